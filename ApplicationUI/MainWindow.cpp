@@ -78,6 +78,10 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
     });
     ui->btnShowGrid->setChecked(true);
 
+    ui->actionWeldOnImport->setChecked(m_core->importWelding());
+    ui->actionGltfQuantize->setChecked(m_core->gltfQuantize());
+    ui->actionGltfMeshopt->setChecked(m_core->gltfMeshopt());
+
 #ifndef NDEBUG
     connect(ui->btnCulling, &QPushButton::toggled, this, [=, this](bool checked) {
         if (!m_core)
@@ -101,11 +105,10 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
 
     if (!m_vkInstance->create())
     {
-        QMessageBox::critical(this,
-                              tr("Vulkan Error"),
-                              tr("Failed to create a Vulkan instance. "
-                                 "This application requires a Vulkan-capable GPU and driver."));
-        std::exit(EXIT_FAILURE);
+        // Remote sessions, VMs and CI runners often have no Vulkan driver: keep going with
+        // CPU rasterized viewports.
+        qWarning() << "Failed to create a Vulkan instance; using software viewports";
+        m_vkInstance.reset();
     }
 
     // ------------------------------------------------------------
@@ -235,6 +238,15 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
     m_uiTimer->setInterval(16); // ~60 fps
     connect(m_uiTimer, &QTimer::timeout, this, &MainWindow::onUiTick);
     m_uiTimer->start();
+
+    // Capture runs here, the write on a worker; unchanged scenes are skipped.
+    m_autosaveTimer = new QTimer(this);
+    m_autosaveTimer->setInterval(2 * 60 * 1000);
+    connect(m_autosaveTimer, &QTimer::timeout, this, [this]() {
+        if (m_core)
+            (void)m_core->autosave();
+    });
+    m_autosaveTimer->start();
 }
 
 MainWindow::~MainWindow() noexcept
@@ -369,9 +381,11 @@ namespace
     {
         return QObject::tr(
             "IMP3D Scene (*.imp);;"
-            "3D Models (*.imp *.obj *.gltf *.glb);;"
+            "3D Models (*.imp *.obj *.gltf *.glb *.ply *.stl);;"
             "OBJ Files (*.obj);;"
             "glTF Files (*.gltf *.glb);;"
+            "PLY Files (*.ply);;"
+            "STL Files (*.stl);;"
             "All Files (*.*)");
     }
 
@@ -383,10 +397,12 @@ namespace
     static QString importFilter()
     {
         return QObject::tr(
-            "3D Models (*.obj *.gltf *.glb *.imp);;"
+            "3D Models (*.obj *.gltf *.glb *.ply *.stl *.imp);;"
             "IMP3D Scene (*.imp);;"
             "OBJ Files (*.obj);;"
             "glTF Files (*.gltf *.glb);;"
+            "PLY Files (*.ply);;"
+            "STL Files (*.stl);;"
             "All Files (*.*)");
     }
 
@@ -395,6 +411,9 @@ namespace
         return QObject::tr(
             "OBJ Files (*.obj);;"
             "glTF Files (*.gltf *.glb);;"
+            "PLY Files (*.ply);;"
+            "STL Files (*.stl);;"
+            "IMP3D Text Scene (*.imp);;"
             "All Files (*.*)");
     }
 
@@ -593,6 +612,14 @@ void MainWindow::handleAction()
             (void)m_core->importFile(fileName.toStdString());
         }
 
+        // ------------------------------------------------------------
+        // File -> Weld Vertices on Import (also applies to Open)
+        // ------------------------------------------------------------
+        else if (name == "actionWeldOnImport")
+        {
+            m_core->importWelding(action->isChecked());
+        }
+
         // ------------------------------------------------------------
         // File -> Export (does NOT change current document path)
         // ------------------------------------------------------------
@@ -611,6 +638,14 @@ void MainWindow::handleAction()
             (void)m_core->exportFile(fileName.toStdString());
         }
 
+        // ------------------------------------------------------------
+        // File -> Export Options (glTF encodings)
+        // ------------------------------------------------------------
+        else if (name == "actionGltfQuantize" || name == "actionGltfMeshopt")
+        {
+            m_core->gltfCompression(ui->actionGltfQuantize->isChecked(), ui->actionGltfMeshopt->isChecked());
+        }
+
         // ------------------------------------------------------------
         // File -> Exit
         // ------------------------------------------------------------
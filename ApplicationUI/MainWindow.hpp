@@ -61,6 +61,8 @@ private:
     QTimer* m_uiTimer = nullptr;
     void    onUiTick();
 
+    QTimer* m_autosaveTimer = nullptr;
+
     std::unique_ptr<ViewportManager>  m_viewportManager;
     std::unique_ptr<SubWindowManager> m_subWindowManager;
 
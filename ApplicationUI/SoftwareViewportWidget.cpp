@@ -0,0 +1,147 @@
+#include "SoftwareViewportWidget.hpp"
+
+#include <Core.hpp>
+#include <QImage>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QResizeEvent>
+#include <QWheelEvent>
+#include <cmath>
+
+namespace
+{
+    static QSize pixelSize(const QWidget* w)
+    {
+        const qreal dpr = w->devicePixelRatioF();
+        return QSize(
+            int(std::lround(double(w->width()) * double(dpr))),
+            int(std::lround(double(w->height()) * double(dpr))));
+    }
+} // namespace
+
+SoftwareViewportWidget::SoftwareViewportWidget(Core* core, Viewport* vp, QWidget* parent) noexcept :
+    QWidget(parent),
+    m_core(core),
+    m_viewport(vp)
+{
+    Q_ASSERT(m_core);
+    Q_ASSERT(m_viewport);
+
+    // Every pixel is written by the rasterizer.
+    setAttribute(Qt::WA_OpaquePaintEvent, true);
+    setAttribute(Qt::WA_NoSystemBackground, true);
+
+    setMouseTracking(true);
+    setFocusPolicy(Qt::ClickFocus);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+}
+
+void SoftwareViewportWidget::paintEvent(QPaintEvent* e)
+{
+    Q_UNUSED(e);
+
+    QPainter painter(this);
+
+    if (!m_core || !m_viewport || !m_core->renderSoftware(m_viewport, m_frame) || !m_frame.valid())
+    {
+        painter.fillRect(rect(), QColor::fromRgbF(0.032f, 0.049f, 0.074f));
+        return;
+    }
+
+    // CpuFrame pixels are RGBA8 in memory order; wrap them without a copy.
+    QImage image(reinterpret_cast<const uchar*>(m_frame.pixels.data()),
+                 m_frame.width,
+                 m_frame.height,
+                 m_frame.width * int(sizeof(uint32_t)),
+                 QImage::Format_RGBA8888);
+    image.setDevicePixelRatio(devicePixelRatioF());
+
+    painter.drawImage(QPointF(0.0, 0.0), image);
+}
+
+void SoftwareViewportWidget::resizeEvent(QResizeEvent* e)
+{
+    QWidget::resizeEvent(e);
+
+    // Core viewport uses pixel size.
+    const QSize px = pixelSize(this);
+    if (m_core && m_viewport)
+        m_core->resizeViewport(m_viewport, px.width(), px.height());
+}
+
+CoreEvent SoftwareViewportWidget::createCoreEvent(const QMouseEvent* e) const noexcept
+{
+    CoreEvent ev = {};
+
+    const float dpr = static_cast<float>(devicePixelRatioF());
+
+    ev.button = static_cast<int>(e->button());
+    ev.x      = static_cast<float>(e->position().x()) * dpr;
+    ev.y      = static_cast<float>(e->position().y()) * dpr;
+
+    ev.key_code  = 0;
+    ev.shift_key = (e->modifiers() & Qt::ShiftModifier) != 0;
+    ev.ctrl_key  = (e->modifiers() & Qt::ControlModifier) != 0;
+    ev.cmd_key   = (e->modifiers() & Qt::MetaModifier) != 0;
+    ev.alt_key   = (e->modifiers() & Qt::AltModifier) != 0;
+    ev.dbl_click = e->type() == QEvent::MouseButtonDblClick;
+
+    return ev;
+}
+
+void SoftwareViewportWidget::mousePressEvent(QMouseEvent* e)
+{
+    if (!m_core || !m_viewport)
+        return;
+
+    m_lastPos = e->position();
+    m_core->setActiveViewport(m_viewport);
+    m_core->mousePressEvent(m_viewport, createCoreEvent(e));
+    update();
+}
+
+void SoftwareViewportWidget::mouseMoveEvent(QMouseEvent* e)
+{
+    if (!m_core || !m_viewport)
+        return;
+
+    CoreEvent ev = createCoreEvent(e);
+
+    const float dpr = static_cast<float>(devicePixelRatioF());
+    ev.deltaX       = (e->position().x() - m_lastPos.x()) * dpr;
+    ev.deltaY       = (e->position().y() - m_lastPos.y()) * dpr;
+
+    m_lastPos = e->position();
+
+    if (e->buttons() & Qt::LeftButton)
+        m_core->mouseDragEvent(m_viewport, ev);
+    else
+        m_core->mouseMoveEvent(m_viewport, ev);
+}
+
+void SoftwareViewportWidget::mouseReleaseEvent(QMouseEvent* e)
+{
+    if (!m_core || !m_viewport)
+        return;
+
+    m_core->mouseReleaseEvent(m_viewport, createCoreEvent(e));
+}
+
+void SoftwareViewportWidget::mouseDoubleClickEvent(QMouseEvent* e)
+{
+    if (!m_core || !m_viewport)
+        return;
+
+    m_core->mousePressEvent(m_viewport, createCoreEvent(e));
+}
+
+void SoftwareViewportWidget::wheelEvent(QWheelEvent* e)
+{
+    if (!m_core || !m_viewport)
+        return;
+
+    CoreEvent ev = {};
+    ev.deltaY    = e->angleDelta().y() / 120.0f;
+
+    m_core->mouseWheelEvent(m_viewport, ev);
+}
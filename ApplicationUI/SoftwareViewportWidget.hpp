@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QPointF>
+#include <QWidget>
+
+#include "CoreTypes.hpp"
+#include "CpuRasterizer.hpp"
+
+class Core;
+class Viewport;
+
+/**
+ * @brief Viewport surface drawn by Core::renderSoftware() instead of Vulkan.
+ *
+ * Used by ViewportWidget when no Vulkan device could be created. Paints the
+ * CPU frame on update() and forwards mouse input to Core the same way
+ * ViewportRenderWindow does.
+ */
+class SoftwareViewportWidget final : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit SoftwareViewportWidget(Core* core, Viewport* vp, QWidget* parent = nullptr) noexcept;
+    ~SoftwareViewportWidget() override = default;
+
+protected:
+    void paintEvent(QPaintEvent* e) override;
+    void resizeEvent(QResizeEvent* e) override;
+
+    void mousePressEvent(QMouseEvent* e) override;
+    void mouseMoveEvent(QMouseEvent* e) override;
+    void mouseReleaseEvent(QMouseEvent* e) override;
+    void mouseDoubleClickEvent(QMouseEvent* e) override;
+    void wheelEvent(QWheelEvent* e) override;
+
+private:
+    CoreEvent createCoreEvent(const QMouseEvent* e) const noexcept;
+
+private:
+    Core*     m_core     = nullptr;
+    Viewport* m_viewport = nullptr;
+
+    CpuFrame m_frame   = {};
+    QPointF  m_lastPos = {};
+};
@@ -19,6 +19,19 @@ void SceneStatsDialog::idleEvent(Core* core)
     if (!core)
         return;
 
+    // Culling counts follow the camera, not scene content, so poll them every idle.
+    const RenderStats r = core->renderStats();
+    if (r.meshesDrawn != m_lastRenderStats.meshesDrawn ||
+        r.meshesCulled != m_lastRenderStats.meshesCulled ||
+        r.texturesPending != m_lastRenderStats.texturesPending)
+    {
+        m_lastRenderStats = r;
+
+        ui->labelDrawnValue->setText(QString::number(r.meshesDrawn));
+        ui->labelCulledValue->setText(QString::number(r.meshesCulled));
+        ui->labelTexturesLoadingValue->setText(QString::number(r.texturesPending));
+    }
+
     const uint64_t stamp = core->sceneContentChangeStamp();
     if (stamp == m_lastStamp)
         return;
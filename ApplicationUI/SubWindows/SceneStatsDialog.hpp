@@ -22,7 +22,8 @@ public:
 
 private:
     Ui::SceneStatsDialog* ui;
-    uint64_t              m_lastStamp = 0ull;
+    uint64_t              m_lastStamp       = 0ull;
+    RenderStats           m_lastRenderStats = {};
 };
 
 #endif // SCENESTATSDIALOG_HPP
@@ -12,17 +12,21 @@ ViewportManager::ViewportManager(QWidget* parent, Core* core, QVulkanInstance* v
     m_core(core)
 {
     Q_ASSERT(m_core);
-    Q_ASSERT(vkInstance);
 
-    m_backend = std::make_unique<VulkanBackend>();
-
-    if (m_backend->init(vkInstance, 2))
-    {
-        m_core->initializeDevice(m_backend->context());
-    }
-    else
+    // Without a Vulkan instance or device the viewports fall back to the CPU rasterizer.
+    if (vkInstance)
     {
-        qFatal("Failed to init VulkanBackend");
+        m_backend = std::make_unique<VulkanBackend>();
+
+        if (m_backend->init(vkInstance, 2))
+        {
+            m_core->initializeDevice(m_backend->context());
+        }
+        else
+        {
+            qWarning("Failed to init VulkanBackend; using software viewports");
+            m_backend.reset();
+        }
     }
 
     buildUi();
@@ -173,9 +177,6 @@ void ViewportManager::buildUi()
 
 void ViewportManager::renderViews()
 {
-    if (!m_backend)
-        return;
-
     for (ViewportWidget* vpw : m_viewports)
     {
         if (!vpw || !vpw->isVisible() || vpw->width() <= 1 || vpw->height() <= 1)
@@ -35,10 +35,11 @@ public:
      *
      * @param parent     Parent QWidget.
      * @param core       Application core (must outlive ViewportManager).
-     * @param vkInstance Vulkan instance used to initialize the backend.
+     * @param vkInstance Vulkan instance used to initialize the backend (may be null).
      *
      * Creates the VulkanBackend, initializes the device, builds the UI,
-     * and creates four ViewportWidget instances.
+     * and creates four ViewportWidget instances. If there is no instance or
+     * the device cannot be created, the viewports are software rasterized.
      */
     explicit ViewportManager(QWidget* parent, Core* core, QVulkanInstance* vkInstance);
 
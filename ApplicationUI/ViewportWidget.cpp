@@ -5,6 +5,7 @@
 #include <QVBoxLayout>
 #include <cmath>
 
+#include "SoftwareViewportWidget.hpp"
 #include "ViewportRenderWindow.hpp"
 #include "VulkanBackend.hpp"
 #include "ui_ViewportWidget.h"
@@ -17,8 +18,8 @@ ViewportWidget::ViewportWidget(QWidget* parent, Core* core, VulkanBackend* backe
 {
     ui->setupUi(this);
 
-    // Disable Ray Trace draw mode if backend does not support it
-    if (m_backend && !m_backend->supportsRayTracing())
+    // Disable Ray Trace draw mode if backend does not support it (or there is no backend)
+    if (!m_backend || !m_backend->supportsRayTracing())
     {
         const int rtIndex = static_cast<int>(DrawMode::RAY_TRACE);
 
@@ -66,6 +67,22 @@ ViewportWidget::ViewportWidget(QWidget* parent, Core* core, VulkanBackend* backe
         ui->renderPlaceholder->setAutoFillBackground(false);
         m_container->setAttribute(Qt::WA_OpaquePaintEvent, true);
     }
+    else if (m_core && m_viewport)
+    {
+        // No Vulkan device: CPU rasterized viewport.
+        m_software = new SoftwareViewportWidget(m_core, m_viewport, ui->renderPlaceholder);
+
+        QVBoxLayout* l = qobject_cast<QVBoxLayout*>(ui->renderPlaceholder->layout());
+        if (!l)
+        {
+            l = new QVBoxLayout(ui->renderPlaceholder);
+            l->setContentsMargins(0, 0, 0, 0);
+            l->setSpacing(0);
+        }
+        l->addWidget(m_software);
+
+        ui->renderPlaceholder->setAutoFillBackground(false);
+    }
 
     connect(ui->btnMove, &ScrollButton::scrollButtonAction, this, &ViewportWidget::scrollButtonAction);
     connect(ui->btnZoom, &ScrollButton::scrollButtonAction, this, &ViewportWidget::scrollButtonAction);
@@ -82,6 +99,11 @@ ViewportWidget::ViewportWidget(QWidget* parent, Core* core, VulkanBackend* backe
 ViewportWidget::~ViewportWidget()
 {
     shutdownVulkan();
+
+    if (m_core && m_viewport)
+        m_core->destroyViewport(m_viewport);
+    m_viewport = nullptr;
+
     delete ui;
 }
 
@@ -129,6 +151,8 @@ void ViewportWidget::requestRender()
     // m_container->setFocus(Qt::OtherFocusReason);
     if (m_window)
         m_window->requestUpdate();
+    else if (m_software)
+        m_software->update();
 }
 
 void ViewportWidget::cmbViewTypeChanged(int index)
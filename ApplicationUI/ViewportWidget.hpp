@@ -13,8 +13,9 @@ namespace Ui
 class Core;
 class Viewport;
 
-class VulkanBackend;        // UI layer type (Qt/Vulkan)
-class ViewportRenderWindow; // UI layer type (QWindow)
+class VulkanBackend;          // UI layer type (Qt/Vulkan)
+class ViewportRenderWindow;   // UI layer type (QWindow)
+class SoftwareViewportWidget; // UI layer type (CPU fallback)
 
 class ViewportWidget : public QWidget
 {
@@ -52,9 +53,10 @@ private:
     Core*               m_core     = nullptr;
     Viewport*           m_viewport = nullptr;
 
-    VulkanBackend*        m_backend   = nullptr;
-    ViewportRenderWindow* m_window    = nullptr;
-    QWidget*              m_container = nullptr;
+    VulkanBackend*          m_backend   = nullptr;
+    ViewportRenderWindow*   m_window    = nullptr;
+    QWidget*                m_container = nullptr;
+    SoftwareViewportWidget* m_software  = nullptr; ///< Used instead of m_window without a backend.
 };
 
 #endif // VIEWPORTWIDGET_HPP
@@ -5,6 +5,7 @@
 #include "VulkanBackend.hpp"
 
 #include <QMessageBox>
+#include <QStandardPaths>
 #include <QVulkanDeviceFunctions>
 #include <QVulkanFunctions>
 #include <QWindow>
@@ -14,6 +15,8 @@
 #include <iostream>
 #include <sstream>
 
+#include "PipelineCache.hpp"
+#include "TextureCache.hpp"
 #include "VkDebugNames.hpp"
 
 namespace
@@ -64,6 +67,24 @@ namespace
         return VK_SAMPLE_COUNT_1_BIT;
     }
 
+    static std::filesystem::path pipelineCacheDir()
+    {
+        const QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        if (base.isEmpty())
+            return {};
+
+        return std::filesystem::path(base.toStdWString()) / "pipeline_cache";
+    }
+
+    static std::filesystem::path textureCacheDir()
+    {
+        const QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        if (base.isEmpty())
+            return {};
+
+        return std::filesystem::path(base.toStdWString()) / "texture_cache";
+    }
+
 } // namespace
 
 // ------------------------------------------------------------
@@ -243,6 +264,9 @@ bool VulkanBackend::init(QVulkanInstance* qvk, uint32_t framesInFlight)
     if (!loadKhrEntryPoints())
         return false;
 
+    m_pipelineCache = vkutil::loadPipelineCache(m_device, m_physicalDevice, pipelineCacheDir());
+    TextureCache::shared().setDirectory(textureCacheDir());
+
     ensureContext();
     return true;
 }
@@ -274,6 +298,14 @@ void VulkanBackend::shutdown() noexcept
     }
     m_swapchains.clear();
 
+    if (m_pipelineCache != VK_NULL_HANDLE)
+    {
+        vkutil::savePipelineCache(m_device, m_physicalDevice, m_pipelineCache, pipelineCacheDir());
+        if (df)
+            df->vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+        m_pipelineCache = VK_NULL_HANDLE;
+    }
+
     if (df && m_device)
         df->vkDestroyDevice(m_device, nullptr);
 
@@ -594,6 +626,11 @@ bool VulkanBackend::createDevice()
     std::vector<const char*> enabledExts;
     enabledExts.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 
+    // Query-only extension; lets texture streaming follow the driver's VRAM budget.
+    m_supportsMemoryBudget = hasExt(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    if (m_supportsMemoryBudget)
+        enabledExts.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
     const bool rtExtsOk =
         hasExt(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME) &&
         hasExt(VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME) &&
@@ -667,6 +704,13 @@ bool VulkanBackend::createDevice()
     feats2.features.samplerAnisotropy = VK_TRUE;
     feats2.features.shaderInt64       = supportedCore.features.shaderInt64 ? VK_TRUE : VK_FALSE;
 
+    // Batched mesh drawing (Renderer): firstInstance selects the per-draw model matrix.
+    m_supportsDrawIndirectFirstInstance = supportedCore.features.drawIndirectFirstInstance == VK_TRUE;
+    m_supportsMultiDrawIndirect         = supportedCore.features.multiDrawIndirect == VK_TRUE;
+
+    feats2.features.drawIndirectFirstInstance = m_supportsDrawIndirectFirstInstance ? VK_TRUE : VK_FALSE;
+    feats2.features.multiDrawIndirect         = m_supportsMultiDrawIndirect ? VK_TRUE : VK_FALSE;
+
     VkPhysicalDeviceVulkan12Features feat12 = {};
     feat12.sType                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
 
@@ -799,6 +843,11 @@ void VulkanBackend::ensureContext() noexcept
     m_ctx.sampleCount              = m_sampleCount;
     m_ctx.deviceProps              = m_deviceProps;
     m_ctx.supportsRayTracing       = m_supportsRayTracing;
+
+    m_ctx.supportsDrawIndirectFirstInstance = m_supportsDrawIndirectFirstInstance;
+    m_ctx.supportsMultiDrawIndirect         = m_supportsMultiDrawIndirect;
+    m_ctx.supportsMemoryBudget              = m_supportsMemoryBudget;
+    m_ctx.pipelineCache                     = m_pipelineCache;
     m_ctx.rtProps                  = m_rtProps;
     m_ctx.asProps                  = m_asProps;
     m_ctx.rtDispatch               = m_supportsRayTracing ? &m_rtDispatch : nullptr;
@@ -144,6 +144,9 @@ private:
 
     VkPhysicalDeviceProperties m_deviceProps = {};
 
+    // Shared by every pipeline creator via VulkanContext; persisted on shutdown.
+    VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+
 private:
     VulkanContext    m_ctx              = {};
     DeferredDeletion m_deferredDeletion = {};
@@ -162,6 +165,13 @@ private:
     PFN_vkAcquireNextImageKHR   m_vkAcquireNextImageKHR   = nullptr;
     PFN_vkQueuePresentKHR       m_vkQueuePresentKHR       = nullptr;
 
+    // ------------------------------------------------------------
+    // Optional indirect draw capability
+    // ------------------------------------------------------------
+    bool m_supportsDrawIndirectFirstInstance = false;
+    bool m_supportsMultiDrawIndirect         = false;
+    bool m_supportsMemoryBudget              = false;
+
     // ------------------------------------------------------------
     // Optional RT capability
     // ------------------------------------------------------------
@@ -10,8 +10,11 @@
 
 #include "CoreDocument.hpp"
 #include "CoreTypes.hpp"
+#include "CpuPathTracer.hpp"
+#include "CpuRasterizer.hpp"
 #include "ItemFactory.hpp"
 #include "LightingSettings.hpp"
+#include "LightmapBaker.hpp"
 #include "Scene.hpp"
 #include "SceneFormat.hpp"
 #include "VulkanContext.hpp"
@@ -72,6 +75,12 @@ public:
      */
     Viewport* createViewport();
 
+    /**
+     * @brief Release a viewport's renderer state and destroy it.
+     * @param vp Viewport from createViewport(); dangling afterwards
+     */
+    void destroyViewport(Viewport* vp) noexcept;
+
     /**
      * @brief Initialize a viewport after creation.
      * @param vp Viewport to initialize
@@ -178,6 +187,12 @@ public:
      */
     SceneStats sceneStats() const noexcept;
 
+    /**
+     * @brief Retrieve renderer culling statistics.
+     * @return RenderStats structure (drawn/culled meshes, last frame)
+     */
+    RenderStats renderStats() const noexcept;
+
     /** @brief Scene-stats change stamp for UI polling (monotonic). */
     [[nodiscard]] uint64_t sceneStatsStamp() const noexcept;
 
@@ -230,11 +245,99 @@ public:
     /** @brief Export scene to file. */
     [[nodiscard]] bool exportFile(const std::filesystem::path& path);
 
+    /**
+     * @brief Block compression for native saves (Save / Save As).
+     *
+     * On by default with LZ4; zstd trades save time for size. Loading
+     * detects the codec, so this only affects writing.
+     *
+     * @param level Codec level; 0 = codec default (see NativeCodec).
+     */
+    void nativeCompression(bool enabled, NativeCodec codec = NativeCodec::Lz4, int level = 0) noexcept;
+
+    /**
+     * @brief Vertex welding for Open / Import of formats that split vertices
+     *        at seams (glTF).
+     *
+     * Off by default so imports keep the file's vertex layout. Enable it to
+     * bring meshes in connected so they edit like native ones. STL imports
+     * are always welded; @p epsilon applies to them either way.
+     *
+     * @param epsilon Weld grid size; 0 = only identical positions merge.
+     */
+    void importWelding(bool enabled, float epsilon = 0.0f) noexcept;
+
+    /** @brief Query whether Open / Import weld vertices. */
+    bool importWelding() const noexcept;
+
+    /**
+     * @brief Geometry encodings for glTF export.
+     *
+     * Both are off by default; files using them need a loader that supports
+     * KHR_mesh_quantization / EXT_meshopt_compression.
+     */
+    void gltfCompression(bool quantize, bool meshopt) noexcept;
+
+    /** @brief Query whether glTF export quantizes attributes (KHR_mesh_quantization). */
+    bool gltfQuantize() const noexcept;
+
+    /** @brief Query whether glTF export compresses buffers (EXT_meshopt_compression). */
+    bool gltfMeshopt() const noexcept;
+
+    /**
+     * @brief Write a recovery copy in the background if the scene changed.
+     *
+     * Cheap to call periodically: returns immediately when there is nothing
+     * new to save or the previous autosave is still writing.
+     *
+     * @return True if an autosave was started.
+     */
+    bool autosave();
+
     /**
      * @return Current document file path, or empty if unnamed/unsaved
      */
     std::string filePath() const noexcept;
 
+    // ------------------------------------------------------------
+    // Final-frame rendering and baking (CPU, no swapchain)
+    // ------------------------------------------------------------
+
+    /**
+     * @brief Path trace the scene as seen from @p vp and write it to @p path.
+     *
+     * Runs on the CPU (see renderPathTraced()), so it also works headless:
+     * create a viewport, size it and call this without initializeDevice().
+     * Blocks until done or until @p progress returns false.
+     *
+     * @param path Output image; .exr (linear float) or .png (tonemapped sRGB).
+     */
+    [[nodiscard]] bool renderImage(Viewport*                    vp,
+                                   const CpuRenderSettings&     settings,
+                                   const std::filesystem::path& path,
+                                   const CpuRenderProgress&     progress = {});
+
+    /**
+     * @brief Bake AO / bent normals / direct light of @p mesh into new images.
+     *
+     * CPU baker over the UV0 layout (see bakeLightmaps()); the maps are added
+     * to the image handler and returned in @p result. Blocks until done or
+     * until @p progress returns false.
+     */
+    [[nodiscard]] bool bakeLightmaps(SceneMesh*                  mesh,
+                                     const LightmapBakeSettings& settings,
+                                     LightmapBakeResult&         result,
+                                     const LightmapBakeProgress& progress = {});
+
+    /**
+     * @brief Rasterize @p vp on the CPU into @p frame (software viewport).
+     *
+     * Fallback for machines without a usable Vulkan device (remote sessions,
+     * CI, screenshot tests). Same draw modes and geometry as the Vulkan
+     * viewport; see CpuRasterizer.
+     */
+    [[nodiscard]] bool renderSoftware(Viewport* vp, CpuFrame& frame, const CpuRasterSettings& settings = {});
+
     // ------------------------------------------------------------
     // Materials
     // ------------------------------------------------------------
@@ -362,6 +465,9 @@ private:
     /** @brief Material editor facade. */
     std::unique_ptr<MaterialEditor> m_materialEditor;
 
+    /** @brief Software viewport rasterizer (created on first use). */
+    std::unique_ptr<CpuRasterizer> m_rasterizer;
+
     /** @brief Cached camera pan. */
     glm::vec3 m_pan{0.f};
 
@@ -371,6 +477,19 @@ private:
     /** @brief Cached camera distance. */
     float m_dist = -6.f;
 
+    /** @brief Native save compression (see nativeCompression()). */
+    bool        m_compressNative = true;
+    NativeCodec m_nativeCodec    = NativeCodec::Lz4;
+    int         m_nativeLevel    = 0;
+
+    /** @brief Import vertex welding (see importWelding()). */
+    bool  m_weldOnImport = false;
+    float m_weldEpsilon  = 0.0f;
+
+    /** @brief glTF export encodings (see gltfCompression()). */
+    bool m_gltfQuantize = false;
+    bool m_gltfMeshopt  = false;
+
     // ------------------------------------------------------------
     // Tools & commands
     // ------------------------------------------------------------
@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <future>
+#include <memory>
 #include <optional>
 
 #include "ItemFactory.hpp"
@@ -9,6 +11,11 @@
 
 class Scene;
 
+namespace imp_binary
+{
+    class ChunkCache;
+} // namespace imp_binary
+
 /**
  * @brief Application-level document wrapper for a Scene.
  *
@@ -26,6 +33,11 @@ class Scene;
  *  - exportFile() writes to other formats without changing document path or save-state
  *  - openFile() replaces the scene (unless options.mergeIntoExisting=true)
  *  - importFile() merges into the existing scene and does NOT change document path
+ *  - autosave() writes a recovery copy on a worker; path and save-state are untouched
+ *
+ * Binary native saves go through a chunk cache: only meshes whose change
+ * counters moved since the previous save (or autosave) are serialized and
+ * compressed again, the rest reuse their packed chunks.
  *
  * UI responsibilities:
  *  - requestNew()/requestExit() are gates only; if false, UI shows "Save/Discard/Cancel"
@@ -40,6 +52,9 @@ public:
      */
     explicit CoreDocument(Scene* owner) noexcept;
 
+    /// Waits for a running autosave.
+    ~CoreDocument();
+
     CoreDocument(const CoreDocument&)            = delete;
     CoreDocument& operator=(const CoreDocument&) = delete;
 
@@ -165,6 +180,36 @@ public:
      */
     bool exportFile(const std::filesystem::path& path, const SaveOptions& options = {}, SceneIOReport* report = nullptr) const;
 
+    // ------------------------------------------------------------
+    // Autosave
+    // ------------------------------------------------------------
+
+    /**
+     * @brief Write a recovery copy of the scene to autosavePath() in the background.
+     *
+     * The scene is captured here (main thread, reusing cached chunks); compression
+     * and the file write run on the shared TaskPool. Skipped when nothing changed
+     * since the last save/autosave, while images are still decoding, or while the
+     * previous autosave is still running.
+     *
+     * @return True if an autosave was started.
+     */
+    bool autosave(const SaveOptions& options = {});
+
+    /// True while an autosave started by autosave() is still writing.
+    [[nodiscard]] bool autosaveRunning() const;
+
+    /// Block until a running autosave has finished.
+    void waitForAutosave();
+
+    /**
+     * @brief Where autosave() writes.
+     *
+     * "<name>.autosave.imp" next to the document, or "untitled.autosave.imp"
+     * in the system temp directory for an unsaved document.
+     */
+    [[nodiscard]] std::filesystem::path autosavePath() const;
+
 private:
     Scene*                               m_scene = nullptr; // non-owning
     std::optional<std::filesystem::path> m_path  = {};
@@ -174,6 +219,10 @@ private:
 
     ItemFactory<SceneFormat> m_formatFactory;
 
+    std::unique_ptr<imp_binary::ChunkCache> m_chunkCache       = {};
+    std::future<bool>                       m_autosaveJob      = {};
+    uint64_t                                m_autosavedCounter = 0; ///< Content counter the last autosave captured.
+
 private:
     [[nodiscard]] uint64_t currentCounter() const noexcept;
     void                   markDirtyFallback() const noexcept;
@@ -182,4 +231,10 @@ private:
     [[nodiscard]] static bool        isNativeImp_(const std::filesystem::path& path) noexcept;
 
     [[nodiscard]] std::unique_ptr<SceneFormat> createFormatForPath_(const std::filesystem::path& path) const;
+
+    /// Save through @p fmt, or through the chunk cache for binary native saves.
+    bool saveNative_(SceneFormat& fmt, const std::filesystem::path& path, const SaveOptions& options, SceneIOReport& report);
+
+    /// Remove a recovery copy once the real file is safe.
+    void discardAutosave_(const std::filesystem::path& autosaveFile);
 };
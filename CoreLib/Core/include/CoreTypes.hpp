@@ -73,6 +73,16 @@ struct SceneStats
     unsigned int uvPos = 0;
 };
 
+struct RenderStats
+{
+    unsigned int meshesDrawn  = 0;    // Meshes that passed frustum culling (last frame, all viewports)
+    unsigned int meshesCulled = 0;    // Visible meshes rejected by frustum culling
+    unsigned int drawCalls    = 0;    // Mesh draw commands recorded (a multi-draw indirect counts once)
+    double       recordMs     = 0.0;  // CPU time spent recording the mesh passes
+
+    unsigned int texturesPending = 0; // Textures still decoding or uploading (fallback bound meanwhile)
+};
+
 enum class GpuBackend
 {
     OpenGL, // Not implemented anymore
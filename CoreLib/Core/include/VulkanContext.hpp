@@ -164,8 +164,25 @@ struct VulkanContext
 
     VkPhysicalDeviceProperties deviceProps{};
 
+    /**
+     * @brief Shared pipeline cache (may be VK_NULL_HANDLE).
+     *
+     * Created by the backend from the on-disk cache (see PipelineCache.hpp) and
+     * saved back at shutdown. Pass it to every vkCreate*Pipelines call.
+     * Vulkan pipeline caches are internally synchronized, so parallel pipeline
+     * creation may share it.
+     */
+    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+
     bool supportsRayTracing = false;
 
+    // Core features used by the batched (indirect) mesh path.
+    bool supportsDrawIndirectFirstInstance = false;
+    bool supportsMultiDrawIndirect         = false;
+
+    // VK_EXT_memory_budget enabled: TextureHandler sizes its residency budget from it.
+    bool supportsMemoryBudget = false;
+
     // Optional RT dispatch table (only valid if supportsRayTracing == true)
     const VulkanRtDispatch* rtDispatch = nullptr;
 
@@ -27,6 +27,8 @@
 #include "Formats/GltfSceneFormat.hpp"
 #include "Formats/ImpSceneFormat.hpp"
 #include "Formats/ObjSceneFormat.hpp"
+#include "Formats/PlySceneFormat.hpp"
+#include "Formats/StlSceneFormat.hpp"
 #include "InsetTool.hpp"
 #include "MockTool.hpp"
 #include "MoveTool.hpp"
@@ -96,6 +98,8 @@ namespace config
         factory.registerItem(".obj", factory.createItemType<ObjSceneFormat>);
         factory.registerItem(".gltf", factory.createItemType<GltfSceneFormat>);
         factory.registerItem(".glb", factory.createItemType<GltfSceneFormat>);
+        factory.registerItem(".ply", factory.createItemType<PlySceneFormat>);
+        factory.registerItem(".stl", factory.createItemType<StlSceneFormat>);
     }
 
 } // namespace config
@@ -54,6 +54,8 @@ void Core::destroy()
     if (!m_scene)
         return;
 
+    m_rasterizer.reset();
+
     m_scene->destroy();
     m_scene.reset();
 }
@@ -73,6 +75,23 @@ Viewport* Core::createViewport()
     return m_viewports.back().get();
 }
 
+void Core::destroyViewport(Viewport* vp) noexcept
+{
+    if (!vp)
+        return;
+
+    if (m_scene)
+    {
+        if (Renderer* renderer = m_scene->renderer())
+            renderer->releaseViewport(vp);
+
+        if (m_scene->activeViewport() == vp)
+            m_scene->setActiveViewport(nullptr);
+    }
+
+    std::erase_if(m_viewports, [vp](const std::unique_ptr<Viewport>& v) { return v.get() == vp; });
+}
+
 void Core::initializeViewport(Viewport* vp) noexcept
 {
     if (!vp)
@@ -288,6 +307,11 @@ SceneStats Core::sceneStats() const noexcept
     return m_scene ? m_scene->stats() : SceneStats{};
 }
 
+RenderStats Core::renderStats() const noexcept
+{
+    return m_scene ? m_scene->renderStats() : RenderStats{};
+}
+
 void Core::idle()
 {
     if (m_scene)
@@ -372,6 +396,8 @@ bool Core::openFile(const std::filesystem::path& path)
     LoadOptions opt       = {};
     opt.mergeIntoExisting = false;
     opt.triangulate       = false;
+    opt.weldVertices      = m_weldOnImport;
+    opt.weldEpsilon       = m_weldEpsilon;
 
     return m_document->openFile(path, opt, nullptr);
 }
@@ -383,7 +409,9 @@ bool Core::saveFile()
 
     SaveOptions opt    = {};
     opt.selectedOnly   = false;
-    opt.compressNative = false;
+    opt.compressNative = m_compressNative;
+    opt.compressCodec  = m_nativeCodec;
+    opt.compressLevel  = m_nativeLevel;
     opt.triangulate    = false;
 
     return m_document->save(opt, nullptr);
@@ -396,7 +424,9 @@ bool Core::saveFileAs(const std::filesystem::path& path)
 
     SaveOptions opt    = {};
     opt.selectedOnly   = false;
-    opt.compressNative = false;
+    opt.compressNative = m_compressNative;
+    opt.compressCodec  = m_nativeCodec;
+    opt.compressLevel  = m_nativeLevel;
     opt.triangulate    = false;
 
     return m_document->saveAs(path, opt, nullptr);
@@ -410,6 +440,8 @@ bool Core::importFile(const std::filesystem::path& path)
     LoadOptions opt       = {};
     opt.mergeIntoExisting = true;
     opt.triangulate       = false;
+    opt.weldVertices      = m_weldOnImport;
+    opt.weldEpsilon       = m_weldEpsilon;
 
     return m_document->importFile(path, opt, nullptr);
 }
@@ -423,10 +455,60 @@ bool Core::exportFile(const std::filesystem::path& path)
     opt.selectedOnly   = false;
     opt.compressNative = false;
     opt.triangulate    = false;
+    opt.textNative     = true; // .imp export stays human-readable
+    opt.gltfQuantize   = m_gltfQuantize;
+    opt.gltfMeshopt    = m_gltfMeshopt;
 
     return m_document->exportFile(path, opt, nullptr);
 }
 
+void Core::nativeCompression(bool enabled, NativeCodec codec, int level) noexcept
+{
+    m_compressNative = enabled;
+    m_nativeCodec    = codec;
+    m_nativeLevel    = level;
+}
+
+void Core::importWelding(bool enabled, float epsilon) noexcept
+{
+    m_weldOnImport = enabled;
+    m_weldEpsilon  = epsilon;
+}
+
+bool Core::importWelding() const noexcept
+{
+    return m_weldOnImport;
+}
+
+void Core::gltfCompression(bool quantize, bool meshopt) noexcept
+{
+    m_gltfQuantize = quantize;
+    m_gltfMeshopt  = meshopt;
+}
+
+bool Core::gltfQuantize() const noexcept
+{
+    return m_gltfQuantize;
+}
+
+bool Core::gltfMeshopt() const noexcept
+{
+    return m_gltfMeshopt;
+}
+
+bool Core::autosave()
+{
+    if (!m_document)
+        return false;
+
+    SaveOptions opt    = {};
+    opt.compressNative = m_compressNative;
+    opt.compressCodec  = m_nativeCodec;
+    opt.compressLevel  = m_nativeLevel;
+
+    return m_document->autosave(opt);
+}
+
 std::string Core::filePath() const noexcept
 {
     if (!m_document || !m_document->hasFilePath())
@@ -436,6 +518,55 @@ std::string Core::filePath() const noexcept
     return m_document->filePath().filename().string();
 }
 
+// ------------------------------------------------------------
+// Final-frame rendering and baking (CPU, no swapchain)
+// ------------------------------------------------------------
+
+bool Core::renderImage(Viewport*                    vp,
+                       const CpuRenderSettings&     settings,
+                       const std::filesystem::path& path,
+                       const CpuRenderProgress&     progress)
+{
+    if (!m_scene || !vp)
+        return false;
+
+    // Bring the Embree BVH up to date with pending edits.
+    m_scene->idle();
+
+    CpuFilm film = {};
+    if (!renderPathTraced(*m_scene, *vp, settings, film, progress))
+        return false;
+
+    return writeFilm(film, path);
+}
+
+bool Core::bakeLightmaps(SceneMesh*                  mesh,
+                         const LightmapBakeSettings& settings,
+                         LightmapBakeResult&         result,
+                         const LightmapBakeProgress& progress)
+{
+    if (!m_scene || !mesh || !m_scene->imageHandler())
+        return false;
+
+    m_scene->idle();
+
+    return ::bakeLightmaps(*m_scene, *mesh, *m_scene->imageHandler(), settings, result, progress);
+}
+
+bool Core::renderSoftware(Viewport* vp, CpuFrame& frame, const CpuRasterSettings& settings)
+{
+    if (!m_scene || !vp)
+        return false;
+
+    m_scene->idle();
+    vp->apply();
+
+    if (!m_rasterizer)
+        m_rasterizer = std::make_unique<CpuRasterizer>();
+
+    return m_rasterizer->render(*m_scene, *vp, settings, frame);
+}
+
 // ------------------------------------------------------------
 // Materials
 // ------------------------------------------------------------
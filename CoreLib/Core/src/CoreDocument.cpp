@@ -2,9 +2,14 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <exception>
 
+#include "Formats/ImpBinaryFormat.hpp"
 #include "Formats/SceneIOUtils.hpp"
+#include "ImageHandler.hpp"
 #include "Scene.hpp"
+#include "TaskPool.hpp"
 
 namespace
 {
@@ -25,14 +30,50 @@ namespace
             p.replace_extension(".imp");
         return p;
     }
+
+    // A throwing reader/writer (bad_alloc, an item rethrown by TaskPool::parallelFor)
+    // fails the operation with a report instead of escaping into the UI.
+    template <typename Fn>
+    static bool guardedIO(SceneIOReport& report, SceneIOStatus status, const char* what, Fn&& fn)
+    {
+        try
+        {
+            return fn();
+        }
+        catch (const std::exception& e)
+        {
+            report.status = status;
+            report.error(std::string(what) + ": " + e.what());
+        }
+        catch (...)
+        {
+            report.status = status;
+            report.error(std::string(what) + ": unknown exception");
+        }
+        return false;
+    }
+
+    // Writers skip images that are not decoded yet; settle async loads first.
+    static void finishImageLoads(Scene* scene)
+    {
+        if (scene && scene->imageHandler())
+            scene->imageHandler()->waitForPendingLoads();
+    }
 } // namespace
 
 CoreDocument::CoreDocument(Scene* owner) noexcept
-    : m_scene(owner)
+    : m_scene(owner),
+      m_chunkCache(std::make_unique<imp_binary::ChunkCache>())
 {
     resetSaveState();
 }
 
+CoreDocument::~CoreDocument()
+{
+    // The job writes through m_chunkCache.
+    waitForAutosave();
+}
+
 ItemFactory<SceneFormat>& CoreDocument::formatFactory() noexcept
 {
     return m_formatFactory;
@@ -94,8 +135,9 @@ bool CoreDocument::hasUnsavedChanges() const noexcept
 
 void CoreDocument::resetSaveState() noexcept
 {
-    m_savedCounter  = currentCounter();
-    m_dirtyFallback = false;
+    m_savedCounter     = currentCounter();
+    m_autosavedCounter = m_savedCounter;
+    m_dirtyFallback    = false;
 }
 
 std::string CoreDocument::extensionLower_(const std::filesystem::path& path)
@@ -123,6 +165,7 @@ bool CoreDocument::newFile() noexcept
         return false;
 
     m_scene->clear();
+    m_chunkCache->clear();
 
     clearFilePath();
     resetSaveState();
@@ -151,7 +194,7 @@ bool CoreDocument::openFile(const std::filesystem::path& path, const LoadOptions
         return false;
     }
 
-    if (!fmt->load(m_scene, path, options, *rep))
+    if (!guardedIO(*rep, SceneIOStatus::ReadError, "CoreDocument::openFile", [&] { return fmt->load(m_scene, path, options, *rep); }))
     {
         dumpSceneIOReport(*rep);
         return false;
@@ -163,6 +206,7 @@ bool CoreDocument::openFile(const std::filesystem::path& path, const LoadOptions
 
     // Opening a file updates document path to what was opened.
     m_path = path;
+    m_chunkCache->clear();
     resetSaveState();
     return true;
 }
@@ -190,7 +234,7 @@ bool CoreDocument::importFile(const std::filesystem::path& path, const LoadOptio
     LoadOptions opt       = options;
     opt.mergeIntoExisting = true;
 
-    if (!fmt->load(m_scene, path, opt, *rep))
+    if (!guardedIO(*rep, SceneIOStatus::ReadError, "CoreDocument::importFile", [&] { return fmt->load(m_scene, path, opt, *rep); }))
         return false;
 
     // Import does not change document path; it makes the doc dirty.
@@ -232,10 +276,13 @@ bool CoreDocument::save(const SaveOptions& options, SceneIOReport* report)
         return false;
     }
 
-    if (!fmt->save(m_scene, *m_path, options, *rep))
+    finishImageLoads(m_scene);
+
+    if (!saveNative_(*fmt, *m_path, options, *rep))
         return false;
 
     resetSaveState();
+    discardAutosave_(autosavePath());
     return true;
 }
 
@@ -261,11 +308,16 @@ bool CoreDocument::saveAs(const std::filesystem::path& path, const SaveOptions&
         return false;
     }
 
-    if (!fmt->save(m_scene, nativePath, options, *rep))
+    finishImageLoads(m_scene);
+
+    if (!saveNative_(*fmt, nativePath, options, *rep))
         return false;
 
+    const std::filesystem::path previousAutosave = autosavePath();
+
     m_path = nativePath;
     resetSaveState();
+    discardAutosave_(previousAutosave);
     return true;
 }
 
@@ -289,6 +341,102 @@ bool CoreDocument::exportFile(const std::filesystem::path& path, const SaveOptio
         return false;
     }
 
+    finishImageLoads(m_scene);
+
     // Export does NOT touch document path or save snapshot.
-    return fmt->save(m_scene, path, options, *rep);
+    return guardedIO(*rep, SceneIOStatus::WriteError, "CoreDocument::exportFile", [&] { return fmt->save(m_scene, path, options, *rep); });
+}
+
+bool CoreDocument::saveNative_(SceneFormat& fmt, const std::filesystem::path& path, const SaveOptions& options, SceneIOReport& report)
+{
+    return guardedIO(report, SceneIOStatus::WriteError, "CoreDocument::save", [&] {
+        if (options.textNative)
+            return fmt.save(m_scene, path, options, report);
+
+        const imp_binary::Snapshot snapshot = imp_binary::capture(m_scene, path, options, m_chunkCache.get());
+        return imp_binary::write(snapshot, path, report, m_chunkCache.get());
+    });
+}
+
+bool CoreDocument::autosave(const SaveOptions& options)
+{
+    if (!m_scene || autosaveRunning())
+        return false;
+
+    const uint64_t now = currentCounter();
+    if (!hasUnsavedChanges() || now == m_autosavedCounter)
+        return false;
+
+    // A pending decode would be written as a missing image; try again next time.
+    if (const ImageHandler* ih = m_scene->imageHandler(); ih && ih->loadProgress().busy())
+        return false;
+
+    const std::filesystem::path path = autosavePath();
+
+    SaveOptions opt  = options;
+    opt.selectedOnly = false;
+    opt.textNative   = false;
+
+    // Capture is the only part that reads the scene; everything after runs on a worker.
+    auto snapshot = std::make_shared<const imp_binary::Snapshot>(imp_binary::capture(m_scene, path, opt, m_chunkCache.get()));
+
+    m_autosavedCounter = now;
+
+    auto done     = std::make_shared<std::promise<bool>>();
+    m_autosaveJob = done->get_future();
+
+    TaskPool::shared().submit([done, snapshot, path, cache = m_chunkCache.get()] {
+        SceneIOReport report = {};
+
+        const bool ok = imp_binary::write(*snapshot, path, report, cache);
+        if (!ok)
+            dumpSceneIOReport(report);
+
+        done->set_value(ok);
+    });
+
+    return true;
+}
+
+bool CoreDocument::autosaveRunning() const
+{
+    return m_autosaveJob.valid() && m_autosaveJob.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void CoreDocument::waitForAutosave()
+{
+    if (!m_autosaveJob.valid())
+        return;
+
+    try
+    {
+        (void)m_autosaveJob.get();
+    }
+    catch (const std::future_error&)
+    {
+        // Pool shut down before the job started.
+    }
+}
+
+std::filesystem::path CoreDocument::autosavePath() const
+{
+    if (m_path)
+    {
+        std::filesystem::path p = *m_path;
+        p.replace_extension(".autosave.imp");
+        return p;
+    }
+
+    std::error_code             ec;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+    return dir / "untitled.autosave.imp";
+}
+
+void CoreDocument::discardAutosave_(const std::filesystem::path& autosaveFile)
+{
+    // A running job would recreate the file after we remove it.
+    waitForAutosave();
+
+    std::error_code ec;
+    std::filesystem::remove(autosaveFile, ec);
 }
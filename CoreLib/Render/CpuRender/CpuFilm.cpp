@@ -0,0 +1,272 @@
+#include "CpuFilm.hpp"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "PathUtilities.hpp"
+
+namespace
+{
+    // Same curve as tonemapACES() in RtScene.rchit / ShadedDraw.frag.
+    float tonemapACES(float x) noexcept
+    {
+        constexpr float a = 2.51f;
+        constexpr float b = 0.03f;
+        constexpr float c = 2.43f;
+        constexpr float d = 0.59f;
+        constexpr float e = 0.14f;
+        return std::clamp((x * (a * x + b)) / (x * (c * x + d) + e), 0.0f, 1.0f);
+    }
+
+    // The viewport presents through an SRGB swapchain; 8-bit files get the same encoding.
+    float linearToSrgb(float x) noexcept
+    {
+        x = std::clamp(x, 0.0f, 1.0f);
+        return (x <= 0.0031308f) ? x * 12.92f : 1.055f * std::pow(x, 1.0f / 2.4f) - 0.055f;
+    }
+
+    // Premultiplied linear pixel, composited over the background unless it is kept transparent.
+    glm::vec4 resolvePixel(const CpuFilm& film, const glm::vec4& p) noexcept
+    {
+        if (film.transparentBackground)
+            return p;
+
+        return glm::vec4(glm::vec3(p) + film.background * (1.0f - p.a), 1.0f);
+    }
+
+    bool writePng(const CpuFilm& film, const std::filesystem::path& path)
+    {
+        std::vector<unsigned char> bytes(film.pixels.size() * 4);
+
+        for (std::size_t i = 0; i < film.pixels.size(); ++i)
+        {
+            const glm::vec4& p = film.pixels[i];
+
+            // Tonemap the covered radiance only; the background is already display color.
+            glm::vec3 c = (p.a > 0.0f) ? glm::vec3(p) / p.a : glm::vec3(0.0f);
+            if (film.tonemap)
+                c = glm::vec3(tonemapACES(c.x), tonemapACES(c.y), tonemapACES(c.z));
+
+            c *= p.a;
+
+            float alpha = p.a;
+            if (!film.transparentBackground)
+            {
+                c += film.background * (1.0f - p.a);
+                alpha = 1.0f;
+            }
+            else if (alpha > 0.0f)
+            {
+                c /= alpha; // PNG stores straight alpha
+            }
+
+            bytes[i * 4 + 0] = static_cast<unsigned char>(std::lround(linearToSrgb(c.x) * 255.0f));
+            bytes[i * 4 + 1] = static_cast<unsigned char>(std::lround(linearToSrgb(c.y) * 255.0f));
+            bytes[i * 4 + 2] = static_cast<unsigned char>(std::lround(linearToSrgb(c.z) * 255.0f));
+            bytes[i * 4 + 3] = static_cast<unsigned char>(std::lround(std::clamp(alpha, 0.0f, 1.0f) * 255.0f));
+        }
+
+        if (!stbi_write_png(path.string().c_str(), film.width, film.height, 4, bytes.data(), film.width * 4))
+        {
+            std::cerr << "writeFilm: failed to write " << path.string() << "\n";
+            return false;
+        }
+
+        return true;
+    }
+
+    // --------------------------------------------------------
+    // Minimal OpenEXR writer
+    // --------------------------------------------------------
+    // Single-part scanline file, no compression, FLOAT channels. Enough for
+    // any EXR reader; avoids pulling OpenEXR in for one output format.
+
+    class ExrBytes
+    {
+    public:
+        void u8(uint8_t v)
+        {
+            m_data.push_back(v);
+        }
+
+        void i32(int32_t v)
+        {
+            u32(static_cast<uint32_t>(v));
+        }
+
+        void u32(uint32_t v)
+        {
+            for (int i = 0; i < 4; ++i)
+                u8(static_cast<uint8_t>(v >> (8 * i)));
+        }
+
+        void u64(uint64_t v)
+        {
+            for (int i = 0; i < 8; ++i)
+                u8(static_cast<uint8_t>(v >> (8 * i)));
+        }
+
+        void f32(float v)
+        {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &v, sizeof(bits));
+            u32(bits);
+        }
+
+        void str(const char* s)
+        {
+            m_data.insert(m_data.end(), s, s + std::strlen(s) + 1);
+        }
+
+        void attribute(const char* name, const char* type, int32_t size)
+        {
+            str(name);
+            str(type);
+            i32(size);
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return m_data.size();
+        }
+
+        void patchU64(std::size_t at, uint64_t v)
+        {
+            for (int i = 0; i < 8; ++i)
+                m_data[at + i] = static_cast<uint8_t>(v >> (8 * i));
+        }
+
+        [[nodiscard]] const std::vector<uint8_t>& data() const noexcept
+        {
+            return m_data;
+        }
+
+    private:
+        std::vector<uint8_t> m_data = {};
+    };
+
+    bool writeExr(const CpuFilm& film, const std::filesystem::path& path)
+    {
+        // Channels must be listed (and stored) in alphabetical order.
+        const bool        withAlpha = film.transparentBackground;
+        const char* const names[]   = {"A", "B", "G", "R"};
+        const int         comps[]   = {3, 2, 1, 0};
+        const int         first     = withAlpha ? 0 : 1;
+        const int         chanCount = 4 - first;
+
+        const int32_t w = film.width;
+        const int32_t h = film.height;
+
+        ExrBytes out;
+
+        out.u32(20000630u); // magic
+        out.u32(2u);        // version 2, single-part scanline
+
+        out.attribute("channels", "chlist", chanCount * 18 + 1);
+        for (int c = first; c < 4; ++c)
+        {
+            out.str(names[c]);
+            out.i32(2); // FLOAT
+            out.u8(0);  // pLinear
+            out.u8(0);
+            out.u8(0);
+            out.u8(0);
+            out.i32(1); // xSampling
+            out.i32(1); // ySampling
+        }
+        out.u8(0);
+
+        out.attribute("compression", "compression", 1);
+        out.u8(0); // NO_COMPRESSION
+
+        for (const char* window : {"dataWindow", "displayWindow"})
+        {
+            out.attribute(window, "box2i", 16);
+            out.i32(0);
+            out.i32(0);
+            out.i32(w - 1);
+            out.i32(h - 1);
+        }
+
+        out.attribute("lineOrder", "lineOrder", 1);
+        out.u8(0); // INCREASING_Y
+
+        out.attribute("pixelAspectRatio", "float", 4);
+        out.f32(1.0f);
+
+        out.attribute("screenWindowCenter", "v2f", 8);
+        out.f32(0.0f);
+        out.f32(0.0f);
+
+        out.attribute("screenWindowWidth", "float", 4);
+        out.f32(1.0f);
+
+        out.u8(0); // end of header
+
+        // One scanline per block; offsets are patched once the block sizes are known.
+        const std::size_t tableAt = out.size();
+        for (int32_t y = 0; y < h; ++y)
+            out.u64(0);
+
+        const int32_t lineBytes = w * chanCount * 4;
+
+        for (int32_t y = 0; y < h; ++y)
+        {
+            out.patchU64(tableAt + std::size_t(y) * 8, out.size());
+
+            out.i32(y);
+            out.i32(lineBytes);
+
+            const glm::vec4* row = film.pixels.data() + std::size_t(y) * w;
+
+            for (int c = first; c < 4; ++c)
+            {
+                for (int32_t x = 0; x < w; ++x)
+                    out.f32(resolvePixel(film, row[x])[comps[c]]);
+            }
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            std::cerr << "writeFilm: cannot open " << path.string() << "\n";
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(out.data().data()), static_cast<std::streamsize>(out.size()));
+        if (!file)
+        {
+            std::cerr << "writeFilm: failed to write " << path.string() << "\n";
+            return false;
+        }
+
+        return true;
+    }
+} // namespace
+
+bool writeFilm(const CpuFilm& film, const std::filesystem::path& path)
+{
+    if (!film.valid())
+    {
+        std::cerr << "writeFilm: empty film.\n";
+        return false;
+    }
+
+    const std::string ext = PathUtil::extension(path);
+
+    if (ext == ".exr")
+        return writeExr(film, path);
+
+    if (ext == ".png")
+        return writePng(film, path);
+
+    std::cerr << "writeFilm: unsupported output format '" << ext << "' (use .exr or .png).\n";
+    return false;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+/**
+ * @brief Accumulation target of the CPU path tracer.
+ *
+ * Each pixel holds the running mean over all samples so far:
+ *   - rgb = exposed linear radiance (before tonemapping), zero for samples
+ *           that missed the scene;
+ *   - a   = coverage (fraction of samples that hit geometry).
+ *
+ * Row 0 is the top of the image.
+ */
+struct CpuFilm
+{
+    int32_t                width   = 0;
+    int32_t                height  = 0;
+    uint32_t               samples = 0; ///< Samples per pixel accumulated so far.
+    std::vector<glm::vec4> pixels  = {};
+
+    glm::vec3 background            = glm::vec3(0.0f); ///< Linear color behind uncovered pixels.
+    bool      transparentBackground = false;           ///< Write coverage as alpha instead of compositing.
+    bool      tonemap               = true;            ///< ACES for 8-bit outputs (matches RtScene.rchit).
+
+    void resize(int32_t w, int32_t h)
+    {
+        width   = w;
+        height  = h;
+        samples = 0;
+        pixels.assign(static_cast<std::size_t>(w) * static_cast<std::size_t>(h), glm::vec4(0.0f));
+    }
+
+    [[nodiscard]] bool valid() const noexcept
+    {
+        return width > 0 && height > 0 && pixels.size() == static_cast<std::size_t>(width) * height;
+    }
+};
+
+/**
+ * @brief Write @p film to disk; the format follows the extension.
+ *
+ *   - .exr: 32-bit float, uncompressed scanlines, linear (no tonemap),
+ *           premultiplied RGBA (alpha only if transparentBackground).
+ *   - .png: 8-bit sRGB, tonemapped if film.tonemap.
+ *
+ * @return false (and logs) on an unknown extension or I/O error.
+ */
+[[nodiscard]] bool writeFilm(const CpuFilm& film, const std::filesystem::path& path);
@@ -0,0 +1,623 @@
+//==============================================================
+// CpuPathTracer.cpp
+// Tile-based CPU path tracer over the scene's Embree BVH.
+//
+// Shading follows RtScene.rchit so a final frame looks like the RT
+// viewport: same light list (buildGpuLightsUBO), light BVH sampling,
+// GGX/Schlick BRDF, LIGHT_INTENSITY_SCALE and exposure mapping. Where the
+// shader fakes indirect light (studio IBL, ambient fill) this traces it:
+// diffuse/specular bounces that escape pick up the studio environment.
+//
+// Like the GPU path tracer (and picking), mesh space is world space.
+//==============================================================
+#include "CpuPathTracer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "CpuTraceCommon.hpp"
+#include "GpuLights.hpp"
+#include "LightBvh.hpp"
+#include "Scene.hpp"
+#include "SceneMesh.hpp"
+#include "SceneQueryEmbree.hpp"
+#include "TaskPool.hpp"
+#include "Viewport.hpp"
+
+namespace
+{
+    // Must match RtScene.rchit.
+    constexpr float    kLightIntensityScale = 5.0f; // LIGHT_INTENSITY_SCALE
+    constexpr uint32_t kExactLocalLights    = 8;    // RT_EXACT_LOCAL_LIGHTS
+    constexpr float    kShadowBiasMin       = 1e-3f;
+    constexpr float    kShadowBiasSlope     = 1e-4f;
+    constexpr float    kExposureEvMin       = -3.0f;
+    constexpr float    kExposureEvMax       = 3.0f;
+
+    // Weight of the studio environment seen by escaping bounce rays; the
+    // rchit diffuse IBL term uses the same 0.10 factor.
+    constexpr float kEnvStrength = 0.10f;
+
+    constexpr float kPi = 3.14159265f;
+
+    // ------------------------------------------------------------
+    // Math helpers (GLSL twins in RtScene.rchit)
+    // ------------------------------------------------------------
+    float saturate(float x) noexcept
+    {
+        return std::clamp(x, 0.0f, 1.0f);
+    }
+
+    float luminance(const glm::vec3& c) noexcept
+    {
+        return glm::dot(c, glm::vec3(0.2126f, 0.7152f, 0.0722f));
+    }
+
+    // ------------------------------------------------------------
+    // Scene snapshot (taken on the calling thread, read-only while tracing)
+    // ------------------------------------------------------------
+    struct TriData
+    {
+        std::array<glm::vec3, 3> normals  = {};
+        std::array<glm::vec2, 3> uvs      = {};
+        uint32_t                 material = 0;
+    };
+
+    struct SceneData
+    {
+        CpuTraceScene                     trace     = {};
+        std::vector<std::vector<TriData>> geoms     = {}; // [geomId][primId]; empty for hidden meshes
+        std::vector<CpuMaterial>          materials = {};
+        std::vector<CpuTexture>           textures  = {};
+
+        std::vector<GpuLight>        lights   = {};
+        uint32_t                     dirCount = 0;
+        std::vector<GpuLightBvhNode> lightBvh = {}; // empty: loop over all local lights
+
+        float iblScale      = 1.0f;
+        float exposure      = 1.0f;
+        bool  clampRadiance = false;
+        float clampMax      = 0.0f;
+    };
+
+    // Per-triangle corner normals/UVs (maps 0 and 1, see extractMeshData())
+    // and material, indexed like the Embree primitives.
+    void snapshotGeometry(SceneData& out)
+    {
+        const SceneQueryEmbree& query = *out.trace.query();
+
+        out.geoms.resize(query.geometryCount());
+
+        for (uint32_t g = 0; g < query.geometryCount(); ++g)
+        {
+            const SceneMesh* mesh = query.meshForGeometry(g);
+            const SysMesh*   sys  = mesh ? mesh->sysMesh() : nullptr;
+            if (!sys || !out.trace.visible(g))
+                continue;
+
+            std::vector<TriData>& tris = out.geoms[g];
+
+            const int32_t normMap = sys->map_find(0);
+            const int32_t uvMap   = sys->map_find(1);
+
+            const uint32_t primCount = query.primitiveCount(g);
+            tris.resize(primCount);
+
+            for (uint32_t p = 0; p < primCount; ++p)
+            {
+                int                poly  = -1;
+                std::array<int, 3> verts = {};
+                if (!query.primitive(g, p, poly, verts))
+                    continue;
+
+                const SysPolyVerts& pv = sys->poly_verts(poly);
+                const SysPolyVerts& pn = sys->map_poly_verts(normMap, poly);
+                const SysPolyVerts& pt = sys->map_poly_verts(uvMap, poly);
+
+                TriData& tri = tris[p];
+                tri.material = sys->poly_material(poly);
+
+                const glm::vec3 flat = sys->poly_normal(poly);
+
+                // Fan triangle (0, i, i + 1): find each corner's local index in the polygon.
+                int from = 0;
+                for (int j = 0; j < 3; ++j)
+                {
+                    int local = -1;
+                    for (int k = from; k < static_cast<int>(pv.size()); ++k)
+                    {
+                        if (pv[k] == verts[j])
+                        {
+                            local = k;
+                            break;
+                        }
+                    }
+
+                    tri.normals[j] = flat;
+                    tri.uvs[j]     = glm::vec2(0.0f);
+
+                    if (local < 0)
+                        continue;
+
+                    from = local + 1;
+
+                    if (local < static_cast<int>(pn.size()))
+                        tri.normals[j] = glm::make_vec3(sys->map_vert_position(normMap, pn[local]));
+
+                    if (local < static_cast<int>(pt.size()))
+                        tri.uvs[j] = glm::make_vec2(sys->map_vert_position(uvMap, pt[local]));
+                }
+            }
+        }
+    }
+
+    void snapshotLights(Scene& scene, const Viewport& vp, SceneData& out)
+    {
+        const LightingSettings& ls = scene.lightingSettings();
+
+        HeadlightSettings headlight = {};
+        headlight.enabled           = ls.useHeadlight;
+        headlight.intensity         = ls.headlightIntensity;
+
+        GpuLightsUBO ubo = {};
+        buildGpuLightsUBO(ls, headlight, vp, &scene, ubo, out.lights);
+
+        out.dirCount = std::min<uint32_t>(ubo.dirCount, static_cast<uint32_t>(out.lights.size()));
+
+        if (out.lights.size() - out.dirCount > kExactLocalLights)
+            buildLightBvh(out.lights, out.dirCount, out.lightBvh);
+
+        out.iblScale      = (ubo.count > 1u) ? 0.20f : 1.0f;
+        out.exposure      = std::exp2(glm::mix(kExposureEvMin, kExposureEvMax, saturate(ubo.exposure)));
+        out.clampRadiance = ls.clampRadiance;
+        out.clampMax      = ls.clampMax;
+    }
+
+    // ------------------------------------------------------------
+    // Shading
+    // ------------------------------------------------------------
+    struct Surface
+    {
+        glm::vec3 P         = glm::vec3(0.0f);
+        glm::vec3 N         = glm::vec3(0.0f, 1.0f, 0.0f); // shading normal, facing the ray origin
+        glm::vec3 Ng        = glm::vec3(0.0f, 1.0f, 0.0f); // geometric normal, same side
+        glm::vec3 albedo    = glm::vec3(1.0f);
+        glm::vec3 F0        = glm::vec3(0.04f);
+        glm::vec3 emissive  = glm::vec3(0.0f);
+        float     roughness = 0.5f;
+        float     metallic  = 0.0f;
+        float     alpha     = 0.25f;
+        float     bias      = kShadowBiasMin;
+    };
+
+    Surface makeSurface(const SceneData& sd, const CpuHit& hit, const glm::vec3& org, const glm::vec3& dir) noexcept
+    {
+        Surface s = {};
+        s.P       = org + dir * hit.t;
+        s.bias    = std::max(kShadowBiasMin, kShadowBiasSlope * hit.t);
+
+        const std::vector<TriData>& tris = sd.geoms[hit.geom];
+        const TriData*              tri  = (hit.prim < tris.size()) ? &tris[hit.prim] : nullptr;
+
+        // Embree: P = (1 - u - v) * v0 + u * v1 + v * v2
+        const float w = 1.0f - hit.u - hit.v;
+
+        glm::vec3 ng = (glm::dot(hit.ng, hit.ng) > 1e-30f) ? glm::normalize(hit.ng) : -dir;
+        if (glm::dot(ng, dir) > 0.0f)
+            ng = -ng;
+
+        glm::vec3 n  = ng;
+        glm::vec2 uv = glm::vec2(0.0f);
+
+        if (tri)
+        {
+            const glm::vec3 ni = tri->normals[0] * w + tri->normals[1] * hit.u + tri->normals[2] * hit.v;
+            if (glm::dot(ni, ni) > 1e-20f)
+                n = glm::normalize(ni);
+
+            uv = tri->uvs[0] * w + tri->uvs[1] * hit.u + tri->uvs[2] * hit.v;
+        }
+
+        // Backface handling (the rchit flips N for back-facing hits).
+        if (glm::dot(n, ng) < 0.0f)
+            n = -n;
+
+        s.N  = n;
+        s.Ng = ng;
+
+        CpuMaterial mat = {};
+        if (!sd.materials.empty())
+        {
+            const uint32_t matId = tri ? std::min<uint32_t>(tri->material, uint32_t(sd.materials.size() - 1)) : 0u;
+            mat                  = sd.materials[matId];
+        }
+
+        s.albedo = mat.baseColor;
+        if (mat.baseTex >= 0)
+            s.albedo *= sd.textures[mat.baseTex].sample(uv);
+
+        s.roughness = std::clamp(mat.roughness, 0.04f, 1.0f);
+        s.metallic  = std::clamp(mat.metallic, 0.0f, 1.0f);
+
+        // MRAO: r = ao (unused: occlusion is traced), g = roughness, b = metallic.
+        if (mat.mraoTex >= 0)
+        {
+            const glm::vec3 mrao = sd.textures[mat.mraoTex].sample(uv);
+            s.roughness          = std::clamp(s.roughness * mrao.g, 0.04f, 1.0f);
+            s.metallic           = std::clamp(s.metallic * mrao.b, 0.0f, 1.0f);
+        }
+
+        s.alpha = s.roughness * s.roughness;
+
+        const float ior = std::max(mat.ior, 1.0f);
+        const float f0s = std::pow((ior - 1.0f) / (ior + 1.0f), 2.0f);
+        s.F0            = glm::mix(glm::vec3(std::clamp(f0s, 0.02f, 0.08f)), s.albedo, s.metallic);
+
+        s.emissive = mat.emissive;
+        if (mat.emissiveTex >= 0)
+            s.emissive *= sd.textures[mat.emissiveTex].sample(uv);
+
+        return s;
+    }
+
+    // (diffuse + specular) BRDF, as in directLight() of RtScene.rchit.
+    glm::vec3 evalBrdf(const Surface& s, const glm::vec3& V, const glm::vec3& L) noexcept
+    {
+        const float NdotL = saturate(glm::dot(s.N, L));
+        const float NdotV = saturate(glm::dot(s.N, V));
+        if (NdotL <= 0.0f || NdotV <= 0.0f)
+            return glm::vec3(0.0f);
+
+        const glm::vec3 H     = glm::normalize(V + L);
+        const float     NdotH = saturate(glm::dot(s.N, H));
+        const float     VdotH = saturate(glm::dot(V, H));
+
+        const glm::vec3 F = cpuFresnelSchlick(VdotH, s.F0);
+        const float     D = cpuGgxD(NdotH, s.alpha);
+
+        const float r = s.roughness + 1.0f;
+        const float k = (r * r) / 8.0f;
+        const float G = cpuSmithG(NdotV, NdotL, k);
+
+        const glm::vec3 spec = (D * G * F) / std::max(4.0f * NdotV * NdotL, 1e-7f);
+        const glm::vec3 kd   = (glm::vec3(1.0f) - F) * (1.0f - s.metallic);
+        const glm::vec3 diff = kd * s.albedo / kPi;
+
+        return diff + spec;
+    }
+
+    // One light with one (cone-jittered) shadow ray; noise averages out over samples.
+    glm::vec3 directLight(const SceneData& sd, const GpuLight& Ld, const Surface& s, const glm::vec3& V, CpuRng& rng) noexcept
+    {
+        const CpuLightSample ls = cpuEvalLight(Ld, s.P);
+
+        const float NdotL = saturate(glm::dot(s.N, ls.L));
+        if (NdotL <= 0.0f || ls.atten <= 0.0f)
+            return glm::vec3(0.0f);
+
+        const glm::vec3 brdf = evalBrdf(s, V, ls.L);
+        if (brdf == glm::vec3(0.0f))
+            return glm::vec3(0.0f);
+
+        const glm::vec3 shadowDir = (ls.angRad > 0.0f) ? cpuConeSample(ls.L, ls.angRad, rng.next(), rng.next()) : ls.L;
+        if (sd.trace.occluded(s.P + s.Ng * s.bias, shadowDir, ls.tMax))
+            return glm::vec3(0.0f);
+
+        return brdf * Ld.color * (Ld.intensity * kLightIntensityScale * ls.atten) * NdotL;
+    }
+
+    // lightBvhImportance() / sampleLightBvh() of RtScene.rchit.
+    float lightBvhImportance(const GpuLightBvhNode& nd, const glm::vec3& P, const glm::vec3& N) noexcept
+    {
+        const glm::vec3 c   = 0.5f * (nd.boundsMin + nd.boundsMax);
+        const glm::vec3 ext = 0.5f * (nd.boundsMax - nd.boundsMin);
+        const glm::vec3 d   = c - P;
+
+        if (glm::dot(N, d) + glm::dot(glm::abs(N), ext) < 0.0f)
+            return 0.0f;
+
+        return nd.power / std::max(glm::dot(d, d), std::max(glm::dot(ext, ext), 1e-4f));
+    }
+
+    int sampleLightBvh(const std::vector<GpuLightBvhNode>& nodes, const glm::vec3& P, const glm::vec3& N, float u, float& pdf) noexcept
+    {
+        pdf = 1.0f;
+
+        uint32_t node = 0;
+        for (int depth = 0; depth < 64 && node < nodes.size(); ++depth)
+        {
+            const GpuLightBvhNode& nd = nodes[node];
+
+            if ((nd.child & kLightBvhLeaf) != 0u)
+                return int(nd.child & ~kLightBvhLeaf);
+
+            const uint32_t c0 = nd.child;
+            if (c0 + 1 >= nodes.size())
+                return -1;
+
+            const float w0 = lightBvhImportance(nodes[c0], P, N);
+            const float w1 = lightBvhImportance(nodes[c0 + 1], P, N);
+            const float ws = w0 + w1;
+            if (!(ws > 0.0f))
+                return -1;
+
+            const float p0 = w0 / ws;
+            if (u < p0)
+            {
+                node = c0;
+                pdf *= p0;
+                u = u / p0;
+            }
+            else
+            {
+                node = c0 + 1;
+                pdf *= 1.0f - p0;
+                u = (u - p0) / std::max(1.0f - p0, 1e-7f);
+            }
+            u = std::min(u, 0.99999994f);
+        }
+
+        return -1;
+    }
+
+    glm::vec3 directLighting(const SceneData& sd, const Surface& s, const glm::vec3& V, CpuRng& rng) noexcept
+    {
+        glm::vec3 sum = glm::vec3(0.0f);
+
+        const uint32_t lightCount = static_cast<uint32_t>(sd.lights.size());
+
+        for (uint32_t i = 0; i < sd.dirCount; ++i)
+            sum += directLight(sd, sd.lights[i], s, V, rng);
+
+        if (sd.lightBvh.empty())
+        {
+            for (uint32_t i = sd.dirCount; i < lightCount; ++i)
+                sum += directLight(sd, sd.lights[i], s, V, rng);
+        }
+        else
+        {
+            float     pdf = 0.0f;
+            const int li  = sampleLightBvh(sd.lightBvh, s.P, s.N, std::min(rng.next(), 0.99999994f), pdf);
+            if (li >= 0 && uint32_t(li) < lightCount && pdf > 0.0f)
+                sum += directLight(sd, sd.lights[li], s, V, rng) / pdf;
+        }
+
+        return sum;
+    }
+
+    // Next path direction: GGX half-vector or cosine sampling, picked by the
+    // Fresnel/albedo balance. The weight uses the combined pdf of both lobes.
+    bool sampleBounce(const Surface& s, const glm::vec3& V, CpuRng& rng, glm::vec3& outDir, glm::vec3& outWeight) noexcept
+    {
+        const float     NdotV = std::max(glm::dot(s.N, V), 1e-4f);
+        const glm::vec3 Fv    = cpuFresnelSchlick(NdotV, s.F0);
+
+        const float specW = luminance(Fv);
+        const float diffW = luminance(s.albedo) * (1.0f - s.metallic) * (1.0f - specW);
+        if (!(specW + diffW > 0.0f))
+            return false;
+
+        const float pSpec = std::clamp(specW / (specW + diffW), 0.1f, 0.9f);
+
+        const float u0 = rng.next();
+        const float u1 = rng.next();
+        const float u2 = rng.next();
+
+        glm::vec3 L;
+        if (u0 < pSpec)
+        {
+            const float a2   = s.alpha * s.alpha;
+            const float cosT = std::sqrt((1.0f - u1) / (1.0f + (a2 - 1.0f) * u1));
+            const float sinT = std::sqrt(std::max(1.0f - cosT * cosT, 0.0f));
+            const float phi  = 2.0f * kPi * u2;
+
+            const glm::vec3 H = cpuFromBasis(s.N, std::cos(phi) * sinT, std::sin(phi) * sinT, cosT);
+            L                 = glm::reflect(-V, H);
+        }
+        else
+        {
+            L = cpuCosineSample(s.N, u1, u2);
+        }
+
+        const float NdotL = glm::dot(s.N, L);
+        if (NdotL <= 0.0f || glm::dot(s.Ng, L) <= 0.0f)
+            return false;
+
+        const glm::vec3 H     = glm::normalize(V + L);
+        const float     NdotH = saturate(glm::dot(s.N, H));
+        const float     VdotH = std::max(glm::dot(V, H), 1e-4f);
+
+        const float pdfSpec = cpuGgxD(NdotH, s.alpha) * NdotH / (4.0f * VdotH);
+        const float pdfDiff = NdotL / kPi;
+        const float pdf     = pSpec * pdfSpec + (1.0f - pSpec) * pdfDiff;
+        if (!(pdf > 1e-7f))
+            return false;
+
+        outDir    = L;
+        outWeight = evalBrdf(s, V, L) * (NdotL / pdf);
+        return true;
+    }
+
+    glm::vec3 clampContribution(const SceneData& sd, const glm::vec3& c) noexcept
+    {
+        if (!sd.clampRadiance || sd.clampMax <= 0.0f)
+            return c;
+
+        return glm::min(c, glm::vec3(sd.clampMax));
+    }
+
+    // Radiance along one camera ray (rgb, exposed) and coverage (a).
+    glm::vec4 traceSample(const SceneData&         sd,
+                          const CpuRenderSettings& settings,
+                          glm::vec3                org,
+                          glm::vec3                dir,
+                          CpuRng&                  rng) noexcept
+    {
+        glm::vec3 radiance   = glm::vec3(0.0f);
+        glm::vec3 throughput = glm::vec3(1.0f);
+
+        for (uint32_t bounce = 0;; ++bounce)
+        {
+            const CpuHit hit = sd.trace.intersect(org, dir, std::numeric_limits<float>::max());
+
+            if (!hit.valid)
+            {
+                if (bounce == 0)
+                    return glm::vec4(0.0f);
+
+                radiance += clampContribution(sd, throughput * cpuStudioEnv(dir) * (kEnvStrength * sd.iblScale));
+                break;
+            }
+
+            const Surface   s = makeSurface(sd, hit, org, dir);
+            const glm::vec3 V = -dir;
+
+            glm::vec3 contrib = throughput * (s.emissive + directLighting(sd, s, V, rng));
+            radiance += (bounce == 0) ? contrib : clampContribution(sd, contrib);
+
+            if (bounce >= settings.maxBounces)
+                break;
+
+            glm::vec3 nextDir;
+            glm::vec3 weight;
+            if (!sampleBounce(s, V, rng, nextDir, weight))
+                break;
+
+            throughput *= weight;
+
+            // Russian roulette once the path has had a chance to pick up indirect light.
+            if (bounce >= 2)
+            {
+                const float pContinue = std::clamp(std::max(throughput.x, std::max(throughput.y, throughput.z)), 0.05f, 0.95f);
+                if (rng.next() >= pContinue)
+                    break;
+
+                throughput /= pContinue;
+            }
+
+            org = s.P + s.Ng * s.bias;
+            dir = nextDir;
+        }
+
+        return glm::vec4(radiance * sd.exposure, 1.0f);
+    }
+
+    struct Tile
+    {
+        int32_t x0 = 0;
+        int32_t y0 = 0;
+        int32_t x1 = 0;
+        int32_t y1 = 0;
+    };
+} // namespace
+
+bool renderPathTraced(Scene&                   scene,
+                      const Viewport&          vp,
+                      const CpuRenderSettings& settings,
+                      CpuFilm&                 film,
+                      const CpuRenderProgress& progress)
+{
+    const int32_t width  = (settings.width > 0) ? settings.width : vp.width();
+    const int32_t height = (settings.height > 0) ? settings.height : vp.height();
+    if (width <= 0 || height <= 0 || settings.samplesPerPixel == 0)
+    {
+        std::cerr << "renderPathTraced: empty image or zero samples.\n";
+        return false;
+    }
+
+    // Holds a reference on the BVH, so a rebuild meanwhile cannot free it.
+    SceneData sd = {};
+    if (!sd.trace.init(scene))
+        return false;
+
+    snapshotGeometry(sd);
+    cpuSnapshotMaterials(scene, sd.materials, sd.textures);
+    snapshotLights(scene, vp, sd);
+
+    film.resize(width, height);
+    film.background            = glm::vec3(vp.clearColor());
+    film.transparentBackground = settings.transparentBackground;
+    film.tonemap               = scene.lightingSettings().tonemap;
+
+    // Camera rays exactly as RtScene.rgen builds them (Vulkan NDC, row 0 at the top).
+    const glm::mat4 invViewProj = glm::inverse(vp.projection() * vp.view());
+
+    const uint32_t tileSize = std::max<uint32_t>(settings.tileSize, 1u);
+
+    std::vector<Tile> tiles = {};
+    for (int32_t y = 0; y < height; y += int32_t(tileSize))
+    {
+        for (int32_t x = 0; x < width; x += int32_t(tileSize))
+            tiles.push_back({x, y, std::min(x + int32_t(tileSize), width), std::min(y + int32_t(tileSize), height)});
+    }
+
+    uint32_t threads = settings.threadCount;
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<uint32_t>(threads, static_cast<uint32_t>(tiles.size()));
+
+    TaskPool pool(threads);
+
+    while (film.samples < settings.samplesPerPixel)
+    {
+        const uint32_t first = film.samples;
+        const uint32_t count = std::min(std::max(settings.samplesPerPass, 1u), settings.samplesPerPixel - first);
+
+        std::atomic<std::size_t> nextTile{0};
+
+        auto worker = [&] {
+            for (std::size_t ti = nextTile++; ti < tiles.size(); ti = nextTile++)
+            {
+                const Tile& tile = tiles[ti];
+
+                for (int32_t y = tile.y0; y < tile.y1; ++y)
+                {
+                    for (int32_t x = tile.x0; x < tile.x1; ++x)
+                    {
+                        glm::vec4 sum = glm::vec4(0.0f);
+
+                        for (uint32_t si = first; si < first + count; ++si)
+                        {
+                            CpuRng rng(settings.seed, uint32_t(x), uint32_t(y), si);
+
+                            const glm::vec2 uv  = (glm::vec2(float(x), float(y)) + glm::vec2(rng.next(), rng.next())) /
+                                                 glm::vec2(float(width), float(height));
+                            const glm::vec2 ndc = uv * 2.0f - 1.0f;
+
+                            const glm::vec4 p0h = invViewProj * glm::vec4(ndc, 0.0f, 1.0f);
+                            const glm::vec4 p1h = invViewProj * glm::vec4(ndc, 1.0f, 1.0f);
+                            const glm::vec3 p0  = glm::vec3(p0h) / p0h.w;
+                            const glm::vec3 p1  = glm::vec3(p1h) / p1h.w;
+
+                            sum += traceSample(sd, settings, p0, glm::normalize(p1 - p0), rng);
+                        }
+
+                        // Incremental mean; each pixel belongs to exactly one tile.
+                        glm::vec4& px = film.pixels[std::size_t(y) * width + x];
+                        px            = (px * float(first) + sum) / float(first + count);
+                    }
+                }
+            }
+        };
+
+        for (uint32_t t = 0; t < pool.threadCount(); ++t)
+            pool.submit(worker);
+
+        pool.waitIdle();
+
+        film.samples = first + count;
+
+        if (progress && !progress(film))
+            break;
+    }
+
+    return true;
+}
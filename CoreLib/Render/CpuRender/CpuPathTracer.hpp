@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "CpuFilm.hpp"
+
+class Scene;
+class Viewport;
+
+/**
+ * @brief Settings of a CPU path-traced render.
+ */
+struct CpuRenderSettings
+{
+    int32_t  width           = 0;  ///< 0 = viewport width.
+    int32_t  height          = 0;  ///< 0 = viewport height.
+    uint32_t samplesPerPixel = 64; ///< Total samples per pixel.
+    uint32_t samplesPerPass  = 4;  ///< Samples added per progressive pass.
+    uint32_t maxBounces      = 4;  ///< Indirect bounces after the primary hit.
+    uint32_t seed            = 0;  ///< Same seed + scene + settings = same image.
+    uint32_t tileSize        = 32; ///< Square tile edge in pixels.
+    uint32_t threadCount     = 0;  ///< 0 = hardware_concurrency().
+
+    bool transparentBackground = false;
+};
+
+/**
+ * @brief Progress hook, called after each pass with the film so far.
+ * @return false to stop early (the film keeps the samples done).
+ */
+using CpuRenderProgress = std::function<bool(const CpuFilm& film)>;
+
+/**
+ * @brief Path trace @p scene as seen from @p vp into @p film.
+ *
+ * Final-frame renderer for headless use: no Vulkan device or swapchain is
+ * involved. Rays are traced against the scene's Embree BVH
+ * (SceneQueryEmbree) and shaded from the same Material, Image and light
+ * data the RT viewport uses (buildGpuLightsUBO(), light BVH, BRDF,
+ * exposure), adding diffuse/specular bounces with next-event estimation.
+ *
+ * Work is split into tiles spread over worker threads. Random numbers are
+ * hashed from (seed, pixel, sample), so the result does not depend on the
+ * thread count or scheduling. Samples are accumulated in passes of
+ * samplesPerPass; @p progress sees each intermediate film.
+ *
+ * Blocks the caller. Call Scene::idle() first so the BVH matches the scene.
+ *
+ * @return false (and logs) if there is nothing to render.
+ */
+[[nodiscard]] bool renderPathTraced(Scene&                   scene,
+                                    const Viewport&          vp,
+                                    const CpuRenderSettings& settings,
+                                    CpuFilm&                 film,
+                                    const CpuRenderProgress& progress = {});
@@ -0,0 +1,1042 @@
+//==============================================================
+// CpuRasterizer.cpp
+// Tiled, multi-threaded software rasterizer for the viewport.
+//
+// Frame flow:
+//  1) Mesh streams (cached extractMeshData()/extractMeshEdges()) are
+//     transformed, near-clipped and set up in parallel chunks.
+//  2) Triangles and edges are binned into screen tiles.
+//  3) Each worker takes whole tiles: a 4-wide edge-function + depth test
+//     fills a visibility buffer, covered pixels are shaded once, edges are
+//     drawn on top, and the tile is written out sRGB encoded.
+//
+// Shading mirrors SolidDraw.frag / ShadedDraw.frag; depth follows the
+// viewport's ZO projection with Y flipped (row 0 at the top).
+//==============================================================
+#include "CpuRasterizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CPU_RASTER_SSE2 1
+#include <emmintrin.h>
+#else
+#define CPU_RASTER_SSE2 0
+#endif
+
+#include "CpuTraceCommon.hpp"
+#include "GpuLights.hpp"
+#include "Scene.hpp"
+#include "SceneMesh.hpp"
+#include "TaskPool.hpp"
+#include "Viewport.hpp"
+
+namespace
+{
+    constexpr float    kLightIntensityScale = 5.0f; // LIGHT_INTENSITY_SCALE
+    constexpr float    kExposureEvMin       = -3.0f;
+    constexpr float    kExposureEvMax       = 3.0f;
+    constexpr uint32_t kNoTriangle          = 0xFFFFFFFFu;
+    constexpr uint32_t kChunkPrimitives     = 4096; // triangles or edges per setup task
+
+    // Renderer.cpp edge colors.
+    const glm::vec4 kWireVisibleColor = glm::vec4(0.85f, 0.85f, 0.85f, 1.0f);
+    const glm::vec4 kWireHiddenColor  = glm::vec4(0.85f, 0.85f, 0.85f, 0.25f);
+    const glm::vec4 kSolidEdgeColor   = glm::vec4(0.10f, 0.10f, 0.10f, 0.5f);
+
+    float saturate(float x) noexcept
+    {
+        return std::clamp(x, 0.0f, 1.0f);
+    }
+
+    glm::vec3 tonemapACES(const glm::vec3& x) noexcept
+    {
+        constexpr float a = 2.51f;
+        constexpr float b = 0.03f;
+        constexpr float c = 2.43f;
+        constexpr float d = 0.59f;
+        constexpr float e = 0.14f;
+        return glm::clamp((x * (a * x + b)) / (x * (c * x + d) + e), 0.0f, 1.0f);
+    }
+
+    // The swapchain is SRGB; the frame gets the same encoding. 12-bit input keeps dark gradients smooth.
+    const std::array<uint8_t, 4096>& linearToSrgbTable()
+    {
+        static const std::array<uint8_t, 4096> table = [] {
+            std::array<uint8_t, 4096> t = {};
+            for (int i = 0; i < 4096; ++i)
+            {
+                const float c = float(i) / 4095.0f;
+                const float s = (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+                t[i]          = static_cast<uint8_t>(std::lround(saturate(s) * 255.0f));
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    uint32_t packSrgb(const glm::vec3& c) noexcept
+    {
+        const auto& lut = linearToSrgbTable();
+
+        const uint32_t r = lut[static_cast<int>(saturate(c.x) * 4095.0f + 0.5f)];
+        const uint32_t g = lut[static_cast<int>(saturate(c.y) * 4095.0f + 0.5f)];
+        const uint32_t b = lut[static_cast<int>(saturate(c.z) * 4095.0f + 0.5f)];
+        return r | (g << 8) | (b << 16) | 0xFF000000u;
+    }
+
+    // ------------------------------------------------------------
+    // Frame inputs
+    // ------------------------------------------------------------
+    struct FrameData
+    {
+        DrawMode  mode    = DrawMode::SOLID;
+        glm::vec3 camPos  = glm::vec3(0.0f);
+        glm::vec3 viewDir = glm::vec3(0.0f, 0.0f, -1.0f);
+        bool      ortho   = false;
+        glm::vec3 clear   = glm::vec3(0.0f);
+
+        std::vector<CpuMaterial> materials = {};
+        std::vector<CpuTexture>  textures  = {};
+
+        std::vector<GpuLight> lights   = {};
+        glm::vec3             ambient  = glm::vec3(0.0f);
+        float                 exposure = 1.0f;
+        float                 iblScale = 1.0f;
+    };
+
+    // Clip-space corner with the attributes the fragment shaders read.
+    struct ClipVert
+    {
+        glm::vec4 clip = glm::vec4(0.0f);
+        glm::vec3 pos  = glm::vec3(0.0f); ///< World
+        glm::vec3 nrm  = glm::vec3(0.0f); ///< World
+        glm::vec2 uv   = glm::vec2(0.0f);
+    };
+
+    ClipVert lerp(const ClipVert& a, const ClipVert& b, float t) noexcept
+    {
+        ClipVert v = {};
+        v.clip     = glm::mix(a.clip, b.clip, t);
+        v.pos      = glm::mix(a.pos, b.pos, t);
+        v.nrm      = glm::mix(a.nrm, b.nrm, t);
+        v.uv       = glm::mix(a.uv, b.uv, t);
+        return v;
+    }
+
+    /**
+     * Screen-space triangle, ready to rasterize.
+     *
+     * Edge functions are pre-scaled by 1 / area, so at a pixel centre
+     * (ea[i] * x + eb[i] * y + ec[i]) is the screen barycentric of corner i.
+     */
+    struct RasterTri
+    {
+        float ea[3] = {};
+        float eb[3] = {};
+        float ec[3] = {};
+
+        float za = 0.0f; ///< Depth plane: z = za * x + zb * y + zc.
+        float zb = 0.0f;
+        float zc = 0.0f;
+
+        float     invW[3] = {};
+        glm::vec3 pos[3]  = {};
+        glm::vec3 nrm[3]  = {};
+        glm::vec2 uv[3]   = {};
+
+        glm::vec3 faceN    = glm::vec3(0.0f, 1.0f, 0.0f); ///< World, unit.
+        uint32_t  material = 0;
+        bool      backface = false;
+
+        int32_t x0 = 0; ///< Inclusive pixel bounds, clamped to the frame.
+        int32_t y0 = 0;
+        int32_t x1 = -1;
+        int32_t y1 = -1;
+    };
+
+    struct RasterLine
+    {
+        glm::vec3 a = glm::vec3(0.0f); ///< Screen x, y and device depth.
+        glm::vec3 b = glm::vec3(0.0f);
+    };
+
+    glm::vec2 toScreen(const glm::vec4& clip, int32_t w, int32_t h) noexcept
+    {
+        return glm::vec2((clip.x / clip.w * 0.5f + 0.5f) * float(w), (clip.y / clip.w * 0.5f + 0.5f) * float(h));
+    }
+
+    void setupTriangle(const ClipVert (&v)[3],
+                       const glm::vec3&         faceN,
+                       uint32_t                 material,
+                       bool                     backface,
+                       int32_t                  w,
+                       int32_t                  h,
+                       std::vector<RasterTri>&  out)
+    {
+        glm::vec2 p[3] = {toScreen(v[0].clip, w, h), toScreen(v[1].clip, w, h), toScreen(v[2].clip, w, h)};
+        int       k[3] = {0, 1, 2};
+
+        float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+        if (!(std::abs(area) > 1e-10f))
+            return;
+
+        // Positive orientation, so "inside" is all three edge functions >= 0.
+        if (area < 0.0f)
+        {
+            std::swap(p[1], p[2]);
+            std::swap(k[1], k[2]);
+            area = -area;
+        }
+
+        const float minX = std::min(p[0].x, std::min(p[1].x, p[2].x));
+        const float minY = std::min(p[0].y, std::min(p[1].y, p[2].y));
+        const float maxX = std::max(p[0].x, std::max(p[1].x, p[2].x));
+        const float maxY = std::max(p[0].y, std::max(p[1].y, p[2].y));
+
+        RasterTri t = {};
+        t.x0        = std::max(0, static_cast<int32_t>(std::ceil(minX - 0.5f)));
+        t.y0        = std::max(0, static_cast<int32_t>(std::ceil(minY - 0.5f)));
+        t.x1        = std::min(w - 1, static_cast<int32_t>(std::floor(maxX - 0.5f)));
+        t.y1        = std::min(h - 1, static_cast<int32_t>(std::floor(maxY - 0.5f)));
+        if (t.x0 > t.x1 || t.y0 > t.y1)
+            return;
+
+        const float invArea = 1.0f / area;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            // Edge opposite corner i: from corner i + 1 to corner i + 2.
+            const glm::vec2& a = p[(i + 1) % 3];
+            const glm::vec2& b = p[(i + 2) % 3];
+
+            t.ea[i] = (a.y - b.y) * invArea;
+            t.eb[i] = (b.x - a.x) * invArea;
+            t.ec[i] = ((b.y - a.y) * a.x - (b.x - a.x) * a.y) * invArea;
+
+            const ClipVert& src = v[k[i]];
+            t.invW[i]           = 1.0f / src.clip.w;
+            t.pos[i]            = src.pos;
+            t.nrm[i]            = src.nrm;
+            t.uv[i]             = src.uv;
+        }
+
+        // Device depth is affine in screen space.
+        for (int i = 0; i < 3; ++i)
+        {
+            const float z = v[k[i]].clip.z / v[k[i]].clip.w;
+            t.za += z * t.ea[i];
+            t.zb += z * t.eb[i];
+            t.zc += z * t.ec[i];
+        }
+
+        t.faceN    = faceN;
+        t.material = material;
+        t.backface = backface;
+
+        out.push_back(t);
+    }
+
+    // Clip against the near plane (z >= 0, ZO depth), then fan into set-up triangles.
+    void clipAndSetup(const ClipVert (&v)[3],
+                      const glm::vec3&        faceN,
+                      uint32_t                material,
+                      bool                    backface,
+                      int32_t                 w,
+                      int32_t                 h,
+                      std::vector<RasterTri>& out)
+    {
+        // Trivial reject: all corners outside one side plane.
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            if (v[0].clip[axis] > v[0].clip.w && v[1].clip[axis] > v[1].clip.w && v[2].clip[axis] > v[2].clip.w)
+                return;
+            if (v[0].clip[axis] < -v[0].clip.w && v[1].clip[axis] < -v[1].clip.w && v[2].clip[axis] < -v[2].clip.w)
+                return;
+        }
+
+        const bool in0 = v[0].clip.z >= 0.0f;
+        const bool in1 = v[1].clip.z >= 0.0f;
+        const bool in2 = v[2].clip.z >= 0.0f;
+
+        if (in0 && in1 && in2)
+        {
+            setupTriangle(v, faceN, material, backface, w, h, out);
+            return;
+        }
+
+        if (!in0 && !in1 && !in2)
+            return;
+
+        ClipVert poly[4] = {};
+        int      n       = 0;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const ClipVert& a = v[i];
+            const ClipVert& b = v[(i + 1) % 3];
+
+            const bool aIn = a.clip.z >= 0.0f;
+            const bool bIn = b.clip.z >= 0.0f;
+
+            if (aIn)
+                poly[n++] = a;
+
+            if (aIn != bIn)
+                poly[n++] = lerp(a, b, a.clip.z / (a.clip.z - b.clip.z));
+        }
+
+        for (int i = 1; i + 1 < n; ++i)
+        {
+            const ClipVert tri[3] = {poly[0], poly[i], poly[i + 1]};
+            setupTriangle(tri, faceN, material, backface, w, h, out);
+        }
+    }
+
+    bool clipLine(glm::vec4 a, glm::vec4 b, int32_t w, int32_t h, std::vector<RasterLine>& out)
+    {
+        if (a.z < 0.0f && b.z < 0.0f)
+            return false;
+
+        if (a.z < 0.0f)
+            a = glm::mix(a, b, a.z / (a.z - b.z));
+        else if (b.z < 0.0f)
+            b = glm::mix(b, a, b.z / (b.z - a.z));
+
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            if ((a[axis] > a.w && b[axis] > b.w) || (a[axis] < -a.w && b[axis] < -b.w))
+                return false;
+        }
+
+        RasterLine l = {};
+        l.a          = glm::vec3(toScreen(a, w, h), a.z / a.w);
+        l.b          = glm::vec3(toScreen(b, w, h), b.z / b.w);
+        out.push_back(l);
+        return true;
+    }
+
+    // ------------------------------------------------------------
+    // Coverage + depth test of 4 horizontal pixels
+    // ------------------------------------------------------------
+
+    /**
+     * Pixel centres (px + i, py), i = 0..3. Writes their depth to @p zOut and
+     * returns a bit per pixel that is inside @p t and closer than @p depth.
+     */
+    uint32_t testQuad(const RasterTri& t, float px, float py, const float* depth, float* zOut) noexcept
+    {
+#if CPU_RASTER_SSE2
+        const __m128 x    = _mm_add_ps(_mm_set1_ps(px), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+        const __m128 zero = _mm_setzero_ps();
+
+        const __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.ea[0]), x), _mm_set1_ps(t.eb[0] * py + t.ec[0]));
+        const __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.ea[1]), x), _mm_set1_ps(t.eb[1] * py + t.ec[1]));
+        const __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.ea[2]), x), _mm_set1_ps(t.eb[2] * py + t.ec[2]));
+
+        const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+        if (_mm_movemask_ps(inside) == 0)
+            return 0;
+
+        const __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.za), x), _mm_set1_ps(t.zb * py + t.zc));
+        _mm_storeu_ps(zOut, z);
+
+        const __m128 closer = _mm_cmplt_ps(z, _mm_loadu_ps(depth));
+        return static_cast<uint32_t>(_mm_movemask_ps(_mm_and_ps(inside, closer)));
+#else
+        uint32_t mask = 0;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            const float x = px + float(i);
+
+            const float e0 = t.ea[0] * x + t.eb[0] * py + t.ec[0];
+            const float e1 = t.ea[1] * x + t.eb[1] * py + t.ec[1];
+            const float e2 = t.ea[2] * x + t.eb[2] * py + t.ec[2];
+            if (e0 < 0.0f || e1 < 0.0f || e2 < 0.0f)
+                continue;
+
+            zOut[i] = t.za * x + t.zb * py + t.zc;
+            if (zOut[i] < depth[i])
+                mask |= 1u << i;
+        }
+
+        return mask;
+#endif
+    }
+
+    // ------------------------------------------------------------
+    // Shading
+    // ------------------------------------------------------------
+    struct Fragment
+    {
+        glm::vec3 P        = glm::vec3(0.0f);
+        glm::vec3 N        = glm::vec3(0.0f, 1.0f, 0.0f);
+        glm::vec2 uv       = glm::vec2(0.0f);
+        uint32_t  material = 0;
+        bool      backface = false;
+    };
+
+    Fragment interpolate(const RasterTri& t, float px, float py) noexcept
+    {
+        float q[3] = {};
+        float sum  = 0.0f;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            q[i] = std::max(t.ea[i] * px + t.eb[i] * py + t.ec[i], 0.0f) * t.invW[i];
+            sum += q[i];
+        }
+
+        const float inv = (sum > 0.0f) ? 1.0f / sum : 0.0f;
+
+        Fragment f = {};
+        f.material = t.material;
+        f.backface = t.backface;
+
+        glm::vec3 n = glm::vec3(0.0f);
+        for (int i = 0; i < 3; ++i)
+        {
+            const float w = q[i] * inv;
+            f.P += t.pos[i] * w;
+            n += t.nrm[i] * w;
+            f.uv += t.uv[i] * w;
+        }
+
+        f.N = (glm::dot(n, n) > 1e-20f) ? glm::normalize(n) : t.faceN;
+        return f;
+    }
+
+    const CpuMaterial* materialOf(const FrameData& fd, uint32_t id) noexcept
+    {
+        if (fd.materials.empty())
+            return nullptr;
+
+        return &fd.materials[std::min<std::size_t>(id, fd.materials.size() - 1)];
+    }
+
+    glm::vec3 viewVector(const FrameData& fd, const glm::vec3& P) noexcept
+    {
+        const glm::vec3 v = fd.camPos - P;
+        return (glm::dot(v, v) > 1e-20f) ? glm::normalize(v) : -fd.viewDir;
+    }
+
+    // SolidDraw.frag
+    glm::vec3 shadeSolid(const FrameData& fd, const Fragment& f) noexcept
+    {
+        glm::vec3 N = f.backface ? -f.N : f.N;
+
+        const glm::vec3 V = viewVector(fd, f.P);
+
+        glm::vec3 base = glm::vec3(0.8f);
+        if (const CpuMaterial* mat = materialOf(fd, f.material))
+        {
+            base = mat->baseColor;
+            if (mat->baseTex >= 0)
+                base *= fd.textures[mat->baseTex].sample(f.uv);
+        }
+
+        // Headlight (fallback) in WORLD space; light 0 when there is one.
+        glm::vec3 L = glm::normalize(glm::vec3(0.25f, 0.35f, -0.90f));
+        glm::vec3 c = glm::vec3(1.0f);
+        float     I = 1.0f;
+
+        if (!fd.lights.empty() && glm::dot(fd.lights[0].direction, fd.lights[0].direction) > 1e-12f)
+        {
+            L = glm::normalize(-fd.lights[0].direction);
+            c = fd.lights[0].color;
+            I = fd.lights[0].intensity;
+        }
+
+        const float NdotL = saturate(glm::dot(N, L));
+        const float diff  = std::pow(NdotL, 1.65f);
+
+        glm::vec3 lit = base * 0.06f;
+
+        const float hemi = saturate(N.y * 0.5f + 0.5f);
+        lit *= glm::mix(0.75f, 1.0f, hemi);
+
+        lit += base * (c * (I * diff)) * 0.90f;
+
+        const glm::vec3 H    = glm::normalize(V + L);
+        const float     spec = std::pow(saturate(glm::dot(N, H)), 48.0f) * 0.035f;
+        lit += (c * I) * spec;
+
+        const float rim = std::pow(1.0f - saturate(glm::dot(N, V)), 3.0f);
+        lit += base * rim * 0.010f;
+
+        if (f.backface)
+        {
+            constexpr float kInnerFaceDim = 0.35f;
+            const glm::vec3 baseLine      = base * 0.06f;
+            lit                           = baseLine + (lit - baseLine) * kInnerFaceDim;
+        }
+
+        return lit / (glm::vec3(1.0f) + lit);
+    }
+
+    // shadeLight() of ShadedDraw.frag
+    glm::vec3 shadeLight(const GpuLight&  Ld,
+                         const glm::vec3& P,
+                         const glm::vec3& N,
+                         const glm::vec3& V,
+                         const glm::vec3& albedo,
+                         const glm::vec3& F0,
+                         float            roughness,
+                         float            metallic,
+                         float            alpha) noexcept
+    {
+        // What the light clusters skip on the GPU.
+        if (Ld.type != static_cast<uint32_t>(GpuLightType::Directional) && Ld.spot_params.w > 0.0f &&
+            glm::distance(P, Ld.position) > Ld.spot_params.w)
+            return glm::vec3(0.0f);
+
+        const CpuLightSample ls = cpuEvalLight(Ld, P);
+
+        const float NdotL = saturate(glm::dot(N, ls.L));
+        const float NdotV = saturate(glm::dot(N, V));
+        if (NdotL <= 0.0f || NdotV <= 0.0f || ls.atten <= 0.0f)
+            return glm::vec3(0.0f);
+
+        const glm::vec3 H     = glm::normalize(V + ls.L);
+        const float     NdotH = saturate(glm::dot(N, H));
+        const float     VdotH = saturate(glm::dot(V, H));
+
+        const glm::vec3 F = cpuFresnelSchlick(VdotH, F0);
+        const float     D = cpuGgxD(NdotH, alpha);
+
+        const float r = roughness + 1.0f;
+        const float k = (r * r) / 8.0f;
+        const float G = cpuSmithG(NdotV, NdotL, k);
+
+        const glm::vec3 spec = (D * G * F) / std::max(4.0f * NdotV * NdotL, 1e-7f);
+        const glm::vec3 kd   = (glm::vec3(1.0f) - F) * (1.0f - metallic);
+        const glm::vec3 diff = kd * albedo / 3.14159265f;
+
+        const glm::vec3 radiance = Ld.color * (Ld.intensity * kLightIntensityScale * ls.atten);
+
+        return (diff + spec) * radiance * NdotL;
+    }
+
+    // ShadedDraw.frag (no normal maps: there are no screen derivatives here)
+    glm::vec3 shadeShaded(const FrameData& fd, const Fragment& f) noexcept
+    {
+        const CpuMaterial* mat = materialOf(fd, f.material);
+
+        glm::vec3 albedo    = mat ? mat->baseColor : glm::vec3(0.8f);
+        float     roughness = mat ? std::clamp(mat->roughness, 0.04f, 1.0f) : 0.5f;
+        float     metallic  = mat ? std::clamp(mat->metallic, 0.0f, 1.0f) : 0.0f;
+        float     ao        = 1.0f;
+        float     ior       = mat ? std::max(mat->ior, 1.0f) : 1.5f;
+        glm::vec3 emissive  = mat ? mat->emissive : glm::vec3(0.0f);
+
+        if (mat && mat->baseTex >= 0)
+            albedo *= fd.textures[mat->baseTex].sample(f.uv);
+
+        if (mat && mat->mraoTex >= 0)
+        {
+            const glm::vec3 mrao = fd.textures[mat->mraoTex].sample(f.uv);
+            ao                   = saturate(mrao.x);
+            roughness            = std::clamp(roughness * mrao.y, 0.04f, 1.0f);
+            metallic             = saturate(metallic * mrao.z);
+        }
+
+        if (mat && mat->emissiveTex >= 0)
+            emissive *= fd.textures[mat->emissiveTex].sample(f.uv);
+
+        const glm::vec3 N     = f.N;
+        const glm::vec3 V     = viewVector(fd, f.P);
+        const float     alpha = roughness * roughness;
+
+        const float     f0s = std::pow((ior - 1.0f) / (ior + 1.0f), 2.0f);
+        const glm::vec3 F0  = glm::mix(glm::vec3(std::clamp(f0s, 0.02f, 0.08f)), albedo, metallic);
+
+        glm::vec3 direct = glm::vec3(0.0f);
+        for (const GpuLight& Ld : fd.lights)
+            direct += shadeLight(Ld, f.P, N, V, albedo, F0, roughness, metallic, alpha);
+
+        const glm::vec3 Fv  = cpuFresnelSchlick(saturate(glm::dot(N, V)), F0);
+        const glm::vec3 kdI = (glm::vec3(1.0f) - Fv) * (1.0f - metallic);
+
+        const glm::vec3 diffIBL = kdI * albedo * cpuStudioEnv(N) * 0.10f * ao * fd.iblScale;
+        const glm::vec3 R       = glm::reflect(-V, N);
+        const glm::vec3 specIBL = cpuStudioEnv(R) * Fv * (0.05f + 0.25f * (1.0f - roughness)) * fd.iblScale;
+
+        const glm::vec3 floorFill   = albedo * 0.004f;
+        const glm::vec3 ambientFill = fd.ambient * albedo * ao;
+
+        const glm::vec3 color = direct + diffIBL + specIBL + floorFill + emissive + ambientFill;
+        return tonemapACES(color * fd.exposure);
+    }
+
+    // ------------------------------------------------------------
+    // Tiles
+    // ------------------------------------------------------------
+    struct TileBuffers
+    {
+        std::vector<float>     depth = {};
+        std::vector<uint32_t>  ids   = {};
+        std::vector<glm::vec3> color = {};
+
+        void reset(uint32_t size)
+        {
+            const std::size_t n = std::size_t(size) * size;
+            depth.assign(n, 1.0f);
+            ids.assign(n, kNoTriangle);
+            color.resize(n);
+        }
+    };
+
+    struct TileRect
+    {
+        int32_t x0 = 0; ///< Inclusive
+        int32_t y0 = 0;
+        int32_t x1 = 0; ///< Exclusive
+        int32_t y1 = 0;
+    };
+
+    void rasterizeTriangle(const RasterTri& t, uint32_t index, const TileRect& tile, uint32_t stride, TileBuffers& tb)
+    {
+        const int32_t rx0 = std::max(t.x0, tile.x0);
+        const int32_t ry0 = std::max(t.y0, tile.y0);
+        const int32_t rx1 = std::min(t.x1, tile.x1 - 1);
+        const int32_t ry1 = std::min(t.y1, tile.y1 - 1);
+        if (rx0 > rx1 || ry0 > ry1)
+            return;
+
+        // Quads start on 4-pixel boundaries of the tile, so the 4-wide loads stay inside the row.
+        const int32_t qx0 = tile.x0 + ((rx0 - tile.x0) & ~3);
+
+        float z[4] = {};
+
+        for (int32_t y = ry0; y <= ry1; ++y)
+        {
+            const float   py  = float(y) + 0.5f;
+            const int32_t row = (y - tile.y0) * int32_t(stride);
+
+            for (int32_t x = qx0; x <= rx1; x += 4)
+            {
+                uint32_t lanes = 0xFu;
+                if (x < rx0)
+                    lanes &= 0xFu << (rx0 - x);
+                if (x + 3 > rx1)
+                    lanes &= 0xFu >> (x + 3 - rx1);
+
+                const int32_t local = row + (x - tile.x0);
+
+                uint32_t mask = testQuad(t, float(x) + 0.5f, py, &tb.depth[local], z) & lanes;
+
+                while (mask)
+                {
+                    const int i = std::countr_zero(mask);
+                    mask &= mask - 1;
+
+                    tb.depth[local + i] = z[i];
+                    tb.ids[local + i]   = index;
+                }
+            }
+        }
+    }
+
+    // Liang-Barsky step; false when the segment is fully outside.
+    bool clipParam(float p, float q, float& t0, float& t1) noexcept
+    {
+        if (p == 0.0f)
+            return q >= 0.0f;
+
+        const float r = q / p;
+        if (p < 0.0f)
+        {
+            if (r > t1)
+                return false;
+            t0 = std::max(t0, r);
+        }
+        else
+        {
+            if (r < t0)
+                return false;
+            t1 = std::min(t1, r);
+        }
+
+        return true;
+    }
+
+    void drawLine(const RasterLine& l,
+                  const TileRect&   tile,
+                  uint32_t          stride,
+                  const glm::vec4&  visible,
+                  const glm::vec4*  hidden,
+                  TileBuffers&      tb)
+    {
+        const glm::vec3 d     = l.b - l.a;
+        const float     steps = std::max(std::abs(d.x), std::abs(d.y));
+        const int32_t   n     = std::max(1, static_cast<int32_t>(std::ceil(steps)));
+
+        // Only walk the part of the segment that crosses this tile.
+        float t0 = 0.0f;
+        float t1 = 1.0f;
+        if (!clipParam(-d.x, l.a.x - float(tile.x0 - 1), t0, t1) ||
+            !clipParam(d.x, float(tile.x1 + 1) - l.a.x, t0, t1) ||
+            !clipParam(-d.y, l.a.y - float(tile.y0 - 1), t0, t1) ||
+            !clipParam(d.y, float(tile.y1 + 1) - l.a.y, t0, t1))
+            return;
+
+        const int32_t i0 = std::max(0, static_cast<int32_t>(std::floor(t0 * float(n))));
+        const int32_t i1 = std::min(n, static_cast<int32_t>(std::ceil(t1 * float(n))));
+
+        for (int32_t i = i0; i <= i1; ++i)
+        {
+            const glm::vec3 p  = l.a + d * (float(i) / float(n));
+            const int32_t   ix = static_cast<int32_t>(std::floor(p.x));
+            const int32_t   iy = static_cast<int32_t>(std::floor(p.y));
+            if (ix < tile.x0 || iy < tile.y0 || ix >= tile.x1 || iy >= tile.y1)
+                continue;
+
+            const int32_t local = (iy - tile.y0) * int32_t(stride) + (ix - tile.x0);
+
+            // Slope-free bias: about 0.2% of the view distance in ZO perspective depth.
+            const float bias = 1e-6f + 2e-3f * (1.0f - p.z);
+
+            const glm::vec4* c = (p.z <= tb.depth[local] + bias) ? &visible : hidden;
+            if (!c)
+                continue;
+
+            tb.color[local] = glm::mix(tb.color[local], glm::vec3(*c), c->a);
+        }
+    }
+} // namespace
+
+// ------------------------------------------------------------
+// CpuFrame
+// ------------------------------------------------------------
+
+void CpuFrame::resize(int32_t w, int32_t h)
+{
+    width  = std::max(w, 0);
+    height = std::max(h, 0);
+
+    const std::size_t n = std::size_t(width) * std::size_t(height);
+    pixels.resize(n);
+    depth.resize(n);
+}
+
+// ------------------------------------------------------------
+// CpuRasterizer
+// ------------------------------------------------------------
+
+CpuRasterizer::CpuRasterizer(uint32_t threadCount) :
+    m_pool(std::make_unique<TaskPool>(threadCount))
+{
+}
+
+CpuRasterizer::~CpuRasterizer() noexcept = default;
+
+void CpuRasterizer::clearCache() noexcept
+{
+    m_meshes.clear();
+}
+
+const CpuRasterizer::MeshStreams& CpuRasterizer::streams(const SceneMesh& mesh)
+{
+    const SysMesh* sys = mesh.sysMesh();
+
+    MeshStreams& s = m_meshes[&mesh];
+    s.used         = true;
+
+    const SysCounterPtr& topo     = sys->topology_counter();
+    const uint64_t       topology = topo->value();
+    const uint64_t       deform   = sys->deform_counter()->value();
+
+    if (s.counter == topo && s.topology == topology && s.deform == deform)
+        return s;
+
+    s.counter  = topo;
+    s.topology = topology;
+    s.deform   = deform;
+    s.tris     = extractMeshData(sys);
+    s.edges    = extractMeshEdges(sys);
+
+    return s;
+}
+
+bool CpuRasterizer::render(Scene& scene, const Viewport& vp, const CpuRasterSettings& settings, CpuFrame& frame)
+{
+    const int32_t width  = vp.width();
+    const int32_t height = vp.height();
+    if (width <= 0 || height <= 0)
+        return false;
+
+    frame.resize(width, height);
+
+    // ------------------------------------------------------------
+    // Frame inputs
+    // ------------------------------------------------------------
+    FrameData fd = {};
+    fd.mode      = (vp.drawMode() == DrawMode::RAY_TRACE) ? DrawMode::SHADED : vp.drawMode();
+    fd.camPos    = vp.cameraPosition();
+    fd.viewDir   = vp.viewDirection();
+    fd.ortho     = vp.viewMode() != ViewMode::PERSPECTIVE;
+    fd.clear     = glm::vec3(vp.clearColor());
+
+    if (fd.mode != DrawMode::WIREFRAME)
+    {
+        cpuSnapshotMaterials(scene, fd.materials, fd.textures);
+
+        const LightingSettings& ls = scene.lightingSettings();
+
+        HeadlightSettings headlight = {};
+        headlight.enabled           = ls.useHeadlight;
+        headlight.intensity         = ls.headlightIntensity;
+
+        GpuLightsUBO ubo = {};
+        buildGpuLightsUBO(ls, headlight, vp, &scene, ubo, fd.lights);
+
+        fd.ambient  = ubo.ambient;
+        fd.exposure = std::exp2(glm::mix(kExposureEvMin, kExposureEvMax, saturate(ubo.exposure)));
+        fd.iblScale = (ubo.count > 1u) ? 0.20f : 1.0f;
+    }
+
+    const bool drawEdges = (fd.mode == DrawMode::WIREFRAME) || (fd.mode == DrawMode::SOLID && settings.solidEdges);
+    const bool cullBack  = (fd.mode == DrawMode::SHADED);
+
+    // ------------------------------------------------------------
+    // Mesh streams (main thread: the cache is not shared)
+    // ------------------------------------------------------------
+    struct DrawMesh
+    {
+        const MeshStreams* streams = nullptr;
+        glm::mat4          model   = glm::mat4(1.0f);
+        glm::mat3          normal  = glm::mat3(1.0f);
+    };
+
+    for (auto& [mesh, s] : m_meshes)
+        s.used = false;
+
+    std::vector<DrawMesh> draws = {};
+    for (SceneMesh* sm : scene.sceneMeshes())
+    {
+        if (!sm || !sm->visible() || !sm->sysMesh())
+            continue;
+
+        DrawMesh dm = {};
+        dm.streams  = &streams(*sm);
+        dm.model    = sm->model();
+        dm.normal   = glm::transpose(glm::inverse(glm::mat3(dm.model)));
+        draws.push_back(dm);
+    }
+
+    // Forget meshes that are gone or hidden.
+    std::erase_if(m_meshes, [](const auto& entry) { return !entry.second.used; });
+
+    // ------------------------------------------------------------
+    // 1) Transform, clip and set up, in chunks
+    // ------------------------------------------------------------
+    struct Chunk
+    {
+        const DrawMesh*         draw  = nullptr;
+        bool                    edges = false;
+        uint32_t                first = 0;
+        uint32_t                count = 0;
+        std::vector<RasterTri>  tris  = {};
+        std::vector<RasterLine> lines = {};
+    };
+
+    std::vector<Chunk> chunks = {};
+    for (const DrawMesh& dm : draws)
+    {
+        const uint32_t triCount  = static_cast<uint32_t>(dm.streams->tris.verts.size() / 3);
+        const uint32_t edgeCount = drawEdges ? static_cast<uint32_t>(dm.streams->edges.size() / 2) : 0u;
+
+        for (uint32_t first = 0; first < triCount; first += kChunkPrimitives)
+            chunks.push_back({&dm, false, first, std::min(kChunkPrimitives, triCount - first)});
+
+        for (uint32_t first = 0; first < edgeCount; first += kChunkPrimitives)
+            chunks.push_back({&dm, true, first, std::min(kChunkPrimitives, edgeCount - first)});
+    }
+
+    const glm::mat4 viewProj = vp.projection() * vp.view();
+
+    auto setupChunk = [&](Chunk& c) {
+        const MeshStreams& ms = *c.draw->streams;
+
+        if (c.edges)
+        {
+            for (uint32_t e = c.first; e < c.first + c.count; ++e)
+            {
+                const glm::vec4 a = viewProj * (c.draw->model * glm::vec4(ms.edges[e * 2 + 0], 1.0f));
+                const glm::vec4 b = viewProj * (c.draw->model * glm::vec4(ms.edges[e * 2 + 1], 1.0f));
+                clipLine(a, b, width, height, c.lines);
+            }
+            return;
+        }
+
+        const MeshData& md     = ms.tris;
+        const bool      hasUvs = md.uvPos.size() == md.verts.size();
+
+        for (uint32_t t = c.first; t < c.first + c.count; ++t)
+        {
+            ClipVert v[3] = {};
+            for (int j = 0; j < 3; ++j)
+            {
+                const std::size_t k = std::size_t(t) * 3 + j;
+
+                v[j].pos  = glm::vec3(c.draw->model * glm::vec4(md.verts[k], 1.0f));
+                v[j].nrm  = (k < md.norms.size()) ? c.draw->normal * md.norms[k] : glm::vec3(0.0f);
+                v[j].uv   = hasUvs ? md.uvPos[k] : glm::vec2(0.0f);
+                v[j].clip = viewProj * glm::vec4(v[j].pos, 1.0f);
+            }
+
+            glm::vec3 faceN = glm::cross(v[1].pos - v[0].pos, v[2].pos - v[0].pos);
+            if (!(glm::dot(faceN, faceN) > 1e-30f))
+                continue;
+            faceN = glm::normalize(faceN);
+
+            const glm::vec3 toCamera = fd.ortho ? -fd.viewDir : fd.camPos - v[0].pos;
+            const bool      backface = glm::dot(faceN, toCamera) < 0.0f;
+            if (backface && cullBack)
+                continue;
+
+            const uint32_t material = (t < md.matIds.size()) ? md.matIds[t] : 0u;
+            clipAndSetup(v, faceN, material, backface, width, height, c.tris);
+        }
+    };
+
+    {
+        std::atomic<std::size_t> next{0};
+
+        auto worker = [&] {
+            for (std::size_t i = next++; i < chunks.size(); i = next++)
+                setupChunk(chunks[i]);
+        };
+
+        for (uint32_t t = 0; t < m_pool->threadCount(); ++t)
+            m_pool->submit(worker);
+
+        m_pool->waitIdle();
+    }
+
+    // Chunk order is draw order, so the result does not depend on scheduling.
+    std::vector<RasterTri>  tris  = {};
+    std::vector<RasterLine> lines = {};
+    for (Chunk& c : chunks)
+    {
+        tris.insert(tris.end(), c.tris.begin(), c.tris.end());
+        lines.insert(lines.end(), c.lines.begin(), c.lines.end());
+    }
+
+    // ------------------------------------------------------------
+    // 2) Bin into tiles
+    // ------------------------------------------------------------
+    const uint32_t tileSize = (std::clamp<uint32_t>(settings.tileSize, 8u, 256u) + 3u) & ~3u;
+    const int32_t  ts       = int32_t(tileSize);
+    const int32_t  tilesX   = (width + ts - 1) / ts;
+    const int32_t  tilesY   = (height + ts - 1) / ts;
+
+    std::vector<std::vector<uint32_t>> tileTris(std::size_t(tilesX) * tilesY);
+    std::vector<std::vector<uint32_t>> tileLines(std::size_t(tilesX) * tilesY);
+
+    for (uint32_t i = 0; i < tris.size(); ++i)
+    {
+        const RasterTri& t = tris[i];
+        for (int32_t ty = t.y0 / ts; ty <= t.y1 / ts; ++ty)
+        {
+            for (int32_t tx = t.x0 / ts; tx <= t.x1 / ts; ++tx)
+                tileTris[std::size_t(ty) * tilesX + tx].push_back(i);
+        }
+    }
+
+    for (uint32_t i = 0; i < lines.size(); ++i)
+    {
+        const RasterLine& l = lines[i];
+
+        const float minX = std::min(l.a.x, l.b.x) - 1.0f;
+        const float minY = std::min(l.a.y, l.b.y) - 1.0f;
+        const float maxX = std::max(l.a.x, l.b.x) + 1.0f;
+        const float maxY = std::max(l.a.y, l.b.y) + 1.0f;
+        if (maxX < 0.0f || maxY < 0.0f || minX >= float(width) || minY >= float(height))
+            continue;
+
+        const int32_t tx0 = std::clamp(static_cast<int32_t>(minX) / ts, 0, tilesX - 1);
+        const int32_t ty0 = std::clamp(static_cast<int32_t>(minY) / ts, 0, tilesY - 1);
+        const int32_t tx1 = std::clamp(static_cast<int32_t>(maxX) / ts, 0, tilesX - 1);
+        const int32_t ty1 = std::clamp(static_cast<int32_t>(maxY) / ts, 0, tilesY - 1);
+
+        for (int32_t ty = ty0; ty <= ty1; ++ty)
+        {
+            for (int32_t tx = tx0; tx <= tx1; ++tx)
+                tileLines[std::size_t(ty) * tilesX + tx].push_back(i);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // 3) Rasterize, shade and resolve tiles
+    // ------------------------------------------------------------
+    const glm::vec4  edgeColor   = (fd.mode == DrawMode::WIREFRAME) ? kWireVisibleColor : kSolidEdgeColor;
+    const glm::vec4* hiddenColor = (fd.mode == DrawMode::WIREFRAME) ? &kWireHiddenColor : nullptr;
+
+    std::atomic<int32_t> nextTile{0};
+
+    auto tileWorker = [&] {
+        TileBuffers tb = {};
+
+        for (int32_t ti = nextTile++; ti < tilesX * tilesY; ti = nextTile++)
+        {
+            TileRect tile = {};
+            tile.x0       = (ti % tilesX) * ts;
+            tile.y0       = (ti / tilesX) * ts;
+            tile.x1       = std::min(tile.x0 + ts, width);
+            tile.y1       = std::min(tile.y0 + ts, height);
+
+            tb.reset(tileSize);
+
+            for (uint32_t index : tileTris[ti])
+                rasterizeTriangle(tris[index], index, tile, tileSize, tb);
+
+            for (int32_t y = tile.y0; y < tile.y1; ++y)
+            {
+                for (int32_t x = tile.x0; x < tile.x1; ++x)
+                {
+                    const int32_t  local = (y - tile.y0) * ts + (x - tile.x0);
+                    const uint32_t id    = tb.ids[local];
+
+                    if (id == kNoTriangle || fd.mode == DrawMode::WIREFRAME)
+                    {
+                        tb.color[local] = fd.clear;
+                        continue;
+                    }
+
+                    const Fragment f = interpolate(tris[id], float(x) + 0.5f, float(y) + 0.5f);
+                    tb.color[local]  = (fd.mode == DrawMode::SHADED) ? shadeShaded(fd, f) : shadeSolid(fd, f);
+                }
+            }
+
+            for (uint32_t index : tileLines[ti])
+                drawLine(lines[index], tile, tileSize, edgeColor, hiddenColor, tb);
+
+            for (int32_t y = tile.y0; y < tile.y1; ++y)
+            {
+                for (int32_t x = tile.x0; x < tile.x1; ++x)
+                {
+                    const int32_t     local = (y - tile.y0) * ts + (x - tile.x0);
+                    const std::size_t out   = std::size_t(y) * width + x;
+
+                    frame.pixels[out] = packSrgb(tb.color[local]);
+                    frame.depth[out]  = tb.depth[local];
+                }
+            }
+        }
+    };
+
+    for (uint32_t t = 0; t < m_pool->threadCount(); ++t)
+        m_pool->submit(tileWorker);
+
+    m_pool->waitIdle();
+
+    return true;
+}
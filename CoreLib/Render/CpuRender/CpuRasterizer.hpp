@@ -0,0 +1,102 @@
+#pragma once
+
+#include <SysCounter.hpp>
+#include <cstdint>
+#include <glm/vec3.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "MeshUtilities.hpp"
+
+class Scene;
+class SceneMesh;
+class TaskPool;
+class Viewport;
+
+/**
+ * @brief Color and depth image produced by CpuRasterizer.
+ */
+struct CpuFrame
+{
+    int32_t               width  = 0;
+    int32_t               height = 0;
+    std::vector<uint32_t> pixels = {}; ///< RGBA8, R in the lowest byte, sRGB encoded. Row 0 is the top.
+    std::vector<float>    depth  = {}; ///< Device depth (0 = near plane, 1 = far / empty).
+
+    void resize(int32_t w, int32_t h);
+
+    [[nodiscard]] bool valid() const noexcept
+    {
+        return width > 0 && height > 0 && pixels.size() == std::size_t(width) * std::size_t(height);
+    }
+};
+
+/**
+ * @brief Per-frame knobs of CpuRasterizer::render().
+ */
+struct CpuRasterSettings
+{
+    uint32_t tileSize   = 64;   ///< Square tile edge in pixels (rounded up to a multiple of 4).
+    bool     solidEdges = true; ///< Edge overlay in SOLID mode, as the Vulkan renderer draws it.
+};
+
+/**
+ * @brief Software rasterizer for viewports without a Vulkan device.
+ *
+ * Draws the same coarse triangle and edge streams MeshGpuResources uploads
+ * (extractMeshData(), extractMeshEdges()) with the same draw modes:
+ *  - WIREFRAME: depth-only fill, visible edges plus faded hidden edges.
+ *  - SOLID:     SolidDraw.frag shading (main light, double sided) + edge overlay.
+ *  - SHADED:    ShadedDraw.frag shading (all lights, studio IBL, ACES), back faces culled.
+ *  - RAY_TRACE: drawn as SHADED.
+ *
+ * The screen is split into tiles. Triangles are clipped, set up and binned
+ * once, then tiles are rasterized on worker threads: a 4-wide (SSE2 where
+ * available) edge-function and depth test fills a visibility buffer, then
+ * each covered pixel is shaded once. Textures are sampled from the 8-bit
+ * Images (KTX images shade untextured); subdivision surfaces draw their
+ * cage.
+ *
+ * Extracted streams are cached per mesh and refreshed when its topology or
+ * deform counter moves.
+ */
+class CpuRasterizer final
+{
+public:
+    /// @param threadCount Worker count; 0 picks hardware_concurrency() - 1 (at least 1).
+    explicit CpuRasterizer(uint32_t threadCount = 0);
+    ~CpuRasterizer() noexcept;
+
+    CpuRasterizer(const CpuRasterizer&)            = delete;
+    CpuRasterizer& operator=(const CpuRasterizer&) = delete;
+
+    /**
+     * @brief Draw @p scene as seen from @p vp into @p frame (resized to the viewport).
+     *
+     * Call Viewport::apply() first so the matrices match the viewport size.
+     *
+     * @return false if the viewport is empty.
+     */
+    [[nodiscard]] bool render(Scene& scene, const Viewport& vp, const CpuRasterSettings& settings, CpuFrame& frame);
+
+    /// Drop the cached mesh streams (e.g. when the scene is replaced).
+    void clearCache() noexcept;
+
+private:
+    struct MeshStreams
+    {
+        SysCounterPtr          counter  = {}; ///< Topology counter; keeps a reused mesh address from matching.
+        uint64_t               topology = ~0ull;
+        uint64_t               deform   = ~0ull;
+        MeshData               tris     = {};
+        std::vector<glm::vec3> edges    = {}; ///< Line list.
+        bool                   used     = false;
+    };
+
+    const MeshStreams& streams(const SceneMesh& mesh);
+
+private:
+    std::unique_ptr<TaskPool>                         m_pool   = {};
+    std::unordered_map<const SceneMesh*, MeshStreams> m_meshes = {};
+};
@@ -0,0 +1,407 @@
+#include "CpuTraceCommon.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+
+#include "Image.hpp"
+#include "ImageHandler.hpp"
+#include "MaterialHandler.hpp"
+#include "Scene.hpp"
+#include "SceneMesh.hpp"
+#include "SceneQueryEmbree.hpp"
+
+namespace
+{
+    constexpr float kPi = 3.14159265f;
+
+    uint32_t hashU32(uint32_t x) noexcept
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    float saturate(float x) noexcept
+    {
+        return std::clamp(x, 0.0f, 1.0f);
+    }
+
+    const std::array<float, 256>& srgbToLinearTable()
+    {
+        static const std::array<float, 256> table = [] {
+            std::array<float, 256> t = {};
+            for (int i = 0; i < 256; ++i)
+            {
+                const float c = float(i) / 255.0f;
+                t[i]          = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    int textureIndex(const ImageHandler*               images,
+                     ImageId                           id,
+                     bool                              srgb,
+                     std::vector<CpuTexture>&          textures,
+                     std::unordered_map<int64_t, int>& lookup)
+    {
+        if (!images || id == kInvalidImageId)
+            return -1;
+
+        const int64_t key = int64_t(id) * 2 + (srgb ? 1 : 0);
+        if (auto it = lookup.find(key); it != lookup.end())
+            return it->second;
+
+        int index = -1;
+
+        // Compressed (KTX) images have no 8-bit pixels on the CPU; shade untextured.
+        const Image* img = images->get(id);
+        if (img && img->valid() && !img->isKtx() && img->data() && img->width() > 0 && img->height() > 0 &&
+            img->channels() > 0)
+        {
+            CpuTexture tex = {};
+            tex.data       = img->data();
+            tex.width      = img->width();
+            tex.height     = img->height();
+            tex.channels   = img->channels();
+            tex.srgb       = srgb;
+
+            index = int(textures.size());
+            textures.push_back(tex);
+        }
+
+        lookup.emplace(key, index);
+        return index;
+    }
+
+    float G_SchlickGGX(float NdotX, float k) noexcept
+    {
+        return NdotX / (NdotX * (1.0f - k) + k);
+    }
+} // namespace
+
+// ------------------------------------------------------------
+// CpuTraceScene
+// ------------------------------------------------------------
+
+CpuTraceScene::~CpuTraceScene() noexcept
+{
+    if (m_rtc)
+        rtcReleaseScene(m_rtc);
+}
+
+bool CpuTraceScene::init(Scene& scene)
+{
+    auto* query = dynamic_cast<SceneQueryEmbree*>(scene.sceneQuery());
+    if (!query || !query->rtcScene())
+    {
+        std::cerr << "CpuTraceScene: scene has no Embree BVH.\n";
+        return false;
+    }
+
+    if (m_rtc)
+        rtcReleaseScene(m_rtc);
+
+    m_rtc   = query->rtcScene();
+    m_query = query;
+    rtcRetainScene(m_rtc);
+
+    m_visible.assign(query->geometryCount(), 0);
+    m_anyHidden = false;
+
+    for (uint32_t g = 0; g < query->geometryCount(); ++g)
+    {
+        const SceneMesh* mesh = query->meshForGeometry(g);
+        if (!mesh)
+            continue;
+
+        m_visible[g] = mesh->visible() ? 1 : 0;
+        m_anyHidden |= !mesh->visible();
+    }
+
+    return true;
+}
+
+CpuHit CpuTraceScene::intersect(const glm::vec3& org, const glm::vec3& dir, float tMax) const noexcept
+{
+    float tnear = 0.0f;
+
+    for (int guard = 0; guard < 64; ++guard)
+    {
+        RTCRayHit rh{};
+        rh.ray.org_x = org.x;
+        rh.ray.org_y = org.y;
+        rh.ray.org_z = org.z;
+        rh.ray.dir_x = dir.x;
+        rh.ray.dir_y = dir.y;
+        rh.ray.dir_z = dir.z;
+        rh.ray.tnear = tnear;
+        rh.ray.tfar  = tMax;
+        rh.ray.mask  = 0xFFFFFFFFu;
+        rh.ray.flags = 0;
+
+        rh.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+        rh.hit.primID = RTC_INVALID_GEOMETRY_ID;
+
+        RTCIntersectArguments args;
+        rtcInitIntersectArguments(&args);
+
+        rtcIntersect1(m_rtc, &rh, &args);
+
+        if (rh.hit.geomID == RTC_INVALID_GEOMETRY_ID)
+            return {};
+
+        if (visible(rh.hit.geomID))
+        {
+            CpuHit hit = {};
+            hit.valid  = true;
+            hit.t      = rh.ray.tfar;
+            hit.geom   = rh.hit.geomID;
+            hit.prim   = rh.hit.primID;
+            hit.u      = rh.hit.u;
+            hit.v      = rh.hit.v;
+            hit.ng     = glm::vec3(rh.hit.Ng_x, rh.hit.Ng_y, rh.hit.Ng_z);
+            return hit;
+        }
+
+        tnear = rh.ray.tfar + 1e-4f;
+        if (tnear >= tMax)
+            return {};
+    }
+
+    return {};
+}
+
+bool CpuTraceScene::occluded(const glm::vec3& org, const glm::vec3& dir, float tMax) const noexcept
+{
+    if (m_anyHidden)
+        return intersect(org, dir, tMax).valid;
+
+    RTCRay ray{};
+    ray.org_x = org.x;
+    ray.org_y = org.y;
+    ray.org_z = org.z;
+    ray.dir_x = dir.x;
+    ray.dir_y = dir.y;
+    ray.dir_z = dir.z;
+    ray.tnear = 0.0f;
+    ray.tfar  = tMax;
+    ray.mask  = 0xFFFFFFFFu;
+    ray.flags = 0;
+
+    RTCOccludedArguments args;
+    rtcInitOccludedArguments(&args);
+
+    rtcOccluded1(m_rtc, &ray, &args);
+
+    // Embree sets tfar to -inf when something was hit.
+    return ray.tfar < 0.0f;
+}
+
+// ------------------------------------------------------------
+// CpuRng
+// ------------------------------------------------------------
+
+CpuRng::CpuRng(uint32_t seed, uint32_t x, uint32_t y, uint32_t sample) noexcept :
+    m_state(hashU32(seed ^ hashU32(x ^ hashU32(y ^ hashU32(sample)))))
+{
+}
+
+float CpuRng::next() noexcept
+{
+    m_state = hashU32(m_state + 0x9e3779b9u);
+    return float(m_state >> 8) * (1.0f / 16777216.0f);
+}
+
+// ------------------------------------------------------------
+// Sampling helpers
+// ------------------------------------------------------------
+
+glm::vec3 cpuFromBasis(const glm::vec3& n, float x, float y, float z) noexcept
+{
+    // Orthonormal basis without branches (Duff et al. 2017).
+    const float sign = std::copysign(1.0f, n.z);
+    const float a    = -1.0f / (sign + n.z);
+    const float bb   = n.x * n.y * a;
+
+    const glm::vec3 t = glm::vec3(1.0f + sign * n.x * n.x * a, sign * bb, -sign * n.x);
+    const glm::vec3 b = glm::vec3(bb, sign + n.y * n.y * a, -n.y);
+
+    return glm::normalize(t * x + b * y + n * z);
+}
+
+glm::vec3 cpuConeSample(const glm::vec3& axis, float angRad, float u0, float u1) noexcept
+{
+    const float cosT = glm::mix(1.0f, std::cos(angRad), u0);
+    const float sinT = std::sqrt(std::max(1.0f - cosT * cosT, 0.0f));
+    const float phi  = 2.0f * kPi * u1;
+
+    return cpuFromBasis(axis, std::cos(phi) * sinT, std::sin(phi) * sinT, cosT);
+}
+
+glm::vec3 cpuCosineSample(const glm::vec3& n, float u0, float u1) noexcept
+{
+    const float r   = std::sqrt(u0);
+    const float phi = 2.0f * kPi * u1;
+
+    return cpuFromBasis(n, r * std::cos(phi), r * std::sin(phi), std::sqrt(std::max(1.0f - u0, 0.0f)));
+}
+
+CpuLightSample cpuEvalLight(const GpuLight& Ld, const glm::vec3& P) noexcept
+{
+    CpuLightSample ls = {};
+    ls.atten          = 1.0f;
+
+    if (Ld.type == static_cast<uint32_t>(GpuLightType::Directional))
+    {
+        ls.L      = glm::normalize(-Ld.direction);
+        ls.tMax   = std::numeric_limits<float>::max();
+        ls.angRad = std::max(Ld.range, 0.0f);
+        return ls;
+    }
+
+    const glm::vec3 toLight = Ld.position - P;
+    const float     dist2   = std::max(glm::dot(toLight, toLight), 1e-6f);
+    const float     dist    = std::sqrt(dist2);
+
+    ls.L     = toLight / dist;
+    ls.atten = 1.0f / dist2;
+
+    // Gentle range window
+    if (Ld.range > 0.0f)
+    {
+        const float x = saturate(1.0f - dist / Ld.range);
+        ls.atten *= x * x * (3.0f - 2.0f * x);
+    }
+
+    if (Ld.type == static_cast<uint32_t>(GpuLightType::Spot))
+    {
+        const float cosAn  = glm::dot(glm::normalize(Ld.direction), -ls.L);
+        const float innerC = Ld.spot_params.x;
+        const float outerC = Ld.spot_params.y;
+
+        ls.atten *= (innerC > outerC) ? saturate((cosAn - outerC) / std::max(innerC - outerC, 1e-5f))
+                                      : (cosAn >= outerC ? 1.0f : 0.0f);
+    }
+
+    ls.tMax   = std::max(dist - 0.01f, 0.01f);
+    ls.angRad = std::max(Ld.spot_params.z, 0.0f);
+    return ls;
+}
+
+// ------------------------------------------------------------
+// Materials
+// ------------------------------------------------------------
+
+glm::vec3 CpuTexture::fetch(int x, int y) const noexcept
+{
+    x = ((x % width) + width) % width;
+    y = ((y % height) + height) % height;
+
+    const unsigned char* p = data + (std::size_t(y) * width + x) * channels;
+
+    const int r = p[0];
+    const int g = (channels >= 3) ? p[1] : r;
+    const int b = (channels >= 3) ? p[2] : r;
+
+    if (srgb)
+    {
+        const auto& lut = srgbToLinearTable();
+        return glm::vec3(lut[r], lut[g], lut[b]);
+    }
+
+    return glm::vec3(r, g, b) * (1.0f / 255.0f);
+}
+
+glm::vec3 CpuTexture::sample(const glm::vec2& uv) const noexcept
+{
+    const float fx = uv.x * float(width) - 0.5f;
+    const float fy = uv.y * float(height) - 0.5f;
+    const float x0 = std::floor(fx);
+    const float y0 = std::floor(fy);
+    const float tx = fx - x0;
+    const float ty = fy - y0;
+    const int   ix = int(x0);
+    const int   iy = int(y0);
+
+    const glm::vec3 top    = glm::mix(fetch(ix, iy), fetch(ix + 1, iy), tx);
+    const glm::vec3 bottom = glm::mix(fetch(ix, iy + 1), fetch(ix + 1, iy + 1), tx);
+    return glm::mix(top, bottom, ty);
+}
+
+void cpuSnapshotMaterials(const Scene& scene, std::vector<CpuMaterial>& materials, std::vector<CpuTexture>& textures)
+{
+    materials.clear();
+    textures.clear();
+
+    const MaterialHandler* mh     = scene.materialHandler();
+    const ImageHandler*    images = scene.imageHandler();
+    if (!mh)
+        return;
+
+    std::unordered_map<int64_t, int> lookup = {};
+
+    materials.reserve(mh->materials().size());
+
+    for (const Material& m : mh->materials())
+    {
+        CpuMaterial md = {};
+        md.baseColor   = m.baseColor();
+        md.emissive    = m.emissiveColor() * m.emissiveIntensity();
+        md.roughness   = m.roughness();
+        md.metallic    = m.metallic();
+        md.ior         = m.ior();
+        md.baseTex     = textureIndex(images, m.baseColorTexture(), true, textures, lookup);
+        md.mraoTex     = textureIndex(images, m.mraoTexture(), false, textures, lookup);
+        md.emissiveTex = textureIndex(images, m.emissiveTexture(), true, textures, lookup);
+
+        materials.push_back(md);
+    }
+}
+
+glm::vec3 cpuFresnelSchlick(float cosTheta, const glm::vec3& F0) noexcept
+{
+    return F0 + (glm::vec3(1.0f) - F0) * std::pow(1.0f - saturate(cosTheta), 5.0f);
+}
+
+float cpuGgxD(float NdotH, float alpha) noexcept
+{
+    const float a2 = alpha * alpha;
+    const float d  = (NdotH * NdotH) * (a2 - 1.0f) + 1.0f;
+    return a2 / std::max(kPi * d * d, 1e-7f);
+}
+
+float cpuSmithG(float NdotV, float NdotL, float k) noexcept
+{
+    return G_SchlickGGX(NdotV, k) * G_SchlickGGX(NdotL, k);
+}
+
+glm::vec3 cpuStudioEnv(glm::vec3 dir) noexcept
+{
+    dir = glm::normalize(dir);
+
+    const float t = saturate(dir.y * 0.5f + 0.5f);
+
+    const glm::vec3 top    = glm::vec3(1.0f, 1.0f, 1.05f) * 0.75f;
+    const glm::vec3 bottom = glm::vec3(0.03f, 0.03f, 0.035f) * 0.55f;
+
+    glm::vec3 col = glm::mix(bottom, top, std::pow(t, 0.65f));
+
+    const glm::vec3 box0 = glm::normalize(glm::vec3(0.15f, 0.85f, 0.35f));
+    col += glm::vec3(1.0f, 0.98f, 0.95f) * std::pow(saturate(glm::dot(dir, box0)), 25.0f) * 1.5f;
+
+    const glm::vec3 box1 = glm::normalize(glm::vec3(-0.55f, 0.65f, 0.50f));
+    col += glm::vec3(0.95f, 0.98f, 1.0f) * std::pow(saturate(glm::dot(dir, box1)), 35.0f) * 1.1f;
+
+    col += glm::vec3(0.20f, 0.25f, 0.30f) * (1.0f - std::abs(dir.y)) * 0.15f;
+    return col;
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <embree4/rtcore.h>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <vector>
+
+#include "GpuLight.hpp"
+
+class Scene;
+class SceneQueryEmbree;
+
+// ============================================================
+// Shared pieces of the CPU renderers (CpuPathTracer, LightmapBaker)
+// ============================================================
+
+/**
+ * @brief Closest hit of a CpuTraceScene ray (Embree conventions).
+ */
+struct CpuHit
+{
+    bool      valid = false;
+    float     t     = 0.0f;
+    uint32_t  geom  = RTC_INVALID_GEOMETRY_ID;
+    uint32_t  prim  = RTC_INVALID_GEOMETRY_ID;
+    float     u     = 0.0f; ///< Barycentric weight of vertex 1.
+    float     v     = 0.0f; ///< Barycentric weight of vertex 2.
+    glm::vec3 ng    = glm::vec3(0.0f); ///< Unnormalized geometric normal.
+};
+
+/**
+ * @brief Read-only view of the scene's Embree BVH for worker threads.
+ *
+ * Holds a reference on the RTCScene, so a rebuild on the main thread does
+ * not free it under running workers. Hidden meshes stay in the BVH and are
+ * stepped over. Geometry is in mesh space (world space for the renderers).
+ */
+class CpuTraceScene final
+{
+public:
+    CpuTraceScene() noexcept = default;
+    ~CpuTraceScene() noexcept;
+
+    CpuTraceScene(const CpuTraceScene&)            = delete;
+    CpuTraceScene& operator=(const CpuTraceScene&) = delete;
+
+    /// Capture the BVH and mesh visibility of @p scene. Logs and returns false if there is no BVH.
+    [[nodiscard]] bool init(Scene& scene);
+
+    [[nodiscard]] const SceneQueryEmbree* query() const noexcept
+    {
+        return m_query;
+    }
+
+    [[nodiscard]] bool visible(uint32_t geomId) const noexcept
+    {
+        return geomId < m_visible.size() && m_visible[geomId] != 0;
+    }
+
+    /// Closest visible hit in (0, tMax).
+    [[nodiscard]] CpuHit intersect(const glm::vec3& org, const glm::vec3& dir, float tMax) const noexcept;
+
+    /// True if any visible geometry lies in (0, tMax).
+    [[nodiscard]] bool occluded(const glm::vec3& org, const glm::vec3& dir, float tMax) const noexcept;
+
+private:
+    RTCScene                m_rtc       = nullptr;
+    const SceneQueryEmbree* m_query     = nullptr;
+    std::vector<uint8_t>    m_visible   = {};
+    bool                    m_anyHidden = false;
+};
+
+/**
+ * @brief Random numbers keyed by (seed, x, y, sample).
+ *
+ * The stream depends only on its key, so results do not change with the
+ * thread count or the order in which work is picked up.
+ */
+class CpuRng
+{
+public:
+    CpuRng(uint32_t seed, uint32_t x, uint32_t y, uint32_t sample) noexcept;
+
+    /// Uniform in [0, 1).
+    [[nodiscard]] float next() noexcept;
+
+private:
+    uint32_t m_state = 0;
+};
+
+/// Unit vector (x, y, z) expressed in an orthonormal basis around unit @p n (z along n).
+[[nodiscard]] glm::vec3 cpuFromBasis(const glm::vec3& n, float x, float y, float z) noexcept;
+
+/// Uniform direction within @p angRad of unit @p axis.
+[[nodiscard]] glm::vec3 cpuConeSample(const glm::vec3& axis, float angRad, float u0, float u1) noexcept;
+
+/// Cosine-weighted direction around unit @p n.
+[[nodiscard]] glm::vec3 cpuCosineSample(const glm::vec3& n, float u0, float u1) noexcept;
+
+/**
+ * @brief Light @p Ld as seen from world point @p P (evalLight() of RtScene.rchit).
+ */
+struct CpuLightSample
+{
+    glm::vec3 L      = glm::vec3(0.0f); ///< Surface -> light.
+    float     atten  = 0.0f;            ///< Inverse square, range window and spot cone.
+    float     tMax   = 0.0f;            ///< Shadow ray length.
+    float     angRad = 0.0f;            ///< Soft-shadow cone half angle.
+};
+
+[[nodiscard]] CpuLightSample cpuEvalLight(const GpuLight& Ld, const glm::vec3& P) noexcept;
+
+// ------------------------------------------------------------
+// Materials (GLSL twins in ShadedDraw.frag / RtScene.rchit)
+// ------------------------------------------------------------
+
+/**
+ * @brief 8-bit Image pixels, sampled bilinearly with repeat wrapping.
+ *
+ * Rows follow the Image layout, as on the GPU (v = 0 is row 0). Points
+ * into the Image, which must outlive the render.
+ */
+struct CpuTexture
+{
+    const unsigned char* data     = nullptr;
+    int                  width    = 0;
+    int                  height   = 0;
+    int                  channels = 0;
+    bool                 srgb     = false; ///< Decode to linear on fetch.
+
+    [[nodiscard]] glm::vec3 fetch(int x, int y) const noexcept;
+    [[nodiscard]] glm::vec3 sample(const glm::vec2& uv) const noexcept;
+};
+
+/**
+ * @brief Material constants with indices into the texture list (-1 = none).
+ */
+struct CpuMaterial
+{
+    glm::vec3 baseColor   = glm::vec3(1.0f, 0.0f, 1.0f);
+    glm::vec3 emissive    = glm::vec3(0.0f); ///< Color * intensity.
+    float     roughness   = 0.5f;
+    float     metallic    = 0.0f;
+    float     ior         = 1.5f;
+    int       baseTex     = -1; ///< sRGB
+    int       mraoTex     = -1; ///< r = ao, g = roughness, b = metallic
+    int       emissiveTex = -1; ///< sRGB
+};
+
+/// Snapshot the scene materials and their CPU-readable textures (KTX images shade untextured).
+void cpuSnapshotMaterials(const Scene& scene, std::vector<CpuMaterial>& materials, std::vector<CpuTexture>& textures);
+
+[[nodiscard]] glm::vec3 cpuFresnelSchlick(float cosTheta, const glm::vec3& F0) noexcept;
+[[nodiscard]] float     cpuGgxD(float NdotH, float alpha) noexcept;
+[[nodiscard]] float     cpuSmithG(float NdotV, float NdotL, float k) noexcept;
+
+/// studioEnv() of the shaders: the viewport's fake environment (WORLD +Y up).
+[[nodiscard]] glm::vec3 cpuStudioEnv(glm::vec3 dir) noexcept;
@@ -0,0 +1,439 @@
+//==============================================================
+// LightmapBaker.cpp
+// Texel-space AO / bent normal / direct light baking over the scene's
+// Embree BVH.
+//
+// The mesh is rasterized into its UV0 layout once (position, shading and
+// geometric normal per covered texel centre); rows of that G-buffer are
+// then traced in parallel. Direct light matches RtScene.rchit's diffuse
+// term (evalLight(), LIGHT_INTENSITY_SCALE) for a white Lambert surface.
+//
+// Like the path tracer, mesh space is world space.
+//==============================================================
+#include "LightmapBaker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CpuTraceCommon.hpp"
+#include "GpuLights.hpp"
+#include "Scene.hpp"
+#include "SceneMesh.hpp"
+#include "TaskPool.hpp"
+
+namespace
+{
+    constexpr float kPi                  = 3.14159265f;
+    constexpr float kLightIntensityScale = 5.0f; // LIGHT_INTENSITY_SCALE
+
+    // SysMesh maps written by the importers (MESH_MAP_NORMALS / MESH_MAP_UV0).
+    constexpr int32_t kNormalMapId = 0;
+    constexpr int32_t kUvMapId     = 1;
+
+    struct Texel
+    {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 normal   = glm::vec3(0.0f); ///< Shading normal.
+        glm::vec3 geomN    = glm::vec3(0.0f); ///< Face normal, same side as normal.
+        bool      covered  = false;
+    };
+
+    struct Corner
+    {
+        glm::vec2 st       = glm::vec2(0.0f); ///< UV in texel units, texel centres on integers.
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 normal   = glm::vec3(0.0f);
+    };
+
+    float edge(const glm::vec2& a, const glm::vec2& b, const glm::vec2& p) noexcept
+    {
+        return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+    }
+
+    void rasterizeTriangle(const Corner (&c)[3], const glm::vec3& geomN, int32_t w, int32_t h, std::vector<Texel>& gbuf)
+    {
+        const float area = edge(c[0].st, c[1].st, c[2].st);
+        if (std::abs(area) < 1e-12f)
+            return;
+
+        const glm::vec2 lo = glm::min(c[0].st, glm::min(c[1].st, c[2].st));
+        const glm::vec2 hi = glm::max(c[0].st, glm::max(c[1].st, c[2].st));
+
+        const int32_t x0 = std::max(0, static_cast<int32_t>(std::ceil(lo.x)));
+        const int32_t y0 = std::max(0, static_cast<int32_t>(std::ceil(lo.y)));
+        const int32_t x1 = std::min(w - 1, static_cast<int32_t>(std::floor(hi.x)));
+        const int32_t y1 = std::min(h - 1, static_cast<int32_t>(std::floor(hi.y)));
+
+        const float invArea = 1.0f / area;
+
+        for (int32_t y = y0; y <= y1; ++y)
+        {
+            for (int32_t x = x0; x <= x1; ++x)
+            {
+                const glm::vec2 p = glm::vec2(float(x), float(y));
+
+                const float b0 = edge(c[1].st, c[2].st, p) * invArea;
+                const float b1 = edge(c[2].st, c[0].st, p) * invArea;
+                const float b2 = 1.0f - b0 - b1;
+
+                if (b0 < -1e-5f || b1 < -1e-5f || b2 < -1e-5f)
+                    continue;
+
+                Texel& t   = gbuf[std::size_t(y) * w + x];
+                t.position = c[0].position * b0 + c[1].position * b1 + c[2].position * b2;
+
+                glm::vec3 n = c[0].normal * b0 + c[1].normal * b1 + c[2].normal * b2;
+                n           = (glm::dot(n, n) > 1e-12f) ? glm::normalize(n) : geomN;
+
+                t.normal  = n;
+                t.geomN   = (glm::dot(geomN, n) < 0.0f) ? -geomN : geomN;
+                t.covered = true;
+            }
+        }
+    }
+
+    // Texel G-buffer of every fan triangle of @p sys in UV0 space.
+    bool rasterizeMesh(const SysMesh& sys, int32_t w, int32_t h, std::vector<Texel>& gbuf)
+    {
+        const int32_t normMap = sys.map_find(kNormalMapId);
+        const int32_t uvMap   = sys.map_find(kUvMapId);
+        if (uvMap < 0)
+            return false;
+
+        gbuf.assign(std::size_t(w) * std::size_t(h), Texel{});
+
+        const glm::vec2 scale = glm::vec2(float(w), float(h));
+
+        const int polyCount = static_cast<int>(sys.poly_buffer_size());
+        for (int poly = 0; poly < polyCount; ++poly)
+        {
+            if (!sys.poly_valid(poly))
+                continue;
+
+            const SysPolyVerts& pv = sys.poly_verts(poly);
+            const SysPolyVerts& pt = sys.map_poly_verts(uvMap, poly);
+            if (pv.size() < 3 || pt.size() != pv.size())
+                continue;
+
+            const bool          smooth = normMap >= 0 && sys.map_poly_verts(normMap, poly).size() == pv.size();
+            const glm::vec3     flat   = sys.poly_normal(poly);
+            const SysPolyVerts* pn     = smooth ? &sys.map_poly_verts(normMap, poly) : nullptr;
+
+            auto corner = [&](int local) {
+                Corner c   = {};
+                c.position = sys.vert_position(pv[local]);
+                c.normal   = pn ? glm::make_vec3(sys.map_vert_position(normMap, (*pn)[local])) : flat;
+                c.st       = glm::make_vec2(sys.map_vert_position(uvMap, pt[local])) * scale - 0.5f;
+                return c;
+            };
+
+            const Corner first = corner(0);
+            for (int i = 1; i + 1 < static_cast<int>(pv.size()); ++i)
+            {
+                const Corner tri[3] = {first, corner(i), corner(i + 1)};
+
+                glm::vec3 geomN = glm::cross(tri[1].position - tri[0].position, tri[2].position - tri[0].position);
+                geomN           = (glm::dot(geomN, geomN) > 1e-20f) ? glm::normalize(geomN) : flat;
+
+                rasterizeTriangle(tri, geomN, w, h, gbuf);
+            }
+        }
+
+        return true;
+    }
+
+    struct BakeContext
+    {
+        CpuTraceScene         trace    = {};
+        std::vector<GpuLight> lights   = {};
+        std::vector<Texel>    gbuf     = {};
+        int32_t               width    = 0;
+        int32_t               height   = 0;
+        float                 aoLength = 0.0f;
+    };
+
+    // Ray start lifted off the surface by a scale-aware epsilon.
+    glm::vec3 rayOrigin(const Texel& t) noexcept
+    {
+        const glm::vec3 a   = glm::abs(t.position);
+        const float     eps = 1e-4f * (1.0f + std::max(a.x, std::max(a.y, a.z)));
+        return t.position + t.geomN * eps;
+    }
+
+    void bakeTexel(const BakeContext&          ctx,
+                   const LightmapBakeSettings& settings,
+                   int32_t                     x,
+                   int32_t                     y,
+                   glm::vec4*                  ao,
+                   glm::vec4*                  bent,
+                   glm::vec4*                  direct)
+    {
+        const Texel&    t   = ctx.gbuf[std::size_t(y) * ctx.width + x];
+        const glm::vec3 org = rayOrigin(t);
+
+        if (ao || bent)
+        {
+            const uint32_t count = std::max(settings.aoSamples, 1u);
+            uint32_t       open  = 0;
+            glm::vec3      sum   = glm::vec3(0.0f);
+
+            for (uint32_t s = 0; s < count; ++s)
+            {
+                CpuRng          rng(settings.seed, uint32_t(x), uint32_t(y), s);
+                const glm::vec3 dir = cpuCosineSample(t.normal, rng.next(), rng.next());
+
+                // Below the face: the surface itself blocks it.
+                if (glm::dot(dir, t.geomN) <= 0.0f)
+                    continue;
+
+                if (!ctx.trace.occluded(org, dir, ctx.aoLength))
+                {
+                    ++open;
+                    sum += dir;
+                }
+            }
+
+            if (ao)
+                *ao = glm::vec4(glm::vec3(float(open) / float(count)), 1.0f);
+
+            if (bent)
+            {
+                const glm::vec3 n = (glm::dot(sum, sum) > 1e-12f) ? glm::normalize(sum) : t.normal;
+                *bent             = glm::vec4(n * 0.5f + 0.5f, 1.0f);
+            }
+        }
+
+        if (direct)
+        {
+            const uint32_t shadowRays = std::max(settings.lightSamples, 1u);
+            glm::vec3      radiance   = glm::vec3(0.0f);
+
+            for (std::size_t li = 0; li < ctx.lights.size(); ++li)
+            {
+                const GpuLight&      Ld = ctx.lights[li];
+                const CpuLightSample ls = cpuEvalLight(Ld, t.position);
+
+                const float NdotL = glm::dot(t.normal, ls.L);
+                if (NdotL <= 0.0f || ls.atten <= 0.0f || Ld.intensity <= 0.0f)
+                    continue;
+
+                const uint32_t rays    = (ls.angRad > 0.0f) ? shadowRays : 1u;
+                uint32_t       visible = 0;
+
+                for (uint32_t s = 0; s < rays; ++s)
+                {
+                    CpuRng          rng(settings.seed ^ 0x51ed270bu, uint32_t(x), uint32_t(y), uint32_t(li) * rays + s);
+                    const glm::vec3 L = (ls.angRad > 0.0f) ? cpuConeSample(ls.L, ls.angRad, rng.next(), rng.next()) : ls.L;
+
+                    if (!ctx.trace.occluded(org, L, ls.tMax))
+                        ++visible;
+                }
+
+                const float vis = float(visible) / float(rays);
+                radiance += Ld.color * (Ld.intensity * kLightIntensityScale * ls.atten * NdotL * vis / kPi);
+            }
+
+            *direct = glm::vec4(radiance * settings.directScale, 1.0f);
+        }
+    }
+
+    // Grow covered texels into their uncovered 8-neighbours, @p passes times.
+    void dilate(std::vector<glm::vec4>& map, std::vector<uint8_t> covered, int32_t w, int32_t h, uint32_t passes)
+    {
+        std::vector<uint8_t> next = covered;
+
+        for (uint32_t pass = 0; pass < passes; ++pass)
+        {
+            bool grew = false;
+
+            for (int32_t y = 0; y < h; ++y)
+            {
+                for (int32_t x = 0; x < w; ++x)
+                {
+                    const std::size_t i = std::size_t(y) * w + x;
+                    if (covered[i])
+                        continue;
+
+                    glm::vec4 sum   = glm::vec4(0.0f);
+                    int       count = 0;
+
+                    for (int32_t dy = -1; dy <= 1; ++dy)
+                    {
+                        for (int32_t dx = -1; dx <= 1; ++dx)
+                        {
+                            const int32_t nx = x + dx;
+                            const int32_t ny = y + dy;
+                            if (nx < 0 || ny < 0 || nx >= w || ny >= h)
+                                continue;
+
+                            const std::size_t ni = std::size_t(ny) * w + nx;
+                            if (covered[ni])
+                            {
+                                sum += map[ni];
+                                ++count;
+                            }
+                        }
+                    }
+
+                    if (count > 0)
+                    {
+                        map[i]  = sum / float(count);
+                        next[i] = 1;
+                        grew    = true;
+                    }
+                }
+            }
+
+            if (!grew)
+                break;
+
+            covered = next;
+        }
+    }
+
+    float linearToSrgb(float x) noexcept
+    {
+        x = std::clamp(x, 0.0f, 1.0f);
+        return (x <= 0.0031308f) ? x * 12.92f : 1.055f * std::pow(x, 1.0f / 2.4f) - 0.055f;
+    }
+
+    ImageId storeMap(ImageHandler& images, const std::vector<glm::vec4>& map, int32_t w, int32_t h, bool srgb, const std::string& name)
+    {
+        std::vector<unsigned char> bytes(map.size() * 4);
+
+        for (std::size_t i = 0; i < map.size(); ++i)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                const float v    = srgb ? linearToSrgb(map[i][c]) : std::clamp(map[i][c], 0.0f, 1.0f);
+                bytes[i * 4 + c] = static_cast<unsigned char>(std::lround(v * 255.0f));
+            }
+            bytes[i * 4 + 3] = 255;
+        }
+
+        return images.createFromRaw(bytes.data(), w, h, 4, name);
+    }
+} // namespace
+
+bool bakeLightmaps(Scene&                      scene,
+                   const SceneMesh&            mesh,
+                   ImageHandler&               images,
+                   const LightmapBakeSettings& settings,
+                   LightmapBakeResult&         result,
+                   const LightmapBakeProgress& progress)
+{
+    result = {};
+
+    const int32_t w = settings.width;
+    const int32_t h = settings.height;
+    if (w <= 0 || h <= 0 || !(settings.bakeAo || settings.bakeBentNormals || settings.bakeDirect))
+    {
+        std::cerr << "bakeLightmaps: empty map size or nothing to bake.\n";
+        return false;
+    }
+
+    const SysMesh* sys = mesh.sysMesh();
+    if (!sys)
+        return false;
+
+    BakeContext ctx = {};
+    ctx.width       = w;
+    ctx.height      = h;
+    ctx.aoLength    = (settings.aoDistance > 0.0f) ? settings.aoDistance : std::numeric_limits<float>::max();
+
+    if (!rasterizeMesh(*sys, w, h, ctx.gbuf))
+    {
+        std::cerr << "bakeLightmaps: mesh '" << mesh.name() << "' has no UV0 map.\n";
+        return false;
+    }
+
+    // Holds a reference on the BVH, so a rebuild meanwhile cannot free it.
+    if (!ctx.trace.init(scene))
+        return false;
+
+    if (settings.bakeDirect)
+        buildSceneLights(scene.lightingSettings(), &scene, ctx.lights);
+
+    const std::size_t      texelCount = std::size_t(w) * std::size_t(h);
+    std::vector<glm::vec4> aoMap(settings.bakeAo ? texelCount : 0, glm::vec4(0.0f));
+    std::vector<glm::vec4> bentMap(settings.bakeBentNormals ? texelCount : 0, glm::vec4(0.5f, 0.5f, 1.0f, 1.0f));
+    std::vector<glm::vec4> directMap(settings.bakeDirect ? texelCount : 0, glm::vec4(0.0f));
+
+    uint32_t threads = settings.threadCount;
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<uint32_t>(threads, static_cast<uint32_t>(h));
+
+    TaskPool pool(threads);
+
+    // A few rows per worker between progress reports keeps cancel responsive.
+    const int32_t rowsPerBatch = static_cast<int32_t>(pool.threadCount()) * 4;
+
+    for (int32_t batch = 0; batch < h; batch += rowsPerBatch)
+    {
+        const int32_t        end = std::min(batch + rowsPerBatch, h);
+        std::atomic<int32_t> nextRow{batch};
+
+        auto worker = [&] {
+            for (int32_t y = nextRow++; y < end; y = nextRow++)
+            {
+                for (int32_t x = 0; x < w; ++x)
+                {
+                    const std::size_t i = std::size_t(y) * w + x;
+                    if (!ctx.gbuf[i].covered)
+                        continue;
+
+                    bakeTexel(ctx,
+                              settings,
+                              x,
+                              y,
+                              aoMap.empty() ? nullptr : &aoMap[i],
+                              bentMap.empty() ? nullptr : &bentMap[i],
+                              directMap.empty() ? nullptr : &directMap[i]);
+                }
+            }
+        };
+
+        for (uint32_t t = 0; t < pool.threadCount(); ++t)
+            pool.submit(worker);
+
+        pool.waitIdle();
+
+        if (progress && !progress(float(end) / float(h)))
+            return false;
+    }
+
+    std::vector<uint8_t> covered(texelCount);
+    for (std::size_t i = 0; i < texelCount; ++i)
+        covered[i] = ctx.gbuf[i].covered ? 1 : 0;
+
+    const std::string base = std::string(mesh.name());
+
+    if (settings.bakeAo)
+    {
+        dilate(aoMap, covered, w, h, settings.dilation);
+        result.ao = storeMap(images, aoMap, w, h, false, base + "_AO");
+    }
+
+    if (settings.bakeBentNormals)
+    {
+        dilate(bentMap, covered, w, h, settings.dilation);
+        result.bentNormals = storeMap(images, bentMap, w, h, false, base + "_BentNormals");
+    }
+
+    if (settings.bakeDirect)
+    {
+        dilate(directMap, covered, w, h, settings.dilation);
+        result.direct = storeMap(images, directMap, w, h, true, base + "_Direct");
+    }
+
+    return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "ImageHandler.hpp"
+
+class Scene;
+class SceneMesh;
+
+/**
+ * @brief What bakeLightmaps() computes and at which resolution.
+ */
+struct LightmapBakeSettings
+{
+    int32_t  width  = 1024; ///< Output texels along U.
+    int32_t  height = 1024; ///< Output texels along V.
+
+    bool bakeAo          = true;  ///< Ambient occlusion (1 = open).
+    bool bakeBentNormals = false; ///< Mean unoccluded direction, world space, encoded n * 0.5 + 0.5.
+    bool bakeDirect      = false; ///< Direct light from the scene lights, with shadows.
+
+    uint32_t aoSamples    = 64;   ///< Hemisphere rays per texel (AO and bent normals).
+    float    aoDistance   = 1.0f; ///< AO ray length in world units; <= 0 = unbounded.
+    uint32_t lightSamples = 4;    ///< Shadow rays per light per texel (soft shadows).
+    float    directScale  = 1.0f; ///< Multiplier before the 8-bit encode of the direct map.
+
+    uint32_t dilation    = 4; ///< Texels to grow each chart by (hides seams under bilinear/mips).
+    uint32_t seed        = 0; ///< Same seed + scene + settings = same maps.
+    uint32_t threadCount = 0; ///< 0 = hardware_concurrency().
+};
+
+/**
+ * @brief Images created by bakeLightmaps(); kInvalidImageId for maps not baked.
+ */
+struct LightmapBakeResult
+{
+    ImageId ao          = kInvalidImageId;
+    ImageId bentNormals = kInvalidImageId;
+    ImageId direct      = kInvalidImageId;
+};
+
+/**
+ * @brief Progress hook, called between batches of rows with the fraction done.
+ * @return false to cancel the bake (no images are created).
+ */
+using LightmapBakeProgress = std::function<bool(float done)>;
+
+/**
+ * @brief Bake AO, bent normals and/or direct light of @p mesh into its UV0 layout.
+ *
+ * Every polygon is rasterized in UV space (map MESH_MAP_UV0) and each
+ * covered texel centre is traced against the scene's Embree BVH, so the
+ * other meshes occlude and shadow it too. Direct light uses the scene
+ * lights only (buildSceneLights()); the headlight is view dependent and is
+ * left out. It is stored as Lambert radiance for a white surface, scaled
+ * by directScale and sRGB-encoded. AO and bent normals are linear.
+ *
+ * Rows are spread over worker threads; random numbers are hashed from
+ * (seed, texel, sample), so the maps do not depend on the thread count.
+ * Charts are dilated by settings.dilation texels, then each map is added
+ * to @p images as an RGBA8 image named after the mesh.
+ *
+ * Blocks the caller. Call Scene::idle() first so the BVH matches the scene.
+ *
+ * @return false (and logs) if the mesh has no UVs or there is no BVH,
+ *         or false without logging if @p progress cancelled.
+ */
+[[nodiscard]] bool bakeLightmaps(Scene&                      scene,
+                                 const SceneMesh&            mesh,
+                                 ImageHandler&               images,
+                                 const LightmapBakeSettings& settings,
+                                 LightmapBakeResult&         result,
+                                 const LightmapBakeProgress& progress = {});
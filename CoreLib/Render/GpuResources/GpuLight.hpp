@@ -37,7 +37,7 @@
 //   - spot_params:
 //       * x = innerCos, y = outerCos (both derived from cone angles)
 //       * z = RT soft-shadow angular radius (point/spot)
-//       * w = reserved
+//       * w = influence radius (point/spot), used for light culling
 //
 // Exposure / tonemapping note:
 //   - Exposure is NOT a light parameter.
@@ -76,7 +76,8 @@ struct alignas(16) GpuLight
     glm::vec3 color     = glm::vec3(0.0f);
     float     intensity = 0.0f;
 
-    // x = spot inner cos, y = spot outer cos, z = RT soft-shadow angular radius, w reserved
+    // x = spot inner cos, y = spot outer cos, z = RT soft-shadow angular radius,
+    // w = influence radius (point/spot; beyond it the light is negligible)
     glm::vec4 spot_params = glm::vec4(0.0f);
 };
 
@@ -3,7 +3,8 @@
 // ============================================================
 //
 // Conventions:
-//   - All lights in GpuLightsUBO are expressed in WORLD space.
+//   - All lights in the light buffer are expressed in WORLD space.
+//     Directional lights come first (GpuLightsUBO.dirCount), then point/spot.
 //     * Directional: lights[i].direction = forward (WORLD)
 //     * Point:       lights[i].position  = position (WORLD)
 //     * Spot:        lights[i].position  = position (WORLD)
@@ -19,7 +20,8 @@
 // IMPORTANT:
 //   - out.ambient      = ambient fill color (already scaled by ambientFill)
 //   - out.exposure     = exposure scalar used by shaders
-//   - out.count        = number of active lights
+//   - out.count        = number of active lights (no cap; they go to an SSBO)
+//   - out.cluster*     = view-depth range of the raster light-cluster grid
 //
 // Production/editor behavior (this file):
 //   - NO auto-exposure derived from max light intensity.
@@ -96,24 +98,54 @@ namespace
                          std::clamp(c.z, 0.0f, 1.0f));
     }
 
-    static std::uint32_t lightCount(const GpuLightsUBO& ubo) noexcept
+    // ------------------------------------------------------------
+    // Light culling
+    // ------------------------------------------------------------
+    // Must match LIGHT_INTENSITY_SCALE in ShadedDraw.frag / RtScene.rchit.
+    constexpr float kShaderIntensityScale = 5.0f;
+
+    // Radiance (before exposure) below which a point/spot light is treated
+    // as out of reach. Exposure maps to at most 2^3, so this stays well
+    // under one 8-bit step after tonemapping.
+    constexpr float kLightCullRadiance = 1e-4f;
+
+    static void pushLight(std::vector<GpuLight>& out, const GpuLight& l) noexcept
     {
-        return ubo.count;
+        out.push_back(l);
     }
 
-    static void setLightCount(GpuLightsUBO& ubo, std::uint32_t v) noexcept
+    // Distance past which an inverse-square light falls below kLightCullRadiance
+    // (or its range, if that is shorter).
+    static float influenceRadius(const GpuLight& l) noexcept
     {
-        ubo.count = v;
+        const float peak   = l.intensity * kShaderIntensityScale * std::max(l.color.x, std::max(l.color.y, l.color.z));
+        float       radius = std::sqrt(std::max(peak, 0.0f) / kLightCullRadiance);
+
+        if (l.range > 0.0f)
+            radius = std::min(radius, l.range);
+
+        return radius;
     }
 
-    static void pushLight(GpuLightsUBO& out, const GpuLight& l) noexcept
+    // View-depth range of the cluster grid, from a Vulkan (depth 0..1) projection.
+    static void setClusterRange(const glm::mat4& proj, GpuLightsUBO& out) noexcept
     {
-        const std::uint32_t count = lightCount(out);
-        if (count >= kMaxGpuLights)
+        const float p22 = proj[2][2];
+        const float p32 = proj[3][2];
+
+        if (std::abs(p22) < 1e-12f)
             return;
 
-        out.lights[count] = l;
-        setLightCount(out, count + 1u);
+        const bool  ortho    = proj[3][3] == 1.0f;
+        const float nearDist = p32 / p22;
+        const float farDist  = ortho ? (p32 - 1.0f) / p22 : p32 / (p22 + 1.0f);
+
+        if (!(nearDist > 0.0f) || !(farDist > nearDist) || !std::isfinite(farDist))
+            return;
+
+        out.clusterNear     = nearDist;
+        out.clusterFar      = farDist;
+        out.clusterLogScale = float(kLightClusterCountZ) / std::log(farDist / nearDist);
     }
 
     // Positive-only clamp that FALLS BACK to a default on 0/negative/NaN.
@@ -317,6 +349,105 @@ namespace
         return s;
     }
 
+    constexpr bool kLogSceneLights = false;
+
+    // Scene lights (enabled ones, with the global multipliers applied), unordered.
+    static void appendSceneLights(const LightingSettings& settings,
+                                  const Scene&            scene,
+                                  std::vector<GpuLight>&  lights,
+                                  std::uint32_t&          sceneLightCount,
+                                  float&                  maxSceneLight) noexcept
+    {
+        const float ptIntMul  = clampNonNeg(settings.scenePointIntensityMul, 1.0f);
+        const float ptRngMul  = clampPos(settings.scenePointRangeMul, 1.0f);
+        const float spIntMul  = clampNonNeg(settings.sceneSpotIntensityMul, 1.0f);
+        const float spRngMul  = clampPos(settings.sceneSpotRangeMul, 1.0f);
+        const float spConeMul = clampPos(settings.sceneSpotConeMul, 1.0f);
+
+        const LightHandler* lh = scene.lightHandler();
+        if (!lh)
+            return;
+
+        const auto ids = lh->allLights();
+
+        if constexpr (kLogSceneLights)
+            std::printf("Scene lights: enabled count=%zu\n", ids.size());
+
+        for (LightId id : ids)
+        {
+            const Light* l = lh->light(id);
+            if (!l || !l->enabled)
+                continue;
+
+            float intensity = std::max(0.0f, l->intensity);
+            float range     = std::max(0.0f, l->range);
+
+            if (l->type == LightType::Point)
+            {
+                intensity *= ptIntMul;
+                range *= ptRngMul;
+            }
+            else if (l->type == LightType::Spot)
+            {
+                intensity *= spIntMul;
+                range *= spRngMul;
+            }
+
+            // Logging metric only (NOT used for exposure)
+            const glm::vec3 c01  = clamp01(l->color);
+            const float     cmax = std::max(c01.x, std::max(c01.y, c01.z));
+            maxSceneLight        = std::max(maxSceneLight, intensity * cmax);
+            ++sceneLightCount;
+
+            if constexpr (kLogSceneLights)
+            {
+                const char* typeStr = (l->type == LightType::Directional) ? "Directional"
+                                      : (l->type == LightType::Point)     ? "Point"
+                                                                          : "Spot";
+                std::printf("%-11s Light:   I=%.3f  range=%.3f  color=(%.3f %.3f %.3f)\n",
+                            typeStr,
+                            intensity,
+                            range,
+                            c01.x,
+                            c01.y,
+                            c01.z);
+            }
+
+            switch (l->type)
+            {
+                case LightType::Directional:
+                    pushLight(lights, makeDirectionalWorld(l->direction, l->color, intensity, 0.0f));
+                    break;
+
+                case LightType::Point:
+                    pushLight(lights, makePointWorld(l->position, l->color, intensity, range, kScenePointSoftnessRadians));
+                    break;
+
+                case LightType::Spot: {
+                    float innerRad = l->spotInnerConeRad;
+                    float outerRad = l->spotOuterConeRad;
+                    scaleSpotCones(innerRad, outerRad, spConeMul);
+
+                    pushLight(lights, makeSpotWorld(l->position, l->direction, l->color, intensity, range, innerRad, outerRad, kSceneSpotSoftnessRadians));
+                    break;
+                }
+            }
+        }
+    }
+
+    // Directional lights first, influence radii for the rest. Returns the directional count.
+    static std::uint32_t orderLights(std::vector<GpuLight>& lights) noexcept
+    {
+        const auto firstLocal = std::stable_partition(lights.begin(), lights.end(), [](const GpuLight& l) {
+            return l.type == static_cast<std::uint32_t>(GpuLightType::Directional);
+        });
+
+        for (auto it = firstLocal; it != lights.end(); ++it)
+            it->spot_params.w = influenceRadius(*it);
+
+        return static_cast<std::uint32_t>(firstLocal - lights.begin());
+    }
+
 } // namespace
 
 //============================================================
@@ -326,16 +457,17 @@ void buildGpuLightsUBO(const LightingSettings&  settings,
                        const HeadlightSettings& headlight,
                        const Viewport&          vp,
                        const Scene*             scene,
-                       GpuLightsUBO&            out) noexcept
+                       GpuLightsUBO&            out,
+                       std::vector<GpuLight>&   lights) noexcept
 {
-    constexpr bool kLogSceneLights = false;
-
     // Zero everything; then explicitly reset the header fields for clarity.
     out          = {};
     out.count    = 0u;
     out.ambient  = glm::vec3(0.0f);
     out.exposure = 0.0f;
 
+    lights.clear();
+
     const DrawMode dm = vp.drawMode();
 
     if constexpr (kLogSceneLights)
@@ -377,7 +509,7 @@ void buildGpuLightsUBO(const LightingSettings&  settings,
             const glm::vec3 dirWorld = viewportForwardWorld(vp);
 
             // NOTE: spot_params.z used by RT for soft shadows (optional)
-            pushLight(out, makeSpotWorld(posWorld, dirWorld, headlight.color, headlight.intensity, kHeadlightRange, kHeadlightInnerRad, kHeadlightOuterRad, kSceneSpotSoftnessRadians));
+            pushLight(lights, makeSpotWorld(posWorld, dirWorld, headlight.color, headlight.intensity, kHeadlightRange, kHeadlightInnerRad, kHeadlightOuterRad, kSceneSpotSoftnessRadians));
 
             if constexpr (kLogSceneLights)
                 std::printf("Headlight: FLASHLIGHT SPOT  I=%.3f\n", headlight.intensity);
@@ -411,7 +543,7 @@ void buildGpuLightsUBO(const LightingSettings&  settings,
                 }
             }
 
-            pushLight(out, makeDirectionalWorld(dirWorld, headlight.color, headlight.intensity, kHeadlightSoftnessRadians));
+            pushLight(lights, makeDirectionalWorld(dirWorld, headlight.color, headlight.intensity, kHeadlightSoftnessRadians));
 
             if constexpr (kLogSceneLights)
             {
@@ -430,86 +562,9 @@ void buildGpuLightsUBO(const LightingSettings&  settings,
     std::uint32_t sceneLightCount = 0u;
     float         maxSceneLight   = 0.0f; // logging only
 
-    const float ptIntMul  = clampNonNeg(settings.scenePointIntensityMul, 1.0f);
-    const float ptRngMul  = clampPos(settings.scenePointRangeMul, 1.0f);
-    const float spIntMul  = clampNonNeg(settings.sceneSpotIntensityMul, 1.0f);
-    const float spRngMul  = clampPos(settings.sceneSpotRangeMul, 1.0f);
-    const float spConeMul = clampPos(settings.sceneSpotConeMul, 1.0f);
-
     if (allowSceneLights(settings, dm) && scene)
     {
-        const LightHandler* lh = scene->lightHandler();
-        if (lh)
-        {
-            const auto ids = lh->allLights();
-
-            if constexpr (kLogSceneLights)
-                std::printf("Scene lights: enabled count=%zu\n", ids.size());
-
-            for (LightId id : ids)
-            {
-                const Light* l = lh->light(id);
-                if (!l || !l->enabled)
-                    continue;
-
-                float intensity = std::max(0.0f, l->intensity);
-                float range     = std::max(0.0f, l->range);
-
-                if (l->type == LightType::Point)
-                {
-                    intensity *= ptIntMul;
-                    range *= ptRngMul;
-                }
-                else if (l->type == LightType::Spot)
-                {
-                    intensity *= spIntMul;
-                    range *= spRngMul;
-                }
-
-                // Logging metric only (NOT used for exposure)
-                const glm::vec3 c01  = clamp01(l->color);
-                const float     cmax = std::max(c01.x, std::max(c01.y, c01.z));
-                maxSceneLight        = std::max(maxSceneLight, intensity * cmax);
-                ++sceneLightCount;
-
-                if constexpr (kLogSceneLights)
-                {
-                    const char* typeStr = (l->type == LightType::Directional) ? "Directional"
-                                          : (l->type == LightType::Point)     ? "Point"
-                                                                              : "Spot";
-                    std::printf("%-11s Light:   I=%.3f  range=%.3f  color=(%.3f %.3f %.3f)\n",
-                                typeStr,
-                                intensity,
-                                range,
-                                c01.x,
-                                c01.y,
-                                c01.z);
-                }
-
-                switch (l->type)
-                {
-                    case LightType::Directional:
-                        pushLight(out, makeDirectionalWorld(l->direction, l->color, intensity, 0.0f));
-                        break;
-
-                    case LightType::Point:
-                        pushLight(out, makePointWorld(l->position, l->color, intensity, range, kScenePointSoftnessRadians));
-                        break;
-
-                    case LightType::Spot: {
-                        float innerRad = l->spotInnerConeRad;
-                        float outerRad = l->spotOuterConeRad;
-                        scaleSpotCones(innerRad, outerRad, spConeMul);
-
-                        pushLight(out, makeSpotWorld(l->position, l->direction, l->color, intensity, range, innerRad, outerRad, kSceneSpotSoftnessRadians));
-                        break;
-                    }
-                }
-
-                if (out.count >= kMaxGpuLights)
-                    break;
-            }
-        }
+        appendSceneLights(settings, *scene, lights, sceneLightCount, maxSceneLight);
     }
     else
     {
@@ -518,7 +573,15 @@ void buildGpuLightsUBO(const LightingSettings&  settings,
     }
 
     // ------------------------------------------------------------
-    // 3) Ambient.rgb (fill) and exposure scalar
+    // 3) Order (directional first) and culling radii
+    // ------------------------------------------------------------
+    out.dirCount = orderLights(lights);
+    out.count    = static_cast<std::uint32_t>(lights.size());
+
+    setClusterRange(vp.projection(), out);
+
+    // ------------------------------------------------------------
+    // 4) Ambient.rgb (fill) and exposure scalar
     // ------------------------------------------------------------
     const float fill = std::max(0.0f, settings.ambientFill);
     out.ambient      = glm::vec3(fill);
@@ -538,3 +601,22 @@ void buildGpuLightsUBO(const LightingSettings&  settings,
                     maxSceneLight);
     }
 }
+
+//============================================================
+// buildSceneLights()
+//============================================================
+std::uint32_t buildSceneLights(const LightingSettings& settings,
+                               const Scene*            scene,
+                               std::vector<GpuLight>&  lights) noexcept
+{
+    lights.clear();
+
+    if (!scene || !settings.useSceneLights)
+        return 0u;
+
+    std::uint32_t sceneLightCount = 0u;
+    float         maxSceneLight   = 0.0f;
+    appendSceneLights(settings, *scene, lights, sceneLightCount, maxSceneLight);
+
+    return orderLights(lights);
+}
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <glm/glm.hpp>
+#include <vector>
 
 #include "GpuLight.hpp"
 #include "LightingSettings.hpp"
@@ -9,38 +10,61 @@
 class Scene;
 class Viewport;
 
-constexpr std::uint32_t kMaxGpuLights = 64;
+// ------------------------------------------------------------
+// Clustered light culling (raster)
+// ------------------------------------------------------------
+// The view frustum is split into a fixed grid of clusters: X * Y screen
+// tiles and Z slices, exponentially spaced in view depth. LightCluster.comp
+// writes, per cluster, the point/spot lights whose influence sphere touches
+// it; ShadedDraw.frag then only walks its own cluster's list.
+//
+// Cluster c occupies kLightClusterStride uints of the cluster buffer:
+//   [0] = light count n (<= kMaxLightsPerCluster), [1..n] = light indices.
+// Shader constants (LightCluster.comp, ShadedDraw.frag) must match.
+constexpr std::uint32_t kLightClusterCountX     = 16;
+constexpr std::uint32_t kLightClusterCountY     = 9;
+constexpr std::uint32_t kLightClusterCountZ     = 24;
+constexpr std::uint32_t kLightClusterCount      = kLightClusterCountX * kLightClusterCountY * kLightClusterCountZ;
+constexpr std::uint32_t kLightClusterStride     = 128;
+constexpr std::uint32_t kMaxLightsPerCluster    = kLightClusterStride - 1;
+constexpr std::uint64_t kLightClusterBufferSize = std::uint64_t(kLightClusterCount) * kLightClusterStride * sizeof(std::uint32_t);
 
 /**
- * @brief std140-friendly UBO payload for lights.
+ * @brief std140-friendly UBO header for lights.
  *
+ * The lights themselves live in a storage buffer (set=0, binding=2) with no
+ * fixed cap. They are ordered: directional lights first, then point/spot.
  * All lights are provided in WORLD SPACE.
- * Shaders operate entirely in world space.
  *
  * Layout (matches std140 in GLSL):
- *   - count:   number of active lights (<= kMaxGpuLights)
- *   - pad0/1/2: explicit padding to keep 16-byte alignment
- *   - ambient: rgb ambient fill color
- *   - exposure: scalar used by shaders for exposure mapping
- *   - lights[]: array of GpuLight structs in WORLD SPACE
+ *   - count:        number of lights in the light buffer
+ *   - dirCount:     lights[0, dirCount) are directional (always evaluated)
+ *   - bvhNodeCount: nodes in the RT light BVH buffer (0 = not built)
+ *   - ambient:      rgb ambient fill color
+ *   - exposure:     scalar used by shaders for exposure mapping
+ *   - cluster*:     view-depth range of the cluster grid (raster)
  */
 struct alignas(16) GpuLightsUBO
 {
-    // Number of active lights (0..kMaxGpuLights).
-    // Explicit pads for std140 alignment (4 * uint = 16 bytes).
-    std::uint32_t count = 0u;
-    std::uint32_t pad0  = 0u;
-    std::uint32_t pad1  = 0u;
-    std::uint32_t pad2  = 0u;
+    std::uint32_t count        = 0u;
+    std::uint32_t dirCount     = 0u;
+    std::uint32_t bvhNodeCount = 0u;
+    std::uint32_t pad0         = 0u;
 
     // rgb = ambient fill color, exposure = scalar used by shaders
     glm::vec3 ambient  = glm::vec3(0.0f);
     float     exposure = 0.0f;
 
-    GpuLight lights[kMaxGpuLights] = {};
+    // Cluster slice k spans view depth near * (far/near)^(k/Z) .. ^((k+1)/Z).
+    // clusterLogScale = Z / log(far/near).
+    float clusterNear     = 0.0f;
+    float clusterFar      = 0.0f;
+    float clusterLogScale = 0.0f;
+    float pad1            = 0.0f;
 };
 
 static_assert(alignof(GpuLightsUBO) == 16, "GpuLightsUBO must be 16-byte aligned");
+static_assert(sizeof(GpuLightsUBO) == 48, "GpuLightsUBO must match the std140 LightsUBO block");
 
 /**
  * @brief Simple render-time headlight (modeling light) driven by the camera.
@@ -52,8 +76,27 @@ struct HeadlightSettings
     float     intensity = 1.0f;
 };
 
+/**
+ * @brief Gather the lights active for @p vp into @p lights and fill the header.
+ *
+ * Directional lights come first (out.dirCount of them), then point/spot
+ * lights with their influence radius in spot_params.w.
+ */
 void buildGpuLightsUBO(const LightingSettings&  settings,
                        const HeadlightSettings& headlight,
                        const Viewport&          vp,
                        const Scene*             scene,
-                       GpuLightsUBO&            out) noexcept;
+                       GpuLightsUBO&            out,
+                       std::vector<GpuLight>&   lights) noexcept;
+
+/**
+ * @brief Gather only the scene lights, independent of any viewport.
+ *
+ * Same conversion as buildGpuLightsUBO() but without the headlight and the
+ * per-draw-mode policy (for view-independent work such as lightmap baking).
+ *
+ * @return Number of directional lights at the front of @p lights.
+ */
+std::uint32_t buildSceneLights(const LightingSettings& settings,
+                               const Scene*            scene,
+                               std::vector<GpuLight>&  lights) noexcept;
@@ -16,7 +16,7 @@ GpuMaterial toGpuMaterial(const Material& m)
     out.ior               = m.ior();
     out.pad0              = 0.0f;
 
-    // Texture indices are filled in buildGpuMaterialArray()
+    // Texture indices are filled in buildGpuMaterial()
     out.baseColorTexture = -1;
     out.normalTexture    = -1;
     out.mraoTexture      = -1;
@@ -25,94 +25,55 @@ GpuMaterial toGpuMaterial(const Material& m)
     return out;
 }
 
-void buildGpuMaterialArray(const std::vector<Material>& src,
-                           TextureHandler&              texHandler,
-                           std::vector<GpuMaterial>&    dst)
+namespace
 {
-    dst.clear();
-    dst.reserve(src.size());
-
-    // Common texture desc presets based on your enum class TextureUsage { Color, Normal, Data };
-    TextureDesc baseDesc{};
-    baseDesc.usage           = TextureUsage::Color;
-    baseDesc.generateMipmaps = true;
-    baseDesc.srgb            = true; // color maps in sRGB
-
-    TextureDesc normalDesc{};
-    normalDesc.usage           = TextureUsage::Normal;
-    normalDesc.generateMipmaps = true;
-    normalDesc.srgb            = false; // normals are linear data
-
-    TextureDesc mraoDesc{};
-    mraoDesc.usage           = TextureUsage::Data;
-    mraoDesc.generateMipmaps = true;
-    mraoDesc.srgb            = false; // MRAO is linear
+    // Texture desc presets by slot (TextureUsage { Color, Normal, Data }).
+    TextureDesc makeTextureDesc(TextureUsage usage, bool srgb)
+    {
+        TextureDesc desc{};
+        desc.usage           = usage;
+        desc.generateMipmaps = true;
+        desc.srgb            = srgb;
+        return desc;
+    }
 
-    TextureDesc emissiveDesc{};
-    emissiveDesc.usage           = TextureUsage::Color;
-    emissiveDesc.generateMipmaps = true;
-    emissiveDesc.srgb            = true; // emissive is color
+    const TextureDesc kBaseDesc     = makeTextureDesc(TextureUsage::Color, true);   // color maps in sRGB
+    const TextureDesc kNormalDesc   = makeTextureDesc(TextureUsage::Normal, false); // normals are linear data
+    const TextureDesc kMraoDesc     = makeTextureDesc(TextureUsage::Data, false);   // MRAO is linear
+    const TextureDesc kEmissiveDesc = makeTextureDesc(TextureUsage::Color, true);   // emissive is color
 
-    for (const Material& m : src)
+    // -1 if the material has no image in this slot (or it cannot be loaded).
+    std::int32_t textureFor(TextureHandler&    texHandler,
+                            ImageId            imageId,
+                            const TextureDesc& desc,
+                            const std::string& debugName)
     {
-        GpuMaterial gm = toGpuMaterial(m);
+        if (imageId == kInvalidImageId)
+            return -1;
 
-        // baseColorTexture (Material stores ImageId)
-        if (m.baseColorTexture() != kInvalidImageId)
-        {
-            TextureId tid = texHandler.ensureTexture(
-                m.baseColorTexture(),
-                baseDesc,
-                m.name() + "_BaseColor");
-            gm.baseColorTexture = tid; // -1 or >= 0
-        }
-        else
-        {
-            gm.baseColorTexture = -1;
-        }
+        return texHandler.ensureTexture(imageId, desc, debugName);
+    }
+} // namespace
 
-        // normalTexture
-        if (m.normalTexture() != kInvalidImageId)
-        {
-            TextureId tid = texHandler.ensureTexture(
-                m.normalTexture(),
-                normalDesc,
-                m.name() + "_Normal");
-            gm.normalTexture = tid;
-        }
-        else
-        {
-            gm.normalTexture = -1;
-        }
+GpuMaterial buildGpuMaterial(const Material& m, TextureHandler& texHandler)
+{
+    GpuMaterial gm = toGpuMaterial(m);
 
-        // mraoTexture (Data)
-        if (m.mraoTexture() != kInvalidImageId)
-        {
-            TextureId tid = texHandler.ensureTexture(
-                m.mraoTexture(),
-                mraoDesc,
-                m.name() + "_MRAO");
-            gm.mraoTexture = tid;
-        }
-        else
-        {
-            gm.mraoTexture = -1;
-        }
+    gm.baseColorTexture = textureFor(texHandler, m.baseColorTexture(), kBaseDesc, m.name() + "_BaseColor");
+    gm.normalTexture    = textureFor(texHandler, m.normalTexture(), kNormalDesc, m.name() + "_Normal");
+    gm.mraoTexture      = textureFor(texHandler, m.mraoTexture(), kMraoDesc, m.name() + "_MRAO");
+    gm.emissiveTexture  = textureFor(texHandler, m.emissiveTexture(), kEmissiveDesc, m.name() + "_Emissive");
 
-        // emissiveTexture
-        if (m.emissiveTexture() != kInvalidImageId)
-        {
-            TextureId tid = texHandler.ensureTexture(
-                m.emissiveTexture(),
-                emissiveDesc,
-                m.name() + "_Emissive");
-            gm.emissiveTexture = tid;
-        }
-        else
-        {
-            gm.emissiveTexture = -1;
-        }
+    return gm;
+}
 
-        dst.push_back(gm);
-    }
+void buildGpuMaterialArray(const std::vector<Material>& src,
+                           TextureHandler&              texHandler,
+                           std::vector<GpuMaterial>&    dst)
+{
+    dst.clear();
+    dst.reserve(src.size());
+
+    for (const Material& m : src)
+        dst.push_back(buildGpuMaterial(m, texHandler));
 }
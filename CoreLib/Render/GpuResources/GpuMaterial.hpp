@@ -48,6 +48,12 @@ struct GpuMaterial
  */
 GpuMaterial toGpuMaterial(const Material& src);
 
+/**
+ * @brief Convert a Material, resolving its images to TextureIds (creating
+ *        textures on first use).
+ */
+GpuMaterial buildGpuMaterial(const Material& src, TextureHandler& texHandler);
+
 /**
  * @brief Build a contiguous GPU array from a list of Materials.
  */
@@ -0,0 +1,96 @@
+#include "LightBvh.hpp"
+
+#include <algorithm>
+#include <glm/common.hpp>
+
+namespace
+{
+    struct BuildItem
+    {
+        glm::vec3     position = glm::vec3(0.0f);
+        float         power    = 0.0f;
+        std::uint32_t light    = 0u;
+    };
+
+    // Fill node @p nodeIndex from items[begin, end) and recurse (median split
+    // along the widest axis of the light positions).
+    void buildNode(std::vector<BuildItem>&       items,
+                   std::size_t                   begin,
+                   std::size_t                   end,
+                   std::uint32_t                 nodeIndex,
+                   std::vector<GpuLightBvhNode>& nodes)
+    {
+        glm::vec3 lo    = items[begin].position;
+        glm::vec3 hi    = items[begin].position;
+        float     power = 0.0f;
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            lo = glm::min(lo, items[i].position);
+            hi = glm::max(hi, items[i].position);
+            power += items[i].power;
+        }
+
+        nodes[nodeIndex].boundsMin = lo;
+        nodes[nodeIndex].boundsMax = hi;
+        nodes[nodeIndex].power     = power;
+
+        if (end - begin == 1)
+        {
+            nodes[nodeIndex].child = kLightBvhLeaf | items[begin].light;
+            return;
+        }
+
+        const glm::vec3 extent = hi - lo;
+
+        int axis = 0;
+        if (extent.y > extent[axis])
+            axis = 1;
+        if (extent.z > extent[axis])
+            axis = 2;
+
+        const std::size_t mid = begin + (end - begin) / 2;
+
+        std::nth_element(items.begin() + begin, items.begin() + mid, items.begin() + end, [axis](const BuildItem& a, const BuildItem& b) {
+            return a.position[axis] < b.position[axis];
+        });
+
+        const std::uint32_t child = static_cast<std::uint32_t>(nodes.size());
+        nodes.resize(nodes.size() + 2);
+        nodes[nodeIndex].child = child;
+
+        buildNode(items, begin, mid, child, nodes);
+        buildNode(items, mid, end, child + 1, nodes);
+    }
+} // namespace
+
+void buildLightBvh(const std::vector<GpuLight>&  lights,
+                   std::uint32_t                 firstLocal,
+                   std::vector<GpuLightBvhNode>& nodes)
+{
+    nodes.clear();
+
+    std::vector<BuildItem> items = {};
+    items.reserve(lights.size() > firstLocal ? lights.size() - firstLocal : 0);
+
+    for (std::size_t i = firstLocal; i < lights.size(); ++i)
+    {
+        const GpuLight& l = lights[i];
+        if (l.type == static_cast<std::uint32_t>(GpuLightType::Directional))
+            continue;
+
+        const float power = l.intensity * std::max(l.color.x, std::max(l.color.y, l.color.z));
+        if (!(power > 0.0f))
+            continue;
+
+        items.push_back({l.position, power, static_cast<std::uint32_t>(i)});
+    }
+
+    if (items.empty())
+        return;
+
+    nodes.reserve(items.size() * 2 - 1);
+    nodes.resize(1);
+
+    buildNode(items, 0, items.size(), 0, nodes);
+}
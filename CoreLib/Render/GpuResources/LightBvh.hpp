@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/vec3.hpp>
+#include <vector>
+
+#include "GpuLight.hpp"
+
+/// Set in GpuLightBvhNode::child for leaves; the low bits are the light index.
+constexpr std::uint32_t kLightBvhLeaf = 0x80000000u;
+
+/**
+ * @brief Node of the ray tracing light BVH (std430, set=0 binding=4).
+ *
+ * Built on the CPU over the point/spot lights of the light buffer. The RT
+ * closest-hit shader walks it stochastically: at each node it picks a child
+ * with probability proportional to an importance estimate (power over
+ * squared distance, zero if the box is behind the surface), so a shading
+ * point samples one light out of hundreds in O(log n) instead of looping
+ * over all of them.
+ *
+ * Node 0 is the root. Children of an internal node are stored next to each
+ * other: child and child + 1.
+ */
+struct alignas(16) GpuLightBvhNode
+{
+    glm::vec3     boundsMin = glm::vec3(0.0f); ///< Light positions below this node.
+    float         power     = 0.0f;            ///< Sum of intensity * max(color).
+    glm::vec3     boundsMax = glm::vec3(0.0f);
+    std::uint32_t child     = 0u; ///< Internal: first child index. Leaf: kLightBvhLeaf | light index.
+};
+
+static_assert(sizeof(GpuLightBvhNode) == 32, "GpuLightBvhNode must match the std430 LightBvhNode struct");
+
+/**
+ * @brief Build the light BVH over lights[firstLocal, lights.size()).
+ *
+ * Lights that emit nothing are left out. @p nodes is cleared and stays empty
+ * if no light qualifies. Leaves hold one light each; light indices refer to
+ * @p lights (the whole light buffer, not the local range).
+ */
+void buildLightBvh(const std::vector<GpuLight>&  lights,
+                   std::uint32_t                 firstLocal,
+                   std::vector<GpuLightBvhNode>& nodes);
@@ -0,0 +1,89 @@
+#include "LightClusterPass.hpp"
+
+#include <iostream>
+
+#include "GpuLights.hpp"
+#include "ShaderStage.hpp"
+#include "VkPipelineHelpers.hpp"
+#include "VkUtilities.hpp"
+
+namespace
+{
+    // Must match local_size_x in LightCluster.comp.
+    constexpr uint32_t kGroupSize = 64;
+} // namespace
+
+bool LightClusterPass::initDevice(const VulkanContext& ctx, VkDescriptorSetLayout set0Layout)
+{
+    shutdown();
+
+    if (!ctx.device || set0Layout == VK_NULL_HANDLE)
+        return false;
+
+    m_device = ctx.device;
+
+    VkPipelineLayoutCreateInfo plci{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+    plci.setLayoutCount = 1;
+    plci.pSetLayouts    = &set0Layout;
+
+    if (vkCreatePipelineLayout(m_device, &plci, nullptr, &m_pipelineLayout) != VK_SUCCESS)
+    {
+        std::cerr << "LightClusterPass: failed to create pipeline layout.\n";
+        shutdown();
+        return false;
+    }
+
+    ShaderStage comp = vkutil::loadStage(m_device, "LightCluster.comp.spv", VK_SHADER_STAGE_COMPUTE_BIT);
+    if (!comp.isValid())
+    {
+        std::cerr << "LightClusterPass: failed to load LightCluster.comp.\n";
+        shutdown();
+        return false;
+    }
+
+    VkComputePipelineCreateInfo cpci{VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+    cpci.stage  = comp.stageInfo();
+    cpci.layout = m_pipelineLayout;
+
+    if (vkCreateComputePipelines(m_device, ctx.pipelineCache, 1, &cpci, nullptr, &m_pipeline) != VK_SUCCESS)
+    {
+        std::cerr << "LightClusterPass: failed to create pipeline.\n";
+        shutdown();
+        return false;
+    }
+
+    return true;
+}
+
+void LightClusterPass::shutdown() noexcept
+{
+    if (!m_device)
+        return;
+
+    if (m_pipeline != VK_NULL_HANDLE)
+    {
+        vkDestroyPipeline(m_device, m_pipeline, nullptr);
+        m_pipeline = VK_NULL_HANDLE;
+    }
+
+    if (m_pipelineLayout != VK_NULL_HANDLE)
+    {
+        vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+        m_pipelineLayout = VK_NULL_HANDLE;
+    }
+
+    m_device = VK_NULL_HANDLE;
+}
+
+void LightClusterPass::dispatch(VkCommandBuffer cmd, VkDescriptorSet set0) const noexcept
+{
+    if (!valid() || cmd == VK_NULL_HANDLE || set0 == VK_NULL_HANDLE)
+        return;
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, 1, &set0, 0, nullptr);
+
+    vkCmdDispatch(cmd, (kLightClusterCount + kGroupSize - 1) / kGroupSize, 1, 1);
+
+    vkutil::barrierComputeToGraphicsShaderRead(cmd);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "VulkanContext.hpp"
+
+/**
+ * @brief Compute pre-pass that bins point/spot lights into view clusters.
+ *
+ * Runs LightCluster.comp over the frame-globals set (set=0): it reads the
+ * camera (binding 0), the lights header and buffer (bindings 1, 2) and
+ * writes the per-cluster light lists (binding 3) that ShadedDraw.frag walks.
+ * See GpuLights.hpp for the grid layout.
+ *
+ * Record dispatch() outside a render pass, after the frame globals of the
+ * set have been uploaded and before the draws that read the clusters.
+ */
+class LightClusterPass final
+{
+public:
+    LightClusterPass() noexcept  = default;
+    ~LightClusterPass() noexcept = default;
+
+    LightClusterPass(const LightClusterPass&)            = delete;
+    LightClusterPass& operator=(const LightClusterPass&) = delete;
+
+public:
+    [[nodiscard]] bool initDevice(const VulkanContext& ctx, VkDescriptorSetLayout set0Layout);
+    void               shutdown() noexcept;
+
+    [[nodiscard]] bool valid() const noexcept
+    {
+        return m_pipeline != VK_NULL_HANDLE;
+    }
+
+    /// Build the cluster lists for @p set0 and make them visible to fragment shaders.
+    void dispatch(VkCommandBuffer cmd, VkDescriptorSet set0) const noexcept;
+
+private:
+    VkDevice         m_device         = VK_NULL_HANDLE;
+    VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+    VkPipeline       m_pipeline       = VK_NULL_HANDLE;
+};
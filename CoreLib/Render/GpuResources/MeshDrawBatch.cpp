@@ -0,0 +1,372 @@
+//============================================================
+// MeshDrawBatch.cpp
+//============================================================
+#include "MeshDrawBatch.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "MeshGpuResources.hpp"
+#include "RenderGeometry.hpp"
+#include "SceneMesh.hpp"
+#include "VkUtilities.hpp"
+
+namespace
+{
+    constexpr VkDeviceSize kPosStride = sizeof(glm::vec3);
+    constexpr VkDeviceSize kNrmStride = sizeof(glm::vec3);
+    constexpr VkDeviceSize kUvStride  = sizeof(glm::vec2);
+    constexpr VkDeviceSize kMatStride = sizeof(std::int32_t);
+
+    constexpr uint32_t kInitialVertexCapacity = 64u * 1024u;
+
+    // Previous transfer writes (mesh stream uploads) and vertex fetches of the
+    // arenas must finish before we copy into the arenas.
+    void barrierBeforeArenaCopy(VkCommandBuffer cmd)
+    {
+        VkMemoryBarrier mb = {};
+        mb.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        mb.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        mb.dstAccessMask   = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             1,
+                             &mb,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+    }
+
+    void deferDestroy(const RenderFrameContext& fc, GpuBuffer& buffer)
+    {
+        if (!buffer.valid())
+            return;
+
+        if (fc.deferred)
+        {
+            fc.deferred->enqueue(fc.frameIndex, [old = std::move(buffer)]() mutable {
+                // destructor runs when lambda is destroyed during flush
+            });
+        }
+        else
+        {
+            buffer.destroy();
+        }
+
+        buffer = {};
+    }
+
+} // namespace
+
+MeshDrawBatch::~MeshDrawBatch() noexcept
+{
+    destroy();
+}
+
+void MeshDrawBatch::init(const VulkanContext& ctx) noexcept
+{
+    destroy();
+
+    m_ctx = ctx;
+
+    m_maxDrawCount = 1;
+    if (m_ctx.supportsMultiDrawIndirect)
+        m_maxDrawCount = std::max(1u, m_ctx.deviceProps.limits.maxDrawIndirectCount);
+}
+
+void MeshDrawBatch::destroy() noexcept
+{
+    // GpuBuffer destructors release the arenas and indirect buffers.
+    m_viewports.clear();
+    m_scratchSlots.clear();
+}
+
+void MeshDrawBatch::releaseViewport(const Viewport* vp) noexcept
+{
+    m_viewports.erase(vp);
+}
+
+//==================================================================
+// Packing
+//==================================================================
+
+bool MeshDrawBatch::ensureArenaCapacity(const RenderFrameContext& fc, Arena& arena, uint32_t vertexCount)
+{
+    if (vertexCount <= arena.vertexCapacity && arena.pos.valid())
+        return true;
+
+    uint32_t newCapacity = std::max(arena.vertexCapacity, kInitialVertexCapacity);
+    while (newCapacity < vertexCount)
+        newCapacity = newCapacity + newCapacity / 2;
+
+    deferDestroy(fc, arena.pos);
+    deferDestroy(fc, arena.nrm);
+    deferDestroy(fc, arena.uv);
+    deferDestroy(fc, arena.mat);
+
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+
+    arena.pos = vkutil::createDeviceLocalBufferEmpty(m_ctx, kPosStride * newCapacity, usage, false);
+    arena.nrm = vkutil::createDeviceLocalBufferEmpty(m_ctx, kNrmStride * newCapacity, usage, false);
+    arena.uv  = vkutil::createDeviceLocalBufferEmpty(m_ctx, kUvStride * newCapacity, usage, false);
+    arena.mat = vkutil::createDeviceLocalBufferEmpty(m_ctx, kMatStride * newCapacity, usage, false);
+
+    if (!arena.pos.valid() || !arena.nrm.valid() || !arena.uv.valid() || !arena.mat.valid())
+    {
+        arena.vertexCapacity = 0;
+        return false;
+    }
+
+    arena.vertexCapacity = newCapacity;
+    return true;
+}
+
+void MeshDrawBatch::update(const Viewport* vp, const RenderFrameContext& fc, const std::vector<MeshDrawItem>& items)
+{
+    if (!vp || !m_ctx.device || fc.cmd == VK_NULL_HANDLE || fc.frameIndex >= vkcfg::kMaxFramesInFlight)
+        return;
+
+    Arena& arena = m_viewports[vp].arenas[fc.frameIndex];
+
+    // ------------------------------------------------------------
+    // Gather what would be packed this frame
+    // ------------------------------------------------------------
+    std::vector<Slot>                           next;
+    std::vector<render::geom::GfxMeshGeometry> geos;
+    next.reserve(items.size());
+    geos.reserve(items.size());
+
+    uint32_t totalVerts = 0;
+
+    for (const MeshDrawItem& item : items)
+    {
+        const render::geom::GfxMeshGeometry geo = render::geom::selectGfxGeometry(item.mesh, item.gpu);
+        if (!geo.valid())
+            continue;
+
+        Slot s        = {};
+        s.gpu         = item.gpu;
+        s.version     = item.gpu->gfxVersion();
+        s.firstVertex = totalVerts;
+        s.vertexCount = geo.vertexCount;
+        s.model       = item.mesh->model();
+
+        next.push_back(s);
+        geos.push_back(geo);
+
+        totalVerts += geo.vertexCount;
+    }
+
+    bool layoutChanged = (next.size() != arena.slots.size());
+    for (size_t i = 0; !layoutChanged && i < next.size(); ++i)
+    {
+        layoutChanged = next[i].gpu != arena.slots[i].gpu ||
+                        next[i].vertexCount != arena.slots[i].vertexCount;
+    }
+
+    if (layoutChanged && totalVerts > 0)
+    {
+        if (!ensureArenaCapacity(fc, arena, totalVerts))
+        {
+            // Leave the slot empty; Renderer falls back to per-mesh draws.
+            arena.slots.clear();
+            arena.slotIndex.clear();
+            ++arena.layoutVersion;
+            return;
+        }
+    }
+
+    // ------------------------------------------------------------
+    // GPU->GPU copies for new or changed meshes
+    // ------------------------------------------------------------
+    bool barrierRecorded = false;
+
+    for (size_t i = 0; i < next.size(); ++i)
+    {
+        const Slot& s = next[i];
+
+        if (!layoutChanged && s.version == arena.slots[i].version)
+            continue;
+
+        if (!barrierRecorded)
+        {
+            barrierBeforeArenaCopy(fc.cmd);
+            barrierRecorded = true;
+        }
+
+        const render::geom::GfxMeshGeometry& geo = geos[i];
+
+        auto copy = [&](VkBuffer src, const GpuBuffer& dst, VkDeviceSize stride) {
+            VkBufferCopy cpy = {};
+            cpy.srcOffset    = 0;
+            cpy.dstOffset    = stride * s.firstVertex;
+            cpy.size         = stride * s.vertexCount;
+            vkCmdCopyBuffer(fc.cmd, src, dst.buffer(), 1, &cpy);
+        };
+
+        copy(geo.posBuffer, arena.pos, kPosStride);
+        copy(geo.nrmBuffer, arena.nrm, kNrmStride);
+        copy(geo.matBuffer, arena.mat, kMatStride);
+
+        if (geo.hasUvs())
+            copy(geo.uvBuffer, arena.uv, kUvStride);
+        else
+            vkCmdFillBuffer(fc.cmd, arena.uv.buffer(), kUvStride * s.firstVertex, kUvStride * s.vertexCount, 0u);
+    }
+
+    if (barrierRecorded)
+        vkutil::barrierTransferToVertexAttributeRead(fc.cmd);
+
+    // ------------------------------------------------------------
+    // Per-slot model matrices (host visible, rewritten on change)
+    // ------------------------------------------------------------
+    bool modelsChanged = layoutChanged;
+    for (size_t i = 0; !modelsChanged && i < next.size(); ++i)
+        modelsChanged = next[i].model != arena.slots[i].model;
+
+    if (modelsChanged && !next.empty())
+    {
+        std::vector<glm::mat4> models;
+        models.reserve(next.size());
+        for (const Slot& s : next)
+            models.push_back(s.model);
+
+        const VkDeviceSize bytes = VkDeviceSize(sizeof(glm::mat4)) * models.size();
+
+        if (!arena.models.valid())
+        {
+            arena.models.create(m_ctx.device,
+                                m_ctx.physicalDevice,
+                                bytes,
+                                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                /*persistentMap*/ true);
+        }
+
+        arena.models.upload(models.data(), bytes);
+    }
+
+    // ------------------------------------------------------------
+    // Commit
+    // ------------------------------------------------------------
+    if (layoutChanged)
+    {
+        arena.slotIndex.clear();
+        for (uint32_t i = 0; i < static_cast<uint32_t>(next.size()); ++i)
+            arena.slotIndex[next[i].gpu] = i;
+
+        ++arena.layoutVersion;
+    }
+
+    arena.slots = std::move(next);
+}
+
+bool MeshDrawBatch::contains(const Viewport* vp, uint32_t frameIndex, const MeshGpuResources* gpu) const noexcept
+{
+    if (frameIndex >= vkcfg::kMaxFramesInFlight)
+        return false;
+
+    auto vit = m_viewports.find(vp);
+    if (vit == m_viewports.end())
+        return false;
+
+    const Arena& arena = vit->second.arenas[frameIndex];
+    return arena.slotIndex.find(gpu) != arena.slotIndex.end();
+}
+
+//==================================================================
+// Drawing
+//==================================================================
+
+uint32_t MeshDrawBatch::draw(VkCommandBuffer                  cmd,
+                             const Viewport*                  vp,
+                             uint32_t                         frameIndex,
+                             const std::vector<MeshDrawItem>& draws)
+{
+    if (cmd == VK_NULL_HANDLE || frameIndex >= vkcfg::kMaxFramesInFlight)
+        return 0;
+
+    auto vit = m_viewports.find(vp);
+    if (vit == m_viewports.end())
+        return 0;
+
+    const Arena& arena = vit->second.arenas[frameIndex];
+    if (arena.slots.empty() || !arena.models.valid())
+        return 0;
+
+    m_scratchSlots.clear();
+    for (const MeshDrawItem& d : draws)
+    {
+        auto it = arena.slotIndex.find(d.gpu);
+        if (it != arena.slotIndex.end())
+            m_scratchSlots.push_back(it->second);
+    }
+
+    if (m_scratchSlots.empty())
+        return 0;
+
+    IndirectState& state = vit->second.indirect[frameIndex];
+
+    // Rebuild the indirect commands only if the culled set or the arena layout moved.
+    if (state.layoutVersion != arena.layoutVersion || state.slots != m_scratchSlots || !state.commands.valid())
+    {
+        std::vector<VkDrawIndirectCommand> commands;
+        commands.reserve(m_scratchSlots.size());
+
+        for (uint32_t slot : m_scratchSlots)
+        {
+            const Slot& s = arena.slots[slot];
+
+            VkDrawIndirectCommand c = {};
+            c.vertexCount           = s.vertexCount;
+            c.instanceCount         = 1;
+            c.firstVertex           = s.firstVertex;
+            c.firstInstance         = slot;
+            commands.push_back(c);
+        }
+
+        const VkDeviceSize bytes = VkDeviceSize(sizeof(VkDrawIndirectCommand)) * commands.size();
+
+        if (!state.commands.valid())
+        {
+            state.commands.create(m_ctx.device,
+                                  m_ctx.physicalDevice,
+                                  bytes,
+                                  VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                  /*persistentMap*/ true);
+        }
+
+        state.commands.upload(commands.data(), bytes);
+
+        state.slots         = m_scratchSlots;
+        state.layoutVersion = arena.layoutVersion;
+    }
+
+    if (!state.commands.valid())
+        return 0;
+
+    VkBuffer     bufs[5] = {arena.pos.buffer(), arena.nrm.buffer(), arena.uv.buffer(), arena.mat.buffer(), arena.models.buffer()};
+    VkDeviceSize offs[5] = {0, 0, 0, 0, 0};
+    vkCmdBindVertexBuffers(cmd, 0, 5, bufs, offs);
+
+    constexpr uint32_t stride = sizeof(VkDrawIndirectCommand);
+
+    const uint32_t total = static_cast<uint32_t>(m_scratchSlots.size());
+    uint32_t       calls = 0;
+
+    for (uint32_t first = 0; first < total; first += m_maxDrawCount)
+    {
+        const uint32_t count = std::min(m_maxDrawCount, total - first);
+        vkCmdDrawIndirect(cmd, state.commands.buffer(), VkDeviceSize(first) * stride, count, stride);
+        ++calls;
+    }
+
+    return calls;
+}
@@ -0,0 +1,141 @@
+//============================================================
+// MeshDrawBatch.hpp
+//============================================================
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "GpuBuffer.hpp"
+#include "VulkanContext.hpp"
+
+class SceneMesh;
+class MeshGpuResources;
+class Viewport;
+
+/**
+ * @brief One mesh to draw (or pack) this frame.
+ */
+struct MeshDrawItem
+{
+    SceneMesh*        mesh = nullptr;
+    MeshGpuResources* gpu  = nullptr;
+};
+
+/**
+ * @brief Packs the filled-triangle streams of many meshes into shared arenas
+ *        and draws them with vkCmdDrawIndirect.
+ *
+ * Layout (per viewport and frame-in-flight slot):
+ *  - Four arenas mirroring the solid vertex bindings 0..3 (pos / nrm / uv / matId).
+ *    Each mesh owns a contiguous range [firstVertex, firstVertex + vertexCount).
+ *  - A per-draw stream of model matrices (binding 4, instance rate).
+ *    Each indirect command sets firstInstance = slot so the vertex shader
+ *    (MeshDrawIndirect.vert) picks up its own matrix.
+ *
+ * Each viewport has its own swapchain, frame index, fences and deferred
+ * deletion queue, so its arenas are its own too: one viewport never rewrites
+ * or retires a buffer another viewport's in-flight frame still reads. Next to
+ * them, an indirect command buffer holds the frustum-culled subset of the
+ * packed meshes.
+ *
+ * Update policy:
+ *  - update() is called outside the render pass. Arenas are repacked only when
+ *    the packed mesh set or a vertex count changes (visibility / topology).
+ *    Otherwise only meshes whose MeshGpuResources::gfxVersion() moved are
+ *    re-copied (deforms). Copies are GPU->GPU from the mesh's own streams.
+ *  - draw() rewrites the indirect commands only when the culled set or the
+ *    arena layout changed.
+ *
+ * Requires drawIndirectFirstInstance. multiDrawIndirect is used when available;
+ * otherwise one vkCmdDrawIndirect is issued per mesh (still no rebinding).
+ */
+class MeshDrawBatch
+{
+public:
+    MeshDrawBatch() = default;
+    ~MeshDrawBatch() noexcept;
+
+    MeshDrawBatch(const MeshDrawBatch&)            = delete;
+    MeshDrawBatch& operator=(const MeshDrawBatch&) = delete;
+    MeshDrawBatch(MeshDrawBatch&&)                 = delete;
+    MeshDrawBatch& operator=(MeshDrawBatch&&)      = delete;
+
+    void init(const VulkanContext& ctx) noexcept;
+    void destroy() noexcept;
+
+    /// Free the arenas and indirect command buffers of @p vp. The caller makes sure the GPU is done with them.
+    void releaseViewport(const Viewport* vp) noexcept;
+
+    /// Pack @p items into the arenas of @p vp / fc.frameIndex. Records copies into fc.cmd.
+    void update(const Viewport* vp, const RenderFrameContext& fc, const std::vector<MeshDrawItem>& items);
+
+    /// True if @p gpu was packed into slot @p frameIndex of @p vp by the last update().
+    [[nodiscard]] bool contains(const Viewport* vp, uint32_t frameIndex, const MeshGpuResources* gpu) const noexcept;
+
+    /**
+     * @brief Draw the packed subset of @p draws.
+     *
+     * The caller binds the pipeline (vertex input from makeSolidIndirectVertexInput)
+     * and descriptor sets. Items that are not packed are skipped; use contains()
+     * to draw them through the regular path.
+     *
+     * @return Number of draw commands recorded.
+     */
+    uint32_t draw(VkCommandBuffer                  cmd,
+                  const Viewport*                  vp,
+                  uint32_t                         frameIndex,
+                  const std::vector<MeshDrawItem>& draws);
+
+private:
+    struct Slot
+    {
+        const MeshGpuResources* gpu         = nullptr;
+        uint64_t                version     = 0;
+        uint32_t                firstVertex = 0;
+        uint32_t                vertexCount = 0;
+        glm::mat4               model       = {};
+    };
+
+    struct Arena
+    {
+        GpuBuffer pos;    // vec3
+        GpuBuffer nrm;    // vec3
+        GpuBuffer uv;     // vec2
+        GpuBuffer mat;    // int32
+        GpuBuffer models; // mat4 per slot, host visible
+
+        uint32_t vertexCapacity = 0;
+        uint64_t layoutVersion  = 0;
+
+        std::vector<Slot>                                     slots     = {};
+        std::unordered_map<const MeshGpuResources*, uint32_t> slotIndex = {};
+    };
+
+    struct IndirectState
+    {
+        GpuBuffer             commands;
+        std::vector<uint32_t> slots         = {};
+        uint64_t              layoutVersion = ~0ull;
+    };
+
+    struct ViewportState
+    {
+        std::array<Arena, vkcfg::kMaxFramesInFlight>         arenas   = {};
+        std::array<IndirectState, vkcfg::kMaxFramesInFlight> indirect = {};
+    };
+
+    bool ensureArenaCapacity(const RenderFrameContext& fc, Arena& arena, uint32_t vertexCount);
+
+private:
+    VulkanContext m_ctx          = {};
+    uint32_t      m_maxDrawCount = 1;
+
+    std::unordered_map<const Viewport*, ViewportState> m_viewports = {};
+
+    std::vector<uint32_t> m_scratchSlots = {};
+};
@@ -227,6 +227,7 @@ void MeshGpuResources::destroy() noexcept
     m_subdivSelPolyIndexCount = 0;
 
     m_cachedSubdivLevel = 0;
+    m_gfxVersion        = ++s_gfxVersionCounter;
 }
 
 // ============================================================================
@@ -250,6 +251,10 @@ void MeshGpuResources::update(const RenderFrameContext& fc)
     if (!topoChanged && !deformChanged && !selectChanged && !levelChanged)
         return;
 
+    // Anything but a selection change rewrites the solid streams.
+    if (topoChanged || deformChanged || levelChanged)
+        m_gfxVersion = ++s_gfxVersionCounter;
+
     // ---------------------------------------------------------
     // Subdivision path
     // ---------------------------------------------------------
@@ -327,10 +332,10 @@ void MeshGpuResources::fullRebuild(const RenderFrameContext& fc, const SysMesh*
     m_edgeIndexCount  = static_cast<uint32_t>(edgeIdx.size());
 
     // Solid draw vertex streams (corner-expanded)
-    updateOrRecreate(fc, m_polyVertBuffer, tri.verts, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
-    updateOrRecreate(fc, m_polyNormBuffer, tri.norms, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
-    updateOrRecreate(fc, m_polyUvBuffer, tri.uvPos, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
-    updateOrRecreate(fc, m_polyMatIdBuffer, tri.matIds, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    updateOrRecreate(fc, m_polyVertBuffer, tri.verts, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    updateOrRecreate(fc, m_polyNormBuffer, tri.norms, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    updateOrRecreate(fc, m_polyUvBuffer, tri.uvPos, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    updateOrRecreate(fc, m_polyMatIdBuffer, tri.matIds, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
 
     // Unique per-slot positions (shared)
     const uint32_t slotCount = sys->vert_buffer_size();
@@ -526,12 +531,12 @@ void MeshGpuResources::updateDeformBuffers(const RenderFrameContext& fc, const S
     std::vector<glm::vec3> triVerts = extractTriPositionsOnly(sys);
     m_polyVertexCount               = static_cast<uint32_t>(triVerts.size());
 
-    updateOrRecreate(fc, m_polyVertBuffer, triVerts, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, kCapacity64KiB);
+    updateOrRecreate(fc, m_polyVertBuffer, triVerts, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kCapacity64KiB);
 
     // 3) Corner-expanded normals (optional but recommended for correct lighting while moving)
     std::vector<glm::vec3> norms = extractPolyNormasOnly(sys);
     if (!norms.empty())
-        updateOrRecreate(fc, m_polyNormBuffer, norms, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, kCapacity64KiB);
+        updateOrRecreate(fc, m_polyNormBuffer, norms, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kCapacity64KiB);
 
     // 4) RT position buffer (vec4 padded)
     m_coarseRtPosCount = slotCount;
@@ -798,10 +803,10 @@ void MeshGpuResources::fullRebuildSubdiv(const RenderFrameContext& fc, const Sys
 
         m_subdivPolyVertexCount = static_cast<uint32_t>(pos.size());
 
-        updateOrRecreate(fc, m_subdivPolyVertBuffer, pos, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, kCapacity64KiB);
-        updateOrRecreate(fc, m_subdivPolyNormBuffer, nrm, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, kCapacity64KiB);
-        updateOrRecreate(fc, m_subdivPolyUvBuffer, uv, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, kCapacity64KiB);
-        updateOrRecreate(fc, m_subdivPolyMatIdBuffer, mat, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, kCapacity64KiB);
+        updateOrRecreate(fc, m_subdivPolyVertBuffer, pos, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kCapacity64KiB);
+        updateOrRecreate(fc, m_subdivPolyNormBuffer, nrm, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kCapacity64KiB);
+        updateOrRecreate(fc, m_subdivPolyUvBuffer, uv, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kCapacity64KiB);
+        updateOrRecreate(fc, m_subdivPolyMatIdBuffer, mat, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kCapacity64KiB);
 
         // RT per-corner normals (vec4 padded)
         m_subdivRtCornerNrmCount = 0;
@@ -935,8 +940,8 @@ void MeshGpuResources::updateSubdivDeform(const RenderFrameContext& fc, const Sy
 
         m_subdivPolyVertexCount = static_cast<uint32_t>(pos.size());
 
-        updateOrRecreate(fc, m_subdivPolyVertBuffer, pos, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, kCapacity64KiB);
-        updateOrRecreate(fc, m_subdivPolyNormBuffer, nrm, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, kCapacity64KiB);
+        updateOrRecreate(fc, m_subdivPolyVertBuffer, pos, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kCapacity64KiB);
+        updateOrRecreate(fc, m_subdivPolyNormBuffer, nrm, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kCapacity64KiB);
 
         // RT per-corner normals update
         m_subdivRtCornerNrmCount = 0;
@@ -40,6 +40,10 @@ public:
     const GpuBuffer& polyMatIdBuffer() const { return m_polyMatIdBuffer; } // binding 3, uint32_t
     uint32_t         vertexCount() const { return m_polyVertexCount; }     // triCount*3
 
+    /// Bumped whenever the solid streams (coarse or subdiv) are rewritten or
+    /// recreated. Unique across all instances, so a stale copy never matches.
+    uint64_t gfxVersion() const { return m_gfxVersion; }
+
     // ---------------------------------------------------------
     // Coarse unique verts + edges
     //
@@ -310,6 +314,10 @@ private:
     // Current cached subdivision level (0 = coarse path)
     int m_cachedSubdivLevel = 0;
 
+    // See gfxVersion()
+    uint64_t               m_gfxVersion        = 0;
+    inline static uint64_t s_gfxVersionCounter = 0;
+
     // ---------------------------------------------------------
     // Change monitors
     // ---------------------------------------------------------
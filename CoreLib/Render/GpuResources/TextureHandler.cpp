@@ -4,11 +4,14 @@
 #include "TextureHandler.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstring>
 #include <iostream>
 
+#include "MappedFile.hpp"
+#include "TextureCache.hpp"
 #include "VkTextureUtilities.hpp"
 
 namespace
@@ -99,6 +102,83 @@ namespace
 
         return fmt;
     }
+
+    static TextureCacheVariant cacheVariantFor(const TextureDesc& desc) noexcept
+    {
+        if (desc.usage == TextureUsage::Normal)
+            return TextureCacheVariant::Normal;
+        return desc.srgb ? TextureCacheVariant::ColorSrgb : TextureCacheVariant::Linear;
+    }
+
+    /// 2x2 box-filter @p pixels in place (odd edges clamp). sRGB colour channels are averaged in linear light.
+    void halveImage(std::vector<uint8_t>& pixels, int& width, int& height, int channels, bool srgb)
+    {
+        static const std::array<float, 256> toLinear = []() {
+            std::array<float, 256> t = {};
+            for (int i = 0; i < 256; ++i)
+            {
+                const float c = static_cast<float>(i) / 255.0f;
+                t[i]          = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return t;
+        }();
+
+        static const std::array<uint8_t, 4096> toSrgb = []() {
+            std::array<uint8_t, 4096> t = {};
+            for (int i = 0; i < 4096; ++i)
+            {
+                const float l = static_cast<float>(i) / 4095.0f;
+                const float c = (l <= 0.0031308f) ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                t[i]          = static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+            return t;
+        }();
+
+        const int nw = std::max(1, width / 2);
+        const int nh = std::max(1, height / 2);
+
+        std::vector<uint8_t> out(static_cast<std::size_t>(nw) * static_cast<std::size_t>(nh) * static_cast<std::size_t>(channels));
+
+        auto at = [&](int x, int y) {
+            return pixels.data() + (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) + static_cast<std::size_t>(x)) * static_cast<std::size_t>(channels);
+        };
+
+        uint8_t* d = out.data();
+        for (int y = 0; y < nh; ++y)
+        {
+            const int y0 = std::min(2 * y, height - 1);
+            const int y1 = std::min(2 * y + 1, height - 1);
+
+            for (int x = 0; x < nw; ++x)
+            {
+                const int x0 = std::min(2 * x, width - 1);
+                const int x1 = std::min(2 * x + 1, width - 1);
+
+                const uint8_t* a = at(x0, y0);
+                const uint8_t* b = at(x1, y0);
+                const uint8_t* c = at(x0, y1);
+                const uint8_t* e = at(x1, y1);
+
+                for (int ch = 0; ch < channels; ++ch)
+                {
+                    if (srgb && ch < 3)
+                    {
+                        const float l = 0.25f * (toLinear[a[ch]] + toLinear[b[ch]] + toLinear[c[ch]] + toLinear[e[ch]]);
+                        d[ch]         = toSrgb[static_cast<std::size_t>(l * 4095.0f + 0.5f)];
+                    }
+                    else
+                    {
+                        d[ch] = static_cast<uint8_t>((a[ch] + b[ch] + c[ch] + e[ch] + 2) / 4);
+                    }
+                }
+                d += channels;
+            }
+        }
+
+        pixels = std::move(out);
+        width  = nw;
+        height = nh;
+    }
 } // namespace
 
 namespace
@@ -263,6 +343,10 @@ TextureId TextureHandler::ensureTexture(ImageId            imageId,
     if (imageId == kInvalidImageId)
         return kInvalidTextureId;
 
+    // Duplicate images share one GPU texture.
+    if (m_imageHandler)
+        imageId = m_imageHandler->resolve(imageId);
+
     CacheKey key{imageId, desc.usage, desc.generateMipmaps, desc.srgb};
 
     if (auto it = m_cache.find(key); it != m_cache.end())
@@ -277,6 +361,9 @@ TextureId TextureHandler::ensureTexture(ImageId            imageId,
 
 const GpuTexture* TextureHandler::get(TextureId id) const noexcept
 {
+    if (auto it = m_textureAlias.find(id); it != m_textureAlias.end())
+        id = it->second;
+
     if (!isValidTextureId(id, m_textures.size()))
         return nullptr;
 
@@ -288,16 +375,224 @@ void TextureHandler::destroy(TextureId id) noexcept
     if (!isValidTextureId(id, m_textures.size()))
         return;
 
+    // The slot may be the target of the in-flight batch.
+    retireUploadBatch(true);
+
+    std::erase_if(m_pendingUploads, [id](const PendingUpload& p) { return p.id == id; });
+    std::erase_if(m_textureAlias, [id](const auto& kv) { return kv.first == id || kv.second == id; });
+
+    m_residency.untrack(id);
+    m_streamSource.erase(id);
+
     destroyTexture(m_textures[static_cast<std::size_t>(id)]);
+    ++m_version;
 }
 
 void TextureHandler::destroyAll() noexcept
 {
+    retireUploadBatch(true);
+    m_pendingUploads.clear();
+
     for (auto& tex : m_textures)
         destroyTexture(tex);
 
+    for (GpuTexture& tex : m_retiring)
+        destroyTexture(tex);
+
+    for (RetiredTextures& r : m_retired)
+    {
+        vkWaitForFences(m_ctx.device, 1, &r.fence, VK_TRUE, UINT64_MAX);
+        vkDestroyFence(m_ctx.device, r.fence, nullptr);
+        for (GpuTexture& tex : r.textures)
+            destroyTexture(tex);
+    }
+
     m_textures.clear();
     m_cache.clear();
+    m_textureAlias.clear();
+    m_retiring.clear();
+    m_retired.clear();
+    m_streamSource.clear();
+    m_residency.clear();
+    m_residencyRound.clear();
+    ++m_version;
+}
+
+bool TextureHandler::update(const Viewport* vp)
+{
+    collectRetired();
+
+    if (m_imageHandler)
+        m_imageHandler->pollPendingLoads();
+
+    const bool published = retireUploadBatch(false);
+
+    updateResidency(vp);
+
+    if (m_batch.fence == VK_NULL_HANDLE && !m_pendingUploads.empty())
+        submitUploadBatch();
+
+    return published;
+}
+
+void TextureHandler::finishPendingUploads()
+{
+    if (m_imageHandler)
+        m_imageHandler->waitForPendingLoads();
+
+    while (!m_pendingUploads.empty() || m_batch.fence != VK_NULL_HANDLE)
+    {
+        retireUploadBatch(true);
+
+        const size_t before = m_pendingUploads.size();
+        if (before == 0)
+            break;
+
+        submitUploadBatch();
+
+        // Nothing could be staged (e.g. out of memory): stop rather than spin.
+        if (m_batch.fence == VK_NULL_HANDLE && m_pendingUploads.size() == before)
+            break;
+    }
+}
+
+void TextureHandler::requestResidency(TextureId id, float projectedPixels)
+{
+    if (auto it = m_textureAlias.find(id); it != m_textureAlias.end())
+        id = it->second;
+
+    m_residency.request(id, projectedPixels);
+}
+
+void TextureHandler::collectRetired()
+{
+    while (!m_retired.empty() && vkGetFenceStatus(m_ctx.device, m_retired.front().fence) == VK_SUCCESS)
+    {
+        RetiredTextures& r = m_retired.front();
+        vkDestroyFence(m_ctx.device, r.fence, nullptr);
+        for (GpuTexture& tex : r.textures)
+            destroyTexture(tex);
+        m_retired.pop_front();
+    }
+
+    if (m_retiring.empty())
+        return;
+
+    // Replaced during an earlier pre-pass: every frame that could still sample
+    // these images has been submitted by now, whichever viewport recorded it.
+    // An empty submit's fence signals once all earlier work on the queue is done.
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    VkFence fence = VK_NULL_HANDLE;
+    if (vkCreateFence(m_ctx.device, &fenceInfo, nullptr, &fence) != VK_SUCCESS)
+        fence = VK_NULL_HANDLE;
+
+    if (fence != VK_NULL_HANDLE && vkQueueSubmit(m_ctx.graphicsQueue, 0, nullptr, fence) != VK_SUCCESS)
+    {
+        vkDestroyFence(m_ctx.device, fence, nullptr);
+        fence = VK_NULL_HANDLE;
+    }
+
+    if (fence == VK_NULL_HANDLE)
+    {
+        // Could not fence: wait for the queue instead of risking a live image.
+        vkQueueWaitIdle(m_ctx.graphicsQueue);
+        for (GpuTexture& tex : m_retiring)
+            destroyTexture(tex);
+        m_retiring.clear();
+        return;
+    }
+
+    m_retired.push_back({std::move(m_retiring), fence});
+    m_retiring.clear();
+}
+
+void TextureHandler::updateResidency(const Viewport* vp)
+{
+    // One policy run per round of viewports: requests from every viewport are
+    // decided together, and LRU ages advance once per round, not per viewport.
+    if (m_residencyRound.insert(vp).second)
+        return;
+
+    m_residencyRound = {vp};
+
+    m_residency.setBudget(queryTextureBudget());
+
+    for (const TextureResidency::Change& change : m_residency.update())
+    {
+        auto src = m_streamSource.find(change.id);
+        if (src == m_streamSource.end())
+        {
+            m_residency.untrack(change.id);
+            continue;
+        }
+
+        PendingUpload up = src->second;
+        up.topMip        = change.topMip;
+
+        // A newer decision supersedes a re-upload that has not been staged yet.
+        auto queued = std::find_if(m_pendingUploads.begin(), m_pendingUploads.end(), [&](const PendingUpload& p) {
+            return p.id == change.id;
+        });
+
+        if (queued != m_pendingUploads.end())
+            *queued = std::move(up);
+        else
+            m_pendingUploads.push_back(std::move(up));
+    }
+}
+
+uint64_t TextureHandler::queryTextureBudget() const
+{
+    if (!m_ctx.physicalDevice)
+        return m_memoryBudget;
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProps{};
+    budgetProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2 props{};
+    props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    props.pNext = m_ctx.supportsMemoryBudget ? &budgetProps : nullptr;
+
+    vkGetPhysicalDeviceMemoryProperties2(m_ctx.physicalDevice, &props);
+
+    const VkPhysicalDeviceMemoryProperties& mem = props.memoryProperties;
+
+    uint64_t largestHeap = 0;
+    uint64_t available   = 0;
+    for (uint32_t i = 0; i < mem.memoryHeapCount; ++i)
+    {
+        if ((mem.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0)
+            continue;
+
+        largestHeap = std::max<uint64_t>(largestHeap, mem.memoryHeaps[i].size);
+
+        if (m_ctx.supportsMemoryBudget)
+            available += budgetProps.heapBudget[i] - std::min(budgetProps.heapUsage[i], budgetProps.heapBudget[i]);
+    }
+
+    // Streamed levels are already part of the usage; keep 20% of what is left as headroom.
+    uint64_t budget = m_ctx.supportsMemoryBudget ? m_residency.residentBytes() + available / 5 * 4 : largestHeap / 2;
+
+    if (m_memoryBudget != 0)
+        budget = std::min(budget, m_memoryBudget);
+
+    return budget;
+}
+
+void TextureHandler::publish(TextureId id, StagedUpload& up)
+{
+    GpuTexture& slot = m_textures[static_cast<std::size_t>(id)];
+
+    if (slot.image != VK_NULL_HANDLE)
+        m_retiring.push_back(slot);
+
+    slot = up.tex;
+
+    // (Re-)track: a re-upload may come from the conditioned cache with different level sizes.
+    if (up.levelBytes.size() > 1)
+        m_residency.track(id, up.baseWidth, up.baseHeight, std::move(up.levelBytes), up.tex.topMip);
 }
 
 bool TextureHandler::createFallbackTexture() noexcept
@@ -432,6 +727,18 @@ TextureId TextureHandler::createTextureInternal(ImageId            imageId,
     if (!m_imageHandler)
         return kInvalidTextureId;
 
+    // Still decoding: hand out the slot now, upload from update() later.
+    if (m_imageHandler->isPending(imageId))
+    {
+        GpuTexture placeholder{};
+        placeholder.sourceImage = imageId;
+
+        const TextureId id = static_cast<TextureId>(m_textures.size());
+        m_textures.push_back(placeholder);
+        m_pendingUploads.push_back({id, imageId, desc, debugName});
+        return id;
+    }
+
     const Image* img = m_imageHandler->get(imageId);
     if (!img || !img->valid())
     {
@@ -440,113 +747,153 @@ TextureId TextureHandler::createTextureInternal(ImageId            imageId,
         return kInvalidTextureId;
     }
 
-    // ---------------------------------------------------------
-    // KTX path (compressed + mip chain provided by Image)
-    // ---------------------------------------------------------
-    if (img->isKtx())
+    StagedUpload up{};
+    if (!stageTexture(*img, imageId, desc, debugName, kPinnedTopMip, up))
+        return kInvalidTextureId;
+
+    // Synchronous path: one submit per texture (copy + mips recorded together).
+    VkCommandPool   pool = VK_NULL_HANDLE;
+    VkCommandBuffer cmd  = beginOneShotCmd(m_ctx, pool);
+    if (cmd == VK_NULL_HANDLE)
     {
-        const auto& data = img->ktxData();
-        const auto& mips = img->ktxMips();
+        std::cerr << "TextureHandler: beginOneShotCmd failed for '" << debugName << "'\n";
+        releaseStaging(up);
+        destroyTexture(up.tex);
+        return kInvalidTextureId;
+    }
 
-        if (data.empty() || mips.empty())
-        {
-            std::cerr << "TextureHandler::createTextureInternal: KTX image missing payload/mips for '"
-                      << debugName << "'\n";
-            return kInvalidTextureId;
-        }
+    recordUpload(cmd, up);
 
-        const int width  = img->width();
-        const int height = img->height();
-        if (width <= 0 || height <= 0)
-        {
-            std::cerr << "TextureHandler::createTextureInternal: invalid KTX dimensions for '"
-                      << debugName << "'\n";
-            return kInvalidTextureId;
-        }
+    if (!endOneShotCmd(m_ctx, cmd, pool))
+    {
+        std::cerr << "TextureHandler: endOneShotCmd failed for '" << debugName << "'\n";
+        releaseStaging(up);
+        destroyTexture(up.tex);
+        return kInvalidTextureId;
+    }
 
-        VkFormat format = img->ktxVkFormat();
-        format          = srgbVariantIfNeeded(format, desc.srgb);
+    releaseStaging(up);
 
-        if (format == VK_FORMAT_UNDEFINED)
+    const TextureId id = static_cast<TextureId>(m_textures.size());
+    m_textures.emplace_back();
+
+    if (up.levelBytes.size() > 1)
+        m_streamSource[id] = {id, imageId, desc, debugName};
+
+    publish(id, up);
+    return id;
+}
+
+bool TextureHandler::stageTexture(const Image&       img,
+                                  ImageId            imageId,
+                                  const TextureDesc& desc,
+                                  const std::string& debugName,
+                                  uint32_t           topMip,
+                                  StagedUpload&      out)
+{
+    out = {};
+
+    // Mipmapped pixel images: use the conditioned (CPU mips, BC7/BC5) copy from
+    // the texture cache when present, otherwise queue it for next time.
+    if (!img.isKtx() && desc.generateMipmaps && img.contentHash() != 0 && img.channels() >= 2)
+    {
+        TextureCache& cache = TextureCache::shared();
+        if (cache.enabled())
         {
-            std::cerr << "TextureHandler::createTextureInternal: KTX has VK_FORMAT_UNDEFINED for '"
-                      << debugName << "'\n";
-            return kInvalidTextureId;
+            const TextureCacheVariant variant = cacheVariantFor(desc);
+            const MappedFile          cached  = cache.open(img.contentHash(), variant);
+
+            Image conditioned;
+            if (cached.valid() &&
+                conditioned.loadFromEncodedMemory(cached.data(), static_cast<int>(cached.size()), false))
+                return stageTexture(conditioned, imageId, desc, debugName, topMip, out);
+
+            cache.conditionAsync(img, variant);
         }
+    }
 
-        const uint32_t     mipLevels  = static_cast<uint32_t>(mips.size());
-        const VkDeviceSize uploadSize = static_cast<VkDeviceSize>(data.size());
+    const uint8_t* src       = nullptr;
+    VkDeviceSize   srcBytes  = 0;
+    VkFormat       format    = VK_FORMAT_UNDEFINED;
+    uint32_t       mipLevels = 1;
+    int            width     = img.width();
+    int            height    = img.height();
 
-        VkBuffer       stagingBuffer{VK_NULL_HANDLE};
-        VkDeviceMemory stagingMemory{VK_NULL_HANDLE};
+    std::vector<uint8_t> rgba = {};
+
+    if (width <= 0 || height <= 0)
+    {
+        std::cerr << "TextureHandler::stageTexture: invalid dimensions for '"
+                  << debugName << "'\n";
+        return false;
+    }
+
+    // ---------------------------------------------------------
+    // KTX path (compressed + mip chain provided by Image)
+    // ---------------------------------------------------------
+    if (img.isKtx())
+    {
+        const auto& data = img.ktxData();
+        const auto& mips = img.ktxMips();
 
-        if (!createStagingBuffer(m_ctx, uploadSize, stagingBuffer, stagingMemory))
+        if (data.empty() || mips.empty())
         {
-            std::cerr << "TextureHandler: failed to create KTX staging buffer for '"
+            std::cerr << "TextureHandler::stageTexture: KTX image missing payload/mips for '"
                       << debugName << "'\n";
-            return kInvalidTextureId;
+            return false;
         }
 
-        void* mapped = nullptr;
-        if (vkMapMemory(m_ctx.device, stagingMemory, 0, uploadSize, 0, &mapped) != VK_SUCCESS)
+        format = srgbVariantIfNeeded(img.ktxVkFormat(), desc.srgb);
+        if (format == VK_FORMAT_UNDEFINED)
         {
-            std::cerr << "TextureHandler: vkMapMemory(KTX staging) failed for '"
+            std::cerr << "TextureHandler::stageTexture: KTX has VK_FORMAT_UNDEFINED for '"
                       << debugName << "'\n";
-            vkDestroyBuffer(m_ctx.device, stagingBuffer, nullptr);
-            vkFreeMemory(m_ctx.device, stagingMemory, nullptr);
-            return kInvalidTextureId;
+            return false;
         }
 
-        std::memcpy(mapped, data.data(), static_cast<std::size_t>(uploadSize));
-        vkUnmapMemory(m_ctx.device, stagingMemory);
-
-        const VkImageUsageFlags usage =
-            VK_IMAGE_USAGE_TRANSFER_DST_BIT |
-            VK_IMAGE_USAGE_SAMPLED_BIT;
+        const uint32_t fullLevels = static_cast<uint32_t>(mips.size());
 
-        vkutil::GpuImage gpuImg =
-            vkutil::createDeviceLocalImage2D(m_ctx, width, height, mipLevels, format, usage);
+        uint32_t top = std::min(topMip, fullLevels - 1);
+        if (topMip == kPinnedTopMip)
+            top = m_residency.pinnedTopMip(static_cast<uint32_t>(std::max(width, height)), fullLevels);
 
-        if (!gpuImg.valid())
+        // Only levels [top, fullLevels) are uploaded; they may sit anywhere in the payload.
+        VkDeviceSize first = data.size();
+        VkDeviceSize last  = 0;
+        for (uint32_t level = top; level < fullLevels; ++level)
         {
-            std::cerr << "TextureHandler: createDeviceLocalImage2D(KTX) failed for '"
-                      << debugName << "'\n";
-            vkDestroyBuffer(m_ctx.device, stagingBuffer, nullptr);
-            vkFreeMemory(m_ctx.device, stagingMemory, nullptr);
-            return kInvalidTextureId;
+            first = std::min(first, mips[level].offset);
+            last  = std::max(last, mips[level].offset + mips[level].size);
         }
 
-        // -----------------------------------------------------
-        // Copy each mip level using the KTX-provided offsets/sizes.
-        // Final layout must be SHADER_READ_ONLY_OPTIMAL.
-        // -----------------------------------------------------
-        VkCommandPool   pool = VK_NULL_HANDLE;
-        VkCommandBuffer cmd  = beginOneShotCmd(m_ctx, pool);
-        if (cmd == VK_NULL_HANDLE)
+        if (first >= last || last > data.size())
         {
-            std::cerr << "TextureHandler: beginOneShotCmd failed for KTX '" << debugName << "'\n";
-            vkDestroyImage(m_ctx.device, gpuImg.image, nullptr);
-            vkFreeMemory(m_ctx.device, gpuImg.memory, nullptr);
-            vkDestroyBuffer(m_ctx.device, stagingBuffer, nullptr);
-            vkFreeMemory(m_ctx.device, stagingMemory, nullptr);
-            return kInvalidTextureId;
+            first = 0;
+            last  = data.size();
         }
 
-        imageBarrier(cmd,
-                     gpuImg.image,
-                     VK_IMAGE_LAYOUT_UNDEFINED,
-                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                     mipLevels);
+        mipLevels = fullLevels - top;
+        width     = static_cast<int>(std::max(1u, mips[top].width));
+        height    = static_cast<int>(std::max(1u, mips[top].height));
+        src       = data.data() + first;
+        srcBytes  = last - first;
 
-        std::vector<VkBufferImageCopy> regions;
-        regions.reserve(mipLevels);
+        if (fullLevels > 1)
+        {
+            out.baseWidth  = std::max(1u, mips[0].width);
+            out.baseHeight = std::max(1u, mips[0].height);
+            for (const Image::KtxMipLevel& ml : mips)
+                out.levelBytes.push_back(ml.size);
+        }
+        out.tex.topMip = top;
 
+        out.regions.reserve(mipLevels);
         for (uint32_t level = 0; level < mipLevels; ++level)
         {
-            const Image::KtxMipLevel& ml = mips[level];
+            const Image::KtxMipLevel& ml = mips[top + level];
 
             VkBufferImageCopy r{};
-            r.bufferOffset                    = static_cast<VkDeviceSize>(ml.offset);
+            r.bufferOffset                    = static_cast<VkDeviceSize>(ml.offset) - first;
             r.bufferRowLength                 = 0; // tightly packed
             r.bufferImageHeight               = 0;
             r.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -559,246 +906,185 @@ TextureId TextureHandler::createTextureInternal(ImageId            imageId,
                 std::max(1u, static_cast<uint32_t>(ml.height)),
                 1u};
 
-            regions.push_back(r);
-        }
-
-        vkCmdCopyBufferToImage(cmd,
-                               stagingBuffer,
-                               gpuImg.image,
-                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                               static_cast<uint32_t>(regions.size()),
-                               regions.data());
-
-        imageBarrier(cmd,
-                     gpuImg.image,
-                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                     mipLevels);
-
-        if (!endOneShotCmd(m_ctx, cmd, pool))
-        {
-            std::cerr << "TextureHandler: endOneShotCmd failed for KTX '" << debugName << "'\n";
-            vkDestroyImage(m_ctx.device, gpuImg.image, nullptr);
-            vkFreeMemory(m_ctx.device, gpuImg.memory, nullptr);
-            vkDestroyBuffer(m_ctx.device, stagingBuffer, nullptr);
-            vkFreeMemory(m_ctx.device, stagingMemory, nullptr);
-            return kInvalidTextureId;
-        }
-
-        // Staging no longer needed
-        vkDestroyBuffer(m_ctx.device, stagingBuffer, nullptr);
-        vkFreeMemory(m_ctx.device, stagingMemory, nullptr);
-
-        // -----------------------------------------------------
-        // Create view + sampler
-        // -----------------------------------------------------
-        VkImageViewCreateInfo viewInfo{};
-        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        viewInfo.image                           = gpuImg.image;
-        viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
-        viewInfo.format                          = gpuImg.format;
-        viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-        viewInfo.subresourceRange.baseMipLevel   = 0;
-        viewInfo.subresourceRange.levelCount     = gpuImg.mipLevels;
-        viewInfo.subresourceRange.baseArrayLayer = 0;
-        viewInfo.subresourceRange.layerCount     = 1;
-
-        VkImageView view{VK_NULL_HANDLE};
-        if (vkCreateImageView(m_ctx.device, &viewInfo, nullptr, &view) != VK_SUCCESS)
-        {
-            std::cerr << "TextureHandler: vkCreateImageView(KTX) failed for '"
-                      << debugName << "'\n";
-            vkDestroyImage(m_ctx.device, gpuImg.image, nullptr);
-            vkFreeMemory(m_ctx.device, gpuImg.memory, nullptr);
-            return kInvalidTextureId;
+            out.regions.push_back(r);
         }
+    }
+    // ---------------------------------------------------------
+    // Raw pixels path
+    // ---------------------------------------------------------
+    else
+    {
+        int            channels = img.channels();
+        const uint8_t* pixels   = img.data();
 
-        VkSamplerCreateInfo samplerInfo{};
-        samplerInfo.sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-        samplerInfo.magFilter               = VK_FILTER_LINEAR;
-        samplerInfo.minFilter               = VK_FILTER_LINEAR;
-        samplerInfo.addressModeU            = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-        samplerInfo.addressModeV            = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-        samplerInfo.addressModeW            = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-        samplerInfo.anisotropyEnable        = VK_TRUE;
-        samplerInfo.maxAnisotropy           = std::min(16.0f, m_ctx.deviceProps.limits.maxSamplerAnisotropy);
-        samplerInfo.borderColor             = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
-        samplerInfo.unnormalizedCoordinates = VK_FALSE;
-        samplerInfo.compareEnable           = VK_FALSE;
-        samplerInfo.compareOp               = VK_COMPARE_OP_ALWAYS;
-        samplerInfo.mipmapMode              = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-        samplerInfo.mipLodBias              = 0.0f;
-        samplerInfo.minLod                  = 0.0f;
-        samplerInfo.maxLod                  = static_cast<float>(gpuImg.mipLevels);
-
-        VkSampler sampler{VK_NULL_HANDLE};
-        if (vkCreateSampler(m_ctx.device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS)
+        if (!pixels)
         {
-            std::cerr << "TextureHandler: vkCreateSampler(KTX) failed for '"
+            std::cerr << "TextureHandler::stageTexture: image has no data for '"
                       << debugName << "'\n";
-            vkDestroyImageView(m_ctx.device, view, nullptr);
-            vkDestroyImage(m_ctx.device, gpuImg.image, nullptr);
-            vkFreeMemory(m_ctx.device, gpuImg.memory, nullptr);
-            return kInvalidTextureId;
+            return false;
         }
 
-        GpuTexture tex{};
-        tex.image       = gpuImg.image;
-        tex.view        = view;
-        tex.memory      = gpuImg.memory;
-        tex.sampler     = sampler;
-        tex.width       = gpuImg.width;
-        tex.height      = gpuImg.height;
-        tex.mipLevels   = gpuImg.mipLevels;
-        tex.format      = gpuImg.format;
-        tex.sourceImage = imageId;
+        const std::size_t count =
+            static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
 
-        const TextureId id = static_cast<TextureId>(m_textures.size());
-        m_textures.push_back(tex);
-        return id;
-    }
+        switch (channels)
+        {
+            case 4:
+                format = desc.srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+                break;
 
-    // ---------------------------------------------------------
-    // Raw pixels path (your existing implementation)
-    // ---------------------------------------------------------
-    const int      width    = img->width();
-    const int      height   = img->height();
-    int            channels = img->channels();
-    const uint8_t* pixels   = img->data();
+            case 3: {
+                rgba.resize(count * 4u);
 
-    if (width <= 0 || height <= 0 || !pixels)
-    {
-        std::cerr << "TextureHandler::createTextureInternal: image has no data for '"
-                  << debugName << "'\n";
-        return kInvalidTextureId;
-    }
+                const uint8_t* s = pixels;
+                uint8_t*       d = rgba.data();
 
-    std::vector<uint8_t> rgba = {};
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    d[0] = s[0];
+                    d[1] = s[1];
+                    d[2] = s[2];
+                    d[3] = 255;
+                    s += 3;
+                    d += 4;
+                }
 
-    VkFormat format = VK_FORMAT_UNDEFINED;
-    switch (channels)
-    {
-        case 4:
-            format = desc.srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
-            break;
+                pixels   = rgba.data();
+                channels = 4;
+                format   = desc.srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+                break;
+            }
 
-        case 3: {
-            rgba.resize(static_cast<std::size_t>(width) *
-                        static_cast<std::size_t>(height) * 4u);
+            case 2: {
+                rgba.resize(count * 4u);
 
-            const uint8_t* src = pixels;
-            uint8_t*       dst = rgba.data();
+                const uint8_t* s = pixels;
+                uint8_t*       d = rgba.data();
 
-            const std::size_t count =
-                static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+                if (desc.srgb)
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        const uint8_t l = s[0];
+                        const uint8_t a = s[1];
+                        d[0]            = l;
+                        d[1]            = l;
+                        d[2]            = l;
+                        d[3]            = a;
+                        s += 2;
+                        d += 4;
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        d[0] = s[0];
+                        d[1] = s[1];
+                        d[2] = 0;
+                        d[3] = 255;
+                        s += 2;
+                        d += 4;
+                    }
+                }
 
-            for (std::size_t i = 0; i < count; ++i)
-            {
-                dst[0] = src[0];
-                dst[1] = src[1];
-                dst[2] = src[2];
-                dst[3] = 255;
-                src += 3;
-                dst += 4;
+                pixels   = rgba.data();
+                channels = 4;
+                format   = desc.srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+                break;
             }
 
-            pixels   = rgba.data();
-            channels = 4;
-            format   = desc.srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
-            break;
-        }
+            case 1:
+                format = VK_FORMAT_R8_UNORM;
+                break;
 
-        case 2: {
-            rgba.resize(static_cast<std::size_t>(width) *
-                        static_cast<std::size_t>(height) * 4u);
+            default:
+                std::cerr << "TextureHandler: unsupported channel count (" << channels
+                          << ") for '" << debugName << "'\n";
+                return false;
+        }
 
-            const uint8_t* src = pixels;
-            uint8_t*       dst = rgba.data();
+        if (desc.generateMipmaps)
+        {
+            const int maxDim = std::max(width, height);
+            mipLevels        = static_cast<uint32_t>(std::floor(std::log2(maxDim))) + 1u;
+        }
 
-            const std::size_t count =
-                static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+        // Streamed: the levels above top are dropped on the CPU before staging.
+        if (mipLevels > 1)
+        {
+            uint32_t top = std::min(topMip, mipLevels - 1);
+            if (topMip == kPinnedTopMip)
+                top = m_residency.pinnedTopMip(static_cast<uint32_t>(std::max(width, height)), mipLevels);
 
-            if (desc.srgb)
+            out.baseWidth  = static_cast<uint32_t>(width);
+            out.baseHeight = static_cast<uint32_t>(height);
+            for (uint32_t level = 0; level < mipLevels; ++level)
             {
-                for (std::size_t i = 0; i < count; ++i)
-                {
-                    const uint8_t l = src[0];
-                    const uint8_t a = src[1];
-                    dst[0]          = l;
-                    dst[1]          = l;
-                    dst[2]          = l;
-                    dst[3]          = a;
-                    src += 2;
-                    dst += 4;
-                }
+                const uint64_t w = std::max(1u, out.baseWidth >> level);
+                const uint64_t h = std::max(1u, out.baseHeight >> level);
+                out.levelBytes.push_back(w * h * static_cast<uint64_t>(channels));
             }
-            else
+
+            if (top > 0)
             {
-                for (std::size_t i = 0; i < count; ++i)
-                {
-                    dst[0] = src[0];
-                    dst[1] = src[1];
-                    dst[2] = 0;
-                    dst[3] = 255;
-                    src += 2;
-                    dst += 4;
-                }
+                if (pixels != rgba.data())
+                    rgba.assign(pixels, pixels + count * static_cast<std::size_t>(channels));
+
+                const bool srgbFilter = desc.srgb && channels == 4;
+                for (uint32_t i = 0; i < top; ++i)
+                    halveImage(rgba, width, height, channels, srgbFilter);
+
+                pixels    = rgba.data();
+                mipLevels = mipLevels - top;
             }
 
-            pixels   = rgba.data();
-            channels = 4;
-            format   = desc.srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
-            break;
+            out.tex.topMip = top;
         }
 
-        case 1:
-            format = VK_FORMAT_R8_UNORM;
-            break;
+        src      = pixels;
+        srcBytes = static_cast<VkDeviceSize>(width) * static_cast<VkDeviceSize>(height) * static_cast<VkDeviceSize>(channels);
 
-        default:
-            std::cerr << "TextureHandler: unsupported channel count (" << channels
-                      << ") for '" << debugName << "'\n";
-            return kInvalidTextureId;
-    }
+        VkBufferImageCopy r{};
+        r.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        r.imageSubresource.mipLevel   = 0;
+        r.imageSubresource.layerCount = 1;
+        r.imageExtent                 = {static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1u};
 
-    uint32_t mipLevels = 1;
-    if (desc.generateMipmaps)
-    {
-        const int maxDim = std::max(width, height);
-        mipLevels        = static_cast<uint32_t>(std::floor(std::log2(maxDim))) + 1u;
+        out.regions.push_back(r);
+        out.generateMips = desc.generateMipmaps;
     }
 
-    const VkDeviceSize imageSize =
-        static_cast<VkDeviceSize>(static_cast<std::size_t>(width) *
-                                  static_cast<std::size_t>(height) *
-                                  static_cast<std::size_t>(channels));
-
-    VkBuffer       stagingBuffer{VK_NULL_HANDLE};
-    VkDeviceMemory stagingMemory{VK_NULL_HANDLE};
-
-    if (!createStagingBuffer(m_ctx, imageSize, stagingBuffer, stagingMemory))
+    // ---------------------------------------------------------
+    // Staging buffer
+    // ---------------------------------------------------------
+    if (!createStagingBuffer(m_ctx, srcBytes, out.staging, out.stagingMemory))
     {
         std::cerr << "TextureHandler: failed to create staging buffer for '"
                   << debugName << "'\n";
-        return kInvalidTextureId;
+        return false;
     }
 
+    out.bytes = srcBytes;
+
     void* mapped = nullptr;
-    if (vkMapMemory(m_ctx.device, stagingMemory, 0, imageSize, 0, &mapped) != VK_SUCCESS)
+    if (vkMapMemory(m_ctx.device, out.stagingMemory, 0, srcBytes, 0, &mapped) != VK_SUCCESS)
     {
         std::cerr << "TextureHandler: vkMapMemory(staging) failed for '"
                   << debugName << "'\n";
-        vkDestroyBuffer(m_ctx.device, stagingBuffer, nullptr);
-        vkFreeMemory(m_ctx.device, stagingMemory, nullptr);
-        return kInvalidTextureId;
+        releaseStaging(out);
+        return false;
     }
 
-    std::memcpy(mapped, pixels, static_cast<std::size_t>(imageSize));
-    vkUnmapMemory(m_ctx.device, stagingMemory);
+    std::memcpy(mapped, src, static_cast<std::size_t>(srcBytes));
+    vkUnmapMemory(m_ctx.device, out.stagingMemory);
 
+    // ---------------------------------------------------------
+    // Device image + view + sampler
+    // ---------------------------------------------------------
     const VkImageUsageFlags usage =
         VK_IMAGE_USAGE_TRANSFER_DST_BIT |
-        (desc.generateMipmaps ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : 0u) |
+        (out.generateMips ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : 0u) |
         VK_IMAGE_USAGE_SAMPLED_BIT;
 
     vkutil::GpuImage gpuImg =
@@ -808,64 +1094,80 @@ TextureId TextureHandler::createTextureInternal(ImageId            imageId,
     {
         std::cerr << "TextureHandler: createDeviceLocalImage2D failed for '"
                   << debugName << "'\n";
-        vkDestroyBuffer(m_ctx.device, stagingBuffer, nullptr);
-        vkFreeMemory(m_ctx.device, stagingMemory, nullptr);
-        return kInvalidTextureId;
+        releaseStaging(out);
+        return false;
     }
 
-    vkutil::transitionImageLayout(m_ctx,
-                                  gpuImg.image,
-                                  gpuImg.format,
-                                  VK_IMAGE_LAYOUT_UNDEFINED,
-                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                  gpuImg.mipLevels);
+    out.tex.image       = gpuImg.image;
+    out.tex.memory      = gpuImg.memory;
+    out.tex.width       = gpuImg.width;
+    out.tex.height      = gpuImg.height;
+    out.tex.mipLevels   = gpuImg.mipLevels;
+    out.tex.format      = gpuImg.format;
+    out.tex.sourceImage = imageId;
 
-    vkutil::copyBufferToImage(m_ctx,
-                              stagingBuffer,
-                              gpuImg.image,
-                              width,
-                              height);
+    if (!createViewAndSampler(out.tex, debugName))
+    {
+        releaseStaging(out);
+        destroyTexture(out.tex);
+        return false;
+    }
 
-    if (desc.generateMipmaps)
+    return true;
+}
+
+void TextureHandler::recordUpload(VkCommandBuffer cmd, const StagedUpload& up) noexcept
+{
+    imageBarrier(cmd,
+                 up.tex.image,
+                 VK_IMAGE_LAYOUT_UNDEFINED,
+                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                 up.tex.mipLevels);
+
+    vkCmdCopyBufferToImage(cmd,
+                           up.staging,
+                           up.tex.image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(up.regions.size()),
+                           up.regions.data());
+
+    if (up.generateMips)
     {
-        vkutil::generateMipmaps(m_ctx,
-                                gpuImg.image,
-                                width,
-                                height,
-                                gpuImg.mipLevels);
+        vkutil::generateMipmaps(cmd,
+                                up.tex.image,
+                                up.tex.width,
+                                up.tex.height,
+                                up.tex.mipLevels);
     }
     else
     {
-        vkutil::transitionImageLayout(m_ctx,
-                                      gpuImg.image,
-                                      gpuImg.format,
-                                      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                                      gpuImg.mipLevels);
+        imageBarrier(cmd,
+                     up.tex.image,
+                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                     up.tex.mipLevels);
     }
+}
 
-    vkDestroyBuffer(m_ctx.device, stagingBuffer, nullptr);
-    vkFreeMemory(m_ctx.device, stagingMemory, nullptr);
-
+bool TextureHandler::createViewAndSampler(GpuTexture& tex, const std::string& debugName) noexcept
+{
     VkImageViewCreateInfo viewInfo{};
     viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image                           = gpuImg.image;
+    viewInfo.image                           = tex.image;
     viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format                          = gpuImg.format;
+    viewInfo.format                          = tex.format;
     viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
     viewInfo.subresourceRange.baseMipLevel   = 0;
-    viewInfo.subresourceRange.levelCount     = gpuImg.mipLevels;
+    viewInfo.subresourceRange.levelCount     = tex.mipLevels;
     viewInfo.subresourceRange.baseArrayLayer = 0;
     viewInfo.subresourceRange.layerCount     = 1;
 
-    VkImageView view{VK_NULL_HANDLE};
-    if (vkCreateImageView(m_ctx.device, &viewInfo, nullptr, &view) != VK_SUCCESS)
+    if (vkCreateImageView(m_ctx.device, &viewInfo, nullptr, &tex.view) != VK_SUCCESS)
     {
         std::cerr << "TextureHandler: vkCreateImageView failed for '"
                   << debugName << "'\n";
-        vkDestroyImage(m_ctx.device, gpuImg.image, nullptr);
-        vkFreeMemory(m_ctx.device, gpuImg.memory, nullptr);
-        return kInvalidTextureId;
+        tex.view = VK_NULL_HANDLE;
+        return false;
     }
 
     VkSamplerCreateInfo samplerInfo{};
@@ -884,33 +1186,177 @@ TextureId TextureHandler::createTextureInternal(ImageId            imageId,
     samplerInfo.mipmapMode              = VK_SAMPLER_MIPMAP_MODE_LINEAR;
     samplerInfo.mipLodBias              = 0.0f;
     samplerInfo.minLod                  = 0.0f;
-    samplerInfo.maxLod                  = static_cast<float>(gpuImg.mipLevels);
+    samplerInfo.maxLod                  = static_cast<float>(tex.mipLevels);
 
-    VkSampler sampler{VK_NULL_HANDLE};
-    if (vkCreateSampler(m_ctx.device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS)
+    if (vkCreateSampler(m_ctx.device, &samplerInfo, nullptr, &tex.sampler) != VK_SUCCESS)
     {
         std::cerr << "TextureHandler: vkCreateSampler failed for '"
                   << debugName << "'\n";
-        vkDestroyImageView(m_ctx.device, view, nullptr);
-        vkDestroyImage(m_ctx.device, gpuImg.image, nullptr);
-        vkFreeMemory(m_ctx.device, gpuImg.memory, nullptr);
-        return kInvalidTextureId;
+        tex.sampler = VK_NULL_HANDLE;
+        return false;
     }
 
-    GpuTexture tex{};
-    tex.image       = gpuImg.image;
-    tex.view        = view;
-    tex.memory      = gpuImg.memory;
-    tex.sampler     = sampler;
-    tex.width       = gpuImg.width;
-    tex.height      = gpuImg.height;
-    tex.mipLevels   = gpuImg.mipLevels;
-    tex.format      = gpuImg.format;
-    tex.sourceImage = imageId;
+    return true;
+}
 
-    const TextureId id = static_cast<TextureId>(m_textures.size());
-    m_textures.push_back(tex);
-    return id;
+void TextureHandler::releaseStaging(StagedUpload& up) noexcept
+{
+    if (up.staging != VK_NULL_HANDLE)
+        vkDestroyBuffer(m_ctx.device, up.staging, nullptr);
+    if (up.stagingMemory != VK_NULL_HANDLE)
+        vkFreeMemory(m_ctx.device, up.stagingMemory, nullptr);
+
+    up.staging       = VK_NULL_HANDLE;
+    up.stagingMemory = VK_NULL_HANDLE;
+}
+
+void TextureHandler::submitUploadBatch()
+{
+    if (m_batch.fence != VK_NULL_HANDLE || m_pendingUploads.empty() || !m_imageHandler)
+        return;
+
+    // Keep one batch bounded so staging memory and the submit stay small;
+    // a single oversized texture still goes through on its own.
+    constexpr VkDeviceSize kBatchBudget = 64ull * 1024ull * 1024ull;
+
+    VkDeviceSize budget = kBatchBudget;
+
+    std::vector<PendingUpload> keep = {};
+    keep.reserve(m_pendingUploads.size());
+
+    for (PendingUpload& p : m_pendingUploads)
+    {
+        if (m_imageHandler->isPending(p.imageId))
+        {
+            keep.push_back(std::move(p));
+            continue;
+        }
+
+        const Image* img = m_imageHandler->get(p.imageId);
+        if (!img || !img->valid())
+        {
+            // Decode failed or was cancelled: the slot keeps the fallback.
+            continue;
+        }
+
+        // The image turned out to duplicate another one after it was requested.
+        // Point the slot at the canonical texture instead of uploading a copy.
+        if (const ImageId canonical = m_imageHandler->resolve(p.imageId); canonical != p.imageId)
+        {
+            const CacheKey key{canonical, p.desc.usage, p.desc.generateMipmaps, p.desc.srgb};
+
+            if (auto it = m_cache.find(key); it != m_cache.end() && it->second != p.id)
+            {
+                m_textureAlias[p.id] = it->second;
+                ++m_version;
+                continue;
+            }
+
+            m_cache.emplace(key, p.id);
+        }
+
+        if (budget == 0)
+        {
+            keep.push_back(std::move(p));
+            continue;
+        }
+
+        StagedUpload up{};
+        if (!stageTexture(*img, p.imageId, p.desc, p.debugName, p.topMip, up))
+        {
+            // A failed re-upload leaves the current image in place.
+            if (m_residency.tracked(p.id) && isValidTextureId(p.id, m_textures.size()))
+                m_residency.setResident(p.id, m_textures[static_cast<std::size_t>(p.id)].topMip);
+            continue;
+        }
+
+        if (up.levelBytes.size() > 1 && !m_streamSource.contains(p.id))
+            m_streamSource[p.id] = {p.id, p.imageId, p.desc, p.debugName};
+
+        up.id  = p.id;
+        budget = (up.bytes >= budget) ? 0 : budget - up.bytes;
+        m_batch.uploads.push_back(std::move(up));
+    }
+
+    m_pendingUploads = std::move(keep);
+
+    if (m_batch.uploads.empty())
+        return;
+
+    auto abandon = [this]() {
+        for (StagedUpload& up : m_batch.uploads)
+        {
+            releaseStaging(up);
+            destroyTexture(up.tex);
+        }
+        if (m_batch.pool != VK_NULL_HANDLE)
+            vkDestroyCommandPool(m_ctx.device, m_batch.pool, nullptr);
+        if (m_batch.fence != VK_NULL_HANDLE)
+            vkDestroyFence(m_ctx.device, m_batch.fence, nullptr);
+        m_batch = {};
+    };
+
+    m_batch.cmd = beginOneShotCmd(m_ctx, m_batch.pool);
+    if (m_batch.cmd == VK_NULL_HANDLE)
+    {
+        std::cerr << "TextureHandler: failed to begin upload batch.\n";
+        abandon();
+        return;
+    }
+
+    for (const StagedUpload& up : m_batch.uploads)
+        recordUpload(m_batch.cmd, up);
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    if (vkEndCommandBuffer(m_batch.cmd) != VK_SUCCESS ||
+        vkCreateFence(m_ctx.device, &fenceInfo, nullptr, &m_batch.fence) != VK_SUCCESS)
+    {
+        std::cerr << "TextureHandler: failed to finish upload batch.\n";
+        abandon();
+        return;
+    }
+
+    VkSubmitInfo submit{};
+    submit.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers    = &m_batch.cmd;
+
+    if (vkQueueSubmit(m_ctx.graphicsQueue, 1, &submit, m_batch.fence) != VK_SUCCESS)
+    {
+        std::cerr << "TextureHandler: upload batch submit failed.\n";
+        abandon();
+        return;
+    }
+}
+
+bool TextureHandler::retireUploadBatch(bool wait) noexcept
+{
+    if (m_batch.fence == VK_NULL_HANDLE)
+        return false;
+
+    if (wait)
+        vkWaitForFences(m_ctx.device, 1, &m_batch.fence, VK_TRUE, UINT64_MAX);
+    else if (vkGetFenceStatus(m_ctx.device, m_batch.fence) != VK_SUCCESS)
+        return false;
+
+    for (StagedUpload& up : m_batch.uploads)
+    {
+        releaseStaging(up);
+
+        if (isValidTextureId(up.id, m_textures.size()))
+            publish(up.id, up);
+        else
+            destroyTexture(up.tex);
+    }
+
+    vkDestroyFence(m_ctx.device, m_batch.fence, nullptr);
+    vkDestroyCommandPool(m_ctx.device, m_batch.pool, nullptr);
+    m_batch = {};
+
+    ++m_version;
+    return true;
 }
 
 void TextureHandler::destroyTexture(GpuTexture& tex) noexcept
@@ -4,14 +4,19 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <vulkan/vulkan.h>
 
 #include "ImageHandler.hpp"
+#include "TextureResidency.hpp"
 #include "VulkanContext.hpp"
 
+class Viewport;
+
 // Opaque handle for GPU textures
 using TextureId = int32_t;
 
@@ -41,6 +46,7 @@ struct GpuTexture
     int32_t  width{};
     int32_t  height{};
     uint32_t mipLevels{};
+    uint32_t topMip{}; ///< Source level stored as this image's level 0 (mip streaming).
     VkFormat format{VK_FORMAT_UNDEFINED};
 
     ImageId sourceImage{kInvalidImageId};
@@ -59,6 +65,36 @@ struct GpuTexture
  *  - TextureId values are stable and not reused in this implementation.
  *  - destroy(TextureId) frees GPU resources but keeps the slot.
  *  - fallbackTexture() returns a 1x1 RGBA texture with a valid view+sampler.
+ *
+ * Asynchronous uploads:
+ *  - Requesting a texture for an image that is still decoding
+ *    (ImageHandler::isPending) returns a TextureId at once. The slot stays
+ *    empty (no view), which the renderer binds as the fallback.
+ *  - update() (each viewport pre-pass, main thread) collects finished decodes, records
+ *    the ready textures into one command buffer per batch and submits it with
+ *    a fence. The batch is published into its slots when the fence signals,
+ *    bumping version().
+ *  - Only one batch is in flight; its size is capped so a burst of large
+ *    images is spread over several frames.
+ *
+ * Deduplication:
+ *  - Requests go through ImageHandler::resolve(), so identical images share one
+ *    texture. A slot requested before its image was recognised as a duplicate
+ *    is redirected to the canonical texture by get() rather than uploaded.
+ *
+ * Residency (mip streaming):
+ *  - Mipmapped textures are first uploaded with only their tail levels (see
+ *    TextureResidency::Config::pinnedMaxDim). The renderer reports each frame
+ *    which textures it draws and how large they are on screen
+ *    (requestResidency()). The policy runs once per round of viewports (when a
+ *    viewport that already rendered comes back), so it sees the requests of
+ *    every viewport; update() then re-creates textures with more (or, under
+ *    budget pressure, fewer) high levels through the regular async path.
+ *  - The budget follows VK_EXT_memory_budget when available (otherwise half the
+ *    largest device-local heap), capped by setMemoryBudget().
+ *  - Replaced images are destroyed once a fence submitted after the frames that
+ *    could still reference them has signalled. Every viewport submits to the
+ *    graphics queue, so that one fence covers all of them.
  */
 class TextureHandler
 {
@@ -131,6 +167,67 @@ public:
         return m_hasFallback ? &m_fallback : nullptr;
     }
 
+    /**
+     * @brief Advance asynchronous uploads (see class notes). Call outside any render pass.
+     * @param vp Viewport whose pre-pass this is; delimits residency rounds.
+     * @return True if textures were published this call (descriptor tables need a refresh).
+     */
+    bool update(const Viewport* vp);
+
+    /**
+     * @brief Block until every requested texture is either uploaded or dropped.
+     *
+     * Waits for pending image decodes as well.
+     */
+    void finishPendingUploads();
+
+    /**
+     * @brief Bumped whenever a slot's view/sampler changes (publish, destroy).
+     */
+    [[nodiscard]] uint64_t version() const noexcept
+    {
+        return m_version;
+    }
+
+    /**
+     * @brief Textures requested but not yet visible (waiting for decode or in flight).
+     */
+    [[nodiscard]] size_t pendingUploadCount() const noexcept
+    {
+        return m_pendingUploads.size() + m_batch.uploads.size();
+    }
+
+    /**
+     * @brief Record that @p id is drawn this frame, covering about @p projectedPixels on screen.
+     *
+     * Aliased ids are followed. Ids without a streamable mip chain are ignored.
+     */
+    void requestResidency(TextureId id, float projectedPixels);
+
+    /**
+     * @brief Cap on streamed texture memory in bytes (0 = automatic, see class notes).
+     */
+    void setMemoryBudget(uint64_t bytes) noexcept
+    {
+        m_memoryBudget = bytes;
+    }
+
+    /**
+     * @brief Bytes of mip levels currently resident for streamed textures.
+     */
+    [[nodiscard]] uint64_t residentTextureBytes() const noexcept
+    {
+        return m_residency.residentBytes();
+    }
+
+    /**
+     * @brief True while the residency manager still has upgrades queued for later frames.
+     */
+    [[nodiscard]] bool isStreaming() const noexcept
+    {
+        return m_residency.hasDeferredWork();
+    }
+
 private:
     VulkanContext m_ctx          = {};
     ImageHandler* m_imageHandler = nullptr;
@@ -161,11 +258,81 @@ private:
 
     std::unordered_map<CacheKey, TextureId, CacheKeyHash> m_cache = {};
 
+    /// Slots whose image was found to duplicate another after the slot was handed out.
+    std::unordered_map<TextureId, TextureId> m_textureAlias = {};
+
+private:
+    /// A texture whose GPU objects exist but whose pixels are still in a staging buffer.
+    struct StagedUpload
+    {
+        TextureId      id            = kInvalidTextureId;
+        GpuTexture     tex           = {};
+        VkBuffer       staging       = VK_NULL_HANDLE;
+        VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+        VkDeviceSize   bytes         = 0;
+        bool           generateMips  = false;
+
+        std::vector<VkBufferImageCopy> regions = {};
+
+        // Full chain description for the residency manager (levelBytes empty = not streamable).
+        uint32_t              baseWidth  = 0;
+        uint32_t              baseHeight = 0;
+        std::vector<uint64_t> levelBytes = {};
+    };
+
+    /// Let stageTexture() pick the pinned tail (first upload of a texture).
+    static constexpr uint32_t kPinnedTopMip = UINT32_MAX;
+
+    struct PendingUpload
+    {
+        TextureId   id        = kInvalidTextureId;
+        ImageId     imageId   = kInvalidImageId;
+        TextureDesc desc      = {};
+        std::string debugName = {};
+        uint32_t    topMip    = kPinnedTopMip;
+    };
+
+    /// Images replaced by streaming re-uploads, destroyed once @c fence signals.
+    struct RetiredTextures
+    {
+        std::vector<GpuTexture> textures = {};
+        VkFence                 fence    = VK_NULL_HANDLE;
+    };
+
+    struct UploadBatch
+    {
+        VkCommandPool   pool  = VK_NULL_HANDLE;
+        VkCommandBuffer cmd   = VK_NULL_HANDLE;
+        VkFence         fence = VK_NULL_HANDLE;
+
+        std::vector<StagedUpload> uploads = {};
+    };
+
 private:
     TextureId createTextureInternal(ImageId            imageId,
                                     const TextureDesc& desc,
                                     const std::string& debugName);
 
+    bool stageTexture(const Image&       img,
+                      ImageId            imageId,
+                      const TextureDesc& desc,
+                      const std::string& debugName,
+                      uint32_t           topMip,
+                      StagedUpload&      out);
+
+    void publish(TextureId id, StagedUpload& up);
+    void updateResidency(const Viewport* vp);
+    void collectRetired();
+    [[nodiscard]] uint64_t queryTextureBudget() const;
+
+    static void recordUpload(VkCommandBuffer cmd, const StagedUpload& up) noexcept;
+
+    bool createViewAndSampler(GpuTexture& tex, const std::string& debugName) noexcept;
+    void releaseStaging(StagedUpload& up) noexcept;
+
+    void submitUploadBatch();
+    bool retireUploadBatch(bool wait) noexcept;
+
     void destroyTexture(GpuTexture& tex) noexcept;
 
 private:
@@ -174,4 +341,16 @@ private:
 private:
     GpuTexture m_fallback    = {};
     bool       m_hasFallback = false;
+
+    std::vector<PendingUpload> m_pendingUploads = {};
+    UploadBatch                m_batch          = {};
+    uint64_t                   m_version        = 0;
+
+    // Residency
+    TextureResidency                             m_residency      = {};
+    std::unordered_map<TextureId, PendingUpload> m_streamSource   = {}; ///< How to re-stage a streamed texture.
+    std::vector<GpuTexture>                      m_retiring       = {}; ///< Replaced since the last update(), no fence yet.
+    std::deque<RetiredTextures>                  m_retired        = {}; ///< Fenced, oldest first.
+    std::unordered_set<const Viewport*>          m_residencyRound = {}; ///< Viewports that rendered since the last policy run.
+    uint64_t                                     m_memoryBudget   = 0;  ///< 0 = automatic.
 };
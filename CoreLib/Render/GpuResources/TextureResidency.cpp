@@ -0,0 +1,235 @@
+#include "TextureResidency.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+TextureResidency::TextureResidency(const Config& config) : m_config{config}
+{
+}
+
+void TextureResidency::track(TextureId             id,
+                             uint32_t              baseWidth,
+                             uint32_t              baseHeight,
+                             std::vector<uint64_t> levelBytes,
+                             uint32_t              topMip)
+{
+    if (id < 0 || levelBytes.empty())
+        return;
+
+    Entry e      = {};
+    e.baseWidth  = baseWidth;
+    e.baseHeight = baseHeight;
+    e.levelBytes = std::move(levelBytes);
+
+    e.pinnedTop  = pinnedTopMip(std::max(baseWidth, baseHeight), static_cast<uint32_t>(e.levelBytes.size()));
+    e.topMip     = std::min(topMip, e.pinnedTop);
+    e.lastUsed   = m_frame;
+
+    m_entries[id] = std::move(e);
+}
+
+void TextureResidency::untrack(TextureId id)
+{
+    m_entries.erase(id);
+}
+
+void TextureResidency::clear()
+{
+    m_entries.clear();
+}
+
+bool TextureResidency::tracked(TextureId id) const noexcept
+{
+    return m_entries.find(id) != m_entries.end();
+}
+
+void TextureResidency::request(TextureId id, float projectedPixels)
+{
+    auto it = m_entries.find(id);
+    if (it == m_entries.end())
+        return;
+
+    Entry& e = it->second;
+
+    const uint32_t want = std::min(wantedTopMip(std::max(e.baseWidth, e.baseHeight), projectedPixels), e.pinnedTop);
+
+    e.wanted    = e.requested ? std::min(e.wanted, want) : want;
+    e.requested = true;
+    e.lastUsed  = m_frame;
+}
+
+uint32_t TextureResidency::pinnedTopMip(TextureId id) const noexcept
+{
+    auto it = m_entries.find(id);
+    return it != m_entries.end() ? it->second.pinnedTop : 0u;
+}
+
+uint32_t TextureResidency::pinnedTopMip(uint32_t maxDim, uint32_t levelCount) const noexcept
+{
+    uint32_t top = 0;
+    while (top + 1 < levelCount && (maxDim >> top) > m_config.pinnedMaxDim)
+        ++top;
+    return top;
+}
+
+void TextureResidency::setResident(TextureId id, uint32_t topMip)
+{
+    auto it = m_entries.find(id);
+    if (it == m_entries.end())
+        return;
+
+    it->second.topMip = std::min(topMip, it->second.pinnedTop);
+}
+
+uint32_t TextureResidency::residentTopMip(TextureId id) const noexcept
+{
+    auto it = m_entries.find(id);
+    return it != m_entries.end() ? it->second.topMip : 0u;
+}
+
+uint64_t TextureResidency::residentBytes() const noexcept
+{
+    uint64_t total = 0;
+    for (const auto& [id, e] : m_entries)
+        total += bytesFrom(e, e.topMip);
+    return total;
+}
+
+uint64_t TextureResidency::bytesFrom(const Entry& e, uint32_t topMip) noexcept
+{
+    uint64_t bytes = 0;
+    for (size_t level = topMip; level < e.levelBytes.size(); ++level)
+        bytes += e.levelBytes[level];
+    return bytes;
+}
+
+uint32_t TextureResidency::wantedTopMip(uint32_t maxDim, float projectedPixels) noexcept
+{
+    if (maxDim <= 1)
+        return 0;
+
+    // Not on screen in any meaningful way: the smallest level will do.
+    if (!(projectedPixels >= 1.0f))
+        return 31;
+
+    const float ratio = static_cast<float>(maxDim) / projectedPixels;
+    if (ratio <= 1.0f)
+        return 0;
+
+    return static_cast<uint32_t>(std::floor(std::log2(ratio)));
+}
+
+std::vector<TextureResidency::Change> TextureResidency::update()
+{
+    std::vector<Change> changes = {};
+
+    uint64_t total = residentBytes();
+    m_deferred     = false;
+
+    auto record = [&](TextureId id, Entry& e, uint32_t top) {
+        total = total - bytesFrom(e, e.topMip) + bytesFrom(e, top);
+        e.topMip = top;
+
+        for (Change& c : changes)
+        {
+            if (c.id == id)
+            {
+                c.topMip = top;
+                return;
+            }
+        }
+        changes.push_back({id, top});
+    };
+
+    // Coarsest top an entry may be pushed to right now.
+    auto floorOf = [](const Entry& e) noexcept {
+        return e.requested ? std::max(e.wanted, e.topMip) : e.pinnedTop;
+    };
+
+    // Eviction candidates, least recently used first.
+    std::vector<std::pair<TextureId, Entry*>> lru = {};
+    lru.reserve(m_entries.size());
+    for (auto& [id, e] : m_entries)
+        lru.push_back({id, &e});
+
+    std::sort(lru.begin(), lru.end(), [](const auto& a, const auto& b) {
+        if (a.second->lastUsed != b.second->lastUsed)
+            return a.second->lastUsed < b.second->lastUsed;
+        return a.first < b.first;
+    });
+
+    size_t victim = 0;
+
+    // Free until total + need fits, skipping @p keep. Returns false if it cannot.
+    auto evictFor = [&](uint64_t need, TextureId keep) {
+        while (total + need > m_budget && victim < lru.size())
+        {
+            auto& [id, e] = lru[victim];
+
+            const uint32_t floor = floorOf(*e);
+            if (id == keep || floor <= e->topMip || changes.size() >= m_config.maxChangesPerFrame)
+            {
+                ++victim;
+                continue;
+            }
+
+            record(id, *e, floor);
+            ++victim;
+        }
+        return total + need <= m_budget;
+    };
+
+    // Budget shrank (or other allocations grew): shed LRU levels first.
+    if (m_budget != 0 && total > m_budget)
+        evictFor(0, -1);
+
+    // Upgrades, finest need first; ties favour the bigger step.
+    std::vector<std::pair<TextureId, Entry*>> ups = {};
+    for (auto& [id, e] : m_entries)
+    {
+        if (e.requested && e.wanted < e.topMip)
+            ups.push_back({id, &e});
+    }
+
+    std::sort(ups.begin(), ups.end(), [](const auto& a, const auto& b) {
+        if (a.second->wanted != b.second->wanted)
+            return a.second->wanted < b.second->wanted;
+        const uint32_t stepA = a.second->topMip - a.second->wanted;
+        const uint32_t stepB = b.second->topMip - b.second->wanted;
+        if (stepA != stepB)
+            return stepA > stepB;
+        return a.first < b.first;
+    });
+
+    for (auto& [id, e] : ups)
+    {
+        if (changes.size() >= m_config.maxChangesPerFrame)
+        {
+            m_deferred = true;
+            break;
+        }
+
+        const uint64_t current = bytesFrom(*e, e->topMip);
+        const uint64_t full    = bytesFrom(*e, e->wanted) - current;
+
+        if (m_budget == 0 || total + full <= m_budget || evictFor(full, id))
+        {
+            record(id, *e, e->wanted);
+            continue;
+        }
+
+        // Partial upgrade: as many extra levels as still fit.
+        uint32_t top = e->topMip;
+        while (top > e->wanted && total + (bytesFrom(*e, top - 1) - current) <= m_budget)
+            --top;
+
+        if (top < e->topMip)
+            record(id, *e, top);
+    }
+
+    for (auto& [id, e] : m_entries)
+        e.requested = false;
+
+    ++m_frame;
+    return changes;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+using TextureId = int32_t;
+
+/**
+ * @brief Mip residency policy for TextureHandler (pure CPU, no Vulkan).
+ *
+ * Each tracked texture has a resident "top mip": levels [topMip, levelCount)
+ * are on the GPU. The policy decides, once per frame, which textures should
+ * gain or lose high-resolution levels:
+ *
+ *  - Tail levels (max dimension <= pinnedMaxDim) are never evicted, so every
+ *    texture always has something to sample.
+ *  - request() records that a texture was needed this frame and how many
+ *    screen pixels it roughly covers; the wanted top mip follows from that.
+ *  - Upgrades are granted finest-need-first while they fit in the budget.
+ *    When they do not, high levels of the least recently used textures are
+ *    evicted (never below what they were asked for this frame).
+ *  - A texture's unused high levels are only dropped under budget pressure,
+ *    so panning back and forth does not cause churn.
+ *
+ * The handler applies returned changes and reports the outcome with
+ * setResident(). All sizes are bytes.
+ */
+class TextureResidency
+{
+public:
+    struct Config
+    {
+        uint32_t pinnedMaxDim       = 256; ///< Levels at or below this size stay resident.
+        uint32_t maxChangesPerFrame = 8;   ///< Spread uploads over frames.
+    };
+
+    struct Change
+    {
+        TextureId id     = -1;
+        uint32_t  topMip = 0;
+    };
+
+public:
+    TextureResidency() = default;
+    explicit TextureResidency(const Config& config);
+
+    /**
+     * @brief Start tracking @p id.
+     * @param levelBytes Size of each mip level, finest first (levelBytes.size() == level count).
+     * @param topMip     Level currently resident at the top.
+     */
+    void track(TextureId id, uint32_t baseWidth, uint32_t baseHeight, std::vector<uint64_t> levelBytes, uint32_t topMip);
+
+    void untrack(TextureId id);
+    void clear();
+
+    [[nodiscard]] bool tracked(TextureId id) const noexcept;
+
+    /// Record that @p id was used this frame, covering about @p projectedPixels on screen.
+    void request(TextureId id, float projectedPixels);
+
+    /// Top mip that pins only the tail (the smallest set that stays resident).
+    [[nodiscard]] uint32_t pinnedTopMip(TextureId id) const noexcept;
+
+    /// Same, for a texture that is not tracked yet (first uploads start there).
+    [[nodiscard]] uint32_t pinnedTopMip(uint32_t maxDim, uint32_t levelCount) const noexcept;
+
+    /// Report what is actually resident (after an upload, or if one failed).
+    void setResident(TextureId id, uint32_t topMip);
+
+    [[nodiscard]] uint32_t residentTopMip(TextureId id) const noexcept;
+
+    void setBudget(uint64_t bytes) noexcept
+    {
+        m_budget = bytes;
+    }
+
+    [[nodiscard]] uint64_t budget() const noexcept
+    {
+        return m_budget;
+    }
+
+    [[nodiscard]] uint64_t residentBytes() const noexcept;
+
+    /**
+     * @brief Advance one frame and return the residency changes to apply.
+     *
+     * Requests are consumed. Changes are already recorded as resident;
+     * call setResident() to correct a change that could not be applied.
+     */
+    [[nodiscard]] std::vector<Change> update();
+
+    /// True if the last update() hit the per-frame change cap with upgrades left over.
+    [[nodiscard]] bool hasDeferredWork() const noexcept
+    {
+        return m_deferred;
+    }
+
+    /// Top mip a texture of @p maxDim texels needs for @p projectedPixels on screen.
+    [[nodiscard]] static uint32_t wantedTopMip(uint32_t maxDim, float projectedPixels) noexcept;
+
+private:
+    struct Entry
+    {
+        uint32_t              baseWidth  = 0;
+        uint32_t              baseHeight = 0;
+        std::vector<uint64_t> levelBytes = {};
+
+        uint32_t topMip    = 0; ///< Resident.
+        uint32_t pinnedTop = 0; ///< Coarsest top mip ever allowed.
+        uint32_t wanted    = 0; ///< This frame's request (valid if requested).
+        bool     requested = false;
+        uint64_t lastUsed  = 0; ///< Frame of the last request.
+    };
+
+    [[nodiscard]] static uint64_t bytesFrom(const Entry& e, uint32_t topMip) noexcept;
+
+private:
+    Config                                m_config   = {};
+    std::unordered_map<TextureId, Entry>  m_entries  = {};
+    uint64_t                              m_budget   = 0; ///< 0 = unlimited.
+    uint64_t                              m_frame    = 0;
+    bool                                  m_deferred = false;
+};
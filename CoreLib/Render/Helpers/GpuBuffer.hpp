@@ -67,6 +67,12 @@ public:
         return m_size;
     }
 
+    /// Persistent mapping; nullptr unless created with persistentMap on HOST_VISIBLE memory.
+    [[nodiscard]] void* mapped() const
+    {
+        return m_mapped;
+    }
+
 private:
     uint32_t findMemoryType(uint32_t bits, VkPhysicalDevice phys, VkMemoryPropertyFlags flags);
     void     moveFrom(GpuBuffer&& other);
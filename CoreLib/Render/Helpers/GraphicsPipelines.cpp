@@ -147,7 +147,8 @@ namespace vkutil
                              VkPipelineLayout                            layout,
                              VkSampleCountFlagBits                       sampleCount,
                              const VkPipelineVertexInputStateCreateInfo& vi,
-                             GraphicsPipeline&                           out)
+                             GraphicsPipeline&                           out,
+                             const char*                                 vertShader)
     {
         out.destroy();
 
@@ -159,7 +160,7 @@ namespace vkutil
         // const std::filesystem::path shaderDir = std::filesystem::path(SHADER_BIN_DIR);
 
         ShaderStage vs =
-            vkutil::loadStage(ctx.device, "SolidDraw.vert.spv", VK_SHADER_STAGE_VERTEX_BIT);
+            vkutil::loadStage(ctx.device, vertShader, VK_SHADER_STAGE_VERTEX_BIT);
         ShaderStage fs =
             vkutil::loadStage(ctx.device, "SolidDraw.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT);
 
@@ -215,7 +216,7 @@ namespace vkutil
         info.subpass             = 0;
 
         if (vkCreateGraphicsPipelines(ctx.device,
-                                      VK_NULL_HANDLE,
+                                      ctx.pipelineCache,
                                       1,
                                       &info,
                                       nullptr,
@@ -237,7 +238,8 @@ namespace vkutil
                               VkPipelineLayout                            layout,
                               VkSampleCountFlagBits                       sampleCount,
                               const VkPipelineVertexInputStateCreateInfo& vi,
-                              GraphicsPipeline&                           out)
+                              GraphicsPipeline&                           out,
+                              const char*                                 vertShader)
     {
         out.destroy();
 
@@ -246,7 +248,7 @@ namespace vkutil
 
         out.m_device = ctx.device;
 
-        ShaderStage vs = vkutil::loadStage(ctx.device, "ShadedDraw.vert.spv", VK_SHADER_STAGE_VERTEX_BIT);
+        ShaderStage vs = vkutil::loadStage(ctx.device, vertShader, VK_SHADER_STAGE_VERTEX_BIT);
         ShaderStage fs = vkutil::loadStage(ctx.device, "ShadedDraw.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT);
 
         if (!vs.isValid() || !fs.isValid())
@@ -306,7 +308,7 @@ namespace vkutil
         info.subpass             = 0;
 
         if (vkCreateGraphicsPipelines(ctx.device,
-                                      VK_NULL_HANDLE,
+                                      ctx.pipelineCache,
                                       1,
                                       &info,
                                       nullptr,
@@ -328,7 +330,8 @@ namespace vkutil
                                  VkPipelineLayout                            layout,
                                  VkSampleCountFlagBits                       sampleCount,
                                  const VkPipelineVertexInputStateCreateInfo& vi,
-                                 GraphicsPipeline&                           out)
+                                 GraphicsPipeline&                           out,
+                                 const char*                                 vertShader)
     {
         out.destroy();
 
@@ -338,11 +341,11 @@ namespace vkutil
         out.m_device = ctx.device;
 
         // Only vertex shader; no fragment shader -> depth only.
-        ShaderStage vs = vkutil::loadStage(ctx.device, "SolidDraw.vert.spv", VK_SHADER_STAGE_VERTEX_BIT);
+        ShaderStage vs = vkutil::loadStage(ctx.device, vertShader, VK_SHADER_STAGE_VERTEX_BIT);
 
         if (!vs.isValid())
         {
-            std::cerr << "GraphicsPipelines: Failed to load SolidDraw.vert for depth-only.\n";
+            std::cerr << "GraphicsPipelines: Failed to load " << vertShader << " for depth-only.\n";
             out.destroy();
             return false;
         }
@@ -398,7 +401,7 @@ namespace vkutil
         info.subpass             = 0;
 
         if (vkCreateGraphicsPipelines(ctx.device,
-                                      VK_NULL_HANDLE,
+                                      ctx.pipelineCache,
                                       1,
                                       &info,
                                       nullptr,
@@ -484,7 +487,7 @@ namespace vkutil
         info.subpass             = 0;
 
         if (vkCreateGraphicsPipelines(ctx.device,
-                                      VK_NULL_HANDLE,
+                                      ctx.pipelineCache,
                                       1,
                                       &info,
                                       nullptr,
@@ -569,7 +572,7 @@ namespace vkutil
         info.subpass             = 0;
 
         if (vkCreateGraphicsPipelines(ctx.device,
-                                      VK_NULL_HANDLE,
+                                      ctx.pipelineCache,
                                       1,
                                       &info,
                                       nullptr,
@@ -654,7 +657,7 @@ namespace vkutil
         info.subpass             = 0;
 
         if (vkCreateGraphicsPipelines(ctx.device,
-                                      VK_NULL_HANDLE,
+                                      ctx.pipelineCache,
                                       1,
                                       &info,
                                       nullptr,
@@ -743,7 +746,7 @@ namespace vkutil
         info.subpass             = 0;
 
         if (vkCreateGraphicsPipelines(ctx.device,
-                                      VK_NULL_HANDLE,
+                                      ctx.pipelineCache,
                                       1,
                                       &info,
                                       nullptr,
@@ -829,7 +832,7 @@ namespace vkutil
         info.subpass             = 0;
 
         if (vkCreateGraphicsPipelines(ctx.device,
-                                      VK_NULL_HANDLE,
+                                      ctx.pipelineCache,
                                       1,
                                       &info,
                                       nullptr,
@@ -915,7 +918,7 @@ namespace vkutil
         info.subpass             = 0;
 
         if (vkCreateGraphicsPipelines(ctx.device,
-                                      VK_NULL_HANDLE,
+                                      ctx.pipelineCache,
                                       1,
                                       &info,
                                       nullptr,
@@ -1003,7 +1006,7 @@ namespace vkutil
         info.subpass             = 0;
 
         if (vkCreateGraphicsPipelines(ctx.device,
-                                      VK_NULL_HANDLE,
+                                      ctx.pipelineCache,
                                       1,
                                       &info,
                                       nullptr,
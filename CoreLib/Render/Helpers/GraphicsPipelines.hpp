@@ -35,7 +35,7 @@ namespace vkutil
      * @brief Solid (unlit) mesh pipeline.
      *
      * Shaders:
-     *  - SolidDraw.vert.spv
+     *  - SolidDraw.vert.spv (or @p vertShader)
      *  - SolidDraw.frag.spv
      *
      * Matches original solidPreset.
@@ -45,13 +45,14 @@ namespace vkutil
                              VkPipelineLayout                            layout,
                              VkSampleCountFlagBits                       sampleCount,
                              const VkPipelineVertexInputStateCreateInfo& vi,
-                             GraphicsPipeline&                           out);
+                             GraphicsPipeline&                           out,
+                             const char*                                 vertShader = "SolidDraw.vert.spv");
 
     /**
      * @brief Shaded (lit) mesh pipeline.
      *
      * Shaders:
-     *  - ShadedDraw.vert.spv
+     *  - ShadedDraw.vert.spv (or @p vertShader)
      *  - ShadedDraw.frag.spv
      *
      * Matches original solidPreset (same depth/cull, different shader).
@@ -61,13 +62,14 @@ namespace vkutil
                               VkPipelineLayout                            layout,
                               VkSampleCountFlagBits                       sampleCount,
                               const VkPipelineVertexInputStateCreateInfo& vi,
-                              GraphicsPipeline&                           out);
+                              GraphicsPipeline&                           out,
+                              const char*                                 vertShader = "ShadedDraw.vert.spv");
 
     /**
      * @brief Depth-only triangle prepass.
      *
      * Shaders:
-     *  - SolidDraw.vert.spv   (no fragment shader)
+     *  - SolidDraw.vert.spv or @p vertShader (no fragment shader)
      *
      * Matches original depthOnlyPreset:
      *  - depth test ON
@@ -80,7 +82,8 @@ namespace vkutil
                                  VkPipelineLayout                            layout,
                                  VkSampleCountFlagBits                       sampleCount,
                                  const VkPipelineVertexInputStateCreateInfo& vi,
-                                 GraphicsPipeline&                           out);
+                                 GraphicsPipeline&                           out,
+                                 const char*                                 vertShader = "SolidDraw.vert.spv");
 
     /**
      * @brief Wireframe pipeline for visible edges.
@@ -314,7 +314,7 @@ bool GridRendererVK::createPipelines(VkRenderPass     renderPass,
     // Create depth-tested pipeline
     info.pDepthStencilState = &dsDepth;
     if (vkCreateGraphicsPipelines(device,
-                                  VK_NULL_HANDLE,
+                                  m_ctx->pipelineCache,
                                   1,
                                   &info,
                                   nullptr,
@@ -328,7 +328,7 @@ bool GridRendererVK::createPipelines(VkRenderPass     renderPass,
     // Create xray (no depth) pipeline
     info.pDepthStencilState = &dsXray;
     if (vkCreateGraphicsPipelines(device,
-                                  VK_NULL_HANDLE,
+                                  m_ctx->pipelineCache,
                                   1,
                                   &info,
                                   nullptr,
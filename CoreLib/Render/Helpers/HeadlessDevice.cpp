@@ -0,0 +1,459 @@
+//============================================================
+// HeadlessDevice.cpp
+//============================================================
+#include "HeadlessDevice.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    constexpr const char* kValidationLayer = "VK_LAYER_KHRONOS_validation";
+
+    bool hasExt(const std::vector<VkExtensionProperties>& exts, const char* name) noexcept
+    {
+        for (const VkExtensionProperties& e : exts)
+        {
+            if (std::strcmp(e.extensionName, name) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    bool containsNoCase(std::string_view haystack, std::string_view needle) noexcept
+    {
+        const auto it = std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(), [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        });
+        return it != haystack.end();
+    }
+
+    std::vector<VkExtensionProperties> deviceExtensions(VkPhysicalDevice pd)
+    {
+        uint32_t count = 0;
+        vkEnumerateDeviceExtensionProperties(pd, nullptr, &count, nullptr);
+
+        std::vector<VkExtensionProperties> exts(count);
+        if (count)
+            vkEnumerateDeviceExtensionProperties(pd, nullptr, &count, exts.data());
+        return exts;
+    }
+
+    bool findGraphicsFamily(VkPhysicalDevice pd, uint32_t& outFamily) noexcept
+    {
+        uint32_t count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(pd, &count, nullptr);
+
+        std::vector<VkQueueFamilyProperties> props(count);
+        vkGetPhysicalDeviceQueueFamilyProperties(pd, &count, props.data());
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (props[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
+            {
+                outFamily = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Same ranking as VulkanBackend::createDevice(), minus the swapchain requirement.
+    int scoreDevice(const VkPhysicalDeviceProperties& props) noexcept
+    {
+        int score = 0;
+        switch (props.deviceType)
+        {
+            case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+                score += 1000;
+                break;
+            case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+                score += 300;
+                break;
+            case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+                score += 150;
+                break;
+            case VK_PHYSICAL_DEVICE_TYPE_CPU:
+                score += 10;
+                break;
+            default:
+                score += 50;
+                break;
+        }
+
+        score += int(VK_VERSION_MAJOR(props.apiVersion)) * 100;
+        score += int(VK_VERSION_MINOR(props.apiVersion)) * 10;
+        score += int(props.limits.maxImageDimension2D / 1024);
+        return score;
+    }
+
+    VkSampleCountFlagBits maxUsableSampleCount(const VkPhysicalDeviceProperties& props, uint32_t cap) noexcept
+    {
+        const VkSampleCountFlags counts = props.limits.framebufferColorSampleCounts & props.limits.framebufferDepthSampleCounts;
+
+        for (uint32_t s = 64; s > 1; s >>= 1)
+        {
+            if ((counts & s) && (cap == 0 || s <= cap))
+                return static_cast<VkSampleCountFlagBits>(s);
+        }
+        return VK_SAMPLE_COUNT_1_BIT;
+    }
+} // namespace
+
+HeadlessDevice::~HeadlessDevice() noexcept
+{
+    shutdown();
+}
+
+bool HeadlessDevice::init(const HeadlessDeviceSettings& settings)
+{
+    shutdown();
+
+    if (!createInstance(settings.validation))
+        return false;
+
+    if (!createDevice(settings))
+    {
+        shutdown();
+        return false;
+    }
+
+    if (m_ctx.supportsRayTracing)
+        loadRtEntryPoints();
+
+    m_ctx.instance                 = m_instance;
+    m_ctx.physicalDevice           = m_physicalDevice;
+    m_ctx.device                   = m_device;
+    m_ctx.graphicsQueue            = m_graphicsQueue;
+    m_ctx.graphicsQueueFamilyIndex = m_graphicsFamily;
+    m_ctx.framesInFlight           = std::clamp(settings.framesInFlight, 1u, vkcfg::kMaxFramesInFlight);
+    m_ctx.rtDispatch               = m_ctx.supportsRayTracing ? &m_rtDispatch : nullptr;
+    m_ctx.allocator                = nullptr;
+
+    return true;
+}
+
+void HeadlessDevice::shutdown() noexcept
+{
+    if (m_device)
+    {
+        vkDeviceWaitIdle(m_device);
+        vkDestroyDevice(m_device, nullptr);
+    }
+
+    if (m_instance)
+        vkDestroyInstance(m_instance, nullptr);
+
+    m_instance       = VK_NULL_HANDLE;
+    m_physicalDevice = VK_NULL_HANDLE;
+    m_device         = VK_NULL_HANDLE;
+    m_graphicsQueue  = VK_NULL_HANDLE;
+    m_graphicsFamily = 0;
+    m_ctx            = {};
+    m_rtDispatch     = {};
+}
+
+bool HeadlessDevice::createInstance(bool validation)
+{
+    uint32_t loaderVersion = VK_API_VERSION_1_0;
+    if (vkEnumerateInstanceVersion(&loaderVersion) != VK_SUCCESS)
+        loaderVersion = VK_API_VERSION_1_0;
+
+    VkApplicationInfo app  = {};
+    app.sType              = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    app.pApplicationName   = "IMP3D Headless";
+    app.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+    app.pEngineName        = "IMP3D";
+    app.engineVersion      = VK_MAKE_VERSION(1, 0, 0);
+    app.apiVersion         = std::min(loaderVersion, VK_API_VERSION_1_3);
+
+    std::vector<const char*> layers = {};
+    if (validation)
+    {
+        uint32_t count = 0;
+        vkEnumerateInstanceLayerProperties(&count, nullptr);
+        std::vector<VkLayerProperties> props(count);
+        if (count)
+            vkEnumerateInstanceLayerProperties(&count, props.data());
+
+        const bool found = std::any_of(props.begin(), props.end(), [](const VkLayerProperties& p) {
+            return std::strcmp(p.layerName, kValidationLayer) == 0;
+        });
+
+        if (found)
+            layers.push_back(kValidationLayer);
+        else
+            std::cerr << "HeadlessDevice: " << kValidationLayer << " not available on this system\n";
+    }
+
+    VkInstanceCreateInfo ici = {};
+    ici.sType                = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    ici.pApplicationInfo     = &app;
+    ici.enabledLayerCount    = uint32_t(layers.size());
+    ici.ppEnabledLayerNames  = layers.data();
+
+    const VkResult r = vkCreateInstance(&ici, nullptr, &m_instance);
+    if (r != VK_SUCCESS)
+    {
+        std::cerr << "HeadlessDevice: vkCreateInstance failed (" << r << ")\n";
+        m_instance = VK_NULL_HANDLE;
+        return false;
+    }
+
+    return true;
+}
+
+bool HeadlessDevice::createDevice(const HeadlessDeviceSettings& settings)
+{
+    uint32_t devCount = 0;
+    vkEnumeratePhysicalDevices(m_instance, &devCount, nullptr);
+    if (devCount == 0)
+    {
+        std::cerr << "HeadlessDevice: no Vulkan devices\n";
+        return false;
+    }
+
+    std::vector<VkPhysicalDevice> devices(devCount);
+    vkEnumeratePhysicalDevices(m_instance, &devCount, devices.data());
+
+    // ------------------------------------------------------------
+    // Pick a device
+    // ------------------------------------------------------------
+    int bestScore = -1;
+
+    for (VkPhysicalDevice pd : devices)
+    {
+        VkPhysicalDeviceProperties props = {};
+        VkPhysicalDeviceFeatures   feats = {};
+        vkGetPhysicalDeviceProperties(pd, &props);
+        vkGetPhysicalDeviceFeatures(pd, &feats);
+
+        uint32_t family = 0;
+        if (!findGraphicsFamily(pd, family) || !feats.geometryShader || !feats.samplerAnisotropy)
+            continue;
+
+        if (!settings.deviceFilter.empty() && !containsNoCase(props.deviceName, settings.deviceFilter))
+            continue;
+
+        const int score = scoreDevice(props);
+        if (score > bestScore)
+        {
+            bestScore         = score;
+            m_physicalDevice  = pd;
+            m_graphicsFamily  = family;
+            m_ctx.deviceProps = props;
+        }
+    }
+
+    if (!m_physicalDevice)
+    {
+        std::cerr << "HeadlessDevice: no suitable Vulkan device";
+        if (!settings.deviceFilter.empty())
+            std::cerr << " matching \"" << settings.deviceFilter << "\"";
+        std::cerr << "\n";
+        return false;
+    }
+
+    std::cerr << "HeadlessDevice: Selected device: " << m_ctx.deviceProps.deviceName << ", Vulkan "
+              << VK_VERSION_MAJOR(m_ctx.deviceProps.apiVersion) << "." << VK_VERSION_MINOR(m_ctx.deviceProps.apiVersion) << "."
+              << VK_VERSION_PATCH(m_ctx.deviceProps.apiVersion) << "\n";
+
+    m_ctx.sampleCount = maxUsableSampleCount(m_ctx.deviceProps, settings.maxSamples);
+
+    // ------------------------------------------------------------
+    // Extensions and features (mirrors VulkanBackend::createDevice)
+    // ------------------------------------------------------------
+    const std::vector<VkExtensionProperties> exts = deviceExtensions(m_physicalDevice);
+
+    const uint32_t apiMajor     = VK_VERSION_MAJOR(m_ctx.deviceProps.apiVersion);
+    const uint32_t apiMinor     = VK_VERSION_MINOR(m_ctx.deviceProps.apiVersion);
+    const bool     apiAtLeast12 = (apiMajor > 1) || (apiMajor == 1 && apiMinor >= 2);
+
+    VkPhysicalDeviceFeatures2 supportedCore = {};
+    supportedCore.sType                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    vkGetPhysicalDeviceFeatures2(m_physicalDevice, &supportedCore);
+
+    VkPhysicalDeviceVulkan12Features supported12 = {};
+    supported12.sType                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    if (apiAtLeast12)
+    {
+        VkPhysicalDeviceFeatures2 q = {};
+        q.sType                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        q.pNext                     = &supported12;
+        vkGetPhysicalDeviceFeatures2(m_physicalDevice, &q);
+    }
+
+    std::vector<const char*> enabledExts = {};
+
+    m_ctx.supportsMemoryBudget = hasExt(exts, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    if (m_ctx.supportsMemoryBudget)
+        enabledExts.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+    bool rt = hasExt(exts, VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME) &&
+              hasExt(exts, VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME) &&
+              hasExt(exts, VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME) &&
+              hasExt(exts, VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME) &&
+              hasExt(exts, VK_KHR_SPIRV_1_4_EXTENSION_NAME) &&
+              hasExt(exts, VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME) &&
+              apiAtLeast12 && supportedCore.features.shaderInt64 && supported12.bufferDeviceAddress == VK_TRUE;
+
+    if (rt)
+    {
+        VkPhysicalDeviceAccelerationStructureFeaturesKHR supportedAs = {};
+        supportedAs.sType                                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
+
+        VkPhysicalDeviceRayTracingPipelineFeaturesKHR supportedRt = {};
+        supportedRt.sType                                         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR;
+
+        VkPhysicalDeviceFeatures2 q = {};
+        q.sType                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        q.pNext                     = &supportedAs;
+        supportedAs.pNext           = &supportedRt;
+        vkGetPhysicalDeviceFeatures2(m_physicalDevice, &q);
+
+        rt = supportedAs.accelerationStructure && supportedRt.rayTracingPipeline;
+    }
+
+    m_ctx.supportsRayTracing = rt;
+
+    if (rt)
+    {
+        enabledExts.push_back(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME);
+        enabledExts.push_back(VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME);
+        enabledExts.push_back(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME);
+        enabledExts.push_back(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
+        enabledExts.push_back(VK_KHR_SPIRV_1_4_EXTENSION_NAME);
+        enabledExts.push_back(VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME);
+    }
+
+    VkPhysicalDeviceFeatures2 feats2  = {};
+    feats2.sType                      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    feats2.features.geometryShader    = VK_TRUE;
+    feats2.features.samplerAnisotropy = VK_TRUE;
+    feats2.features.shaderInt64       = supportedCore.features.shaderInt64 ? VK_TRUE : VK_FALSE;
+
+    m_ctx.supportsDrawIndirectFirstInstance = supportedCore.features.drawIndirectFirstInstance == VK_TRUE;
+    m_ctx.supportsMultiDrawIndirect         = supportedCore.features.multiDrawIndirect == VK_TRUE;
+
+    feats2.features.drawIndirectFirstInstance = m_ctx.supportsDrawIndirectFirstInstance ? VK_TRUE : VK_FALSE;
+    feats2.features.multiDrawIndirect         = m_ctx.supportsMultiDrawIndirect ? VK_TRUE : VK_FALSE;
+
+    VkPhysicalDeviceVulkan12Features feat12 = {};
+    feat12.sType                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    if (apiAtLeast12)
+    {
+        feat12.scalarBlockLayout                         = supported12.scalarBlockLayout;
+        feat12.timelineSemaphore                         = supported12.timelineSemaphore;
+        feat12.shaderSampledImageArrayNonUniformIndexing = supported12.shaderSampledImageArrayNonUniformIndexing;
+        feat12.bufferDeviceAddress                       = rt ? VK_TRUE : VK_FALSE;
+    }
+
+    VkPhysicalDeviceAccelerationStructureFeaturesKHR asFeat = {};
+    asFeat.sType                                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
+
+    VkPhysicalDeviceRayTracingPipelineFeaturesKHR rtFeat = {};
+    rtFeat.sType                                         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR;
+
+    void* pNextChain = nullptr;
+    auto  chain      = [&](auto& s) {
+        s.pNext    = pNextChain;
+        pNextChain = &s;
+    };
+
+    if (rt)
+    {
+        asFeat.accelerationStructure = VK_TRUE;
+        rtFeat.rayTracingPipeline    = VK_TRUE;
+        chain(rtFeat);
+        chain(asFeat);
+    }
+
+    if (apiAtLeast12)
+        chain(feat12);
+
+    feats2.pNext = pNextChain;
+
+    const float prio = 1.0f;
+
+    VkDeviceQueueCreateInfo qci = {};
+    qci.sType                   = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    qci.queueFamilyIndex        = m_graphicsFamily;
+    qci.queueCount              = 1;
+    qci.pQueuePriorities        = &prio;
+
+    VkDeviceCreateInfo dci      = {};
+    dci.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    dci.pNext                   = &feats2;
+    dci.queueCreateInfoCount    = 1;
+    dci.pQueueCreateInfos       = &qci;
+    dci.enabledExtensionCount   = uint32_t(enabledExts.size());
+    dci.ppEnabledExtensionNames = enabledExts.data();
+
+    const VkResult r = vkCreateDevice(m_physicalDevice, &dci, nullptr, &m_device);
+    if (r != VK_SUCCESS)
+    {
+        std::cerr << "HeadlessDevice: vkCreateDevice failed (" << r << ")\n";
+        m_device = VK_NULL_HANDLE;
+        return false;
+    }
+
+    vkGetDeviceQueue(m_device, m_graphicsFamily, 0, &m_graphicsQueue);
+
+    if (rt)
+    {
+        m_ctx.rtProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_PROPERTIES_KHR;
+        m_ctx.asProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR;
+
+        VkPhysicalDeviceProperties2 props2 = {};
+        props2.sType                       = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        props2.pNext                       = &m_ctx.rtProps;
+        m_ctx.rtProps.pNext                = &m_ctx.asProps;
+        m_ctx.asProps.pNext                = nullptr;
+
+        vkGetPhysicalDeviceProperties2(m_physicalDevice, &props2);
+
+        m_ctx.rtProps.pNext = nullptr;
+    }
+
+    return true;
+}
+
+void HeadlessDevice::loadRtEntryPoints() noexcept
+{
+    auto load = [&](auto& fn, const char* name) {
+        fn = reinterpret_cast<std::remove_reference_t<decltype(fn)>>(vkGetDeviceProcAddr(m_device, name));
+        return fn != nullptr;
+    };
+
+    VulkanRtDispatch& d  = m_rtDispatch;
+    bool              ok = true;
+
+    ok &= load(d.vkGetBufferDeviceAddressKHR, "vkGetBufferDeviceAddressKHR");
+    ok &= load(d.vkCreateAccelerationStructureKHR, "vkCreateAccelerationStructureKHR");
+    ok &= load(d.vkDestroyAccelerationStructureKHR, "vkDestroyAccelerationStructureKHR");
+    ok &= load(d.vkGetAccelerationStructureBuildSizesKHR, "vkGetAccelerationStructureBuildSizesKHR");
+    ok &= load(d.vkCmdBuildAccelerationStructuresKHR, "vkCmdBuildAccelerationStructuresKHR");
+    ok &= load(d.vkCmdCopyAccelerationStructureKHR, "vkCmdCopyAccelerationStructureKHR");
+    ok &= load(d.vkCmdWriteAccelerationStructuresPropertiesKHR, "vkCmdWriteAccelerationStructuresPropertiesKHR");
+    ok &= load(d.vkGetAccelerationStructureDeviceAddressKHR, "vkGetAccelerationStructureDeviceAddressKHR");
+    ok &= load(d.vkCreateRayTracingPipelinesKHR, "vkCreateRayTracingPipelinesKHR");
+    ok &= load(d.vkGetRayTracingShaderGroupHandlesKHR, "vkGetRayTracingShaderGroupHandlesKHR");
+    ok &= load(d.vkCmdTraceRaysKHR, "vkCmdTraceRaysKHR");
+
+    // If any entry point is missing, raster still works.
+    if (!ok)
+    {
+        std::cerr << "HeadlessDevice: ray tracing entry points missing; RT disabled.\n";
+        m_rtDispatch             = {};
+        m_ctx.supportsRayTracing = false;
+        m_ctx.rtProps            = {};
+        m_ctx.asProps            = {};
+    }
+}
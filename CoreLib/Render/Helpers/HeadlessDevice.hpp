@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vulkan/vulkan.h>
+
+#include "VulkanContext.hpp"
+
+/**
+ * @brief Options for HeadlessDevice::init().
+ */
+struct HeadlessDeviceSettings
+{
+    std::string deviceFilter   = {};    ///< Case-insensitive name substring (e.g. "llvmpipe"); empty = best scored.
+    bool        validation     = false; ///< Enable VK_LAYER_KHRONOS_validation when installed.
+    uint32_t    maxSamples     = 0;     ///< MSAA cap; 0 = highest the device supports (as VulkanBackend).
+    uint32_t    framesInFlight = vkcfg::kMaxFramesInFlight;
+};
+
+/**
+ * @brief Vulkan instance + device without a window system (no Qt, no surface).
+ *
+ * Picks and creates the device with the same hard requirements and optional
+ * features as the Qt VulkanBackend (descriptor indexing, scalar layout,
+ * indirect draws, memory budget, ray tracing when available), so CoreLib
+ * renders exactly as it does in the app. Works on software ICDs such as
+ * lavapipe, which is what headless CI machines usually have.
+ *
+ * Pair with OffscreenTarget for a render pass and framebuffers.
+ */
+class HeadlessDevice final
+{
+public:
+    HeadlessDevice() noexcept = default;
+    ~HeadlessDevice() noexcept;
+
+    HeadlessDevice(const HeadlessDevice&)            = delete;
+    HeadlessDevice& operator=(const HeadlessDevice&) = delete;
+
+    /// @return false (and logs) when no instance or suitable device can be created.
+    [[nodiscard]] bool init(const HeadlessDeviceSettings& settings = {});
+
+    /// Destroys the device and instance. Release everything created on it first.
+    void shutdown() noexcept;
+
+    [[nodiscard]] const VulkanContext& context() const noexcept
+    {
+        return m_ctx;
+    }
+
+    [[nodiscard]] const char* deviceName() const noexcept
+    {
+        return m_ctx.deviceProps.deviceName;
+    }
+
+private:
+    bool createInstance(bool validation);
+    bool createDevice(const HeadlessDeviceSettings& settings);
+    void loadRtEntryPoints() noexcept;
+
+private:
+    VkInstance       m_instance       = VK_NULL_HANDLE;
+    VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+    VkDevice         m_device         = VK_NULL_HANDLE;
+    VkQueue          m_graphicsQueue  = VK_NULL_HANDLE;
+    uint32_t         m_graphicsFamily = 0;
+
+    VulkanContext    m_ctx        = {};
+    VulkanRtDispatch m_rtDispatch = {};
+};
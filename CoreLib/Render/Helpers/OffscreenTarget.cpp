@@ -0,0 +1,607 @@
+//============================================================
+// OffscreenTarget.cpp
+//============================================================
+#include "OffscreenTarget.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include "VkUtilities.hpp"
+
+namespace
+{
+    constexpr VkFormat kDepthFormat = VK_FORMAT_D32_SFLOAT;
+
+    static bool isBgra(VkFormat f) noexcept
+    {
+        return f == VK_FORMAT_B8G8R8A8_SRGB || f == VK_FORMAT_B8G8R8A8_UNORM;
+    }
+} // namespace
+
+OffscreenTarget::~OffscreenTarget() noexcept
+{
+    destroy();
+}
+
+bool OffscreenTarget::create(const VulkanContext& ctx, uint32_t width, uint32_t height, VkFormat colorFormat)
+{
+    destroy();
+
+    if (ctx.device == VK_NULL_HANDLE || width == 0 || height == 0)
+        return false;
+
+    m_ctx         = ctx;
+    m_colorFormat = colorFormat;
+    m_extent      = {width, height};
+    m_msaa        = ctx.sampleCount != VK_SAMPLE_COUNT_1_BIT;
+
+    const uint32_t frames = std::clamp(ctx.framesInFlight, 1u, vkcfg::kMaxFramesInFlight);
+
+    if (!createRenderPass())
+    {
+        destroy();
+        return false;
+    }
+
+    VkCommandPoolCreateInfo cpci = {};
+    cpci.sType                   = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    cpci.queueFamilyIndex        = ctx.graphicsQueueFamilyIndex;
+    cpci.flags                   = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+    if (vkCreateCommandPool(ctx.device, &cpci, nullptr, &m_cmdPool) != VK_SUCCESS)
+    {
+        std::cerr << "OffscreenTarget: vkCreateCommandPool failed\n";
+        destroy();
+        return false;
+    }
+
+    // Timestamps are optional: a family with timestampValidBits == 0 cannot write them.
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(ctx.physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(ctx.physicalDevice, &familyCount, families.data());
+
+    const uint32_t validBits = ctx.graphicsQueueFamilyIndex < familyCount ? families[ctx.graphicsQueueFamilyIndex].timestampValidBits : 0u;
+
+    if (validBits != 0 && ctx.deviceProps.limits.timestampPeriod > 0.0f)
+    {
+        VkQueryPoolCreateInfo qpci = {};
+        qpci.sType                 = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        qpci.queryType             = VK_QUERY_TYPE_TIMESTAMP;
+        qpci.queryCount            = frames * 2;
+
+        if (vkCreateQueryPool(ctx.device, &qpci, nullptr, &m_queryPool) != VK_SUCCESS)
+            m_queryPool = VK_NULL_HANDLE;
+
+        m_tickMs   = double(ctx.deviceProps.limits.timestampPeriod) * 1e-6;
+        m_tickMask = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1ull);
+    }
+
+    m_slots.resize(frames);
+    m_deferred.init(frames);
+
+    std::vector<VkCommandBuffer> cmds(frames, VK_NULL_HANDLE);
+
+    VkCommandBufferAllocateInfo cbai = {};
+    cbai.sType                       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cbai.commandPool                 = m_cmdPool;
+    cbai.level                       = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cbai.commandBufferCount          = frames;
+
+    if (vkAllocateCommandBuffers(ctx.device, &cbai, cmds.data()) != VK_SUCCESS)
+    {
+        std::cerr << "OffscreenTarget: vkAllocateCommandBuffers failed\n";
+        destroy();
+        return false;
+    }
+
+    for (uint32_t i = 0; i < frames; ++i)
+    {
+        Slot& slot = m_slots[i];
+        slot.cmd   = cmds[i];
+
+        VkFenceCreateInfo fci = {};
+        fci.sType             = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fci.flags             = VK_FENCE_CREATE_SIGNALED_BIT;
+
+        if (vkCreateFence(ctx.device, &fci, nullptr, &slot.fence) != VK_SUCCESS || !createAttachments(slot))
+        {
+            std::cerr << "OffscreenTarget: failed to create frame slot " << i << "\n";
+            destroy();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool OffscreenTarget::resize(uint32_t width, uint32_t height)
+{
+    if (m_renderPass == VK_NULL_HANDLE || width == 0 || height == 0)
+        return false;
+
+    if (width == m_extent.width && height == m_extent.height)
+        return true;
+
+    finish();
+
+    m_extent = {width, height};
+    m_last   = -1;
+
+    for (Slot& slot : m_slots)
+    {
+        destroyAttachments(slot);
+        slot.rendered = false;
+
+        if (!createAttachments(slot))
+        {
+            std::cerr << "OffscreenTarget: failed to recreate attachments at " << width << "x" << height << "\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void OffscreenTarget::destroy() noexcept
+{
+    if (m_ctx.device == VK_NULL_HANDLE)
+        return;
+
+    vkDeviceWaitIdle(m_ctx.device);
+
+    for (uint32_t i = 0; i < uint32_t(m_deferred.perFrame.size()); ++i)
+        m_deferred.flush(i);
+
+    for (Slot& slot : m_slots)
+    {
+        destroyAttachments(slot);
+
+        if (slot.fence)
+            vkDestroyFence(m_ctx.device, slot.fence, nullptr);
+    }
+    m_slots.clear();
+
+    m_readback.destroy();
+
+    if (m_queryPool)
+        vkDestroyQueryPool(m_ctx.device, m_queryPool, nullptr);
+    if (m_cmdPool)
+        vkDestroyCommandPool(m_ctx.device, m_cmdPool, nullptr); // frees the slot command buffers
+    if (m_renderPass)
+        vkDestroyRenderPass(m_ctx.device, m_renderPass, nullptr);
+
+    m_queryPool  = VK_NULL_HANDLE;
+    m_cmdPool    = VK_NULL_HANDLE;
+    m_renderPass = VK_NULL_HANDLE;
+
+    m_gpuMs.clear();
+    m_frameIndex = 0;
+    m_current    = 0;
+    m_last       = -1;
+    m_extent     = {};
+    m_ctx        = {};
+}
+
+// ------------------------------------------------------------
+// Frame loop
+// ------------------------------------------------------------
+
+bool OffscreenTarget::beginFrame(RenderFrameContext& out)
+{
+    if (m_slots.empty())
+        return false;
+
+    m_current  = m_frameIndex % uint32_t(m_slots.size());
+    Slot& slot = m_slots[m_current];
+
+    if (vkWaitForFences(m_ctx.device, 1, &slot.fence, VK_TRUE, UINT64_MAX) != VK_SUCCESS)
+    {
+        std::cerr << "OffscreenTarget: vkWaitForFences failed\n";
+        return false;
+    }
+
+    collectTimestamps(m_current);
+    m_deferred.flush(m_current);
+
+    vkResetCommandBuffer(slot.cmd, 0);
+
+    VkCommandBufferBeginInfo bi = {};
+    bi.sType                    = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    bi.flags                    = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if (vkBeginCommandBuffer(slot.cmd, &bi) != VK_SUCCESS)
+    {
+        std::cerr << "OffscreenTarget: vkBeginCommandBuffer failed\n";
+        return false;
+    }
+
+    if (m_queryPool)
+    {
+        vkCmdResetQueryPool(slot.cmd, m_queryPool, m_current * 2, 2);
+        vkCmdWriteTimestamp(slot.cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_queryPool, m_current * 2);
+    }
+
+    out                  = {};
+    out.cmd              = slot.cmd;
+    out.frameIndex       = m_current;
+    out.deferred         = &m_deferred;
+    out.frameFenceWaited = true;
+
+    return true;
+}
+
+void OffscreenTarget::beginRenderPass(const VkClearColorValue& clearColor)
+{
+    const Slot& slot = m_slots[m_current];
+
+    VkClearValue clears[2] = {};
+    clears[0].color        = clearColor;
+    clears[1].depthStencil = {1.0f, 0};
+
+    VkRenderPassBeginInfo rpbi = {};
+    rpbi.sType                 = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    rpbi.renderPass            = m_renderPass;
+    rpbi.framebuffer           = slot.framebuffer;
+    rpbi.renderArea.offset     = {0, 0};
+    rpbi.renderArea.extent     = m_extent;
+    rpbi.clearValueCount       = 2; // resolve attachment (if any) is not cleared
+    rpbi.pClearValues          = clears;
+
+    vkCmdBeginRenderPass(slot.cmd, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
+}
+
+void OffscreenTarget::endRenderPass()
+{
+    vkCmdEndRenderPass(m_slots[m_current].cmd);
+}
+
+bool OffscreenTarget::endFrame()
+{
+    Slot& slot = m_slots[m_current];
+
+    if (m_queryPool)
+        vkCmdWriteTimestamp(slot.cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPool, m_current * 2 + 1);
+
+    if (vkEndCommandBuffer(slot.cmd) != VK_SUCCESS)
+    {
+        std::cerr << "OffscreenTarget: vkEndCommandBuffer failed\n";
+        return false;
+    }
+
+    vkResetFences(m_ctx.device, 1, &slot.fence);
+
+    VkSubmitInfo si       = {};
+    si.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    si.commandBufferCount = 1;
+    si.pCommandBuffers    = &slot.cmd;
+
+    if (vkQueueSubmit(m_ctx.graphicsQueue, 1, &si, slot.fence) != VK_SUCCESS)
+    {
+        std::cerr << "OffscreenTarget: vkQueueSubmit failed\n";
+        return false;
+    }
+
+    slot.pendingTimestamps = m_queryPool != VK_NULL_HANDLE;
+    slot.rendered          = true;
+
+    m_last = int32_t(m_current);
+    ++m_frameIndex;
+
+    return true;
+}
+
+void OffscreenTarget::finish() noexcept
+{
+    if (m_slots.empty())
+        return;
+
+    vkQueueWaitIdle(m_ctx.graphicsQueue);
+
+    // Oldest first so frame times stay in submission order.
+    const uint32_t n = uint32_t(m_slots.size());
+    for (uint32_t i = 0; i < n; ++i)
+        collectTimestamps((m_frameIndex + i) % n);
+}
+
+std::vector<double> OffscreenTarget::takeGpuTimesMs()
+{
+    std::vector<double> out;
+    out.swap(m_gpuMs);
+    return out;
+}
+
+void OffscreenTarget::collectTimestamps(uint32_t slotIndex) noexcept
+{
+    Slot& slot = m_slots[slotIndex];
+    if (!slot.pendingTimestamps || !m_queryPool)
+        return;
+
+    slot.pendingTimestamps = false;
+
+    uint64_t ticks[2] = {};
+    if (vkGetQueryPoolResults(m_ctx.device,
+                              m_queryPool,
+                              slotIndex * 2,
+                              2,
+                              sizeof(ticks),
+                              ticks,
+                              sizeof(uint64_t),
+                              VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) != VK_SUCCESS)
+    {
+        return;
+    }
+
+    const uint64_t t0 = ticks[0] & m_tickMask;
+    const uint64_t t1 = ticks[1] & m_tickMask;
+    m_gpuMs.push_back(double((t1 - t0) & m_tickMask) * m_tickMs);
+}
+
+// ------------------------------------------------------------
+// Readback
+// ------------------------------------------------------------
+
+bool OffscreenTarget::readback(std::vector<uint32_t>& rgba)
+{
+    rgba.clear();
+
+    if (m_last < 0 || !m_slots[uint32_t(m_last)].rendered)
+        return false;
+
+    finish();
+
+    const Slot&        slot  = m_slots[uint32_t(m_last)];
+    const VkImage      image = m_msaa ? slot.resolveImage : slot.msaaImage;
+    const VkDeviceSize bytes = VkDeviceSize(m_extent.width) * m_extent.height * sizeof(uint32_t);
+
+    if (!m_readback.valid() || m_readback.size() < bytes)
+    {
+        m_readback.destroy();
+        m_readback.create(m_ctx.device,
+                          m_ctx.physicalDevice,
+                          bytes,
+                          VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          true);
+
+        if (!m_readback.valid() || !m_readback.mapped())
+        {
+            std::cerr << "OffscreenTarget: failed to create readback buffer\n";
+            return false;
+        }
+    }
+
+    const bool ok = vkutil::TransientCmd(m_ctx, [&](VkCommandBuffer cmd) {
+        VkBufferImageCopy region               = {};
+        region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel       = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount     = 1;
+        region.imageExtent                     = {m_extent.width, m_extent.height, 1};
+
+        vkCmdCopyImageToBuffer(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_readback.buffer(), 1, &region);
+
+        VkMemoryBarrier mb = {};
+        mb.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        mb.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        mb.dstAccessMask   = VK_ACCESS_HOST_READ_BIT;
+
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &mb, 0, nullptr, 0, nullptr);
+    });
+
+    if (!ok)
+    {
+        std::cerr << "OffscreenTarget: readback copy failed\n";
+        return false;
+    }
+
+    const size_t pixels = size_t(m_extent.width) * m_extent.height;
+    rgba.resize(pixels);
+    std::memcpy(rgba.data(), m_readback.mapped(), pixels * sizeof(uint32_t));
+
+    if (isBgra(m_colorFormat))
+    {
+        for (uint32_t& p : rgba)
+            p = (p & 0xFF00FF00u) | ((p & 0x00FF0000u) >> 16) | ((p & 0x000000FFu) << 16);
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------
+// Creation helpers
+// ------------------------------------------------------------
+
+bool OffscreenTarget::createRenderPass()
+{
+    // Same layout as the viewport swapchain pass. Without MSAA the color
+    // attachment is the readback image itself and there is no resolve.
+    VkAttachmentDescription attachments[3] = {};
+
+    attachments[0].format         = m_colorFormat;
+    attachments[0].samples        = m_ctx.sampleCount;
+    attachments[0].loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    attachments[0].storeOp        = m_msaa ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+    attachments[0].stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    attachments[0].initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+    attachments[0].finalLayout    = m_msaa ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    attachments[1].format         = kDepthFormat;
+    attachments[1].samples        = m_ctx.sampleCount;
+    attachments[1].loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    attachments[1].storeOp        = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    attachments[1].stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    attachments[1].initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+    attachments[1].finalLayout    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    attachments[2].format         = m_colorFormat;
+    attachments[2].samples        = VK_SAMPLE_COUNT_1_BIT;
+    attachments[2].loadOp         = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachments[2].storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+    attachments[2].stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachments[2].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    attachments[2].initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+    attachments[2].finalLayout    = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    VkAttachmentReference colorRef   = {0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+    VkAttachmentReference depthRef   = {1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+    VkAttachmentReference resolveRef = {2, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+
+    VkSubpassDescription sub    = {};
+    sub.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    sub.colorAttachmentCount    = 1;
+    sub.pColorAttachments       = &colorRef;
+    sub.pResolveAttachments     = m_msaa ? &resolveRef : nullptr;
+    sub.pDepthStencilAttachment = &depthRef;
+
+    // Make the end-of-pass layout transition visible to the readback copy.
+    VkSubpassDependency dep = {};
+    dep.srcSubpass          = 0;
+    dep.dstSubpass          = VK_SUBPASS_EXTERNAL;
+    dep.srcStageMask        = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dep.dstStageMask        = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    dep.srcAccessMask       = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dep.dstAccessMask       = VK_ACCESS_TRANSFER_READ_BIT;
+
+    VkRenderPassCreateInfo rpci = {};
+    rpci.sType                  = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    rpci.attachmentCount        = m_msaa ? 3u : 2u;
+    rpci.pAttachments           = attachments;
+    rpci.subpassCount           = 1;
+    rpci.pSubpasses             = &sub;
+    rpci.dependencyCount        = 1;
+    rpci.pDependencies          = &dep;
+
+    if (vkCreateRenderPass(m_ctx.device, &rpci, nullptr, &m_renderPass) != VK_SUCCESS)
+    {
+        std::cerr << "OffscreenTarget: vkCreateRenderPass failed\n";
+        return false;
+    }
+
+    return true;
+}
+
+bool OffscreenTarget::createAttachments(Slot& slot)
+{
+    const VkImageUsageFlags colorUsage = m_msaa ? VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+                                                : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+    if (!createImage(m_colorFormat, colorUsage, VK_IMAGE_ASPECT_COLOR_BIT, m_ctx.sampleCount, slot.msaaImage, slot.msaaMemory, slot.msaaView))
+        return false;
+
+    if (!createImage(kDepthFormat,
+                     VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+                     VK_IMAGE_ASPECT_DEPTH_BIT,
+                     m_ctx.sampleCount,
+                     slot.depthImage,
+                     slot.depthMemory,
+                     slot.depthView))
+        return false;
+
+    if (m_msaa &&
+        !createImage(m_colorFormat,
+                     VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                     VK_IMAGE_ASPECT_COLOR_BIT,
+                     VK_SAMPLE_COUNT_1_BIT,
+                     slot.resolveImage,
+                     slot.resolveMemory,
+                     slot.resolveView))
+        return false;
+
+    const VkImageView views[3] = {slot.msaaView, slot.depthView, slot.resolveView};
+
+    VkFramebufferCreateInfo fci = {};
+    fci.sType                   = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    fci.renderPass              = m_renderPass;
+    fci.attachmentCount         = m_msaa ? 3u : 2u;
+    fci.pAttachments            = views;
+    fci.width                   = m_extent.width;
+    fci.height                  = m_extent.height;
+    fci.layers                  = 1;
+
+    return vkCreateFramebuffer(m_ctx.device, &fci, nullptr, &slot.framebuffer) == VK_SUCCESS;
+}
+
+void OffscreenTarget::destroyAttachments(Slot& slot) noexcept
+{
+    const VkDevice device = m_ctx.device;
+
+    if (slot.framebuffer)
+        vkDestroyFramebuffer(device, slot.framebuffer, nullptr);
+    slot.framebuffer = VK_NULL_HANDLE;
+
+    auto destroyImage = [device](VkImage& image, VkDeviceMemory& memory, VkImageView& view) {
+        if (view)
+            vkDestroyImageView(device, view, nullptr);
+        if (image)
+            vkDestroyImage(device, image, nullptr);
+        if (memory)
+            vkFreeMemory(device, memory, nullptr);
+
+        view   = VK_NULL_HANDLE;
+        image  = VK_NULL_HANDLE;
+        memory = VK_NULL_HANDLE;
+    };
+
+    destroyImage(slot.msaaImage, slot.msaaMemory, slot.msaaView);
+    destroyImage(slot.depthImage, slot.depthMemory, slot.depthView);
+    destroyImage(slot.resolveImage, slot.resolveMemory, slot.resolveView);
+}
+
+bool OffscreenTarget::createImage(VkFormat              format,
+                                  VkImageUsageFlags     usage,
+                                  VkImageAspectFlags    aspect,
+                                  VkSampleCountFlagBits samples,
+                                  VkImage&              outImage,
+                                  VkDeviceMemory&       outMemory,
+                                  VkImageView&          outView)
+{
+    VkImageCreateInfo ici = {};
+    ici.sType             = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    ici.imageType         = VK_IMAGE_TYPE_2D;
+    ici.format            = format;
+    ici.extent            = {m_extent.width, m_extent.height, 1};
+    ici.mipLevels         = 1;
+    ici.arrayLayers       = 1;
+    ici.samples           = samples;
+    ici.tiling            = VK_IMAGE_TILING_OPTIMAL;
+    ici.usage             = usage;
+    ici.initialLayout     = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    if (vkCreateImage(m_ctx.device, &ici, nullptr, &outImage) != VK_SUCCESS)
+        return false;
+
+    VkMemoryRequirements mr = {};
+    vkGetImageMemoryRequirements(m_ctx.device, outImage, &mr);
+
+    const uint32_t memType = vkutil::findMemoryType(m_ctx.physicalDevice, mr.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (memType == UINT32_MAX)
+        return false;
+
+    VkMemoryAllocateInfo mai = {};
+    mai.sType                = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    mai.allocationSize       = mr.size;
+    mai.memoryTypeIndex      = memType;
+
+    if (vkAllocateMemory(m_ctx.device, &mai, nullptr, &outMemory) != VK_SUCCESS)
+        return false;
+
+    if (vkBindImageMemory(m_ctx.device, outImage, outMemory, 0) != VK_SUCCESS)
+        return false;
+
+    VkImageViewCreateInfo vci           = {};
+    vci.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    vci.image                           = outImage;
+    vci.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+    vci.format                          = format;
+    vci.subresourceRange.aspectMask     = aspect;
+    vci.subresourceRange.baseMipLevel   = 0;
+    vci.subresourceRange.levelCount     = 1;
+    vci.subresourceRange.baseArrayLayer = 0;
+    vci.subresourceRange.layerCount     = 1;
+
+    return vkCreateImageView(m_ctx.device, &vci, nullptr, &outView) == VK_SUCCESS;
+}
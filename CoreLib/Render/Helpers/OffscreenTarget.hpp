@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "GpuBuffer.hpp"
+#include "VulkanContext.hpp"
+
+/**
+ * @brief Offscreen stand-in for a viewport swapchain.
+ *
+ * Same render pass layout as VulkanBackend's viewport swapchain (MSAA color,
+ * D32 depth, single-sample resolve), so Core::initializeSwapchain() builds
+ * identical pipelines against renderPass(). The resolve image ends the pass
+ * in TRANSFER_SRC_OPTIMAL for readback() instead of PRESENT_SRC.
+ *
+ * Frame loop, mirroring VulkanBackend::beginFrame()/endFrame():
+ * @code
+ *   RenderFrameContext rfc = {};
+ *   target.beginFrame(rfc);
+ *   core.renderPrePass(vp, rfc);
+ *   target.beginRenderPass(clear);
+ *   core.render(vp, rfc);
+ *   target.endRenderPass();
+ *   target.endFrame();
+ * @endcode
+ *
+ * Each frame is bracketed by GPU timestamps; completed frame times are
+ * collected when their slot is reused or on finish().
+ */
+class OffscreenTarget final
+{
+public:
+    OffscreenTarget() noexcept = default;
+    ~OffscreenTarget() noexcept;
+
+    OffscreenTarget(const OffscreenTarget&)            = delete;
+    OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+    /// @param colorFormat Defaults to the format the viewport swapchain prefers.
+    [[nodiscard]] bool create(const VulkanContext& ctx,
+                              uint32_t             width,
+                              uint32_t             height,
+                              VkFormat             colorFormat = VK_FORMAT_B8G8R8A8_SRGB);
+
+    /// Recreates the attachments and framebuffers; the render pass is kept.
+    [[nodiscard]] bool resize(uint32_t width, uint32_t height);
+
+    void destroy() noexcept;
+
+    [[nodiscard]] VkRenderPass renderPass() const noexcept
+    {
+        return m_renderPass;
+    }
+
+    [[nodiscard]] VkExtent2D extent() const noexcept
+    {
+        return m_extent;
+    }
+
+    /// False when the queue family cannot write timestamps (frame times stay empty).
+    [[nodiscard]] bool timestampsSupported() const noexcept
+    {
+        return m_queryPool != VK_NULL_HANDLE;
+    }
+
+    // ------------------------------------------------------------
+    // Frame loop
+    // ------------------------------------------------------------
+
+    /// Waits for the slot, flushes its deferred deletions and starts recording.
+    [[nodiscard]] bool beginFrame(RenderFrameContext& out);
+
+    void beginRenderPass(const VkClearColorValue& clearColor);
+    void endRenderPass();
+
+    /// Ends recording and submits (no wait).
+    [[nodiscard]] bool endFrame();
+
+    /// Waits for all submitted frames and collects their timestamps.
+    void finish() noexcept;
+
+    /// GPU time of each completed frame in milliseconds, in submission order; clears the list.
+    [[nodiscard]] std::vector<double> takeGpuTimesMs();
+
+    /**
+     * @brief Copy the last finished frame to @p rgba (RGBA8, row 0 at the top).
+     *
+     * Calls finish() first. BGRA formats are swizzled to RGBA.
+     */
+    [[nodiscard]] bool readback(std::vector<uint32_t>& rgba);
+
+private:
+    struct Slot
+    {
+        VkImage        msaaImage  = VK_NULL_HANDLE;
+        VkDeviceMemory msaaMemory = VK_NULL_HANDLE;
+        VkImageView    msaaView   = VK_NULL_HANDLE;
+
+        VkImage        depthImage  = VK_NULL_HANDLE;
+        VkDeviceMemory depthMemory = VK_NULL_HANDLE;
+        VkImageView    depthView   = VK_NULL_HANDLE;
+
+        VkImage        resolveImage  = VK_NULL_HANDLE;
+        VkDeviceMemory resolveMemory = VK_NULL_HANDLE;
+        VkImageView    resolveView   = VK_NULL_HANDLE;
+
+        VkFramebuffer   framebuffer = VK_NULL_HANDLE;
+        VkCommandBuffer cmd         = VK_NULL_HANDLE;
+        VkFence         fence       = VK_NULL_HANDLE;
+
+        bool pendingTimestamps = false;
+        bool rendered          = false;
+    };
+
+    bool createRenderPass();
+    bool createAttachments(Slot& slot);
+    void destroyAttachments(Slot& slot) noexcept;
+    void collectTimestamps(uint32_t slotIndex) noexcept;
+
+    bool createImage(VkFormat              format,
+                     VkImageUsageFlags     usage,
+                     VkImageAspectFlags    aspect,
+                     VkSampleCountFlagBits samples,
+                     VkImage&              outImage,
+                     VkDeviceMemory&       outMemory,
+                     VkImageView&          outView);
+
+private:
+    VulkanContext m_ctx         = {};
+    VkFormat      m_colorFormat = VK_FORMAT_UNDEFINED;
+    VkExtent2D    m_extent      = {};
+    bool          m_msaa        = false; ///< ctx.sampleCount > 1: render to MSAA color and resolve.
+
+    VkRenderPass  m_renderPass = VK_NULL_HANDLE;
+    VkCommandPool m_cmdPool    = VK_NULL_HANDLE;
+    VkQueryPool   m_queryPool  = VK_NULL_HANDLE;
+
+    std::vector<Slot> m_slots      = {};
+    uint32_t          m_frameIndex = 0;
+    uint32_t          m_current    = 0;      ///< Slot being recorded.
+    int32_t           m_last       = -1;     ///< Slot of the last submitted frame.
+    double            m_tickMs     = 0.0;    ///< timestampPeriod in milliseconds.
+    uint64_t          m_tickMask   = ~0ull;  ///< timestampValidBits mask.
+
+    DeferredDeletion    m_deferred = {};
+    GpuBuffer           m_readback = {};
+    std::vector<double> m_gpuMs    = {};
+};
@@ -0,0 +1,268 @@
+#include "PipelineCache.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t kMagic   = 0x43504D49u; // "IMPC" little-endian
+    constexpr uint32_t kVersion = 1u;
+
+    struct PipelineCacheFileHeader
+    {
+        uint32_t magic         = kMagic;
+        uint32_t version       = kVersion;
+        uint32_t vendorID      = 0;
+        uint32_t deviceID      = 0;
+        uint32_t driverVersion = 0;
+        uint32_t reserved      = 0;
+
+        uint8_t deviceUUID[VK_UUID_SIZE]        = {};
+        uint8_t pipelineCacheUUID[VK_UUID_SIZE] = {};
+
+        uint64_t dataSize = 0;
+        uint64_t dataHash = 0;
+    };
+    static_assert(sizeof(PipelineCacheFileHeader) == 24 + 2 * VK_UUID_SIZE + 16);
+
+    struct DeviceIdentity
+    {
+        VkPhysicalDeviceProperties props              = {};
+        uint8_t                    uuid[VK_UUID_SIZE] = {};
+    };
+
+    DeviceIdentity queryIdentity(VkPhysicalDevice physicalDevice) noexcept
+    {
+        DeviceIdentity id = {};
+
+        VkPhysicalDeviceIDProperties idProps = {};
+        idProps.sType                        = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+
+        VkPhysicalDeviceProperties2 props2 = {};
+        props2.sType                       = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        props2.pNext                       = &idProps;
+
+        vkGetPhysicalDeviceProperties2(physicalDevice, &props2);
+
+        id.props = props2.properties;
+        std::memcpy(id.uuid, idProps.deviceUUID, VK_UUID_SIZE);
+        return id;
+    }
+
+    PipelineCacheFileHeader makeHeader(const DeviceIdentity& id) noexcept
+    {
+        PipelineCacheFileHeader h = {};
+        h.vendorID                = id.props.vendorID;
+        h.deviceID                = id.props.deviceID;
+        h.driverVersion           = id.props.driverVersion;
+        std::memcpy(h.deviceUUID, id.uuid, VK_UUID_SIZE);
+        std::memcpy(h.pipelineCacheUUID, id.props.pipelineCacheUUID, VK_UUID_SIZE);
+        return h;
+    }
+
+    // FNV-1a, 64 bit. Only guards against truncated/corrupt files.
+    uint64_t checksum(const uint8_t* data, size_t size) noexcept
+    {
+        uint64_t h = 1469598103934665603ull;
+        for (size_t i = 0; i < size; ++i)
+        {
+            h ^= data[i];
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    std::filesystem::path cacheFilePath(const std::filesystem::path& dir, const DeviceIdentity& id)
+    {
+        static constexpr char kHex[] = "0123456789abcdef";
+
+        std::string name = "pipelines_";
+        for (uint8_t b : id.uuid)
+        {
+            name.push_back(kHex[b >> 4]);
+            name.push_back(kHex[b & 0xF]);
+        }
+        name += ".bin";
+
+        return dir / name;
+    }
+
+    // Validate the driver's own blob header (VkPipelineCacheHeaderVersionOne) as well;
+    // some drivers do not reject foreign data gracefully.
+    bool driverBlobMatches(const std::vector<uint8_t>& blob, const DeviceIdentity& id) noexcept
+    {
+        if (blob.size() < sizeof(VkPipelineCacheHeaderVersionOne))
+            return false;
+
+        VkPipelineCacheHeaderVersionOne vh = {};
+        std::memcpy(&vh, blob.data(), sizeof(vh));
+
+        return vh.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne) &&
+               vh.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+               vh.vendorID == id.props.vendorID &&
+               vh.deviceID == id.props.deviceID &&
+               std::memcmp(vh.pipelineCacheUUID, id.props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+
+    std::vector<uint8_t> readValidatedBlob(const std::filesystem::path& file, const DeviceIdentity& id)
+    {
+        std::ifstream in(file, std::ios::binary);
+        if (!in)
+            return {};
+
+        PipelineCacheFileHeader h = {};
+        if (!in.read(reinterpret_cast<char*>(&h), sizeof(h)))
+            return {};
+
+        const PipelineCacheFileHeader expected = makeHeader(id);
+
+        const bool headerOk = h.magic == expected.magic &&
+                              h.version == expected.version &&
+                              h.vendorID == expected.vendorID &&
+                              h.deviceID == expected.deviceID &&
+                              h.driverVersion == expected.driverVersion &&
+                              std::memcmp(h.deviceUUID, expected.deviceUUID, VK_UUID_SIZE) == 0 &&
+                              std::memcmp(h.pipelineCacheUUID, expected.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+
+        if (!headerOk)
+        {
+            std::cerr << "PipelineCache: " << file.string() << " is for another device/driver; starting empty.\n";
+            return {};
+        }
+
+        // Sanity cap; real caches are a few MB at most.
+        constexpr uint64_t kMaxSize = 512ull * 1024ull * 1024ull;
+        if (h.dataSize == 0 || h.dataSize > kMaxSize)
+            return {};
+
+        std::vector<uint8_t> blob(static_cast<size_t>(h.dataSize));
+        if (!in.read(reinterpret_cast<char*>(blob.data()), static_cast<std::streamsize>(blob.size())))
+            return {};
+
+        if (checksum(blob.data(), blob.size()) != h.dataHash || !driverBlobMatches(blob, id))
+        {
+            std::cerr << "PipelineCache: " << file.string() << " is corrupt; starting empty.\n";
+            return {};
+        }
+
+        return blob;
+    }
+
+} // namespace
+
+namespace vkutil
+{
+    VkPipelineCache loadPipelineCache(VkDevice                     device,
+                                      VkPhysicalDevice             physicalDevice,
+                                      const std::filesystem::path& cacheDir) noexcept
+    {
+        if (!device || !physicalDevice)
+            return VK_NULL_HANDLE;
+
+        const DeviceIdentity id = queryIdentity(physicalDevice);
+
+        std::vector<uint8_t> blob;
+        if (!cacheDir.empty())
+        {
+            try
+            {
+                blob = readValidatedBlob(cacheFilePath(cacheDir, id), id);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "PipelineCache: read failed: " << e.what() << "\n";
+                blob.clear();
+            }
+        }
+
+        VkPipelineCacheCreateInfo ci = {};
+        ci.sType                     = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        ci.initialDataSize           = blob.size();
+        ci.pInitialData              = blob.empty() ? nullptr : blob.data();
+
+        VkPipelineCache cache = VK_NULL_HANDLE;
+        if (vkCreatePipelineCache(device, &ci, nullptr, &cache) == VK_SUCCESS)
+        {
+            if (!blob.empty())
+                std::cerr << "PipelineCache: Loaded " << blob.size() << " bytes.\n";
+            return cache;
+        }
+
+        // The driver refused the data; an empty cache is still worth having.
+        ci.initialDataSize = 0;
+        ci.pInitialData    = nullptr;
+
+        if (vkCreatePipelineCache(device, &ci, nullptr, &cache) != VK_SUCCESS)
+            return VK_NULL_HANDLE;
+
+        return cache;
+    }
+
+    bool savePipelineCache(VkDevice                     device,
+                           VkPhysicalDevice             physicalDevice,
+                           VkPipelineCache              cache,
+                           const std::filesystem::path& cacheDir) noexcept
+    {
+        if (!device || !physicalDevice || cache == VK_NULL_HANDLE || cacheDir.empty())
+            return false;
+
+        size_t size = 0;
+        if (vkGetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS || size == 0)
+            return false;
+
+        std::vector<uint8_t> blob(size);
+        if (vkGetPipelineCacheData(device, cache, &size, blob.data()) != VK_SUCCESS)
+            return false;
+
+        blob.resize(size);
+
+        const DeviceIdentity id = queryIdentity(physicalDevice);
+
+        PipelineCacheFileHeader h = makeHeader(id);
+        h.dataSize                = blob.size();
+        h.dataHash                = checksum(blob.data(), blob.size());
+
+        try
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(cacheDir, ec);
+
+            const std::filesystem::path file = cacheFilePath(cacheDir, id);
+            std::filesystem::path       tmp  = file;
+            tmp += ".tmp";
+
+            {
+                std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                if (!out)
+                    return false;
+
+                out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+                out.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+
+                if (!out)
+                    return false;
+            }
+
+            // A crash mid-write leaves only the .tmp behind, never a torn cache file.
+            std::filesystem::rename(tmp, file, ec);
+            if (ec)
+            {
+                std::filesystem::remove(tmp, ec);
+                return false;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "PipelineCache: write failed: " << e.what() << "\n";
+            return false;
+        }
+
+        return true;
+    }
+
+} // namespace vkutil
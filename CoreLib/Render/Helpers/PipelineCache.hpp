@@ -0,0 +1,47 @@
+#pragma once
+
+#include <filesystem>
+#include <vulkan/vulkan.h>
+
+/**
+ * @file PipelineCache.hpp
+ * @brief On-disk persistence for a VkPipelineCache.
+ *
+ * One file per physical device, named after the device UUID, inside a caller
+ * supplied directory (the UI passes the user cache dir).
+ *
+ * File layout:
+ *   PipelineCacheFileHeader | vkGetPipelineCacheData() blob
+ *
+ * The header pins vendor/device IDs, driver version, device UUID and the
+ * driver's pipelineCacheUUID, plus the blob size and checksum. Any mismatch
+ * (driver update, GPU swap, truncated/corrupt file) falls back to an empty
+ * cache; the file is rewritten on the next save.
+ */
+namespace vkutil
+{
+    /**
+     * @brief Create a pipeline cache, seeded from disk when a valid file exists.
+     *
+     * @param device         Logical device.
+     * @param physicalDevice Physical device the cache belongs to.
+     * @param cacheDir       Directory holding cache files (created on save, not here).
+     * @return Cache handle, or VK_NULL_HANDLE if even an empty cache could not be created.
+     */
+    [[nodiscard]] VkPipelineCache loadPipelineCache(VkDevice                     device,
+                                                    VkPhysicalDevice             physicalDevice,
+                                                    const std::filesystem::path& cacheDir) noexcept;
+
+    /**
+     * @brief Write @p cache to disk (temp file + rename).
+     *
+     * Safe to call with VK_NULL_HANDLE (no-op). Does not destroy the cache.
+     *
+     * @return True if the file was written.
+     */
+    bool savePipelineCache(VkDevice                     device,
+                           VkPhysicalDevice             physicalDevice,
+                           VkPipelineCache              cache,
+                           const std::filesystem::path& cacheDir) noexcept;
+
+} // namespace vkutil
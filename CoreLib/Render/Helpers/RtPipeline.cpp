@@ -85,10 +85,17 @@ namespace vkrt
         // ------------------------------------------------------------
         // Pipeline layout (set layouts provided by caller)
         // ------------------------------------------------------------
+        VkPushConstantRange pcRange{};
+        pcRange.stageFlags = VK_SHADER_STAGE_RAYGEN_BIT_KHR | VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
+        pcRange.offset     = 0;
+        pcRange.size       = sizeof(RtPushConstants);
+
         VkPipelineLayoutCreateInfo pl{};
-        pl.sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pl.setLayoutCount = setLayoutCount;
-        pl.pSetLayouts    = setLayouts;
+        pl.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pl.setLayoutCount         = setLayoutCount;
+        pl.pSetLayouts            = setLayouts;
+        pl.pushConstantRangeCount = 1;
+        pl.pPushConstantRanges    = &pcRange;
 
         if (vkCreatePipelineLayout(ctx.device, &pl, nullptr, &m_layout) != VK_SUCCESS)
             return false;
@@ -191,7 +198,7 @@ namespace vkrt
             ctx.rtDispatch->vkCreateRayTracingPipelinesKHR(
                 ctx.device,
                 VK_NULL_HANDLE,
-                VK_NULL_HANDLE,
+                ctx.pipelineCache,
                 1,
                 &ci,
                 nullptr,
@@ -10,11 +10,27 @@ struct VulkanContext;
 
 namespace vkrt
 {
+    /**
+     * @brief Push constants of the scene pipeline (raygen + closest hit).
+     *
+     * sampleIndex counts the frames accumulated since the last reset; the
+     * shaders use it to decorrelate jitter and soft-shadow samples per frame.
+     */
+    struct RtPushConstants
+    {
+        uint32_t sampleIndex = 0;
+        uint32_t _pad0       = 0;
+        uint32_t _pad1       = 0;
+        uint32_t _pad2       = 0;
+    };
+    static_assert(sizeof(RtPushConstants) == 16);
+
     /**
      * @brief Minimal RT pipeline wrapper (scene pipeline only).
      *
      * Creates:
-     *  - VkPipelineLayout (descriptor set layouts provided by caller)
+     *  - VkPipelineLayout (descriptor set layouts provided by caller,
+     *    plus RtPushConstants for raygen + closest hit)
      *  - VkPipeline (raygen + miss + closest hit)
      *
      * Used by SBT build + vkCmdTraceRaysKHR.
@@ -73,7 +73,8 @@ namespace vkrt
     bool RtPresentPipeline::create(VkDevice              device,
                                    VkRenderPass          renderPass,
                                    VkSampleCountFlagBits sampleCount,
-                                   VkDescriptorSetLayout setLayout)
+                                   VkDescriptorSetLayout setLayout,
+                                   VkPipelineCache       cache)
     {
         destroy(device);
 
@@ -191,7 +192,7 @@ namespace vkrt
         gp.subpass             = 0;
 
         if (vkCreateGraphicsPipelines(device,
-                                      VK_NULL_HANDLE,
+                                      cache,
                                       1,
                                       &gp,
                                       nullptr,
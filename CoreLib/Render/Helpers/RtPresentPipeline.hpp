@@ -43,11 +43,13 @@ namespace vkrt
          * @param renderPass   Render pass used for the viewport swapchain.
          * @param sampleCount  MSAA sample count for the swapchain.
          * @param setLayout    Descriptor set layout for the RT set (Set 2).
+         * @param cache        Optional pipeline cache.
          */
         bool create(VkDevice              device,
                     VkRenderPass          renderPass,
                     VkSampleCountFlagBits sampleCount,
-                    VkDescriptorSetLayout setLayout);
+                    VkDescriptorSetLayout setLayout,
+                    VkPipelineCache       cache = VK_NULL_HANDLE);
 
         [[nodiscard]] VkPipeline pipeline() const noexcept
         {
@@ -1,8 +1,11 @@
 #include "VkPipelineHelpers.hpp"
 
+#include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <future>
 #include <iostream>
+#include <system_error>
 
 #include "ShaderStage.hpp"
 
@@ -77,6 +80,40 @@ namespace vkutil
         vi.pVertexAttributeDescriptions    = attrs;
     }
 
+    void makeSolidIndirectVertexInput(VkPipelineVertexInputStateCreateInfo& vi,
+                                      VkVertexInputBindingDescription (&bindings)[5],
+                                      VkVertexInputAttributeDescription (&attrs)[8])
+    {
+        VkVertexInputBindingDescription   solidBindings[4] = {};
+        VkVertexInputAttributeDescription solidAttrs[4]    = {};
+        makeSolidVertexInput(vi, solidBindings, solidAttrs);
+
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            bindings[i] = solidBindings[i];
+            attrs[i]    = solidAttrs[i];
+        }
+
+        // Binding 4: model matrix, advanced once per instance
+        bindings[4].binding   = 4;
+        bindings[4].stride    = sizeof(glm::mat4);
+        bindings[4].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+        // locations 4..7: model matrix columns
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            attrs[4 + c].location = 4 + c;
+            attrs[4 + c].binding  = 4;
+            attrs[4 + c].format   = VK_FORMAT_R32G32B32A32_SFLOAT;
+            attrs[4 + c].offset   = c * static_cast<uint32_t>(sizeof(glm::vec4));
+        }
+
+        vi.vertexBindingDescriptionCount   = 5;
+        vi.pVertexBindingDescriptions      = bindings;
+        vi.vertexAttributeDescriptionCount = 8;
+        vi.pVertexAttributeDescriptions    = attrs;
+    }
+
     void makeLineVertexInput(VkPipelineVertexInputStateCreateInfo& vi,
                              VkVertexInputBindingDescription&      binding,
                              VkVertexInputAttributeDescription&    attr)
@@ -227,9 +264,54 @@ namespace vkutil
         desc.depthStencil  = &ds;
         desc.colorBlend    = &cb;
         desc.dynamicState  = &dyn;
+        desc.cache         = ctx.pipelineCache;
 
         // Create the pipeline now, while all pointers are valid
         return vkutil::createGraphicsPipeline(ctx.device, desc);
     }
 
+    bool buildPipelinesParallel(const std::vector<PipelineJob>& jobs)
+    {
+        std::vector<std::future<bool>> pending;
+        pending.reserve(jobs.size());
+
+        for (const PipelineJob& job : jobs)
+        {
+            try
+            {
+                pending.push_back(std::async(std::launch::async, job.build));
+            }
+            catch (const std::system_error&)
+            {
+                // No thread available: build inline.
+                std::promise<bool> inlineResult;
+                inlineResult.set_value(job.build ? job.build() : false);
+                pending.push_back(inlineResult.get_future());
+            }
+        }
+
+        bool ok = true;
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            bool built = false;
+            try
+            {
+                built = pending[i].get();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "vkutil: " << jobs[i].name << " threw: " << e.what() << "\n";
+            }
+
+            if (built)
+                continue;
+
+            std::cerr << "vkutil: " << jobs[i].name << " failed" << (jobs[i].optional ? " (optional).\n" : ".\n");
+            if (!jobs[i].optional)
+                ok = false;
+        }
+
+        return ok;
+    }
+
 } // namespace vkutil
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
+#include <vector>
 #include <vulkan/vulkan.h>
 
 #include "VkUtilities.hpp"
@@ -25,6 +27,11 @@ namespace vkutil
                               VkVertexInputBindingDescription (&bindings)[4],
                               VkVertexInputAttributeDescription (&attrs)[4]);
 
+    /// Solid layout plus binding 4: per-instance mat4 model (locations 4..7).
+    void makeSolidIndirectVertexInput(VkPipelineVertexInputStateCreateInfo& vi,
+                                      VkVertexInputBindingDescription (&bindings)[5],
+                                      VkVertexInputAttributeDescription (&attrs)[8]);
+
     void makeLineVertexInput(VkPipelineVertexInputStateCreateInfo& vi,
                              VkVertexInputBindingDescription&      binding,
                              VkVertexInputAttributeDescription&    attr);
@@ -75,4 +82,32 @@ namespace vkutil
                                   const VkPipelineVertexInputStateCreateInfo* vertexInput,
                                   const MeshPipelinePreset&                   preset);
 
+    // ---------------------------------------------------------
+    // Parallel pipeline creation
+    // ---------------------------------------------------------
+
+    /**
+     * @brief One independent pipeline build.
+     *
+     * @c build must only touch its own output and state that outlives
+     * buildPipelinesParallel() (vertex input structs, presets, shader stages).
+     */
+    struct PipelineJob
+    {
+        const char*           name     = "";
+        std::function<bool()> build    = {};
+        bool                  optional = false; ///< Failure is reported but not fatal.
+    };
+
+    /**
+     * @brief Run @p jobs concurrently and wait for all of them.
+     *
+     * Pipeline creation is thread safe per the spec (the shared VkPipelineCache
+     * is internally synchronized), so driver compiles overlap. Failures are
+     * logged after the join, in job order.
+     *
+     * @return False if any non-optional job failed.
+     */
+    bool buildPipelinesParallel(const std::vector<PipelineJob>& jobs);
+
 } // namespace vkutil
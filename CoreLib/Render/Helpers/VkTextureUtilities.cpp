@@ -164,6 +164,17 @@ namespace vkutil
         if (!otc.cmd)
             return;
 
+        generateMipmaps(otc.cmd, image, width, height, mipLevels);
+
+        submitTransientCmd(otc);
+    }
+
+    void generateMipmaps(VkCommandBuffer cmd,
+                         VkImage         image,
+                         int32_t         width,
+                         int32_t         height,
+                         uint32_t        mipLevels)
+    {
         VkImageMemoryBarrier barrier{};
         barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
         barrier.image                           = image;
@@ -185,7 +196,7 @@ namespace vkutil
             barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
             barrier.dstAccessMask                 = VK_ACCESS_TRANSFER_READ_BIT;
 
-            vkCmdPipelineBarrier(otc.cmd,
+            vkCmdPipelineBarrier(cmd,
                                  VK_PIPELINE_STAGE_TRANSFER_BIT,
                                  VK_PIPELINE_STAGE_TRANSFER_BIT,
                                  0,
@@ -214,7 +225,7 @@ namespace vkutil
             blit.dstSubresource.baseArrayLayer = 0;
             blit.dstSubresource.layerCount     = 1;
 
-            vkCmdBlitImage(otc.cmd,
+            vkCmdBlitImage(cmd,
                            image,
                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
                            image,
@@ -228,7 +239,7 @@ namespace vkutil
             barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
             barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
-            vkCmdPipelineBarrier(otc.cmd,
+            vkCmdPipelineBarrier(cmd,
                                  VK_PIPELINE_STAGE_TRANSFER_BIT,
                                  VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
                                  0,
@@ -252,7 +263,7 @@ namespace vkutil
         barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
         barrier.dstAccessMask                 = VK_ACCESS_SHADER_READ_BIT;
 
-        vkCmdPipelineBarrier(otc.cmd,
+        vkCmdPipelineBarrier(cmd,
                              VK_PIPELINE_STAGE_TRANSFER_BIT,
                              VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
                              0,
@@ -262,8 +273,6 @@ namespace vkutil
                              nullptr,
                              1,
                              &barrier);
-
-        submitTransientCmd(otc);
     }
 
 } // namespace vkutil
@@ -54,4 +54,12 @@ namespace vkutil
                          int32_t              height,
                          uint32_t             mipLevels);
 
+    /// Same as above, recorded into @p cmd (for batched uploads).
+    /// Expects every level in TRANSFER_DST_OPTIMAL; leaves them SHADER_READ_ONLY_OPTIMAL.
+    void generateMipmaps(VkCommandBuffer cmd,
+                         VkImage         image,
+                         int32_t         width,
+                         int32_t         height,
+                         uint32_t        mipLevels);
+
 } // namespace vkutil
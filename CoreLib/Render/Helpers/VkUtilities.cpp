@@ -309,6 +309,25 @@ namespace vkutil
                              nullptr);
     }
 
+    void barrierComputeToGraphicsShaderRead(VkCommandBuffer cmd)
+    {
+        VkMemoryBarrier mb = {};
+        mb.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        mb.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+        mb.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0,
+                             1,
+                             &mb,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+    }
+
     void barrierTransferToRtShaderRead(VkCommandBuffer cmd)
     {
         VkMemoryBarrier mb = {};
@@ -328,6 +347,25 @@ namespace vkutil
                              nullptr);
     }
 
+    void barrierTraceToAsUpdate(VkCommandBuffer cmd)
+    {
+        VkMemoryBarrier mb = {};
+        mb.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        mb.srcAccessMask   = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        mb.dstAccessMask   = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                             VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                             0,
+                             1,
+                             &mb,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+    }
+
     // --------------------------------------------------------------------------
     // NEW: Transfer-write -> AS build read (build input buffers)
     //
@@ -782,7 +820,7 @@ namespace vkutil
 
         VkPipeline pipeline = VK_NULL_HANDLE;
         if (vkCreateGraphicsPipelines(device,
-                                      VK_NULL_HANDLE,
+                                      d.cache,
                                       1,
                                       &ci,
                                       nullptr,
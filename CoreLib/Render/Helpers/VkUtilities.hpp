@@ -104,6 +104,9 @@ namespace vkutil
     /// Transfer-write -> ray tracing shader read (SSBO read in RT pipeline)
     void barrierTransferToRtShaderRead(VkCommandBuffer cmd);
 
+    /// Compute-write -> graphics shader read (SSBO produced by a compute pre-pass)
+    void barrierComputeToGraphicsShaderRead(VkCommandBuffer cmd);
+
     /**
      * @brief Transfer-write -> acceleration structure build read (AS build inputs).
      *
@@ -120,6 +123,9 @@ namespace vkutil
     /// AS build writes -> RT shader reads (TLAS/BLAS visibility for trace rays)
     void barrierAsBuildToTrace(VkCommandBuffer cmd);
 
+    /// Earlier trace rays / AS builds -> AS update (refitting a BLAS in place that earlier work still reads)
+    void barrierTraceToAsUpdate(VkCommandBuffer cmd);
+
     // ============================================================================
     // Device address helpers
     // ============================================================================
@@ -211,6 +217,8 @@ namespace vkutil
         const VkPipelineDepthStencilStateCreateInfo*  depthStencil  = nullptr;
         const VkPipelineColorBlendStateCreateInfo*    colorBlend    = nullptr;
         const VkPipelineDynamicStateCreateInfo*       dynamicState  = nullptr;
+
+        VkPipelineCache cache = VK_NULL_HANDLE; ///< optional, usually VulkanContext::pipelineCache
     };
 
     VkPipeline createGraphicsPipeline(VkDevice device, const GraphicsPipelineDesc& desc);
@@ -216,7 +216,7 @@ bool RtDenoiser::initDevice(const VulkanContext& ctx, VkFormat colorFormat)
         cpci.stage  = comp.stageInfo();
         cpci.layout = m_filterPipelineLayout;
 
-        if (vkCreateComputePipelines(m_ctx.device, VK_NULL_HANDLE, 1, &cpci, nullptr, &m_filterPipeline) != VK_SUCCESS)
+        if (vkCreateComputePipelines(m_ctx.device, m_ctx.pipelineCache, 1, &cpci, nullptr, &m_filterPipeline) != VK_SUCCESS)
         {
             std::cerr << "RtDenoiser: failed to create filter pipeline.\n";
             return false;
@@ -240,7 +240,7 @@ bool RtDenoiser::initDevice(const VulkanContext& ctx, VkFormat colorFormat)
         cpci.stage  = comp.stageInfo();
         cpci.layout = m_copyPipelineLayout;
 
-        if (vkCreateComputePipelines(m_ctx.device, VK_NULL_HANDLE, 1, &cpci, nullptr, &m_copyPipeline) != VK_SUCCESS)
+        if (vkCreateComputePipelines(m_ctx.device, m_ctx.pipelineCache, 1, &cpci, nullptr, &m_copyPipeline) != VK_SUCCESS)
         {
             std::cerr << "RtDenoiser: failed to create copy pipeline.\n";
             return false;
@@ -302,6 +302,16 @@ void RtDenoiser::shutdown() noexcept
     m_colorFormat    = VK_FORMAT_UNDEFINED;
 }
 
+void RtDenoiser::releaseViewport(Viewport* vp) noexcept
+{
+    auto it = m_viewports.find(vp);
+    if (it == m_viewports.end())
+        return;
+
+    it->second.destroyDeviceResources(m_framesInFlight);
+    m_viewports.erase(it);
+}
+
 // =========================================================
 // ensureViewportState
 // =========================================================
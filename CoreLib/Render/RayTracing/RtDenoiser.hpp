@@ -41,6 +41,9 @@ public:
     [[nodiscard]] VkImageView outputView(Viewport* vp, uint32_t frameIndex) const noexcept;
     [[nodiscard]] VkImage     outputImage(Viewport* vp, uint32_t frameIndex) const noexcept;
 
+    /// Destroy @p vp's filter images and sets (caller guarantees the GPU is idle).
+    void releaseViewport(Viewport* vp) noexcept;
+
 private:
     struct ViewportState
     {
@@ -5,6 +5,7 @@
 #include <SysMesh.hpp>
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
 #include <iostream>
 #include <vector>
@@ -15,9 +16,47 @@
 #include "RtSbt.hpp"
 #include "Scene.hpp"
 #include "SceneMesh.hpp"
+#include "TextureHandler.hpp"
 #include "Viewport.hpp"
 #include "VkUtilities.hpp"
 
+namespace
+{
+    void hashMix(uint64_t& key, uint64_t v) noexcept
+    {
+        key ^= (v + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2));
+    }
+
+    // Everything that invalidates accumulated radiance: camera, output size,
+    // background, and any scene change (meshes, materials, lights, lighting
+    // settings) or newly streamed texture levels.
+    uint64_t accumulationKey(Viewport* vp, Scene* scene, uint32_t w, uint32_t h) noexcept
+    {
+        uint64_t key = (uint64_t(w) << 32) | uint64_t(h);
+
+        for (const glm::mat4* m : {&vp->view(), &vp->projection()})
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                for (int r = 0; r < 4; ++r)
+                    hashMix(key, std::bit_cast<uint32_t>((*m)[c][r]));
+            }
+        }
+
+        const glm::vec4 clear = vp->clearColor();
+        for (int i = 0; i < 4; ++i)
+            hashMix(key, std::bit_cast<uint32_t>(clear[i]));
+
+        if (scene->changeCounter())
+            hashMix(key, scene->changeCounter()->value());
+
+        if (scene->textureHandler())
+            hashMix(key, scene->textureHandler()->version());
+
+        return key;
+    }
+} // namespace
+
 RtRenderer::RtRenderer() noexcept
     : m_tlasChangeCounter(std::make_shared<SysCounter>()),
       m_tlasChangeMonitor(m_tlasChangeCounter)
@@ -51,6 +90,10 @@ void RtRenderer::RtViewportState::destroyDeviceResources(uint32_t framesInFlight
     normalImage.destroy();
     depthImage.destroy();
     albedoImage.destroy();
+    accumImage.destroy();
+
+    accumKey     = 0;
+    accumSamples = 0;
 
     cachedW = 0;
     cachedH = 0;
@@ -74,7 +117,7 @@ bool RtRenderer::initDevice(const VulkanContext&  ctx,
 
     m_framesInFlight = std::max(1u, std::min(ctx.framesInFlight, vkcfg::kMaxFramesInFlight));
 
-    DescriptorBindingInfo bindings[7]{};
+    DescriptorBindingInfo bindings[8]{};
 
     bindings[0].binding = 0;
     bindings[0].type    = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
@@ -111,8 +154,13 @@ bool RtRenderer::initDevice(const VulkanContext&  ctx,
     bindings[6].stages  = VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR | VK_SHADER_STAGE_MISS_BIT_KHR;
     bindings[6].count   = 1;
 
+    bindings[7].binding = 7;
+    bindings[7].type    = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    bindings[7].stages  = VK_SHADER_STAGE_RAYGEN_BIT_KHR;
+    bindings[7].count   = 1;
+
     m_rtSetLayout.destroy();
-    if (!m_rtSetLayout.create(m_ctx.device, std::span{bindings, 7}))
+    if (!m_rtSetLayout.create(m_ctx.device, std::span{bindings, 8}))
     {
         std::cerr << "RtRenderer: Failed to create RT DescriptorSetLayout.\n";
         return false;
@@ -122,7 +170,7 @@ bool RtRenderer::initDevice(const VulkanContext&  ctx,
     const uint32_t     setCount      = m_framesInFlight * kMaxViewports * 2u;
 
     std::array<VkDescriptorPoolSize, 4> poolSizes = {
-        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, setCount * 4u},
+        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, setCount * 5u},
         VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, setCount},
         VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, setCount},
         VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, setCount},
@@ -238,6 +286,18 @@ void RtRenderer::shutdown() noexcept
     m_framesInFlight = 1;
 }
 
+void RtRenderer::releaseViewport(Viewport* vp) noexcept
+{
+    m_denoiser.releaseViewport(vp);
+
+    auto it = m_viewports.find(vp);
+    if (it == m_viewports.end())
+        return;
+
+    it->second.destroyDeviceResources(m_framesInFlight);
+    m_viewports.erase(it);
+}
+
 // =========================================================
 // initSwapchain / destroySwapchainResources
 // =========================================================
@@ -258,7 +318,7 @@ bool RtRenderer::initSwapchain(VkRenderPass renderPass)
         return false;
     }
 
-    if (!m_rtPresent.create(m_ctx.device, renderPass, m_ctx.sampleCount, m_rtSetLayout.layout()))
+    if (!m_rtPresent.create(m_ctx.device, renderPass, m_ctx.sampleCount, m_rtSetLayout.layout(), m_ctx.pipelineCache))
     {
         std::cerr << "RtRenderer: RtPresentPipeline::create() failed.\n";
         return false;
@@ -360,6 +420,8 @@ bool RtRenderer::ensureRtOutputImages(RtViewportState&          s,
         return false;
     if (!s.albedoImage.ensure(m_ctx.device, m_ctx.physicalDevice, w, h, m_rtAlbedoFormat, kRtUsage, fc))
         return false;
+    if (!s.accumImage.ensure(m_ctx.device, m_ctx.physicalDevice, w, h, m_rtAccumFormat, VK_IMAGE_USAGE_STORAGE_BIT, fc))
+        return false;
 
     s.cachedW = w;
     s.cachedH = h;
@@ -387,6 +449,8 @@ void RtRenderer::writeRtImageDescriptors(RtViewportState& s, uint32_t frameIndex
         s.rtSets[frameIndex].writeStorageImage(m_ctx.device, 5, s.depthImage.view(), VK_IMAGE_LAYOUT_GENERAL);
     if (s.albedoImage.view())
         s.rtSets[frameIndex].writeStorageImage(m_ctx.device, 6, s.albedoImage.view(), VK_IMAGE_LAYOUT_GENERAL);
+    if (s.accumImage.view())
+        s.rtSets[frameIndex].writeStorageImage(m_ctx.device, 7, s.accumImage.view(), VK_IMAGE_LAYOUT_GENERAL);
 }
 
 // =========================================================
@@ -627,18 +691,33 @@ void RtRenderer::recordTraceRays(Viewport*                 vp,
     if (!ensureRtOutputImages(rtv, fc, w, h))
         return;
 
+    const uint64_t accumKey = accumulationKey(vp, scene, w, h);
+    if (accumKey != rtv.accumKey)
+    {
+        rtv.accumKey     = accumKey;
+        rtv.accumSamples = 0;
+    }
+
+    // Converged: nothing changed since the target was reached, so the last
+    // present descriptors (accumulated + denoised image) stay valid.
+    if (rtv.accumSamples >= kAccumTargetFrames && rtv.presentDescriptorReady[frameIdx])
+        return;
+
     // Process any pending BLAS compactions before building TLAS.
     // Results from the previous frame's queries are now available.
     processCompactionQueue(fc);
 
+    ++m_blasFrame;
+
     writeRtImageDescriptors(rtv, frameIdx);
 
     VulkanImage& radiance = rtv.radianceImage;
     VulkanImage& normal   = rtv.normalImage;
     VulkanImage& depth    = rtv.depthImage;
     VulkanImage& albedo   = rtv.albedoImage;
+    VulkanImage& accum    = rtv.accumImage;
 
-    if (!radiance.valid() || !normal.valid() || !depth.valid() || !albedo.valid())
+    if (!radiance.valid() || !normal.valid() || !depth.valid() || !albedo.valid() || !accum.valid())
         return;
 
     if (rtv.rtSets[frameIdx].set() == VK_NULL_HANDLE)
@@ -653,6 +732,10 @@ void RtRenderer::recordTraceRays(Viewport*                 vp,
         vkCmdClearColorImage(fc.cmd, img->image(), VK_IMAGE_LAYOUT_GENERAL, &clearBlack, 1, &fullRange);
     }
 
+    // Not cleared: raygen ignores its contents when sampleIndex == 0. The
+    // transition also orders last frame's writes before this frame's reads.
+    accum.transitionToGeneral(fc.cmd);
+
     for (SceneMesh* sm : scene->sceneMeshes())
     {
         if (!sm || !sm->visible())
@@ -669,11 +752,14 @@ void RtRenderer::recordTraceRays(Viewport*                 vp,
         (void)ensureMeshBlas(vp, sm, geo, fc);
     }
 
-    if (!ensureSceneTlas(vp, scene, fc))
-        return;
-
-    if (frameIdx >= m_tlasFrames.size() || m_tlasFrames[frameIdx].as == VK_NULL_HANDLE)
+    // Nothing to trace (e.g. empty scene): treat as converged so idle frames
+    // are not requested until the accumulation key changes.
+    if (!ensureSceneTlas(vp, scene, fc) ||
+        frameIdx >= m_tlasFrames.size() || m_tlasFrames[frameIdx].as == VK_NULL_HANDLE)
+    {
+        rtv.accumSamples = kAccumTargetFrames;
         return;
+    }
 
     writeRtTlasDescriptor(rtv, frameIdx);
 
@@ -743,10 +829,21 @@ void RtRenderer::recordTraceRays(Viewport*                 vp,
                             0,
                             nullptr);
 
+    vkrt::RtPushConstants pc{};
+    pc.sampleIndex = rtv.accumSamples;
+    vkCmdPushConstants(fc.cmd,
+                       m_rtPipeline.layout(),
+                       VK_SHADER_STAGE_RAYGEN_BIT_KHR | VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR,
+                       0,
+                       sizeof(pc),
+                       &pc);
+
     VkStridedDeviceAddressRegionKHR rgen{}, miss{}, hit{}, call{};
     m_rtSbt.regions(m_ctx, rgen, miss, hit, call);
     m_ctx.rtDispatch->vkCmdTraceRaysKHR(fc.cmd, &rgen, &miss, &hit, &call, w, h, 1);
 
+    ++rtv.accumSamples;
+
     for (VulkanImage* img : {&radiance, &normal, &depth, &albedo})
         img->transitionToShaderRead(fc.cmd);
 
@@ -792,6 +889,21 @@ void RtRenderer::renderPrePass(Viewport*                 vp,
     recordTraceRays(vp, scene, fc, set0FrameGlobals, set1Materials);
 }
 
+// =========================================================
+// isAccumulating
+// =========================================================
+
+bool RtRenderer::isAccumulating() const noexcept
+{
+    for (const auto& [vp, st] : m_viewports)
+    {
+        if (vp && vp->drawMode() == DrawMode::RAY_TRACE && st.accumSamples < kAccumTargetFrames)
+            return true;
+    }
+
+    return false;
+}
+
 // =========================================================
 // present
 // =========================================================
@@ -1002,7 +1114,14 @@ void RtRenderer::destroyAllRtBlas() noexcept
 }
 
 // =========================================================
-// ensureMeshBlas  — builds with ALLOW_COMPACTION, writes size query
+// ensureMeshBlas
+//
+// Static meshes get a PREFER_FAST_TRACE build with ALLOW_COMPACTION
+// and a compacted size query. Once a mesh deforms it is rebuilt as
+// Refittable (ALLOW_UPDATE | PREFER_FAST_BUILD); further deform-only
+// changes refit it in place, with a fresh rebuild every
+// kMaxBlasRefits refits. After kBlasIdleFrames without edits it gets
+// a final static build, which then compacts as usual.
 // =========================================================
 
 bool RtRenderer::ensureMeshBlas(Viewport*                           vp,
@@ -1024,23 +1143,48 @@ bool RtRenderer::ensureMeshBlas(Viewport*                           vp,
     key ^= uint64_t(geo.buildPosCount);
     key ^= (uint64_t(geo.buildIndexCount) << 32);
 
+    uint64_t shapeKey = key;
+
     if (sm->sysMesh())
     {
         uint64_t topo   = sm->sysMesh()->topology_counter() ? sm->sysMesh()->topology_counter()->value() : 0ull;
         uint64_t deform = sm->sysMesh()->deform_counter() ? sm->sysMesh()->deform_counter()->value() : 0ull;
         key ^= (topo + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2));
+        shapeKey = key;
         key ^= (deform + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2));
     }
 
     RtBlas& b = m_blas[sm];
 
-    // Already built and compaction is done (or in progress) — skip rebuild
-    if (b.as != VK_NULL_HANDLE && b.buildKey == key &&
-        (b.state == BlasState::Compacted || b.state == BlasState::BuiltUncompacted))
-        return true;
+    const bool built      = b.as != VK_NULL_HANDLE && b.state != BlasState::Empty;
+    const bool refittable = built && b.state == BlasState::Refittable;
+
+    bool editing = false; // build as Refittable
+    bool refit   = false; // update b.as in place
+
+    if (built && b.buildKey == key)
+    {
+        // Unchanged. A Refittable BLAS gets its final build once the mesh has settled.
+        if (!refittable || m_blasFrame - b.lastEditFrame < kBlasIdleFrames)
+            return true;
+    }
+    else if (built && b.shapeKey == shapeKey)
+    {
+        // Deform-only change (vertex drag, sculpt, pose).
+        editing = true;
+        refit   = refittable && b.refitCount < kMaxBlasRefits;
+    }
+    else
+    {
+        // Topology change: stay refittable if it happens mid-interaction.
+        editing = refittable;
+    }
+
+    if (editing)
+        b.lastEditFrame = m_blasFrame;
 
     // Needs rebuild — destroy existing resources first
-    if (b.as != VK_NULL_HANDLE || b.asBuffer.valid())
+    if (!refit && (b.as != VK_NULL_HANDLE || b.asBuffer.valid()))
     {
         if (b.queryPool != VK_NULL_HANDLE)
         {
@@ -1081,9 +1225,12 @@ bool RtRenderer::ensureMeshBlas(Viewport*                           vp,
         }
     }
 
-    b.address  = 0;
-    b.buildKey = 0;
-    b.state    = BlasState::Empty;
+    if (!refit)
+    {
+        b.address  = 0;
+        b.buildKey = 0;
+        b.state    = BlasState::Empty;
+    }
 
     const VkDeviceAddress vAdr = vkutil::bufferDeviceAddress(m_ctx.device, geo.buildPosBuffer);
     const VkDeviceAddress iAdr = vkutil::bufferDeviceAddress(m_ctx.device, geo.buildIndexBuffer);
@@ -1113,10 +1260,14 @@ bool RtRenderer::ensureMeshBlas(Viewport*                           vp,
     VkAccelerationStructureBuildGeometryInfoKHR buildInfo{};
     buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
     buildInfo.type  = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-    // Add ALLOW_COMPACTION so the driver writes a compacted size query
-    buildInfo.flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR |
-                      VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
-    buildInfo.mode          = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+    // Static: ALLOW_COMPACTION so the driver writes a compacted size query.
+    // Editing: ALLOW_UPDATE so later deforms can refit (flags must match between build and update).
+    buildInfo.flags = editing ? (VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR |
+                                 VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_BUILD_BIT_KHR)
+                              : (VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR |
+                                 VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR);
+    buildInfo.mode          = refit ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR
+                                    : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
     buildInfo.geometryCount = 1;
     buildInfo.pGeometries   = &asGeom;
 
@@ -1129,32 +1280,37 @@ bool RtRenderer::ensureMeshBlas(Viewport*                           vp,
                                                               &primCount,
                                                               &sizeInfo);
 
-    if (sizeInfo.accelerationStructureSize == 0 || sizeInfo.buildScratchSize == 0)
-        return false;
-
-    b.asBuffer.create(m_ctx.device,
-                      m_ctx.physicalDevice,
-                      sizeInfo.accelerationStructureSize,
-                      VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR |
-                          VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                      false,
-                      true);
+    const VkDeviceSize scratchBytes = refit ? sizeInfo.updateScratchSize : sizeInfo.buildScratchSize;
 
-    if (!b.asBuffer.valid())
+    if (sizeInfo.accelerationStructureSize == 0 || scratchBytes == 0)
         return false;
 
-    VkAccelerationStructureCreateInfoKHR asci{};
-    asci.sType  = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
-    asci.type   = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-    asci.size   = sizeInfo.accelerationStructureSize;
-    asci.buffer = b.asBuffer.buffer();
+    if (!refit)
+    {
+        b.asBuffer.create(m_ctx.device,
+                          m_ctx.physicalDevice,
+                          sizeInfo.accelerationStructureSize,
+                          VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR |
+                              VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                          false,
+                          true);
+
+        if (!b.asBuffer.valid())
+            return false;
 
-    if (m_ctx.rtDispatch->vkCreateAccelerationStructureKHR(m_ctx.device, &asci, nullptr, &b.as) != VK_SUCCESS)
-        return false;
+        VkAccelerationStructureCreateInfoKHR asci{};
+        asci.sType  = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+        asci.type   = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+        asci.size   = sizeInfo.accelerationStructureSize;
+        asci.buffer = b.asBuffer.buffer();
+
+        if (m_ctx.rtDispatch->vkCreateAccelerationStructureKHR(m_ctx.device, &asci, nullptr, &b.as) != VK_SUCCESS)
+            return false;
+    }
 
     RtViewportState& rts = ensureViewportState(vp, fc.frameIndex);
-    if (!ensureRtScratch(rts, fc, sizeInfo.buildScratchSize))
+    if (!ensureRtScratch(rts, fc, scratchBytes))
         return false;
 
     GpuBuffer& scratch = rts.scratchBuffers[fc.frameIndex];
@@ -1173,6 +1329,13 @@ bool RtRenderer::ensureMeshBlas(Viewport*                           vp,
     buildInfo.dstAccelerationStructure  = b.as;
     buildInfo.scratchData.deviceAddress = scratchAdr;
 
+    if (refit)
+    {
+        // In place: frames still in flight may be tracing against b.as.
+        buildInfo.srcAccelerationStructure = b.as;
+        vkutil::barrierTraceToAsUpdate(fc.cmd);
+    }
+
     VkAccelerationStructureBuildRangeInfoKHR range{};
     range.primitiveCount                                      = primCount;
     const VkAccelerationStructureBuildRangeInfoKHR* pRanges[] = {&range};
@@ -1181,31 +1344,45 @@ bool RtRenderer::ensureMeshBlas(Viewport*                           vp,
 
     vkutil::barrierAsBuildToTrace(fc.cmd);
 
-    // Create a query pool for the compacted size and write the query
-    VkQueryPoolCreateInfo qpci{};
-    qpci.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
-    qpci.queryType  = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
-    qpci.queryCount = 1;
+    b.shapeKey = shapeKey;
 
-    if (vkCreateQueryPool(m_ctx.device, &qpci, nullptr, &b.queryPool) == VK_SUCCESS)
+    if (editing)
     {
-        vkCmdResetQueryPool(fc.cmd, b.queryPool, 0, 1);
-
-        m_ctx.rtDispatch->vkCmdWriteAccelerationStructuresPropertiesKHR(
-            fc.cmd,
-            1,
-            &b.as,
-            VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
-            b.queryPool,
-            0);
-
-        b.state = BlasState::BuiltUncompacted;
+        // Compaction waits for the final build once the mesh is idle.
+        b.refitCount = refit ? b.refitCount + 1 : 0;
+        b.state      = BlasState::Refittable;
+        b.buildKey   = key;
+        if (refit)
+            return true;
     }
     else
     {
-        // Query pool creation failed — continue without compaction
-        b.queryPool = VK_NULL_HANDLE;
-        b.state     = BlasState::Compacted; // skip compaction
+        // Create a query pool for the compacted size and write the query
+        VkQueryPoolCreateInfo qpci{};
+        qpci.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        qpci.queryType  = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+        qpci.queryCount = 1;
+
+        if (vkCreateQueryPool(m_ctx.device, &qpci, nullptr, &b.queryPool) == VK_SUCCESS)
+        {
+            vkCmdResetQueryPool(fc.cmd, b.queryPool, 0, 1);
+
+            m_ctx.rtDispatch->vkCmdWriteAccelerationStructuresPropertiesKHR(
+                fc.cmd,
+                1,
+                &b.as,
+                VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+                b.queryPool,
+                0);
+
+            b.state = BlasState::BuiltUncompacted;
+        }
+        else
+        {
+            // Query pool creation failed — continue without compaction
+            b.queryPool = VK_NULL_HANDLE;
+            b.state     = BlasState::Compacted; // skip compaction
+        }
     }
 
     VkAccelerationStructureDeviceAddressInfoKHR addrInfo{};
@@ -59,6 +59,22 @@ public:
     void present(VkCommandBuffer cmd, Viewport* vp, const RenderFrameContext& fc);
     void idle(Scene* scene);
 
+    /// Destroy @p vp's RT images, buffers and denoiser state (caller guarantees the GPU is idle).
+    void releaseViewport(Viewport* vp) noexcept;
+
+    /**
+     * @brief True while a ray-traced viewport has not reached its sample target.
+     *
+     * Frames must keep coming until then; once converged, renderPrePass()
+     * stops tracing and present() keeps showing the accumulated image.
+     */
+    [[nodiscard]] bool isAccumulating() const noexcept;
+
+public:
+    // Frames (of SPP 4 each, see RtScene.rgen) blended into a viewport's
+    // accumulation buffer before tracing stops: 64 * 4 = 256 samples/pixel.
+    static constexpr uint32_t kAccumTargetFrames = 64;
+
 public:
     struct alignas(8) RtInstanceData
     {
@@ -89,6 +105,12 @@ private:
         VulkanImage depthImage    = {};
         VulkanImage albedoImage   = {};
 
+        // Progressive accumulation (RGBA32F running mean, raygen read/write).
+        // Reset whenever accumKey (camera, size, scene and texture state) changes.
+        VulkanImage accumImage   = {};
+        uint64_t    accumKey     = 0;
+        uint32_t    accumSamples = 0; // frames blended into accumImage
+
         std::array<GpuBuffer, vkcfg::kMaxFramesInFlight>    scratchBuffers = {};
         std::array<VkDeviceSize, vkcfg::kMaxFramesInFlight> scratchSizes   = {};
 
@@ -133,17 +155,31 @@ private:
         Empty,            // no AS built yet
         BuiltUncompacted, // built, compacted size query pending
         Compacted,        // compaction done, original destroyed
+        Refittable,       // built with ALLOW_UPDATE while the mesh deforms, not compacted
     };
 
+    // Deform-only changes refit a Refittable BLAS in place; after this many
+    // refits it is rebuilt, since the tree quality degrades with each one.
+    static constexpr uint32_t kMaxBlasRefits = 32;
+
+    // Frames without edits before a Refittable BLAS gets its final
+    // fast-trace build (and then compaction).
+    static constexpr uint64_t kBlasIdleFrames = 30;
+
     struct RtBlas
     {
         VkAccelerationStructureKHR as       = VK_NULL_HANDLE;
         VkDeviceAddress            address  = 0;
         GpuBuffer                  asBuffer = {};
         uint64_t                   buildKey = 0;
+        uint64_t                   shapeKey = 0; // buildKey without the deform counter
 
         BlasState state = BlasState::Empty;
 
+        // Refit support (state == Refittable)
+        uint32_t refitCount    = 0;
+        uint64_t lastEditFrame = 0;
+
         // Compaction support:
         // queryPool holds one AS_COMPACTED_SIZE query per BLAS.
         // queryIndex is the slot within the pool.
@@ -192,6 +228,7 @@ private:
     VkFormat  m_rtNormalFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
     VkFormat  m_rtDepthFormat  = VK_FORMAT_R16G16B16A16_SFLOAT;
     VkFormat  m_rtAlbedoFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+    VkFormat  m_rtAccumFormat  = VK_FORMAT_R32G32B32A32_SFLOAT;
     VkSampler m_rtSampler      = VK_NULL_HANDLE;
 
 private:
@@ -209,6 +246,7 @@ private:
 
     std::unordered_map<SceneMesh*, RtBlas>             m_blas       = {};
     std::array<RtTlasFrame, vkcfg::kMaxFramesInFlight> m_tlasFrames = {};
+    uint64_t                                           m_blasFrame  = 0; // recordTraceRays calls, for BLAS idle detection
 
 private:
     SysCounterPtr                m_tlasChangeCounter;
@@ -4,14 +4,20 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <limits>
+#include <span>
 #include <vector>
 
+#include "Frustum.hpp"
 #include "GpuResources/GpuMaterial.hpp"
 #include "GpuResources/MeshGpuResources.hpp"
 #include "GpuResources/TextureHandler.hpp"
 #include "GridRendererVK.hpp"
+#include "MaterialHandler.hpp"
 #include "RenderGeometry.hpp"
 #include "Scene.hpp"
 #include "SceneMesh.hpp"
@@ -31,7 +37,11 @@ bool Renderer::initDevice(const VulkanContext& ctx)
     m_ctx            = ctx;
     m_framesInFlight = std::clamp(m_ctx.framesInFlight, 1u, vkcfg::kMaxFramesInFlight);
 
-    m_materialCounterPerFrame = {};
+    m_materialCounterPerFrame   = {};
+    m_textureVersionPerFrame    = {};
+    m_materialStructurePerFrame = {};
+    m_materialVersionsPerFrame  = {};
+    m_textureTablePerFrame      = {};
 
     m_viewportUbos.clear();
 
@@ -41,6 +51,14 @@ bool Renderer::initDevice(const VulkanContext& ctx)
     if (!createPipelineLayout())
         return false;
 
+    if (!m_lightClusters.initDevice(m_ctx, m_descriptorSetLayout.layout()))
+    {
+        std::cerr << "LightClusterPass::initDevice() failed.\n";
+        return false;
+    }
+
+    m_meshBatch.init(m_ctx);
+
     m_grid = std::make_unique<GridRendererVK>(&m_ctx);
     m_grid->createDeviceResources();
 
@@ -109,11 +127,35 @@ void Renderer::shutdown() noexcept
             state.lightBuffers[i].destroy();
             state.lightBuffers[i] = {};
 
+            state.lightDataBuffers[i].destroy();
+            state.lightDataBuffers[i] = {};
+
+            state.clusterBuffers[i].destroy();
+            state.clusterBuffers[i] = {};
+
+            state.lightBvhBuffers[i].destroy();
+            state.lightBvhBuffers[i] = {};
+
             state.uboSets[i] = {};
         }
     }
     m_viewportUbos.clear();
 
+    m_lightClusters.shutdown();
+    m_gpuLights.clear();
+    m_lightBvhNodes.clear();
+
+    m_drawList.clear();
+    m_renderStats.clear();
+    m_materialTextures.clear();
+    m_gpuMaterials.clear();
+
+    m_materialVersionsPerFrame = {};
+    m_textureTablePerFrame     = {};
+
+    m_meshBatch.destroy();
+    m_batchItems.clear();
+
     for (uint32_t i = 0; i < m_framesInFlight; ++i)
     {
         if (m_materialBuffers[i].valid())
@@ -166,6 +208,19 @@ void Renderer::waitDeviceIdle() noexcept
     vkDeviceWaitIdle(m_ctx.device);
 }
 
+void Renderer::releaseViewport(Viewport* vp) noexcept
+{
+    // In-flight frames may still read this viewport's buffers.
+    waitDeviceIdle();
+
+    // Descriptor sets stay with the pool (no FREE_DESCRIPTOR_SET_BIT); the
+    // buffers are released here.
+    m_viewportUbos.erase(vp);
+    m_renderStats.erase(vp);
+    m_meshBatch.releaseViewport(vp);
+    m_rt.releaseViewport(vp);
+}
+
 void Renderer::setLightingSettings(const LightingSettings& settings) noexcept
 {
     m_lightingSettings = settings;
@@ -183,6 +238,50 @@ const LightingSettings& Renderer::lightingSettings() const noexcept
 // Shared per-viewport/per-frame globals (set=0)
 //==================================================================
 
+namespace
+{
+    // Upload the lights that differ from @p uploaded (what @p buf already
+    // holds), coalesced into contiguous runs, and record them in @p uploaded.
+    // Returns true if the buffer had to be recreated (contents all written,
+    // descriptor must be rewritten).
+    bool uploadChangedLights(GpuBuffer& buf, const std::vector<GpuLight>& lights, std::vector<GpuLight>& uploaded)
+    {
+        const VkDeviceSize bytes = static_cast<VkDeviceSize>(lights.size() * sizeof(GpuLight));
+
+        if (bytes > buf.size())
+        {
+            buf.upload(lights.data(), bytes);
+            uploaded = lights;
+            return true;
+        }
+
+        const auto same = [&](std::size_t i) {
+            return i < uploaded.size() && std::memcmp(&lights[i], &uploaded[i], sizeof(GpuLight)) == 0;
+        };
+
+        std::size_t i = 0;
+        while (i < lights.size())
+        {
+            if (same(i))
+            {
+                ++i;
+                continue;
+            }
+
+            const std::size_t first = i;
+            while (i < lights.size() && !same(i))
+                ++i;
+
+            buf.upload(&lights[first],
+                       static_cast<VkDeviceSize>((i - first) * sizeof(GpuLight)),
+                       static_cast<VkDeviceSize>(first * sizeof(GpuLight)));
+        }
+
+        uploaded = lights;
+        return false;
+    }
+} // namespace
+
 void Renderer::updateViewportFrameGlobals(Viewport* vp, Scene* scene, uint32_t frameIndex) noexcept
 {
     if (!vp || !scene)
@@ -197,7 +296,8 @@ void Renderer::updateViewportFrameGlobals(Viewport* vp, Scene* scene, uint32_t f
     if (frameIndex >= fi)
         return;
 
-    if (!vpUbo.cameraBuffers[frameIndex].valid() || !vpUbo.lightBuffers[frameIndex].valid())
+    if (!vpUbo.cameraBuffers[frameIndex].valid() || !vpUbo.lightBuffers[frameIndex].valid() ||
+        !vpUbo.lightDataBuffers[frameIndex].valid() || !vpUbo.lightBvhBuffers[frameIndex].valid())
         return;
 
     {
@@ -235,7 +335,50 @@ void Renderer::updateViewportFrameGlobals(Viewport* vp, Scene* scene, uint32_t f
             m_headlight,
             *vp,
             scene,
-            lights);
+            lights,
+            m_gpuLights);
+
+        GpuBuffer& lightData = vpUbo.lightDataBuffers[frameIndex];
+        GpuBuffer& lightBvh  = vpUbo.lightBvhBuffers[frameIndex];
+
+        // Only lights that changed since this frame's buffer was last written
+        // are uploaded (a gizmo drag touches one light, not all of them).
+        std::vector<GpuLight>& uploaded = vpUbo.uploadedLights[frameIndex];
+
+        const bool lightsChanged = uploaded.size() != m_gpuLights.size() ||
+                                   (!m_gpuLights.empty() &&
+                                    std::memcmp(uploaded.data(), m_gpuLights.data(), m_gpuLights.size() * sizeof(GpuLight)) != 0);
+
+        if (lightsChanged && uploadChangedLights(lightData, m_gpuLights, uploaded))
+            vpUbo.uboSets[frameIndex].writeStorageBuffer(m_ctx.device, 2, lightData.buffer(), lightData.size());
+
+        // RT importance-samples point/spot lights through the BVH (rebuilt
+        // only when the lights change); raster culls them per cluster on
+        // the GPU instead.
+        if (vp->drawMode() != DrawMode::RAY_TRACE)
+        {
+            vpUbo.lightBvhNodeCounts[frameIndex] = 0;
+            vpUbo.lightBvhValid[frameIndex]      = false;
+        }
+        else if (lightsChanged || !vpUbo.lightBvhValid[frameIndex])
+        {
+            buildLightBvh(m_gpuLights, lights.dirCount, m_lightBvhNodes);
+
+            const VkDeviceSize bytes = static_cast<VkDeviceSize>(m_lightBvhNodes.size() * sizeof(GpuLightBvhNode));
+            if (bytes > 0)
+            {
+                const bool grow = bytes > lightBvh.size();
+                lightBvh.upload(m_lightBvhNodes.data(), bytes);
+
+                if (grow)
+                    vpUbo.uboSets[frameIndex].writeStorageBuffer(m_ctx.device, 4, lightBvh.buffer(), lightBvh.size());
+            }
+
+            vpUbo.lightBvhNodeCounts[frameIndex] = static_cast<uint32_t>(m_lightBvhNodes.size());
+            vpUbo.lightBvhValid[frameIndex]      = true;
+        }
+
+        lights.bvhNodeCount = vpUbo.lightBvhNodeCounts[frameIndex];
 
         vpUbo.lightBuffers[frameIndex].upload(&lights, sizeof(lights));
     }
@@ -255,28 +398,30 @@ void Renderer::renderPrePass(Viewport* vp, Scene* scene, const RenderFrameContex
 
     const uint32_t frameIdx = fc.frameIndex;
 
-    forEachVisibleMesh(scene, [&](SceneMesh* /*sm*/, MeshGpuResources* gpu) {
+    m_batchItems.clear();
+
+    forEachVisibleMesh(scene, [&](SceneMesh* sm, MeshGpuResources* gpu) {
         gpu->update(fc);
+        m_batchItems.push_back({sm, gpu});
     });
 
+    // Pack after the per-mesh uploads so the arena copies see the new streams.
+    if (batchReady() && vp->drawMode() != DrawMode::RAY_TRACE)
+        m_meshBatch.update(vp, fc, m_batchItems);
+
     updateViewportFrameGlobals(vp, scene, frameIdx);
 
-    if (vp->drawMode() == DrawMode::RAY_TRACE && rtReady(m_ctx))
-    {
-        if (scene->materialHandler() && scene->textureHandler())
-        {
-            const uint64_t matCounter =
-                scene->materialHandler()->changeCounter() ? scene->materialHandler()->changeCounter()->value() : 0ull;
+    // Bin point/spot lights into clusters for ShadedDraw.frag.
+    if (vp->drawMode() == DrawMode::SHADED)
+        m_lightClusters.dispatch(fc.cmd, ensureViewportUboState(vp, frameIdx).uboSets[frameIdx].set());
 
-            if (m_materialCounterPerFrame[frameIdx] != matCounter)
-            {
-                const auto& mats = scene->materialHandler()->materials();
-                uploadMaterialsToGpu(mats, *scene->textureHandler(), frameIdx, fc);
-                updateMaterialTextureTable(*scene->textureHandler(), frameIdx);
+    // Collect finished image decodes and submit/publish async texture uploads.
+    if (scene->textureHandler())
+        scene->textureHandler()->update(vp);
 
-                m_materialCounterPerFrame[frameIdx] = matCounter;
-            }
-        }
+    if (vp->drawMode() == DrawMode::RAY_TRACE && rtReady(m_ctx))
+    {
+        syncMaterials(scene, frameIdx, fc);
 
         ViewportUboState& vpUbo = ensureViewportUboState(vp, frameIdx);
 
@@ -312,6 +457,14 @@ void Renderer::render(Viewport* vp, Scene* scene, const RenderFrameContext& fc)
     const glm::vec4 wireVisibleColor{0.85f, 0.85f, 0.85f, 1.0f};
     const glm::vec4 wireHiddenColor{0.85f, 0.85f, 0.85f, 0.25f};
 
+    // Cull once per viewport; every raster pass below draws from this list.
+    buildDrawList(vp, scene);
+
+    if (vp->drawMode() != DrawMode::WIREFRAME)
+        requestTextureResidency(vp, scene);
+
+    RenderStats& stats = m_renderStats[vp];
+
     // --------------------------------------------------------
     // Update materials BEFORE binding any descriptor sets.
     // Writing a descriptor set while it is already bound in a
@@ -321,21 +474,7 @@ void Renderer::render(Viewport* vp, Scene* scene, const RenderFrameContext& fc)
     if (vp->drawMode() != DrawMode::RAY_TRACE &&
         vp->drawMode() != DrawMode::WIREFRAME)
     {
-        if (scene->materialHandler() && scene->textureHandler())
-        {
-            const uint64_t matCounter =
-                scene->materialHandler()->changeCounter()
-                    ? scene->materialHandler()->changeCounter()->value()
-                    : 0ull;
-
-            if (m_materialCounterPerFrame[frameIdx] != matCounter)
-            {
-                const auto& mats = scene->materialHandler()->materials();
-                uploadMaterialsToGpu(mats, *scene->textureHandler(), frameIdx, fc);
-                updateMaterialTextureTable(*scene->textureHandler(), frameIdx);
-                m_materialCounterPerFrame[frameIdx] = matCounter;
-            }
-        }
+        syncMaterials(scene, frameIdx, fc);
     }
 
     auto bindSet0 = [&]() -> bool {
@@ -391,12 +530,62 @@ void Renderer::render(Viewport* vp, Scene* scene, const RenderFrameContext& fc)
 
     vkutil::setViewportAndScissor(cmd, w, h);
 
+    const auto recordStart = std::chrono::steady_clock::now();
+
+    // Filled triangles: batched meshes first (one indirect draw), then whatever
+    // the batch does not hold through the per-mesh path.
+    auto drawTriangles = [&](const GraphicsPipeline& pipeline, const GraphicsPipeline& batchPipeline) {
+        const bool useBatch = batchReady() && batchPipeline.valid();
+
+        if (useBatch)
+        {
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, batchPipeline.handle());
+            stats.drawCalls += m_meshBatch.draw(cmd, vp, frameIdx, m_drawList);
+        }
+
+        if (!pipeline.valid())
+            return;
+
+        bool pipelineBound = false;
+
+        forEachDrawMesh([&](SceneMesh* sm, MeshGpuResources* gpu) {
+            if (useBatch && m_meshBatch.contains(vp, frameIdx, gpu))
+                return;
+
+            const render::geom::GfxMeshGeometry geo = render::geom::selectGfxGeometry(sm, gpu);
+            if (!geo.valid())
+                return;
+
+            if (!pipelineBound)
+            {
+                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.handle());
+                pipelineBound = true;
+            }
+
+            PushConstants pc{};
+            pc.model = sm->model();
+            pc.color = glm::vec4(0, 0, 0, 1);
+
+            vkCmdPushConstants(cmd,
+                               m_pipelineLayout,
+                               VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_GEOMETRY_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                               0,
+                               sizeof(PushConstants),
+                               &pc);
+
+            VkBuffer     bufs[4] = {geo.posBuffer, geo.nrmBuffer, geo.uvBuffer, geo.matBuffer};
+            VkDeviceSize offs[4] = {0, 0, 0, 0};
+
+            vkCmdBindVertexBuffers(cmd, 0, 4, bufs, offs);
+            vkCmdDraw(cmd, geo.vertexCount, 1, 0, 0);
+            ++stats.drawCalls;
+        });
+    };
+
     if (vp->drawMode() != DrawMode::WIREFRAME)
     {
         const bool isShaded = (vp->drawMode() == DrawMode::SHADED);
 
-        VkPipeline triPipe = isShaded ? m_shadedPipeline.handle() : m_solidPipeline.handle();
-
         // Bind set=1 (materials + texture table).
         // The material data was already uploaded at the top of this
         // function before any descriptor sets were bound.
@@ -412,40 +601,17 @@ void Renderer::render(Viewport* vp, Scene* scene, const RenderFrameContext& fc)
                                     nullptr);
         }
 
-        if (triPipe != VK_NULL_HANDLE)
-        {
-            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, triPipe);
-
-            forEachVisibleMesh(scene, [&](SceneMesh* sm, MeshGpuResources* gpu) {
-                PushConstants pc{};
-                pc.model = sm->model();
-                pc.color = glm::vec4(0, 0, 0, 1);
-
-                vkCmdPushConstants(cmd,
-                                   m_pipelineLayout,
-                                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_GEOMETRY_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                                   0,
-                                   sizeof(PushConstants),
-                                   &pc);
-
-                const render::geom::GfxMeshGeometry geo = render::geom::selectGfxGeometry(sm, gpu);
-                if (!geo.valid())
-                    return;
-
-                VkBuffer     bufs[4] = {geo.posBuffer, geo.nrmBuffer, geo.uvBuffer, geo.matBuffer};
-                VkDeviceSize offs[4] = {0, 0, 0, 0};
-
-                vkCmdBindVertexBuffers(cmd, 0, 4, bufs, offs);
-                vkCmdDraw(cmd, geo.vertexCount, 1, 0, 0);
-            });
-        }
+        if (isShaded)
+            drawTriangles(m_shadedPipeline, m_shadedIndirectPipeline);
+        else
+            drawTriangles(m_solidPipeline, m_solidIndirectPipeline);
 
         constexpr bool drawEdgesInSolid = true;
         if (!isShaded && drawEdgesInSolid && m_wireOverlayPipeline.valid())
         {
             vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_wireOverlayPipeline.handle());
 
-            forEachVisibleMesh(scene, [&](SceneMesh* sm, MeshGpuResources* gpu) {
+            forEachDrawMesh([&](SceneMesh* sm, MeshGpuResources* gpu) {
                 const bool useSubdiv = (sm->subdivisionLevel() > 0);
 
                 PushConstants pc{};
@@ -467,38 +633,13 @@ void Renderer::render(Viewport* vp, Scene* scene, const RenderFrameContext& fc)
                 vkCmdBindVertexBuffers(cmd, 0, 1, &wgeo.posVb, &voff);
                 vkCmdBindIndexBuffer(cmd, wgeo.idxIb, 0, wgeo.idxType);
                 vkCmdDrawIndexed(cmd, wgeo.idxCount, 1, 0, 0, 0);
+                ++stats.drawCalls;
             });
         }
     }
     else
     {
-        if (m_depthOnlyPipeline.valid())
-        {
-            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_depthOnlyPipeline.handle());
-
-            forEachVisibleMesh(scene, [&](SceneMesh* sm, MeshGpuResources* gpu) {
-                PushConstants pc{};
-                pc.model = sm->model();
-                pc.color = glm::vec4(0, 0, 0, 0);
-
-                vkCmdPushConstants(cmd,
-                                   m_pipelineLayout,
-                                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_GEOMETRY_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                                   0,
-                                   sizeof(PushConstants),
-                                   &pc);
-
-                const render::geom::GfxMeshGeometry geo = render::geom::selectGfxGeometry(sm, gpu);
-                if (!geo.valid())
-                    return;
-
-                VkBuffer     bufs[4] = {geo.posBuffer, geo.nrmBuffer, geo.uvBuffer, geo.matBuffer};
-                VkDeviceSize offs[4] = {0, 0, 0, 0};
-
-                vkCmdBindVertexBuffers(cmd, 0, 4, bufs, offs);
-                vkCmdDraw(cmd, geo.vertexCount, 1, 0, 0);
-            });
-        }
+        drawTriangles(m_depthOnlyPipeline, m_depthOnlyIndirectPipeline);
 
         auto drawEdges = [&](const GraphicsPipeline& pipeline, const glm::vec4& color) {
             if (!pipeline.valid())
@@ -506,7 +647,7 @@ void Renderer::render(Viewport* vp, Scene* scene, const RenderFrameContext& fc)
 
             vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.handle());
 
-            forEachVisibleMesh(scene, [&](SceneMesh* sm, MeshGpuResources* gpu) {
+            forEachDrawMesh([&](SceneMesh* sm, MeshGpuResources* gpu) {
                 const bool useSubdiv = (sm->subdivisionLevel() > 0);
 
                 PushConstants pc{};
@@ -528,6 +669,7 @@ void Renderer::render(Viewport* vp, Scene* scene, const RenderFrameContext& fc)
                 vkCmdBindVertexBuffers(cmd, 0, 1, &wgeo.posVb, &voff);
                 vkCmdBindIndexBuffer(cmd, wgeo.idxIb, 0, wgeo.idxType);
                 vkCmdDrawIndexed(cmd, wgeo.idxCount, 1, 0, 0, 0);
+                ++stats.drawCalls;
             });
         };
 
@@ -535,6 +677,8 @@ void Renderer::render(Viewport* vp, Scene* scene, const RenderFrameContext& fc)
         drawEdges(m_wirePipeline, wireVisibleColor);
     }
 
+    stats.recordMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - recordStart).count();
+
     drawSelection(cmd, vp, scene);
 
     if (scene->showSceneGrid())
@@ -840,7 +984,7 @@ void Renderer::drawSelection(VkCommandBuffer cmd, Viewport* vp, Scene* scene)
 
     const SelectionMode mode = scene->selectionMode();
 
-    forEachVisibleMesh(scene, [&](SceneMesh* sm, MeshGpuResources* gpu) {
+    forEachDrawMesh([&](SceneMesh* sm, MeshGpuResources* gpu) {
         const bool useSubdiv = (sm->subdivisionLevel() > 0);
 
         const render::geom::SelDrawGeo geo =
@@ -859,6 +1003,111 @@ void Renderer::drawSelection(VkCommandBuffer cmd, Viewport* vp, Scene* scene)
     vkCmdSetDepthBias(cmd, 0.0f, 0.0f, 0.0f);
 }
 
+//==================================================================
+// Frustum culling
+//==================================================================
+
+void Renderer::buildDrawList(Viewport* vp, Scene* scene)
+{
+    m_drawList.clear();
+
+    RenderStats& stats = m_renderStats[vp];
+    stats              = {};
+
+    const un::frustum frustum = un::make_frustum(vp->projection() * vp->view());
+
+    forEachVisibleMesh(scene, [&](SceneMesh* sm, MeshGpuResources* gpu) {
+        // Empty meshes have no bounds; keep them (nothing gets drawn anyway).
+        const un::aabb& wb = sm->worldBounds();
+        if (wb.valid && !un::frustum_intersects(frustum, wb))
+        {
+            ++stats.meshesCulled;
+            return;
+        }
+
+        m_drawList.push_back({sm, gpu});
+        ++stats.meshesDrawn;
+    });
+}
+
+void Renderer::requestTextureResidency(Viewport* vp, Scene* scene)
+{
+    TextureHandler* texHandler = scene->textureHandler();
+    if (!texHandler || m_materialTextures.empty())
+        return;
+
+    const glm::mat4& proj    = vp->projection();
+    const bool       ortho   = proj[3][3] == 1.0f;
+    const float      heightF = static_cast<float>(vp->height());
+
+    for (const DrawItem& item : m_drawList)
+    {
+        const un::aabb& wb = item.mesh->worldBounds();
+        if (!wb.valid)
+            continue;
+
+        // Screen height of the bounding sphere; a texture is assumed to span its mesh once.
+        const glm::vec3 center = 0.5f * (wb.min + wb.max);
+        const float     radius = 0.5f * glm::length(wb.max - wb.min);
+        const float     depth  = vp->linearDepth(center);
+
+        float pixels = std::numeric_limits<float>::max();
+        if (ortho)
+            pixels = radius * proj[1][1] * heightF;
+        else if (depth > radius)
+            pixels = radius * proj[1][1] * heightF / depth;
+
+        for (uint32_t materialId : item.mesh->materialIds())
+        {
+            if (materialId >= m_materialTextures.size())
+                continue;
+
+            for (TextureId id : m_materialTextures[materialId])
+            {
+                if (id != kInvalidTextureId)
+                    texHandler->requestResidency(id, pixels);
+            }
+        }
+    }
+}
+
+RenderStats Renderer::renderStats() const noexcept
+{
+    RenderStats total = {};
+
+    for (const auto& [vp, stats] : m_renderStats)
+    {
+        total.meshesDrawn += stats.meshesDrawn;
+        total.meshesCulled += stats.meshesCulled;
+        total.drawCalls += stats.drawCalls;
+        total.recordMs += stats.recordMs;
+    }
+
+    return total;
+}
+
+bool Renderer::rtAccumulating() const noexcept
+{
+    return rtReady(m_ctx) && m_rt.isAccumulating();
+}
+
+void Renderer::setIndirectDrawEnabled(bool enabled) noexcept
+{
+    m_indirectDrawEnabled = enabled;
+}
+
+bool Renderer::indirectDrawEnabled() const noexcept
+{
+    return m_indirectDrawEnabled;
+}
+
+bool Renderer::batchReady() const noexcept
+{
+    return m_indirectDrawEnabled &&
+           m_ctx.supportsDrawIndirectFirstInstance &&
+           m_solidIndirectPipeline.valid();
+}
+
 void Renderer::drawSceneGrid(VkCommandBuffer cmd, Viewport* vp, Scene* scene)
 {
     if (!vp || !scene)
@@ -912,6 +1161,9 @@ void Renderer::destroyPipelines() noexcept
     destroyPipe(m_wirePipeline);
     destroyPipe(m_wireHiddenPipeline);
     destroyPipe(m_wireOverlayPipeline);
+    destroyPipe(m_solidIndirectPipeline);
+    destroyPipe(m_shadedIndirectPipeline);
+    destroyPipe(m_depthOnlyIndirectPipeline);
     destroyPipe(m_overlayPipeline);
     destroyPipe(m_overlayFillPipeline);
 
@@ -943,13 +1195,14 @@ bool Renderer::createDescriptors(uint32_t framesInFlight)
     m_materialSetLayout.destroy();
 
     {
-        DescriptorBindingInfo uboBindings[2] = {};
+        DescriptorBindingInfo uboBindings[5] = {};
 
         uboBindings[0].binding = 0;
         uboBindings[0].type    = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
         uboBindings[0].stages  = VK_SHADER_STAGE_VERTEX_BIT |
                                 VK_SHADER_STAGE_GEOMETRY_BIT |
                                 VK_SHADER_STAGE_FRAGMENT_BIT |
+                                VK_SHADER_STAGE_COMPUTE_BIT |
                                 VK_SHADER_STAGE_RAYGEN_BIT_KHR |
                                 VK_SHADER_STAGE_MISS_BIT_KHR |
                                 VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
@@ -960,7 +1213,27 @@ bool Renderer::createDescriptors(uint32_t framesInFlight)
         uboBindings[1].stages  = VK_SHADER_STAGE_ALL;
         uboBindings[1].count   = 1;
 
-        if (!m_descriptorSetLayout.create(device, std::span{uboBindings, 2}))
+        // Light buffer (GpuLight[], no fixed cap)
+        uboBindings[2].binding = 2;
+        uboBindings[2].type    = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        uboBindings[2].stages  = VK_SHADER_STAGE_FRAGMENT_BIT |
+                                VK_SHADER_STAGE_COMPUTE_BIT |
+                                VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
+        uboBindings[2].count = 1;
+
+        // Per-cluster light lists (LightCluster.comp -> ShadedDraw.frag)
+        uboBindings[3].binding = 3;
+        uboBindings[3].type    = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        uboBindings[3].stages  = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+        uboBindings[3].count   = 1;
+
+        // Light BVH (RtScene.rchit)
+        uboBindings[4].binding = 4;
+        uboBindings[4].type    = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        uboBindings[4].stages  = VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
+        uboBindings[4].count   = 1;
+
+        if (!m_descriptorSetLayout.create(device, std::span{uboBindings, 5}))
         {
             std::cerr << "RendererVK: Failed to create Frame Globals DescriptorSetLayout.\n";
             return false;
@@ -996,7 +1269,7 @@ bool Renderer::createDescriptors(uint32_t framesInFlight)
 
     std::array<VkDescriptorPoolSize, 3> poolSizes{
         VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, rasterSetCount * 2u},
-        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, materialSetCount},
+        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, rasterSetCount * 3u + materialSetCount},
         VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, materialSetCount * vkcfg::kMaxTextureCount},
     };
 
@@ -1050,16 +1323,47 @@ bool Renderer::createPipelineLayout() noexcept
 // Materials
 //==================================================================
 
-void Renderer::uploadMaterialsToGpu(const std::vector<Material>& materials,
-                                    TextureHandler&              texHandler,
-                                    uint32_t                     frameIndex,
-                                    const RenderFrameContext&    fc)
+void Renderer::syncMaterials(Scene* scene, uint32_t frameIndex, const RenderFrameContext& fc)
+{
+    if (!scene->materialHandler() || !scene->textureHandler())
+        return;
+
+    const MaterialHandler& materialHandler = *scene->materialHandler();
+    TextureHandler&        texHandler      = *scene->textureHandler();
+
+    const uint64_t matCounter = materialHandler.changeCounter() ? materialHandler.changeCounter()->value() : 0ull;
+
+    if (m_materialCounterPerFrame[frameIndex] != matCounter)
+    {
+        uploadMaterialsToGpu(materialHandler, texHandler, frameIndex, fc);
+        m_materialCounterPerFrame[frameIndex] = matCounter;
+    }
+
+    // Async uploads landed, or the materials created new textures.
+    const uint64_t texVersion = texHandler.version();
+    if (m_textureVersionPerFrame[frameIndex] != texVersion)
+    {
+        updateMaterialTextureTable(texHandler, frameIndex);
+        m_textureVersionPerFrame[frameIndex] = texVersion;
+    }
+}
+
+void Renderer::uploadMaterialsToGpu(const MaterialHandler&    materialHandler,
+                                    TextureHandler&           texHandler,
+                                    uint32_t                  frameIndex,
+                                    const RenderFrameContext& fc)
 {
     if (frameIndex >= m_framesInFlight)
         return;
 
+    const std::vector<Material>& materials = materialHandler.materials();
+    std::vector<std::uint64_t>&  versions  = m_materialVersionsPerFrame[frameIndex];
+
     if (materials.empty())
     {
+        m_materialTextures.clear();
+        versions.clear();
+
         if (m_materialBuffers[frameIndex].valid())
         {
             m_materialSets[frameIndex].writeStorageBuffer(m_ctx.device,
@@ -1071,13 +1375,69 @@ void Renderer::uploadMaterialsToGpu(const std::vector<Material>& materials,
         return;
     }
 
-    std::vector<GpuMaterial> gpuMats = {};
-    buildGpuMaterialArray(materials, texHandler, gpuMats);
+    const auto materialVersion = [&](std::size_t i) -> std::uint64_t {
+        const SysCounterPtr& counter = materials[i].changeCounter();
+        return counter ? counter->value() : 0ull;
+    };
+
+    const uint64_t structure = materialHandler.structureCounter() ? materialHandler.structureCounter()->value() : 0ull;
 
-    const VkDeviceSize sizeBytes = static_cast<VkDeviceSize>(gpuMats.size() * sizeof(GpuMaterial));
+    const std::size_t  count     = materials.size();
+    const VkDeviceSize sizeBytes = static_cast<VkDeviceSize>(count * sizeof(GpuMaterial));
 
     GpuBuffer& buf = m_materialBuffers[frameIndex];
 
+    const bool sparse = buf.valid() && buf.size() >= sizeBytes &&
+                        versions.size() == count &&
+                        m_materialStructurePerFrame[frameIndex] == structure;
+
+    if (m_materialTextures.size() != count)
+        m_materialTextures.resize(count);
+
+    if (sparse)
+    {
+        // Same materials as the last upload to this frame's buffer: only
+        // re-convert the edited ones and upload them as contiguous runs.
+        // The buffer is unchanged, so the descriptor stays as written.
+        std::size_t i = 0;
+        while (i < count)
+        {
+            if (versions[i] == materialVersion(i))
+            {
+                ++i;
+                continue;
+            }
+
+            const std::size_t first = i;
+
+            m_gpuMaterials.clear();
+            for (; i < count && versions[i] != materialVersion(i); ++i)
+            {
+                const GpuMaterial& g = m_gpuMaterials.emplace_back(buildGpuMaterial(materials[i], texHandler));
+
+                m_materialTextures[i] = {g.baseColorTexture, g.normalTexture, g.mraoTexture, g.emissiveTexture};
+                versions[i]           = materialVersion(i);
+            }
+
+            buf.upload(m_gpuMaterials.data(),
+                       static_cast<VkDeviceSize>(m_gpuMaterials.size() * sizeof(GpuMaterial)),
+                       static_cast<VkDeviceSize>(first * sizeof(GpuMaterial)));
+        }
+        return;
+    }
+
+    buildGpuMaterialArray(materials, texHandler, m_gpuMaterials);
+
+    versions.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const GpuMaterial& g  = m_gpuMaterials[i];
+        m_materialTextures[i] = {g.baseColorTexture, g.normalTexture, g.mraoTexture, g.emissiveTexture};
+        versions[i]           = materialVersion(i);
+    }
+
+    m_materialStructurePerFrame[frameIndex] = structure;
+
     if (!buf.valid() || buf.size() < sizeBytes)
     {
         if (buf.valid())
@@ -1101,10 +1461,10 @@ void Renderer::uploadMaterialsToGpu(const std::vector<Material>& materials,
                    sizeBytes,
                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                   false);
+                   true);
     }
 
-    buf.upload(gpuMats.data(), sizeBytes);
+    buf.upload(m_gpuMaterials.data(), sizeBytes);
 
     m_materialSets[frameIndex].writeStorageBuffer(m_ctx.device,
                                                   0,
@@ -1161,7 +1521,39 @@ void Renderer::updateMaterialTextureTable(const TextureHandler& textureHandler,
         infos[static_cast<size_t>(i)] = info;
     }
 
-    m_materialSets[frameIndex].writeCombinedImageSamplerArray(device, 1, infos);
+    // Write only the runs of slots that differ from what this frame's set
+    // already holds (everything on the first write).
+    std::vector<VkDescriptorImageInfo>& written = m_textureTablePerFrame[frameIndex];
+
+    if (written.size() != infos.size())
+    {
+        m_materialSets[frameIndex].writeCombinedImageSamplerArray(device, 1, infos);
+        written = std::move(infos);
+        return;
+    }
+
+    const auto sameSlot = [&](std::size_t i) {
+        return written[i].imageView == infos[i].imageView && written[i].sampler == infos[i].sampler;
+    };
+
+    std::size_t i = 0;
+    while (i < infos.size())
+    {
+        if (sameSlot(i))
+        {
+            ++i;
+            continue;
+        }
+
+        const std::size_t first = i;
+        for (; i < infos.size() && !sameSlot(i); ++i)
+            written[i] = infos[i];
+
+        m_materialSets[frameIndex].writeCombinedImageSamplerArray(device,
+                                                                  1,
+                                                                  std::span{infos}.subspan(first, i - first),
+                                                                  static_cast<uint32_t>(first));
+    }
 }
 
 //==================================================================
@@ -1242,54 +1634,6 @@ bool Renderer::createPipelines(VkRenderPass renderPass)
     viOverlayFill.vertexAttributeDescriptionCount = 2;
     viOverlayFill.pVertexAttributeDescriptions    = overlayFillAttrs;
 
-    if (!vkutil::createSolidPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viSolid, m_solidPipeline))
-    {
-        std::cerr << "RendererVK: createSolidPipeline failed.\n";
-        return false;
-    }
-
-    if (!vkutil::createShadedPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viSolid, m_shadedPipeline))
-    {
-        std::cerr << "RendererVK: createShadedPipeline failed.\n";
-        return false;
-    }
-
-    if (!vkutil::createDepthOnlyPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viSolid, m_depthOnlyPipeline))
-    {
-        std::cerr << "RendererVK: createDepthOnlyPipeline failed.\n";
-        return false;
-    }
-
-    if (!vkutil::createWireframePipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viLines, m_wirePipeline))
-    {
-        std::cerr << "RendererVK: createWireframePipeline failed.\n";
-        return false;
-    }
-
-    if (!vkutil::createWireframeHiddenPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viLines, m_wireHiddenPipeline))
-    {
-        std::cerr << "RendererVK: createWireframeHiddenPipeline failed.\n";
-        return false;
-    }
-
-    if (!vkutil::createWireframeDepthBiasPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viLines, m_wireOverlayPipeline))
-    {
-        std::cerr << "RendererVK: createWireframeDepthBiasPipeline failed.\n";
-        return false;
-    }
-
-    if (!vkutil::createOverlayPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viOverlay, m_overlayPipeline))
-    {
-        std::cerr << "RendererVK: createOverlayPipeline failed.\n";
-        return false;
-    }
-
-    if (!vkutil::createOverlayFillPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viOverlayFill, m_overlayFillPipeline))
-    {
-        std::cerr << "RendererVK: createOverlayFillPipeline failed.\n";
-        return false;
-    }
-
     ShaderStage selVert     = vkutil::loadStage(m_ctx.device, "Selection.vert.spv", VK_SHADER_STAGE_VERTEX_BIT);
     ShaderStage selFrag     = vkutil::loadStage(m_ctx.device, "Selection.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT);
     ShaderStage selVertFrag = vkutil::loadStage(m_ctx.device, "SelectionVert.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT);
@@ -1364,7 +1708,14 @@ bool Renderer::createPipelines(VkRenderPass renderPass)
     vkutil::MeshPipelinePreset selPolyHiddenPreset = selPolyPreset;
     selPolyHiddenPreset.depthCompareOp             = VK_COMPARE_OP_GREATER;
 
-    auto wrapSelPipeline = [&](GraphicsPipeline& dst, VkPipeline src) -> bool {
+    VkVertexInputBindingDescription      batchBindings[5] = {};
+    VkVertexInputAttributeDescription    batchAttrs[8]    = {};
+    VkPipelineVertexInputStateCreateInfo viBatch{};
+    vkutil::makeSolidIndirectVertexInput(viBatch, batchBindings, batchAttrs);
+
+    constexpr const char* batchVert = "MeshDrawIndirect.vert.spv";
+
+    auto wrapSelPipeline = [this](GraphicsPipeline& dst, VkPipeline src) -> bool {
         if (!src)
             return false;
         dst.destroy();
@@ -1373,58 +1724,56 @@ bool Renderer::createPipelines(VkRenderPass renderPass)
         return true;
     };
 
-    {
-        VkPipeline p = createMeshPipeline(m_ctx, renderPass, m_pipelineLayout, selVertStages, 2, &viLines, selVertPreset);
-        if (!wrapSelPipeline(m_selVertPipeline, p))
-        {
-            std::cerr << "RendererVK: createMeshPipeline(selection verts) failed.\n";
-            return false;
-        }
-    }
+    auto selJob = [&](const char* name, GraphicsPipeline& dst, const VkPipelineShaderStageCreateInfo* stages, const vkutil::MeshPipelinePreset& preset) {
+        GraphicsPipeline*                 out = &dst;
+        const vkutil::MeshPipelinePreset* pre = &preset;
 
-    {
-        VkPipeline p = createMeshPipeline(m_ctx, renderPass, m_pipelineLayout, selStages, 2, &viLines, selEdgePreset);
-        if (!wrapSelPipeline(m_selEdgePipeline, p))
-        {
-            std::cerr << "RendererVK: createMeshPipeline(selection edges) failed.\n";
-            return false;
-        }
-    }
+        return vkutil::PipelineJob{name, [this, renderPass, &viLines, &wrapSelPipeline, out, stages, pre] {
+                                       VkPipeline p = createMeshPipeline(m_ctx, renderPass, m_pipelineLayout, stages, 2, &viLines, *pre);
+                                       return wrapSelPipeline(*out, p);
+                                   }};
+    };
 
-    {
-        VkPipeline p = createMeshPipeline(m_ctx, renderPass, m_pipelineLayout, selStages, 2, &viLines, selPolyPreset);
-        if (!wrapSelPipeline(m_selPolyPipeline, p))
-        {
-            std::cerr << "RendererVK: createMeshPipeline(selection polys) failed.\n";
-            return false;
-        }
-    }
+    // Every pipeline below is independent; the jobs write only their own member.
+    // Everything they reference lives on this stack frame until the join.
+    std::vector<vkutil::PipelineJob> jobs = {
+        {"createSolidPipeline", [&] { return vkutil::createSolidPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viSolid, m_solidPipeline); }},
+        {"createShadedPipeline", [&] { return vkutil::createShadedPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viSolid, m_shadedPipeline); }},
+        {"createDepthOnlyPipeline", [&] { return vkutil::createDepthOnlyPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viSolid, m_depthOnlyPipeline); }},
+        {"createWireframePipeline", [&] { return vkutil::createWireframePipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viLines, m_wirePipeline); }},
+        {"createWireframeHiddenPipeline", [&] { return vkutil::createWireframeHiddenPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viLines, m_wireHiddenPipeline); }},
+        {"createWireframeDepthBiasPipeline", [&] { return vkutil::createWireframeDepthBiasPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viLines, m_wireOverlayPipeline); }},
+        {"createOverlayPipeline", [&] { return vkutil::createOverlayPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viOverlay, m_overlayPipeline); }},
+        {"createOverlayFillPipeline", [&] { return vkutil::createOverlayFillPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viOverlayFill, m_overlayFillPipeline); }},
+        selJob("createMeshPipeline(selection verts)", m_selVertPipeline, selVertStages, selVertPreset),
+        selJob("createMeshPipeline(selection edges)", m_selEdgePipeline, selStages, selEdgePreset),
+        selJob("createMeshPipeline(selection polys)", m_selPolyPipeline, selStages, selPolyPreset),
+        selJob("createMeshPipeline(selection verts hidden)", m_selVertHiddenPipeline, selVertStages, selVertHiddenPreset),
+        selJob("createMeshPipeline(selection edges hidden)", m_selEdgeHiddenPipeline, selStages, selEdgeHiddenPreset),
+        selJob("createMeshPipeline(selection polys hidden)", m_selPolyHiddenPipeline, selStages, selPolyHiddenPreset),
+    };
 
+    // Batched variants are optional: without them every mesh takes the per-mesh path.
+    if (m_ctx.supportsDrawIndirectFirstInstance)
     {
-        VkPipeline p = createMeshPipeline(m_ctx, renderPass, m_pipelineLayout, selVertStages, 2, &viLines, selVertHiddenPreset);
-        if (!wrapSelPipeline(m_selVertHiddenPipeline, p))
-        {
-            std::cerr << "RendererVK: createMeshPipeline(selection verts hidden) failed.\n";
-            return false;
-        }
+        jobs.push_back({"createSolidPipeline(batched)", [&] { return vkutil::createSolidPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viBatch, m_solidIndirectPipeline, batchVert); }, true});
+        jobs.push_back({"createShadedPipeline(batched)", [&] { return vkutil::createShadedPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viBatch, m_shadedIndirectPipeline, batchVert); }, true});
+        jobs.push_back({"createDepthOnlyPipeline(batched)", [&] { return vkutil::createDepthOnlyPipeline(m_ctx, renderPass, m_pipelineLayout, m_ctx.sampleCount, viBatch, m_depthOnlyIndirectPipeline, batchVert); }, true});
     }
 
+    if (!vkutil::buildPipelinesParallel(jobs))
     {
-        VkPipeline p = createMeshPipeline(m_ctx, renderPass, m_pipelineLayout, selStages, 2, &viLines, selEdgeHiddenPreset);
-        if (!wrapSelPipeline(m_selEdgeHiddenPipeline, p))
-        {
-            std::cerr << "RendererVK: createMeshPipeline(selection edges hidden) failed.\n";
-            return false;
-        }
+        std::cerr << "RendererVK: Pipeline creation failed.\n";
+        return false;
     }
 
+    if (!m_solidIndirectPipeline.valid() || !m_shadedIndirectPipeline.valid() || !m_depthOnlyIndirectPipeline.valid())
     {
-        VkPipeline p = createMeshPipeline(m_ctx, renderPass, m_pipelineLayout, selStages, 2, &viLines, selPolyHiddenPreset);
-        if (!wrapSelPipeline(m_selPolyHiddenPipeline, p))
-        {
-            std::cerr << "RendererVK: createMeshPipeline(selection polys hidden) failed.\n";
-            return false;
-        }
+        if (m_ctx.supportsDrawIndirectFirstInstance)
+            std::cerr << "RendererVK: Batched mesh pipelines unavailable; using per-mesh draws.\n";
+        m_solidIndirectPipeline.destroy();
+        m_shadedIndirectPipeline.destroy();
+        m_depthOnlyIndirectPipeline.destroy();
     }
 
     return true;
@@ -1490,10 +1839,67 @@ Renderer::ViewportUboState& Renderer::ensureViewportUboState(Viewport* vp, uint3
         needWrite = true;
     }
 
+    // Storage buffers start at one element; updateViewportFrameGlobals grows
+    // the light and BVH buffers as needed.
+    if (!s.lightDataBuffers[frameIdx].valid())
+    {
+        s.lightDataBuffers[frameIdx].create(m_ctx.device,
+                                            m_ctx.physicalDevice,
+                                            sizeof(GpuLight),
+                                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                            true);
+
+        if (!s.lightDataBuffers[frameIdx].valid())
+        {
+            std::cerr << "RendererVK: Failed to create light buffer for viewport frame " << frameIdx << ".\n";
+            return s;
+        }
+        s.uploadedLights[frameIdx].clear();
+        needWrite = true;
+    }
+
+    if (!s.clusterBuffers[frameIdx].valid())
+    {
+        s.clusterBuffers[frameIdx].create(m_ctx.device,
+                                          m_ctx.physicalDevice,
+                                          kLightClusterBufferSize,
+                                          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        if (!s.clusterBuffers[frameIdx].valid())
+        {
+            std::cerr << "RendererVK: Failed to create light cluster buffer for viewport frame " << frameIdx << ".\n";
+            return s;
+        }
+        needWrite = true;
+    }
+
+    if (!s.lightBvhBuffers[frameIdx].valid())
+    {
+        s.lightBvhBuffers[frameIdx].create(m_ctx.device,
+                                           m_ctx.physicalDevice,
+                                           sizeof(GpuLightBvhNode),
+                                           VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                           true);
+
+        if (!s.lightBvhBuffers[frameIdx].valid())
+        {
+            std::cerr << "RendererVK: Failed to create light BVH buffer for viewport frame " << frameIdx << ".\n";
+            return s;
+        }
+        s.lightBvhValid[frameIdx] = false;
+        needWrite = true;
+    }
+
     if (needWrite)
     {
         s.uboSets[frameIdx].writeUniformBuffer(m_ctx.device, 0, s.cameraBuffers[frameIdx].buffer(), sizeof(CameraUBO));
         s.uboSets[frameIdx].writeUniformBuffer(m_ctx.device, 1, s.lightBuffers[frameIdx].buffer(), sizeof(GpuLightsUBO));
+        s.uboSets[frameIdx].writeStorageBuffer(m_ctx.device, 2, s.lightDataBuffers[frameIdx].buffer(), s.lightDataBuffers[frameIdx].size());
+        s.uboSets[frameIdx].writeStorageBuffer(m_ctx.device, 3, s.clusterBuffers[frameIdx].buffer(), kLightClusterBufferSize);
+        s.uboSets[frameIdx].writeStorageBuffer(m_ctx.device, 4, s.lightBvhBuffers[frameIdx].buffer(), s.lightBvhBuffers[frameIdx].size());
     }
 
     return s;
@@ -1524,3 +1930,14 @@ void Renderer::forEachVisibleMesh(Scene* scene, Fn&& fn)
         fn(sm, gpu);
     }
 }
+
+//==================================================================
+// forEachDrawMesh
+//==================================================================
+
+template<typename Fn>
+void Renderer::forEachDrawMesh(Fn&& fn)
+{
+    for (const DrawItem& item : m_drawList)
+        fn(item.mesh, item.gpu);
+}
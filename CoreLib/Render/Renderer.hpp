@@ -12,20 +12,27 @@
 #include <vector>
 #include <vulkan/vulkan.h>
 
+#include "CoreTypes.hpp"
 #include "DescriptorPool.hpp"
 #include "DescriptorSet.hpp"
 #include "DescriptorSetLayout.hpp"
 #include "GpuBuffer.hpp"
 #include "GpuLights.hpp"
+#include "GpuResources/GpuMaterial.hpp"
 #include "GraphicsPipelines.hpp"
 #include "GridRendererVK.hpp"
+#include "LightBvh.hpp"
+#include "LightClusterPass.hpp"
 #include "LightingSettings.hpp"
 #include "Material.hpp"
+#include "MeshDrawBatch.hpp"
 #include "OverlayHandler.hpp"
 #include "RtRenderer.hpp"
 #include "VulkanContext.hpp"
 
+class MaterialHandler;
 class Scene;
+class SceneMesh;
 class TextureHandler;
 class Viewport;
 class MeshGpuResources;
@@ -40,6 +47,7 @@ struct RenderFrameContext;
  *      * set=0 (frame globals): CameraUBO + LightsUBO (per viewport, per frame)
  *      * set=1 (materials): SSBO + texture table (per frame)
  *  - MeshGpuResources::update() scheduling outside render pass.
+ *  - Optional batched filled-triangle path (MeshDrawBatch, vkCmdDrawIndirect).
  *  - Delegates all ray tracing (set=2, BLAS/TLAS, trace, RT present) to RtRenderer.
  */
 class Renderer
@@ -88,6 +96,31 @@ public:
 
     void drawOverlays(VkCommandBuffer cmd, Viewport* vp, const OverlayHandler& overlays);
 
+    /**
+     * @brief Drop everything kept per viewport (UBOs, stats, indirect buffers, RT and denoiser images). Waits for the device.
+     */
+    void releaseViewport(Viewport* vp) noexcept;
+
+    /**
+     * @brief Culling / draw counters from the last render() of every viewport, summed.
+     */
+    [[nodiscard]] RenderStats renderStats() const noexcept;
+
+    /**
+     * @brief True while a ray-traced viewport is still accumulating samples.
+     */
+    [[nodiscard]] bool rtAccumulating() const noexcept;
+
+    /**
+     * @brief Toggle the batched (multi-draw-indirect) path for filled triangles.
+     *
+     * Only takes effect when the device supports drawIndirectFirstInstance.
+     * Edges, selection and overlays always use per-mesh draws.
+     */
+    void setIndirectDrawEnabled(bool enabled) noexcept;
+
+    [[nodiscard]] bool indirectDrawEnabled() const noexcept;
+
 public:
     // ============================================================
     // Shader-visible structs (must match GLSL/std140)
@@ -138,11 +171,21 @@ public:
 
     struct ViewportUboState
     {
-        std::array<GpuBuffer, vkcfg::kMaxFramesInFlight>     cameraBuffers = {};
-        std::array<GpuBuffer, vkcfg::kMaxFramesInFlight>     lightBuffers  = {};
-        std::array<DescriptorSet, vkcfg::kMaxFramesInFlight> uboSets       = {}; // set=0
+        std::array<GpuBuffer, vkcfg::kMaxFramesInFlight>     cameraBuffers    = {};
+        std::array<GpuBuffer, vkcfg::kMaxFramesInFlight>     lightBuffers     = {}; // binding 1: GpuLightsUBO header
+        std::array<GpuBuffer, vkcfg::kMaxFramesInFlight>     lightDataBuffers = {}; // binding 2: GpuLight[]
+        std::array<GpuBuffer, vkcfg::kMaxFramesInFlight>     clusterBuffers   = {}; // binding 3: written by LightClusterPass
+        std::array<GpuBuffer, vkcfg::kMaxFramesInFlight>     lightBvhBuffers  = {}; // binding 4: GpuLightBvhNode[] (RT)
+        std::array<DescriptorSet, vkcfg::kMaxFramesInFlight> uboSets          = {}; // set=0
+
+        // What each frame's light buffers currently hold, for sparse re-upload.
+        std::array<std::vector<GpuLight>, vkcfg::kMaxFramesInFlight> uploadedLights     = {};
+        std::array<uint32_t, vkcfg::kMaxFramesInFlight>              lightBvhNodeCounts = {};
+        std::array<bool, vkcfg::kMaxFramesInFlight>                  lightBvhValid      = {};
     };
 
+    using DrawItem = MeshDrawItem;
+
 private:
     // ============================================================
     // Raster helpers
@@ -156,16 +199,28 @@ private:
 
     ViewportUboState& ensureViewportUboState(Viewport* vp, uint32_t frameIndex);
 
-    void uploadMaterialsToGpu(const std::vector<Material>& materials,
-                              TextureHandler&              texHandler,
-                              uint32_t                     frameIndex,
-                              const RenderFrameContext&    fc);
+    // Bring this frame's material buffer and texture table up to date.
+    void syncMaterials(Scene* scene, uint32_t frameIndex, const RenderFrameContext& fc);
+
+    void uploadMaterialsToGpu(const MaterialHandler&    materialHandler,
+                              TextureHandler&           texHandler,
+                              uint32_t                  frameIndex,
+                              const RenderFrameContext& fc);
 
     void drawSceneGrid(VkCommandBuffer cmd, Viewport* vp, Scene* scene);
     void ensureOverlayVertexCapacity(std::size_t requiredVertexCount);
     void ensureOverlayFillVertexCapacity(std::size_t requiredVertexCount);
     void drawSelection(VkCommandBuffer cmd, Viewport* vp, Scene* scene);
 
+    // Frustum-cull visible meshes into m_drawList and record the counts for vp.
+    void buildDrawList(Viewport* vp, Scene* scene);
+
+    // Tell the texture handler which textures m_drawList samples and at what screen size.
+    void requestTextureResidency(Viewport* vp, Scene* scene);
+
+    // True when filled triangles go through m_meshBatch.
+    [[nodiscard]] bool batchReady() const noexcept;
+
     // Shared helper to update set=0 buffers for a viewport+frame.
     void updateViewportFrameGlobals(Viewport* vp, Scene* scene, uint32_t frameIndex) noexcept;
 
@@ -193,6 +248,11 @@ private:
     GraphicsPipeline m_wireHiddenPipeline  = {};
     GraphicsPipeline m_wireOverlayPipeline = {};
 
+    // Batched variants (MeshDrawIndirect.vert, instance-rate model matrix)
+    GraphicsPipeline m_solidIndirectPipeline     = {};
+    GraphicsPipeline m_shadedIndirectPipeline    = {};
+    GraphicsPipeline m_depthOnlyIndirectPipeline = {};
+
     GraphicsPipeline m_overlayPipeline     = {};
     GraphicsPipeline m_overlayFillPipeline = {};
 
@@ -220,6 +280,29 @@ private:
     HeadlightSettings m_headlight        = {};
     LightingSettings  m_lightingSettings = {};
 
+    // Scratch for updateViewportFrameGlobals (reused across frames).
+    std::vector<GpuLight>        m_gpuLights     = {};
+    std::vector<GpuLightBvhNode> m_lightBvhNodes = {};
+
+    LightClusterPass m_lightClusters = {};
+
+private:
+    // ============================================================
+    // Culling (rebuilt per render() call)
+    // ============================================================
+
+    std::vector<DrawItem>                      m_drawList    = {};
+    std::unordered_map<Viewport*, RenderStats> m_renderStats = {};
+
+private:
+    // ============================================================
+    // Batched filled-triangle drawing
+    // ============================================================
+
+    MeshDrawBatch         m_meshBatch           = {};
+    std::vector<DrawItem> m_batchItems          = {};
+    bool                  m_indirectDrawEnabled = true;
+
 private:
     // ============================================================
     // Materials SSBO (per-frame)
@@ -227,6 +310,19 @@ private:
 
     std::array<GpuBuffer, vkcfg::kMaxFramesInFlight>     m_materialBuffers         = {};
     std::array<std::uint64_t, vkcfg::kMaxFramesInFlight> m_materialCounterPerFrame = {};
+    std::array<std::uint64_t, vkcfg::kMaxFramesInFlight> m_textureVersionPerFrame  = {};
+
+    // Per-element state of each frame's copy, so edits upload only what changed:
+    // MaterialHandler::structureCounter() and each Material::changeCounter()
+    // at the last upload, and the texture table as last written.
+    std::array<std::uint64_t, vkcfg::kMaxFramesInFlight>                      m_materialStructurePerFrame = {};
+    std::array<std::vector<std::uint64_t>, vkcfg::kMaxFramesInFlight>         m_materialVersionsPerFrame  = {};
+    std::array<std::vector<VkDescriptorImageInfo>, vkcfg::kMaxFramesInFlight> m_textureTablePerFrame      = {};
+
+    std::vector<GpuMaterial> m_gpuMaterials = {}; // upload scratch
+
+    // TextureIds (base, normal, mrao, emissive) per material, from the last upload.
+    std::vector<std::array<std::int32_t, 4>> m_materialTextures = {};
 
 private:
     // ============================================================
@@ -253,4 +349,8 @@ private:
 
     template<typename Fn>
     void forEachVisibleMesh(Scene* scene, Fn&& fn);
+
+    // Iterates m_drawList (frustum-culled). Only valid inside render().
+    template<typename Fn>
+    void forEachDrawMesh(Fn&& fn);
 };
@@ -76,21 +76,43 @@ struct GpuLight
     vec3 color;      // linear RGB color
     float intensity; // light strength
 
-    // x = innerCos, y = outerCos, z = RT soft-shadow radius (point/spot), w reserved
+    // x = innerCos, y = outerCos, z = RT soft-shadow radius (point/spot),
+    // w = influence radius (point/spot)
     vec4 spot_params;
 };
 
 layout(set = 0, binding = 1, std140) uniform LightsUBO
 {
-    uint  count;          // number of active lights
+    uint  count;          // number of lights in LightBuf
+    uint  dirCount;       // lights[0, dirCount) are directional
+    uint  bvhNodeCount;   // RT only
     uint  pad0;
-    uint  pad1;
-    uint  pad2;
     vec3  ambient;        // ambient fill color (linear)
     float exposure;       // exposure scalar or UI value
-    GpuLight lights[64];
+    float clusterNear;    // view depth of the first cluster slice
+    float clusterFar;
+    float clusterLogScale; // CLUSTER_Z / log(far / near), 0 = no clusters
+    float pad1;
 } Lights;
 
+layout(std430, set = 0, binding = 2) readonly buffer LightBuffer
+{
+    GpuLight lights[];
+} LightBuf;
+
+// ============================================================
+// Light clusters (written by LightCluster.comp; see GpuLights.hpp)
+// ============================================================
+const uint CLUSTER_X      = 16u;
+const uint CLUSTER_Y      = 9u;
+const uint CLUSTER_Z      = 24u;
+const uint CLUSTER_STRIDE = 128u;
+
+layout(std430, set = 0, binding = 3) readonly buffer ClusterBuffer
+{
+    uint data[];
+} Clusters;
+
 // ============================================================
 // Output controls
 // ============================================================
@@ -165,7 +187,9 @@ vec3 studioEnv(vec3 dir)
 // ------------------------------------------------------------
 vec3 sampleNormalMapTS(int normalTex, vec2 uv)
 {
-    vec3 n = texture(uTextures[normalTex], uv).xyz * 2.0 - 1.0;
+    // Z is rebuilt from XY so two-channel (BC5) normal maps work too.
+    vec3 n = vec3(texture(uTextures[normalTex], uv).xy * 2.0 - 1.0, 0.0);
+    n.z    = sqrt(max(0.0, 1.0 - dot(n.xy, n.xy)));
     return normalize(n);
 }
 
@@ -245,6 +269,59 @@ void evalLight(in GpuLight Ld, in vec3 Pworld, out vec3 Lworld, out float atten)
     }
 }
 
+// Cook-Torrance contribution of one light.
+vec3 shadeLight(in GpuLight Ld, vec3 N, vec3 V, vec3 albedo, vec3 F0, float roughness, float metallic, float alpha)
+{
+    vec3  L;
+    float atten;
+    evalLight(Ld, posW, L, atten);
+
+    float NdotL = saturate(dot(N, L));
+    float NdotV = saturate(dot(N, V));
+    if (NdotL <= 0.0 || NdotV <= 0.0 || atten <= 0.0)
+        return vec3(0.0);
+
+    vec3  H     = normalize(V + L);
+    float NdotH = saturate(dot(N, H));
+    float VdotH = saturate(dot(V, H));
+
+    vec3  F = fresnelSchlick(VdotH, F0);
+    float D = D_GGX(NdotH, alpha);
+
+    float r = roughness + 1.0;
+    float k = (r * r) / 8.0;
+    float G = G_Smith(NdotV, NdotL, k);
+
+    vec3 spec = (D * G * F) / max(4.0 * NdotV * NdotL, 1e-7);
+    vec3 kd   = (vec3(1.0) - F) * (1.0 - metallic);
+    vec3 diff = kd * albedo / 3.14159265;
+
+    const float LIGHT_INTENSITY_SCALE = 5.0; // 2..10
+
+    vec3 radiance = Ld.color * (Ld.intensity * LIGHT_INTENSITY_SCALE * atten);
+
+    return (diff + spec) * radiance * NdotL;
+}
+
+// Index of this fragment's cluster, or -1 if outside the grid.
+int clusterIndex()
+{
+    if (Lights.clusterLogScale <= 0.0)
+        return -1;
+
+    float depth = -(uCamera.view * vec4(posW, 1.0)).z;
+    if (depth < Lights.clusterNear)
+        return -1;
+
+    uvec2 tile  = uvec2(gl_FragCoord.xy * uCamera.viewport.zw * vec2(CLUSTER_X, CLUSTER_Y));
+    uint  slice = uint(log(depth / Lights.clusterNear) * Lights.clusterLogScale);
+
+    tile  = min(tile, uvec2(CLUSTER_X - 1u, CLUSTER_Y - 1u));
+    slice = min(slice, CLUSTER_Z - 1u);
+
+    return int((slice * CLUSTER_Y + tile.y) * CLUSTER_X + tile.x);
+}
+
 // ------------------------------------------------------------
 // Tonemap (ACES fitted)
 // ------------------------------------------------------------
@@ -313,40 +390,26 @@ void main()
     // --------------------------------------------------------
     vec3 direct = vec3(0.0);
 
-    uint lightCount = min(Lights.count, 64u);
+    uint lightCount = min(Lights.count, uint(LightBuf.lights.length()));
+    uint dirCount   = min(Lights.dirCount, lightCount);
 
-    for (uint i = 0u; i < lightCount; ++i)
-    {
-        vec3  L;
-        float atten;
-        evalLight(Lights.lights[i], posW, L, atten);
+    // Directional lights reach everything.
+    for (uint i = 0u; i < dirCount; ++i)
+        direct += shadeLight(LightBuf.lights[i], N, V, albedo, F0, roughness, metallic, alpha);
 
-        float NdotL = saturate(dot(N, L));
-        float NdotV = saturate(dot(N, V));
-        if (NdotL <= 0.0 || NdotV <= 0.0)
-            continue;
-
-        vec3  H     = normalize(V + L);
-        float NdotH = saturate(dot(N, H));
-        float VdotH = saturate(dot(V, H));
-
-        vec3  F = fresnelSchlick(VdotH, F0);
-        float D = D_GGX(NdotH, alpha);
-
-        float r = roughness + 1.0;
-        float k = (r * r) / 8.0;
-        float G = G_Smith(NdotV, NdotL, k);
-
-        vec3 spec = (D * G * F) / max(4.0 * NdotV * NdotL, 1e-7);
-        vec3 kd   = (vec3(1.0) - F) * (1.0 - metallic);
-        vec3 diff = kd * albedo / 3.14159265;
-
-        const float LIGHT_INTENSITY_SCALE = 5.0; // 2..10
-
-        vec3 radiance = Lights.lights[i].color *
-                        (Lights.lights[i].intensity * LIGHT_INTENSITY_SCALE * atten);
-
-        direct += (diff + spec) * radiance * NdotL;
+    // Point/spot lights: only those binned into this fragment's cluster.
+    int ci = clusterIndex();
+    if (ci >= 0)
+    {
+        uint base = uint(ci) * CLUSTER_STRIDE;
+        uint n    = Clusters.data[base];
+
+        for (uint j = 0u; j < n; ++j)
+        {
+            uint i = Clusters.data[base + 1u + j];
+            if (i < lightCount)
+                direct += shadeLight(LightBuf.lights[i], N, V, albedo, F0, roughness, metallic, alpha);
+        }
     }
 
     // --------------------------------------------------------
@@ -61,21 +61,26 @@ struct GpuLight
     vec4 pos_type;        // xyz = pos (WORLD) for point/spot, w = type
     vec4 dir_range;       // xyz = forward dir (WORLD), w = range OR angular radius (dir)
     vec4 color_intensity; // rgb = color, a = intensity
-    vec4 spot_params;     // x = innerCos, y = outerCos, z = angular radius (radians)
+    vec4 spot_params;     // x = innerCos, y = outerCos, z = angular radius (radians), w = influence radius
 };
 
-// Unified LightsUBO layout (matches ShadedDraw + RT)
+// Unified LightsUBO header (matches ShadedDraw + RT)
 layout(set = 0, binding = 1, std140) uniform LightsUBO
 {
-    uint  count;          // number of active lights
+    uint  count;          // number of lights in LightBuf
+    uint  dirCount;       // directional lights come first
+    uint  bvhNodeCount;   // RT only
     uint  pad0;
-    uint  pad1;
-    uint  pad2;
     vec3  ambient;        // ambient fill (unused here)
     float exposure;       // exposure scalar/UI (unused here)
-    GpuLight lights[64];
+    vec4  cluster;        // raster light clusters (unused here)
 } Lights;
 
+layout(std430, set = 0, binding = 2) readonly buffer LightBuffer
+{
+    GpuLight lights[];
+} LightBuf;
+
 float saturate(float x) { return clamp(x, 0.0, 1.0); }
 vec3  tonemapReinhard(vec3 x) { return x / (1.0 + x); }
 
@@ -113,11 +118,11 @@ void main()
     float I = 1.0;
 
     // If we have lights in the UBO, use light 0 as the "main" light
-    if (Lights.count > 0u)
+    if (Lights.count > 0u && LightBuf.lights.length() > 0)
     {
-        L = normalize(-Lights.lights[0].dir_range.xyz); // dir_range.xyz is forward; we want surface->light
-        c = Lights.lights[0].color_intensity.rgb;
-        I = Lights.lights[0].color_intensity.a;
+        L = normalize(-LightBuf.lights[0].dir_range.xyz); // dir_range.xyz is forward; we want surface->light
+        c = LightBuf.lights[0].color_intensity.rgb;
+        I = LightBuf.lights[0].color_intensity.a;
     }
 
     float NdotL = saturate(dot(N, L));
@@ -6,11 +6,15 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <iostream>
 #include <string>
 
+#include "ContentHash.hpp"
+#include "TextureCache.hpp"
+
 namespace
 {
     static std::string toLower(std::string s)
@@ -38,7 +42,8 @@ namespace
         return KTX_TTF_BC7_RGBA;
     }
 
-    static bool transcodeIfNeeded(ktxTexture* baseTex, VkFormat& outVkFormat) noexcept
+    // Swaps @p baseTex for a cached BC7 transcode when one exists (see TextureCache).
+    static bool transcodeIfNeeded(ktxTexture*& baseTex, VkFormat& outVkFormat) noexcept
     {
         if (!baseTex)
             return false;
@@ -61,6 +66,34 @@ namespace
             return true;
         }
 
+        TextureCache& cache = TextureCache::shared();
+
+        uint64_t key = 0;
+        if (cache.enabled())
+        {
+            const uint32_t dims[3] = {baseTex->baseWidth, baseTex->baseHeight, baseTex->numLevels};
+            key                    = un::xxh64(ktxTexture_GetData(baseTex),
+                                               ktxTexture_GetDataSize(baseTex),
+                                               un::xxh64(dims, sizeof(dims)));
+
+            const MappedFile cached = cache.open(key, TextureCacheVariant::Transcoded);
+            ktxTexture*      hit    = nullptr;
+
+            if (cached.valid() &&
+                ktxTexture_CreateFromMemory(cached.data(), cached.size(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &hit) == KTX_SUCCESS)
+            {
+                if (hit->classId == ktxTexture2_c &&
+                    ktxTexture2_NeedsTranscoding(reinterpret_cast<ktxTexture2*>(hit)) == KTX_FALSE)
+                {
+                    ktxTexture_Destroy(baseTex);
+                    baseTex     = hit;
+                    outVkFormat = static_cast<VkFormat>(reinterpret_cast<ktxTexture2*>(hit)->vkFormat);
+                    return true;
+                }
+                ktxTexture_Destroy(hit);
+            }
+        }
+
         const ktx_transcode_fmt_e target = defaultTranscodeTarget();
 
         // IMPORTANT: Must transcode before asking for mip offsets / using pData for BasisU payloads.
@@ -68,6 +101,17 @@ namespace
         if (ec != KTX_SUCCESS)
             return false;
 
+        if (key != 0)
+        {
+            ktx_uint8_t* bytes = nullptr;
+            ktx_size_t   size  = 0;
+            if (ktxTexture_WriteToMemory(baseTex, &bytes, &size) == KTX_SUCCESS && bytes)
+            {
+                cache.store(key, TextureCacheVariant::Transcoded, {bytes, size});
+                std::free(bytes);
+            }
+        }
+
         // After transcode, vkFormat should reflect the transcoded block format.
         outVkFormat = static_cast<VkFormat>(tex2->vkFormat);
         return true;
@@ -128,6 +172,8 @@ void Image::clear() noexcept
     m_channels = 0;
     m_pixels.clear();
 
+    m_contentHash = 0;
+
     m_isKtx               = false;
     m_ktxVkFormat         = VK_FORMAT_UNDEFINED;
     m_ktxNeedsTranscoding = false;
@@ -149,7 +195,8 @@ bool Image::loadFromFile(const std::filesystem::path& path, bool flipY)
         return loadKtxFromFile_(m_path);
 
     // stb route
-    stbi_set_flip_vertically_on_load(flipY);
+    // Per-thread flag: ImageHandler decodes on worker threads.
+    stbi_set_flip_vertically_on_load_thread(flipY);
     unsigned char* raw = stbi_load(m_path.string().c_str(), &m_width, &m_height, &m_channels, 0);
 
     if (!raw)
@@ -243,7 +290,7 @@ bool Image::loadFromEncodedMemory(const unsigned char* data,
     }
 
     // stb route
-    stbi_set_flip_vertically_on_load(flipY);
+    stbi_set_flip_vertically_on_load_thread(flipY);
     unsigned char* raw = stbi_load_from_memory(
         data,
         sizeInBytes,
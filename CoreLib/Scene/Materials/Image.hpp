@@ -170,6 +170,17 @@ public:
         return m_path;
     }
 
+    /// Hash of the decoded content (set by ImageHandler; 0 if unknown).
+    void setContentHash(uint64_t hash) noexcept
+    {
+        m_contentHash = hash;
+    }
+
+    [[nodiscard]] uint64_t contentHash() const noexcept
+    {
+        return m_contentHash;
+    }
+
 private:
     void clear() noexcept;
 
@@ -179,6 +190,7 @@ private:
 private:
     std::string           m_name;
     std::filesystem::path m_path;
+    uint64_t              m_contentHash = 0;
 
     // Classic pixel image
     int                        m_width    = 0;
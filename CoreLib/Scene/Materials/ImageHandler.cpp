@@ -2,7 +2,42 @@
 
 #include <iostream>
 
+#include "ContentHash.hpp"
 #include "PathUtilities.hpp"
+#include "TaskPool.hpp"
+
+// ---------------------------------------------------------
+// Async job (shared between the handler and a TaskPool worker)
+// ---------------------------------------------------------
+
+struct ImageHandler::PendingLoad
+{
+    enum State : int
+    {
+        Queued,
+        Decoded,
+        Failed,
+        Cancelled,
+    };
+
+    ImageId                    id      = kInvalidImageId;
+    std::filesystem::path      path    = {}; // file source, or empty
+    std::vector<unsigned char> encoded = {}; // memory source, or empty
+    std::string                label   = {}; // for log messages
+    bool                       flipY   = true;
+    uint64_t                   srcHash = 0; // encoded-byte hash (memory source), or 0
+
+    std::shared_ptr<std::atomic<bool>> cancel = {};
+
+    // Written by whoever claimed the job before state is released.
+    Image             result    = {};
+    uint64_t          pixelHash = 0;
+    std::atomic<int>  state{Queued};
+    std::atomic<bool> claimed{false};
+
+    // Decode on the calling thread unless another thread already claimed the job.
+    void run();
+};
 
 // ---------------------------------------------------------
 // Helpers
@@ -65,16 +100,53 @@ namespace
         // stem().string() can be empty for odd paths; keep it safe.
         return p.stem().string();
     }
+
+    // Distinct seeds keep encoded-byte and pixel hashes from colliding by construction.
+    constexpr uint64_t kEncodedSeed = 0x454E43ull; // "ENC"
+    constexpr uint64_t kPixelSeed   = 0x504958ull; // "PIX"
+    constexpr uint64_t kKtxSeed     = 0x4B5458ull; // "KTX"
+
+    [[nodiscard]] uint64_t encodedHash(std::span<const unsigned char> bytes, bool flipY) noexcept
+    {
+        return un::xxh64(bytes.data(), bytes.size(), kEncodedSeed + (flipY ? 1u : 0u));
+    }
+
+    // Hash of what ends up on the GPU; equal for the same picture from any source.
+    [[nodiscard]] uint64_t pixelHash(const Image& img) noexcept
+    {
+        if (!img.valid())
+            return 0;
+
+        if (img.isKtx())
+        {
+            const auto& data = img.ktxData();
+            return un::xxh64(data.data(), data.size(), kKtxSeed + static_cast<uint64_t>(img.ktxVkFormat()));
+        }
+
+        const int      dims[3] = {img.width(), img.height(), img.channels()};
+        const uint64_t seed    = un::xxh64(dims, sizeof(dims), kPixelSeed);
+        const size_t   bytes   = size_t(img.width()) * size_t(img.height()) * size_t(img.channels());
+
+        return un::xxh64(img.data(), bytes, seed);
+    }
 } // namespace
 
 // ---------------------------------------------------------
 // Public API
 // ---------------------------------------------------------
 
-ImageHandler::ImageHandler() : m_changeCounter{std::make_shared<SysCounter>()}
+ImageHandler::ImageHandler() :
+    m_changeCounter{std::make_shared<SysCounter>()},
+    m_cancelToken{std::make_shared<std::atomic<bool>>(false)}
 {
 }
 
+ImageHandler::~ImageHandler()
+{
+    // Workers own their jobs through shared_ptr; nothing here outlives them.
+    cancelPendingLoads();
+}
+
 ImageId ImageHandler::loadFromFile(const std::filesystem::path& path, bool flipY)
 {
     // Normalize the path (so the same file isn't loaded twice).
@@ -92,6 +164,14 @@ ImageId ImageHandler::loadFromFile(const std::filesystem::path& path, bool flipY
         return kInvalidImageId;
     }
 
+    // Same pixels under another path (copied texture files).
+    const uint64_t hash = pixelHash(img);
+    if (const ImageId existing = findByHash(hash); existing != kInvalidImageId)
+    {
+        m_pathToId.emplace(normalized, existing);
+        return existing;
+    }
+
     // Allocate ID before pushing so fallback naming can include the final ID.
     const ImageId id = static_cast<ImageId>(m_images.size());
 
@@ -109,8 +189,11 @@ ImageId ImageHandler::loadFromFile(const std::filesystem::path& path, bool flipY
 
     img.setName(makeUniqueName(m_images, baseName));
 
+    img.setContentHash(hash);
+
     m_images.push_back(std::move(img));
     m_pathToId.emplace(normalized, id);
+    m_hashToId.emplace(hash, id);
 
     m_changeCounter->change();
     return id;
@@ -123,6 +206,10 @@ ImageId ImageHandler::loadFromEncodedMemory(std::span<const unsigned char> encod
     if (encodedData.empty())
         return kInvalidImageId;
 
+    const uint64_t srcHash = encodedHash(encodedData, flipY);
+    if (const ImageId existing = findByHash(srcHash); existing != kInvalidImageId)
+        return existing;
+
     Image img;
     if (!img.loadFromEncodedMemory(encodedData.data(),
                                    static_cast<int>(encodedData.size()),
@@ -133,6 +220,14 @@ ImageId ImageHandler::loadFromEncodedMemory(std::span<const unsigned char> encod
         return kInvalidImageId;
     }
 
+    // Same picture encoded differently (or also loaded from a file).
+    const uint64_t hash = pixelHash(img);
+    if (const ImageId existing = findByHash(hash); existing != kInvalidImageId)
+    {
+        m_hashToId.emplace(srcHash, existing);
+        return existing;
+    }
+
     const ImageId id = static_cast<ImageId>(m_images.size());
 
     // Enforce non-empty name (prefer hint; otherwise deterministic fallback).
@@ -143,13 +238,167 @@ ImageId ImageHandler::loadFromEncodedMemory(std::span<const unsigned char> encod
     img.setName(makeUniqueName(m_images, baseName));
 
     // No filesystem path for embedded images.
+    img.setContentHash(hash);
 
     m_images.push_back(std::move(img));
+    m_hashToId.emplace(srcHash, id);
+    m_hashToId.emplace(hash, id);
 
     m_changeCounter->change();
     return id;
 }
 
+ImageId ImageHandler::loadFromFileAsync(const std::filesystem::path& path, bool flipY)
+{
+    const std::string normalized = PathUtil::normalizedPath(path);
+
+    if (auto it = m_pathToId.find(normalized); it != m_pathToId.end())
+        return it->second;
+
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec))
+    {
+        std::cerr << "ImageHandler::loadFromFileAsync: no such file: " << normalized << "\n";
+        return kInvalidImageId;
+    }
+
+    auto job   = std::make_shared<PendingLoad>();
+    job->path  = path;
+    job->label = normalized;
+    job->flipY = flipY;
+    job->id    = reserveSlot(stemNameOrEmpty(path), normalized);
+
+    enqueue(job);
+    return job->id;
+}
+
+ImageId ImageHandler::loadFromEncodedMemoryAsync(std::span<const unsigned char> encodedData,
+                                                 const std::string&             nameHint,
+                                                 bool                           flipY)
+{
+    if (encodedData.empty())
+        return kInvalidImageId;
+
+    // Hashing is far cheaper than decoding, so duplicates never reach the pool.
+    const uint64_t srcHash = encodedHash(encodedData, flipY);
+    if (const ImageId existing = findByHash(srcHash); existing != kInvalidImageId)
+        return existing;
+
+    auto job = std::make_shared<PendingLoad>();
+    job->encoded.assign(encodedData.begin(), encodedData.end());
+    job->label   = nameHint;
+    job->flipY   = flipY;
+    job->srcHash = srcHash;
+    job->id      = reserveSlot(nameHint, {});
+
+    m_hashToId.emplace(srcHash, job->id);
+
+    enqueue(job);
+    return job->id;
+}
+
+bool ImageHandler::isPending(ImageId id) const noexcept
+{
+    for (const auto& job : m_pending)
+    {
+        if (job->id == id)
+            return true;
+    }
+    return false;
+}
+
+uint32_t ImageHandler::pollPendingLoads()
+{
+    if (m_pending.empty())
+        return 0;
+
+    uint32_t loaded = 0;
+
+    auto it = m_pending.begin();
+    while (it != m_pending.end())
+    {
+        PendingLoad& job   = **it;
+        const int    state = job.state.load(std::memory_order_acquire);
+
+        if (state == PendingLoad::Queued)
+        {
+            ++it;
+            continue;
+        }
+
+        const bool cancelled = job.cancel->load(std::memory_order_relaxed);
+        const bool decoded   = state == PendingLoad::Decoded && !cancelled && isValidId(job.id, m_images.size());
+
+        if (const ImageId existing = decoded ? findByHash(job.pixelHash) : kInvalidImageId;
+            existing != kInvalidImageId && existing != job.id)
+        {
+            // Duplicate of an image that finished first: drop the pixels, keep the id.
+            m_aliasToId[job.id] = existing;
+            ++loaded;
+        }
+        else if (decoded)
+        {
+            Image& slot = m_images[static_cast<std::size_t>(job.id)];
+
+            job.result.setName(slot.name());
+            if (!slot.path().empty())
+                job.result.setPath(slot.path());
+
+            job.result.setContentHash(job.pixelHash);
+
+            slot = std::move(job.result);
+            m_hashToId.emplace(job.pixelHash, job.id);
+            ++loaded;
+        }
+        else
+        {
+            if (state == PendingLoad::Failed)
+                std::cerr << "ImageHandler: failed to decode image: " << job.label << "\n";
+
+            // Let a later load of the same file try again (matches the sync path).
+            if (!job.path.empty())
+                m_pathToId.erase(job.label);
+            if (job.srcHash != 0)
+                m_hashToId.erase(job.srcHash);
+
+            ++m_progress.failed;
+        }
+
+        ++m_progress.finished;
+        it = m_pending.erase(it);
+    }
+
+    if (loaded > 0)
+        m_changeCounter->change();
+
+    return loaded;
+}
+
+void ImageHandler::waitForPendingLoads()
+{
+    if (m_pending.empty())
+        return;
+
+    // Only this handler's jobs: waiting on the whole pool would deadlock when
+    // called from a pool task. Jobs no worker has started yet run right here.
+    for (const auto& job : m_pending)
+    {
+        job->run();
+        job->state.wait(PendingLoad::Queued, std::memory_order_acquire);
+    }
+
+    pollPendingLoads();
+}
+
+void ImageHandler::cancelPendingLoads()
+{
+    if (m_pending.empty())
+        return;
+
+    m_cancelToken->store(true, std::memory_order_relaxed);
+    m_cancelToken = std::make_shared<std::atomic<bool>>(false);
+}
+
 ImageId ImageHandler::createFromRaw(const unsigned char* pixels,
                                     int                  width,
                                     int                  height,
@@ -168,6 +417,10 @@ ImageId ImageHandler::createFromRaw(const unsigned char* pixels,
         return kInvalidImageId;
     }
 
+    const uint64_t hash = pixelHash(img);
+    if (const ImageId existing = findByHash(hash); existing != kInvalidImageId)
+        return existing;
+
     const ImageId id = static_cast<ImageId>(m_images.size());
 
     // Enforce non-empty name.
@@ -178,15 +431,25 @@ ImageId ImageHandler::createFromRaw(const unsigned char* pixels,
     img.setName(makeUniqueName(m_images, baseName));
 
     // No filesystem path for raw images by default.
+    img.setContentHash(hash);
 
     m_images.push_back(std::move(img));
+    m_hashToId.emplace(hash, id);
 
     m_changeCounter->change();
     return id;
 }
 
+ImageId ImageHandler::resolve(ImageId id) const noexcept
+{
+    if (auto it = m_aliasToId.find(id); it != m_aliasToId.end())
+        return it->second;
+    return id;
+}
+
 const Image* ImageHandler::get(ImageId id) const noexcept
 {
+    id = resolve(id);
     if (!isValidId(id, m_images.size()))
         return nullptr;
 
@@ -195,6 +458,7 @@ const Image* ImageHandler::get(ImageId id) const noexcept
 
 Image* ImageHandler::get(ImageId id) noexcept
 {
+    id = resolve(id);
     if (!isValidId(id, m_images.size()))
         return nullptr;
 
@@ -203,11 +467,17 @@ Image* ImageHandler::get(ImageId id) noexcept
 
 void ImageHandler::clear() noexcept
 {
+    cancelPendingLoads();
+    m_pending.clear();
+    m_progress = {};
+
     if (m_images.empty() && m_pathToId.empty())
         return;
 
     m_images.clear();
     m_pathToId.clear();
+    m_hashToId.clear();
+    m_aliasToId.clear();
 
     m_changeCounter->change();
 }
@@ -216,3 +486,87 @@ SysCounterPtr ImageHandler::changeCounter() const noexcept
 {
     return m_changeCounter;
 }
+
+// ---------------------------------------------------------
+// Async internals
+// ---------------------------------------------------------
+
+ImageId ImageHandler::reserveSlot(std::string baseName, const std::string& normalizedPath)
+{
+    const ImageId id = static_cast<ImageId>(m_images.size());
+
+    if (baseName.empty())
+        baseName = normalizedPath.empty() ? fallbackEmbeddedName(id) : fallbackRawName(id);
+
+    Image placeholder;
+    placeholder.setName(makeUniqueName(m_images, baseName));
+    if (!normalizedPath.empty())
+    {
+        placeholder.setPath(normalizedPath);
+        m_pathToId.emplace(normalizedPath, id);
+    }
+
+    m_images.push_back(std::move(placeholder));
+    return id;
+}
+
+void ImageHandler::PendingLoad::run()
+{
+    if (claimed.exchange(true, std::memory_order_acq_rel))
+        return;
+
+    int done = Cancelled;
+    if (!cancel->load(std::memory_order_relaxed))
+    {
+        // The state must leave Queued even if decoding throws (bad_alloc):
+        // waitForPendingLoads() blocks on it.
+        bool ok = false;
+        try
+        {
+            if (!path.empty())
+                ok = result.loadFromFile(path, flipY);
+            else
+                ok = result.loadFromEncodedMemory(encoded.data(), static_cast<int>(encoded.size()), flipY);
+
+            if (ok)
+                pixelHash = ::pixelHash(result);
+        }
+        catch (...)
+        {
+            ok = false;
+        }
+
+        encoded.clear();
+        encoded.shrink_to_fit();
+
+        done = ok ? Decoded : Failed;
+    }
+
+    state.store(done, std::memory_order_release);
+    state.notify_all();
+}
+
+void ImageHandler::enqueue(std::shared_ptr<PendingLoad> job)
+{
+    if (!m_progress.busy())
+        m_progress = {};
+
+    ++m_progress.queued;
+
+    job->cancel = m_cancelToken;
+    m_pending.push_back(job);
+
+    TaskPool::shared().submit([job = std::move(job)] { job->run(); });
+}
+
+ImageId ImageHandler::findByHash(uint64_t hash) const noexcept
+{
+    // 64-bit XXH64: a false match is not a practical concern at scene scale.
+    if (hash == 0)
+        return kInvalidImageId;
+
+    if (auto it = m_hashToId.find(hash); it != m_hashToId.end())
+        return it->second;
+
+    return kInvalidImageId;
+}
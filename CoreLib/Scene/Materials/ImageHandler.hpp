@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <filesystem>
+#include <memory>
 #include <span>
 #include <string>
 #include <unordered_map>
@@ -12,11 +14,34 @@
 using ImageId                     = int32_t;
 constexpr ImageId kInvalidImageId = -1;
 
+/**
+ * @brief Snapshot of asynchronous image loads since the last idle point.
+ *
+ * Counters reset once every queued load has been collected by pollPendingLoads().
+ */
+struct ImageLoadProgress
+{
+    uint32_t queued   = 0; ///< Loads requested.
+    uint32_t finished = 0; ///< Loads collected (decoded, failed or cancelled).
+    uint32_t failed   = 0; ///< Subset of finished that produced no image.
+
+    [[nodiscard]] bool busy() const noexcept
+    {
+        return finished < queued;
+    }
+};
+
 class ImageHandler
 {
 public:
     ImageHandler();
-    ~ImageHandler() = default;
+    ~ImageHandler();
+
+    ImageHandler(const ImageHandler&)            = delete;
+    ImageHandler& operator=(const ImageHandler&) = delete;
+
+    // Identical content (same decoded pixels, or same encoded bytes for memory
+    // sources) collapses onto one ImageId; see resolve() for late matches.
 
     // Load from file (PNG/JPG). Reuses existing if same normalized path.
     [[nodiscard]] ImageId loadFromFile(const std::filesystem::path& path,
@@ -27,6 +52,42 @@ public:
                                                 const std::string&             nameHint,
                                                 bool                           flipY = true);
 
+    // -----------------------------------------------------------------
+    // Asynchronous loads
+    //
+    // The ImageId is allocated immediately; its Image stays invalid (but named)
+    // until the decode finishes on a TaskPool worker and pollPendingLoads()
+    // moves the result in. Consumers treat a pending image like a missing one
+    // (TextureHandler binds the fallback texture meanwhile).
+    // -----------------------------------------------------------------
+
+    /// Like loadFromFile(), decoding off-thread. Returns kInvalidImageId only if the file does not exist.
+    [[nodiscard]] ImageId loadFromFileAsync(const std::filesystem::path& path,
+                                            bool                         flipY = true);
+
+    /// Like loadFromEncodedMemory(); @p encodedData is copied before returning.
+    [[nodiscard]] ImageId loadFromEncodedMemoryAsync(std::span<const unsigned char> encodedData,
+                                                     const std::string&             nameHint,
+                                                     bool                           flipY = true);
+
+    /// True while @p id is queued or decoding.
+    [[nodiscard]] bool isPending(ImageId id) const noexcept;
+
+    /// Collect finished decodes (main thread). Returns the number of images that became valid.
+    uint32_t pollPendingLoads();
+
+    /// Block until every load queued by this handler has finished, then collect.
+    /// Loads no worker has picked up yet are decoded on the calling thread.
+    void waitForPendingLoads();
+
+    /// Skip queued decodes that have not started; in-flight ones finish but are discarded.
+    void cancelPendingLoads();
+
+    [[nodiscard]] ImageLoadProgress loadProgress() const noexcept
+    {
+        return m_progress;
+    }
+
     // Already-decoded pixels
     [[nodiscard]] ImageId createFromRaw(const unsigned char* pixels,
                                         int                  width,
@@ -35,7 +96,16 @@ public:
                                         const std::string&   nameHint,
                                         bool                 flipY = false);
 
-    // Access
+    /**
+     * @brief Canonical id for @p id.
+     *
+     * Async loads learn their content hash only after decoding. If it matches an
+     * image that already exists, the new id becomes an alias: its slot keeps the
+     * placeholder (no pixels) and get() forwards to the canonical image.
+     */
+    [[nodiscard]] ImageId resolve(ImageId id) const noexcept;
+
+    // Access (aliases are resolved)
     [[nodiscard]] const Image* get(ImageId id) const noexcept;
     [[nodiscard]] Image*       get(ImageId id) noexcept;
 
@@ -50,9 +120,24 @@ public:
 
     [[nodiscard]] SysCounterPtr changeCounter() const noexcept;
 
+private:
+    struct PendingLoad;
+
+    ImageId reserveSlot(std::string baseName, const std::string& normalizedPath);
+    void    enqueue(std::shared_ptr<PendingLoad> job);
+
+    /// Existing image with content hash @p hash, or kInvalidImageId.
+    [[nodiscard]] ImageId findByHash(uint64_t hash) const noexcept;
+
 private:
     std::vector<Image>                       m_images;
     std::unordered_map<std::string, ImageId> m_pathToId;
+    std::unordered_map<uint64_t, ImageId>    m_hashToId  = {}; // pixel and encoded-byte hashes
+    std::unordered_map<ImageId, ImageId>     m_aliasToId = {}; // late duplicates -> canonical
 
     SysCounterPtr m_changeCounter;
+
+    std::vector<std::shared_ptr<PendingLoad>> m_pending     = {};
+    std::shared_ptr<std::atomic<bool>>        m_cancelToken = {};
+    ImageLoadProgress                         m_progress    = {};
 };
@@ -2,7 +2,8 @@
 
 #include "CoreUtilities.hpp"
 
-MaterialHandler::MaterialHandler() : m_changeCounter{std::make_shared<SysCounter>()}
+MaterialHandler::MaterialHandler() : m_changeCounter{std::make_shared<SysCounter>()},
+                                     m_structureCounter{std::make_shared<SysCounter>()}
 {
 }
 
@@ -57,6 +58,7 @@ int32_t MaterialHandler::createMaterial(std::string_view name)
             // mat.setBaseColor({0.55f, 0.55f, 0.75f, 1.f}); // default
 
             m_materials.push_back(std::move(mat));
+            m_structureCounter->change();
             m_changeCounter->change();
 
             return static_cast<int32_t>(m_materials.size() - 1);
@@ -69,6 +71,7 @@ int32_t MaterialHandler::createMaterial(std::string_view name)
 void MaterialHandler::clear()
 {
     m_materials.clear();
+    m_structureCounter->change();
     m_changeCounter->change();
 }
 
@@ -96,3 +99,8 @@ SysCounterPtr MaterialHandler::changeCounter() const
 {
     return m_changeCounter;
 }
+
+SysCounterPtr MaterialHandler::structureCounter() const
+{
+    return m_structureCounter;
+}
@@ -33,9 +33,25 @@ public:
 
     [[nodiscard]] Material& material(int index) noexcept;
 
+    /**
+     * @brief Changes on any material edit, addition or removal.
+     *
+     * Each material also has its own Material::changeCounter() (a child of
+     * this one), which tells which materials an edit touched.
+     */
     SysCounterPtr changeCounter() const;
 
+    /**
+     * @brief Changes only when materials are added or removed.
+     *
+     * While it is unchanged, material indices stay stable and consumers
+     * (the renderer's material buffer) can update just the materials whose
+     * own counter moved instead of rebuilding everything.
+     */
+    SysCounterPtr structureCounter() const;
+
 private:
     std::vector<Material> m_materials;
     SysCounterPtr         m_changeCounter;
+    SysCounterPtr         m_structureCounter;
 };
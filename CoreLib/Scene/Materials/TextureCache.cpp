@@ -0,0 +1,450 @@
+#include "TextureCache.hpp"
+
+#include <ktx.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include "Image.hpp"
+#include "TaskPool.hpp"
+
+namespace
+{
+    // Bump when the conditioning output changes; old entries are then ignored.
+    constexpr const char* kEntryPrefix = "t1_";
+
+    const char* variantTag(TextureCacheVariant v) noexcept
+    {
+        switch (v)
+        {
+            case TextureCacheVariant::ColorSrgb:
+                return "srgb";
+            case TextureCacheVariant::Linear:
+                return "lin";
+            case TextureCacheVariant::Normal:
+                return "nrm";
+            case TextureCacheVariant::Transcoded:
+                return "bc7";
+        }
+        return "unk";
+    }
+
+    uint64_t inFlightKey(uint64_t hash, TextureCacheVariant v) noexcept
+    {
+        return hash ^ (static_cast<uint64_t>(v) + 1ull) * 0x9E3779B97F4A7C15ull;
+    }
+
+    // ---------------------------------------------------------
+    // Colour space helpers
+    // ---------------------------------------------------------
+
+    const std::array<float, 256>& srgbToLinearLut() noexcept
+    {
+        static const std::array<float, 256> lut = [] {
+            std::array<float, 256> t = {};
+            for (int i = 0; i < 256; ++i)
+            {
+                const float c = static_cast<float>(i) / 255.0f;
+                t[i]          = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return t;
+        }();
+        return lut;
+    }
+
+    uint8_t linearToSrgb8(float c) noexcept
+    {
+        c             = std::clamp(c, 0.0f, 1.0f);
+        const float s = (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+        return static_cast<uint8_t>(s * 255.0f + 0.5f);
+    }
+
+    float unpackSnorm(uint8_t v) noexcept
+    {
+        return static_cast<float>(v) / 255.0f * 2.0f - 1.0f;
+    }
+
+    uint8_t packSnorm(float v) noexcept
+    {
+        return static_cast<uint8_t>(std::clamp(v * 0.5f + 0.5f, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    // ---------------------------------------------------------
+    // Mip chain (RGBA8 per level)
+    // ---------------------------------------------------------
+
+    // Expand to RGBA8 the same way TextureHandler does for direct uploads.
+    std::vector<uint8_t> toRgba8(const uint8_t* src, int w, int h, int channels, TextureCacheVariant v)
+    {
+        const size_t         count = size_t(w) * size_t(h);
+        std::vector<uint8_t> out(count * 4u);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint8_t* s = src + i * size_t(channels);
+            uint8_t*       d = out.data() + i * 4u;
+
+            switch (channels)
+            {
+                case 4:
+                    d[0] = s[0];
+                    d[1] = s[1];
+                    d[2] = s[2];
+                    d[3] = s[3];
+                    break;
+                case 3:
+                    d[0] = s[0];
+                    d[1] = s[1];
+                    d[2] = s[2];
+                    d[3] = 255;
+                    break;
+                default: // 2
+                    if (v == TextureCacheVariant::ColorSrgb)
+                    {
+                        d[0] = s[0];
+                        d[1] = s[0];
+                        d[2] = s[0];
+                        d[3] = s[1];
+                    }
+                    else
+                    {
+                        d[0] = s[0];
+                        d[1] = s[1];
+                        d[2] = 0;
+                        d[3] = 255;
+                    }
+                    break;
+            }
+
+            // Two-channel normal maps carry XY only.
+            if (v == TextureCacheVariant::Normal && channels == 2)
+            {
+                const float x = unpackSnorm(d[0]);
+                const float y = unpackSnorm(d[1]);
+                d[2]          = packSnorm(std::sqrt(std::max(0.0f, 1.0f - x * x - y * y)));
+            }
+        }
+
+        return out;
+    }
+
+    // 2x2 box filter; odd edges reuse the last row/column.
+    void downsample(const uint8_t* src, int sw, int sh, uint8_t* dst, int dw, int dh, TextureCacheVariant v)
+    {
+        const auto& lut = srgbToLinearLut();
+
+        for (int y = 0; y < dh; ++y)
+        {
+            const int y0 = std::min(2 * y, sh - 1);
+            const int y1 = std::min(2 * y + 1, sh - 1);
+
+            for (int x = 0; x < dw; ++x)
+            {
+                const int x0 = std::min(2 * x, sw - 1);
+                const int x1 = std::min(2 * x + 1, sw - 1);
+
+                const uint8_t* p[4] = {
+                    src + (size_t(y0) * size_t(sw) + size_t(x0)) * 4u,
+                    src + (size_t(y0) * size_t(sw) + size_t(x1)) * 4u,
+                    src + (size_t(y1) * size_t(sw) + size_t(x0)) * 4u,
+                    src + (size_t(y1) * size_t(sw) + size_t(x1)) * 4u,
+                };
+
+                uint8_t* d = dst + (size_t(y) * size_t(dw) + size_t(x)) * 4u;
+
+                const unsigned alphaSum = p[0][3] + p[1][3] + p[2][3] + p[3][3];
+
+                switch (v)
+                {
+                    case TextureCacheVariant::ColorSrgb: {
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            const float lin = lut[p[0][c]] + lut[p[1][c]] + lut[p[2][c]] + lut[p[3][c]];
+                            d[c]            = linearToSrgb8(lin * 0.25f);
+                        }
+                        d[3] = static_cast<uint8_t>((alphaSum + 2u) / 4u);
+                        break;
+                    }
+
+                    case TextureCacheVariant::Normal: {
+                        float n[3] = {};
+                        for (const uint8_t* s : p)
+                        {
+                            n[0] += unpackSnorm(s[0]);
+                            n[1] += unpackSnorm(s[1]);
+                            n[2] += unpackSnorm(s[2]);
+                        }
+
+                        const float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                        if (len > 1e-6f)
+                        {
+                            d[0] = packSnorm(n[0] / len);
+                            d[1] = packSnorm(n[1] / len);
+                            d[2] = packSnorm(n[2] / len);
+                        }
+                        else
+                        {
+                            d[0] = 128;
+                            d[1] = 128;
+                            d[2] = 255;
+                        }
+                        d[3] = 255;
+                        break;
+                    }
+
+                    default: {
+                        for (int c = 0; c < 4; ++c)
+                            d[c] = static_cast<uint8_t>((p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2u) / 4u);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // ---------------------------------------------------------
+    // libktx encode: RGBA8 levels -> UASTC -> BC7/BC5
+    // ---------------------------------------------------------
+
+    std::vector<uint8_t> encodeKtx2(std::vector<std::vector<uint8_t>>& levels,
+                                    int                                width,
+                                    int                                height,
+                                    TextureCacheVariant                v)
+    {
+        const bool srgb   = (v == TextureCacheVariant::ColorSrgb);
+        const bool normal = (v == TextureCacheVariant::Normal);
+
+        // The BC5 transcode reads X from R and Y from G or A depending on the
+        // source format; put Y in both.
+        if (normal)
+        {
+            for (std::vector<uint8_t>& level : levels)
+            {
+                for (size_t i = 0; i + 3 < level.size(); i += 4)
+                {
+                    level[i + 2] = 0;
+                    level[i + 3] = level[i + 1];
+                }
+            }
+        }
+
+        ktxTextureCreateInfo ci = {};
+        ci.vkFormat             = srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+        ci.baseWidth            = static_cast<ktx_uint32_t>(width);
+        ci.baseHeight           = static_cast<ktx_uint32_t>(height);
+        ci.baseDepth            = 1;
+        ci.numDimensions        = 2;
+        ci.numLevels            = static_cast<ktx_uint32_t>(levels.size());
+        ci.numLayers            = 1;
+        ci.numFaces             = 1;
+        ci.isArray              = KTX_FALSE;
+        ci.generateMipmaps      = KTX_FALSE;
+
+        ktxTexture2* tex = nullptr;
+        if (ktxTexture2_Create(&ci, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &tex) != KTX_SUCCESS || !tex)
+            return {};
+
+        for (ktx_uint32_t level = 0; level < ci.numLevels; ++level)
+        {
+            const std::vector<uint8_t>& px = levels[level];
+            if (ktxTexture_SetImageFromMemory(ktxTexture(tex), level, 0, 0, px.data(), px.size()) != KTX_SUCCESS)
+            {
+                ktxTexture_Destroy(ktxTexture(tex));
+                return {};
+            }
+        }
+
+        ktxBasisParams params = {};
+        params.structSize     = sizeof(params);
+        params.uastc          = KTX_TRUE;
+        params.uastcFlags     = KTX_PACK_UASTC_LEVEL_DEFAULT;
+        params.threadCount    = 1; // already on a pool worker
+
+        KTX_error_code ec = ktxTexture2_CompressBasisEx(tex, &params);
+        if (ec == KTX_SUCCESS)
+            ec = ktxTexture2_TranscodeBasis(tex, normal ? KTX_TTF_BC5_RG : KTX_TTF_BC7_RGBA, 0);
+
+        std::vector<uint8_t> out = {};
+        if (ec == KTX_SUCCESS)
+        {
+            ktx_uint8_t* bytes = nullptr;
+            ktx_size_t   size  = 0;
+            if (ktxTexture_WriteToMemory(ktxTexture(tex), &bytes, &size) == KTX_SUCCESS && bytes)
+            {
+                out.assign(bytes, bytes + size);
+                std::free(bytes);
+            }
+        }
+        else
+        {
+            std::cerr << "TextureCache: block compression failed: " << ktxErrorString(ec) << "\n";
+        }
+
+        ktxTexture_Destroy(ktxTexture(tex));
+        return out;
+    }
+
+} // namespace
+
+TextureCache& TextureCache::shared()
+{
+    // Intentionally leaked: pool workers may still be storing entries at exit.
+    static TextureCache* cache = new TextureCache();
+    return *cache;
+}
+
+void TextureCache::setDirectory(const std::filesystem::path& dir)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_dir = dir;
+}
+
+bool TextureCache::enabled() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_dir.empty();
+}
+
+std::filesystem::path TextureCache::entryPath(uint64_t hash, TextureCacheVariant variant) const
+{
+    static constexpr char kHex[] = "0123456789abcdef";
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_dir.empty() || hash == 0)
+        return {};
+
+    std::string name = kEntryPrefix;
+    for (int shift = 60; shift >= 0; shift -= 4)
+        name.push_back(kHex[(hash >> shift) & 0xF]);
+    name += "_";
+    name += variantTag(variant);
+    name += ".ktx2";
+
+    return m_dir / name;
+}
+
+MappedFile TextureCache::open(uint64_t hash, TextureCacheVariant variant) const
+{
+    const std::filesystem::path file = entryPath(hash, variant);
+    if (file.empty())
+        return {};
+
+    return MappedFile(file);
+}
+
+bool TextureCache::store(uint64_t hash, TextureCacheVariant variant, std::span<const uint8_t> ktx2) const
+{
+    const std::filesystem::path file = entryPath(hash, variant);
+    if (file.empty() || ktx2.empty())
+        return false;
+
+    try
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(file.parent_path(), ec);
+
+        // Unique per writer so concurrent stores of the same entry do not interleave.
+        std::filesystem::path tmp = file;
+        tmp += ".";
+        tmp += std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        tmp += ".tmp";
+
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out)
+                return false;
+
+            out.write(reinterpret_cast<const char*>(ktx2.data()), static_cast<std::streamsize>(ktx2.size()));
+            if (!out)
+                return false;
+        }
+
+        std::filesystem::rename(tmp, file, ec);
+        if (ec)
+        {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "TextureCache: write failed: " << e.what() << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+void TextureCache::conditionAsync(const Image& src, TextureCacheVariant variant)
+{
+    const uint64_t hash = src.contentHash();
+    if (hash == 0 || src.isKtx() || !src.data() || src.channels() < 2 || src.channels() > 4)
+        return;
+
+    if (!enabled())
+        return;
+
+    const uint64_t key = inFlightKey(hash, variant);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_inFlight.insert(key).second)
+            return;
+    }
+
+    const int w = src.width();
+    const int h = src.height();
+    const int c = src.channels();
+
+    std::vector<uint8_t> pixels(src.data(), src.data() + size_t(w) * size_t(h) * size_t(c));
+
+    TaskPool::shared().submit([this, key, hash, variant, w, h, c, pixels = std::move(pixels)] {
+        const std::vector<uint8_t> ktx2 = condition(pixels.data(), w, h, c, variant);
+        if (!ktx2.empty())
+            store(hash, variant, ktx2);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_inFlight.erase(key);
+    });
+}
+
+std::vector<uint8_t> TextureCache::condition(const uint8_t*      pixels,
+                                             int                 width,
+                                             int                 height,
+                                             int                 channels,
+                                             TextureCacheVariant variant)
+{
+    if (!pixels || width <= 0 || height <= 0 || channels < 2 || channels > 4 ||
+        variant == TextureCacheVariant::Transcoded)
+        return {};
+
+    // Same level count and sizes as the GPU blit chain.
+    const uint32_t mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1u;
+
+    std::vector<std::vector<uint8_t>> levels = {};
+    levels.reserve(mipLevels);
+    levels.push_back(toRgba8(pixels, width, height, channels, variant));
+
+    int w = width;
+    int h = height;
+    for (uint32_t level = 1; level < mipLevels; ++level)
+    {
+        const int dw = std::max(1, w >> 1);
+        const int dh = std::max(1, h >> 1);
+
+        std::vector<uint8_t> next(size_t(dw) * size_t(dh) * 4u);
+        downsample(levels.back().data(), w, h, next.data(), dw, dh, variant);
+
+        levels.push_back(std::move(next));
+        w = dw;
+        h = dh;
+    }
+
+    return encodeKtx2(levels, width, height, variant);
+}
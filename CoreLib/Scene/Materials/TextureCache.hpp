@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+#include "MappedFile.hpp"
+
+class Image;
+
+/**
+ * @brief What a cached texture was conditioned for (part of the cache key).
+ */
+enum class TextureCacheVariant : uint8_t
+{
+    ColorSrgb,  ///< sRGB colour: mips filtered in linear light, BC7 (sRGB).
+    Linear,     ///< Linear data / non-sRGB colour: BC7 (UNORM).
+    Normal,     ///< Tangent-space normals: renormalised mips, BC5 (XY, Z rebuilt in the shader).
+    Transcoded, ///< KTX2 Basis/UASTC source already transcoded to BC7.
+};
+
+/**
+ * @brief Content-addressed on-disk cache of GPU-ready KTX2 textures.
+ *
+ * Entries are named after a content hash plus variant, so renamed or copied
+ * sources hit the same entry and edited ones miss it. Nothing is ever
+ * invalidated in place; a stale directory can simply be deleted.
+ *
+ * - Decoded PNG/JPG images (keyed by Image::contentHash()) are conditioned on
+ *   TaskPool workers: a CPU mip chain (see TextureCacheVariant) is encoded to
+ *   UASTC and transcoded to BC7/BC5 with libktx. The first session uploads the
+ *   plain pixels as before; later ones upload the cached KTX2 through the
+ *   regular KTX path (no GPU mip blits, ~4x less VRAM).
+ * - Basis-supercompressed KTX2 sources store their BC7 transcode, so the
+ *   transcoder runs once per texture rather than once per load.
+ *
+ * Disabled until setDirectory() is given a non-empty path.
+ */
+class TextureCache
+{
+public:
+    /// Process-wide cache (configured by the application at startup).
+    [[nodiscard]] static TextureCache& shared();
+
+    void setDirectory(const std::filesystem::path& dir);
+
+    [[nodiscard]] bool enabled() const;
+
+    /// Map the cached KTX2 for (@p hash, @p variant); invalid mapping on a miss.
+    [[nodiscard]] MappedFile open(uint64_t hash, TextureCacheVariant variant) const;
+
+    /// Store a finished KTX2 (temp file + rename). Returns true if written.
+    bool store(uint64_t hash, TextureCacheVariant variant, std::span<const uint8_t> ktx2) const;
+
+    /**
+     * @brief Condition @p src for @p variant on a worker and store the result.
+     *
+     * Pixels are copied, so @p src may go away immediately. Requests for an
+     * entry that is already being built are ignored.
+     */
+    void conditionAsync(const Image& src, TextureCacheVariant variant);
+
+    /**
+     * @brief Build the mip chain and block-compress it (any thread).
+     * @return KTX2 file bytes, or empty on failure.
+     */
+    [[nodiscard]] static std::vector<uint8_t> condition(const uint8_t*      pixels,
+                                                        int                 width,
+                                                        int                 height,
+                                                        int                 channels,
+                                                        TextureCacheVariant variant);
+
+private:
+    TextureCache() = default;
+
+    [[nodiscard]] std::filesystem::path entryPath(uint64_t hash, TextureCacheVariant variant) const;
+
+private:
+    mutable std::mutex           m_mutex    = {};
+    std::filesystem::path        m_dir      = {};
+    std::unordered_set<uint64_t> m_inFlight = {};
+};
@@ -1,5 +1,8 @@
 #include "SceneMesh.hpp"
 
+#include <algorithm>
+#include <glm/gtx/compatibility.hpp>
+
 #include "MeshGpuResources.hpp"
 
 SceneMesh::SceneMesh() : m_mesh{std::make_unique<SysMesh>()}
@@ -30,7 +33,8 @@ glm::mat4 SceneMesh::model() const noexcept
 
 void SceneMesh::model(const glm::mat4& mtx) noexcept
 {
-    m_model = mtx;
+    m_model            = mtx;
+    m_worldBoundsDirty = true;
     m_changeCounter->change();
 }
 
@@ -105,3 +109,61 @@ SysCounterPtr SceneMesh::changeCounter() const noexcept
 {
     return m_changeCounter;
 }
+
+const un::aabb& SceneMesh::localBounds() const noexcept
+{
+    const uint64_t topo   = m_mesh->topology_counter()->value();
+    const uint64_t deform = m_mesh->deform_counter()->value();
+
+    if (topo == m_boundsTopologyStamp && deform == m_boundsDeformStamp)
+        return m_localBounds;
+
+    un::aabb b = {};
+    for (int32_t vi : m_mesh->all_verts())
+    {
+        const glm::vec3& p = m_mesh->vert_position(vi);
+
+        // Skip NaN/Inf verts so one bad import value does not poison the box.
+        if (!glm::all(glm::isfinite(p)))
+            continue;
+
+        b.expand(p);
+    }
+
+    m_localBounds         = b;
+    m_boundsTopologyStamp = topo;
+    m_boundsDeformStamp   = deform;
+    m_worldBoundsDirty    = true;
+
+    return m_localBounds;
+}
+
+const un::aabb& SceneMesh::worldBounds() const noexcept
+{
+    const un::aabb& local = localBounds();
+
+    if (m_worldBoundsDirty)
+    {
+        m_worldBounds      = un::transform_aabb(local, m_model);
+        m_worldBoundsDirty = false;
+    }
+
+    return m_worldBounds;
+}
+
+const std::vector<uint32_t>& SceneMesh::materialIds() const
+{
+    const uint64_t topo = m_mesh->topology_counter()->value();
+    if (topo == m_materialIdsStamp)
+        return m_materialIds;
+
+    m_materialIds.clear();
+    for (int32_t pi : m_mesh->all_polys())
+        m_materialIds.push_back(m_mesh->poly_material(pi));
+
+    std::sort(m_materialIds.begin(), m_materialIds.end());
+    m_materialIds.erase(std::unique(m_materialIds.begin(), m_materialIds.end()), m_materialIds.end());
+
+    m_materialIdsStamp = topo;
+    return m_materialIds;
+}
@@ -6,7 +6,9 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
+#include "Frustum.hpp"
 #include "MeshGpuResources.hpp"
 #include "SceneObject.hpp"
 #include "SubdivEvaluator.hpp"
@@ -129,6 +131,31 @@ public:
      */
     [[nodiscard]] SysCounterPtr changeCounter() const noexcept;
 
+    /**
+     * @brief Returns the object-space bounds of the coarse cage.
+     *
+     * Cached and refreshed lazily when the SysMesh topology or deform
+     * counters move. The subdivided surface lies inside the cage's
+     * convex hull, so these bounds are valid at every subdivision level.
+     *
+     * @return Local AABB (invalid for an empty mesh).
+     */
+    [[nodiscard]] const un::aabb& localBounds() const noexcept;
+
+    /**
+     * @brief Returns the world-space bounds (localBounds() through model()).
+     * @return World AABB (invalid for an empty mesh).
+     */
+    [[nodiscard]] const un::aabb& worldBounds() const noexcept;
+
+    /**
+     * @brief Returns the distinct material ids used by the mesh's polygons.
+     *
+     * Cached and refreshed lazily when the SysMesh topology counter moves
+     * (poly material edits bump it too). Sorted ascending.
+     */
+    [[nodiscard]] const std::vector<uint32_t>& materialIds() const;
+
 private:
     /** @brief CPU mesh data (authoritative). */
     std::unique_ptr<SysMesh> m_mesh;
@@ -156,4 +183,25 @@ private:
 
     /** @brief Current subdivision level. */
     int m_subdivisionLevel = 0;
+
+    /** @brief Cached object-space bounds. */
+    mutable un::aabb m_localBounds = {};
+
+    /** @brief Cached world-space bounds. */
+    mutable un::aabb m_worldBounds = {};
+
+    /** @brief Topology counter value m_localBounds was built from. */
+    mutable uint64_t m_boundsTopologyStamp = ~0ull;
+
+    /** @brief Deform counter value m_localBounds was built from. */
+    mutable uint64_t m_boundsDeformStamp = ~0ull;
+
+    /** @brief True when m_worldBounds must be rebuilt (model or local bounds changed). */
+    mutable bool m_worldBoundsDirty = true;
+
+    /** @brief Cached distinct poly material ids. */
+    mutable std::vector<uint32_t> m_materialIds = {};
+
+    /** @brief Topology counter value m_materialIds was built from. */
+    mutable uint64_t m_materialIdsStamp = ~0ull;
 };
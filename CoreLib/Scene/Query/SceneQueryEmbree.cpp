@@ -434,6 +434,48 @@ void SceneQueryEmbree::rebuildMesh(Scene* scene, SceneMesh* /*mesh*/)
     buildForScene(scene);
 }
 
+// --------------------------------------------------------
+// Read access (renderers)
+// --------------------------------------------------------
+
+uint32_t SceneQueryEmbree::geometryCount() const noexcept
+{
+    return static_cast<uint32_t>(m_meshes.size());
+}
+
+SceneMesh* SceneQueryEmbree::meshForGeometry(uint32_t geomId) const noexcept
+{
+    if (geomId >= m_meshes.size())
+        return nullptr;
+
+    return m_meshes[geomId].owner;
+}
+
+uint32_t SceneQueryEmbree::primitiveCount(uint32_t geomId) const noexcept
+{
+    if (geomId >= m_meshes.size())
+        return 0;
+
+    return static_cast<uint32_t>(m_meshes[geomId].triToPoly.size());
+}
+
+bool SceneQueryEmbree::primitive(uint32_t            geomId,
+                                 uint32_t            primId,
+                                 int&                outPoly,
+                                 std::array<int, 3>& outVerts) const noexcept
+{
+    if (geomId >= m_meshes.size())
+        return false;
+
+    const MeshAccel& accel = m_meshes[geomId];
+    if (!accel.owner || primId >= accel.triToPoly.size())
+        return false;
+
+    outPoly  = accel.triToPoly[primId];
+    outVerts = accel.triToVerts[primId];
+    return true;
+}
+
 // --------------------------------------------------------
 // Vertices – closest hit via Embree
 // --------------------------------------------------------
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <vector>
 
 #include "CoreTypes.hpp"    // for un::ray
@@ -45,6 +47,28 @@ public:
                                     const Scene*    scene,
                                     const un::ray&  ray) const override;
 
+    // --------------------------------------------------------
+    // Read access for renderers tracing the same BVH (CpuPathTracer)
+    // --------------------------------------------------------
+    // Geometry is in mesh space; geometry ids run [0, geometryCount()) and
+    // may have gaps (meshForGeometry() == nullptr). The scene is replaced
+    // on rebuild(), so do not keep these across Scene::idle().
+
+    [[nodiscard]] RTCScene rtcScene() const noexcept
+    {
+        return m_rtcScene;
+    }
+
+    [[nodiscard]] uint32_t   geometryCount() const noexcept;
+    [[nodiscard]] SceneMesh* meshForGeometry(uint32_t geomId) const noexcept;
+    [[nodiscard]] uint32_t   primitiveCount(uint32_t geomId) const noexcept;
+
+    /// Source polygon and SysMesh vertex indices of triangle @p primId (a fan triangle of the polygon).
+    [[nodiscard]] bool primitive(uint32_t            geomId,
+                                 uint32_t            primId,
+                                 int&                outPoly,
+                                 std::array<int, 3>& outVerts) const noexcept;
+
 private:
     struct MeshAccel;
 
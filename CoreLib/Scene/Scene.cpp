@@ -81,7 +81,8 @@ void Scene::clear()
     m_materialHandler->clear();
     m_lightHandler->clear();
     m_imageHandler->clear();
-    m_textureHandler->destroyAll();
+    if (m_textureHandler) // Created by initDevice(); absent for headless scenes.
+        m_textureHandler->destroyAll();
 
     // Ensure default material at index 0.
     m_materialHandler->createMaterial("Default");
@@ -478,9 +479,29 @@ SceneStats Scene::stats() const noexcept
     return s;
 }
 
+RenderStats Scene::renderStats() const noexcept
+{
+    RenderStats r = m_renderer ? m_renderer->renderStats() : RenderStats{};
+
+    if (m_textureHandler)
+        r.texturesPending = static_cast<unsigned int>(m_textureHandler->pendingUploadCount());
+
+    return r;
+}
+
 bool Scene::needsRender() noexcept
 {
-    return m_sceneChangeMonitor.changed();
+    const bool changed = m_sceneChangeMonitor.changed();
+
+    // Keep frames coming while textures stream in; each frame publishes what has landed.
+    const bool streaming = (m_textureHandler && (m_textureHandler->pendingUploadCount() > 0 ||
+                                                  m_textureHandler->isStreaming())) ||
+                           m_imageHandler->loadProgress().busy();
+
+    // Ray-traced viewports refine progressively until they converge.
+    const bool accumulating = m_renderer && m_renderer->rtAccumulating();
+
+    return changed || streaming || accumulating;
 }
 
 void Scene::markModified() noexcept
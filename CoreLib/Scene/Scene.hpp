@@ -342,6 +342,12 @@ public:
      */
     [[nodiscard]] SceneStats stats() const noexcept;
 
+    /**
+     * @brief Retrieve renderer culling statistics (last frame, all viewports).
+     * @return RenderStats structure
+     */
+    [[nodiscard]] RenderStats renderStats() const noexcept;
+
     /**
      * @brief Check whether rendering is required.
      * @return True if a redraw is needed
@@ -0,0 +1,369 @@
+#include "GltfMeshopt.hpp"
+
+#include <tiny_gltf.h>
+
+#include <cstring>
+#include <json.hpp> // nlohmann, bundled with TinyGLTF
+#include <meshoptimizer.h>
+#include <string>
+#include <string_view>
+
+#include "TaskPool.hpp"
+
+namespace
+{
+    constexpr uint32_t kGlbMagic     = 0x46546C67u; // "glTF"
+    constexpr uint32_t kGlbChunkJson = 0x4E4F534Au; // "JSON"
+    constexpr size_t   kGlbHeader    = 12;
+    constexpr size_t   kChunkHeader  = 8;
+
+    // Four zero bytes. Views that point into the fallback buffer are never
+    // read: decode() re-points them before any accessor is touched.
+    constexpr const char* kPlaceholderUri    = "data:application/octet-stream;base64,AAAAAA==";
+    constexpr size_t      kPlaceholderLength = 4;
+
+    // Upper bound on one decoded view, checked before allocating. Well above
+    // any real asset; stops a bogus count from turning into a huge resize.
+    constexpr size_t kMaxDecodedBytes = size_t(1) << 30;
+
+    uint32_t readU32(const uint8_t* p) noexcept
+    {
+        uint32_t v = 0;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    void appendU32(std::vector<uint8_t>& out, uint32_t v)
+    {
+        uint8_t b[4];
+        std::memcpy(b, &v, sizeof(v));
+        out.insert(out.end(), b, b + 4);
+    }
+
+    bool isFallbackBuffer(const nlohmann::json& buffer)
+    {
+        if (buffer.contains("uri"))
+            return false;
+
+        const auto ext = buffer.find("extensions");
+        if (ext == buffer.end() || !ext->is_object())
+            return false;
+
+        const auto meshopt = ext->find(gltf_meshopt::kExtension);
+        if (meshopt == ext->end() || !meshopt->is_object())
+            return false;
+
+        const auto fallback = meshopt->find("fallback");
+        return fallback != meshopt->end() && fallback->is_boolean() && fallback->get<bool>();
+    }
+
+    /// Returns the patched JSON text, or empty when nothing changed.
+    std::string patchJson(std::string_view text)
+    {
+        if (text.find(gltf_meshopt::kExtension) == std::string_view::npos)
+            return {};
+
+        nlohmann::json doc = nlohmann::json::parse(text, nullptr, false);
+        if (doc.is_discarded() || !doc.is_object())
+            return {}; // Let TinyGLTF report the parse error.
+
+        auto buffers = doc.find("buffers");
+        if (buffers == doc.end() || !buffers->is_array())
+            return {};
+
+        bool changed = false;
+        for (nlohmann::json& buffer : *buffers)
+        {
+            if (!buffer.is_object() || !isFallbackBuffer(buffer))
+                continue;
+
+            buffer["uri"]        = kPlaceholderUri;
+            buffer["byteLength"] = kPlaceholderLength;
+            changed              = true;
+        }
+
+        return changed ? doc.dump() : std::string{};
+    }
+
+    enum class Mode
+    {
+        Attributes,
+        Triangles,
+        Indices,
+    };
+
+    enum class Filter
+    {
+        None,
+        Octahedral,
+        Quaternion,
+        Exponential,
+    };
+
+    struct DecodeJob
+    {
+        int                  view   = -1;
+        const uint8_t*       src    = nullptr;
+        size_t               size   = 0;
+        size_t               count  = 0;
+        size_t               stride = 0;
+        Mode                 mode   = Mode::Attributes;
+        Filter               filter = Filter::None;
+        std::vector<uint8_t> out    = {};
+        bool                 ok     = false;
+    };
+
+    size_t numberOr(const tinygltf::Value& obj, const char* key, size_t fallback)
+    {
+        if (!obj.Has(key) || !obj.Get(key).IsNumber())
+            return fallback;
+
+        const double v = obj.Get(key).GetNumberAsDouble();
+        return v >= 0.0 ? static_cast<size_t>(v) : fallback;
+    }
+
+    std::string stringOr(const tinygltf::Value& obj, const char* key, const char* fallback)
+    {
+        if (!obj.Has(key) || !obj.Get(key).IsString())
+            return fallback;
+        return obj.Get(key).Get<std::string>();
+    }
+
+    /// Validates the extension object and fills @p job; the error text goes to @p why.
+    bool setupJob(const tinygltf::Model& model, const tinygltf::Value& ext, DecodeJob& job, std::string& why)
+    {
+        const size_t buffer = numberOr(ext, "buffer", SIZE_MAX);
+        if (buffer >= model.buffers.size())
+        {
+            why = "invalid buffer";
+            return false;
+        }
+
+        const std::vector<unsigned char>& data = model.buffers[buffer].data;
+
+        const size_t offset = numberOr(ext, "byteOffset", 0);
+        job.size            = numberOr(ext, "byteLength", SIZE_MAX);
+        job.count           = numberOr(ext, "count", SIZE_MAX);
+        job.stride          = numberOr(ext, "byteStride", 0);
+
+        if (job.size == SIZE_MAX || offset > data.size() || job.size > data.size() - offset)
+        {
+            why = "byte range out of bounds";
+            return false;
+        }
+
+        if (job.count == SIZE_MAX || job.stride == 0 || job.stride > 256 || job.count > SIZE_MAX / job.stride)
+        {
+            why = "invalid count/byteStride";
+            return false;
+        }
+
+        const std::string mode   = stringOr(ext, "mode", "");
+        const std::string filter = stringOr(ext, "filter", "NONE");
+
+        if (mode == "ATTRIBUTES")
+            job.mode = Mode::Attributes;
+        else if (mode == "TRIANGLES")
+            job.mode = Mode::Triangles;
+        else if (mode == "INDICES")
+            job.mode = Mode::Indices;
+        else
+        {
+            why = "unknown mode '" + mode + "'";
+            return false;
+        }
+
+        if (filter == "NONE")
+            job.filter = Filter::None;
+        else if (filter == "OCTAHEDRAL")
+            job.filter = Filter::Octahedral;
+        else if (filter == "QUATERNION")
+            job.filter = Filter::Quaternion;
+        else if (filter == "EXPONENTIAL")
+            job.filter = Filter::Exponential;
+        else
+        {
+            why = "unknown filter '" + filter + "'";
+            return false;
+        }
+
+        const bool indexStride = job.stride == 2 || job.stride == 4;
+        if (job.mode == Mode::Attributes ? (job.stride % 4u) != 0u : !indexStride)
+        {
+            why = "byteStride not valid for the mode";
+            return false;
+        }
+
+        if (job.mode == Mode::Triangles && (job.count % 3u) != 0u)
+        {
+            why = "TRIANGLES count is not a multiple of 3";
+            return false;
+        }
+
+        if (job.mode != Mode::Attributes && job.filter != Filter::None)
+        {
+            why = "filters only apply to ATTRIBUTES";
+            return false;
+        }
+
+        // Strides the filters are defined for (EXPONENTIAL: any multiple of 4, checked above).
+        if ((job.filter == Filter::Octahedral && job.stride != 4 && job.stride != 8) ||
+            (job.filter == Filter::Quaternion && job.stride != 8))
+        {
+            why = "byteStride not valid for the filter";
+            return false;
+        }
+
+        // Index codecs spend at least one byte per triangle / index.
+        const size_t minSize = job.mode == Mode::Triangles ? job.count / 3u : job.mode == Mode::Indices ? job.count : 0u;
+        if (job.count * job.stride > kMaxDecodedBytes || job.size < minSize)
+        {
+            why = "count too large for the compressed data";
+            return false;
+        }
+
+        job.src = data.data() + offset;
+        return true;
+    }
+
+    void runJob(DecodeJob& job)
+    {
+        job.out.resize(job.count * job.stride);
+
+        int rc = -1;
+        switch (job.mode)
+        {
+            case Mode::Attributes:
+                rc = meshopt_decodeVertexBuffer(job.out.data(), job.count, job.stride, job.src, job.size);
+                break;
+            case Mode::Triangles:
+                rc = meshopt_decodeIndexBuffer(job.out.data(), job.count, job.stride, job.src, job.size);
+                break;
+            case Mode::Indices:
+                rc = meshopt_decodeIndexSequence(job.out.data(), job.count, job.stride, job.src, job.size);
+                break;
+        }
+
+        if (rc != 0)
+            return;
+
+        switch (job.filter)
+        {
+            case Filter::None:
+                break;
+            case Filter::Octahedral:
+                meshopt_decodeFilterOct(job.out.data(), job.count, job.stride);
+                break;
+            case Filter::Quaternion:
+                meshopt_decodeFilterQuat(job.out.data(), job.count, job.stride);
+                break;
+            case Filter::Exponential:
+                meshopt_decodeFilterExp(job.out.data(), job.count, job.stride);
+                break;
+        }
+
+        job.ok = true;
+    }
+} // namespace
+
+namespace gltf_meshopt
+{
+    bool patchFallbackBuffers(std::span<const uint8_t> file, bool isGlb, std::vector<uint8_t>& out)
+    {
+        if (!isGlb)
+        {
+            const std::string json = patchJson({reinterpret_cast<const char*>(file.data()), file.size()});
+            if (json.empty())
+                return false;
+
+            out.assign(json.begin(), json.end());
+            return true;
+        }
+
+        // GLB: header, JSON chunk, then (optionally) the BIN chunk, which is copied as-is.
+        if (file.size() < kGlbHeader + kChunkHeader || readU32(file.data()) != kGlbMagic)
+            return false;
+
+        const size_t jsonLength = readU32(file.data() + kGlbHeader);
+        if (readU32(file.data() + kGlbHeader + 4) != kGlbChunkJson || jsonLength > file.size() - kGlbHeader - kChunkHeader)
+            return false;
+
+        const uint8_t* jsonBegin = file.data() + kGlbHeader + kChunkHeader;
+        std::string    json      = patchJson({reinterpret_cast<const char*>(jsonBegin), jsonLength});
+        if (json.empty())
+            return false;
+
+        json.resize((json.size() + 3u) & ~size_t(3), ' ');
+
+        const std::span<const uint8_t> rest = file.subspan(kGlbHeader + kChunkHeader + jsonLength);
+
+        out.clear();
+        out.reserve(kGlbHeader + kChunkHeader + json.size() + rest.size());
+        appendU32(out, kGlbMagic);
+        appendU32(out, 2);
+        appendU32(out, static_cast<uint32_t>(kGlbHeader + kChunkHeader + json.size() + rest.size()));
+        appendU32(out, static_cast<uint32_t>(json.size()));
+        appendU32(out, kGlbChunkJson);
+        out.insert(out.end(), json.begin(), json.end());
+        out.insert(out.end(), rest.begin(), rest.end());
+        return true;
+    }
+
+    bool decode(tinygltf::Model& model, SceneIOReport& report)
+    {
+        std::vector<DecodeJob> jobs;
+
+        for (size_t i = 0; i < model.bufferViews.size(); ++i)
+        {
+            const tinygltf::BufferView& view = model.bufferViews[i];
+
+            const auto it = view.extensions.find(kExtension);
+            if (it == view.extensions.end())
+                continue;
+
+            DecodeJob   job;
+            std::string why;
+            job.view = static_cast<int>(i);
+
+            if (!setupJob(model, it->second, job, why))
+            {
+                report.error("glTF: " + std::string(kExtension) + " bufferView " + std::to_string(i) + ": " + why);
+                report.status = SceneIOStatus::ParseError;
+                return false;
+            }
+
+            jobs.push_back(std::move(job));
+        }
+
+        if (jobs.empty())
+            return true;
+
+        TaskPool::shared().parallelFor(static_cast<uint32_t>(jobs.size()), [&](uint32_t i) { runJob(jobs[i]); });
+
+        // Source pointers are dead from here on: appending buffers may reallocate.
+        for (DecodeJob& job : jobs)
+        {
+            if (!job.ok)
+            {
+                report.error("glTF: " + std::string(kExtension) + " bufferView " + std::to_string(job.view) + ": corrupt compressed data.");
+                report.status = SceneIOStatus::ParseError;
+                return false;
+            }
+
+            tinygltf::Buffer decoded;
+            decoded.data = std::move(job.out);
+
+            tinygltf::BufferView& view = model.bufferViews[job.view];
+            view.buffer                = static_cast<int>(model.buffers.size());
+            view.byteOffset            = 0;
+            view.byteLength            = decoded.data.size();
+            view.extensions.erase(kExtension);
+
+            model.buffers.push_back(std::move(decoded));
+        }
+
+        report.info("glTF: decoded " + std::to_string(jobs.size()) + " meshopt-compressed buffer views.");
+        return true;
+    }
+
+} // namespace gltf_meshopt
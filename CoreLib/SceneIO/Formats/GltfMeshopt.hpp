@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "SceneFormat.hpp"
+
+namespace tinygltf
+{
+    class Model;
+}
+
+/**
+ * @brief EXT_meshopt_compression support for the glTF loader.
+ *
+ * Compressed buffer views carry their payload in an extension object and
+ * point the regular view at a "fallback" buffer that usually has no data at
+ * all (no uri). TinyGLTF refuses such buffers, so the document is patched
+ * before parsing, and the views are decoded (meshoptimizer, SIMD) into new
+ * buffers right after. The rest of the loader then reads plain accessors.
+ */
+namespace gltf_meshopt
+{
+    inline constexpr const char* kExtension = "EXT_meshopt_compression";
+
+    /**
+     * @brief Give data-less fallback buffers a tiny inline payload.
+     *
+     * @param file  Whole .gltf or .glb file.
+     * @param out   Patched file, only written when the function returns true.
+     * @return True if the document needed patching.
+     */
+    [[nodiscard]] bool patchFallbackBuffers(std::span<const uint8_t> file, bool isGlb, std::vector<uint8_t>& out);
+
+    /**
+     * @brief Decode every compressed buffer view in place, one TaskPool job per view.
+     *
+     * Decoded bytes are appended as new buffers and the views re-pointed at
+     * them; the extension object is removed from each decoded view.
+     */
+    bool decode(tinygltf::Model& model, SceneIOReport& report);
+
+} // namespace gltf_meshopt
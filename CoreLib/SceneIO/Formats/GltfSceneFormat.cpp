@@ -8,11 +8,14 @@
 
 #define TINYGLTF_IMPLEMENTATION
 #define TINYGLTF_NO_STB_IMAGE_WRITE
+#define TINYGLTF_NO_EXTERNAL_IMAGE // uri images are read by ImageHandler's async loads
 #include <tiny_gltf.h>
 
 #include <ImageHandler.hpp>
 #include <SysMesh.hpp>
 #include <algorithm>
+#include <bit>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <filesystem>
@@ -20,14 +23,22 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <limits>
+#include <numeric>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
+#include "GltfMeshopt.hpp"
+#include "GltfWriter.hpp"
 #include "Light.hpp"
 #include "LightHandler.hpp"
+#include "MappedFile.hpp"
 #include "MaterialHandler.hpp"
 #include "Scene.hpp"
+#include "SceneIOUtils.hpp"
 #include "SceneMesh.hpp"
+#include "TaskPool.hpp"
 
 namespace
 {
@@ -138,6 +149,9 @@ namespace
     // ------------------------------------------------------------
     // TinyGLTF image loader override:
     // Store encoded bytes (PNG/JPG/KTX2/etc) and do NOT stb-decode.
+    // Only data: URIs need it; bufferView images are read straight
+    // from the buffer at import and external files are never loaded
+    // by TinyGLTF (TINYGLTF_NO_EXTERNAL_IMAGE).
     // ------------------------------------------------------------
     static bool storeEncodedImageLoader(tinygltf::Image*     image,
                                         const int            image_idx,
@@ -155,6 +169,9 @@ namespace
         (void)req_height;
         (void)user_data;
 
+        if (image && image->bufferView >= 0)
+            return true;
+
         if (!image || !bytes || size <= 0)
         {
             if (err)
@@ -170,78 +187,78 @@ namespace
         return true;
     }
 
-    static bool readAccessorVec3Float(const tinygltf::Model&    model,
-                                      const tinygltf::Accessor& accessor,
-                                      std::vector<glm::vec3>&   out,
-                                      SceneIOReport&            report,
-                                      const char*               label)
+    // ------------------------------------------------------------
+    // Vertex attribute decode
+    //
+    // FLOAT, plus the integer / normalized component types allowed by
+    // KHR_mesh_quantization. Normalized values map to [0,1] / [-1,1] as in
+    // the spec; plain integers convert as-is (the node transform carries
+    // the dequantization scale, and we bake it like any other transform).
+    // Each component type gets its own tight loop so the conversion
+    // vectorizes.
+    // ------------------------------------------------------------
+    template <typename T, glm::length_t N>
+    static void convertComponents(const unsigned char* data, size_t stride, size_t count, bool normalized, glm::vec<N, float>* out) noexcept
     {
-        out.clear();
-
-        if (accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT || accessor.type != TINYGLTF_TYPE_VEC3)
+        // Signed normalized: -128 and -127 both mean -1. Plain integers keep
+        // their full range, so the floor only applies when normalized.
+        float scale = 1.0f;
+        float floor = std::numeric_limits<float>::lowest();
+        if constexpr (std::is_integral_v<T>)
         {
-            report.error(std::string("glTF: expected VEC3/FLOAT for ") + label);
-            return false;
-        }
-
-        if (accessor.bufferView < 0 || accessor.bufferView >= static_cast<int>(model.bufferViews.size()))
-        {
-            report.error(std::string("glTF: invalid bufferView for ") + label);
-            return false;
-        }
-
-        const tinygltf::BufferView& view = model.bufferViews[accessor.bufferView];
-        if (view.buffer < 0 || view.buffer >= static_cast<int>(model.buffers.size()))
-        {
-            report.error(std::string("glTF: invalid buffer index for ") + label);
-            return false;
-        }
-
-        const tinygltf::Buffer& buf = model.buffers[view.buffer];
-
-        const size_t baseOffset = static_cast<size_t>(view.byteOffset) + static_cast<size_t>(accessor.byteOffset);
-        if (baseOffset >= buf.data.size())
-        {
-            report.error(std::string("glTF: buffer range out of bounds for ") + label);
-            return false;
+            if (normalized)
+            {
+                scale = 1.0f / static_cast<float>(std::numeric_limits<T>::max());
+                floor = -1.0f;
+            }
         }
 
-        const unsigned char* data  = buf.data.data() + baseOffset;
-        const size_t         count = static_cast<size_t>(accessor.count);
-
-        const size_t stride =
-            (view.byteStride > 0)
-                ? static_cast<size_t>(view.byteStride)
-                : sizeof(float) * 3u;
-
-        if (stride < sizeof(float) * 3u)
+        for (size_t i = 0; i < count; ++i)
         {
-            report.error(std::string("glTF: invalid stride for ") + label);
-            return false;
-        }
+            T v[N];
+            std::memcpy(v, data + i * stride, sizeof(v));
 
-        out.resize(count);
+            for (glm::length_t c = 0; c < N; ++c)
+            {
+                out[i][c] = static_cast<float>(v[c]) * scale;
 
-        for (size_t i = 0; i < count; ++i)
-        {
-            const float* pf = reinterpret_cast<const float*>(data + i * stride);
-            out[i]          = glm::vec3(pf[0], pf[1], pf[2]);
+                if constexpr (std::is_signed_v<T> && std::is_integral_v<T>)
+                    out[i][c] = std::max(out[i][c], floor);
+            }
         }
-
-        return true;
     }
 
-    static bool readAccessorVec2Float(const tinygltf::Model&    model,
-                                      const tinygltf::Accessor& accessor,
-                                      std::vector<glm::vec2>&   out,
-                                      SceneIOReport&            report,
-                                      const char*               label)
+    template <glm::length_t N>
+    static bool readAccessorVecFloat(const tinygltf::Model&           model,
+                                     const tinygltf::Accessor&        accessor,
+                                     int                              expectedType,
+                                     std::vector<glm::vec<N, float>>& out,
+                                     SceneIOReport&                   report,
+                                     const char*                      label)
     {
         out.clear();
 
-        if (accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT || accessor.type != TINYGLTF_TYPE_VEC2)
+        size_t componentSize = 0;
+        switch (accessor.componentType)
         {
-            report.error(std::string("glTF: expected VEC2/FLOAT for ") + label);
+            case TINYGLTF_COMPONENT_TYPE_FLOAT:
+                componentSize = 4;
+                break;
+            case TINYGLTF_COMPONENT_TYPE_BYTE:
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+                componentSize = 1;
+                break;
+            case TINYGLTF_COMPONENT_TYPE_SHORT:
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+                componentSize = 2;
+                break;
+            default:
+                break;
+        }
+
+        if (componentSize == 0 || accessor.type != expectedType)
+        {
+            report.error(std::string("glTF: expected VEC") + std::to_string(N) + " FLOAT/(U)BYTE/(U)SHORT for " + label);
             return false;
         }
 
@@ -260,38 +277,74 @@ namespace
 
         const tinygltf::Buffer& buf = model.buffers[view.buffer];
 
-        const size_t baseOffset = static_cast<size_t>(view.byteOffset) + static_cast<size_t>(accessor.byteOffset);
-        if (baseOffset >= buf.data.size())
-        {
-            report.error(std::string("glTF: buffer range out of bounds for ") + label);
-            return false;
-        }
-
-        const unsigned char* data  = buf.data.data() + baseOffset;
-        const size_t         count = static_cast<size_t>(accessor.count);
+        const size_t count    = static_cast<size_t>(accessor.count);
+        const size_t elemSize = componentSize * N;
 
         const size_t stride =
             (view.byteStride > 0)
                 ? static_cast<size_t>(view.byteStride)
-                : sizeof(float) * 2u;
+                : elemSize;
 
-        if (stride < sizeof(float) * 2u)
+        if (stride < elemSize)
         {
             report.error(std::string("glTF: invalid stride for ") + label);
             return false;
         }
 
+        const size_t baseOffset = static_cast<size_t>(view.byteOffset) + static_cast<size_t>(accessor.byteOffset);
+        if (count == 0)
+            return true;
+
+        if (baseOffset >= buf.data.size() || (count - 1u) * stride + elemSize > buf.data.size() - baseOffset)
+        {
+            report.error(std::string("glTF: buffer range out of bounds for ") + label);
+            return false;
+        }
+
+        const unsigned char* data = buf.data.data() + baseOffset;
+
         out.resize(count);
 
-        for (size_t i = 0; i < count; ++i)
+        switch (accessor.componentType)
         {
-            const float* pf = reinterpret_cast<const float*>(data + i * stride);
-            out[i]          = glm::vec2(pf[0], pf[1]);
+            case TINYGLTF_COMPONENT_TYPE_FLOAT:
+                convertComponents<float>(data, stride, count, false, out.data());
+                break;
+            case TINYGLTF_COMPONENT_TYPE_BYTE:
+                convertComponents<int8_t>(data, stride, count, accessor.normalized, out.data());
+                break;
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+                convertComponents<uint8_t>(data, stride, count, accessor.normalized, out.data());
+                break;
+            case TINYGLTF_COMPONENT_TYPE_SHORT:
+                convertComponents<int16_t>(data, stride, count, accessor.normalized, out.data());
+                break;
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+                convertComponents<uint16_t>(data, stride, count, accessor.normalized, out.data());
+                break;
         }
 
         return true;
     }
 
+    static bool readAccessorVec3Float(const tinygltf::Model&    model,
+                                      const tinygltf::Accessor& accessor,
+                                      std::vector<glm::vec3>&   out,
+                                      SceneIOReport&            report,
+                                      const char*               label)
+    {
+        return readAccessorVecFloat<3>(model, accessor, TINYGLTF_TYPE_VEC3, out, report, label);
+    }
+
+    static bool readAccessorVec2Float(const tinygltf::Model&    model,
+                                      const tinygltf::Accessor& accessor,
+                                      std::vector<glm::vec2>&   out,
+                                      SceneIOReport&            report,
+                                      const char*               label)
+    {
+        return readAccessorVecFloat<2>(model, accessor, TINYGLTF_TYPE_VEC2, out, report, label);
+    }
+
     static bool readIndices(const tinygltf::Model&    model,
                             const tinygltf::Accessor& accessor,
                             std::vector<uint32_t>&    out,
@@ -711,6 +764,7 @@ namespace
     struct GltfTextureCache
     {
         std::vector<ImageId> texToImage;
+        std::vector<bool>    attempted; ///< Failures are remembered too, so they warn once.
     };
 
     static ImageId importGltfTextureToImageId(Scene*                       scene,
@@ -735,9 +789,13 @@ namespace
         else if (cache.texToImage.size() != model.textures.size())
             cache.texToImage.resize(model.textures.size(), kInvalidImageId);
 
-        if (cache.texToImage[textureIndex] != kInvalidImageId)
+        cache.attempted.resize(model.textures.size(), false);
+
+        if (cache.attempted[textureIndex])
             return cache.texToImage[textureIndex];
 
+        cache.attempted[textureIndex] = true;
+
         const tinygltf::Texture& tex = model.textures[textureIndex];
 
         const int imgIndex = resolveTextureImageIndex(model, tex);
@@ -750,17 +808,12 @@ namespace
         const tinygltf::Image& img      = model.images[imgIndex];
         const std::string      nameHint = makeName(img.name, imgIndex, "Image_");
 
-        if (!img.uri.empty())
+        // data: URIs arrive decoded into img.image (see storeEncodedImageLoader).
+        if (!img.uri.empty() && img.uri.rfind("data:", 0) != 0)
         {
-            if (img.uri.rfind("data:", 0) == 0)
-            {
-                report.warning("glTF: data: URI images not supported yet (skipping): " + nameHint);
-                return kInvalidImageId;
-            }
-
             const std::filesystem::path full = baseDir / img.uri;
 
-            const ImageId id = ih->loadFromFile(full, /*flipY=*/true);
+            const ImageId id = ih->loadFromFileAsync(full, /*flipY=*/true);
             if (id == kInvalidImageId)
             {
                 report.warning("glTF: failed to load image file: " + full.string());
@@ -784,7 +837,7 @@ namespace
                 if (off + size <= buf.data.size() && size > 0)
                 {
                     const unsigned char* p  = buf.data.data() + off;
-                    const ImageId        id = ih->loadFromEncodedMemory(
+                    const ImageId        id = ih->loadFromEncodedMemoryAsync(
                         std::span<const unsigned char>(p, size),
                         nameHint,
                         /*flipY=*/true);
@@ -803,7 +856,7 @@ namespace
 
         if (!img.image.empty() && (img.width <= 0 || img.height <= 0))
         {
-            const ImageId id = ih->loadFromEncodedMemory(
+            const ImageId id = ih->loadFromEncodedMemoryAsync(
                 std::span<const unsigned char>(img.image.data(), img.image.size()),
                 nameHint,
                 /*flipY=*/true);
@@ -983,6 +1036,53 @@ namespace
         return static_cast<uint32_t>(matId);
     }
 
+    // ------------------------------------------------------------
+    // Texture prefetch
+    //
+    // Queue every texture used by an imported primitive before any
+    // geometry is built, so ImageHandler decodes them on the TaskPool
+    // while meshes convert. resolveMaterialIndex() later finds them
+    // in the cache; nothing waits for pixels (TextureHandler binds a
+    // fallback until each decode lands).
+    // ------------------------------------------------------------
+    static void prefetchGltfTextures(Scene*                       scene,
+                                     const tinygltf::Model&       model,
+                                     const std::filesystem::path& baseDir,
+                                     GltfTextureCache&            texCache,
+                                     SceneIOReport&               report)
+    {
+        std::vector<bool> used(model.materials.size(), false);
+        for (const tinygltf::Node& n : model.nodes)
+        {
+            if (n.mesh < 0 || n.mesh >= static_cast<int>(model.meshes.size()))
+                continue;
+
+            for (const tinygltf::Primitive& prim : model.meshes[n.mesh].primitives)
+            {
+                if (prim.material >= 0 && prim.material < static_cast<int>(used.size()))
+                    used[prim.material] = true;
+            }
+        }
+
+        for (size_t i = 0; i < used.size(); ++i)
+        {
+            if (!used[i])
+                continue;
+
+            const tinygltf::Material& gm = model.materials[i];
+
+            for (int tex : {gm.pbrMetallicRoughness.baseColorTexture.index,
+                            gm.pbrMetallicRoughness.metallicRoughnessTexture.index,
+                            gm.occlusionTexture.index,
+                            gm.normalTexture.index,
+                            gm.emissiveTexture.index})
+            {
+                if (tex >= 0)
+                    (void)importGltfTextureToImageId(scene, model, tex, baseDir, texCache, report);
+            }
+        }
+    }
+
     // ------------------------------------------------------------
     // Optional UV flip helper
     // ------------------------------------------------------------
@@ -993,6 +1093,207 @@ namespace
         return uv;
     }
 
+    // ------------------------------------------------------------
+    // Vertex welding (keys: SceneIOUtils.hpp). Normals/UVs stay per
+    // face corner, so welding only changes topology, never shading.
+    // ------------------------------------------------------------
+    using WeldMap = std::unordered_map<WeldKey, int32_t, WeldKeyHash>;
+
+    // ------------------------------------------------------------
+    // Primitive preparation
+    //
+    // Everything that only reads the model runs here, one primitive per
+    // TaskPool job: accessor decode, triangulation, baking the node
+    // transform, and welding within the primitive. The load loop then
+    // only creates SysMesh elements, welding across primitives on the
+    // (much smaller) per-primitive unique point sets.
+    // ------------------------------------------------------------
+    enum class PrimitiveResult
+    {
+        Ok,
+        Skipped, ///< Warning reported; import continues.
+        Failed,  ///< Error reported; import aborts.
+    };
+
+    struct PreparedPrimitive
+    {
+        PrimitiveResult        result    = PrimitiveResult::Skipped;
+        SceneIOReport          report    = {};
+        std::vector<glm::vec3> positions = {}; ///< World space.
+        std::vector<glm::vec3> normals   = {}; ///< World space, normalized; empty when absent.
+        std::vector<glm::vec2> uvs       = {}; ///< Empty when absent.
+        std::vector<uint32_t>  tri       = {};
+        std::vector<uint32_t>  group     = {}; ///< Source vertex -> weld group.
+        std::vector<uint32_t>  groupHead = {}; ///< Weld group -> first source vertex.
+    };
+
+    static void preparePrimitive(const tinygltf::Model&     model,
+                                 const tinygltf::Primitive& prim,
+                                 const glm::mat4&           M,
+                                 const glm::mat3&           N,
+                                 bool                       flipUvY,
+                                 const LoadOptions&         options,
+                                 const std::string&         sceneMeshName,
+                                 PreparedPrimitive&         out)
+    {
+        SceneIOReport& report = out.report;
+        out.result            = PrimitiveResult::Skipped;
+
+        // POSITION required
+        auto itPos = prim.attributes.find("POSITION");
+        if (itPos == prim.attributes.end())
+        {
+            report.warning("glTF: primitive missing POSITION, skipping. (" + sceneMeshName + ")");
+            return;
+        }
+
+        const int posAccIndex = itPos->second;
+        if (posAccIndex < 0 || posAccIndex >= static_cast<int>(model.accessors.size()))
+        {
+            report.warning("glTF: invalid POSITION accessor, skipping primitive. (" + sceneMeshName + ")");
+            return;
+        }
+
+        std::vector<glm::vec3>& positions = out.positions;
+        if (!readAccessorVec3Float(model, model.accessors[posAccIndex], positions, report, "POSITION"))
+        {
+            out.result = PrimitiveResult::Failed;
+            return;
+        }
+
+        // Optional NORMAL
+        std::vector<glm::vec3>& normals = out.normals;
+        {
+            auto itNrm = prim.attributes.find("NORMAL");
+            if (itNrm != prim.attributes.end())
+            {
+                const int nAccIndex = itNrm->second;
+                if (nAccIndex >= 0 && nAccIndex < static_cast<int>(model.accessors.size()))
+                {
+                    if (!readAccessorVec3Float(model, model.accessors[nAccIndex], normals, report, "NORMAL"))
+                    {
+                        out.result = PrimitiveResult::Failed;
+                        return;
+                    }
+
+                    if (normals.size() != positions.size())
+                    {
+                        report.warning("glTF: NORMAL count != POSITION count. Ignoring normals for this primitive.");
+                        normals.clear();
+                    }
+                }
+            }
+        }
+
+        // Optional TEXCOORD_0
+        std::vector<glm::vec2>& uvs = out.uvs;
+        {
+            auto itUv = prim.attributes.find("TEXCOORD_0");
+            if (itUv != prim.attributes.end())
+            {
+                const int uvAccIndex = itUv->second;
+                if (uvAccIndex >= 0 && uvAccIndex < static_cast<int>(model.accessors.size()))
+                {
+                    if (!readAccessorVec2Float(model, model.accessors[uvAccIndex], uvs, report, "TEXCOORD_0"))
+                    {
+                        out.result = PrimitiveResult::Failed;
+                        return;
+                    }
+
+                    if (uvs.size() != positions.size())
+                    {
+                        report.warning("glTF: TEXCOORD_0 count != POSITION count. Ignoring UVs for this primitive.");
+                        uvs.clear();
+                    }
+                }
+            }
+        }
+
+        // Indices (optional)
+        std::vector<uint32_t> indices;
+        if (prim.indices >= 0)
+        {
+            if (prim.indices >= static_cast<int>(model.accessors.size()))
+            {
+                report.warning("glTF: invalid indices accessor, skipping primitive. (" + sceneMeshName + ")");
+                return;
+            }
+
+            if (!readIndices(model, model.accessors[prim.indices], indices, report))
+            {
+                out.result = PrimitiveResult::Failed;
+                return;
+            }
+        }
+        else
+        {
+            indices.resize(positions.size());
+            for (size_t i = 0; i < indices.size(); ++i)
+                indices[i] = static_cast<uint32_t>(i);
+        }
+
+        // Convert to triangles
+        std::vector<uint32_t>& tri = out.tri;
+        switch (prim.mode)
+        {
+            case TINYGLTF_MODE_TRIANGLES:
+                tri = std::move(indices);
+                break;
+            case TINYGLTF_MODE_TRIANGLE_STRIP:
+                triangulateStrip(indices, tri);
+                break;
+            case TINYGLTF_MODE_TRIANGLE_FAN:
+                triangulateFan(indices, tri);
+                break;
+            default:
+                report.warning("glTF: unsupported primitive mode (not triangles/strip/fan). Skipping primitive.");
+                return;
+        }
+
+        if (tri.size() < 3 || (tri.size() % 3u) != 0u)
+            return;
+
+        // Bake node transform into vertices/normals
+        for (glm::vec3& p : positions)
+        {
+            const glm::vec4 p4 = M * glm::vec4(p, 1.0f);
+            p                  = glm::vec3(p4.x, p4.y, p4.z);
+        }
+
+        for (glm::vec3& n : normals)
+        {
+            n                = N * n;
+            const float len2 = glm::dot(n, n);
+            n                = len2 <= 0.0f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::normalize(n);
+        }
+
+        for (glm::vec2& uv : uvs)
+            uv = maybeFlipUv(uv, flipUvY);
+
+        // Weld groups within the primitive (identity when welding is off)
+        out.group.resize(positions.size());
+        if (options.weldVertices)
+        {
+            WeldMap local;
+            local.reserve(positions.size());
+
+            for (size_t i = 0; i < positions.size(); ++i)
+            {
+                const auto [it, inserted] = local.try_emplace(weldKey(positions[i], options.weldEpsilon), static_cast<int32_t>(out.groupHead.size()));
+                if (inserted)
+                    out.groupHead.push_back(static_cast<uint32_t>(i));
+                out.group[i] = static_cast<uint32_t>(it->second);
+            }
+        }
+        else
+        {
+            std::iota(out.group.begin(), out.group.end(), 0u);
+            out.groupHead = out.group;
+        }
+
+        out.result = PrimitiveResult::Ok;
+    }
+
 } // namespace
 
 bool GltfSceneFormat::load(Scene*                       scene,
@@ -1048,8 +1349,24 @@ bool GltfSceneFormat::load(Scene*                       scene,
     // We store encoded image bytes and decode ourselves via ImageHandler.
     loader.SetImageLoader(storeEncodedImageLoader, nullptr);
 
+    // Base directory for external image URIs
+    const std::filesystem::path baseDir = filePath.parent_path();
+
+    // EXT_meshopt_compression fallback buffers have no data; TinyGLTF only
+    // takes them after gltf_meshopt patched the document.
+    std::vector<uint8_t> patched;
+    bool                 usePatched = false;
+    {
+        const MappedFile file(filePath);
+        usePatched = file.valid() && gltf_meshopt::patchFallbackBuffers(file.bytes(), isGlb, patched);
+    }
+
     bool ok = false;
-    if (isGlb)
+    if (usePatched && isGlb)
+        ok = loader.LoadBinaryFromMemory(&model, &err, &warn, patched.data(), static_cast<unsigned int>(patched.size()), baseDir.string());
+    else if (usePatched)
+        ok = loader.LoadASCIIFromString(&model, &err, &warn, reinterpret_cast<const char*>(patched.data()), static_cast<unsigned int>(patched.size()), baseDir.string());
+    else if (isGlb)
         ok = loader.LoadBinaryFromFile(&model, &err, &warn, filePath.string());
     else
         ok = loader.LoadASCIIFromFile(&model, &err, &warn, filePath.string());
@@ -1067,8 +1384,8 @@ bool GltfSceneFormat::load(Scene*                       scene,
         return false;
     }
 
-    // Base directory for external image URIs
-    const std::filesystem::path baseDir = filePath.parent_path();
+    if (!gltf_meshopt::decode(model, report))
+        return false;
 
     // ---------------------------------------------------------
     // Compute node world matrices for selected glTF scene roots
@@ -1129,6 +1446,8 @@ bool GltfSceneFormat::load(Scene*                       scene,
     // If you flip images at load time (we do: flipY=true), usually you do NOT flip UVs.
     const bool flipUvY = false;
 
+    prefetchGltfTextures(scene, model, baseDir, texCache, report);
+
     // ---------------------------------------------------------
     // Import nodes that reference meshes
     // ---------------------------------------------------------
@@ -1180,110 +1499,25 @@ bool GltfSceneFormat::load(Scene*                       scene,
         const glm::mat4 M = world[nodeIdx];
         const glm::mat3 N = glm::mat3(glm::inverseTranspose(M));
 
+        std::vector<PreparedPrimitive> prepared(gm.primitives.size());
+        TaskPool::shared().parallelFor(static_cast<uint32_t>(prepared.size()), [&](uint32_t primIdx) {
+            preparePrimitive(model, gm.primitives[primIdx], M, N, flipUvY, options, sceneMeshName, prepared[primIdx]);
+        });
+
+        // Welding spans all primitives of the node's mesh.
+        WeldMap meshWeld;
+        size_t  collapsedTris  = 0;
+        size_t  degenerateTris = 0;
+
         for (size_t primIdx = 0; primIdx < gm.primitives.size(); ++primIdx)
         {
             const tinygltf::Primitive& prim = gm.primitives[primIdx];
+            const PreparedPrimitive&   pp   = prepared[primIdx];
 
-            // POSITION required
-            auto itPos = prim.attributes.find("POSITION");
-            if (itPos == prim.attributes.end())
-            {
-                report.warning("glTF: primitive missing POSITION, skipping. (" + sceneMeshName + ")");
-                continue;
-            }
-
-            const int posAccIndex = itPos->second;
-            if (posAccIndex < 0 || posAccIndex >= static_cast<int>(model.accessors.size()))
-            {
-                report.warning("glTF: invalid POSITION accessor, skipping primitive. (" + sceneMeshName + ")");
-                continue;
-            }
-
-            std::vector<glm::vec3> positions;
-            if (!readAccessorVec3Float(model, model.accessors[posAccIndex], positions, report, "POSITION"))
+            appendSceneIOReport(report, pp.report);
+            if (pp.result == PrimitiveResult::Failed)
                 return false;
-
-            // Optional NORMAL
-            std::vector<glm::vec3> normals;
-            {
-                auto itNrm = prim.attributes.find("NORMAL");
-                if (itNrm != prim.attributes.end())
-                {
-                    const int nAccIndex = itNrm->second;
-                    if (nAccIndex >= 0 && nAccIndex < static_cast<int>(model.accessors.size()))
-                    {
-                        if (!readAccessorVec3Float(model, model.accessors[nAccIndex], normals, report, "NORMAL"))
-                            return false;
-
-                        if (normals.size() != positions.size())
-                        {
-                            report.warning("glTF: NORMAL count != POSITION count. Ignoring normals for this primitive.");
-                            normals.clear();
-                        }
-                    }
-                }
-            }
-
-            // Optional TEXCOORD_0
-            std::vector<glm::vec2> uvs;
-            {
-                auto itUv = prim.attributes.find("TEXCOORD_0");
-                if (itUv != prim.attributes.end())
-                {
-                    const int uvAccIndex = itUv->second;
-                    if (uvAccIndex >= 0 && uvAccIndex < static_cast<int>(model.accessors.size()))
-                    {
-                        if (!readAccessorVec2Float(model, model.accessors[uvAccIndex], uvs, report, "TEXCOORD_0"))
-                            return false;
-
-                        if (uvs.size() != positions.size())
-                        {
-                            report.warning("glTF: TEXCOORD_0 count != POSITION count. Ignoring UVs for this primitive.");
-                            uvs.clear();
-                        }
-                    }
-                }
-            }
-
-            // Indices (optional)
-            std::vector<uint32_t> indices;
-            if (prim.indices >= 0)
-            {
-                if (prim.indices >= static_cast<int>(model.accessors.size()))
-                {
-                    report.warning("glTF: invalid indices accessor, skipping primitive. (" + sceneMeshName + ")");
-                    continue;
-                }
-
-                if (!readIndices(model, model.accessors[prim.indices], indices, report))
-                    return false;
-            }
-            else
-            {
-                indices.resize(positions.size());
-                for (size_t i = 0; i < indices.size(); ++i)
-                    indices[i] = static_cast<uint32_t>(i);
-            }
-
-            // Convert to triangles
-            std::vector<uint32_t> tri;
-            switch (prim.mode)
-            {
-                case TINYGLTF_MODE_TRIANGLES:
-                    tri = indices;
-                    break;
-                case TINYGLTF_MODE_TRIANGLE_STRIP:
-                    triangulateStrip(indices, tri);
-                    break;
-                case TINYGLTF_MODE_TRIANGLE_FAN:
-                    triangulateFan(indices, tri);
-                    break;
-                default:
-                    report.warning("glTF: unsupported primitive mode (not triangles/strip/fan). Skipping primitive.");
-                    continue;
-            }
-
-            if (tri.size() < 3 || (tri.size() % 3u) != 0u)
+            if (pp.result != PrimitiveResult::Ok)
                 continue;
 
             // Material
@@ -1291,23 +1525,25 @@ bool GltfSceneFormat::load(Scene*                       scene,
             if (prim.material >= 0)
                 matIndex = resolveMaterialIndex(scene, model, prim.material, baseDir, matCache, texCache, report);
 
-            // Create SysMesh verts for this primitive (no dedupe; simple & correct)
-            std::vector<int32_t> vRemap;
-            vRemap.resize(positions.size(), -1);
-
-            for (size_t i = 0; i < positions.size(); ++i)
+            // Create (or reuse) one SysMesh vert per weld group
+            std::vector<int32_t> groupVert(pp.groupHead.size(), -1);
+            for (size_t g = 0; g < pp.groupHead.size(); ++g)
             {
-                const glm::vec4 p4 = M * glm::vec4(positions[i], 1.0f);
-                const glm::vec3 p  = glm::vec3(p4.x, p4.y, p4.z);
-                vRemap[i]          = mesh->create_vert(p);
+                const glm::vec3& p = pp.positions[pp.groupHead[g]];
+                if (options.weldVertices)
+                {
+                    const auto [it, inserted] = meshWeld.try_emplace(weldKey(p, options.weldEpsilon), -1);
+                    if (inserted)
+                        it->second = mesh->create_vert(p);
+                    groupVert[g] = it->second;
+                }
+                else
+                {
+                    groupVert[g] = mesh->create_vert(p);
+                }
             }
 
-            const auto safeNorm = [](const glm::vec3& v) -> glm::vec3 {
-                const float len2 = glm::dot(v, v);
-                if (len2 <= 0.0f)
-                    return glm::vec3(0.0f, 1.0f, 0.0f);
-                return glm::normalize(v);
-            };
+            const std::vector<uint32_t>& tri = pp.tri;
 
             // Emit triangles as polys, attach face-varying normal/uv
             for (size_t t = 0; t < tri.size(); t += 3u)
@@ -1316,55 +1552,62 @@ bool GltfSceneFormat::load(Scene*                       scene,
                 const uint32_t i1 = tri[t + 1u];
                 const uint32_t i2 = tri[t + 2u];
 
-                if (i0 >= vRemap.size() || i1 >= vRemap.size() || i2 >= vRemap.size())
+                if (i0 >= pp.group.size() || i1 >= pp.group.size() || i2 >= pp.group.size())
                 {
                     report.warning("glTF: triangle index out of range. Skipping triangle.");
                     continue;
                 }
 
                 SysPolyVerts pv;
-                pv.push_back(vRemap[i0]);
-                pv.push_back(vRemap[i1]);
-                pv.push_back(vRemap[i2]);
+                pv.push_back(groupVert[pp.group[i0]]);
+                pv.push_back(groupVert[pp.group[i1]]);
+                pv.push_back(groupVert[pp.group[i2]]);
+
+                // Degenerate in the file, or a sliver whose corners welded together
+                if (pv[0] == pv[1] || pv[1] == pv[2] || pv[0] == pv[2])
+                {
+                    if (i0 == i1 || i1 == i2 || i0 == i2 || !options.weldVertices)
+                        ++degenerateTris;
+                    else
+                        ++collapsedTris;
+                    continue;
+                }
 
                 const int poly = mesh->create_poly(pv, static_cast<int>(matIndex));
                 if (poly < 0)
                     continue;
 
-                if (normMap != -1 && !normals.empty())
+                if (normMap != -1 && !pp.normals.empty())
                 {
                     SysPolyVerts pn;
                     pn.reserve(3);
 
-                    glm::vec3 n0 = safeNorm(N * normals[i0]);
-                    glm::vec3 n1 = safeNorm(N * normals[i1]);
-                    glm::vec3 n2 = safeNorm(N * normals[i2]);
-
-                    pn.push_back(mesh->map_create_vert(normMap, glm::value_ptr(n0)));
-                    pn.push_back(mesh->map_create_vert(normMap, glm::value_ptr(n1)));
-                    pn.push_back(mesh->map_create_vert(normMap, glm::value_ptr(n2)));
+                    pn.push_back(mesh->map_create_vert(normMap, glm::value_ptr(pp.normals[i0])));
+                    pn.push_back(mesh->map_create_vert(normMap, glm::value_ptr(pp.normals[i1])));
+                    pn.push_back(mesh->map_create_vert(normMap, glm::value_ptr(pp.normals[i2])));
 
                     mesh->map_create_poly(normMap, poly, pn);
                 }
 
-                if (texMap != -1 && !uvs.empty())
+                if (texMap != -1 && !pp.uvs.empty())
                 {
                     SysPolyVerts pt;
                     pt.reserve(3);
 
-                    const glm::vec2 uv0 = maybeFlipUv(uvs[i0], flipUvY);
-                    const glm::vec2 uv1 = maybeFlipUv(uvs[i1], flipUvY);
-                    const glm::vec2 uv2 = maybeFlipUv(uvs[i2], flipUvY);
-
-                    pt.push_back(mesh->map_create_vert(texMap, glm::value_ptr(uv0)));
-                    pt.push_back(mesh->map_create_vert(texMap, glm::value_ptr(uv1)));
-                    pt.push_back(mesh->map_create_vert(texMap, glm::value_ptr(uv2)));
+                    pt.push_back(mesh->map_create_vert(texMap, glm::value_ptr(pp.uvs[i0])));
+                    pt.push_back(mesh->map_create_vert(texMap, glm::value_ptr(pp.uvs[i1])));
+                    pt.push_back(mesh->map_create_vert(texMap, glm::value_ptr(pp.uvs[i2])));
 
                     mesh->map_create_poly(texMap, poly, pt);
                 }
             }
         }
 
+        if (collapsedTris > 0)
+            report.warning("glTF: " + std::to_string(collapsedTris) + " triangle(s) collapsed by welding were skipped. (" + sceneMeshName + ")");
+        if (degenerateTris > 0)
+            report.warning("glTF: " + std::to_string(degenerateTris) + " degenerate source triangle(s) were skipped. (" + sceneMeshName + ")");
+
         ++importedMeshCount;
     }
 
@@ -1377,12 +1620,10 @@ bool GltfSceneFormat::load(Scene*                       scene,
     return !report.hasErrors();
 }
 
-bool GltfSceneFormat::save(const Scene* /*scene*/,
-                           const std::filesystem::path& /*filePath*/,
-                           const SaveOptions& /*options*/,
-                           SceneIOReport& report)
+bool GltfSceneFormat::save(const Scene*                 scene,
+                           const std::filesystem::path& filePath,
+                           const SaveOptions&           options,
+                           SceneIOReport&               report)
 {
-    report.status = SceneIOStatus::UnsupportedFormat;
-    report.error("GltfSceneFormat::save: saving is not supported yet (import-only).");
-    return false;
+    return gltf_writer::save(scene, filePath, options, report);
 }
@@ -3,9 +3,11 @@
 #include "SceneFormat.hpp"
 
 /**
- * @brief glTF 2.0 scene format loader (TinyGLTF).
+ * @brief glTF 2.0 scene format (.gltf and .glb).
  *
- * Import-only for now (supports .gltf and .glb).
+ * Loads through TinyGLTF, including KHR_mesh_quantization accessors and
+ * EXT_meshopt_compression buffer views (see gltf_meshopt). Saving is done
+ * by gltf_writer.
  */
 class GltfSceneFormat : public SceneFormat
 {
@@ -33,9 +35,4 @@ public:
               const std::filesystem::path& filePath,
               const SaveOptions&           options,
               SceneIOReport&               report) override;
-
-    [[nodiscard]] bool supportsSave() const noexcept override
-    {
-        return false;
-    }
 };
@@ -0,0 +1,837 @@
+#include "GltfWriter.hpp"
+
+#include <tiny_gltf.h>
+
+#include <SysMesh.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <json.hpp> // nlohmann, bundled with TinyGLTF
+#include <limits>
+#include <map>
+#include <meshoptimizer.h>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "GltfMeshopt.hpp"
+#include "ImageHandler.hpp"
+#include "Material.hpp"
+#include "MaterialHandler.hpp"
+#include "Scene.hpp"
+#include "SceneMesh.hpp"
+#include "TaskPool.hpp"
+
+namespace
+{
+    using json = nlohmann::json;
+
+    constexpr const char* kQuantization = "KHR_mesh_quantization";
+
+    constexpr int kTargetArrayBuffer        = 34962;
+    constexpr int kTargetElementArrayBuffer = 34963;
+
+    constexpr uint32_t kGlbMagic     = 0x46546C67u; // "glTF"
+    constexpr uint32_t kGlbChunkJson = 0x4E4F534Au; // "JSON"
+    constexpr uint32_t kGlbChunkBin  = 0x004E4942u; // "BIN\0"
+
+    /**
+     * EXT_meshopt_compression only accepts the v0 vertex codec. The encoder
+     * version is process-global in meshoptimizer and nothing else here
+     * encodes vertex buffers, so it is set once, before the first meshopt
+     * export, rather than on every save.
+     */
+    void pinMeshoptVertexVersion()
+    {
+        static const bool pinned = [] {
+            meshopt_encodeVertexVersion(0);
+            return true;
+        }();
+        (void)pinned;
+    }
+
+    // ------------------------------------------------------------
+    // Flattening: SysMesh (shared verts + face-varying maps) to glTF
+    // vertices, one per unique (vert, normal, uv) corner.
+    // ------------------------------------------------------------
+    struct CornerKey
+    {
+        int32_t vert   = -1;
+        int32_t normal = -1; ///< Map vert, or -2 - poly for a computed face normal.
+        int32_t uv     = -1;
+
+        bool operator==(const CornerKey&) const = default;
+    };
+
+    struct CornerKeyHash
+    {
+        size_t operator()(const CornerKey& k) const noexcept
+        {
+            uint64_t h = uint64_t(uint32_t(k.vert)) * 0x9E3779B97F4A7C15ull;
+            h ^= uint64_t(uint32_t(k.normal)) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+            h ^= uint64_t(uint32_t(k.uv)) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    struct Flattened
+    {
+        std::vector<glm::vec3>               positions = {};
+        std::vector<glm::vec3>               normals   = {}; ///< Empty when the mesh has none.
+        std::vector<glm::vec2>               uvs       = {}; ///< Empty when the mesh has none.
+        std::map<int, std::vector<uint32_t>> triangles = {}; ///< glTF material (-1 = none) -> indices.
+    };
+
+    glm::vec3 unitOr(const glm::vec3& n, const glm::vec3& fallback) noexcept
+    {
+        const float len2 = glm::dot(n, n);
+        return len2 > 0.0f ? n / std::sqrt(len2) : fallback;
+    }
+
+    void flatten(const SysMesh* mesh, int materialCount, Flattened& out)
+    {
+        const int normalMap = mesh->map_find(/*MESH_MAP_NORMALS*/ 0);
+        const int texMap    = mesh->map_find(/*MESH_MAP_UV0*/ 1);
+
+        const std::vector<int32_t>& polys = mesh->all_polys();
+
+        // A map only becomes a glTF attribute if some poly actually uses it;
+        // polys without it get a face normal / (0,0).
+        auto mapUsed = [&](int map) {
+            if (map == -1)
+                return false;
+            return std::any_of(polys.begin(), polys.end(), [&](int32_t pi) {
+                return mesh->map_poly_verts(map, pi).size() == mesh->poly_verts(pi).size();
+            });
+        };
+
+        const bool hasN  = mapUsed(normalMap);
+        const bool hasUV = mapUsed(texMap);
+
+        std::unordered_map<CornerKey, uint32_t, CornerKeyHash> corners;
+        corners.reserve(polys.size() * 4u);
+
+        std::vector<uint32_t> ids;
+        for (int32_t pi : polys)
+        {
+            const SysPolyVerts& pv = mesh->poly_verts(pi);
+            if (pv.size() < 3)
+                continue;
+
+            const SysPolyVerts* pn = hasN && mesh->map_poly_verts(normalMap, pi).size() == pv.size() ? &mesh->map_poly_verts(normalMap, pi) : nullptr;
+            const SysPolyVerts* pt = hasUV && mesh->map_poly_verts(texMap, pi).size() == pv.size() ? &mesh->map_poly_verts(texMap, pi) : nullptr;
+
+            const glm::vec3 faceN = hasN && !pn ? unitOr(mesh->poly_normal(pi), glm::vec3(0.0f, 1.0f, 0.0f)) : glm::vec3(0.0f);
+
+            ids.clear();
+            for (int k = 0; k < pv.size(); ++k)
+            {
+                CornerKey key;
+                key.vert   = pv[k];
+                key.normal = pn ? (*pn)[k] : (hasN ? -2 - pi : -1);
+                key.uv     = pt ? (*pt)[k] : -1;
+
+                const auto [it, inserted] = corners.try_emplace(key, static_cast<uint32_t>(out.positions.size()));
+                if (inserted)
+                {
+                    out.positions.push_back(mesh->vert_position(pv[k]));
+
+                    if (hasN)
+                    {
+                        const glm::vec3 n = pn ? glm::make_vec3(mesh->map_vert_position(normalMap, (*pn)[k])) : faceN;
+                        out.normals.push_back(unitOr(n, glm::vec3(0.0f, 1.0f, 0.0f)));
+                    }
+
+                    if (hasUV)
+                        out.uvs.push_back(pt ? glm::make_vec2(mesh->map_vert_position(texMap, (*pt)[k])) : glm::vec2(0.0f));
+                }
+
+                ids.push_back(it->second);
+            }
+
+            int material = mesh->poly_material(pi);
+            if (material < 0 || material >= materialCount)
+                material = -1;
+
+            std::vector<uint32_t>& tris = out.triangles[material];
+            for (size_t k = 1; k + 1 < ids.size(); ++k)
+            {
+                tris.push_back(ids[0]);
+                tris.push_back(ids[k]);
+                tris.push_back(ids[k + 1]);
+            }
+        }
+    }
+
+    /// Vertex cache order per primitive, then vertex fetch order across the mesh (drops unused vertices).
+    void optimizeForMeshopt(Flattened& f)
+    {
+        const size_t vertexCount = f.positions.size();
+
+        std::vector<uint32_t> all;
+        for (auto& [material, indices] : f.triangles)
+        {
+            std::vector<uint32_t> optimized(indices.size());
+            meshopt_optimizeVertexCache(optimized.data(), indices.data(), indices.size(), vertexCount);
+            indices.swap(optimized);
+            all.insert(all.end(), indices.begin(), indices.end());
+        }
+
+        std::vector<uint32_t> remap(vertexCount);
+        const size_t          unique = meshopt_optimizeVertexFetchRemap(remap.data(), all.data(), all.size(), vertexCount);
+
+        for (auto& [material, indices] : f.triangles)
+            meshopt_remapIndexBuffer(indices.data(), indices.data(), indices.size(), remap.data());
+
+        auto remapStream = [&](auto& values) {
+            if (values.empty())
+                return;
+            std::remove_reference_t<decltype(values)> out(unique);
+            meshopt_remapVertexBuffer(out.data(), values.data(), vertexCount, sizeof(values[0]), remap.data());
+            values.swap(out);
+        };
+
+        remapStream(f.positions);
+        remapStream(f.normals);
+        remapStream(f.uvs);
+    }
+
+    // ------------------------------------------------------------
+    // Encoded streams: one bufferView + accessor each.
+    // ------------------------------------------------------------
+    struct Stream
+    {
+        std::vector<uint8_t> bytes         = {};
+        std::vector<uint8_t> packed        = {}; ///< EXT_meshopt_compression payload.
+        uint32_t             stride        = 0;
+        size_t               count         = 0;
+        int                  componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
+        const char*          type          = "SCALAR";
+        bool                 normalized    = false;
+        bool                 indices       = false;
+        json                 min           = {};
+        json                 max           = {};
+
+        [[nodiscard]] bool quantized() const noexcept
+        {
+            return !indices && componentType != TINYGLTF_COMPONENT_TYPE_FLOAT;
+        }
+    };
+
+    template <typename T>
+    void store(std::vector<uint8_t>& bytes, size_t offset, const T& v) noexcept
+    {
+        std::memcpy(bytes.data() + offset, &v, sizeof(T));
+    }
+
+    template <typename T>
+    T quantize(float v, float scale) noexcept
+    {
+        constexpr float lo = static_cast<float>(std::numeric_limits<T>::lowest());
+        constexpr float hi = static_cast<float>(std::numeric_limits<T>::max());
+        return static_cast<T>(std::clamp(std::round(v * scale), lo, hi));
+    }
+
+    /// Float positions, or 16-bit grid positions with the grid folded into @p matrix.
+    void encodePositions(const std::vector<glm::vec3>& positions, bool quantized, Stream& s, glm::mat4& matrix)
+    {
+        s.count = positions.size();
+        s.type  = "VEC3";
+
+        glm::vec3 lo(std::numeric_limits<float>::max());
+        glm::vec3 hi(std::numeric_limits<float>::lowest());
+        for (const glm::vec3& p : positions)
+        {
+            lo = glm::min(lo, p);
+            hi = glm::max(hi, p);
+        }
+
+        if (!quantized)
+        {
+            s.stride = sizeof(glm::vec3);
+            s.bytes.resize(s.count * s.stride);
+            std::memcpy(s.bytes.data(), positions.data(), s.bytes.size());
+
+            s.min = {lo.x, lo.y, lo.z};
+            s.max = {hi.x, hi.y, hi.z};
+            return;
+        }
+
+        // Uniform step keeps the node matrix free of non-uniform scale, so
+        // normals need no correction.
+        const glm::vec3 extent = hi - lo;
+        const float     range  = std::max(extent.x, std::max(extent.y, extent.z));
+        const float     step   = range > 0.0f ? range / 65535.0f : 1.0f;
+        const float     inv    = 1.0f / step;
+
+        s.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT;
+        s.stride        = 8; // 3 x u16, padded to the 4-byte attribute alignment
+        s.bytes.assign(s.count * s.stride, 0);
+
+        uint16_t qmin[3] = {65535, 65535, 65535};
+        uint16_t qmax[3] = {0, 0, 0};
+        for (size_t i = 0; i < s.count; ++i)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                const uint16_t q = quantize<uint16_t>(positions[i][c] - lo[c], inv);
+                store(s.bytes, i * s.stride + size_t(c) * 2u, q);
+                qmin[c] = std::min(qmin[c], q);
+                qmax[c] = std::max(qmax[c], q);
+            }
+        }
+
+        s.min = {qmin[0], qmin[1], qmin[2]};
+        s.max = {qmax[0], qmax[1], qmax[2]};
+
+        matrix = matrix * glm::translate(glm::mat4(1.0f), lo) * glm::scale(glm::mat4(1.0f), glm::vec3(step));
+    }
+
+    void encodeNormals(const std::vector<glm::vec3>& normals, bool quantized, Stream& s)
+    {
+        s.count = normals.size();
+        s.type  = "VEC3";
+
+        if (!quantized)
+        {
+            s.stride = sizeof(glm::vec3);
+            s.bytes.resize(s.count * s.stride);
+            std::memcpy(s.bytes.data(), normals.data(), s.bytes.size());
+            return;
+        }
+
+        s.componentType = TINYGLTF_COMPONENT_TYPE_BYTE;
+        s.normalized    = true;
+        s.stride        = 4;
+        s.bytes.assign(s.count * s.stride, 0);
+
+        for (size_t i = 0; i < s.count; ++i)
+            for (int c = 0; c < 3; ++c)
+                store(s.bytes, i * s.stride + size_t(c), quantize<int8_t>(normals[i][c], 127.0f));
+    }
+
+    /// 16-bit normalized UVs need [0,1]; anything tiling stays float.
+    void encodeUvs(const std::vector<glm::vec2>& uvs, bool quantized, Stream& s)
+    {
+        s.count = uvs.size();
+        s.type  = "VEC2";
+
+        quantized = quantized && std::all_of(uvs.begin(), uvs.end(), [](const glm::vec2& uv) {
+                        return uv.x >= 0.0f && uv.x <= 1.0f && uv.y >= 0.0f && uv.y <= 1.0f;
+                    });
+
+        if (!quantized)
+        {
+            s.stride = sizeof(glm::vec2);
+            s.bytes.resize(s.count * s.stride);
+            std::memcpy(s.bytes.data(), uvs.data(), s.bytes.size());
+            return;
+        }
+
+        s.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT;
+        s.normalized    = true;
+        s.stride        = 4;
+        s.bytes.resize(s.count * s.stride);
+
+        for (size_t i = 0; i < s.count; ++i)
+            for (int c = 0; c < 2; ++c)
+                store(s.bytes, i * s.stride + size_t(c) * 2u, quantize<uint16_t>(uvs[i][c], 65535.0f));
+    }
+
+    void encodeIndices(const std::vector<uint32_t>& indices, size_t vertexCount, bool meshopt, Stream& s)
+    {
+        s.count   = indices.size();
+        s.indices = true;
+
+        // 0xFFFF is the primitive-restart value, so u16 only up to 65535 verts.
+        if (vertexCount <= 65535u)
+        {
+            s.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT;
+            s.stride        = 2;
+            s.bytes.resize(s.count * 2u);
+            for (size_t i = 0; i < s.count; ++i)
+                store(s.bytes, i * 2u, static_cast<uint16_t>(indices[i]));
+        }
+        else
+        {
+            s.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT;
+            s.stride        = 4;
+            s.bytes.resize(s.count * 4u);
+            std::memcpy(s.bytes.data(), indices.data(), s.bytes.size());
+        }
+
+        if (meshopt)
+        {
+            s.packed.resize(meshopt_encodeIndexBufferBound(indices.size(), vertexCount));
+            s.packed.resize(meshopt_encodeIndexBuffer(s.packed.data(), s.packed.size(), indices.data(), indices.size()));
+        }
+    }
+
+    void packVertices(Stream& s)
+    {
+        s.packed.resize(meshopt_encodeVertexBufferBound(s.count, s.stride));
+        s.packed.resize(meshopt_encodeVertexBuffer(s.packed.data(), s.packed.size(), s.bytes.data(), s.count, s.stride));
+    }
+
+    struct ExportPrimitive
+    {
+        int    material = -1;
+        Stream indices  = {};
+    };
+
+    struct ExportMesh
+    {
+        std::string                  name      = {};
+        glm::mat4                    matrix    = glm::mat4(1.0f);
+        Stream                       positions = {};
+        Stream                       normals   = {}; ///< count == 0 when absent
+        Stream                       uvs       = {}; ///< count == 0 when absent
+        std::vector<ExportPrimitive> prims     = {};
+    };
+
+    /// Everything per mesh that does not touch the JSON document; runs on the TaskPool.
+    void prepareMesh(const SceneMesh* sm, int materialCount, const SaveOptions& options, ExportMesh& out)
+    {
+        const SysMesh* mesh = sm->sysMesh();
+        if (!mesh)
+            return;
+
+        Flattened f;
+        flatten(mesh, materialCount, f);
+        if (f.positions.empty() || f.triangles.empty())
+            return;
+
+        if (options.gltfMeshopt)
+            optimizeForMeshopt(f);
+
+        out.matrix = sm->model();
+
+        encodePositions(f.positions, options.gltfQuantize, out.positions, out.matrix);
+        if (!f.normals.empty())
+            encodeNormals(f.normals, options.gltfQuantize, out.normals);
+        if (!f.uvs.empty())
+            encodeUvs(f.uvs, options.gltfQuantize, out.uvs);
+
+        if (options.gltfMeshopt)
+        {
+            packVertices(out.positions);
+            if (out.normals.count > 0)
+                packVertices(out.normals);
+            if (out.uvs.count > 0)
+                packVertices(out.uvs);
+        }
+
+        for (const auto& [material, indices] : f.triangles)
+        {
+            ExportPrimitive& prim = out.prims.emplace_back();
+            prim.material         = material;
+            encodeIndices(indices, f.positions.size(), options.gltfMeshopt, prim.indices);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Document assembly
+    // ------------------------------------------------------------
+    size_t align4(size_t v) noexcept
+    {
+        return (v + 3u) & ~size_t(3);
+    }
+
+    struct Document
+    {
+        bool meshopt = false;
+
+        std::vector<uint8_t> bin          = {}; ///< Buffer 0.
+        size_t               fallbackSize = 0;  ///< Buffer 1: meshopt fallback, no data.
+
+        json bufferViews = json::array();
+        json accessors   = json::array();
+
+        int addView(const Stream& s)
+        {
+            json view;
+
+            if (meshopt)
+            {
+                bin.resize(align4(bin.size()), 0);
+                const size_t packedOffset = bin.size();
+                bin.insert(bin.end(), s.packed.begin(), s.packed.end());
+
+                fallbackSize = align4(fallbackSize);
+                view         = {{"buffer", 1}, {"byteOffset", fallbackSize}, {"byteLength", s.bytes.size()}};
+                fallbackSize += s.bytes.size();
+
+                view["extensions"][gltf_meshopt::kExtension] = {
+                    {"buffer", 0},
+                    {"byteOffset", packedOffset},
+                    {"byteLength", s.packed.size()},
+                    {"byteStride", s.stride},
+                    {"count", s.count},
+                    {"mode", s.indices ? "TRIANGLES" : "ATTRIBUTES"},
+                };
+            }
+            else
+            {
+                bin.resize(align4(bin.size()), 0);
+                view = {{"buffer", 0}, {"byteOffset", bin.size()}, {"byteLength", s.bytes.size()}};
+                bin.insert(bin.end(), s.bytes.begin(), s.bytes.end());
+            }
+
+            if (!s.indices)
+                view["byteStride"] = s.stride;
+            view["target"] = s.indices ? kTargetElementArrayBuffer : kTargetArrayBuffer;
+
+            bufferViews.push_back(std::move(view));
+            return static_cast<int>(bufferViews.size()) - 1;
+        }
+
+        int addAccessor(const Stream& s)
+        {
+            json acc = {
+                {"bufferView", addView(s)},
+                {"componentType", s.componentType},
+                {"count", s.count},
+                {"type", s.type},
+            };
+
+            if (s.normalized)
+                acc["normalized"] = true;
+
+            if (!s.min.is_null())
+            {
+                acc["min"] = s.min;
+                acc["max"] = s.max;
+            }
+
+            accessors.push_back(std::move(acc));
+            return static_cast<int>(accessors.size()) - 1;
+        }
+    };
+
+    /// Percent-encode everything but unreserved characters and '/'.
+    std::string uriEncode(const std::string& path)
+    {
+        static constexpr char hex[] = "0123456789ABCDEF";
+
+        std::string out;
+        out.reserve(path.size());
+        for (const char ch : path)
+        {
+            const unsigned char c = static_cast<unsigned char>(ch);
+            if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || c == '/')
+            {
+                out += ch;
+            }
+            else
+            {
+                out += '%';
+                out += hex[c >> 4];
+                out += hex[c & 15u];
+            }
+        }
+        return out;
+    }
+
+    struct MaterialWriter
+    {
+        const Scene*          scene = nullptr;
+        std::filesystem::path dir   = {};
+
+        json images   = json::array();
+        json textures = json::array();
+
+        std::unordered_map<ImageId, int> textureOf = {};
+        int                              skipped   = 0;
+
+        /// glTF texture index for @p id, or -1 when the image has no file to point at.
+        int texture(ImageId id)
+        {
+            if (id == kInvalidImageId)
+                return -1;
+
+            if (const auto it = textureOf.find(id); it != textureOf.end())
+                return it->second;
+
+            const ImageHandler* handler = scene->imageHandler();
+            const Image*        image   = handler ? handler->get(id) : nullptr;
+
+            int index = -1;
+            if (image && !image->path().empty())
+            {
+                std::error_code             ec;
+                const std::filesystem::path rel = std::filesystem::relative(image->path(), dir, ec);
+
+                images.push_back({{"uri", uriEncode((ec || rel.empty() ? image->path() : rel).generic_string())}});
+                textures.push_back({{"source", static_cast<int>(images.size()) - 1}});
+                index = static_cast<int>(textures.size()) - 1;
+            }
+            else
+            {
+                ++skipped;
+            }
+
+            textureOf.emplace(id, index);
+            return index;
+        }
+
+        json material(const Material& m)
+        {
+            static constexpr const char* alphaModes[] = {"OPAQUE", "MASK", "BLEND"};
+
+            const glm::vec3& bc = m.baseColor();
+            const glm::vec3  e  = glm::clamp(m.emissiveColor() * m.emissiveIntensity(), glm::vec3(0.0f), glm::vec3(1.0f));
+
+            json pbr = {
+                {"baseColorFactor", {bc.x, bc.y, bc.z, std::clamp(m.opacity(), 0.0f, 1.0f)}},
+                {"metallicFactor", std::clamp(m.metallic(), 0.0f, 1.0f)},
+                {"roughnessFactor", std::clamp(m.roughness(), 0.0f, 1.0f)},
+            };
+
+            json out = {
+                {"name", m.name()},
+                {"pbrMetallicRoughness", json::object()},
+                {"emissiveFactor", {e.x, e.y, e.z}},
+                {"alphaMode", alphaModes[static_cast<int>(m.alphaMode())]},
+                {"doubleSided", m.doubleSided()},
+            };
+
+            if (const int t = texture(m.baseColorTexture()); t >= 0)
+                pbr["baseColorTexture"] = {{"index", t}};
+            if (const int t = texture(m.mraoTexture()); t >= 0)
+                pbr["metallicRoughnessTexture"] = {{"index", t}};
+            if (const int t = texture(m.normalTexture()); t >= 0)
+                out["normalTexture"] = {{"index", t}};
+            if (const int t = texture(m.emissiveTexture()); t >= 0)
+                out["emissiveTexture"] = {{"index", t}};
+
+            out["pbrMetallicRoughness"] = std::move(pbr);
+            return out;
+        }
+    };
+
+    void appendU32(std::vector<uint8_t>& out, uint32_t v)
+    {
+        uint8_t b[4];
+        std::memcpy(b, &v, sizeof(v));
+        out.insert(out.end(), b, b + 4);
+    }
+
+    bool writeFile(const std::filesystem::path& path, const void* data, size_t size)
+    {
+        std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        out.close();
+        return out.good();
+    }
+} // namespace
+
+namespace gltf_writer
+{
+    bool save(const Scene* scene, const std::filesystem::path& filePath, const SaveOptions& options, SceneIOReport& report)
+    {
+        if (scene == nullptr)
+        {
+            report.error("glTF: save: scene is null");
+            report.status = SceneIOStatus::InvalidScene;
+            return false;
+        }
+
+        std::string ext = filePath.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        const bool isGlb = ext == ".glb";
+
+        const MaterialHandler* materialHandler = scene->materialHandler();
+        const int              materialCount   = materialHandler ? static_cast<int>(materialHandler->materials().size()) : 0;
+
+        if (options.gltfMeshopt)
+            pinMeshoptVertexVersion();
+
+        // ---------------------------------------------------------
+        // Flatten + encode meshes in parallel
+        // ---------------------------------------------------------
+        const std::vector<SceneMesh*> sceneMeshes = scene->sceneMeshes();
+
+        std::vector<ExportMesh> meshes(sceneMeshes.size());
+        TaskPool::shared().parallelFor(static_cast<uint32_t>(meshes.size()), [&](uint32_t i) {
+            if (sceneMeshes[i])
+                prepareMesh(sceneMeshes[i], materialCount, options, meshes[i]);
+        });
+
+        // ---------------------------------------------------------
+        // JSON document
+        // ---------------------------------------------------------
+        Document doc;
+        doc.meshopt = options.gltfMeshopt;
+
+        MaterialWriter materialWriter;
+        materialWriter.scene = scene;
+        materialWriter.dir   = filePath.parent_path();
+
+        json materials = json::array();
+        if (materialHandler)
+        {
+            for (const Material& m : materialHandler->materials())
+                materials.push_back(materialWriter.material(m));
+        }
+
+        json gltfMeshes = json::array();
+        json nodes      = json::array();
+        bool quantized  = false;
+
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            ExportMesh& em = meshes[i];
+            if (em.prims.empty())
+                continue;
+
+            json attributes = {{"POSITION", doc.addAccessor(em.positions)}};
+            if (em.normals.count > 0)
+                attributes["NORMAL"] = doc.addAccessor(em.normals);
+            if (em.uvs.count > 0)
+                attributes["TEXCOORD_0"] = doc.addAccessor(em.uvs);
+
+            quantized = quantized || em.positions.quantized() || em.normals.quantized() || em.uvs.quantized();
+
+            json prims = json::array();
+            for (const ExportPrimitive& ep : em.prims)
+            {
+                json prim = {{"attributes", attributes}, {"indices", doc.addAccessor(ep.indices)}, {"mode", TINYGLTF_MODE_TRIANGLES}};
+                if (ep.material >= 0)
+                    prim["material"] = ep.material;
+                prims.push_back(std::move(prim));
+            }
+
+            const std::string name = std::string(sceneMeshes[i]->name());
+
+            gltfMeshes.push_back({{"name", name}, {"primitives", std::move(prims)}});
+
+            json node = {{"name", name}, {"mesh", static_cast<int>(gltfMeshes.size()) - 1}};
+            if (em.matrix != glm::mat4(1.0f))
+            {
+                const float* m = glm::value_ptr(em.matrix);
+                node["matrix"] = std::vector<float>(m, m + 16);
+            }
+            nodes.push_back(std::move(node));
+        }
+
+        json root = {{"asset", {{"version", "2.0"}, {"generator", "IMP3D"}}}};
+
+        json sceneNodes = json::array();
+        for (size_t i = 0; i < nodes.size(); ++i)
+            sceneNodes.push_back(i);
+
+        const size_t meshCount = gltfMeshes.size();
+
+        root["scene"]  = 0;
+        root["scenes"] = json::array({json{{"nodes", std::move(sceneNodes)}}});
+        root["nodes"]  = std::move(nodes);
+
+        if (!gltfMeshes.empty())
+        {
+            root["meshes"]      = std::move(gltfMeshes);
+            root["accessors"]   = std::move(doc.accessors);
+            root["bufferViews"] = std::move(doc.bufferViews);
+        }
+
+        if (!materials.empty())
+            root["materials"] = std::move(materials);
+        if (!materialWriter.textures.empty())
+        {
+            root["textures"] = std::move(materialWriter.textures);
+            root["images"]   = std::move(materialWriter.images);
+        }
+
+        const std::filesystem::path binPath = std::filesystem::path(filePath).replace_extension(".bin");
+
+        if (!doc.bin.empty())
+        {
+            json buffer = {{"byteLength", doc.bin.size()}};
+            if (!isGlb)
+                buffer["uri"] = uriEncode(binPath.filename().string());
+
+            root["buffers"] = json::array({std::move(buffer)});
+
+            if (doc.meshopt)
+            {
+                json fallback = {{"byteLength", std::max<size_t>(doc.fallbackSize, 1)}};
+
+                fallback["extensions"][gltf_meshopt::kExtension] = {{"fallback", true}};
+                root["buffers"].push_back(std::move(fallback));
+            }
+        }
+
+        json required = json::array();
+        if (quantized)
+            required.push_back(kQuantization);
+        if (doc.meshopt && !doc.bin.empty())
+            required.push_back(gltf_meshopt::kExtension);
+
+        if (!required.empty())
+        {
+            root["extensionsUsed"]     = required;
+            root["extensionsRequired"] = required;
+        }
+
+        if (materialWriter.skipped > 0)
+            report.warning("glTF: " + std::to_string(materialWriter.skipped) + " texture(s) without a file path were not exported.");
+
+        // ---------------------------------------------------------
+        // Write .gltf + .bin, or one .glb
+        // ---------------------------------------------------------
+        bool ok = false;
+        if (isGlb)
+        {
+            std::string text = root.dump();
+            text.resize(align4(text.size()), ' ');
+            doc.bin.resize(align4(doc.bin.size()), 0);
+
+            const size_t binChunk = doc.bin.empty() ? 0 : 8u + doc.bin.size();
+            const size_t total    = 12u + 8u + text.size() + binChunk;
+
+            std::vector<uint8_t> glb;
+            glb.reserve(total);
+            appendU32(glb, kGlbMagic);
+            appendU32(glb, 2);
+            appendU32(glb, static_cast<uint32_t>(total));
+            appendU32(glb, static_cast<uint32_t>(text.size()));
+            appendU32(glb, kGlbChunkJson);
+            glb.insert(glb.end(), text.begin(), text.end());
+            if (binChunk > 0)
+            {
+                appendU32(glb, static_cast<uint32_t>(doc.bin.size()));
+                appendU32(glb, kGlbChunkBin);
+                glb.insert(glb.end(), doc.bin.begin(), doc.bin.end());
+            }
+
+            ok = writeFile(filePath, glb.data(), glb.size());
+        }
+        else
+        {
+            const std::string text = root.dump(2);
+
+            ok = writeFile(filePath, text.data(), text.size());
+            if (ok && !doc.bin.empty())
+                ok = writeFile(binPath, doc.bin.data(), doc.bin.size());
+        }
+
+        if (!ok)
+        {
+            report.error("glTF: failed to write " + filePath.string());
+            report.status = SceneIOStatus::WriteError;
+            return false;
+        }
+
+        report.info("glTF: exported " + std::to_string(meshCount) + " meshes.");
+        report.status = SceneIOStatus::Ok;
+        return true;
+    }
+
+} // namespace gltf_writer
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <filesystem>
+
+#include "SceneFormat.hpp"
+
+class Scene;
+
+/**
+ * @brief glTF 2.0 export (.gltf + .bin, or a single .glb).
+ *
+ * Writes meshes, their materials and file-backed textures. Face-varying
+ * normals/UVs are flattened to glTF vertices (one per unique corner) and
+ * polygons are fan-triangulated, one primitive per material.
+ *
+ * Optional encodings, both listed in extensionsRequired when used:
+ *   SaveOptions::gltfQuantize  KHR_mesh_quantization: 16-bit positions (the
+ *                              dequantization goes into the node matrix),
+ *                              8-bit normals, 16-bit UVs when in [0,1].
+ *   SaveOptions::gltfMeshopt   EXT_meshopt_compression on every vertex and
+ *                              index buffer view; vertices are reordered
+ *                              for cache/fetch locality first.
+ */
+namespace gltf_writer
+{
+    bool save(const Scene* scene, const std::filesystem::path& filePath, const SaveOptions& options, SceneIOReport& report);
+
+} // namespace gltf_writer
@@ -0,0 +1,1656 @@
+#include "ImpBinaryFormat.hpp"
+
+#include <LightHandler.hpp>
+#include <SysMesh.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <lz4.h>
+#include <lz4hc.h>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <zstd.h>
+
+#include "ImageHandler.hpp"
+#include "MappedFile.hpp"
+#include "Material.hpp"
+#include "MaterialHandler.hpp"
+#include "Scene.hpp"
+#include "SceneLight.hpp"
+#include "SceneMesh.hpp"
+#include "TaskPool.hpp"
+
+namespace imp_binary
+{
+    /// Plain copy of one mesh taken by capture(); write() turns it into MESH chunk bytes.
+    struct MeshCapture
+    {
+        struct Map
+        {
+            int32_t               id          = -1;
+            int32_t               dim         = 0;
+            std::vector<float>    verts       = {}; ///< Every map slot, dim floats each (zeros for holes).
+            std::vector<uint32_t> polyOffsets = {}; ///< Per captured poly into polyVerts; empty range = unbound.
+            std::vector<int32_t>  polyVerts   = {}; ///< Map slot indices.
+        };
+
+        std::string           name           = {};
+        uint32_t              flags          = 0;
+        int32_t               subdivLevel    = 0;
+        float                 modelRM[16]    = {};
+        size_t                vertBufferSize = 0;
+        std::vector<int32_t>  vertSlots      = {}; ///< Vertex slot per dense index.
+        std::vector<float>    positions      = {}; ///< Dense, xyz.
+        std::vector<uint32_t> polyOffsets    = {};
+        std::vector<uint32_t> polyMaterials  = {};
+        std::vector<int32_t>  polyVerts      = {}; ///< Vertex slot indices, renumbered by write().
+        std::vector<Map>      maps           = {};
+    };
+} // namespace imp_binary
+
+// ============================================================
+// On-disk records
+// ============================================================
+namespace
+{
+    constexpr char     kMagic[8]  = {'I', 'M', 'P', '3', 'D', 'B', 'I', 'N'};
+    constexpr uint64_t kAlignment = 16;
+
+    constexpr uint32_t fourcc(char a, char b, char c, char d) noexcept
+    {
+        return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) | (uint32_t(uint8_t(d)) << 24);
+    }
+
+    constexpr uint32_t kChunkImage    = fourcc('I', 'M', 'A', 'G');
+    constexpr uint32_t kChunkMaterial = fourcc('M', 'A', 'T', 'L');
+    constexpr uint32_t kChunkLight    = fourcc('L', 'G', 'H', 'T');
+    constexpr uint32_t kChunkMesh     = fourcc('M', 'E', 'S', 'H');
+
+    struct FileHeader
+    {
+        char     magic[8]        = {};
+        uint32_t version         = 0;
+        uint32_t chunkCount      = 0;
+        uint64_t directoryOffset = 0;
+        uint64_t reserved        = 0;
+    };
+
+    struct ChunkEntry
+    {
+        uint32_t type   = 0;
+        uint32_t flags  = 0; ///< Codec in the low byte (0 = raw) + kChunkShuffled.
+        uint64_t offset = 0;
+        uint64_t size   = 0;
+    };
+
+    enum class ImageEncoding : uint32_t
+    {
+        External = 0, ///< Payload empty; load from path relative to the scene file.
+        Raw      = 1, ///< width * height * channels bytes, already flipped.
+        Encoded  = 2, ///< KTX / PNG / JPEG bytes for the async decoder.
+    };
+
+    struct ImageRecord
+    {
+        uint32_t keyLength   = 0;
+        uint32_t pathLength  = 0;
+        int32_t  width       = 0;
+        int32_t  height      = 0;
+        int32_t  channels    = 0;
+        uint32_t encoding    = 0;
+        uint64_t payloadSize = 0;
+    };
+
+    struct MaterialRecord
+    {
+        float    baseColor[3]      = {1.f, 1.f, 1.f};
+        float    opacity           = 1.f;
+        float    roughness         = 0.5f;
+        float    metallic          = 0.f;
+        float    ior               = 1.5f;
+        float    emissiveIntensity = 0.f;
+        float    emissiveColor[3]  = {1.f, 1.f, 1.f};
+        uint32_t alphaMode         = 0;
+        uint32_t doubleSided       = 0;
+        uint32_t nameLength        = 0;
+        int32_t  textures[7]       = {-1, -1, -1, -1, -1, -1, -1}; ///< IMAG index; order of kTextureSlots.
+        uint32_t reserved          = 0;
+    };
+
+    enum LightFlags : uint32_t
+    {
+        LightEnabled      = 1u << 0,
+        LightAffectRaster = 1u << 1,
+        LightAffectRt     = 1u << 2,
+        LightCastShadows  = 1u << 3,
+    };
+
+    struct LightRecord
+    {
+        uint32_t type          = 1;
+        uint32_t flags         = 0;
+        float    position[3]   = {};
+        float    direction[3]  = {0.f, 0.f, -1.f};
+        float    color[3]      = {1.f, 1.f, 1.f};
+        float    intensity     = 1.f;
+        float    range         = 0.f;
+        float    spotInnerCone = 0.f;
+        float    spotOuterCone = 0.7853981633f;
+        float    modelRM[16]   = {};
+        uint32_t nameLength    = 0;
+    };
+
+    enum MeshFlags : uint32_t
+    {
+        MeshVisible  = 1u << 0,
+        MeshSelected = 1u << 1,
+    };
+
+    struct MeshRecord
+    {
+        uint32_t nameLength  = 0;
+        uint32_t flags       = 0;
+        int32_t  subdivLevel = 0;
+        uint32_t mapCount    = 0;
+        float    modelRM[16] = {};
+        uint32_t vertCount   = 0;
+        uint32_t polyCount   = 0;
+        uint32_t indexCount  = 0;
+        uint32_t reserved    = 0;
+    };
+
+    struct MapRecord
+    {
+        int32_t  id             = -1;
+        int32_t  type           = 0;
+        int32_t  dim            = 0;
+        uint32_t vertCount      = 0;
+        uint32_t bindCount      = 0;
+        uint32_t bindIndexCount = 0;
+    };
+
+    static_assert(std::is_trivially_copyable_v<FileHeader> && sizeof(FileHeader) == 32);
+    static_assert(std::is_trivially_copyable_v<ChunkEntry> && sizeof(ChunkEntry) == 24);
+    static_assert(std::is_trivially_copyable_v<ImageRecord> && sizeof(ImageRecord) == 32);
+    static_assert(std::is_trivially_copyable_v<MaterialRecord> && sizeof(MaterialRecord) == 88);
+    static_assert(std::is_trivially_copyable_v<LightRecord> && sizeof(LightRecord) == 128);
+    static_assert(std::is_trivially_copyable_v<MeshRecord> && sizeof(MeshRecord) == 96);
+    static_assert(std::is_trivially_copyable_v<MapRecord> && sizeof(MapRecord) == 24);
+
+    using TextureGetter = ImageId (Material::*)() const noexcept;
+    using TextureSetter = void (Material::*)(ImageId) noexcept;
+
+    struct TextureSlot
+    {
+        TextureGetter get;
+        TextureSetter set;
+    };
+
+    static const TextureSlot kTextureSlots[7] = {
+        {&Material::baseColorTexture, &Material::baseColorTexture},
+        {&Material::normalTexture, &Material::normalTexture},
+        {&Material::mraoTexture, &Material::mraoTexture},
+        {&Material::metallicTexture, &Material::metallicTexture},
+        {&Material::roughnessTexture, &Material::roughnessTexture},
+        {&Material::aoTexture, &Material::aoTexture},
+        {&Material::emissiveTexture, &Material::emissiveTexture},
+    };
+
+    static void mat4ToRowMajor(const glm::mat4& m, float out16[16]) noexcept
+    {
+        int k = 0;
+        for (int r = 0; r < 4; ++r)
+            for (int c = 0; c < 4; ++c)
+                out16[k++] = m[c][r];
+    }
+
+    static glm::mat4 rowMajorToMat4(const float in16[16]) noexcept
+    {
+        glm::mat4 m{1.0f};
+        int       k = 0;
+        for (int r = 0; r < 4; ++r)
+            for (int c = 0; c < 4; ++c)
+                m[c][r] = in16[k++];
+        return m;
+    }
+
+    static std::string portablePath(const std::filesystem::path& p, const std::filesystem::path& baseDir)
+    {
+        std::string s;
+        try
+        {
+            s = std::filesystem::relative(p, baseDir).string();
+        }
+        catch (...)
+        {
+            s = p.string();
+        }
+
+        for (char& c : s)
+            if (c == '\\')
+                c = '/';
+        return s;
+    }
+
+    // ------------------------------------------------------------
+    // Writer: appends to one chunk's buffer, aligning relative to its start.
+    // ------------------------------------------------------------
+    class BinWriter
+    {
+    public:
+        explicit BinWriter(std::vector<uint8_t>& out) noexcept : m_out(out)
+        {
+        }
+
+        [[nodiscard]] uint64_t pos() const noexcept
+        {
+            return m_out.size();
+        }
+
+        void bytes(const void* data, size_t size)
+        {
+            if (size == 0)
+                return;
+            const uint8_t* src = static_cast<const uint8_t*>(data);
+            m_out.insert(m_out.end(), src, src + size);
+        }
+
+        template<typename T>
+        void pod(const T& v)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            bytes(&v, sizeof(T));
+        }
+
+        template<typename T>
+        void array(const std::vector<T>& v)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            align();
+            bytes(v.data(), v.size() * sizeof(T));
+        }
+
+        void string(std::string_view s)
+        {
+            bytes(s.data(), s.size());
+        }
+
+        void align(uint64_t alignment = kAlignment)
+        {
+            const uint64_t pad = (alignment - (pos() % alignment)) % alignment;
+            m_out.resize(m_out.size() + size_t(pad), 0);
+        }
+
+    private:
+        std::vector<uint8_t>& m_out;
+    };
+
+    // ------------------------------------------------------------
+    // Chunk compression
+    //
+    // A compressed chunk holds the uint64 raw size followed by the codec
+    // stream. MESH chunks are byte-plane shuffled first: every array in
+    // them is 4-byte floats / indices, and grouping the exponent and
+    // high-order bytes together is what lets LZ4/zstd find runs.
+    // ------------------------------------------------------------
+    constexpr uint32_t kCodecMask     = 0xffu;
+    constexpr uint32_t kCodecLz4      = 1;
+    constexpr uint32_t kCodecZstd     = 2;
+    constexpr uint32_t kChunkShuffled = 1u << 8;
+
+    // Largest expansion each format can encode: an LZ4 match length byte adds
+    // at most 255 bytes, a zstd RLE block turns ~4 bytes into 128 KiB.
+    constexpr uint64_t kLz4MaxRatio  = 255;
+    constexpr uint64_t kZstdMaxRatio = 32768;
+
+    static void byteShuffle4(const uint8_t* src, uint8_t* dst, size_t size) noexcept
+    {
+        const size_t n = size / 4;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t b = 0; b < 4; ++b)
+                dst[b * n + i] = src[i * 4 + b];
+        std::memcpy(dst + n * 4, src + n * 4, size - n * 4);
+    }
+
+    static void byteUnshuffle4(const uint8_t* src, uint8_t* dst, size_t size) noexcept
+    {
+        const size_t n = size / 4;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t b = 0; b < 4; ++b)
+                dst[i * 4 + b] = src[b * n + i];
+        std::memcpy(dst + n * 4, src + n * 4, size - n * 4);
+    }
+
+    /// Compress @p data into @p out. Returns false (raw, flags 0) when that is not smaller.
+    static bool compressChunk(std::span<const uint8_t> data, std::vector<uint8_t>& out, uint32_t& flags, NativeCodec codec, int level, bool shuffle)
+    {
+        flags = 0;
+        if (data.size() < 64 || data.size() > size_t(LZ4_MAX_INPUT_SIZE))
+            return false;
+
+        std::vector<uint8_t> shuffled;
+        const uint8_t*       src = data.data();
+        if (shuffle)
+        {
+            shuffled.resize(data.size());
+            byteShuffle4(data.data(), shuffled.data(), data.size());
+            src = shuffled.data();
+        }
+
+        const uint64_t rawSize = data.size();
+        size_t         packed  = 0;
+
+        if (codec == NativeCodec::Zstd)
+        {
+            out.resize(sizeof(rawSize) + ZSTD_compressBound(data.size()));
+            packed = ZSTD_compress(out.data() + sizeof(rawSize), out.size() - sizeof(rawSize), src, data.size(), level);
+            if (ZSTD_isError(packed))
+                return false;
+            flags = kCodecZstd;
+        }
+        else
+        {
+            const int bound = LZ4_compressBound(int(data.size()));
+            out.resize(sizeof(rawSize) + size_t(bound));
+
+            char*       dst = reinterpret_cast<char*>(out.data() + sizeof(rawSize));
+            const char* in  = reinterpret_cast<const char*>(src);
+            const int   n   = level > 0 ? LZ4_compress_HC(in, dst, int(data.size()), bound, level)
+                                        : LZ4_compress_default(in, dst, int(data.size()), bound);
+            if (n <= 0)
+                return false;
+            packed = size_t(n);
+            flags  = kCodecLz4;
+        }
+
+        if (sizeof(rawSize) + packed >= data.size())
+        {
+            flags = 0;
+            return false;
+        }
+
+        std::memcpy(out.data(), &rawSize, sizeof(rawSize));
+        out.resize(sizeof(rawSize) + packed);
+
+        if (shuffle)
+            flags |= kChunkShuffled;
+        return true;
+    }
+
+    static bool decompressChunk(std::span<const uint8_t> in, uint32_t flags, std::vector<uint8_t>& out)
+    {
+        uint64_t rawSize = 0;
+        if (in.size() < sizeof(rawSize))
+            return false;
+        std::memcpy(&rawSize, in.data(), sizeof(rawSize));
+
+        const uint8_t* src  = in.data() + sizeof(rawSize);
+        const size_t   size = in.size() - sizeof(rawSize);
+
+        // rawSize comes from the file: check it against what the payload can
+        // possibly expand to before allocating. compressChunk() never packs
+        // more than LZ4_MAX_INPUT_SIZE bytes, whichever codec.
+        if (rawSize > uint64_t(LZ4_MAX_INPUT_SIZE))
+            return false;
+
+        switch (flags & kCodecMask)
+        {
+            case kCodecLz4:
+                if (rawSize > uint64_t(size) * kLz4MaxRatio)
+                    return false;
+                break;
+            case kCodecZstd:
+                if (ZSTD_getFrameContentSize(src, size) != rawSize || rawSize > uint64_t(size) * kZstdMaxRatio)
+                    return false;
+                break;
+            default:
+                return false;
+        }
+
+        try
+        {
+            out.resize(size_t(rawSize));
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        switch (flags & kCodecMask)
+        {
+            case kCodecLz4:
+            {
+                const int n = LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(out.data()), int(size), int(rawSize));
+                if (n < 0 || uint64_t(n) != rawSize)
+                    return false;
+                break;
+            }
+            case kCodecZstd:
+            {
+                const size_t n = ZSTD_decompress(out.data(), out.size(), src, size);
+                if (ZSTD_isError(n) || n != rawSize)
+                    return false;
+                break;
+            }
+            default:
+                return false;
+        }
+
+        if (flags & kChunkShuffled)
+        {
+            std::vector<uint8_t> plain(out.size());
+            byteUnshuffle4(out.data(), plain.data(), out.size());
+            out.swap(plain);
+        }
+
+        return true;
+    }
+
+    // ------------------------------------------------------------
+    // Reader: bounds-checked cursor over one chunk of the mapping.
+    // ------------------------------------------------------------
+    class ChunkReader
+    {
+    public:
+        ChunkReader(const uint8_t* data, uint64_t size) noexcept : m_data(data), m_size(size)
+        {
+        }
+
+        template<typename T>
+        [[nodiscard]] bool pod(T& out) noexcept
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (m_size - m_pos < sizeof(T))
+                return false;
+            std::memcpy(&out, m_data + m_pos, sizeof(T));
+            m_pos += sizeof(T);
+            return true;
+        }
+
+        [[nodiscard]] bool string(uint32_t length, std::string& out)
+        {
+            if (m_size - m_pos < length)
+                return false;
+            out.assign(reinterpret_cast<const char*>(m_data + m_pos), length);
+            m_pos += length;
+            return true;
+        }
+
+        /// Aligned in-place view of @p count elements (no copy).
+        template<typename T>
+        [[nodiscard]] bool array(uint64_t count, std::span<const T>& out) noexcept
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (!align() || count > (m_size - m_pos) / sizeof(T))
+                return false;
+
+            out = {reinterpret_cast<const T*>(m_data + m_pos), size_t(count)};
+            m_pos += count * sizeof(T);
+            return true;
+        }
+
+        [[nodiscard]] bool bytes(uint64_t count, std::span<const uint8_t>& out) noexcept
+        {
+            return array(count, out);
+        }
+
+        [[nodiscard]] bool align() noexcept
+        {
+            // Chunk offsets are 16-aligned, so aligning within the chunk aligns in memory.
+            const uint64_t pad = (kAlignment - (m_pos % kAlignment)) % kAlignment;
+            if (m_size - m_pos < pad)
+                return false;
+            m_pos += pad;
+            return true;
+        }
+
+    private:
+        const uint8_t* m_data = nullptr;
+        uint64_t       m_size = 0;
+        uint64_t       m_pos  = 0;
+    };
+
+    // ------------------------------------------------------------
+    // Save helpers
+    // ------------------------------------------------------------
+    static void writeImageChunk(BinWriter& w, const Image& img, const std::string& key, const std::filesystem::path& baseDir)
+    {
+        ImageRecord rec = {};
+        std::string path;
+
+        const uint8_t* payload = nullptr;
+
+        if (!img.path().empty() && std::filesystem::exists(img.path()))
+        {
+            path         = portablePath(img.path(), baseDir);
+            rec.encoding = uint32_t(ImageEncoding::External);
+        }
+        else if (img.isKtx() && !img.ktxData().empty())
+        {
+            rec.encoding    = uint32_t(ImageEncoding::Encoded);
+            rec.payloadSize = img.ktxData().size();
+            payload         = img.ktxData().data();
+        }
+        else if (img.data() && img.width() > 0 && img.height() > 0)
+        {
+            rec.encoding    = uint32_t(ImageEncoding::Raw);
+            rec.width       = img.width();
+            rec.height      = img.height();
+            rec.channels    = img.channels();
+            rec.payloadSize = uint64_t(img.width()) * uint64_t(img.height()) * uint64_t(img.channels());
+            payload         = img.data();
+        }
+
+        rec.keyLength  = uint32_t(key.size());
+        rec.pathLength = uint32_t(path.size());
+
+        w.pod(rec);
+        w.string(key);
+        w.string(path);
+        w.align();
+        w.bytes(payload, size_t(rec.payloadSize));
+    }
+
+    static void writeMaterialChunk(BinWriter& w, const MaterialHandler& mh, const std::unordered_map<ImageId, int32_t>& imageIndex)
+    {
+        w.pod(uint32_t(mh.materials().size()));
+
+        for (const Material& mat : mh.materials())
+        {
+            MaterialRecord rec = {};
+
+            const glm::vec3& bc = mat.baseColor();
+            const glm::vec3& ec = mat.emissiveColor();
+
+            rec.baseColor[0]      = bc.r;
+            rec.baseColor[1]      = bc.g;
+            rec.baseColor[2]      = bc.b;
+            rec.opacity           = mat.opacity();
+            rec.roughness         = mat.roughness();
+            rec.metallic          = mat.metallic();
+            rec.ior               = mat.ior();
+            rec.emissiveIntensity = mat.emissiveIntensity();
+            rec.emissiveColor[0]  = ec.r;
+            rec.emissiveColor[1]  = ec.g;
+            rec.emissiveColor[2]  = ec.b;
+            rec.alphaMode         = uint32_t(mat.alphaMode());
+            rec.doubleSided       = mat.doubleSided() ? 1u : 0u;
+            rec.nameLength        = uint32_t(mat.name().size());
+
+            for (size_t t = 0; t < std::size(kTextureSlots); ++t)
+            {
+                const ImageId id = (mat.*kTextureSlots[t].get)();
+                const auto    it = imageIndex.find(id);
+                rec.textures[t]  = (id != kInvalidImageId && it != imageIndex.end()) ? it->second : -1;
+            }
+
+            w.pod(rec);
+            w.string(mat.name());
+        }
+    }
+
+    static void writeLightChunk(BinWriter& w, const std::vector<SceneLight*>& lights)
+    {
+        uint32_t count = 0;
+        for (const SceneLight* sl : lights)
+            count += sl ? 1u : 0u;
+
+        w.pod(count);
+
+        for (const SceneLight* sl : lights)
+        {
+            if (!sl)
+                continue;
+
+            LightRecord rec = {};
+
+            const glm::vec3 pos = sl->position();
+            const glm::vec3 dir = sl->direction();
+            const glm::vec3 col = sl->color();
+            const std::string name(sl->name());
+
+            rec.type          = uint32_t(sl->lightType());
+            rec.flags         = (sl->enabled() ? LightEnabled : 0u) | (sl->affectRaster() ? LightAffectRaster : 0u) |
+                        (sl->affectRt() ? LightAffectRt : 0u) | (sl->castShadows() ? LightCastShadows : 0u);
+            rec.position[0]   = pos.x;
+            rec.position[1]   = pos.y;
+            rec.position[2]   = pos.z;
+            rec.direction[0]  = dir.x;
+            rec.direction[1]  = dir.y;
+            rec.direction[2]  = dir.z;
+            rec.color[0]      = col.r;
+            rec.color[1]      = col.g;
+            rec.color[2]      = col.b;
+            rec.intensity     = sl->intensity();
+            rec.range         = sl->range();
+            rec.spotInnerCone = sl->spotInnerConeRad();
+            rec.spotOuterCone = sl->spotOuterConeRad();
+            rec.nameLength    = uint32_t(name.size());
+            mat4ToRowMajor(sl->model(), rec.modelRM);
+
+            w.pod(rec);
+            w.string(name);
+        }
+    }
+
+    // Probe IDs 0..31 for existing maps (same range as the text writer).
+    static std::vector<int32_t> discoverMapIds(const SysMesh* sys)
+    {
+        std::vector<int32_t> ids;
+        for (int32_t id = 0; id <= 31; ++id)
+            if (sys->map_find(id) != -1)
+                ids.push_back(id);
+        return ids;
+    }
+
+    /**
+     * @brief Copy what a MESH chunk needs out of @p sm. Main thread.
+     *
+     * Straight copies of the slot buffers, no renumbering; encodeMeshChunk()
+     * does the compaction later on a worker.
+     *
+     * @return nullptr when the mesh has nothing to write.
+     */
+    static std::shared_ptr<const imp_binary::MeshCapture> captureMesh(const SceneMesh& sm)
+    {
+        const SysMesh* sys = sm.sysMesh();
+        if (!sys)
+            return nullptr;
+
+        const std::vector<int32_t>& vAll = sys->all_verts();
+        const std::vector<int32_t>& pAll = sys->all_polys();
+        if (vAll.empty() || pAll.empty())
+            return nullptr;
+
+        auto cap            = std::make_shared<imp_binary::MeshCapture>();
+        cap->name           = std::string(sm.name());
+        cap->flags          = (sm.visible() ? MeshVisible : 0u) | (sm.selected() ? MeshSelected : 0u);
+        cap->subdivLevel    = int32_t(sm.subdivisionLevel());
+        cap->vertBufferSize = size_t(sys->vert_buffer_size());
+        cap->vertSlots      = vAll;
+        mat4ToRowMajor(sm.model(), cap->modelRM);
+
+        cap->positions.reserve(vAll.size() * 3);
+        for (int32_t vi : vAll)
+        {
+            const glm::vec3& p = sys->vert_position(vi);
+            cap->positions.push_back(p.x);
+            cap->positions.push_back(p.y);
+            cap->positions.push_back(p.z);
+        }
+
+        std::vector<int32_t> polys;
+        polys.reserve(pAll.size());
+        cap->polyOffsets.reserve(pAll.size() + 1);
+        cap->polyMaterials.reserve(pAll.size());
+        cap->polyVerts.reserve(pAll.size() * 4);
+
+        cap->polyOffsets.push_back(0);
+        for (int32_t pid : pAll)
+        {
+            if (!sys->poly_valid(pid))
+                continue;
+
+            const SysPolyVerts& pv = sys->poly_verts(pid);
+            if (pv.size() < 3)
+                continue;
+
+            polys.push_back(pid);
+            cap->polyMaterials.push_back(sys->poly_material(pid));
+            for (int32_t vi : pv)
+                cap->polyVerts.push_back(vi);
+            cap->polyOffsets.push_back(uint32_t(cap->polyVerts.size()));
+        }
+
+        if (polys.empty())
+            return nullptr;
+
+        for (int32_t mapId : discoverMapIds(sys))
+        {
+            const int32_t map = sys->map_find(mapId);
+            const int32_t dim = map != -1 ? sys->map_dim(map) : 0;
+            if (dim <= 0)
+                continue;
+
+            imp_binary::MeshCapture::Map& mc = cap->maps.emplace_back();
+            mc.id                            = mapId;
+            mc.dim                           = dim;
+
+            const int32_t slots = std::max(sys->map_buffer_size(map), 0);
+            mc.verts.reserve(size_t(slots) * size_t(dim));
+            for (int32_t mv = 0; mv < slots; ++mv)
+            {
+                const float* vec = sys->map_vert_position(map, mv);
+                for (int32_t k = 0; k < dim; ++k)
+                    mc.verts.push_back(vec ? vec[k] : 0.0f);
+            }
+
+            // Unbound polys (or ones whose map face does not match) get an empty range.
+            mc.polyOffsets.reserve(polys.size() + 1);
+            mc.polyOffsets.push_back(0);
+            for (int32_t pid : polys)
+            {
+                if (sys->map_poly_valid(map, pid))
+                {
+                    const SysPolyVerts& mpv = sys->map_poly_verts(map, pid);
+                    if (mpv.size() == sys->poly_verts(pid).size())
+                    {
+                        for (int32_t mv : mpv)
+                            mc.polyVerts.push_back(mv);
+                    }
+                }
+                mc.polyOffsets.push_back(uint32_t(mc.polyVerts.size()));
+            }
+        }
+
+        return cap;
+    }
+
+    /// Serialize a captureMesh() result. Any thread.
+    static void encodeMeshChunk(BinWriter& w, const imp_binary::MeshCapture& cap)
+    {
+        // Dense vertex numbering via a slot-indexed table (no hashing).
+        std::vector<int32_t> toDense(cap.vertBufferSize, 0);
+        for (size_t dense = 0; dense < cap.vertSlots.size(); ++dense)
+            toDense[size_t(cap.vertSlots[dense])] = int32_t(dense);
+
+        std::vector<uint32_t> polyIndices;
+        polyIndices.reserve(cap.polyVerts.size());
+        for (int32_t vi : cap.polyVerts)
+            polyIndices.push_back(uint32_t(toDense[size_t(vi)]));
+
+        const size_t polyCount = cap.polyMaterials.size();
+
+        struct MapData
+        {
+            MapRecord             rec;
+            std::vector<float>    verts;
+            std::vector<uint32_t> bindPolys;
+            std::vector<uint32_t> bindOffsets;
+            std::vector<uint32_t> bindIndices;
+        };
+        std::vector<MapData> maps;
+
+        for (const imp_binary::MeshCapture::Map& mc : cap.maps)
+        {
+            const size_t dim = size_t(mc.dim);
+
+            MapData md     = {};
+            md.rec.id      = mc.id;
+            md.rec.dim     = mc.dim;
+            md.bindOffsets.push_back(0);
+
+            // Compact map verts to the ones referenced by written polys.
+            std::vector<int32_t> mvToDense(mc.verts.size() / dim, -1);
+
+            for (size_t polyDense = 0; polyDense < polyCount; ++polyDense)
+            {
+                const uint32_t begin = mc.polyOffsets[polyDense];
+                const uint32_t end   = mc.polyOffsets[polyDense + 1];
+                if (begin == end)
+                    continue;
+
+                for (uint32_t k = begin; k < end; ++k)
+                {
+                    const int32_t mv    = mc.polyVerts[k];
+                    uint32_t      dense = 0;
+                    if (mv >= 0 && size_t(mv) < mvToDense.size())
+                    {
+                        if (mvToDense[size_t(mv)] < 0)
+                        {
+                            const float* vec      = mc.verts.data() + size_t(mv) * dim;
+                            mvToDense[size_t(mv)] = int32_t(md.verts.size() / dim);
+                            md.verts.insert(md.verts.end(), vec, vec + dim);
+                        }
+                        dense = uint32_t(mvToDense[size_t(mv)]);
+                    }
+                    md.bindIndices.push_back(dense);
+                }
+
+                md.bindPolys.push_back(uint32_t(polyDense));
+                md.bindOffsets.push_back(uint32_t(md.bindIndices.size()));
+            }
+
+            if (md.bindPolys.empty() || md.verts.empty())
+                continue;
+
+            md.rec.vertCount      = uint32_t(md.verts.size() / dim);
+            md.rec.bindCount      = uint32_t(md.bindPolys.size());
+            md.rec.bindIndexCount = uint32_t(md.bindIndices.size());
+            maps.push_back(std::move(md));
+        }
+
+        MeshRecord rec  = {};
+        rec.nameLength  = uint32_t(cap.name.size());
+        rec.flags       = cap.flags;
+        rec.subdivLevel = cap.subdivLevel;
+        rec.mapCount    = uint32_t(maps.size());
+        rec.vertCount   = uint32_t(cap.vertSlots.size());
+        rec.polyCount   = uint32_t(polyCount);
+        rec.indexCount  = uint32_t(polyIndices.size());
+        std::memcpy(rec.modelRM, cap.modelRM, sizeof(rec.modelRM));
+
+        w.pod(rec);
+        w.string(cap.name);
+        w.array(cap.positions);
+        w.array(cap.polyOffsets);
+        w.array(cap.polyMaterials);
+        w.array(polyIndices);
+
+        for (const MapData& md : maps)
+        {
+            w.align();
+            w.pod(md.rec);
+            w.array(md.verts);
+            w.array(md.bindPolys);
+            w.array(md.bindOffsets);
+            w.array(md.bindIndices);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Load helpers
+    // ------------------------------------------------------------
+    static bool readImageChunk(ChunkReader& r, ImageHandler* ih, const std::filesystem::path& baseDir, ImageId& outId, SceneIOReport& report)
+    {
+        outId = kInvalidImageId;
+
+        ImageRecord rec = {};
+        std::string key;
+        std::string path;
+
+        std::span<const uint8_t> payload;
+
+        if (!r.pod(rec) || !r.string(rec.keyLength, key) || !r.string(rec.pathLength, path) || !r.bytes(rec.payloadSize, payload))
+        {
+            report.error("truncated image chunk");
+            return false;
+        }
+
+        if (!ih)
+            return true;
+
+        switch (ImageEncoding(rec.encoding))
+        {
+            case ImageEncoding::External:
+            {
+                const std::filesystem::path full = baseDir / path;
+                outId                            = ih->loadFromFileAsync(full, /*flipY=*/true);
+                if (outId == kInvalidImageId)
+                    report.warning("Could not load image: " + full.string());
+                break;
+            }
+            case ImageEncoding::Raw:
+            {
+                const uint64_t expected = uint64_t(std::max(rec.width, 0)) * uint64_t(std::max(rec.height, 0)) * uint64_t(std::max(rec.channels, 0));
+                if (expected == 0 || expected != payload.size())
+                {
+                    report.warning("Raw image size mismatch: " + key);
+                    break;
+                }
+
+                // Already flipped when first loaded; do NOT flip again.
+                outId = ih->createFromRaw(payload.data(), rec.width, rec.height, rec.channels, key, /*flipY=*/false);
+                if (outId == kInvalidImageId)
+                    report.warning("Could not reconstruct raw image: " + key);
+                break;
+            }
+            case ImageEncoding::Encoded:
+            {
+                outId = ih->loadFromEncodedMemoryAsync(payload, key, /*flipY=*/true);
+                if (outId == kInvalidImageId)
+                    report.warning("Could not decode embedded image: " + key);
+                break;
+            }
+            default:
+                report.warning("Unknown image encoding: " + key);
+                break;
+        }
+
+        return true;
+    }
+
+    static bool readMaterialChunk(ChunkReader& r, MaterialHandler* mh, const std::vector<ImageId>& images, SceneIOReport& report)
+    {
+        uint32_t count = 0;
+        if (!r.pod(count))
+        {
+            report.error("truncated material chunk");
+            return false;
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            MaterialRecord rec = {};
+            std::string    name;
+            if (!r.pod(rec) || !r.string(rec.nameLength, name))
+            {
+                report.error("truncated material record");
+                return false;
+            }
+
+            if (!mh)
+                continue;
+
+            const int32_t matId = mh->createMaterial(name);
+            Material&     dst   = mh->material(matId);
+
+            dst.alphaMode(static_cast<Material::AlphaMode>(rec.alphaMode));
+            dst.doubleSided(rec.doubleSided != 0);
+            dst.opacity(rec.opacity);
+            dst.roughness(rec.roughness);
+            dst.metallic(rec.metallic);
+            dst.ior(rec.ior);
+            dst.emissiveIntensity(rec.emissiveIntensity);
+            dst.baseColor(glm::vec3(rec.baseColor[0], rec.baseColor[1], rec.baseColor[2]));
+            dst.emissiveColor(glm::vec3(rec.emissiveColor[0], rec.emissiveColor[1], rec.emissiveColor[2]));
+
+            for (size_t t = 0; t < std::size(kTextureSlots); ++t)
+            {
+                const int32_t idx = rec.textures[t];
+                const ImageId id  = (idx >= 0 && size_t(idx) < images.size()) ? images[size_t(idx)] : kInvalidImageId;
+                (dst.*kTextureSlots[t].set)(id);
+            }
+        }
+
+        return true;
+    }
+
+    static bool readLightChunk(ChunkReader& r, Scene* scene, SceneIOReport& report)
+    {
+        uint32_t count = 0;
+        if (!r.pod(count))
+        {
+            report.error("truncated light chunk");
+            return false;
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            LightRecord rec = {};
+            std::string name;
+            if (!r.pod(rec) || !r.string(rec.nameLength, name))
+            {
+                report.error("truncated light record");
+                return false;
+            }
+
+            Light l{};
+            l.name             = name;
+            l.type             = static_cast<LightType>(rec.type);
+            l.position         = glm::vec3(rec.position[0], rec.position[1], rec.position[2]);
+            l.direction        = glm::vec3(rec.direction[0], rec.direction[1], rec.direction[2]);
+            l.color            = glm::vec3(rec.color[0], rec.color[1], rec.color[2]);
+            l.intensity        = rec.intensity;
+            l.range            = rec.range;
+            l.spotInnerConeRad = rec.spotInnerCone;
+            l.spotOuterConeRad = rec.spotOuterCone;
+            l.enabled          = (rec.flags & LightEnabled) != 0;
+            l.affectRaster     = (rec.flags & LightAffectRaster) != 0;
+            l.affectRt         = (rec.flags & LightAffectRt) != 0;
+            l.castShadows      = (rec.flags & LightCastShadows) != 0;
+
+            SceneLight* sl = scene->createSceneLight(l);
+            if (sl)
+                sl->model(rowMajorToMat4(rec.modelRM));
+            else
+                report.warning("Failed to create light: " + name);
+        }
+
+        return true;
+    }
+
+    static bool readMeshChunk(ChunkReader& r, Scene* scene, SceneIOReport& report)
+    {
+        MeshRecord rec = {};
+        std::string name;
+
+        std::span<const float>    positions;
+        std::span<const uint32_t> polyOffsets;
+        std::span<const uint32_t> polyMaterials;
+        std::span<const uint32_t> polyIndices;
+
+        if (!r.pod(rec) || !r.string(rec.nameLength, name) ||
+            !r.array(uint64_t(rec.vertCount) * 3, positions) ||
+            !r.array(uint64_t(rec.polyCount) + 1, polyOffsets) ||
+            !r.array(rec.polyCount, polyMaterials) ||
+            !r.array(rec.indexCount, polyIndices))
+        {
+            report.error("truncated mesh chunk");
+            return false;
+        }
+
+        if (rec.vertCount == 0 || rec.polyCount == 0 || polyOffsets[0] != 0 || polyOffsets[rec.polyCount] != rec.indexCount)
+        {
+            report.error("invalid mesh chunk: " + name);
+            return false;
+        }
+
+        SceneMesh* sm = scene->createSceneMesh(name);
+        if (!sm)
+        {
+            report.error("could not create SceneMesh");
+            return false;
+        }
+
+        sm->visible((rec.flags & MeshVisible) != 0);
+        sm->selected((rec.flags & MeshSelected) != 0);
+        sm->model(rowMajorToMat4(rec.modelRM));
+        sm->subdivisionLevel(rec.subdivLevel - sm->subdivisionLevel());
+
+        SysMesh* sys = sm->sysMesh();
+        if (!sys)
+        {
+            report.error("null SysMesh");
+            return false;
+        }
+
+        sys->clear();
+        sys->reserve(int32_t(rec.vertCount));
+
+        // Straight from the mapped arrays into SysMesh.
+        std::vector<int32_t> vertIds(rec.vertCount);
+        for (uint32_t v = 0; v < rec.vertCount; ++v)
+            vertIds[v] = sys->create_vert(glm::vec3(positions[v * 3 + 0], positions[v * 3 + 1], positions[v * 3 + 2]));
+
+        std::vector<int32_t> polyIds(rec.polyCount, -1);
+        SysPolyVerts         pv;
+        for (uint32_t p = 0; p < rec.polyCount; ++p)
+        {
+            const uint32_t begin = polyOffsets[p];
+            const uint32_t end   = polyOffsets[p + 1];
+            if (begin > end || end > rec.indexCount)
+            {
+                report.error("invalid polygon offsets in mesh: " + name);
+                return false;
+            }
+
+            pv.clear();
+            for (uint32_t k = begin; k < end; ++k)
+            {
+                const uint32_t di = polyIndices[k];
+                if (di >= rec.vertCount)
+                {
+                    report.error("polygon index out of range");
+                    return false;
+                }
+                pv.push_back(vertIds[di]);
+            }
+
+            if (pv.size() >= 3)
+                polyIds[p] = sys->create_poly(pv, polyMaterials[p]);
+        }
+
+        for (uint32_t m = 0; m < rec.mapCount; ++m)
+        {
+            MapRecord mr = {};
+
+            std::span<const float>    mapVerts;
+            std::span<const uint32_t> bindPolys;
+            std::span<const uint32_t> bindOffsets;
+            std::span<const uint32_t> bindIndices;
+
+            if (!r.align() || !r.pod(mr) || mr.dim <= 0 ||
+                !r.array(uint64_t(mr.vertCount) * uint64_t(mr.dim), mapVerts) ||
+                !r.array(mr.bindCount, bindPolys) ||
+                !r.array(uint64_t(mr.bindCount) + 1, bindOffsets) ||
+                !r.array(mr.bindIndexCount, bindIndices))
+            {
+                report.error("truncated map in mesh: " + name);
+                return false;
+            }
+
+            if (sys->map_find(mr.id) != -1)
+                sys->map_remove(mr.id);
+
+            const int32_t map = sys->map_create(mr.id, 0, mr.dim);
+            if (map < 0)
+            {
+                report.warning("Failed to create map id " + std::to_string(mr.id));
+                continue;
+            }
+
+            std::vector<int32_t> mapVertIds(mr.vertCount);
+            for (uint32_t v = 0; v < mr.vertCount; ++v)
+                mapVertIds[v] = sys->map_create_vert(map, mapVerts.data() + size_t(v) * size_t(mr.dim));
+
+            SysPolyVerts mpv;
+            for (uint32_t b = 0; b < mr.bindCount; ++b)
+            {
+                const uint32_t polyDense = bindPolys[b];
+                const uint32_t begin     = bindOffsets[b];
+                const uint32_t end       = bindOffsets[b + 1];
+
+                if (polyDense >= rec.polyCount || begin > end || end > mr.bindIndexCount)
+                    continue;
+
+                const int32_t polyId = polyIds[polyDense];
+                if (polyId < 0 || !sys->poly_valid(polyId) || uint32_t(sys->poly_verts(polyId).size()) != end - begin)
+                    continue;
+
+                mpv.clear();
+                for (uint32_t k = begin; k < end; ++k)
+                {
+                    const uint32_t dmv = bindIndices[k];
+                    mpv.push_back(dmv < mapVertIds.size() ? mapVertIds[dmv] : (mapVertIds.empty() ? -1 : mapVertIds[0]));
+                }
+                sys->map_create_poly(map, polyId, mpv);
+            }
+        }
+
+        return true;
+    }
+
+} // namespace
+
+// ============================================================
+// API
+// ============================================================
+namespace imp_binary
+{
+    // ------------------------------------------------------------
+    // ChunkCache
+    // ------------------------------------------------------------
+    void ChunkCache::clear()
+    {
+        std::lock_guard lock(m_mutex);
+        m_meshes.clear();
+        m_images.clear();
+        ++m_epoch;
+    }
+
+    ChunkCache::Map* ChunkCache::map(CacheSlot slot) noexcept
+    {
+        switch (slot)
+        {
+            case CacheSlot::Mesh:
+                return &m_meshes;
+            case CacheSlot::Image:
+                return &m_images;
+            default:
+                return nullptr;
+        }
+    }
+
+    uint64_t ChunkCache::begin(const std::filesystem::path& baseDir, const SaveOptions& options)
+    {
+        std::lock_guard lock(m_mutex);
+
+        // Packed bytes depend on the codec, and image chunks on the base dir.
+        const bool settingsChanged = baseDir != m_baseDir || options.compressNative != m_compress ||
+                                     (options.compressNative && (options.compressCodec != m_codec || options.compressLevel != m_level));
+        if (settingsChanged)
+        {
+            m_meshes.clear();
+            m_images.clear();
+            ++m_epoch;
+
+            m_baseDir  = baseDir;
+            m_compress = options.compressNative;
+            m_codec    = options.compressCodec;
+            m_level    = options.compressLevel;
+        }
+
+        for (auto& [key, e] : m_meshes)
+            e.seen = false;
+        for (auto& [key, e] : m_images)
+            e.seen = false;
+
+        return m_epoch;
+    }
+
+    bool ChunkCache::acquire(CacheSlot slot, uint64_t key, uint64_t stamp, SysCounterPtr pin, SnapshotChunk& out)
+    {
+        std::lock_guard lock(m_mutex);
+
+        Map* m = map(slot);
+        if (!m)
+            return false;
+
+        Entry& e = (*m)[key];
+        e.seen   = true;
+        if (pin)
+            e.pin = std::move(pin);
+
+        if (!e.bytes || e.stamp != stamp)
+            return false;
+
+        out.data   = e.bytes;
+        out.flags  = e.flags;
+        out.packed = true;
+        return true;
+    }
+
+    void ChunkCache::store(uint64_t epoch, const SnapshotChunk& chunk)
+    {
+        std::lock_guard lock(m_mutex);
+
+        Map* m = map(chunk.slot);
+        if (!m || epoch != m_epoch)
+            return;
+
+        // Only acquired entries: a key whose object is gone must not come back unpinned.
+        auto it = m->find(chunk.key);
+        if (it == m->end())
+            return;
+
+        // Stamps only grow; an older autosave finishing late must not replace a newer save.
+        Entry& e = it->second;
+        if (e.bytes && e.stamp > chunk.stamp)
+            return;
+
+        e.stamp = chunk.stamp;
+        e.flags = chunk.flags;
+        e.bytes = chunk.data;
+    }
+
+    void ChunkCache::end()
+    {
+        std::lock_guard lock(m_mutex);
+        std::erase_if(m_meshes, [](const auto& kv) { return !kv.second.seen; });
+        std::erase_if(m_images, [](const auto& kv) { return !kv.second.seen; });
+    }
+
+    // ------------------------------------------------------------
+    // Save
+    // ------------------------------------------------------------
+    bool isBinary(std::span<const uint8_t> head) noexcept
+    {
+        return head.size() >= sizeof(FileHeader) && std::memcmp(head.data(), kMagic, sizeof(kMagic)) == 0;
+    }
+
+    Snapshot capture(const Scene* scene, const std::filesystem::path& filePath, const SaveOptions& options, ChunkCache* cache)
+    {
+        Snapshot snap = {};
+        snap.options  = options;
+
+        const std::filesystem::path baseDir = filePath.parent_path();
+
+        if (cache)
+            snap.cacheEpoch = cache->begin(baseDir, options);
+
+        auto addChunk = [&](uint32_t type, CacheSlot slot, uint64_t key, uint64_t stamp, SysCounterPtr pin, auto&& body) {
+            SnapshotChunk c = {};
+            c.type          = type;
+            c.slot          = cache ? slot : CacheSlot::None;
+            c.key           = key;
+            c.stamp         = stamp;
+
+            if (c.slot != CacheSlot::None && cache->acquire(slot, key, stamp, std::move(pin), c))
+            {
+                snap.chunks.push_back(std::move(c));
+                return;
+            }
+
+            auto      bytes = std::make_shared<std::vector<uint8_t>>();
+            BinWriter w(*bytes);
+            if (!body(w))
+                return;
+
+            c.data = std::move(bytes);
+            snap.chunks.push_back(std::move(c));
+        };
+
+        // --------------------------------------------------------
+        // Images (IMAG index = position among written images)
+        // --------------------------------------------------------
+        std::unordered_map<ImageId, int32_t> imageIndex;
+
+        if (const ImageHandler* ih = scene->imageHandler())
+        {
+            // Images have no counter of their own; any handler change re-captures them all.
+            const uint64_t imagesStamp = ih->changeCounter()->value();
+
+            for (ImageId id = 0; id < static_cast<ImageId>(ih->images().size()); ++id)
+            {
+                const Image* img = ih->get(id);
+                if (!img || !img->valid())
+                    continue;
+
+                const std::string key = !img->path().empty() ? portablePath(img->path(), baseDir)
+                                                             : (img->name().empty() ? ("image_" + std::to_string(id)) : img->name());
+
+                addChunk(kChunkImage, CacheSlot::Image, uint64_t(id), imagesStamp, nullptr, [&](BinWriter& w) {
+                    writeImageChunk(w, *img, key, baseDir);
+                    return true;
+                });
+                imageIndex[id] = int32_t(imageIndex.size());
+            }
+        }
+
+        // --------------------------------------------------------
+        // Materials / lights (small; always re-captured)
+        // --------------------------------------------------------
+        if (const MaterialHandler* mh = scene->materialHandler(); mh && !mh->materials().empty())
+        {
+            addChunk(kChunkMaterial, CacheSlot::None, 0, 0, nullptr, [&](BinWriter& w) {
+                writeMaterialChunk(w, *mh, imageIndex);
+                return true;
+            });
+        }
+
+        if (const std::vector<SceneLight*> lights = scene->sceneLights(); !lights.empty())
+        {
+            addChunk(kChunkLight, CacheSlot::None, 0, 0, nullptr, [&](BinWriter& w) {
+                writeLightChunk(w, lights);
+                return true;
+            });
+        }
+
+        // --------------------------------------------------------
+        // Meshes
+        //
+        // Keyed by the SceneMesh change counter (transform, visibility,
+        // selection) and stamped with it plus the SysMesh topology and
+        // deform counters. All three only grow, so their sum moves exactly
+        // when the chunk contents can have changed.
+        // --------------------------------------------------------
+        for (const SceneMesh* sm : scene->sceneMeshes())
+        {
+            if (!sm || (options.selectedOnly && !sm->selected()))
+                continue;
+
+            const SysCounterPtr counter = sm->changeCounter();
+            const SysMesh*      sys     = sm->sysMesh();
+
+            uint64_t stamp = counter->value();
+            if (sys)
+                stamp += sys->topology_counter()->value() + sys->deform_counter()->value();
+
+            // Only a plain copy is taken here; write() serializes it on the worker.
+            SnapshotChunk c = {};
+            c.type          = kChunkMesh;
+            c.slot          = cache ? CacheSlot::Mesh : CacheSlot::None;
+            c.key           = uint64_t(reinterpret_cast<uintptr_t>(counter.get()));
+            c.stamp         = stamp;
+
+            if (c.slot != CacheSlot::None && cache->acquire(c.slot, c.key, stamp, counter, c))
+            {
+                snap.chunks.push_back(std::move(c));
+                continue;
+            }
+
+            c.mesh = captureMesh(*sm);
+            if (c.mesh)
+                snap.chunks.push_back(std::move(c));
+        }
+
+        if (cache)
+            cache->end();
+
+        return snap;
+    }
+
+    bool write(const Snapshot& snapshot, const std::filesystem::path& filePath, SceneIOReport& report, ChunkCache* cache)
+    {
+        if constexpr (std::endian::native != std::endian::little)
+        {
+            report.status = SceneIOStatus::WriteError;
+            report.error("binary .imp requires a little-endian host");
+            return false;
+        }
+
+        const SaveOptions&      options = snapshot.options;
+        const size_t            count   = snapshot.chunks.size();
+        std::vector<ChunkBytes> bytes(count);
+        std::vector<uint32_t>   flags(count, 0);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            bytes[i] = snapshot.chunks[i].data;
+            flags[i] = snapshot.chunks[i].flags;
+        }
+
+        // --------------------------------------------------------
+        // Mesh serialization and compression (independent chunks, in
+        // parallel; cached ones are final)
+        // --------------------------------------------------------
+        TaskPool::shared().parallelFor(uint32_t(count), [&](uint32_t i) {
+            const SnapshotChunk& c = snapshot.chunks[i];
+            if (c.packed)
+                return;
+
+            if (c.mesh)
+            {
+                auto      encoded = std::make_shared<std::vector<uint8_t>>();
+                BinWriter w(*encoded);
+                encodeMeshChunk(w, *c.mesh);
+                bytes[i] = std::move(encoded);
+            }
+
+            if (!options.compressNative)
+                return;
+
+            std::vector<uint8_t> out;
+            if (compressChunk(*bytes[i], out, flags[i], options.compressCodec, options.compressLevel, c.type == kChunkMesh))
+                bytes[i] = std::make_shared<const std::vector<uint8_t>>(std::move(out));
+        });
+
+        // --------------------------------------------------------
+        // File: header, aligned chunks, directory -> temp, then rename
+        // --------------------------------------------------------
+        std::filesystem::path tmpPath = filePath;
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream out(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+            {
+                report.status = SceneIOStatus::WriteError;
+                report.error("could not open file for writing");
+                return false;
+            }
+
+            static constexpr char kZeros[kAlignment] = {};
+
+            uint64_t filePos  = 0;
+            auto     writeRaw = [&](const void* data, size_t size) {
+                out.write(static_cast<const char*>(data), std::streamsize(size));
+                filePos += size;
+            };
+            auto alignFile = [&] {
+                writeRaw(kZeros, size_t((kAlignment - (filePos % kAlignment)) % kAlignment));
+            };
+
+            FileHeader header = {};
+            writeRaw(&header, sizeof(header));
+
+            std::vector<ChunkEntry> chunks;
+            chunks.reserve(count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                alignFile();
+
+                ChunkEntry e = {};
+                e.type       = snapshot.chunks[i].type;
+                e.flags      = flags[i];
+                e.offset     = filePos;
+                e.size       = bytes[i]->size();
+                chunks.push_back(e);
+
+                writeRaw(bytes[i]->data(), bytes[i]->size());
+            }
+
+            alignFile();
+
+            header.version         = kVersion;
+            header.chunkCount      = uint32_t(chunks.size());
+            header.directoryOffset = filePos;
+            std::memcpy(header.magic, kMagic, sizeof(kMagic));
+
+            writeRaw(chunks.data(), chunks.size() * sizeof(ChunkEntry));
+
+            out.seekp(0);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.close();
+
+            if (!out.good())
+            {
+                std::error_code ec;
+                std::filesystem::remove(tmpPath, ec);
+
+                report.status = SceneIOStatus::WriteError;
+                report.error("write error");
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, filePath, ec);
+        if (ec)
+        {
+            const std::string reason = ec.message();
+            std::filesystem::remove(tmpPath, ec);
+
+            report.status = SceneIOStatus::WriteError;
+            report.error("could not replace file: " + reason);
+            return false;
+        }
+
+        if (cache)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const SnapshotChunk& c = snapshot.chunks[i];
+                if (c.packed || c.slot == CacheSlot::None)
+                    continue;
+
+                SnapshotChunk packed = c;
+                packed.data          = bytes[i];
+                packed.flags         = flags[i];
+                packed.packed        = true;
+                cache->store(snapshot.cacheEpoch, packed);
+            }
+        }
+
+        report.status = SceneIOStatus::Ok;
+        report.info("Saved binary .imp v" + std::to_string(kVersion) + " scene");
+        return true;
+    }
+
+    bool save(const Scene* scene, const std::filesystem::path& filePath, const SaveOptions& options, SceneIOReport& report)
+    {
+        return write(capture(scene, filePath, options), filePath, report);
+    }
+
+    bool load(Scene* scene, const MappedFile& file, const std::filesystem::path& filePath, const LoadOptions& options, SceneIOReport& report)
+    {
+        if constexpr (std::endian::native != std::endian::little)
+        {
+            report.status = SceneIOStatus::UnsupportedFormat;
+            report.error("binary .imp requires a little-endian host");
+            return false;
+        }
+
+        const uint8_t* base = file.data();
+        const uint64_t size = file.size();
+
+        FileHeader header = {};
+        if (!isBinary(file.bytes()))
+        {
+            report.status = SceneIOStatus::UnsupportedFormat;
+            report.error("not a binary .imp file");
+            return false;
+        }
+        std::memcpy(&header, base, sizeof(header));
+
+        if (header.version != kVersion)
+        {
+            report.status = SceneIOStatus::UnsupportedFormat;
+            report.error("unsupported binary .imp version " + std::to_string(header.version));
+            return false;
+        }
+
+        if (header.directoryOffset > size || uint64_t(header.chunkCount) > (size - header.directoryOffset) / sizeof(ChunkEntry))
+        {
+            report.status = SceneIOStatus::ReadError;
+            report.error("chunk directory out of range");
+            return false;
+        }
+
+        std::vector<ChunkEntry> chunks(header.chunkCount);
+        if (!chunks.empty())
+            std::memcpy(chunks.data(), base + header.directoryOffset, chunks.size() * sizeof(ChunkEntry));
+
+        for (const ChunkEntry& e : chunks)
+        {
+            if (e.offset > size || e.size > size - e.offset || (e.offset % kAlignment) != 0)
+            {
+                report.status = SceneIOStatus::ReadError;
+                report.error("chunk out of range");
+                return false;
+            }
+        }
+
+        // Compressed chunks are detected from their directory flags and
+        // inflated in parallel; raw chunks stay in the mapping.
+        std::vector<std::vector<uint8_t>> inflated(chunks.size());
+        std::vector<uint8_t>              inflateOk(chunks.size(), 1);
+
+        TaskPool::shared().parallelFor(uint32_t(chunks.size()), [&](uint32_t i) {
+            const ChunkEntry& e = chunks[i];
+            if ((e.flags & kCodecMask) != 0)
+                inflateOk[i] = decompressChunk({base + e.offset, size_t(e.size)}, e.flags, inflated[i]) ? 1 : 0;
+        });
+
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            if (!inflateOk[i])
+            {
+                report.status = SceneIOStatus::ReadError;
+                report.error("could not decompress chunk " + std::to_string(i));
+                return false;
+            }
+        }
+
+        auto forEachChunk = [&](uint32_t type, auto&& fn) -> bool {
+            for (size_t i = 0; i < chunks.size(); ++i)
+            {
+                const ChunkEntry& e = chunks[i];
+                if (e.type != type)
+                    continue;
+
+                ChunkReader r = (e.flags & kCodecMask) != 0 ? ChunkReader(inflated[i].data(), inflated[i].size())
+                                                            : ChunkReader(base + e.offset, e.size);
+                if (!fn(r))
+                    return false;
+            }
+            return true;
+        };
+
+        if (!options.mergeIntoExisting)
+            scene->clear();
+
+        const std::filesystem::path baseDir = filePath.parent_path();
+
+        // Images first: materials refer to them by index.
+        std::vector<ImageId> images;
+        ImageHandler*        ih = scene->imageHandler();
+
+        const bool ok = forEachChunk(kChunkImage, [&](ChunkReader& r) {
+                            ImageId id = kInvalidImageId;
+                            if (!readImageChunk(r, ih, baseDir, id, report))
+                                return false;
+                            images.push_back(id);
+                            return true;
+                        }) &&
+                        forEachChunk(kChunkMaterial, [&](ChunkReader& r) { return readMaterialChunk(r, scene->materialHandler(), images, report); }) &&
+                        forEachChunk(kChunkLight, [&](ChunkReader& r) { return readLightChunk(r, scene, report); }) &&
+                        forEachChunk(kChunkMesh, [&](ChunkReader& r) { return readMeshChunk(r, scene, report); });
+
+        if (!ok || report.hasErrors())
+            return false;
+
+        report.status = SceneIOStatus::Ok;
+        report.info("Loaded binary .imp v" + std::to_string(kVersion) + " scene");
+        return true;
+    }
+
+} // namespace imp_binary
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <SysCounter.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "SceneFormat.hpp"
+
+class MappedFile;
+class Scene;
+
+/**
+ * @brief Binary chunked container for the native .imp format.
+ *
+ * Little-endian throughout. Layout:
+ *
+ *   FileHeader   magic "IMP3DBIN", version, chunk count, directory offset
+ *   chunks...    each starts 16-byte aligned
+ *   ChunkEntry[] directory (type fourcc, offset, size)
+ *
+ * Chunk types (loaded in this order, whatever their position in the file):
+ *   IMAG  one per image: key, relative path or raw payload (pixels / KTX)
+ *   MATL  all materials; texture slots refer to images by IMAG index
+ *   LGHT  all lights
+ *   MESH  one per mesh: positions, poly offsets/materials/indices, maps
+ *
+ * Every array inside a chunk is 16-byte aligned, so the loader reads them in
+ * place from a MappedFile without parsing or copying. Unknown chunk types
+ * are skipped, which is how the format grows.
+ *
+ * With SaveOptions::compressNative each chunk is compressed on its own
+ * (LZ4 or zstd, flagged in the directory; MESH chunks byte-shuffled first),
+ * so chunks compress and decompress in parallel. The loader detects the
+ * codec per chunk and only inflates those; raw chunks are still zero-copy.
+ *
+ * Saving is split in two: capture() copies the scene on the main thread
+ * (small chunks as bytes, meshes as plain arrays), write() serializes the
+ * meshes, compresses and replaces the file on any thread. A ChunkCache
+ * carried between saves lets capture() hand back the already-packed bytes
+ * of meshes whose change counters have not moved.
+ *
+ * The text format (imp_scene 1..3) is still read, and written on export
+ * (SaveOptions::textNative); see ImpSceneFormat.
+ */
+namespace imp_binary
+{
+    /// Binary version; text files use 1..3, so the container starts at 4.
+    inline constexpr uint32_t kVersion = 4;
+
+    /// Chunk payload, shared between snapshots and the ChunkCache; never mutated.
+    using ChunkBytes = std::shared_ptr<const std::vector<uint8_t>>;
+
+    /// Copy of one mesh's arrays, serialized by write(); defined in the .cpp.
+    struct MeshCapture;
+
+    enum class CacheSlot : uint8_t
+    {
+        None,
+        Mesh,  ///< key = address of the SceneMesh change counter
+        Image, ///< key = ImageId
+    };
+
+    struct SnapshotChunk
+    {
+        uint32_t                           type   = 0;
+        uint32_t                           flags  = 0;     ///< Directory flags, valid once packed.
+        bool                               packed = false; ///< Bytes are final (from the cache), write() copies them as-is.
+        ChunkBytes                         data   = {};
+        std::shared_ptr<const MeshCapture> mesh   = {};    ///< Set instead of data for MESH chunks write() still has to serialize.
+
+        CacheSlot slot  = CacheSlot::None;
+        uint64_t  key   = 0;
+        uint64_t  stamp = 0;
+    };
+
+    /**
+     * @brief Self-contained copy of everything save() writes.
+     *
+     * Holds no pointers into the scene, so write() can run on a worker while
+     * the user keeps editing.
+     */
+    struct Snapshot
+    {
+        std::vector<SnapshotChunk> chunks     = {};
+        SaveOptions                options    = {};
+        uint64_t                   cacheEpoch = 0;
+    };
+
+    /**
+     * @brief Packed chunks from previous saves, keyed by object and change stamp.
+     *
+     * capture() reads it on the main thread, write() fills it from a worker;
+     * all access goes through the internal mutex. Entries for meshes pin the
+     * mesh change counter, so a recycled address can never match a stale entry.
+     */
+    class ChunkCache
+    {
+    public:
+        void clear();
+
+        /// Start a capture: drops everything if the settings changed, and ages entries.
+        /// @return Epoch to hand back to store().
+        uint64_t begin(const std::filesystem::path& baseDir, const SaveOptions& options);
+
+        /**
+         * @brief Mark @p slot / @p key live for this capture.
+         *
+         * Creates the entry (pinned by @p pin) if needed, and fills @p out with
+         * the packed bytes when they were stored for the same @p stamp.
+         */
+        [[nodiscard]] bool acquire(CacheSlot slot, uint64_t key, uint64_t stamp, SysCounterPtr pin, SnapshotChunk& out);
+
+        /// Record the packed result of an acquired chunk; ignored if @p epoch or the entry is gone.
+        void store(uint64_t epoch, const SnapshotChunk& chunk);
+
+        /// Finish a capture: drops entries for objects that are gone.
+        void end();
+
+    private:
+        struct Entry
+        {
+            SysCounterPtr pin   = {};
+            uint64_t      stamp = 0;
+            uint32_t      flags = 0;
+            ChunkBytes    bytes = {};
+            bool          seen  = false;
+        };
+
+        using Map = std::unordered_map<uint64_t, Entry>;
+
+        Map* map(CacheSlot slot) noexcept;
+
+        std::mutex            m_mutex    = {};
+        Map                   m_meshes   = {};
+        Map                   m_images   = {};
+        std::filesystem::path m_baseDir  = {};
+        bool                  m_compress = false;
+        NativeCodec           m_codec    = NativeCodec::Lz4;
+        int                   m_level    = 0;
+        uint64_t              m_epoch    = 0; ///< Bumped on every reset; stale write() results are dropped.
+    };
+
+    /// True when @p head starts with the binary magic.
+    [[nodiscard]] bool isBinary(std::span<const uint8_t> head) noexcept;
+
+    /**
+     * @brief Copy @p scene into a Snapshot. Main thread only.
+     *
+     * Meshes are only copied here; write() turns them into chunk bytes. With a
+     * @p cache, unchanged meshes and images reuse their packed bytes from the
+     * last save instead of being copied again.
+     */
+    [[nodiscard]] Snapshot capture(const Scene* scene, const std::filesystem::path& filePath, const SaveOptions& options, ChunkCache* cache = nullptr);
+
+    /**
+     * @brief Compress @p snapshot and write it to @p filePath. Any thread.
+     *
+     * The file is written next to the target as "<name>.tmp" and renamed over
+     * it, so a crash mid-write never leaves a truncated scene behind.
+     */
+    bool write(const Snapshot& snapshot, const std::filesystem::path& filePath, SceneIOReport& report, ChunkCache* cache = nullptr);
+
+    /// capture() + write() without a cache.
+    bool save(const Scene* scene, const std::filesystem::path& filePath, const SaveOptions& options, SceneIOReport& report);
+
+    /// @param file Mapping of @p filePath (already checked with isBinary()).
+    bool load(Scene* scene, const MappedFile& file, const std::filesystem::path& filePath, const LoadOptions& options, SceneIOReport& report);
+
+} // namespace imp_binary
@@ -10,18 +10,25 @@
 #include <fstream>
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
+#include <iterator>
+#include <spanstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "ImageHandler.hpp"
+#include "ImpBinaryFormat.hpp"
+#include "MappedFile.hpp"
 #include "Material.hpp"
 #include "MaterialHandler.hpp"
 #include "Scene.hpp"
+#include "SceneIOUtils.hpp"
 #include "SceneLight.hpp"
 #include "SceneMesh.hpp"
 #include "SysMesh.hpp"
+#include "TaskPool.hpp"
 
 // ============================================================
 // Internal helpers
@@ -98,7 +105,7 @@ namespace
     // ------------------------------------------------------------
     // Text helpers (shared with original)
     // ------------------------------------------------------------
-    static std::string trim(std::string s)
+    static std::string_view trim_view(std::string_view s)
     {
         size_t a = 0;
         while (a < s.size() && std::isspace(static_cast<unsigned char>(s[a])))
@@ -109,13 +116,18 @@ namespace
         return s.substr(a, b - a);
     }
 
-    static bool is_comment_or_empty(const std::string& raw)
+    static std::string trim(const std::string& s)
     {
-        const std::string s = trim(raw);
-        return s.empty() || s.rfind("#", 0) == 0 || s.rfind("//", 0) == 0;
+        return std::string(trim_view(s));
     }
 
-    static bool next_line(std::ifstream& in, std::string& outLine)
+    static bool is_comment_or_empty(std::string_view raw)
+    {
+        const std::string_view s = trim_view(raw);
+        return s.empty() || s.starts_with("#") || s.starts_with("//");
+    }
+
+    static bool next_line(std::istream& in, std::string& outLine)
     {
         while (std::getline(in, outLine))
         {
@@ -339,7 +351,7 @@ namespace
     // ------------------------------------------------------------
     // parse_map (unchanged)
     // ------------------------------------------------------------
-    static bool parse_map(std::ifstream& in, MapBindingBlock& mb, SceneIOReport& report)
+    static bool parse_map(std::istream& in, MapBindingBlock& mb, SceneIOReport& report)
     {
         std::string line;
         if (!next_line(in, line) || trim(line) != "{")
@@ -504,7 +516,7 @@ namespace
     // ------------------------------------------------------------
     // parse_mesh (unchanged from v2)
     // ------------------------------------------------------------
-    static bool parse_mesh(std::ifstream& in, MeshBlock& mb, SceneIOReport& report)
+    static bool parse_mesh(std::istream& in, MeshBlock& mb, SceneIOReport& report)
     {
         std::string line;
         if (!next_line(in, line) || trim(line) != "{")
@@ -743,7 +755,7 @@ namespace
     // ------------------------------------------------------------
     // parse_image (v3)
     // ------------------------------------------------------------
-    static bool parse_image(std::ifstream& in, ImageBlock& ib, SceneIOReport& report)
+    static bool parse_image(std::istream& in, ImageBlock& ib, SceneIOReport& report)
     {
         std::string line;
         if (!next_line(in, line) || trim(line) != "{")
@@ -804,7 +816,7 @@ namespace
     // ------------------------------------------------------------
     // parse_material (v3)
     // ------------------------------------------------------------
-    static bool parse_material(std::ifstream& in, MaterialBlock& mb, SceneIOReport& report)
+    static bool parse_material(std::istream& in, MaterialBlock& mb, SceneIOReport& report)
     {
         std::string line;
         if (!next_line(in, line) || trim(line) != "{")
@@ -929,7 +941,7 @@ namespace
     // ------------------------------------------------------------
     // parse_light (v3)
     // ------------------------------------------------------------
-    static bool parse_light(std::ifstream& in, LightBlock& lb, SceneIOReport& report)
+    static bool parse_light(std::istream& in, LightBlock& lb, SceneIOReport& report)
     {
         std::string line;
         if (!next_line(in, line) || trim(line) != "{")
@@ -1044,6 +1056,120 @@ namespace
         return true;
     }
 
+    // ------------------------------------------------------------
+    // Block pre-scan (parallel load)
+    //
+    // Top-level blocks and the entries of images/materials/lights are
+    // independent, so the loader first indexes them by brace depth and then
+    // runs the parse_* functions on each one from its own span of the file.
+    // ------------------------------------------------------------
+    enum class TextBlockKind
+    {
+        Image,
+        Material,
+        Light,
+        Mesh
+    };
+
+    struct TextBlock
+    {
+        TextBlockKind    kind = TextBlockKind::Mesh;
+        std::string_view text = {}; ///< From the line after the keyword through the closing '}'.
+    };
+
+    /// Parsed result of one TextBlock; filled on a worker thread.
+    struct ParsedBlock
+    {
+        bool                 ok       = false;
+        SceneIOReport        report   = {};
+        ImageBlock           image    = {};
+        std::vector<uint8_t> decoded  = {}; ///< Embedded image bytes (base64 already decoded).
+        MaterialBlock        material = {};
+        LightBlock           light    = {};
+        MeshBlock            mesh     = {};
+    };
+
+    static bool next_line_view(std::string_view text, size_t& pos, std::string_view& outLine)
+    {
+        while (pos < text.size())
+        {
+            size_t end = text.find('\n', pos);
+            if (end == std::string_view::npos)
+                end = text.size();
+
+            std::string_view line = text.substr(pos, end - pos);
+            pos                   = end < text.size() ? end + 1 : end;
+
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (!is_comment_or_empty(line))
+            {
+                outLine = line;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static int32_t brace_delta(std::string_view line) noexcept
+    {
+        int32_t d       = 0;
+        bool    inQuote = false;
+        for (char c : line)
+        {
+            if (c == '"')
+                inQuote = !inQuote;
+            else if (!inQuote && c == '{')
+                ++d;
+            else if (!inQuote && c == '}')
+                --d;
+        }
+        return d;
+    }
+
+    /// Span of the block that starts at @p pos (its '{' line) through the matching '}'.
+    /// A missing '{' yields just that line, so the parser reports it.
+    static std::string_view skip_block(std::string_view text, size_t& pos)
+    {
+        const size_t     start = pos;
+        int32_t          depth = 0;
+        std::string_view line;
+
+        while (next_line_view(text, pos, line))
+        {
+            depth += brace_delta(line);
+            if (depth <= 0)
+                break;
+        }
+        return text.substr(start, pos - start);
+    }
+
+    static void parse_block(const TextBlock& block, ParsedBlock& out)
+    {
+        std::ispanstream in(std::span<const char>(block.text.data(), block.text.size()));
+
+        switch (block.kind)
+        {
+            case TextBlockKind::Image:
+                out.ok = parse_image(in, out.image, out.report);
+                if (out.ok && out.image.path.empty() && !out.image.base64Data.empty())
+                {
+                    out.decoded = base64Decode(out.image.base64Data);
+                    std::string().swap(out.image.base64Data);
+                }
+                break;
+            case TextBlockKind::Material:
+                out.ok = parse_material(in, out.material, out.report);
+                break;
+            case TextBlockKind::Light:
+                out.ok = parse_light(in, out.light, out.report);
+                break;
+            case TextBlockKind::Mesh:
+                out.ok = parse_mesh(in, out.mesh, out.report);
+                break;
+        }
+    }
+
     // Probe IDs 0..31 for existing maps
     static std::vector<int32_t> discover_map_ids(const SysMesh* sys)
     {
@@ -1059,7 +1185,7 @@ namespace
 } // namespace
 
 // ============================================================
-// SAVE
+// SAVE / LOAD dispatch (binary container vs text)
 // ============================================================
 bool ImpSceneFormat::save(const Scene*                 scene,
                           const std::filesystem::path& filePath,
@@ -1073,6 +1199,53 @@ bool ImpSceneFormat::save(const Scene*                 scene,
         return false;
     }
 
+    if (options.textNative)
+        return saveText(scene, filePath, options, report);
+
+    return imp_binary::save(scene, filePath, options, report);
+}
+
+bool ImpSceneFormat::load(Scene*                       scene,
+                          const std::filesystem::path& filePath,
+                          const LoadOptions&           options,
+                          SceneIOReport&               report)
+{
+    if (!scene)
+    {
+        report.status = SceneIOStatus::InvalidScene;
+        report.error("scene is null");
+        return false;
+    }
+
+    // Binary files are read in place from the mapping; text is scanned from
+    // it too. Empty files (no mapping) take the regular read path.
+    const MappedFile file(filePath);
+    if (file.valid() && imp_binary::isBinary(file.bytes()))
+        return imp_binary::load(scene, file, filePath, options, report);
+
+    if (file.valid())
+        return loadText(scene, std::string_view(reinterpret_cast<const char*>(file.data()), file.size()), filePath, options, report);
+
+    std::ifstream in(filePath, std::ios::in | std::ios::binary);
+    if (!in.is_open())
+    {
+        report.status = SceneIOStatus::FileNotFound;
+        report.error("file not found");
+        return false;
+    }
+
+    const std::string text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    return loadText(scene, text, filePath, options, report);
+}
+
+// ============================================================
+// SAVE (text)
+// ============================================================
+bool ImpSceneFormat::saveText(const Scene*                 scene,
+                              const std::filesystem::path& filePath,
+                              const SaveOptions&           options,
+                              SceneIOReport&               report)
+{
     std::ofstream out(filePath, std::ios::out | std::ios::trunc);
     if (!out.is_open())
     {
@@ -1571,35 +1744,17 @@ bool ImpSceneFormat::save(const Scene*                 scene,
 }
 
 // ============================================================
-// LOAD
+// LOAD (text)
 // ============================================================
-bool ImpSceneFormat::load(Scene*                       scene,
-                          const std::filesystem::path& filePath,
-                          const LoadOptions&           options,
-                          SceneIOReport&               report)
+bool ImpSceneFormat::loadText(Scene*                       scene,
+                              std::string_view             text,
+                              const std::filesystem::path& filePath,
+                              const LoadOptions&           options,
+                              SceneIOReport&               report)
 {
-    if (!scene)
-    {
-        report.status = SceneIOStatus::InvalidScene;
-        report.error("scene is null");
-        return false;
-    }
-
-    std::ifstream in(filePath, std::ios::in);
-    if (!in.is_open())
-    {
-        report.status = SceneIOStatus::FileNotFound;
-        report.error("file not found");
-        return false;
-    }
-
-    if (!options.mergeIntoExisting)
-        scene->clear();
-
-    const std::filesystem::path baseDir = filePath.parent_path();
-
-    std::string line;
-    if (!next_line(in, line))
+    size_t           pos = 0;
+    std::string_view line;
+    if (!next_line_view(text, pos, line))
     {
         report.error("empty file");
         return false;
@@ -1607,7 +1762,7 @@ bool ImpSceneFormat::load(Scene*                       scene,
 
     int32_t fileVer = 0;
     {
-        const auto tok = tokenize(trim(line));
+        const auto tok = tokenize(std::string(trim_view(line)));
         if (tok.size() != 2 || tok[0] != "imp_scene")
         {
             report.status = SceneIOStatus::UnsupportedFormat;
@@ -1622,125 +1777,158 @@ bool ImpSceneFormat::load(Scene*                       scene,
         }
     }
 
-    // imageKey -> ImageId (built during images block, used during materials block)
-    std::unordered_map<std::string, ImageId> imageKeyToId;
+    // --------------------------------------------------------
+    // Pre-scan: index every block in file order
+    // --------------------------------------------------------
+    std::vector<TextBlock> blocks;
 
-    while (next_line(in, line))
+    while (next_line_view(text, pos, line))
     {
-        const std::string s = trim(line);
+        const std::string_view s = trim_view(line);
+
+        if (s == "mesh")
+        {
+            blocks.push_back({TextBlockKind::Mesh, skip_block(text, pos)});
+            continue;
+        }
+
+        // images / materials / lights (v3): a list of entry blocks
+        struct ListBlock
+        {
+            std::string_view name;
+            std::string_view entry;
+            TextBlockKind    kind;
+        };
+        static constexpr ListBlock kLists[] = {
+            {"images", "image", TextBlockKind::Image},
+            {"materials", "material", TextBlockKind::Material},
+            {"lights", "light", TextBlockKind::Light},
+        };
+
+        const ListBlock* list = nullptr;
+        for (const ListBlock& l : kLists)
+            if (s == l.name && fileVer >= 3)
+                list = &l;
+
+        if (!list)
+        {
+            report.warning("Unknown top-level key: '" + std::string(s) + "'");
+            continue;
+        }
 
-        // --------------------------------------------------------
-        // images block (v3)
-        // --------------------------------------------------------
-        if (s == "images" && fileVer >= 3)
+        if (!next_line_view(text, pos, line) || trim_view(line) != "{")
         {
-            if (!next_line(in, line) || trim(line) != "{")
+            report.error("expected '{' after " + std::string(list->name));
+            return false;
+        }
+
+        while (next_line_view(text, pos, line))
+        {
+            const std::string_view ms = trim_view(line);
+            if (ms == "}")
+                break;
+            if (ms != list->entry)
             {
-                report.error("expected '{' after images");
-                return false;
+                report.warning("Unknown " + std::string(list->name) + " entry: '" + std::string(ms) + "'");
+                continue;
             }
+            blocks.push_back({list->kind, skip_block(text, pos)});
+        }
+    }
 
-            ImageHandler* ih = scene->imageHandler();
+    // --------------------------------------------------------
+    // Parse every block on the workers (no scene access)
+    // --------------------------------------------------------
+    std::vector<ParsedBlock> parsed(blocks.size());
+    TaskPool::shared().parallelFor(uint32_t(blocks.size()), [&](uint32_t i) { parse_block(blocks[i], parsed[i]); });
 
-            while (next_line(in, line))
-            {
-                const std::string ms = trim(line);
-                if (ms == "}")
-                    break;
-                if (ms != "image")
-                {
-                    report.warning(std::string("Unknown images entry: '") + ms + "'");
-                    continue;
-                }
+    // --------------------------------------------------------
+    // Serial pass: create scene objects in file order
+    // --------------------------------------------------------
+    if (!options.mergeIntoExisting)
+        scene->clear();
 
-                ImageBlock ib{};
-                if (!parse_image(in, ib, report))
-                    return false;
+    const std::filesystem::path baseDir = filePath.parent_path();
+
+    // imageKey -> ImageId (built during images block, used during materials block)
+    std::unordered_map<std::string, ImageId> imageKeyToId;
+
+    ImageHandler*    ih = scene->imageHandler();
+    MaterialHandler* mh = scene->materialHandler();
+
+    for (size_t bi = 0; bi < blocks.size(); ++bi)
+    {
+        ParsedBlock& pb = parsed[bi];
+
+        appendSceneIOReport(report, pb.report);
+        if (!pb.ok)
+            return false;
 
+        switch (blocks[bi].kind)
+        {
+            // --------------------------------------------------------
+            // image entry (v3)
+            // --------------------------------------------------------
+            case TextBlockKind::Image:
+            {
                 if (!ih)
-                    continue;
+                    break;
 
-                ImageId id = kInvalidImageId;
+                const ImageBlock& ib = pb.image;
+                ImageId           id = kInvalidImageId;
 
                 if (!ib.path.empty())
                 {
                     // External path — resolve relative to scene file
                     const std::filesystem::path full = baseDir / ib.path;
-                    id                               = ih->loadFromFile(full, /*flipY=*/true);
+                    id                               = ih->loadFromFileAsync(full, /*flipY=*/true);
                     if (id == kInvalidImageId)
                         report.warning("Could not load image: " + full.string());
                 }
-                else if (!ib.base64Data.empty())
+                else if (!pb.decoded.empty())
                 {
-                    const std::vector<uint8_t> decoded = base64Decode(ib.base64Data);
-                    if (!decoded.empty())
+                    if (ib.width > 0 && ib.height > 0 && ib.channels > 0)
                     {
-                        if (ib.width > 0 && ib.height > 0 && ib.channels > 0)
-                        {
-                            // Raw pixels — reconstruct directly. Already flipped on original load
-                            // so do NOT flip again here.
-                            id = ih->createFromRaw(
-                                decoded.data(),
-                                ib.width,
-                                ib.height,
-                                ib.channels,
-                                ib.key,
-                                /*flipY=*/false);
-                            if (id == kInvalidImageId)
-                                report.warning("Could not reconstruct raw image: " + ib.key);
-                        }
-                        else
-                        {
-                            // Encoded format (KTX etc) — decode via stb/libktx.
-                            id = ih->loadFromEncodedMemory(
-                                std::span<const unsigned char>(decoded.data(), decoded.size()),
-                                ib.key,
-                                /*flipY=*/true);
-                            if (id == kInvalidImageId)
-                                report.warning("Could not decode embedded image: " + ib.key);
-                        }
+                        // Raw pixels — reconstruct directly. Already flipped on original load
+                        // so do NOT flip again here.
+                        id = ih->createFromRaw(
+                            pb.decoded.data(),
+                            ib.width,
+                            ib.height,
+                            ib.channels,
+                            ib.key,
+                            /*flipY=*/false);
+                        if (id == kInvalidImageId)
+                            report.warning("Could not reconstruct raw image: " + ib.key);
+                    }
+                    else
+                    {
+                        // Encoded format (KTX etc) — decode via stb/libktx.
+                        id = ih->loadFromEncodedMemoryAsync(
+                            std::span<const unsigned char>(pb.decoded.data(), pb.decoded.size()),
+                            ib.key,
+                            /*flipY=*/true);
+                        if (id == kInvalidImageId)
+                            report.warning("Could not decode embedded image: " + ib.key);
                     }
                 }
 
                 if (id != kInvalidImageId)
                     imageKeyToId[ib.key] = id;
+                break;
             }
-            continue;
-        }
-
-        // --------------------------------------------------------
-        // materials block (v3)
-        // --------------------------------------------------------
-        if (s == "materials" && fileVer >= 3)
-        {
-            if (!next_line(in, line) || trim(line) != "{")
-            {
-                report.error("expected '{' after materials");
-                return false;
-            }
-
-            MaterialHandler* mh = scene->materialHandler();
 
-            while (next_line(in, line))
+            // --------------------------------------------------------
+            // material entry (v3)
+            // --------------------------------------------------------
+            case TextBlockKind::Material:
             {
-                const std::string ms = trim(line);
-                if (ms == "}")
-                    break;
-                if (ms != "material")
-                {
-                    report.warning(std::string("Unknown materials entry: '") + ms + "'");
-                    continue;
-                }
-
-                MaterialBlock mb{};
-                if (!parse_material(in, mb, report))
-                    return false;
-
                 if (!mh)
-                    continue;
+                    break;
 
-                const int32_t matId = mh->createMaterial(mb.name);
-                Material&     dst   = mh->material(matId);
+                const MaterialBlock& mb    = pb.material;
+                const int32_t        matId = mh->createMaterial(mb.name);
+                Material&            dst   = mh->material(matId);
 
                 dst.alphaMode(static_cast<Material::AlphaMode>(mb.alphaMode));
                 dst.doubleSided(mb.doubleSided);
@@ -1766,35 +1954,15 @@ bool ImpSceneFormat::load(Scene*                       scene,
                 dst.roughnessTexture(resolveTex(mb.roughnessTex));
                 dst.aoTexture(resolveTex(mb.aoTex));
                 dst.emissiveTexture(resolveTex(mb.emissiveTex));
-            }
-            continue;
-        }
-
-        // --------------------------------------------------------
-        // lights block (v3)
-        // --------------------------------------------------------
-        if (s == "lights" && fileVer >= 3)
-        {
-            if (!next_line(in, line) || trim(line) != "{")
-            {
-                report.error("expected '{' after lights");
-                return false;
+                break;
             }
 
-            while (next_line(in, line))
+            // --------------------------------------------------------
+            // light entry (v3)
+            // --------------------------------------------------------
+            case TextBlockKind::Light:
             {
-                const std::string ms = trim(line);
-                if (ms == "}")
-                    break;
-                if (ms != "light")
-                {
-                    report.warning(std::string("Unknown lights entry: '") + ms + "'");
-                    continue;
-                }
-
-                LightBlock lb{};
-                if (!parse_light(in, lb, report))
-                    return false;
+                const LightBlock& lb = pb.light;
 
                 Light l{};
                 l.name             = lb.name;
@@ -1816,121 +1984,120 @@ bool ImpSceneFormat::load(Scene*                       scene,
                     sl->model(row_major16_to_mat4(lb.modelRM));
                 else
                     report.warning("Failed to create light: " + lb.name);
+                break;
             }
-            continue;
-        }
 
-        // --------------------------------------------------------
-        // mesh block (v1/v2/v3 — unchanged)
-        // --------------------------------------------------------
-        if (s == "mesh")
-        {
-            MeshBlock mb{};
-            if (!parse_mesh(in, mb, report))
-                return false;
-
-            SceneMesh* sm = scene->createSceneMesh(mb.name);
-            if (!sm)
+            // --------------------------------------------------------
+            // mesh block (v1/v2/v3 — unchanged)
+            // --------------------------------------------------------
+            case TextBlockKind::Mesh:
             {
-                report.error("could not create SceneMesh");
-                return false;
-            }
+                MeshBlock& mb = pb.mesh;
 
-            sm->visible(mb.visible);
-            sm->selected(mb.selected);
-            sm->model(row_major16_to_mat4(mb.modelRM));
-            sm->subdivisionLevel(mb.subdivLevel - sm->subdivisionLevel());
+                SceneMesh* sm = scene->createSceneMesh(mb.name);
+                if (!sm)
+                {
+                    report.error("could not create SceneMesh");
+                    return false;
+                }
 
-            SysMesh* sys = sm->sysMesh();
-            if (!sys)
-            {
-                report.error("null SysMesh");
-                return false;
-            }
+                sm->visible(mb.visible);
+                sm->selected(mb.selected);
+                sm->model(row_major16_to_mat4(mb.modelRM));
+                sm->subdivisionLevel(mb.subdivLevel - sm->subdivisionLevel());
+
+                SysMesh* sys = sm->sysMesh();
+                if (!sys)
+                {
+                    report.error("null SysMesh");
+                    return false;
+                }
 
-            sys->clear();
+                sys->clear();
 
-            // Reserve from declared vert count for fast bulk creation
-            if (!mb.verts.empty())
-                sys->reserve(static_cast<int32_t>(mb.verts.size()));
+                // Reserve from declared vert count for fast bulk creation
+                if (!mb.verts.empty())
+                    sys->reserve(static_cast<int32_t>(mb.verts.size()));
 
-            std::vector<int32_t> newVertIds;
-            newVertIds.reserve(mb.verts.size());
-            for (const glm::vec3& p : mb.verts)
-                newVertIds.push_back(sys->create_vert(p));
+                std::vector<int32_t> newVertIds;
+                newVertIds.reserve(mb.verts.size());
+                for (const glm::vec3& p : mb.verts)
+                    newVertIds.push_back(sys->create_vert(p));
 
-            std::vector<int32_t> createdPolyIds;
-            createdPolyIds.reserve(mb.polys.size());
-            for (const auto& p : mb.polys)
-            {
-                SysPolyVerts pv;
-                for (int32_t di : p.idx)
+                std::vector<int32_t> createdPolyIds;
+                createdPolyIds.reserve(mb.polys.size());
+                for (const auto& p : mb.polys)
                 {
-                    if (di < 0 || di >= static_cast<int32_t>(newVertIds.size()))
+                    SysPolyVerts pv;
+                    for (int32_t di : p.idx)
                     {
-                        report.error("polygon index out of range");
-                        return false;
+                        if (di < 0 || di >= static_cast<int32_t>(newVertIds.size()))
+                        {
+                            report.error("polygon index out of range");
+                            return false;
+                        }
+                        pv.push_back(newVertIds[static_cast<size_t>(di)]);
                     }
-                    pv.push_back(newVertIds[static_cast<size_t>(di)]);
+                    if (pv.size() >= 3)
+                        createdPolyIds.push_back(sys->create_poly(pv, p.mat));
                 }
-                if (pv.size() >= 3)
-                    createdPolyIds.push_back(sys->create_poly(pv, p.mat));
-            }
 
-            for (const MapBindingBlock& m : mb.maps)
-            {
-                if (m.id < 0 || m.dim <= 0)
-                    continue;
-                const int32_t existing = sys->map_find(m.id);
-                if (existing != -1)
-                    sys->map_remove(m.id);
-                const int32_t map = sys->map_create(m.id, 0, m.dim);
-                if (map < 0)
+                for (const MapBindingBlock& m : mb.maps)
                 {
-                    report.warning("Failed to create map id " + std::to_string(m.id));
-                    continue;
-                }
-
-                std::vector<int32_t> denseToMapVert;
-                denseToMapVert.reserve(m.mapVerts.size());
-                for (size_t i = 0; i < m.mapVerts.size(); ++i)
-                {
-                    const auto& vec = m.mapVerts[i];
-                    if (static_cast<int32_t>(vec.size()) != m.dim)
+                    if (m.id < 0 || m.dim <= 0)
+                        continue;
+                    const int32_t existing = sys->map_find(m.id);
+                    if (existing != -1)
+                        sys->map_remove(m.id);
+                    const int32_t map = sys->map_create(m.id, 0, m.dim);
+                    if (map < 0)
                     {
-                        std::vector<float> z(static_cast<size_t>(m.dim), 0.f);
-                        denseToMapVert.push_back(sys->map_create_vert(map, z.data()));
+                        report.warning("Failed to create map id " + std::to_string(m.id));
                         continue;
                     }
-                    denseToMapVert.push_back(sys->map_create_vert(map, vec.data()));
-                }
 
-                for (const auto& b : m.polyBinds)
-                {
-                    if (b.polyDenseIndex < 0 || b.polyDenseIndex >= static_cast<int32_t>(createdPolyIds.size()))
-                        continue;
-                    const int32_t polyId = createdPolyIds[static_cast<size_t>(b.polyDenseIndex)];
-                    if (!sys->poly_valid(polyId))
-                        continue;
-                    const SysPolyVerts& pv = sys->poly_verts(polyId);
-                    if (static_cast<int32_t>(b.denseMapVertIndices.size()) != static_cast<int32_t>(pv.size()))
-                        continue;
-                    SysPolyVerts mpv;
-                    mpv.reserve(pv.size());
-                    for (int32_t dmv : b.denseMapVertIndices)
+                    std::vector<int32_t> denseToMapVert;
+                    denseToMapVert.reserve(m.mapVerts.size());
+                    for (size_t i = 0; i < m.mapVerts.size(); ++i)
                     {
-                        if (dmv < 0 || dmv >= static_cast<int32_t>(denseToMapVert.size()))
-                            mpv.push_back(denseToMapVert.empty() ? -1 : denseToMapVert[0]);
-                        else
-                            mpv.push_back(denseToMapVert[static_cast<size_t>(dmv)]);
+                        const auto& vec = m.mapVerts[i];
+                        if (static_cast<int32_t>(vec.size()) != m.dim)
+                        {
+                            std::vector<float> z(static_cast<size_t>(m.dim), 0.f);
+                            denseToMapVert.push_back(sys->map_create_vert(map, z.data()));
+                            continue;
+                        }
+                        denseToMapVert.push_back(sys->map_create_vert(map, vec.data()));
+                    }
+
+                    for (const auto& b : m.polyBinds)
+                    {
+                        if (b.polyDenseIndex < 0 || b.polyDenseIndex >= static_cast<int32_t>(createdPolyIds.size()))
+                            continue;
+                        const int32_t polyId = createdPolyIds[static_cast<size_t>(b.polyDenseIndex)];
+                        if (!sys->poly_valid(polyId))
+                            continue;
+                        const SysPolyVerts& pv = sys->poly_verts(polyId);
+                        if (static_cast<int32_t>(b.denseMapVertIndices.size()) != static_cast<int32_t>(pv.size()))
+                            continue;
+                        SysPolyVerts mpv;
+                        mpv.reserve(pv.size());
+                        for (int32_t dmv : b.denseMapVertIndices)
+                        {
+                            if (dmv < 0 || dmv >= static_cast<int32_t>(denseToMapVert.size()))
+                                mpv.push_back(denseToMapVert.empty() ? -1 : denseToMapVert[0]);
+                            else
+                                mpv.push_back(denseToMapVert[static_cast<size_t>(dmv)]);
+                        }
+                        sys->map_create_poly(map, polyId, mpv);
                     }
-                    sys->map_create_poly(map, polyId, mpv);
                 }
+
+                // Release the parsed arrays before the next block grows the scene.
+                mb = {};
+                break;
             }
-            continue;
         }
-
-        report.warning(std::string("Unknown top-level key: '") + s + "'");
     }
 
     if (report.hasErrors())
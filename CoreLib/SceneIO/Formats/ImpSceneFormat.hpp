@@ -13,8 +13,11 @@ class Scene;
  * v1: meshes + transforms + raw geometry
  * v2: + face-varying maps (normals / UVs)
  * v3: + materials (PBR) + images (external path or embedded base64) + lights
+ * v4: binary chunked container (see ImpBinaryFormat.hpp), loaded from a
+ *     memory mapping. Written by default; the text form (v3) is kept for
+ *     SaveOptions::textNative (export).
  *
- * Extensible by adding new top-level blocks.
+ * Extensible by adding new top-level blocks / chunk types.
  */
 class ImpSceneFormat final : public SceneFormat
 {
@@ -31,4 +34,17 @@ public:
               const std::filesystem::path& filePath,
               const SaveOptions&           options,
               SceneIOReport&               report) override;
+
+private:
+    /// @param text Whole file contents (usually a memory mapping).
+    bool loadText(Scene*                       scene,
+                  std::string_view             text,
+                  const std::filesystem::path& filePath,
+                  const LoadOptions&           options,
+                  SceneIOReport&               report);
+
+    bool saveText(const Scene*                 scene,
+                  const std::filesystem::path& filePath,
+                  const SaveOptions&           options,
+                  SceneIOReport&               report);
 };
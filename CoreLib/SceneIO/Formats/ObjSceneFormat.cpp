@@ -872,6 +872,7 @@
 #include <SysObjLoader.hpp>
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
@@ -882,21 +883,23 @@
 #include <map>
 #include <sstream>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <string_view>
 #include <vector>
 
 #include "CoreUtilities.hpp"
 #include "Scene.hpp"
 #include "SceneMesh.hpp"
 #include "SceneMtlUtils.hpp"
+#include "TaskPool.hpp"
 
 // ------------------------------------------------------------
-// OBJ has no header counts. These are only fallback reserves.
-// The loader below reads the whole file into memory and parses
-// with char pointers instead of iostreams/istringstream/stoi.
+// The loader reads the whole file into memory, splits it at line
+// boundaries and parses the pieces in parallel with char pointers
+// and std::from_chars (no iostreams/istringstream/stoi/strtof).
 // ------------------------------------------------------------
-static constexpr int32_t kObjReserveVerts = 2048;
+
+/// Target bytes per parse chunk; small files stay a single chunk.
+static constexpr size_t kObjChunkBytes = size_t(4) << 20;
 
 namespace
 {
@@ -950,40 +953,42 @@ namespace
         return std::string(b, r);
     }
 
-    inline bool parse_float3(const char*& p, const char* e, glm::vec3& v)
+    // from_chars rejects a leading '+', which some exporters write.
+    inline const char* skip_plus(const char* p, const char* e)
     {
-        p         = skip_spaces(p, e);
-        char* out = nullptr;
-        v.x       = std::strtof(p, &out);
-        if (out == p)
-            return false;
-        p   = skip_spaces(out, e);
-        v.y = std::strtof(p, &out);
-        if (out == p)
-            return false;
-        p   = skip_spaces(out, e);
-        v.z = std::strtof(p, &out);
-        if (out == p)
+        return (p < e && *p == '+') ? p + 1 : p;
+    }
+
+    inline bool parse_float(const char*& p, const char* e, float& out)
+    {
+        p                 = skip_plus(skip_spaces(p, e), e);
+        const auto result = std::from_chars(p, e, out);
+        if (result.ec != std::errc{})
             return false;
-        p = out;
+        p = result.ptr;
         return true;
     }
 
-    inline bool parse_float2(const char*& p, const char* e, glm::vec2& v)
+    inline bool parse_int(const char*& p, const char* e, int& out)
     {
-        p         = skip_spaces(p, e);
-        char* out = nullptr;
-        v.x       = std::strtof(p, &out);
-        if (out == p)
-            return false;
-        p   = skip_spaces(out, e);
-        v.y = std::strtof(p, &out);
-        if (out == p)
+        p                 = skip_plus(p, e);
+        const auto result = std::from_chars(p, e, out);
+        if (result.ec != std::errc{})
             return false;
-        p = out;
+        p = result.ptr;
         return true;
     }
 
+    inline bool parse_float3(const char*& p, const char* e, glm::vec3& v)
+    {
+        return parse_float(p, e, v.x) && parse_float(p, e, v.y) && parse_float(p, e, v.z);
+    }
+
+    inline bool parse_float2(const char*& p, const char* e, glm::vec2& v)
+    {
+        return parse_float(p, e, v.x) && parse_float(p, e, v.y);
+    }
+
     inline int resolve_obj_index(int idx, int size)
     {
         if (idx > 0)
@@ -1014,13 +1019,11 @@ namespace
     {
         ObjIdx idx{};
 
-        char*      out  = nullptr;
-        const long vRaw = std::strtol(p, &out, 10);
-        if (out == p)
+        int vRaw = 0;
+        if (!parse_int(p, e, vRaw))
             return idx;
 
-        idx.v = resolve_obj_index(static_cast<int>(vRaw), posCount);
-        p     = out;
+        idx.v = resolve_obj_index(vRaw, posCount);
 
         if (p >= e || *p != '/')
             return idx;
@@ -1031,32 +1034,23 @@ namespace
         if (p < e && *p == '/')
         {
             ++p; // second slash
-            const long nRaw = std::strtol(p, &out, 10);
-            if (out != p)
-            {
-                idx.n = resolve_obj_index(static_cast<int>(nRaw), normCount);
-                p     = out;
-            }
+            int nRaw = 0;
+            if (parse_int(p, e, nRaw))
+                idx.n = resolve_obj_index(nRaw, normCount);
             return idx;
         }
 
         // v/t or v/t/n
-        const long tRaw = std::strtol(p, &out, 10);
-        if (out != p)
-        {
-            idx.t = resolve_obj_index(static_cast<int>(tRaw), texCount);
-            p     = out;
-        }
+        int tRaw = 0;
+        if (parse_int(p, e, tRaw))
+            idx.t = resolve_obj_index(tRaw, texCount);
 
         if (p < e && *p == '/')
         {
             ++p;
-            const long nRaw = std::strtol(p, &out, 10);
-            if (out != p)
-            {
-                idx.n = resolve_obj_index(static_cast<int>(nRaw), normCount);
-                p     = out;
-            }
+            int nRaw = 0;
+            if (parse_int(p, e, nRaw))
+                idx.n = resolve_obj_index(nRaw, normCount);
         }
 
         return idx;
@@ -1079,12 +1073,48 @@ namespace
                (p + len == e || is_space(p[len]));
     }
 
-    inline ObjPrepassCounts prepass_obj_counts(const std::string& buffer)
+    enum class ObjLine
     {
-        ObjPrepassCounts c{};
+        Other,
+        Position,
+        Normal,
+        TexCoord,
+        Face,
+        Object,
+        MtlLib,
+        UseMtl,
+    };
+
+    // Both passes classify lines through here, so the counts from the
+    // prepass are exactly the slots the parse pass fills.
+    inline ObjLine obj_line_kind(const char* p, const char* e)
+    {
+        if (*p == 'v')
+        {
+            if (p + 1 < e && (p[1] == ' ' || p[1] == '\t'))
+                return ObjLine::Position;
+            if (p + 2 < e && p[1] == 'n' && (p[2] == ' ' || p[2] == '\t'))
+                return ObjLine::Normal;
+            if (p + 2 < e && p[1] == 't' && (p[2] == ' ' || p[2] == '\t'))
+                return ObjLine::TexCoord;
+            return ObjLine::Other;
+        }
+
+        if (*p == 'f' && p + 1 < e && (p[1] == ' ' || p[1] == '\t'))
+            return ObjLine::Face;
+        if (*p == 'o' && p + 1 < e && (p[1] == ' ' || p[1] == '\t'))
+            return ObjLine::Object;
+        if (starts_with_keyword(p, e, "mtllib", 6))
+            return ObjLine::MtlLib;
+        if (starts_with_keyword(p, e, "usemtl", 6))
+            return ObjLine::UseMtl;
 
-        const char* p = buffer.data();
-        const char* e = buffer.data() + buffer.size();
+        return ObjLine::Other;
+    }
+
+    inline ObjPrepassCounts prepass_obj_counts(const char* p, const char* e)
+    {
+        ObjPrepassCounts c{};
 
         while (p < e)
         {
@@ -1098,33 +1128,38 @@ namespace
                 continue;
             }
 
-            if (*p == 'v')
+            switch (obj_line_kind(p, e))
             {
-                if (p + 1 < e && (p[1] == ' ' || p[1] == '\t'))
+                case ObjLine::Position:
                     ++c.positions;
-                else if (p + 2 < e && p[1] == 'n' && (p[2] == ' ' || p[2] == '\t'))
+                    break;
+                case ObjLine::Normal:
                     ++c.normals;
-                else if (p + 2 < e && p[1] == 't' && (p[2] == ' ' || p[2] == '\t'))
+                    break;
+                case ObjLine::TexCoord:
                     ++c.texcoords;
-            }
-            else if (*p == 'f' && p + 1 < e && (p[1] == ' ' || p[1] == '\t'))
-            {
-                ++c.faces;
-                const char* q = p + 2;
-                while (q < e && *q != '\n' && *q != '\r')
+                    break;
+                case ObjLine::Object:
+                    ++c.objects;
+                    break;
+                case ObjLine::Face:
                 {
-                    q = skip_spaces(q, e);
-                    if (q >= e || *q == '\n' || *q == '\r')
-                        break;
+                    ++c.faces;
+                    const char* q = p + 2;
+                    while (q < e && *q != '\n' && *q != '\r')
+                    {
+                        q = skip_spaces(q, e);
+                        if (q >= e || *q == '\n' || *q == '\r')
+                            break;
 
-                    ++c.faceCorners;
-                    while (q < e && !is_space(*q))
-                        ++q;
+                        ++c.faceCorners;
+                        while (q < e && !is_space(*q))
+                            ++q;
+                    }
+                    break;
                 }
-            }
-            else if (*p == 'o' && p + 1 < e && (p[1] == ' ' || p[1] == '\t'))
-            {
-                ++c.objects;
+                default:
+                    break;
             }
 
             p = next_line(p, e);
@@ -1133,25 +1168,239 @@ namespace
         return c;
     }
 
-    inline int32_t reserve_for_new_mesh(const ObjPrepassCounts& counts)
+    // ------------------------------------------------------------
+    // Parallel parse
+    //
+    // Pass 1 counts v/vn/vt per chunk; a prefix sum gives every chunk
+    // its base into the shared attribute arrays. Pass 2 then parses each
+    // chunk on its own, writing attributes in place and resolving face
+    // indices (including negative ones) to absolute OBJ indices. State
+    // lines (o / usemtl / mtllib) are recorded as events at their face
+    // position and replayed in file order when the meshes are built.
+    // ------------------------------------------------------------
+    struct ObjEvent
+    {
+        ObjLine     kind = ObjLine::Other;
+        uint32_t    face = 0; ///< Index of the first chunk face after the event.
+        std::string name = {};
+    };
+
+    struct ObjChunk
+    {
+        const char* begin = nullptr;
+        const char* end   = nullptr;
+
+        ObjPrepassCounts counts   = {};
+        size_t           posBase  = 0;
+        size_t           normBase = 0;
+        size_t           texBase  = 0;
+
+        std::vector<int32_t>  faceSizes = {}; ///< Corner count per 'f' line; -1 = invalid vertex index.
+        std::vector<ObjIdx>   corners   = {};
+        std::vector<ObjEvent> events    = {};
+        uint32_t              badLines  = 0; ///< v/vn/vt lines that did not parse (kept as zero).
+    };
+
+    inline std::vector<ObjChunk> split_obj_chunks(const std::string& buffer)
+    {
+        const char*  b     = buffer.data();
+        const char*  e     = buffer.data() + buffer.size();
+        const size_t count = std::clamp<size_t>(buffer.size() / kObjChunkBytes, 1, size_t(TaskPool::shared().threadCount() + 1) * 8);
+
+        std::vector<ObjChunk> chunks;
+        chunks.reserve(count);
+
+        const char* p = b;
+        for (size_t i = 1; i <= count && p < e; ++i)
+        {
+            const char* q = (i == count) ? e : std::max(p, b + buffer.size() / count * i);
+            q             = next_line(q, e);
+
+            ObjChunk c = {};
+            c.begin    = p;
+            c.end      = q;
+            chunks.push_back(std::move(c));
+            p = q;
+        }
+
+        return chunks;
+    }
+
+    inline void parse_obj_chunk(ObjChunk&               c,
+                                std::vector<glm::vec3>& positions,
+                                std::vector<glm::vec3>& normals,
+                                std::vector<glm::vec2>& texcoords)
     {
-        if (counts.objects <= 1 && counts.positions <= static_cast<size_t>(std::numeric_limits<int32_t>::max()))
-            return static_cast<int32_t>(std::max<size_t>(counts.positions, kObjReserveVerts));
+        c.faceSizes.reserve(c.counts.faces);
+        c.corners.reserve(c.counts.faceCorners);
 
-        if (counts.objects > 1)
+        size_t pos  = c.posBase;
+        size_t norm = c.normBase;
+        size_t tex  = c.texBase;
+
+        const char* p = c.begin;
+        const char* e = c.end;
+
+        while (p < e)
         {
-            const size_t avg = std::max<size_t>(kObjReserveVerts, counts.positions / counts.objects);
-            return static_cast<int32_t>(std::min<size_t>(avg, static_cast<size_t>(std::numeric_limits<int32_t>::max())));
+            p = skip_spaces(p, e);
+            if (p >= e)
+                break;
+
+            if (*p == '#')
+            {
+                p = next_line(p, e);
+                continue;
+            }
+
+            switch (obj_line_kind(p, e))
+            {
+                case ObjLine::Position:
+                    p += 2;
+                    if (!parse_float3(p, e, positions[pos]))
+                        ++c.badLines;
+                    ++pos;
+                    break;
+
+                case ObjLine::Normal:
+                    p += 3;
+                    if (!parse_float3(p, e, normals[norm]))
+                        ++c.badLines;
+                    ++norm;
+                    break;
+
+                case ObjLine::TexCoord:
+                    p += 3;
+                    if (!parse_float2(p, e, texcoords[tex]))
+                        ++c.badLines;
+                    ++tex;
+                    break;
+
+                case ObjLine::Face:
+                {
+                    p += 2;
+
+                    const size_t first   = c.corners.size();
+                    bool         invalid = false;
+
+                    while (p < e && *p != '\n' && *p != '\r')
+                    {
+                        p = skip_spaces(p, e);
+                        if (p >= e || *p == '\n' || *p == '\r')
+                            break;
+
+                        // Resolved against what has been declared so far,
+                        // like a sequential reader would.
+                        ObjIdx idx = parse_face_vertex(p, e, static_cast<int>(pos), static_cast<int>(tex), static_cast<int>(norm));
+
+                        if (idx.v < 0 || idx.v >= static_cast<int>(pos))
+                        {
+                            invalid = true;
+                            break;
+                        }
+
+                        if (idx.n >= static_cast<int>(norm))
+                            idx.n = -1;
+                        if (idx.t >= static_cast<int>(tex))
+                            idx.t = -1;
+
+                        c.corners.push_back(idx);
+                    }
+
+                    if (invalid)
+                        c.corners.resize(first);
+
+                    c.faceSizes.push_back(invalid ? -1 : static_cast<int32_t>(c.corners.size() - first));
+                    break;
+                }
+
+                case ObjLine::Object:
+                    p += 2;
+                    c.events.push_back({ObjLine::Object, static_cast<uint32_t>(c.faceSizes.size()), read_token_string(p, e)});
+                    break;
+
+                case ObjLine::MtlLib:
+                    p += 6;
+                    c.events.push_back({ObjLine::MtlLib, static_cast<uint32_t>(c.faceSizes.size()), read_rest_of_line_trimmed(p, e)});
+                    break;
+
+                case ObjLine::UseMtl:
+                    p += 6;
+                    c.events.push_back({ObjLine::UseMtl, static_cast<uint32_t>(c.faceSizes.size()), read_token_string(p, e)});
+                    break;
+
+                default:
+                    // Ignore unsupported OBJ commands: g, s, l, p, vp, etc.
+                    break;
+            }
+
+            p = next_line(p, e);
         }
+    }
+
+    /// A run of faces from one chunk that share an object and material.
+    struct ObjFaceSpan
+    {
+        uint32_t chunk    = 0;
+        uint32_t begin    = 0; ///< First face in the chunk.
+        uint32_t end      = 0;
+        size_t   corner   = 0; ///< First corner of face @c begin.
+        uint32_t material = 0;
+    };
+
+    // ------------------------------------------------------------
+    // Export formatting
+    //
+    // Records are formatted with std::to_chars (shortest round-trip for
+    // floats) into per-job strings on the TaskPool, then written in
+    // order with one write per piece.
+    // ------------------------------------------------------------
+    constexpr size_t kObjRecordsPerJob = size_t(1) << 16;
 
-        return kObjReserveVerts;
+    inline void append_float(std::string& out, float v)
+    {
+        char       buf[32];
+        const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+        out.append(buf, r.ptr);
+    }
+
+    inline void append_int(std::string& out, int64_t v)
+    {
+        char       buf[24];
+        const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+        out.append(buf, r.ptr);
+    }
+
+    inline void append_floats(std::string& out, std::string_view keyword, const float* v, int count)
+    {
+        out += keyword;
+        for (int i = 0; i < count; ++i)
+        {
+            out += ' ';
+            append_float(out, v[i]);
+        }
+        out += '\n';
     }
 
-    inline void ensure_vector_size(std::vector<int>& v, int index)
+    /// Format records [0, count) through fn(out, i) in parallel jobs; appends the pieces in order.
+    template<typename Fn>
+    void format_records(std::vector<std::string>& pieces, size_t count, size_t bytesPerRecord, const Fn& fn)
     {
-        if (index >= static_cast<int>(v.size()))
-            v.resize(static_cast<size_t>(index) + 1, -1);
+        const size_t jobs  = (count + kObjRecordsPerJob - 1) / kObjRecordsPerJob;
+        const size_t first = pieces.size();
+        pieces.resize(first + jobs);
+
+        TaskPool::shared().parallelFor(static_cast<uint32_t>(jobs), [&](uint32_t j) {
+            const size_t b = size_t(j) * kObjRecordsPerJob;
+            const size_t e = std::min(count, b + kObjRecordsPerJob);
+
+            std::string& out = pieces[first + j];
+            out.reserve((e - b) * bytesPerRecord);
+            for (size_t i = b; i < e; ++i)
+                fn(out, i);
+        });
     }
+
 } // namespace
 
 bool ObjSceneFormat::load(Scene*                       scene,
@@ -1227,28 +1476,62 @@ bool ObjSceneFormat::load(Scene*                       scene,
     }
 
     // ---------------------------------------------------------
-    // Prepass: exact reserves for attribute arrays and stable
-    // dense remap arrays. This is cheap compared with full import
-    // and removes several realloc / resize costs on huge OBJs.
+    // Pass 1 (parallel): count attributes per chunk, then a
+    // prefix sum gives each chunk its slot range in the shared
+    // arrays, so pass 2 can write them in place.
     // ---------------------------------------------------------
-    const ObjPrepassCounts counts = prepass_obj_counts(buffer);
+    std::vector<ObjChunk> chunks = split_obj_chunks(buffer);
+
+    TaskPool::shared().parallelFor(static_cast<uint32_t>(chunks.size()), [&](uint32_t i) {
+        chunks[i].counts = prepass_obj_counts(chunks[i].begin, chunks[i].end);
+    });
 
-    std::vector<glm::vec3> positions;
-    std::vector<glm::vec3> normals;
-    std::vector<glm::vec2> texcoords;
+    ObjPrepassCounts counts{};
+    for (ObjChunk& c : chunks)
+    {
+        c.posBase  = counts.positions;
+        c.normBase = counts.normals;
+        c.texBase  = counts.texcoords;
+
+        counts.positions += c.counts.positions;
+        counts.normals += c.counts.normals;
+        counts.texcoords += c.counts.texcoords;
+        counts.faces += c.counts.faces;
+    }
 
-    positions.reserve(counts.positions);
-    normals.reserve(counts.normals);
-    texcoords.reserve(counts.texcoords);
+    if (counts.positions > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+    {
+        report.status = SceneIOStatus::ReadError;
+        report.error("OBJ has more vertices than a mesh can index: " + filePath.string());
+        return false;
+    }
 
+    std::vector<glm::vec3> positions(counts.positions, glm::vec3{0.0f});
+    std::vector<glm::vec3> normals(counts.normals, glm::vec3{0.0f});
+    std::vector<glm::vec2> texcoords(counts.texcoords, glm::vec2{0.0f});
+
+    // ---------------------------------------------------------
+    // Pass 2 (parallel): parse attributes and faces.
+    // ---------------------------------------------------------
+    TaskPool::shared().parallelFor(static_cast<uint32_t>(chunks.size()), [&](uint32_t i) {
+        parse_obj_chunk(chunks[i], positions, normals, texcoords);
+    });
+
+    uint32_t badLines = 0;
+    for (const ObjChunk& c : chunks)
+        badLines += c.badLines;
+
+    if (badLines > 0)
+        report.warning(std::to_string(badLines) + " malformed v/vn/vt line(s) read as zero");
+
+    // ---------------------------------------------------------
+    // Build meshes (serial, file order). Events are replayed
+    // between face runs; each object's faces are collected as
+    // spans and turned into one SysMesh in a single batch.
+    // ---------------------------------------------------------
     std::string matlib;
 
     std::uint32_t matIndex = 0;
-    int           normMap  = -1;
-    int           texMap   = -1;
-
-    SceneMesh* sceneMesh   = nullptr;
-    SysMesh*   currentMesh = nullptr;
 
     // Dense OBJ position index -> SysMesh vertex index.
     // The stamp array lets us reuse the same dense arrays for each
@@ -1270,149 +1553,83 @@ bool ObjSceneFormat::load(Scene*                       scene,
         }
     };
 
-    const int32_t meshReserve = reserve_for_new_mesh(counts);
+    bool                     objectOpen = false;
+    std::string              objectName;
+    std::vector<ObjFaceSpan> objectSpans;
+    std::vector<int32_t>     objectVerts;
 
-    auto ensureDefaultMesh = [&]() {
-        if (currentMesh)
+    auto buildObject = [&]() {
+        if (!objectOpen)
             return;
 
-        sceneMesh   = scene->createSceneMesh("Default");
-        currentMesh = sceneMesh->sysMesh();
-        currentMesh->reserve(meshReserve);
-        normMap = currentMesh->map_create(/*MESH_MAP_NORMALS*/ 0, 0, 3);
-        texMap  = currentMesh->map_create(/*MESH_MAP_UV0*/ 1, 0, 2);
+        SceneMesh* sceneMesh   = scene->createSceneMesh(objectName);
+        SysMesh*   currentMesh = sceneMesh->sysMesh();
+        const int  normMap     = currentMesh->map_create(/*MESH_MAP_NORMALS*/ 0, 0, 3);
+        const int  texMap      = currentMesh->map_create(/*MESH_MAP_UV0*/ 1, 0, 2);
         nextMeshStamp();
-    };
-
-    auto startNewMesh = [&](const std::string& name) {
-        sceneMesh   = scene->createSceneMesh(name.empty() ? std::string("Object") : name);
-        currentMesh = sceneMesh->sysMesh();
-        currentMesh->reserve(meshReserve);
-        normMap = currentMesh->map_create(/*MESH_MAP_NORMALS*/ 0, 0, 3);
-        texMap  = currentMesh->map_create(/*MESH_MAP_UV0*/ 1, 0, 2);
-        nextMeshStamp();
-    };
-
-    const char* p = buffer.data();
-    const char* e = buffer.data() + buffer.size();
-
-    while (p < e)
-    {
-        p = skip_spaces(p, e);
-        if (p >= e)
-            break;
-
-        if (*p == '#')
-        {
-            p = next_line(p, e);
-            continue;
-        }
 
-        // -----------------------------------------------------
-        // Vertex attributes
-        // -----------------------------------------------------
-        if (*p == 'v')
+        // Vertices in first-use order, so the numbering matches a
+        // streaming import, created in one go with an exact reserve.
+        objectVerts.clear();
+        for (const ObjFaceSpan& span : objectSpans)
         {
-            if (p + 1 < e && (p[1] == ' ' || p[1] == '\t'))
-            {
-                p += 2;
-                glm::vec3 v{};
-                if (parse_float3(p, e, v))
-                    positions.push_back(v);
-                p = next_line(p, e);
-                continue;
-            }
-
-            if (p + 2 < e && p[1] == 'n' && (p[2] == ' ' || p[2] == '\t'))
-            {
-                p += 3;
-                glm::vec3 n{};
-                if (parse_float3(p, e, n))
-                    normals.push_back(n);
-                p = next_line(p, e);
-                continue;
-            }
-
-            if (p + 2 < e && p[1] == 't' && (p[2] == ' ' || p[2] == '\t'))
+            const ObjChunk& c      = chunks[span.chunk];
+            size_t          corner = span.corner;
+            for (uint32_t f = span.begin; f < span.end; ++f)
             {
-                p += 3;
-                glm::vec2 uv{};
-                if (parse_float2(p, e, uv))
-                    texcoords.push_back(uv);
-                p = next_line(p, e);
-                continue;
+                const int32_t n = std::max(c.faceSizes[f], 0);
+                for (int32_t k = 0; k < n; ++k, ++corner)
+                {
+                    const size_t v = static_cast<size_t>(c.corners[corner].v);
+                    if (globalToLocalStamp[v] != meshStamp)
+                    {
+                        globalToLocalStamp[v] = meshStamp;
+                        objectVerts.push_back(static_cast<int32_t>(v));
+                    }
+                }
             }
         }
 
-        // -----------------------------------------------------
-        // Face
-        // -----------------------------------------------------
-        if (*p == 'f' && p + 1 < e && (p[1] == ' ' || p[1] == '\t'))
-        {
-            ensureDefaultMesh();
-            p += 2;
+        currentMesh->reserve(static_cast<int32_t>(objectVerts.size()));
 
-            SysPolyVerts pv;
-            SysPolyVerts pn;
-            SysPolyVerts pt;
+        for (const int32_t v : objectVerts)
+            globalToLocal[static_cast<size_t>(v)] = currentMesh->create_vert(positions[static_cast<size_t>(v)]);
 
-            bool invalidFace = false;
-
-            while (p < e && *p != '\n' && *p != '\r')
+        for (const ObjFaceSpan& span : objectSpans)
+        {
+            const ObjChunk& c      = chunks[span.chunk];
+            size_t          corner = span.corner;
+            for (uint32_t f = span.begin; f < span.end; ++f)
             {
-                p = skip_spaces(p, e);
-                if (p >= e || *p == '\n' || *p == '\r')
-                    break;
-
-                const ObjIdx idx = parse_face_vertex(
-                    p,
-                    e,
-                    static_cast<int>(positions.size()),
-                    static_cast<int>(texcoords.size()),
-                    static_cast<int>(normals.size()));
-
-                if (idx.v < 0 || idx.v >= static_cast<int>(positions.size()))
+                const int32_t n = c.faceSizes[f];
+                if (n < 0)
                 {
-                    invalidFace = true;
-                    break;
+                    report.error("Invalid vertex index in face, skipping polygon.");
+                    continue;
                 }
 
-                // OBJ indices are dense. Use the pre-sized vector + stamp.
-                // No hash lookup, no resize, no clearing between objects.
-                int meshIdx = -1;
-                if (static_cast<size_t>(idx.v) < globalToLocal.size() &&
-                    globalToLocalStamp[static_cast<size_t>(idx.v)] == meshStamp)
-                {
-                    meshIdx = globalToLocal[static_cast<size_t>(idx.v)];
-                }
-                else
+                SysPolyVerts pv;
+                SysPolyVerts pn;
+                SysPolyVerts pt;
+
+                for (int32_t k = 0; k < n; ++k, ++corner)
                 {
-                    meshIdx = currentMesh->create_vert(positions[static_cast<size_t>(idx.v)]);
-                    if (static_cast<size_t>(idx.v) < globalToLocal.size())
-                    {
-                        globalToLocal[static_cast<size_t>(idx.v)]      = meshIdx;
-                        globalToLocalStamp[static_cast<size_t>(idx.v)] = meshStamp;
-                    }
-                }
+                    const ObjIdx& idx = c.corners[corner];
+                    pv.push_back(globalToLocal[static_cast<size_t>(idx.v)]);
 
-                pv.push_back(meshIdx);
+                    // Keep original editable semantics: normal/UV map verts are
+                    // unique per face corner. Do NOT cache/reuse vn/vt indices.
+                    if (normMap != -1 && idx.n >= 0)
+                        pn.push_back(currentMesh->map_create_vert(normMap, glm::value_ptr(normals[static_cast<size_t>(idx.n)])));
 
-                // Keep original editable semantics: normal/UV map verts are
-                // unique per face corner. Do NOT cache/reuse vn/vt indices.
-                if (normMap != -1 && idx.n >= 0 && idx.n < static_cast<int>(normals.size()))
-                {
-                    pn.push_back(currentMesh->map_create_vert(normMap, glm::value_ptr(normals[static_cast<size_t>(idx.n)])));
+                    if (texMap != -1 && idx.t >= 0)
+                        pt.push_back(currentMesh->map_create_vert(texMap, glm::value_ptr(texcoords[static_cast<size_t>(idx.t)])));
                 }
 
-                if (texMap != -1 && idx.t >= 0 && idx.t < static_cast<int>(texcoords.size()))
-                {
-                    pt.push_back(currentMesh->map_create_vert(texMap, glm::value_ptr(texcoords[static_cast<size_t>(idx.t)])));
-                }
-            }
+                if (pv.size() < 3)
+                    continue;
 
-            if (!invalidFace && pv.size() >= 3)
-            {
-                const int poly = currentMesh->create_poly(pv, matIndex);
+                const int poly = currentMesh->create_poly(pv, span.material);
                 if (poly >= 0)
                 {
                     if (pn.size() == pv.size())
@@ -1421,54 +1638,64 @@ bool ObjSceneFormat::load(Scene*                       scene,
                         currentMesh->map_create_poly(texMap, poly, pt);
                 }
             }
-            else if (invalidFace)
-            {
-                report.error("Invalid vertex index in face, skipping polygon.");
-            }
-
-            p = next_line(p, e);
-            continue;
         }
 
-        // -----------------------------------------------------
-        // Object name
-        // -----------------------------------------------------
-        if (*p == 'o' && p + 1 < e && (p[1] == ' ' || p[1] == '\t'))
-        {
-            p += 2;
-            std::string objName = read_token_string(p, e);
-            startNewMesh(objName);
-            p = next_line(p, e);
-            continue;
-        }
+        objectOpen = false;
+        objectSpans.clear();
+    };
 
-        // -----------------------------------------------------
-        // Material library
-        // -----------------------------------------------------
-        if (starts_with_keyword(p, e, "mtllib", 6))
-        {
-            p += 6;
-            matlib = read_rest_of_line_trimmed(p, e);
-            p      = next_line(p, e);
-            continue;
-        }
+    auto openObject = [&](const std::string& name) {
+        buildObject();
+        objectOpen = true;
+        objectName = name;
+    };
 
-        // -----------------------------------------------------
-        // Material assignment
-        // -----------------------------------------------------
-        if (starts_with_keyword(p, e, "usemtl", 6))
+    for (uint32_t ci = 0; ci < static_cast<uint32_t>(chunks.size()); ++ci)
+    {
+        const ObjChunk& c         = chunks[ci];
+        const uint32_t  faceCount = static_cast<uint32_t>(c.faceSizes.size());
+
+        uint32_t face   = 0;
+        size_t   corner = 0;
+
+        auto emitFaces = [&](uint32_t upTo) {
+            if (upTo <= face)
+                return;
+
+            if (!objectOpen)
+                openObject("Default");
+
+            ObjFaceSpan span{ci, face, upTo, corner, matIndex};
+            for (; face < upTo; ++face)
+                corner += static_cast<size_t>(std::max(c.faceSizes[face], 0));
+            objectSpans.push_back(span);
+        };
+
+        for (const ObjEvent& ev : c.events)
         {
-            p += 6;
-            std::string matName = read_token_string(p, e);
-            matIndex            = materials->createMaterial(matName);
-            p                   = next_line(p, e);
-            continue;
+            emitFaces(ev.face);
+
+            switch (ev.kind)
+            {
+                case ObjLine::Object:
+                    openObject(ev.name.empty() ? std::string("Object") : ev.name);
+                    break;
+                case ObjLine::MtlLib:
+                    matlib = ev.name;
+                    break;
+                case ObjLine::UseMtl:
+                    matIndex = materials->createMaterial(ev.name);
+                    break;
+                default:
+                    break;
+            }
         }
 
-        // Ignore unsupported OBJ commands: g, s, l, p, vp, etc.
-        p = next_line(p, e);
+        emitFaces(faceCount);
     }
 
+    buildObject();
+
     // ---------------------------------------------------------
     // Load .mtl if present
     // ---------------------------------------------------------
@@ -1584,9 +1811,9 @@ bool ObjSceneFormat::save(const Scene*                 scene,
     }
 
     // ---------------------------------------------------------------------
-    // Open OBJ file
+    // Open OBJ file (binary: pieces are written as-is, "\n" line ends)
     // ---------------------------------------------------------------------
-    std::ofstream out(filePath);
+    std::ofstream out(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
     if (!out)
     {
         report.error("SceneFormatOBJ::save: failed to open OBJ file for writing: " + filePath.string());
@@ -1600,7 +1827,14 @@ bool ObjSceneFormat::save(const Scene*                 scene,
     std::string           mtlFilename = filePath.filename().replace_extension(".mtl").string();
     std::filesystem::path mtlPath     = filePath.parent_path() / mtlFilename;
 
-    out << "mtllib " << mtlFilename << "\n";
+    std::vector<std::string> pieces;
+    pieces.push_back("mtllib " + mtlFilename + "\n");
+
+    auto flushPieces = [&]() {
+        for (const std::string& piece : pieces)
+            out.write(piece.data(), static_cast<std::streamsize>(piece.size()));
+        pieces.clear();
+    };
 
     // ---------------------------------------------------------------------
     // Material access
@@ -1618,9 +1852,9 @@ bool ObjSceneFormat::save(const Scene*                 scene,
     // ---------------------------------------------------------------------
     // Iterate over scene meshes
     // ---------------------------------------------------------------------
-    int vertBase = 1;
-    int normBase = 1;
-    int texBase  = 1;
+    int64_t vertBase = 1;
+    int64_t normBase = 1;
+    int64_t texBase  = 1;
 
     int unnamedCounter = 1;
 
@@ -1639,94 +1873,69 @@ bool ObjSceneFormat::save(const Scene*                 scene,
         if (name.empty() || name == "Unnamed")
             name = "Unnamed_" + std::to_string(unnamedCounter++);
 
-        out << "# OriginalName: " << name << "\n";
-        out << "o " << sanitizeName(name) << "\n";
+        pieces.push_back("# OriginalName: " + name + "\no " + sanitizeName(name) + "\n");
 
         const int normalMap = mesh->map_find(/*MESH_MAP_NORMALS*/ 0);
         const int texMap    = mesh->map_find(/*MESH_MAP_UV0*/ 1);
 
         // -----------------------------------------------------------------
-        // Write vertex positions (v)
+        // Write vertex positions (v). Faces refer to them through a dense
+        // slot table, so meshes with deleted verts still index correctly.
         // -----------------------------------------------------------------
-        for (int vi : mesh->all_verts())
-        {
-            const glm::vec3 pos = mesh->vert_position(vi);
-            out << "v " << pos.x << " " << pos.y << " " << pos.z << "\n";
-        }
+        const std::vector<int32_t>& vAll = mesh->all_verts();
+
+        std::vector<int64_t> vertRemap(static_cast<size_t>(mesh->vert_buffer_size()), 0);
+        for (size_t i = 0; i < vAll.size(); ++i)
+            vertRemap[static_cast<size_t>(vAll[i])] = vertBase + static_cast<int64_t>(i);
+
+        format_records(pieces, vAll.size(), 40, [&](std::string& s, size_t i) {
+            const glm::vec3& pos = mesh->vert_position(vAll[i]);
+            append_floats(s, "v", glm::value_ptr(pos), 3);
+        });
 
         // -----------------------------------------------------------------
-        // Collect used face-varying map-verts (normals / texcoords)
+        // Collect used face-varying map-verts (normals / texcoords) in
+        // first-use order; remap tables are slot-indexed (0 = unused).
         // -----------------------------------------------------------------
         std::vector<int32_t> usedNormIds;
-        usedNormIds.reserve(1024);
         std::vector<int32_t> usedTexIds;
-        usedTexIds.reserve(1024);
+        std::vector<int64_t> normalRemap(normalMap != -1 ? static_cast<size_t>(mesh->map_buffer_size(normalMap)) : 0, 0);
+        std::vector<int64_t> texcoordRemap(texMap != -1 ? static_cast<size_t>(mesh->map_buffer_size(texMap)) : 0, 0);
 
-        std::unordered_set<int32_t> seenN;
-        std::unordered_set<int32_t> seenT;
+        auto collect = [](const SysPolyVerts& ids, std::vector<int64_t>& remap, std::vector<int32_t>& used, int64_t base) {
+            for (int id : ids)
+            {
+                if (id >= 0 && static_cast<size_t>(id) < remap.size() && remap[static_cast<size_t>(id)] == 0)
+                {
+                    remap[static_cast<size_t>(id)] = base + static_cast<int64_t>(used.size());
+                    used.push_back(id);
+                }
+            }
+        };
 
         if (normalMap != -1 || texMap != -1)
         {
             for (int pi : mesh->all_polys())
             {
                 if (normalMap != -1)
-                {
-                    const auto& pn = mesh->map_poly_verts(normalMap, pi);
-                    for (int id : pn)
-                    {
-                        if (id >= 0 && !seenN.count(id))
-                        {
-                            seenN.insert(id);
-                            usedNormIds.push_back(id);
-                        }
-                    }
-                }
+                    collect(mesh->map_poly_verts(normalMap, pi), normalRemap, usedNormIds, normBase);
                 if (texMap != -1)
-                {
-                    const auto& pt = mesh->map_poly_verts(texMap, pi);
-                    for (int id : pt)
-                    {
-                        if (id >= 0 && !seenT.count(id))
-                        {
-                            seenT.insert(id);
-                            usedTexIds.push_back(id);
-                        }
-                    }
-                }
+                    collect(mesh->map_poly_verts(texMap, pi), texcoordRemap, usedTexIds, texBase);
             }
         }
 
         // -----------------------------------------------------------------
-        // Emit vt / vn and build remaps (mapVertId -> OBJ 1-based index)
+        // Emit vt / vn
         // -----------------------------------------------------------------
-        std::unordered_map<int32_t, int32_t> texcoordRemap;
-        std::unordered_map<int32_t, int32_t> normalRemap;
+        format_records(pieces, usedTexIds.size(), 28, [&](std::string& s, size_t i) {
+            append_floats(s, "vt", mesh->map_vert_position(texMap, usedTexIds[i]), 2);
+        });
+        texBase += static_cast<int64_t>(usedTexIds.size());
 
-        if (texMap != -1)
-        {
-            int written = 0;
-            for (int id : usedTexIds)
-            {
-                const glm::vec2 uv = glm::make_vec2(mesh->map_vert_position(texMap, id));
-                texcoordRemap[id]  = texBase + written;
-                out << "vt " << uv.x << " " << uv.y << "\n";
-                ++written;
-            }
-            texBase += written;
-        }
-
-        if (normalMap != -1)
-        {
-            int written = 0;
-            for (int id : usedNormIds)
-            {
-                const glm::vec3 n = glm::make_vec3(mesh->map_vert_position(normalMap, id));
-                normalRemap[id]   = normBase + written;
-                out << "vn " << n.x << " " << n.y << " " << n.z << "\n";
-                ++written;
-            }
-            normBase += written;
-        }
+        format_records(pieces, usedNormIds.size(), 40, [&](std::string& s, size_t i) {
+            append_floats(s, "vn", mesh->map_vert_position(normalMap, usedNormIds[i]), 3);
+        });
+        normBase += static_cast<int64_t>(usedNormIds.size());
 
         // -----------------------------------------------------------------
         // Group polygons by material and write faces
@@ -1745,10 +1954,10 @@ bool ObjSceneFormat::save(const Scene*                 scene,
                     ? materials[matIndex].name()
                     : std::string("Default");
 
-            out << "usemtl " << sanitizeName(matName) << "\n";
+            pieces.push_back("usemtl " + sanitizeName(matName) + "\n");
 
-            for (int pi : polyList)
-            {
+            format_records(pieces, polyList.size(), 48, [&](std::string& s, size_t i) {
+                const int   pi    = polyList[i];
                 const auto& verts = mesh->poly_verts(pi);
                 const auto& pn    = (normalMap != -1) ? mesh->map_poly_verts(normalMap, pi) : SysPolyVerts{};
                 const auto& pt    = (texMap != -1) ? mesh->map_poly_verts(texMap, pi) : SysPolyVerts{};
@@ -1756,35 +1965,35 @@ bool ObjSceneFormat::save(const Scene*                 scene,
                 const bool hasN  = (normalMap != -1) && (pn.size() == verts.size());
                 const bool hasUV = (texMap != -1) && (pt.size() == verts.size());
 
-                out << "f";
-                for (size_t i = 0; i < verts.size(); ++i)
+                s += 'f';
+                for (int k = 0; k < verts.size(); ++k)
                 {
-                    const int vIdx = vertBase + verts[i];
+                    s += ' ';
+                    append_int(s, vertRemap[static_cast<size_t>(verts[k])]);
 
-                    if (hasUV && hasN)
-                    {
-                        out << " " << vIdx << "/" << texcoordRemap.at(pt[i]) << "/" << normalRemap.at(pn[i]);
-                    }
-                    else if (hasUV)
-                    {
-                        out << " " << vIdx << "/" << texcoordRemap.at(pt[i]);
-                    }
-                    else if (hasN)
+                    if (hasUV)
                     {
-                        out << " " << vIdx << "//" << normalRemap.at(pn[i]);
+                        s += '/';
+                        append_int(s, texcoordRemap[static_cast<size_t>(pt[k])]);
                     }
-                    else
+
+                    if (hasN)
                     {
-                        out << " " << vIdx;
+                        s += hasUV ? "/" : "//";
+                        append_int(s, normalRemap[static_cast<size_t>(pn[k])]);
                     }
                 }
-                out << "\n";
-            }
+                s += '\n';
+            });
         }
 
-        vertBase += mesh->num_verts();
+        vertBase += static_cast<int64_t>(vAll.size());
+
+        flushPieces();
     }
 
+    flushPieces();
+
     out.close();
     if (!out)
     {
@@ -1811,39 +2020,41 @@ bool ObjSceneFormat::save(const Scene*                 scene,
 bool ObjSceneFormat::saveMaterialLibrary(const Scene* scene, const std::filesystem::path& filePath)
 {
     const auto&   materials = scene->materialHandler()->materials();
-    std::ofstream out(filePath);
+    std::ofstream out(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
     if (!out)
     {
         std::cerr << "Could not open material file for writing: " << filePath << "\n";
         return false;
     }
 
-    out << std::fixed << std::setprecision(6);
+    const auto dir = filePath.parent_path();
 
+    std::string text;
     for (const auto& mat : materials)
     {
         const MtlFields mtl = toMTL(mat, scene);
 
-        out << "newmtl " << sanitizeName(mat.name()) << "\n";
-        out << "Ka " << mtl.Ka.r << " " << mtl.Ka.g << " " << mtl.Ka.b << "\n";
-        out << "Kd " << mtl.Kd.r << " " << mtl.Kd.g << " " << mtl.Kd.b << "\n";
-        out << "Ks " << mtl.Ks.r << " " << mtl.Ks.g << " " << mtl.Ks.b << "\n";
-        out << "Ke " << mtl.Ke.r << " " << mtl.Ke.g << " " << mtl.Ke.b << "\n";
-        out << "Tf " << mtl.Tf.r << " " << mtl.Tf.g << " " << mtl.Tf.b << "\n";
-        out << "Tr " << mtl.Tr << "\n";
-        out << "Ns " << mtl.Ns << "\n";
-        out << "Ni " << mtl.Ni << "\n";
-        out << "d " << mtl.d << "\n";
-
-        const auto dir = filePath.parent_path();
+        text += "newmtl " + sanitizeName(mat.name()) + "\n";
+        append_floats(text, "Ka", glm::value_ptr(mtl.Ka), 3);
+        append_floats(text, "Kd", glm::value_ptr(mtl.Kd), 3);
+        append_floats(text, "Ks", glm::value_ptr(mtl.Ks), 3);
+        append_floats(text, "Ke", glm::value_ptr(mtl.Ke), 3);
+        append_floats(text, "Tf", glm::value_ptr(mtl.Tf), 3);
+        append_floats(text, "Tr", &mtl.Tr, 1);
+        append_floats(text, "Ns", &mtl.Ns, 1);
+        append_floats(text, "Ni", &mtl.Ni, 1);
+        append_floats(text, "d", &mtl.d, 1);
+
         if (!mtl.map_Kd.empty())
-            out << "map_Kd " << PathUtil::relativeSanitized(mtl.map_Kd, dir) << "\n";
+            text += "map_Kd " + PathUtil::relativeSanitized(mtl.map_Kd, dir) + "\n";
         if (!mtl.map_bump.empty())
-            out << "map_bump " << PathUtil::relativeSanitized(mtl.map_bump, dir) << "\n";
+            text += "map_bump " + PathUtil::relativeSanitized(mtl.map_bump, dir) + "\n";
         if (!mtl.map_Ke.empty())
-            out << "map_Ke " << PathUtil::relativeSanitized(mtl.map_Ke, dir) << "\n";
+            text += "map_Ke " + PathUtil::relativeSanitized(mtl.map_Ke, dir) + "\n";
 
-        out << "\n";
+        text += "\n";
     }
-    return true;
+
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return out.good();
 }
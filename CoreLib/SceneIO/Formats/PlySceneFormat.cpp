@@ -0,0 +1,1255 @@
+#include "PlySceneFormat.hpp"
+
+#include <SysMesh.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <glm/gtc/type_ptr.hpp>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "MappedFile.hpp"
+#include "Scene.hpp"
+#include "SceneMesh.hpp"
+#include "TaskPool.hpp"
+
+namespace
+{
+    /// Per-vertex RGBA colors (dim 4). Maps 0 and 1 are normals and UV0.
+    constexpr int32_t kColorMapId = 2;
+
+    /// Vertex/face records handled by one parallel job.
+    constexpr size_t kPlyRecordsPerJob = 16384;
+
+    enum class PlyEncoding
+    {
+        Ascii,
+        BinaryLE,
+        BinaryBE,
+    };
+
+    enum class PlyType : uint8_t
+    {
+        Invalid,
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Float32,
+        Float64,
+    };
+
+    struct PlyProperty
+    {
+        std::string name      = {};
+        PlyType     type      = PlyType::Invalid; // Item type for lists.
+        PlyType     countType = PlyType::Invalid; // Invalid for scalar properties.
+        size_t      offset    = 0;                // Byte offset in the record, fixed-size elements only.
+
+        [[nodiscard]] bool isList() const noexcept
+        {
+            return countType != PlyType::Invalid;
+        }
+    };
+
+    struct PlyElement
+    {
+        std::string              name   = {};
+        size_t                   count  = 0;
+        std::vector<PlyProperty> props  = {};
+        size_t                   stride = 0; // 0 when the element has list properties.
+    };
+
+    struct PlyHeader
+    {
+        PlyEncoding             encoding   = PlyEncoding::Ascii;
+        std::vector<PlyElement> elements   = {};
+        size_t                  dataOffset = 0;
+    };
+
+    /// Property indices (into the vertex element) of the attributes we import; -1 if absent.
+    struct PlyVertexLayout
+    {
+        int   pos[3]        = {-1, -1, -1};
+        int   normal[3]     = {-1, -1, -1};
+        int   color[4]      = {-1, -1, -1, -1};
+        int   uv[2]         = {-1, -1};
+        float colorScale[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+        bool hasNormals = false;
+        bool hasColors  = false;
+        bool hasUVs     = false;
+    };
+
+    struct PlyVertices
+    {
+        std::vector<glm::vec3> positions = {};
+        std::vector<glm::vec3> normals   = {};
+        std::vector<glm::vec4> colors    = {};
+        std::vector<glm::vec2> uvs       = {};
+    };
+
+    struct PlyFaces
+    {
+        std::vector<uint32_t> sizes   = {};
+        std::vector<uint32_t> indices = {}; // Negative file indices become UINT32_MAX (out of range).
+    };
+
+    size_t typeSize(PlyType type) noexcept
+    {
+        switch (type)
+        {
+            case PlyType::Int8:
+            case PlyType::UInt8:
+                return 1;
+            case PlyType::Int16:
+            case PlyType::UInt16:
+                return 2;
+            case PlyType::Int32:
+            case PlyType::UInt32:
+            case PlyType::Float32:
+                return 4;
+            case PlyType::Float64:
+                return 8;
+            case PlyType::Invalid:
+                break;
+        }
+        return 0;
+    }
+
+    PlyType parseType(std::string_view s) noexcept
+    {
+        if (s == "char" || s == "int8")
+            return PlyType::Int8;
+        if (s == "uchar" || s == "uint8")
+            return PlyType::UInt8;
+        if (s == "short" || s == "int16")
+            return PlyType::Int16;
+        if (s == "ushort" || s == "uint16")
+            return PlyType::UInt16;
+        if (s == "int" || s == "int32")
+            return PlyType::Int32;
+        if (s == "uint" || s == "uint32")
+            return PlyType::UInt32;
+        if (s == "float" || s == "float32")
+            return PlyType::Float32;
+        if (s == "double" || s == "float64")
+            return PlyType::Float64;
+        return PlyType::Invalid;
+    }
+
+    bool isIntegerType(PlyType type) noexcept
+    {
+        return type != PlyType::Invalid && type != PlyType::Float32 && type != PlyType::Float64;
+    }
+
+    /// Scale that maps an integer color channel to [0,1]; floats are taken as-is.
+    float colorScale(PlyType type) noexcept
+    {
+        switch (type)
+        {
+            case PlyType::Int8:
+                return 1.0f / 127.0f;
+            case PlyType::UInt8:
+                return 1.0f / 255.0f;
+            case PlyType::Int16:
+                return 1.0f / 32767.0f;
+            case PlyType::UInt16:
+                return 1.0f / 65535.0f;
+            case PlyType::Int32:
+                return 1.0f / 2147483647.0f;
+            case PlyType::UInt32:
+                return 1.0f / 4294967295.0f;
+            default:
+                return 1.0f;
+        }
+    }
+
+    std::vector<std::string_view> splitWords(std::string_view line)
+    {
+        std::vector<std::string_view> words;
+
+        size_t i = 0;
+        while (i < line.size())
+        {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t'))
+                ++i;
+
+            const size_t b = i;
+            while (i < line.size() && line[i] != ' ' && line[i] != '\t')
+                ++i;
+
+            if (i > b)
+                words.push_back(line.substr(b, i - b));
+        }
+
+        return words;
+    }
+
+    /// Fewest body bytes one record of @p e can take: a count for each list, and
+    /// for ASCII one character per value. 0 if the element has no properties.
+    size_t minRecordBytes(const PlyElement& e, PlyEncoding encoding) noexcept
+    {
+        size_t bytes = 0;
+        for (const PlyProperty& p : e.props)
+            bytes += encoding == PlyEncoding::Ascii ? 1 : typeSize(p.isList() ? p.countType : p.type);
+        return bytes;
+    }
+
+    bool parseHeader(std::span<const uint8_t> file, PlyHeader& h, std::string& why)
+    {
+        const std::string_view text(reinterpret_cast<const char*>(file.data()), file.size());
+        if (!text.starts_with("ply"))
+        {
+            why = "missing 'ply' signature";
+            return false;
+        }
+
+        bool   haveFormat = false;
+        size_t pos        = 0;
+
+        while (pos < text.size())
+        {
+            const size_t eol = text.find('\n', pos);
+            if (eol == std::string_view::npos)
+                break;
+
+            std::string_view line = text.substr(pos, eol - pos);
+            pos                   = eol + 1;
+
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+
+            const std::vector<std::string_view> tok = splitWords(line);
+            if (tok.empty() || tok[0] == "ply" || tok[0] == "comment" || tok[0] == "obj_info")
+                continue;
+
+            if (tok[0] == "format")
+            {
+                if (tok.size() < 2)
+                {
+                    why = "incomplete format line";
+                    return false;
+                }
+
+                if (tok[1] == "ascii")
+                    h.encoding = PlyEncoding::Ascii;
+                else if (tok[1] == "binary_little_endian")
+                    h.encoding = PlyEncoding::BinaryLE;
+                else if (tok[1] == "binary_big_endian")
+                    h.encoding = PlyEncoding::BinaryBE;
+                else
+                {
+                    why = "unknown format '" + std::string(tok[1]) + "'";
+                    return false;
+                }
+                haveFormat = true;
+            }
+            else if (tok[0] == "element")
+            {
+                PlyElement e;
+                if (tok.size() != 3 || std::from_chars(tok[2].data(), tok[2].data() + tok[2].size(), e.count).ec != std::errc{})
+                {
+                    why = "malformed element line '" + std::string(line) + "'";
+                    return false;
+                }
+
+                e.name = std::string(tok[1]);
+                h.elements.push_back(std::move(e));
+            }
+            else if (tok[0] == "property")
+            {
+                if (h.elements.empty())
+                {
+                    why = "property before any element";
+                    return false;
+                }
+
+                PlyProperty p;
+                if (tok.size() == 5 && tok[1] == "list")
+                {
+                    p.countType = parseType(tok[2]);
+                    p.type      = parseType(tok[3]);
+                    p.name      = std::string(tok[4]);
+
+                    if (!isIntegerType(p.countType))
+                        p.type = PlyType::Invalid;
+                }
+                else if (tok.size() == 3)
+                {
+                    p.type = parseType(tok[1]);
+                    p.name = std::string(tok[2]);
+                }
+
+                if (p.type == PlyType::Invalid)
+                {
+                    why = "malformed property line '" + std::string(line) + "'";
+                    return false;
+                }
+
+                h.elements.back().props.push_back(std::move(p));
+            }
+            else if (tok[0] == "end_header")
+            {
+                if (!haveFormat)
+                {
+                    why = "missing format line";
+                    return false;
+                }
+
+                h.dataOffset = pos;
+
+                for (PlyElement& e : h.elements)
+                {
+                    size_t offset = 0;
+                    for (PlyProperty& p : e.props)
+                    {
+                        if (p.isList())
+                        {
+                            offset = 0;
+                            break;
+                        }
+                        p.offset = offset;
+                        offset += typeSize(p.type);
+                    }
+                    e.stride = offset;
+                }
+
+                // Counts size the body buffers, so they must fit in the bytes actually present.
+                size_t remaining = file.size() - pos;
+                for (const PlyElement& e : h.elements)
+                {
+                    const size_t minBytes = minRecordBytes(e, h.encoding);
+                    if (minBytes == 0)
+                        continue;
+
+                    if (e.count > remaining / minBytes)
+                    {
+                        why = "element '" + e.name + "' count exceeds the file size";
+                        return false;
+                    }
+                    remaining -= e.count * minBytes;
+                }
+                return true;
+            }
+            else
+            {
+                why = "unknown header keyword '" + std::string(tok[0]) + "'";
+                return false;
+            }
+        }
+
+        why = "header is not terminated by end_header";
+        return false;
+    }
+
+    int findProperty(const PlyElement& e, std::initializer_list<std::string_view> names) noexcept
+    {
+        for (std::string_view name : names)
+        {
+            for (size_t i = 0; i < e.props.size(); ++i)
+            {
+                if (!e.props[i].isList() && e.props[i].name == name)
+                    return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    PlyVertexLayout vertexLayout(const PlyElement& e)
+    {
+        PlyVertexLayout l;
+
+        l.pos[0] = findProperty(e, {"x"});
+        l.pos[1] = findProperty(e, {"y"});
+        l.pos[2] = findProperty(e, {"z"});
+
+        l.normal[0]  = findProperty(e, {"nx", "normal_x"});
+        l.normal[1]  = findProperty(e, {"ny", "normal_y"});
+        l.normal[2]  = findProperty(e, {"nz", "normal_z"});
+        l.hasNormals = l.normal[0] >= 0 && l.normal[1] >= 0 && l.normal[2] >= 0;
+
+        l.color[0]  = findProperty(e, {"red", "r", "diffuse_red"});
+        l.color[1]  = findProperty(e, {"green", "g", "diffuse_green"});
+        l.color[2]  = findProperty(e, {"blue", "b", "diffuse_blue"});
+        l.color[3]  = findProperty(e, {"alpha", "a", "diffuse_alpha"});
+        l.hasColors = l.color[0] >= 0 && l.color[1] >= 0 && l.color[2] >= 0;
+
+        for (int c = 0; c < 4; ++c)
+        {
+            if (l.color[c] >= 0)
+                l.colorScale[c] = colorScale(e.props[static_cast<size_t>(l.color[c])].type);
+        }
+
+        l.uv[0]  = findProperty(e, {"u", "s", "texture_u", "texture_s"});
+        l.uv[1]  = findProperty(e, {"v", "t", "texture_v", "texture_t"});
+        l.hasUVs = l.uv[0] >= 0 && l.uv[1] >= 0;
+
+        return l;
+    }
+
+    /// The face element's index list: "vertex_indices", "vertex_index", or its only list.
+    int faceListProperty(const PlyElement& e) noexcept
+    {
+        int onlyList = -1;
+        int lists    = 0;
+
+        for (size_t i = 0; i < e.props.size(); ++i)
+        {
+            const PlyProperty& p = e.props[i];
+            if (!p.isList())
+                continue;
+
+            if (p.name == "vertex_indices" || p.name == "vertex_index")
+                return isIntegerType(p.type) ? static_cast<int>(i) : -1;
+
+            onlyList = static_cast<int>(i);
+            ++lists;
+        }
+
+        return (lists == 1 && isIntegerType(e.props[static_cast<size_t>(onlyList)].type)) ? onlyList : -1;
+    }
+
+    template<typename T>
+    T loadScalar(const uint8_t* p, bool swap) noexcept
+    {
+        using Bits = std::conditional_t<sizeof(T) == 1, uint8_t,
+                                        std::conditional_t<sizeof(T) == 2, uint16_t,
+                                                           std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+        Bits bits;
+        std::memcpy(&bits, p, sizeof(bits));
+        if constexpr (sizeof(T) > 1)
+        {
+            if (swap)
+                bits = std::byteswap(bits);
+        }
+        return std::bit_cast<T>(bits);
+    }
+
+    double readBinary(const uint8_t* p, PlyType type, bool swap) noexcept
+    {
+        switch (type)
+        {
+            case PlyType::Int8:
+                return loadScalar<int8_t>(p, swap);
+            case PlyType::UInt8:
+                return loadScalar<uint8_t>(p, swap);
+            case PlyType::Int16:
+                return loadScalar<int16_t>(p, swap);
+            case PlyType::UInt16:
+                return loadScalar<uint16_t>(p, swap);
+            case PlyType::Int32:
+                return loadScalar<int32_t>(p, swap);
+            case PlyType::UInt32:
+                return loadScalar<uint32_t>(p, swap);
+            case PlyType::Float32:
+                return loadScalar<float>(p, swap);
+            case PlyType::Float64:
+                return loadScalar<double>(p, swap);
+            case PlyType::Invalid:
+                break;
+        }
+        return 0.0;
+    }
+
+    uint32_t toIndex(double v) noexcept
+    {
+        return (v >= 0.0 && v < 4294967295.0) ? static_cast<uint32_t>(v) : std::numeric_limits<uint32_t>::max();
+    }
+
+    /// Store vertex @p i; get(k) returns the value of vertex property k.
+    template<typename Get>
+    void storeVertex(const PlyVertexLayout& l, size_t i, const Get& get, PlyVertices& v)
+    {
+        v.positions[i] = glm::vec3(get(l.pos[0]), get(l.pos[1]), get(l.pos[2]));
+
+        if (l.hasNormals)
+            v.normals[i] = glm::vec3(get(l.normal[0]), get(l.normal[1]), get(l.normal[2]));
+
+        if (l.hasColors)
+        {
+            v.colors[i] = glm::vec4(get(l.color[0]) * l.colorScale[0],
+                                    get(l.color[1]) * l.colorScale[1],
+                                    get(l.color[2]) * l.colorScale[2],
+                                    l.color[3] >= 0 ? get(l.color[3]) * l.colorScale[3] : 1.0f);
+        }
+
+        if (l.hasUVs)
+            v.uvs[i] = glm::vec2(get(l.uv[0]), get(l.uv[1]));
+    }
+
+    void resizeVertices(PlyVertices& v, const PlyVertexLayout& l, size_t count)
+    {
+        v.positions.resize(count);
+        v.normals.resize(l.hasNormals ? count : 0);
+        v.colors.resize(l.hasColors ? count : 0);
+        v.uvs.resize(l.hasUVs ? count : 0);
+    }
+
+    /// Fixed-stride binary vertices: every record is independent, so decode in parallel jobs.
+    void decodeBinaryVertices(const uint8_t*         base,
+                              const PlyElement&      e,
+                              const PlyVertexLayout& l,
+                              bool                   swap,
+                              PlyVertices&           v)
+    {
+        const size_t jobs = (e.count + kPlyRecordsPerJob - 1) / kPlyRecordsPerJob;
+
+        TaskPool::shared().parallelFor(static_cast<uint32_t>(jobs), [&](uint32_t j) {
+            const size_t b = size_t(j) * kPlyRecordsPerJob;
+            const size_t n = std::min(e.count, b + kPlyRecordsPerJob);
+
+            for (size_t i = b; i < n; ++i)
+            {
+                const uint8_t* rec = base + i * e.stride;
+                storeVertex(l, i, [&](int k) {
+                    const PlyProperty& p = e.props[static_cast<size_t>(k)];
+                    return static_cast<float>(readBinary(rec + p.offset, p.type, swap));
+                }, v);
+            }
+        });
+    }
+
+    /// Binary body: fixed-size elements are located by arithmetic, the others walked record by record.
+    /// Only @p vertexElem is decoded into @p verts (sized for it by the caller).
+    bool readBinaryBody(std::span<const uint8_t> file,
+                        const PlyHeader&         h,
+                        const PlyElement*        vertexElem,
+                        const PlyVertexLayout&   layout,
+                        PlyVertices&             verts,
+                        PlyFaces&                faces,
+                        std::string&             why)
+    {
+        const bool swap = (h.encoding == PlyEncoding::BinaryLE) != (std::endian::native == std::endian::little);
+
+        size_t              pos = h.dataOffset;
+        std::vector<double> values;
+
+        for (const PlyElement& e : h.elements)
+        {
+            const bool isVertex = &e == vertexElem;
+            const bool isFace   = e.name == "face";
+            const int  faceList = isFace ? faceListProperty(e) : -1;
+
+            if (e.stride != 0 || e.props.empty())
+            {
+                if (e.stride != 0 && e.count > (file.size() - pos) / e.stride)
+                {
+                    why = "element '" + e.name + "' runs past the end of the file";
+                    return false;
+                }
+
+                if (isVertex)
+                    decodeBinaryVertices(file.data() + pos, e, layout, swap, verts);
+
+                pos += e.count * e.stride;
+                continue;
+            }
+
+            if (isFace)
+            {
+                faces.sizes.reserve(e.count);
+                faces.indices.reserve(e.count * 3);
+            }
+
+            values.resize(e.props.size());
+
+            for (size_t i = 0; i < e.count; ++i)
+            {
+                for (size_t k = 0; k < e.props.size(); ++k)
+                {
+                    const PlyProperty& p = e.props[k];
+
+                    if (!p.isList())
+                    {
+                        const size_t size = typeSize(p.type);
+                        if (size > file.size() - pos)
+                        {
+                            why = "element '" + e.name + "' runs past the end of the file";
+                            return false;
+                        }
+                        values[k] = readBinary(file.data() + pos, p.type, swap);
+                        pos += size;
+                        continue;
+                    }
+
+                    const size_t countSize = typeSize(p.countType);
+                    if (countSize > file.size() - pos)
+                    {
+                        why = "element '" + e.name + "' runs past the end of the file";
+                        return false;
+                    }
+
+                    const double count    = readBinary(file.data() + pos, p.countType, swap);
+                    const size_t itemSize = typeSize(p.type);
+                    pos += countSize;
+
+                    if (count < 0.0 || static_cast<size_t>(count) > (file.size() - pos) / itemSize)
+                    {
+                        why = "list in element '" + e.name + "' runs past the end of the file";
+                        return false;
+                    }
+
+                    const size_t n = static_cast<size_t>(count);
+                    if (static_cast<int>(k) == faceList)
+                    {
+                        faces.sizes.push_back(static_cast<uint32_t>(n));
+                        for (size_t c = 0; c < n; ++c)
+                            faces.indices.push_back(toIndex(readBinary(file.data() + pos + c * itemSize, p.type, swap)));
+                    }
+                    pos += n * itemSize;
+                }
+
+                if (isVertex)
+                    storeVertex(layout, i, [&](int k) { return static_cast<float>(values[static_cast<size_t>(k)]); }, verts);
+            }
+        }
+
+        return true;
+    }
+
+    bool isSpace(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    /// Parse the next whitespace-separated number; false at the end of input or on garbage.
+    bool nextNumber(const char*& p, const char* end, double& out) noexcept
+    {
+        while (p < end && isSpace(*p))
+            ++p;
+
+        if (p < end && *p == '+')
+            ++p;
+
+        const auto r = std::from_chars(p, end, out);
+        if (r.ec != std::errc{})
+            return false;
+
+        p = r.ptr;
+        return true;
+    }
+
+    /// ASCII body. Vertices without lists are one record per line: the lines are
+    /// located with a memchr scan and parsed in parallel jobs. Everything else
+    /// goes through a sequential token reader.
+    /// Only @p vertexElem is decoded into @p verts (sized for it by the caller).
+    bool readAsciiBody(std::span<const uint8_t> file,
+                       const PlyHeader&         h,
+                       const PlyElement*        vertexElem,
+                       const PlyVertexLayout&   layout,
+                       PlyVertices&             verts,
+                       PlyFaces&                faces,
+                       std::string&             why)
+    {
+        const char* p   = reinterpret_cast<const char*>(file.data()) + h.dataOffset;
+        const char* end = reinterpret_cast<const char*>(file.data()) + file.size();
+
+        std::vector<double>      values;
+        std::vector<const char*> lines;
+
+        for (const PlyElement& e : h.elements)
+        {
+            const bool isVertex = &e == vertexElem;
+            const bool isFace   = e.name == "face";
+            const int  faceList = isFace ? faceListProperty(e) : -1;
+
+            if (isVertex && e.stride != 0)
+            {
+                lines.clear();
+                lines.reserve(e.count + 1);
+
+                while (lines.size() < e.count)
+                {
+                    while (p < end && isSpace(*p))
+                        ++p;
+                    if (p >= end)
+                    {
+                        why = "file ends inside the vertex list";
+                        return false;
+                    }
+
+                    lines.push_back(p);
+                    const void* nl = std::memchr(p, '\n', static_cast<size_t>(end - p));
+                    p              = nl ? static_cast<const char*>(nl) + 1 : end;
+                }
+                lines.push_back(p);
+
+                const size_t          jobs = (e.count + kPlyRecordsPerJob - 1) / kPlyRecordsPerJob;
+                std::atomic<uint32_t> bad{0};
+
+                TaskPool::shared().parallelFor(static_cast<uint32_t>(jobs), [&](uint32_t j) {
+                    const size_t b = size_t(j) * kPlyRecordsPerJob;
+                    const size_t n = std::min(e.count, b + kPlyRecordsPerJob);
+
+                    std::vector<double> record(e.props.size());
+                    uint32_t            badHere = 0;
+
+                    for (size_t i = b; i < n; ++i)
+                    {
+                        const char* q       = lines[i];
+                        const char* lineEnd = lines[i + 1];
+
+                        bool ok = true;
+                        for (size_t k = 0; k < record.size() && ok; ++k)
+                            ok = nextNumber(q, lineEnd, record[k]);
+
+                        if (!ok)
+                        {
+                            ++badHere;
+                            std::fill(record.begin(), record.end(), 0.0);
+                        }
+
+                        storeVertex(layout, i, [&](int k) { return static_cast<float>(record[static_cast<size_t>(k)]); }, verts);
+                    }
+
+                    bad.fetch_add(badHere, std::memory_order_relaxed);
+                });
+
+                if (bad.load() != 0)
+                {
+                    why = std::to_string(bad.load()) + " malformed vertex line(s)";
+                    return false;
+                }
+                continue;
+            }
+
+            if (isFace)
+            {
+                faces.sizes.reserve(e.count);
+                faces.indices.reserve(e.count * 3);
+            }
+
+            values.resize(e.props.size());
+
+            for (size_t i = 0; i < e.count; ++i)
+            {
+                for (size_t k = 0; k < e.props.size(); ++k)
+                {
+                    const PlyProperty& prop = e.props[k];
+
+                    double v = 0.0;
+                    if (!nextNumber(p, end, v))
+                    {
+                        why = "malformed or truncated '" + e.name + "' record " + std::to_string(i);
+                        return false;
+                    }
+
+                    if (!prop.isList())
+                    {
+                        values[k] = v;
+                        continue;
+                    }
+
+                    if (v < 0.0)
+                    {
+                        why = "negative list length in '" + e.name + "' record " + std::to_string(i);
+                        return false;
+                    }
+
+                    const size_t n    = static_cast<size_t>(v);
+                    const bool   keep = static_cast<int>(k) == faceList;
+                    if (keep)
+                        faces.sizes.push_back(static_cast<uint32_t>(n));
+
+                    for (size_t c = 0; c < n; ++c)
+                    {
+                        double item = 0.0;
+                        if (!nextNumber(p, end, item))
+                        {
+                            why = "malformed or truncated '" + e.name + "' record " + std::to_string(i);
+                            return false;
+                        }
+                        if (keep)
+                            faces.indices.push_back(toIndex(item));
+                    }
+                }
+
+                if (isVertex)
+                    storeVertex(layout, i, [&](int k) { return static_cast<float>(values[static_cast<size_t>(k)]); }, verts);
+            }
+        }
+
+        return true;
+    }
+
+    template<typename T>
+    void storeLE(uint8_t* p, T v) noexcept
+    {
+        using Bits = std::conditional_t<sizeof(T) == 1, uint8_t,
+                                        std::conditional_t<sizeof(T) == 2, uint16_t, uint32_t>>;
+        Bits bits = std::bit_cast<Bits>(v);
+        if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1)
+            bits = std::byteswap(bits);
+        std::memcpy(p, &bits, sizeof(bits));
+    }
+
+    /// One scene mesh as written to the file.
+    struct PlySource
+    {
+        const SysMesh*       mesh       = nullptr;
+        glm::mat4            model      = glm::mat4(1.0f);
+        glm::mat3            normalMat  = glm::mat3(1.0f);
+        bool                 mirrored   = false; // Negative determinant: faces are written reversed.
+        int                  normalMap  = -1;
+        int                  colorMap   = -1;
+        size_t               vertBase   = 0;  // First file vertex.
+        size_t               faceBase   = 0;  // Byte offset of the first face in the face block.
+        std::vector<size_t>  polyOffset = {}; // Byte offset of each all_polys() entry, plus the end.
+        std::vector<int32_t> vertRemap  = {}; // Vertex slot -> file vertex, relative to vertBase.
+    };
+
+    /// Face records use a uchar count; bigger polygons are written as a triangle fan.
+    constexpr int kMaxPlyFaceVerts = 255;
+
+    size_t faceBytes(int n) noexcept
+    {
+        if (n < 3)
+            return 0;
+        if (n <= kMaxPlyFaceVerts)
+            return 1 + 4 * static_cast<size_t>(n);
+        return static_cast<size_t>(n - 2) * 13;
+    }
+
+    size_t faceRecords(int n) noexcept
+    {
+        if (n < 3)
+            return 0;
+        return n <= kMaxPlyFaceVerts ? 1 : static_cast<size_t>(n - 2);
+    }
+
+    /// Sum of the corner normals around @p v; polygons without map data add their face normal.
+    glm::vec3 gatherNormal(const SysMesh* mesh, int map, int32_t v)
+    {
+        glm::vec3 n{0.0f};
+
+        for (int32_t p : mesh->vert_polys(v))
+        {
+            const SysPolyVerts& pv = mesh->poly_verts(p);
+
+            if (map != -1 && mesh->map_poly_valid(map, p))
+            {
+                const SysPolyVerts& pn = mesh->map_poly_verts(map, p);
+                for (int k = 0; k < pv.size(); ++k)
+                {
+                    if (pv[k] == v)
+                    {
+                        n += glm::make_vec3(mesh->map_vert_position(map, pn[k]));
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                n += mesh->poly_normal(p);
+            }
+        }
+
+        return n;
+    }
+
+    /// Color of the first corner of @p v that has map data; white if none does.
+    glm::vec4 gatherColor(const SysMesh* mesh, int map, int32_t v)
+    {
+        if (map == -1)
+            return glm::vec4(1.0f);
+
+        const int dim = mesh->map_dim(map);
+
+        for (int32_t p : mesh->vert_polys(v))
+        {
+            if (!mesh->map_poly_valid(map, p))
+                continue;
+
+            const SysPolyVerts& pv = mesh->poly_verts(p);
+            const SysPolyVerts& pc = mesh->map_poly_verts(map, p);
+            for (int k = 0; k < pv.size(); ++k)
+            {
+                if (pv[k] == v)
+                {
+                    const float* c = mesh->map_vert_position(map, pc[k]);
+                    return glm::vec4(c[0], c[1], c[2], dim >= 4 ? c[3] : 1.0f);
+                }
+            }
+        }
+
+        return glm::vec4(1.0f);
+    }
+
+    uint8_t toUnorm8(float v) noexcept
+    {
+        return static_cast<uint8_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+} // namespace
+
+bool PlySceneFormat::load(Scene*                       scene,
+                          const std::filesystem::path& filePath,
+                          const LoadOptions&           options,
+                          SceneIOReport&               report)
+{
+    if (scene == nullptr)
+    {
+        report.error("SceneFormatPLY::load: scene is null");
+        report.status = SceneIOStatus::InvalidScene;
+        return false;
+    }
+
+    if (!std::filesystem::exists(filePath))
+    {
+        report.status = SceneIOStatus::FileNotFound;
+        report.error("File not found: " + filePath.string());
+        return false;
+    }
+
+    const MappedFile file(filePath);
+    if (!file.valid())
+    {
+        report.status = SceneIOStatus::ReadError;
+        report.error("Failed to map PLY file (missing or empty): " + filePath.string());
+        return false;
+    }
+
+    // ---------------------------------------------------------
+    // Header
+    // ---------------------------------------------------------
+    PlyHeader   header;
+    std::string why;
+    if (!parseHeader(file.bytes(), header, why))
+    {
+        report.status = SceneIOStatus::UnsupportedFormat;
+        report.error("PLY: " + why + ": " + filePath.string());
+        return false;
+    }
+
+    const auto vertexElem = std::find_if(header.elements.begin(), header.elements.end(), [](const PlyElement& e) {
+        return e.name == "vertex";
+    });
+
+    if (vertexElem == header.elements.end())
+    {
+        report.status = SceneIOStatus::UnsupportedFormat;
+        report.error("PLY: no vertex element: " + filePath.string());
+        return false;
+    }
+
+    const PlyVertexLayout layout = vertexLayout(*vertexElem);
+    if (layout.pos[0] < 0 || layout.pos[1] < 0 || layout.pos[2] < 0)
+    {
+        report.status = SceneIOStatus::UnsupportedFormat;
+        report.error("PLY: vertex element has no x/y/z properties: " + filePath.string());
+        return false;
+    }
+
+    if (vertexElem->count > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+    {
+        report.status = SceneIOStatus::ReadError;
+        report.error("PLY has more vertices than a mesh can index: " + filePath.string());
+        return false;
+    }
+
+    // The body is read before the scene is touched, so a corrupt file leaves it as it was.
+    PlyVertices verts;
+    PlyFaces    faces;
+    resizeVertices(verts, layout, vertexElem->count);
+
+    const bool bodyOk = header.encoding == PlyEncoding::Ascii
+                            ? readAsciiBody(file.bytes(), header, &*vertexElem, layout, verts, faces, why)
+                            : readBinaryBody(file.bytes(), header, &*vertexElem, layout, verts, faces, why);
+
+    if (!bodyOk)
+    {
+        report.status = SceneIOStatus::ParseError;
+        report.error("PLY: " + why + ": " + filePath.string());
+        return false;
+    }
+
+    if (!options.mergeIntoExisting)
+    {
+        scene->clear();
+    }
+
+    // ---------------------------------------------------------
+    // Build the mesh: vertices in file order with an exact
+    // reserve, then faces; map verts are unique per corner.
+    // ---------------------------------------------------------
+    SceneMesh* sceneMesh = scene->createSceneMesh(filePath.stem().string());
+    SysMesh*   mesh      = sceneMesh->sysMesh();
+
+    const size_t vertCount = verts.positions.size();
+    mesh->reserve(static_cast<int32_t>(vertCount));
+
+    std::vector<int32_t> vertIds(vertCount);
+    for (size_t i = 0; i < vertCount; ++i)
+        vertIds[i] = mesh->create_vert(verts.positions[i]);
+
+    const int normMap  = layout.hasNormals ? mesh->map_create(/*MESH_MAP_NORMALS*/ 0, 0, 3) : -1;
+    const int texMap   = layout.hasUVs ? mesh->map_create(/*MESH_MAP_UV0*/ 1, 0, 2) : -1;
+    const int colorMap = layout.hasColors ? mesh->map_create(kColorMapId, 0, 4) : -1;
+
+    uint32_t skipped = 0;
+    size_t   corner  = 0;
+
+    for (const uint32_t n : faces.sizes)
+    {
+        const uint32_t* idx = faces.indices.data() + corner;
+        corner += n;
+
+        bool valid = n >= 3;
+        for (uint32_t k = 0; k < n && valid; ++k)
+        {
+            valid = idx[k] < vertCount;
+            for (uint32_t j = 0; j < k && valid; ++j)
+                valid = idx[j] != idx[k];
+        }
+
+        if (!valid)
+        {
+            ++skipped;
+            continue;
+        }
+
+        SysPolyVerts pv;
+        for (uint32_t k = 0; k < n; ++k)
+            pv.push_back(vertIds[idx[k]]);
+
+        const int poly = mesh->create_poly(pv, 0);
+        if (poly < 0)
+            continue;
+
+        auto addMap = [&](int map, auto value) {
+            if (map == -1)
+                return;
+
+            SysPolyVerts pm;
+            for (uint32_t k = 0; k < n; ++k)
+                pm.push_back(mesh->map_create_vert(map, glm::value_ptr(value(idx[k]))));
+            mesh->map_create_poly(map, poly, pm);
+        };
+
+        addMap(normMap, [&](uint32_t v) -> const glm::vec3& { return verts.normals[v]; });
+        addMap(texMap, [&](uint32_t v) -> const glm::vec2& { return verts.uvs[v]; });
+        addMap(colorMap, [&](uint32_t v) -> const glm::vec4& { return verts.colors[v]; });
+    }
+
+    if (skipped > 0)
+        report.warning("PLY: skipped " + std::to_string(skipped) + " face(s) with fewer than 3 distinct, valid vertex indices");
+
+    if (faces.sizes.empty())
+        report.info("PLY: no faces, imported " + std::to_string(vertCount) + " vertices as a point cloud");
+
+    return true;
+}
+
+bool PlySceneFormat::save(const Scene*                 scene,
+                          const std::filesystem::path& filePath,
+                          const SaveOptions&           options,
+                          SceneIOReport&               report)
+{
+    (void)options;
+
+    if (scene == nullptr)
+    {
+        report.error("SceneFormatPLY::save: scene is null");
+        report.status = SceneIOStatus::InvalidScene;
+        return false;
+    }
+
+    // ---------------------------------------------------------------------
+    // Lay out the file: one vertex block, one face block. Byte offsets are
+    // fixed up front so both blocks can be encoded in parallel jobs.
+    // ---------------------------------------------------------------------
+    std::vector<PlySource> sources;
+
+    bool   hasNormals = false;
+    bool   hasColors  = false;
+    size_t vertCount  = 0;
+    size_t faceCount  = 0;
+    size_t faceBlock  = 0;
+
+    for (const SceneMesh* sm : scene->sceneMeshes())
+    {
+        if (!sm || !sm->sysMesh() || sm->sysMesh()->num_verts() == 0)
+            continue;
+
+        PlySource src;
+        src.mesh      = sm->sysMesh();
+        src.model     = sm->model();
+        src.normalMat = glm::transpose(glm::inverse(glm::mat3(src.model)));
+        src.mirrored  = glm::determinant(glm::mat3(src.model)) < 0.0f;
+        src.normalMap = src.mesh->map_find(/*MESH_MAP_NORMALS*/ 0);
+        src.colorMap  = src.mesh->map_find(kColorMapId);
+        src.vertBase  = vertCount;
+        src.faceBase  = faceBlock;
+
+        if (src.normalMap != -1 && src.mesh->map_buffer_size(src.normalMap) == 0)
+            src.normalMap = -1;
+        if (src.colorMap != -1 && (src.mesh->map_dim(src.colorMap) < 3 || src.mesh->map_buffer_size(src.colorMap) == 0))
+            src.colorMap = -1;
+
+        hasNormals |= src.normalMap != -1;
+        hasColors |= src.colorMap != -1;
+
+        const std::vector<int32_t>& vAll = src.mesh->all_verts();
+        src.vertRemap.assign(static_cast<size_t>(src.mesh->vert_buffer_size()), 0);
+        for (size_t i = 0; i < vAll.size(); ++i)
+            src.vertRemap[static_cast<size_t>(vAll[i])] = static_cast<int32_t>(i);
+
+        const std::vector<int32_t>& pAll = src.mesh->all_polys();
+        src.polyOffset.resize(pAll.size() + 1);
+
+        size_t offset = 0;
+        for (size_t i = 0; i < pAll.size(); ++i)
+        {
+            const int n       = src.mesh->poly_verts(pAll[i]).size();
+            src.polyOffset[i] = offset;
+            offset += faceBytes(n);
+            faceCount += faceRecords(n);
+        }
+        src.polyOffset.back() = offset;
+
+        vertCount += vAll.size();
+        faceBlock += offset;
+        sources.push_back(std::move(src));
+    }
+
+    if (vertCount > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+    {
+        report.error("SceneFormatPLY::save: too many vertices for 32-bit face indices");
+        report.status = SceneIOStatus::WriteError;
+        return false;
+    }
+
+    const size_t stride    = 12 + (hasNormals ? 12 : 0) + (hasColors ? 4 : 0);
+    const size_t vertBlock = vertCount * stride;
+
+    std::vector<uint8_t> body(vertBlock + faceBlock);
+
+    for (const PlySource& src : sources)
+    {
+        const SysMesh*              mesh = src.mesh;
+        const std::vector<int32_t>& vAll = mesh->all_verts();
+        const std::vector<int32_t>& pAll = mesh->all_polys();
+
+        const size_t vertJobs = (vAll.size() + kPlyRecordsPerJob - 1) / kPlyRecordsPerJob;
+        TaskPool::shared().parallelFor(static_cast<uint32_t>(vertJobs), [&](uint32_t j) {
+            const size_t b = size_t(j) * kPlyRecordsPerJob;
+            const size_t e = std::min(vAll.size(), b + kPlyRecordsPerJob);
+
+            for (size_t i = b; i < e; ++i)
+            {
+                const int32_t v   = vAll[i];
+                uint8_t*      out = body.data() + (src.vertBase + i) * stride;
+
+                const glm::vec3 p = glm::vec3(src.model * glm::vec4(mesh->vert_position(v), 1.0f));
+                storeLE(out + 0, p.x);
+                storeLE(out + 4, p.y);
+                storeLE(out + 8, p.z);
+                out += 12;
+
+                if (hasNormals)
+                {
+                    glm::vec3 n = src.normalMat * gatherNormal(mesh, src.normalMap, v);
+
+                    const float len = glm::length(n);
+                    n               = len > 0.0f ? n / len : glm::vec3(0.0f, 0.0f, 1.0f);
+
+                    storeLE(out + 0, n.x);
+                    storeLE(out + 4, n.y);
+                    storeLE(out + 8, n.z);
+                    out += 12;
+                }
+
+                if (hasColors)
+                {
+                    const glm::vec4 c = gatherColor(mesh, src.colorMap, v);
+                    out[0]            = toUnorm8(c.r);
+                    out[1]            = toUnorm8(c.g);
+                    out[2]            = toUnorm8(c.b);
+                    out[3]            = toUnorm8(c.a);
+                }
+            }
+        });
+
+        const size_t faceJobs = (pAll.size() + kPlyRecordsPerJob - 1) / kPlyRecordsPerJob;
+        TaskPool::shared().parallelFor(static_cast<uint32_t>(faceJobs), [&](uint32_t j) {
+            const size_t b = size_t(j) * kPlyRecordsPerJob;
+            const size_t e = std::min(pAll.size(), b + kPlyRecordsPerJob);
+
+            for (size_t i = b; i < e; ++i)
+            {
+                const SysPolyVerts& pv  = mesh->poly_verts(pAll[i]);
+                const int           n   = pv.size();
+                uint8_t*            out = body.data() + vertBlock + src.faceBase + src.polyOffset[i];
+
+                auto index = [&](int k) {
+                    const int corner = src.mirrored ? (n - k) % n : k;
+                    return static_cast<int32_t>(src.vertBase) + src.vertRemap[static_cast<size_t>(pv[corner])];
+                };
+
+                if (n < 3)
+                    continue;
+
+                if (n <= kMaxPlyFaceVerts)
+                {
+                    *out++ = static_cast<uint8_t>(n);
+                    for (int k = 0; k < n; ++k, out += 4)
+                        storeLE(out, index(k));
+                    continue;
+                }
+
+                for (int k = 1; k + 1 < n; ++k, out += 13)
+                {
+                    out[0] = 3;
+                    storeLE(out + 1, index(0));
+                    storeLE(out + 5, index(k));
+                    storeLE(out + 9, index(k + 1));
+                }
+            }
+        });
+    }
+
+    // ---------------------------------------------------------------------
+    // Header + body
+    // ---------------------------------------------------------------------
+    std::string head = "ply\nformat binary_little_endian 1.0\n";
+    head += "element vertex " + std::to_string(vertCount) + "\n";
+    head += "property float x\nproperty float y\nproperty float z\n";
+    if (hasNormals)
+        head += "property float nx\nproperty float ny\nproperty float nz\n";
+    if (hasColors)
+        head += "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n";
+    head += "element face " + std::to_string(faceCount) + "\n";
+    head += "property list uchar int vertex_indices\n";
+    head += "end_header\n";
+
+    std::ofstream out(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        report.error("SceneFormatPLY::save: failed to open PLY file for writing: " + filePath.string());
+        report.status = SceneIOStatus::WriteError;
+        return false;
+    }
+
+    out.write(head.data(), static_cast<std::streamsize>(head.size()));
+    out.write(reinterpret_cast<const char*>(body.data()), static_cast<std::streamsize>(body.size()));
+
+    out.close();
+    if (!out)
+    {
+        report.error("SceneFormatPLY::save: write error while closing PLY file");
+        report.status = SceneIOStatus::WriteError;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "SceneFormat.hpp"
+
+/**
+ * @brief Stanford PLY scene format loader/saver.
+ *
+ * Loads ASCII and binary (little/big endian) files: positions, optional
+ * per-vertex normals, colors (map id 2, RGBA) and texture coordinates, and
+ * polygon faces. A file without faces comes in as a point cloud.
+ *
+ * Saves every scene mesh, baked to world space, into one binary little
+ * endian file; normals and colors are written when any mesh carries them.
+ */
+class PlySceneFormat : public SceneFormat
+{
+public:
+    PlySceneFormat()           = default;
+    ~PlySceneFormat() override = default;
+
+    [[nodiscard]] std::string_view formatName() const noexcept override
+    {
+        return "Stanford PLY";
+    }
+
+    [[nodiscard]] std::string_view extension() const noexcept override
+    {
+        return ".ply";
+    }
+
+    bool load(Scene*                       scene,
+              const std::filesystem::path& filePath,
+              const LoadOptions&           options,
+              SceneIOReport&               report) override;
+
+    bool save(const Scene*                 scene,
+              const std::filesystem::path& filePath,
+              const SaveOptions&           options,
+              SceneIOReport&               report) override;
+};
@@ -1,9 +1,62 @@
 #pragma once
 
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <glm/vec3.hpp>
 #include <iostream>
 
 #include "SceneFormat.hpp"
 
+/// Append @p src's messages to @p dst; the first non-Ok status wins.
+inline void appendSceneIOReport(SceneIOReport& dst, const SceneIOReport& src)
+{
+    dst.messages.insert(dst.messages.end(), src.messages.begin(), src.messages.end());
+    if (dst.status == SceneIOStatus::Ok)
+        dst.status = src.status;
+}
+
+// ------------------------------------------------------------
+// Vertex welding keys (LoadOptions::weldVertices)
+//
+// Positions are keyed by their bit pattern, or snapped to a grid of
+// LoadOptions::weldEpsilon. Grid snapping is a hash, not a distance
+// query: two points closer than epsilon can still land in neighbouring
+// cells.
+// ------------------------------------------------------------
+struct WeldKey
+{
+    int64_t x = 0;
+    int64_t y = 0;
+    int64_t z = 0;
+
+    bool operator==(const WeldKey&) const = default;
+};
+
+struct WeldKeyHash
+{
+    size_t operator()(const WeldKey& k) const noexcept
+    {
+        uint64_t h = uint64_t(k.x) * 0x9E3779B97F4A7C15ull;
+        h ^= uint64_t(k.y) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+        h ^= uint64_t(k.z) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+        return static_cast<size_t>(h);
+    }
+};
+
+inline WeldKey weldKey(const glm::vec3& p, float epsilon) noexcept
+{
+    if (epsilon > 0.0f)
+    {
+        const double inv = 1.0 / double(epsilon);
+        return {std::llround(double(p.x) * inv), std::llround(double(p.y) * inv), std::llround(double(p.z) * inv)};
+    }
+
+    // -0 and +0 are the same point.
+    const auto bits = [](float f) { return int64_t(std::bit_cast<uint32_t>(f == 0.0f ? 0.0f : f)); };
+    return {bits(p.x), bits(p.y), bits(p.z)};
+}
+
 inline void dumpSceneIOReport(const SceneIOReport& report)
 {
     for (const SceneIOMessage& m : report.messages)
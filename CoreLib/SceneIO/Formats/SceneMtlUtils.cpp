@@ -176,7 +176,7 @@ ImageId ensureImageForMap(Scene*                       scene,
     // to match typical UV conventions (same as other imports).
     //
     // ImageHandler already normalizes the path via PathUtil internally.
-    const ImageId id = imgHandler->loadFromFile(absPath, /*flipY*/ true);
+    const ImageId id = imgHandler->loadFromFileAsync(absPath, /*flipY*/ true);
     return id;
 }
 
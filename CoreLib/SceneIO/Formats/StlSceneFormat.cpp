@@ -0,0 +1,533 @@
+#include "StlSceneFormat.hpp"
+
+#include <SysMesh.hpp>
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MappedFile.hpp"
+#include "Scene.hpp"
+#include "SceneIOUtils.hpp"
+#include "SceneMesh.hpp"
+#include "TaskPool.hpp"
+
+namespace
+{
+    constexpr size_t kStlHeaderBytes   = 80;
+    constexpr size_t kStlPrefixBytes   = kStlHeaderBytes + 4; // Header + triangle count.
+    constexpr size_t kStlTriangleBytes = 50;                  // Normal, 3 corners, attribute word.
+
+    /// Triangles (or corners, for welding) handled by one parallel job.
+    constexpr size_t kStlRecordsPerJob = 16384;
+
+    /// Weld buckets: a power of two, well above the worker count.
+    constexpr uint32_t kWeldBucketBits = 8;
+    constexpr uint32_t kWeldBuckets    = 1u << kWeldBucketBits;
+    constexpr uint32_t kWeldEmpty      = std::numeric_limits<uint32_t>::max();
+
+    uint32_t loadU32(const uint8_t* p) noexcept
+    {
+        uint32_t v = 0;
+        std::memcpy(&v, p, sizeof(v));
+        if constexpr (std::endian::native == std::endian::big)
+            v = std::byteswap(v);
+        return v;
+    }
+
+    float loadF32(const uint8_t* p) noexcept
+    {
+        return std::bit_cast<float>(loadU32(p));
+    }
+
+    void storeU32(uint8_t* p, uint32_t v) noexcept
+    {
+        if constexpr (std::endian::native == std::endian::big)
+            v = std::byteswap(v);
+        std::memcpy(p, &v, sizeof(v));
+    }
+
+    void storeVec3(uint8_t* p, const glm::vec3& v) noexcept
+    {
+        storeU32(p + 0, std::bit_cast<uint32_t>(v.x));
+        storeU32(p + 4, std::bit_cast<uint32_t>(v.y));
+        storeU32(p + 8, std::bit_cast<uint32_t>(v.z));
+    }
+
+    /// WeldKeyHash with a final avalanche: the bucket uses the top bits and
+    /// the probe the low ones, and quantized inputs leave the raw low bits zero.
+    uint32_t weldHash(const WeldKey& key) noexcept
+    {
+        uint64_t h = WeldKeyHash{}(key);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        return static_cast<uint32_t>(h);
+    }
+
+    /**
+     * @brief Weld triangle-soup corners into shared vertices.
+     *
+     * Corners are hashed and scattered into buckets in parallel (a counting
+     * sort that keeps file order inside each bucket). Buckets are welded
+     * independently with an open-addressing table, and a serial pass numbers
+     * the vertices. Numbering is by first use, same as a serial hash-map weld.
+     *
+     * @return Corner -> vertex; @p unique receives the vertex positions.
+     */
+    std::vector<uint32_t> weldCorners(const std::vector<glm::vec3>& corners, float epsilon, std::vector<glm::vec3>& unique)
+    {
+        const size_t   count = corners.size();
+        const uint32_t jobs  = static_cast<uint32_t>((count + kStlRecordsPerJob - 1) / kStlRecordsPerJob);
+
+        auto jobRange = [count](uint32_t j) {
+            const size_t b = size_t(j) * kStlRecordsPerJob;
+            return std::pair{b, std::min(count, b + kStlRecordsPerJob)};
+        };
+
+        // Hash every corner and count it into its job's bucket histogram.
+        std::vector<uint32_t> hashes(count);
+        std::vector<uint32_t> cursor(size_t(jobs) * kWeldBuckets, 0);
+
+        TaskPool::shared().parallelFor(jobs, [&](uint32_t j) {
+            const auto [b, e] = jobRange(j);
+            uint32_t* hist    = cursor.data() + size_t(j) * kWeldBuckets;
+
+            for (size_t i = b; i < e; ++i)
+            {
+                hashes[i] = weldHash(weldKey(corners[i], epsilon));
+                ++hist[hashes[i] >> (32 - kWeldBucketBits)];
+            }
+        });
+
+        // Bucket-major prefix sum; each job's counts become its write cursors.
+        std::vector<uint32_t> bucketBegin(kWeldBuckets + 1);
+
+        uint32_t total = 0;
+        for (uint32_t bucket = 0; bucket < kWeldBuckets; ++bucket)
+        {
+            bucketBegin[bucket] = total;
+            for (uint32_t j = 0; j < jobs; ++j)
+            {
+                uint32_t&      c = cursor[size_t(j) * kWeldBuckets + bucket];
+                const uint32_t n = c;
+
+                c = total;
+                total += n;
+            }
+        }
+        bucketBegin[kWeldBuckets] = total;
+
+        std::vector<uint32_t> order(count);
+        TaskPool::shared().parallelFor(jobs, [&](uint32_t j) {
+            const auto [b, e] = jobRange(j);
+            uint32_t* pos     = cursor.data() + size_t(j) * kWeldBuckets;
+
+            for (size_t i = b; i < e; ++i)
+                order[pos[hashes[i] >> (32 - kWeldBucketBits)]++] = static_cast<uint32_t>(i);
+        });
+
+        // Weld each bucket; a corner's representative is the first corner with its key.
+        std::vector<uint32_t> rep(count);
+        TaskPool::shared().parallelFor(kWeldBuckets, [&](uint32_t bucket) {
+            const uint32_t first = bucketBegin[bucket];
+            const uint32_t n     = bucketBegin[bucket + 1] - first;
+            if (n == 0)
+                return;
+
+            const uint32_t        mask = std::bit_ceil(n * 2u) - 1u;
+            std::vector<uint32_t> table(size_t(mask) + 1, kWeldEmpty);
+
+            for (uint32_t k = 0; k < n; ++k)
+            {
+                const uint32_t c   = order[first + k];
+                const WeldKey  key = weldKey(corners[c], epsilon);
+
+                for (uint32_t slot = hashes[c] & mask;; slot = (slot + 1) & mask)
+                {
+                    const uint32_t t = table[slot];
+                    if (t == kWeldEmpty)
+                    {
+                        table[slot] = c;
+                        rep[c]      = c;
+                        break;
+                    }
+
+                    if (hashes[t] == hashes[c] && weldKey(corners[t], epsilon) == key)
+                    {
+                        rep[c] = t;
+                        break;
+                    }
+                }
+            }
+        });
+
+        // Representatives precede their duplicates, so one forward pass numbers by first use.
+        std::vector<uint32_t> vert(count);
+        unique.clear();
+        for (size_t c = 0; c < count; ++c)
+        {
+            if (rep[c] == c)
+            {
+                vert[c] = static_cast<uint32_t>(unique.size());
+                unique.push_back(corners[c]);
+            }
+            else
+            {
+                vert[c] = vert[rep[c]];
+            }
+        }
+
+        return vert;
+    }
+
+    bool isSpace(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    std::string_view nextWord(const char*& p, const char* end) noexcept
+    {
+        while (p < end && isSpace(*p))
+            ++p;
+
+        const char* b = p;
+        while (p < end && !isSpace(*p))
+            ++p;
+
+        return {b, static_cast<size_t>(p - b)};
+    }
+
+    /// ASCII STL: only "solid <name>" and the "vertex x y z" lines matter.
+    bool parseAscii(std::span<const uint8_t> file, std::vector<glm::vec3>& corners, std::string& name, std::string& why)
+    {
+        const char* p   = reinterpret_cast<const char*>(file.data());
+        const char* end = p + file.size();
+
+        if (nextWord(p, end) == "solid")
+        {
+            const char* eol = std::find(p, end, '\n');
+            name            = std::string(p, eol);
+
+            const auto trimmed = [](char c) { return isSpace(c); };
+            name.erase(name.begin(), std::find_if_not(name.begin(), name.end(), trimmed));
+            name.erase(std::find_if_not(name.rbegin(), name.rend(), trimmed).base(), name.end());
+            p = eol;
+        }
+
+        for (std::string_view word = nextWord(p, end); !word.empty(); word = nextWord(p, end))
+        {
+            if (word != "vertex")
+                continue;
+
+            glm::vec3 v{0.0f};
+            for (int k = 0; k < 3; ++k)
+            {
+                const std::string_view num = nextWord(p, end);
+                const char*            b   = num.data() + (num.starts_with('+') ? 1 : 0);
+
+                if (std::from_chars(b, num.data() + num.size(), v[k]).ec != std::errc{})
+                {
+                    why = "malformed vertex '" + std::string(num) + "'";
+                    return false;
+                }
+            }
+            corners.push_back(v);
+        }
+
+        if (corners.size() % 3 != 0)
+        {
+            why = "vertex count is not a multiple of 3";
+            return false;
+        }
+
+        return true;
+    }
+
+    /// Binary STL: fixed 50-byte records, decoded in parallel jobs.
+    void decodeBinary(std::span<const uint8_t> file, size_t triangles, std::vector<glm::vec3>& corners)
+    {
+        corners.resize(triangles * 3);
+
+        const size_t jobs = (triangles + kStlRecordsPerJob - 1) / kStlRecordsPerJob;
+        TaskPool::shared().parallelFor(static_cast<uint32_t>(jobs), [&](uint32_t j) {
+            const size_t b = size_t(j) * kStlRecordsPerJob;
+            const size_t e = std::min(triangles, b + kStlRecordsPerJob);
+
+            for (size_t t = b; t < e; ++t)
+            {
+                const uint8_t* rec = file.data() + kStlPrefixBytes + t * kStlTriangleBytes + 12; // Skip the facet normal.
+                for (size_t k = 0; k < 3; ++k, rec += 12)
+                    corners[t * 3 + k] = glm::vec3(loadF32(rec), loadF32(rec + 4), loadF32(rec + 8));
+            }
+        });
+    }
+
+    /// One scene mesh as written to the file.
+    struct StlSource
+    {
+        const SysMesh*      mesh      = nullptr;
+        glm::mat4           model     = glm::mat4(1.0f);
+        bool                mirrored  = false; // Negative determinant: swap winding to keep facets outward.
+        size_t              triBase   = 0;     // First triangle of this mesh.
+        std::vector<size_t> polyFirst = {};    // First triangle of each all_polys() entry, relative to triBase.
+    };
+
+} // namespace
+
+bool StlSceneFormat::load(Scene*                       scene,
+                          const std::filesystem::path& filePath,
+                          const LoadOptions&           options,
+                          SceneIOReport&               report)
+{
+    if (scene == nullptr)
+    {
+        report.error("SceneFormatSTL::load: scene is null");
+        report.status = SceneIOStatus::InvalidScene;
+        return false;
+    }
+
+    if (!std::filesystem::exists(filePath))
+    {
+        report.status = SceneIOStatus::FileNotFound;
+        report.error("File not found: " + filePath.string());
+        return false;
+    }
+
+    const MappedFile file(filePath);
+    if (!file.valid())
+    {
+        report.status = SceneIOStatus::ReadError;
+        report.error("Failed to map STL file (missing or empty): " + filePath.string());
+        return false;
+    }
+
+    // ---------------------------------------------------------
+    // Binary or ASCII: binary files may also start with "solid",
+    // so an exact size match wins over the keyword.
+    // ---------------------------------------------------------
+    const std::span<const uint8_t> bytes = file.bytes();
+
+    const uint64_t triangles = bytes.size() >= kStlPrefixBytes ? loadU32(bytes.data() + kStlHeaderBytes) : 0;
+    const uint64_t expected  = kStlPrefixBytes + triangles * kStlTriangleBytes;
+
+    const char* text  = reinterpret_cast<const char*>(bytes.data());
+    const char* end   = text + bytes.size();
+    const bool  solid = nextWord(text, end) == "solid";
+
+    const bool binary = bytes.size() >= kStlPrefixBytes && (expected == bytes.size() || !solid);
+
+    std::vector<glm::vec3> corners;
+    std::string            name;
+    std::string            why;
+
+    if (binary)
+    {
+        if (expected > bytes.size())
+        {
+            report.status = SceneIOStatus::ParseError;
+            report.error("STL: file is truncated (" + std::to_string(triangles) + " triangles declared): " + filePath.string());
+            return false;
+        }
+
+        if (expected < bytes.size())
+            report.warning("STL: ignoring " + std::to_string(bytes.size() - expected) + " trailing byte(s)");
+
+        decodeBinary(bytes, static_cast<size_t>(triangles), corners);
+    }
+    else if (!parseAscii(bytes, corners, name, why))
+    {
+        report.status = SceneIOStatus::ParseError;
+        report.error("STL: " + why + ": " + filePath.string());
+        return false;
+    }
+
+    if (corners.size() >= kWeldEmpty)
+    {
+        report.status = SceneIOStatus::ReadError;
+        report.error("STL has more triangles than a mesh can index: " + filePath.string());
+        return false;
+    }
+
+    // ---------------------------------------------------------
+    // Weld, then build the mesh with an exact reserve. Always on:
+    // an unwelded soup has no connectivity for any tool to work with.
+    // Triangles collapsed by the weld are dropped.
+    // ---------------------------------------------------------
+    std::vector<glm::vec3>      positions;
+    const std::vector<uint32_t> cornerVert = weldCorners(corners, options.weldEpsilon, positions);
+
+    if (positions.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+    {
+        report.status = SceneIOStatus::ReadError;
+        report.error("STL has more vertices than a mesh can index: " + filePath.string());
+        return false;
+    }
+
+    if (!options.mergeIntoExisting)
+    {
+        scene->clear();
+    }
+
+    SceneMesh* sceneMesh = scene->createSceneMesh(name.empty() ? filePath.stem().string() : name);
+    SysMesh*   mesh      = sceneMesh->sysMesh();
+
+    mesh->reserve(static_cast<int32_t>(positions.size()));
+
+    std::vector<int32_t> vertIds(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i)
+        vertIds[i] = mesh->create_vert(positions[i]);
+
+    uint32_t collapsed = 0;
+    for (size_t c = 0; c + 2 < cornerVert.size(); c += 3)
+    {
+        const uint32_t a = cornerVert[c];
+        const uint32_t b = cornerVert[c + 1];
+        const uint32_t d = cornerVert[c + 2];
+
+        if (a == b || b == d || a == d)
+        {
+            ++collapsed;
+            continue;
+        }
+
+        SysPolyVerts pv;
+        pv.push_back(vertIds[a]);
+        pv.push_back(vertIds[b]);
+        pv.push_back(vertIds[d]);
+        mesh->create_poly(pv, 0);
+    }
+
+    if (collapsed > 0)
+        report.warning("STL: skipped " + std::to_string(collapsed) + " degenerate triangle(s)");
+
+    report.info("STL: welded " + std::to_string(cornerVert.size()) + " corners into " + std::to_string(positions.size()) + " vertices");
+
+    return true;
+}
+
+bool StlSceneFormat::save(const Scene*                 scene,
+                          const std::filesystem::path& filePath,
+                          const SaveOptions&           options,
+                          SceneIOReport&               report)
+{
+    (void)options;
+
+    if (scene == nullptr)
+    {
+        report.error("SceneFormatSTL::save: scene is null");
+        report.status = SceneIOStatus::InvalidScene;
+        return false;
+    }
+
+    // ---------------------------------------------------------------------
+    // Triangle offsets per polygon (fan triangulation), so the records
+    // can be encoded in parallel jobs straight into the output buffer.
+    // ---------------------------------------------------------------------
+    std::vector<StlSource> sources;
+    size_t                 triCount = 0;
+
+    for (const SceneMesh* sm : scene->sceneMeshes())
+    {
+        if (!sm || !sm->sysMesh())
+            continue;
+
+        StlSource src;
+        src.mesh     = sm->sysMesh();
+        src.model    = sm->model();
+        src.mirrored = glm::determinant(glm::mat3(src.model)) < 0.0f;
+        src.triBase  = triCount;
+
+        const std::vector<int32_t>& pAll = src.mesh->all_polys();
+        src.polyFirst.resize(pAll.size());
+
+        size_t tris = 0;
+        for (size_t i = 0; i < pAll.size(); ++i)
+        {
+            src.polyFirst[i] = tris;
+            tris += static_cast<size_t>(std::max(src.mesh->poly_verts(pAll[i]).size() - 2, 0));
+        }
+
+        triCount += tris;
+        sources.push_back(std::move(src));
+    }
+
+    if (triCount > std::numeric_limits<uint32_t>::max())
+    {
+        report.error("SceneFormatSTL::save: too many triangles for a binary STL file");
+        report.status = SceneIOStatus::WriteError;
+        return false;
+    }
+
+    std::vector<uint8_t> data(kStlPrefixBytes + triCount * kStlTriangleBytes, 0);
+
+    // Must not start with "solid", or readers may take the file for ASCII.
+    constexpr std::string_view kHeaderText = "IMP3D binary STL";
+    std::memcpy(data.data(), kHeaderText.data(), kHeaderText.size());
+    storeU32(data.data() + kStlHeaderBytes, static_cast<uint32_t>(triCount));
+
+    for (const StlSource& src : sources)
+    {
+        const SysMesh*              mesh = src.mesh;
+        const std::vector<int32_t>& pAll = mesh->all_polys();
+
+        const size_t jobs = (pAll.size() + kStlRecordsPerJob - 1) / kStlRecordsPerJob;
+        TaskPool::shared().parallelFor(static_cast<uint32_t>(jobs), [&](uint32_t j) {
+            const size_t b = size_t(j) * kStlRecordsPerJob;
+            const size_t e = std::min(pAll.size(), b + kStlRecordsPerJob);
+
+            for (size_t i = b; i < e; ++i)
+            {
+                const SysPolyVerts& pv  = mesh->poly_verts(pAll[i]);
+                uint8_t*            out = data.data() + kStlPrefixBytes + (src.triBase + src.polyFirst[i]) * kStlTriangleBytes;
+
+                auto world = [&](int k) {
+                    return glm::vec3(src.model * glm::vec4(mesh->vert_position(pv[k]), 1.0f));
+                };
+
+                const glm::vec3 p0 = world(0);
+                for (int k = 1; k + 1 < pv.size(); ++k, out += kStlTriangleBytes)
+                {
+                    glm::vec3 p1 = world(k);
+                    glm::vec3 p2 = world(k + 1);
+                    if (src.mirrored)
+                        std::swap(p1, p2);
+
+                    const glm::vec3 n   = glm::cross(p1 - p0, p2 - p0);
+                    const float     len = glm::length(n);
+
+                    storeVec3(out + 0, len > 0.0f ? n / len : glm::vec3(0.0f));
+                    storeVec3(out + 12, p0);
+                    storeVec3(out + 24, p1);
+                    storeVec3(out + 36, p2);
+                }
+            }
+        });
+    }
+
+    std::ofstream out(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        report.error("SceneFormatSTL::save: failed to open STL file for writing: " + filePath.string());
+        report.status = SceneIOStatus::WriteError;
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+    out.close();
+    if (!out)
+    {
+        report.error("SceneFormatSTL::save: write error while closing STL file");
+        report.status = SceneIOStatus::WriteError;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "SceneFormat.hpp"
+
+/**
+ * @brief STL (stereolithography) scene format loader/saver.
+ *
+ * Loads binary and ASCII files. STL is a triangle soup with no vertex layout
+ * to preserve, so corners are always welded into shared vertices (grid size
+ * LoadOptions::weldEpsilon; weldVertices is ignored). Facet normals are
+ * ignored, SysMesh derives them from the geometry.
+ *
+ * Saves every scene mesh, baked to world space and fan-triangulated, into
+ * one binary file.
+ */
+class StlSceneFormat : public SceneFormat
+{
+public:
+    StlSceneFormat()           = default;
+    ~StlSceneFormat() override = default;
+
+    [[nodiscard]] std::string_view formatName() const noexcept override
+    {
+        return "STL";
+    }
+
+    [[nodiscard]] std::string_view extension() const noexcept override
+    {
+        return ".stl";
+    }
+
+    bool load(Scene*                       scene,
+              const std::filesystem::path& filePath,
+              const LoadOptions&           options,
+              SceneIOReport&               report) override;
+
+    bool save(const Scene*                 scene,
+              const std::filesystem::path& filePath,
+              const SaveOptions&           options,
+              SceneIOReport&               report) override;
+};
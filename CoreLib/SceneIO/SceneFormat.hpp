@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -96,8 +97,19 @@ struct SceneIOReport
  */
 struct LoadOptions
 {
-    bool mergeIntoExisting = false;
-    bool triangulate       = false;
+    bool  mergeIntoExisting = false;
+    bool  triangulate       = false;
+    bool  weldVertices      = false; ///< Merge coincident glTF vertices; seams move into the normal/UV maps. STL always welds.
+    float weldEpsilon       = 0.0f;  ///< Weld grid size; 0 = bit-exact positions only.
+};
+
+/**
+ * @brief Block compressor for native binary saves (SaveOptions::compressNative).
+ */
+enum class NativeCodec : uint8_t
+{
+    Lz4,  ///< Fast; level > 0 selects LZ4-HC.
+    Zstd, ///< Smaller; level 1..22, 0 = zstd default.
 };
 
 /**
@@ -105,9 +117,14 @@ struct LoadOptions
  */
 struct SaveOptions
 {
-    bool selectedOnly   = false;
-    bool compressNative = false;
-    bool triangulate    = false;
+    bool        selectedOnly   = false;
+    bool        compressNative = false;
+    bool        triangulate    = false;
+    bool        textNative     = false; ///< Native .imp as text instead of the binary container.
+    NativeCodec compressCodec  = NativeCodec::Lz4;
+    int         compressLevel  = 0;     ///< Codec-specific; 0 = codec default.
+    bool        gltfQuantize   = false; ///< glTF: KHR_mesh_quantization (16-bit positions/UVs, 8-bit normals).
+    bool        gltfMeshopt    = false; ///< glTF: EXT_meshopt_compression on vertex and index data.
 };
 
 /**
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @file ContentHash.hpp
+ * @brief Fast non-cryptographic content hashing (XXH64).
+ *
+ * Used to recognise identical payloads (images, cache blobs). Output matches
+ * the reference XXH64 for the same seed, so hashes are stable across builds
+ * and platforms (little-endian reads are assumed).
+ */
+namespace un
+{
+    namespace detail
+    {
+        constexpr uint64_t kXxPrime1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t kXxPrime2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t kXxPrime3 = 0x165667B19E3779F9ull;
+        constexpr uint64_t kXxPrime4 = 0x85EBCA77C2B2AE63ull;
+        constexpr uint64_t kXxPrime5 = 0x27D4EB2F165667C5ull;
+
+        inline uint64_t rotl64(uint64_t x, int r) noexcept
+        {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        inline uint64_t read64(const uint8_t* p) noexcept
+        {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline uint32_t read32(const uint8_t* p) noexcept
+        {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline uint64_t xxRound(uint64_t acc, uint64_t input) noexcept
+        {
+            acc += input * kXxPrime2;
+            acc = rotl64(acc, 31);
+            return acc * kXxPrime1;
+        }
+
+        inline uint64_t xxMerge(uint64_t acc, uint64_t val) noexcept
+        {
+            acc ^= xxRound(0, val);
+            return acc * kXxPrime1 + kXxPrime4;
+        }
+    } // namespace detail
+
+    /**
+     * @brief XXH64 of @p size bytes at @p data.
+     * @ingroup MathUtils
+     */
+    inline uint64_t xxh64(const void* data, std::size_t size, uint64_t seed = 0) noexcept
+    {
+        using namespace detail;
+
+        const uint8_t*       p   = static_cast<const uint8_t*>(data);
+        const uint8_t* const end = p + size;
+
+        uint64_t h = 0;
+
+        if (size >= 32)
+        {
+            const uint8_t* const limit = end - 32;
+
+            uint64_t v1 = seed + kXxPrime1 + kXxPrime2;
+            uint64_t v2 = seed + kXxPrime2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - kXxPrime1;
+
+            do
+            {
+                v1 = xxRound(v1, read64(p));
+                v2 = xxRound(v2, read64(p + 8));
+                v3 = xxRound(v3, read64(p + 16));
+                v4 = xxRound(v4, read64(p + 24));
+                p += 32;
+            } while (p <= limit);
+
+            h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+            h = xxMerge(h, v1);
+            h = xxMerge(h, v2);
+            h = xxMerge(h, v3);
+            h = xxMerge(h, v4);
+        }
+        else
+        {
+            h = seed + kXxPrime5;
+        }
+
+        h += static_cast<uint64_t>(size);
+
+        while (p + 8 <= end)
+        {
+            h ^= xxRound(0, read64(p));
+            h = rotl64(h, 27) * kXxPrime1 + kXxPrime4;
+            p += 8;
+        }
+
+        if (p + 4 <= end)
+        {
+            h ^= static_cast<uint64_t>(read32(p)) * kXxPrime1;
+            h = rotl64(h, 23) * kXxPrime2 + kXxPrime3;
+            p += 4;
+        }
+
+        while (p < end)
+        {
+            h ^= static_cast<uint64_t>(*p) * kXxPrime5;
+            h = rotl64(h, 11) * kXxPrime1;
+            ++p;
+        }
+
+        h ^= h >> 33;
+        h *= kXxPrime2;
+        h ^= h >> 29;
+        h *= kXxPrime3;
+        h ^= h >> 32;
+
+        return h;
+    }
+
+} // namespace un
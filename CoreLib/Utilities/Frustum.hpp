@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+
+/**
+ * @file Frustum.hpp
+ * @brief Axis-aligned bounds and view-frustum helpers used for render culling.
+ *
+ * Conventions match Viewport (Vulkan): clip-space depth is [0, w] (ZO).
+ * The projection Y-flip does not matter here since left/right and
+ * top/bottom planes are extracted in pairs.
+ */
+namespace un
+{
+    /**
+     * @brief Axis-aligned bounding box.
+     * @ingroup MathUtils
+     *
+     * A default-constructed box is empty (valid == false). Use expand() to grow it.
+     */
+    struct aabb
+    {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+        bool      valid = false;
+
+        /** @brief Grow the box to contain @p p. */
+        void expand(const glm::vec3& p) noexcept
+        {
+            if (!valid)
+            {
+                min   = p;
+                max   = p;
+                valid = true;
+                return;
+            }
+
+            min = glm::min(min, p);
+            max = glm::max(max, p);
+        }
+
+        [[nodiscard]] glm::vec3 center() const noexcept { return (min + max) * 0.5f; }
+        [[nodiscard]] glm::vec3 extent() const noexcept { return (max - min) * 0.5f; }
+    };
+
+    /**
+     * @brief Transform an AABB and return the AABB of the result.
+     *
+     * Uses the center/extent form (Arvo): the new extent is |M3x3| * extent.
+     * Exact for affine transforms, conservative for everything else.
+     *
+     * @param box Object-space bounds.
+     * @param m   Object-to-world transform.
+     * @return World-space bounds (invalid if @p box is invalid).
+     * @ingroup MathUtils
+     */
+    [[nodiscard]] inline aabb transform_aabb(const aabb& box, const glm::mat4& m) noexcept
+    {
+        if (!box.valid)
+            return {};
+
+        const glm::vec3 c = glm::vec3(m * glm::vec4(box.center(), 1.0f));
+        const glm::vec3 e = box.extent();
+
+        const glm::mat3 a = glm::mat3(m);
+        const glm::vec3 r = glm::abs(a[0]) * e.x + glm::abs(a[1]) * e.y + glm::abs(a[2]) * e.z;
+
+        aabb out  = {};
+        out.min   = c - r;
+        out.max   = c + r;
+        out.valid = true;
+        return out;
+    }
+
+    /**
+     * @brief Six clip planes of a view frustum in world space.
+     * @ingroup MathUtils
+     *
+     * Each plane is stored as (n.xyz, d) with the inside half-space being
+     * dot(n, p) + d >= 0. Planes are not normalized; the AABB test does not need it.
+     */
+    struct frustum
+    {
+        std::array<glm::vec4, 6> planes = {};
+    };
+
+    /**
+     * @brief Extract frustum planes from a view-projection matrix (Gribb/Hartmann).
+     *
+     * @param viewProj Projection * view, Vulkan ZO depth.
+     * @return World-space frustum.
+     * @ingroup MathUtils
+     */
+    [[nodiscard]] inline frustum make_frustum(const glm::mat4& viewProj) noexcept
+    {
+        // GLM is column-major: row i is (m[0][i], m[1][i], m[2][i], m[3][i]).
+        auto row = [&](int i) {
+            return glm::vec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+        };
+
+        const glm::vec4 r0 = row(0);
+        const glm::vec4 r1 = row(1);
+        const glm::vec4 r2 = row(2);
+        const glm::vec4 r3 = row(3);
+
+        frustum f   = {};
+        f.planes[0] = r3 + r0; // left
+        f.planes[1] = r3 - r0; // right
+        f.planes[2] = r3 + r1; // bottom
+        f.planes[3] = r3 - r1; // top
+        f.planes[4] = r2;      // near (ZO: 0 <= z)
+        f.planes[5] = r3 - r2; // far
+        return f;
+    }
+
+    /**
+     * @brief Conservative frustum vs AABB test.
+     *
+     * Tests the "positive vertex" of the box against each plane. May report
+     * boxes near frustum corners as visible, never culls a visible box.
+     *
+     * @return False only if the box is fully outside one of the planes.
+     * @ingroup MathUtils
+     */
+    [[nodiscard]] inline bool frustum_intersects(const frustum& f, const aabb& box) noexcept
+    {
+        if (!box.valid)
+            return false;
+
+        for (const glm::vec4& pl : f.planes)
+        {
+            const glm::vec3 p = glm::vec3(pl.x >= 0.0f ? box.max.x : box.min.x,
+                                          pl.y >= 0.0f ? box.max.y : box.min.y,
+                                          pl.z >= 0.0f ? box.max.z : box.min.z);
+
+            if (glm::dot(glm::vec3(pl), p) + pl.w < 0.0f)
+                return false;
+        }
+
+        return true;
+    }
+
+} // namespace un
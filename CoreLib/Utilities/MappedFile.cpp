@@ -0,0 +1,148 @@
+#include "MappedFile.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    open(path);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    close();
+
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+    m_file    = std::exchange(other.m_file, nullptr);
+    m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::filesystem::path& path)
+{
+    close();
+
+    HANDLE file = CreateFileW(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file    = file;
+    m_mapping = mapping;
+    m_data    = static_cast<const uint8_t*>(view);
+    m_size    = static_cast<std::size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::close() noexcept
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file)
+        CloseHandle(static_cast<HANDLE>(m_file));
+
+    m_data    = nullptr;
+    m_size    = 0;
+    m_mapping = nullptr;
+    m_file    = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::filesystem::path& path)
+{
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    struct stat st = {};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping keeps the file referenced; the descriptor is no longer needed.
+    ::close(fd);
+
+    if (view == MAP_FAILED)
+        return false;
+
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<std::size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::close() noexcept
+{
+    if (m_data)
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
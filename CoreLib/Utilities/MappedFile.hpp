@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Move-only RAII handle. An empty file or a failed open leaves the mapping
+ * invalid (data() == nullptr); callers fall back to their regular read path.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// Map @p path, replacing any current mapping. Returns valid().
+    bool open(const std::filesystem::path& path);
+    void close() noexcept;
+
+    [[nodiscard]] bool valid() const noexcept
+    {
+        return m_data != nullptr;
+    }
+
+    [[nodiscard]] const uint8_t* data() const noexcept
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] std::span<const uint8_t> bytes() const noexcept
+    {
+        return {m_data, m_size};
+    }
+
+private:
+    const uint8_t* m_data = nullptr;
+    std::size_t    m_size = 0;
+
+#ifdef _WIN32
+    void* m_file    = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
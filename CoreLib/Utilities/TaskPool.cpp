@@ -0,0 +1,177 @@
+#include "TaskPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <memory>
+
+TaskPool::TaskPool(uint32_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        const uint32_t hw = std::thread::hardware_concurrency();
+        threadCount       = std::max(1u, hw > 1 ? hw - 1 : 1u);
+    }
+
+    m_workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+        m_workers.emplace_back([this] { workerLoop(); });
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_queue.clear();
+    }
+
+    m_wake.notify_all();
+
+    for (std::thread& t : m_workers)
+    {
+        if (t.joinable())
+            t.join();
+    }
+}
+
+void TaskPool::submit(std::function<void()> task)
+{
+    if (!task)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop)
+            return;
+        m_queue.push_back(std::move(task));
+    }
+
+    m_wake.notify_one();
+}
+
+void TaskPool::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_queue.empty() && m_running == 0; });
+}
+
+void TaskPool::parallelFor(uint32_t count, const std::function<void(uint32_t)>& fn)
+{
+    if (count == 0 || !fn)
+        return;
+
+    if (count == 1)
+    {
+        fn(0);
+        return;
+    }
+
+    // Helpers may start after we returned (pool busy): they only touch the
+    // shared state, and find nothing left to claim.
+    struct State
+    {
+        std::atomic<uint32_t>                next   = 0;
+        std::atomic<bool>                    failed = false;
+        uint32_t                             done   = 0;
+        uint32_t                             count  = 0;
+        const std::function<void(uint32_t)>* fn     = nullptr;
+        std::exception_ptr                   error  = {}; // First item failure, guarded by mutex.
+        std::mutex                           mutex  = {};
+        std::condition_variable              cv     = {};
+    };
+
+    auto state   = std::make_shared<State>();
+    state->count = count;
+    state->fn    = &fn;
+
+    auto drain = [](State& s) {
+        uint32_t ran = 0;
+        for (uint32_t i = s.next++; i < s.count; i = s.next++)
+        {
+            // After a failure the remaining items are only counted off.
+            if (!s.failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    (*s.fn)(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    if (!s.error)
+                        s.error = std::current_exception();
+                    s.failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            ++ran;
+        }
+
+        if (ran == 0)
+            return;
+
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.done += ran;
+        if (s.done == s.count)
+            s.cv.notify_all();
+    };
+
+    const uint32_t helpers = std::min(threadCount(), count - 1);
+    for (uint32_t h = 0; h < helpers; ++h)
+        submit([state, drain] { drain(*state); });
+
+    drain(*state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done == state->count; });
+
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+TaskPool& TaskPool::shared()
+{
+    static TaskPool pool;
+    return pool;
+}
+
+void TaskPool::workerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+
+            if (m_stop)
+                return;
+
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+            ++m_running;
+        }
+
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "TaskPool: task threw: " << e.what() << "\n";
+        }
+        catch (...)
+        {
+            std::cerr << "TaskPool: task threw an unknown exception.\n";
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_running;
+            if (m_queue.empty() && m_running == 0)
+                m_idle.notify_all();
+        }
+    }
+}
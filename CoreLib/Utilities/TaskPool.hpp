@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size worker pool for fire-and-forget CPU jobs (image decode, parsing).
+ *
+ * Tasks run in FIFO order on background threads. They must not touch
+ * Vulkan queues or scene state owned by the main thread; hand results back
+ * through a structure the owner polls (see ImageHandler::pollPendingLoads()).
+ *
+ * The destructor discards tasks that have not started and joins the workers.
+ */
+class TaskPool
+{
+public:
+    /// @param threadCount Worker count; 0 picks hardware_concurrency() - 1 (at least 1).
+    explicit TaskPool(uint32_t threadCount = 0);
+    ~TaskPool();
+
+    TaskPool(const TaskPool&)            = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+    TaskPool(TaskPool&&)                 = delete;
+    TaskPool& operator=(TaskPool&&)      = delete;
+
+    void submit(std::function<void()> task);
+
+    /// Block until the queue is empty and no task is running.
+    void waitIdle();
+
+    /**
+     * @brief Run fn(0) .. fn(count - 1) across the workers and return when all are done.
+     *
+     * The calling thread takes items too, so this never waits on a busy or
+     * saturated pool and is safe to call from inside a task.
+     *
+     * If an item throws, items not started yet are skipped and the first
+     * exception is rethrown here once every started item has finished.
+     */
+    void parallelFor(uint32_t count, const std::function<void(uint32_t)>& fn);
+
+    [[nodiscard]] uint32_t threadCount() const noexcept
+    {
+        return static_cast<uint32_t>(m_workers.size());
+    }
+
+    /// Process-wide pool, created on first use.
+    [[nodiscard]] static TaskPool& shared();
+
+private:
+    void workerLoop();
+
+private:
+    std::vector<std::thread>          m_workers = {};
+    std::deque<std::function<void()>> m_queue   = {};
+
+    std::mutex              m_mutex   = {};
+    std::condition_variable m_wake    = {};
+    std::condition_variable m_idle    = {};
+    uint32_t                m_running = 0;
+    bool                    m_stop    = false;
+};
@@ -0,0 +1,611 @@
+//============================================================
+// RenderBench — headless benchmark for the Vulkan viewport renderer
+//============================================================
+//
+// Loads a scene, renders it offscreen for every requested draw mode and
+// viewport size, and writes a JSON report (CPU record time, GPU frame time
+// from timestamps, memory) plus optionally one PNG per run.
+//
+//   RenderBench scene.imp --sizes 1280x720,1920x1080 --modes solid,shaded \
+//               --frames 200 --out bench.json --images out/
+//
+// On CI without a GPU, select lavapipe with --device llvmpipe.
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <stb_image_write.h>
+
+#include "Core.hpp"
+#include "CoreTypes.hpp"
+#include "HeadlessDevice.hpp"
+#include "OffscreenTarget.hpp"
+#include "TextureHandler.hpp"
+
+namespace
+{
+    struct BenchSize
+    {
+        uint32_t width  = 0;
+        uint32_t height = 0;
+    };
+
+    struct BenchOptions
+    {
+        std::filesystem::path  scene      = {};
+        std::filesystem::path  out        = "bench.json";
+        std::filesystem::path  imageDir   = {};
+        std::vector<BenchSize> sizes      = {{1280, 720}};
+        std::vector<DrawMode>  modes      = {DrawMode::WIREFRAME, DrawMode::SOLID, DrawMode::SHADED};
+        uint32_t               frames     = 100;
+        uint32_t               warmup     = 10;
+        uint32_t               maxWarmup  = 600; ///< Upper bound while textures are still streaming in.
+        std::string            device     = {};
+        uint32_t               samples    = 0;
+        bool                   validation = false;
+    };
+
+    struct Summary
+    {
+        double mean   = 0.0;
+        double median = 0.0;
+        double p95    = 0.0;
+        double min    = 0.0;
+        double max    = 0.0;
+    };
+
+    struct MemoryUsage
+    {
+        bool     budgetValid       = false;
+        uint64_t deviceLocalUsed   = 0; ///< Sum over DEVICE_LOCAL heaps (VK_EXT_memory_budget).
+        uint64_t deviceLocalBudget = 0;
+        uint64_t residentTextures  = 0;
+    };
+
+    struct RunResult
+    {
+        BenchSize   size       = {};
+        DrawMode    mode       = DrawMode::SOLID;
+        uint32_t    frames     = 0;
+        uint32_t    warmup     = 0;
+        Summary     cpuFrameMs = {}; ///< renderPrePass + render recording, wall clock.
+        Summary     recordMs   = {}; ///< RenderStats::recordMs (mesh passes only).
+        Summary     gpuMs      = {}; ///< Timestamp delta per frame; empty when unsupported.
+        uint32_t    gpuSamples = 0;
+        RenderStats stats      = {};
+        MemoryUsage memory     = {};
+        std::string image      = {};
+    };
+
+    static const char* drawModeName(DrawMode mode) noexcept
+    {
+        switch (mode)
+        {
+            case DrawMode::WIREFRAME:
+                return "wireframe";
+            case DrawMode::SOLID:
+                return "solid";
+            case DrawMode::SHADED:
+                return "shaded";
+            case DrawMode::RAY_TRACE:
+                return "raytrace";
+        }
+        return "unknown";
+    }
+
+    static bool parseDrawMode(std::string_view s, DrawMode& out) noexcept
+    {
+        for (DrawMode m : {DrawMode::WIREFRAME, DrawMode::SOLID, DrawMode::SHADED, DrawMode::RAY_TRACE})
+        {
+            if (s == drawModeName(m))
+            {
+                out = m;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static std::vector<std::string> splitList(const std::string& s)
+    {
+        std::vector<std::string> out;
+        std::stringstream        ss(s);
+        std::string              item;
+        while (std::getline(ss, item, ','))
+        {
+            if (!item.empty())
+                out.push_back(item);
+        }
+        return out;
+    }
+
+    static bool parseSize(const std::string& s, BenchSize& out) noexcept
+    {
+        unsigned w = 0;
+        unsigned h = 0;
+        if (std::sscanf(s.c_str(), "%ux%u", &w, &h) != 2 || w == 0 || h == 0)
+            return false;
+
+        out = {w, h};
+        return true;
+    }
+
+    static void printUsage()
+    {
+        std::cerr << "Usage: RenderBench <scene> [options]\n"
+                     "  --frames N         timed frames per run (default 100)\n"
+                     "  --warmup N         untimed frames before each run (default 10)\n"
+                     "  --sizes WxH,...    viewport sizes (default 1280x720)\n"
+                     "  --modes m,...      wireframe,solid,shaded,raytrace (default wireframe,solid,shaded)\n"
+                     "  --out FILE         JSON report (default bench.json)\n"
+                     "  --images DIR       write the last frame of each run as PNG\n"
+                     "  --device NAME      pick the device whose name contains NAME (e.g. llvmpipe)\n"
+                     "  --samples N        cap MSAA samples (default: device maximum)\n"
+                     "  --validation       enable VK_LAYER_KHRONOS_validation\n";
+    }
+
+    static bool parseArgs(int argc, char* argv[], BenchOptions& opt)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+
+            auto next = [&](const char* name) -> const char* {
+                if (i + 1 >= argc)
+                {
+                    std::cerr << "RenderBench: " << name << " needs a value\n";
+                    return nullptr;
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--frames" || arg == "--warmup" || arg == "--samples")
+            {
+                const char* v = next(argv[i]);
+                if (!v)
+                    return false;
+
+                const uint32_t n = uint32_t(std::strtoul(v, nullptr, 10));
+                if (arg == "--frames")
+                    opt.frames = std::max(1u, n);
+                else if (arg == "--warmup")
+                    opt.warmup = n;
+                else
+                    opt.samples = n;
+            }
+            else if (arg == "--sizes")
+            {
+                const char* v = next("--sizes");
+                if (!v)
+                    return false;
+
+                opt.sizes.clear();
+                for (const std::string& s : splitList(v))
+                {
+                    BenchSize size = {};
+                    if (!parseSize(s, size))
+                    {
+                        std::cerr << "RenderBench: bad size \"" << s << "\" (expected WxH)\n";
+                        return false;
+                    }
+                    opt.sizes.push_back(size);
+                }
+            }
+            else if (arg == "--modes")
+            {
+                const char* v = next("--modes");
+                if (!v)
+                    return false;
+
+                opt.modes.clear();
+                for (const std::string& s : splitList(v))
+                {
+                    DrawMode mode = DrawMode::SOLID;
+                    if (!parseDrawMode(s, mode))
+                    {
+                        std::cerr << "RenderBench: unknown draw mode \"" << s << "\"\n";
+                        return false;
+                    }
+                    opt.modes.push_back(mode);
+                }
+            }
+            else if (arg == "--out" || arg == "--images" || arg == "--device")
+            {
+                const char* v = next(argv[i]);
+                if (!v)
+                    return false;
+
+                if (arg == "--out")
+                    opt.out = v;
+                else if (arg == "--images")
+                    opt.imageDir = v;
+                else
+                    opt.device = v;
+            }
+            else if (arg == "--validation")
+            {
+                opt.validation = true;
+            }
+            else if (arg == "--help" || arg == "-h")
+            {
+                return false;
+            }
+            else if (!arg.empty() && arg[0] != '-' && opt.scene.empty())
+            {
+                opt.scene = std::string(arg);
+            }
+            else
+            {
+                std::cerr << "RenderBench: unknown argument \"" << arg << "\"\n";
+                return false;
+            }
+        }
+
+        return !opt.scene.empty() && !opt.sizes.empty() && !opt.modes.empty();
+    }
+
+    static Summary summarize(std::vector<double> v)
+    {
+        Summary s = {};
+        if (v.empty())
+            return s;
+
+        std::sort(v.begin(), v.end());
+
+        double sum = 0.0;
+        for (double x : v)
+            sum += x;
+
+        const size_t n = v.size();
+        s.mean         = sum / double(n);
+        s.median       = (n & 1) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+        s.p95          = v[std::min(n - 1, size_t(double(n - 1) * 0.95 + 0.5))];
+        s.min          = v.front();
+        s.max          = v.back();
+        return s;
+    }
+
+    static MemoryUsage queryMemory(Core& core, const VulkanContext& ctx)
+    {
+        MemoryUsage mem = {};
+
+        if (const TextureHandler* th = core.textureHandler())
+            mem.residentTextures = th->residentTextureBytes();
+
+        if (!ctx.supportsMemoryBudget)
+            return mem;
+
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budget = {};
+        budget.sType                                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+        VkPhysicalDeviceMemoryProperties2 props = {};
+        props.sType                             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        props.pNext                             = &budget;
+
+        vkGetPhysicalDeviceMemoryProperties2(ctx.physicalDevice, &props);
+
+        for (uint32_t i = 0; i < props.memoryProperties.memoryHeapCount; ++i)
+        {
+            if ((props.memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0)
+                continue;
+
+            mem.deviceLocalUsed += budget.heapUsage[i];
+            mem.deviceLocalBudget += budget.heapBudget[i];
+        }
+
+        mem.budgetValid = true;
+        return mem;
+    }
+
+    /// Record and submit one frame exactly like ViewportRenderWindow::renderOnce().
+    static bool renderFrame(Core& core, Viewport* vp, OffscreenTarget& target, double& cpuMs)
+    {
+        static constexpr VkClearColorValue kClear = {{0.032f, 0.049f, 0.074f, 1.0f}};
+
+        core.idle();
+
+        RenderFrameContext rfc = {};
+        if (!target.beginFrame(rfc))
+            return false;
+
+        const auto t0 = std::chrono::steady_clock::now();
+
+        core.renderPrePass(vp, rfc);
+        target.beginRenderPass(kClear);
+        core.render(vp, rfc);
+        target.endRenderPass();
+
+        cpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+        return target.endFrame();
+    }
+
+    static bool runOne(Core&                core,
+                       const VulkanContext& ctx,
+                       Viewport*            vp,
+                       OffscreenTarget&     target,
+                       const BenchOptions&  opt,
+                       BenchSize            size,
+                       DrawMode             mode,
+                       RunResult&           result)
+    {
+        result      = {};
+        result.size = size;
+        result.mode = mode;
+
+        if (!target.resize(size.width, size.height))
+            return false;
+
+        core.resizeViewport(vp, int(size.width), int(size.height));
+        core.drawMode(vp, mode);
+
+        // Warm up: pipelines, uploads, BVH builds and streamed textures settle here.
+        double   cpuMs  = 0.0;
+        uint32_t warmed = 0;
+        while (warmed < opt.warmup || (core.renderStats().texturesPending > 0 && warmed < opt.maxWarmup))
+        {
+            if (!renderFrame(core, vp, target, cpuMs))
+                return false;
+            ++warmed;
+        }
+
+        target.finish();
+        (void)target.takeGpuTimesMs();
+        result.warmup = warmed;
+
+        std::vector<double> cpuTimes;
+        std::vector<double> recordTimes;
+        cpuTimes.reserve(opt.frames);
+        recordTimes.reserve(opt.frames);
+
+        for (uint32_t f = 0; f < opt.frames; ++f)
+        {
+            if (!renderFrame(core, vp, target, cpuMs))
+                return false;
+
+            cpuTimes.push_back(cpuMs);
+            recordTimes.push_back(core.renderStats().recordMs);
+        }
+
+        target.finish();
+
+        const std::vector<double> gpuTimes = target.takeGpuTimesMs();
+
+        result.frames     = opt.frames;
+        result.cpuFrameMs = summarize(cpuTimes);
+        result.recordMs   = summarize(recordTimes);
+        result.gpuMs      = summarize(gpuTimes);
+        result.gpuSamples = uint32_t(gpuTimes.size());
+        result.stats      = core.renderStats();
+        result.memory     = queryMemory(core, ctx);
+
+        if (!opt.imageDir.empty())
+        {
+            std::vector<uint32_t> rgba;
+            if (!target.readback(rgba))
+            {
+                std::cerr << "RenderBench: readback failed\n";
+                return false;
+            }
+
+            const std::string name = std::string(drawModeName(mode)) + "_" + std::to_string(size.width) + "x" + std::to_string(size.height) + ".png";
+            const std::filesystem::path path = opt.imageDir / name;
+
+            if (!stbi_write_png(path.string().c_str(), int(size.width), int(size.height), 4, rgba.data(), int(size.width * 4)))
+            {
+                std::cerr << "RenderBench: failed to write " << path.string() << "\n";
+                return false;
+            }
+
+            result.image = path.generic_string();
+        }
+
+        return true;
+    }
+
+    static std::string jsonEscape(std::string_view s)
+    {
+        std::string out;
+        out.reserve(s.size());
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out.push_back('\\');
+                out.push_back(c);
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", unsigned(c));
+                out += buf;
+            }
+            else
+            {
+                out.push_back(c);
+            }
+        }
+        return out;
+    }
+
+    static void writeSummary(std::ostream& os, const char* key, const Summary& s)
+    {
+        os << "      \"" << key << "\": {\"mean\": " << s.mean << ", \"median\": " << s.median << ", \"p95\": " << s.p95
+           << ", \"min\": " << s.min << ", \"max\": " << s.max << "}";
+    }
+
+    static bool writeReport(const BenchOptions&           opt,
+                            const HeadlessDevice&         device,
+                            const SceneStats&             scene,
+                            bool                          timestamps,
+                            const std::vector<RunResult>& runs)
+    {
+        std::ofstream os(opt.out);
+        if (!os)
+        {
+            std::cerr << "RenderBench: cannot write " << opt.out.string() << "\n";
+            return false;
+        }
+
+        const VulkanContext& ctx = device.context();
+
+        os << "{\n";
+        os << "  \"scene\": \"" << jsonEscape(opt.scene.generic_string()) << "\",\n";
+        os << "  \"device\": {\"name\": \"" << jsonEscape(device.deviceName()) << "\", \"samples\": " << uint32_t(ctx.sampleCount)
+           << ", \"rayTracing\": " << (ctx.supportsRayTracing ? "true" : "false")
+           << ", \"timestamps\": " << (timestamps ? "true" : "false")
+           << ", \"memoryBudget\": " << (ctx.supportsMemoryBudget ? "true" : "false") << "},\n";
+        os << "  \"sceneStats\": {\"verts\": " << scene.verts << ", \"polys\": " << scene.polys << "},\n";
+        os << "  \"runs\": [\n";
+
+        for (size_t i = 0; i < runs.size(); ++i)
+        {
+            const RunResult& r = runs[i];
+
+            os << "    {\n";
+            os << "      \"mode\": \"" << drawModeName(r.mode) << "\",\n";
+            os << "      \"width\": " << r.size.width << ",\n";
+            os << "      \"height\": " << r.size.height << ",\n";
+            os << "      \"frames\": " << r.frames << ",\n";
+            os << "      \"warmupFrames\": " << r.warmup << ",\n";
+            writeSummary(os, "cpuFrameMs", r.cpuFrameMs);
+            os << ",\n";
+            writeSummary(os, "cpuRecordMs", r.recordMs);
+            os << ",\n";
+            writeSummary(os, "gpuFrameMs", r.gpuMs);
+            os << ",\n";
+            os << "      \"gpuSamples\": " << r.gpuSamples << ",\n";
+            os << "      \"meshesDrawn\": " << r.stats.meshesDrawn << ",\n";
+            os << "      \"meshesCulled\": " << r.stats.meshesCulled << ",\n";
+            os << "      \"drawCalls\": " << r.stats.drawCalls << ",\n";
+            os << "      \"memory\": {\"residentTextureBytes\": " << r.memory.residentTextures;
+            if (r.memory.budgetValid)
+            {
+                os << ", \"deviceLocalUsedBytes\": " << r.memory.deviceLocalUsed
+                   << ", \"deviceLocalBudgetBytes\": " << r.memory.deviceLocalBudget;
+            }
+            os << "}";
+            if (!r.image.empty())
+                os << ",\n      \"image\": \"" << jsonEscape(r.image) << "\"";
+            os << "\n    }" << (i + 1 < runs.size() ? "," : "") << "\n";
+        }
+
+        os << "  ]\n";
+        os << "}\n";
+
+        return bool(os);
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchOptions opt = {};
+    if (!parseArgs(argc, argv, opt))
+    {
+        printUsage();
+        return 2;
+    }
+
+    HeadlessDeviceSettings ds = {};
+    ds.deviceFilter           = opt.device;
+    ds.validation             = opt.validation;
+    ds.maxSamples             = opt.samples;
+
+    HeadlessDevice device;
+    if (!device.init(ds))
+        return 1;
+
+    const VulkanContext& ctx = device.context();
+    std::cout << "RenderBench: " << device.deviceName() << " (" << uint32_t(ctx.sampleCount) << "x MSAA)\n";
+
+    if (!opt.imageDir.empty())
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(opt.imageDir, ec);
+    }
+
+    int exitCode = 0;
+
+    {
+        Core core;
+        core.initializeDevice(ctx);
+
+        if (!core.openFile(opt.scene))
+        {
+            std::cerr << "RenderBench: failed to open " << opt.scene.string() << "\n";
+            core.destroy();
+            device.shutdown();
+            return 1;
+        }
+
+        Viewport* vp = core.createViewport();
+        core.initializeViewport(vp);
+        core.resizeViewport(vp, int(opt.sizes.front().width), int(opt.sizes.front().height));
+        core.viewMode(vp, ViewMode::PERSPECTIVE);
+        core.setActiveViewport(vp);
+        core.runCommand("FitToView");
+
+        OffscreenTarget target;
+        if (!target.create(ctx, opt.sizes.front().width, opt.sizes.front().height))
+        {
+            core.destroy();
+            device.shutdown();
+            return 1;
+        }
+
+        core.initializeSwapchain(target.renderPass());
+
+        std::vector<RunResult> runs;
+
+        for (const BenchSize& size : opt.sizes)
+        {
+            for (DrawMode mode : opt.modes)
+            {
+                if (mode == DrawMode::RAY_TRACE && !rtReady(ctx))
+                {
+                    std::cout << "  skip " << drawModeName(mode) << " (no ray tracing on this device)\n";
+                    continue;
+                }
+
+                RunResult r = {};
+                if (!runOne(core, ctx, vp, target, opt, size, mode, r))
+                {
+                    std::cerr << "RenderBench: run " << drawModeName(mode) << " " << size.width << "x" << size.height << " failed\n";
+                    exitCode = 1;
+                    break;
+                }
+
+                std::cout << "  " << drawModeName(mode) << " " << size.width << "x" << size.height
+                          << "  cpu " << r.cpuFrameMs.median << " ms"
+                          << "  gpu " << r.gpuMs.median << " ms"
+                          << "  draws " << r.stats.drawCalls << "\n";
+
+                runs.push_back(std::move(r));
+            }
+
+            if (exitCode != 0)
+                break;
+        }
+
+        if (!writeReport(opt, device, core.sceneStats(), target.timestampsSupported(), runs))
+            exitCode = 1;
+
+        target.finish();
+        core.destroySwapchainResources();
+        target.destroy();
+        core.destroy();
+    }
+
+    device.shutdown();
+    return exitCode;
+}
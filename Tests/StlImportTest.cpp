@@ -0,0 +1,102 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "Scene.hpp"
+#include "SceneIO/Formats/StlSceneFormat.hpp"
+#include "TestCheck.hpp"
+
+namespace
+{
+    /// Unit quad in z = 0 as two triangles sharing the (1,0,0)-(0,1,0) edge.
+    constexpr float kQuad[2][3][3] = {
+        {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+        {{1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+    };
+
+    std::filesystem::path tempFile(const char* name)
+    {
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+    void writeAscii(const std::filesystem::path& path)
+    {
+        std::ofstream out(path);
+        out << "solid quad\n";
+        for (const auto& tri : kQuad)
+        {
+            out << "  facet normal 0 0 1\n    outer loop\n";
+            for (const auto& v : tri)
+                out << "      vertex " << v[0] << " " << v[1] << " " << v[2] << "\n";
+            out << "    endloop\n  endfacet\n";
+        }
+        out << "endsolid quad\n";
+    }
+
+    void writeBinary(const std::filesystem::path& path)
+    {
+        std::ofstream out(path, std::ios::binary);
+
+        const char     header[80] = {};
+        const uint32_t count      = 2;
+        out.write(header, sizeof(header));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+        for (const auto& tri : kQuad)
+        {
+            const float    normal[3] = {0.0f, 0.0f, 1.0f};
+            const uint16_t attribute = 0;
+            out.write(reinterpret_cast<const char*>(normal), sizeof(normal));
+            out.write(reinterpret_cast<const char*>(tri), sizeof(tri));
+            out.write(reinterpret_cast<const char*>(&attribute), sizeof(attribute));
+        }
+    }
+
+    /// Load @p path with default LoadOptions and check the shared edge was welded.
+    void checkWeldedQuad(const std::filesystem::path& path)
+    {
+        Scene          scene;
+        StlSceneFormat format;
+        SceneIOReport  report;
+
+        CHECK(format.load(&scene, path, LoadOptions{}, report));
+        CHECK(report.status == SceneIOStatus::Ok);
+
+        const std::vector<SceneMesh*> meshes = scene.sceneMeshes();
+        CHECK(meshes.size() == 1);
+        if (meshes.size() != 1)
+            return;
+
+        const SysMesh* mesh = meshes.front()->sysMesh();
+        CHECK(mesh->num_verts() == 4);
+        CHECK(mesh->num_polys() == 2);
+        CHECK(mesh->num_edges() == 5);
+
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    void testAsciiWeldsByDefault()
+    {
+        const std::filesystem::path path = tempFile("imp3d_stl_ascii_quad.stl");
+        writeAscii(path);
+        checkWeldedQuad(path);
+    }
+
+    void testBinaryWeldsByDefault()
+    {
+        const std::filesystem::path path = tempFile("imp3d_stl_binary_quad.stl");
+        writeBinary(path);
+        checkWeldedQuad(path);
+    }
+} // namespace
+
+int main()
+{
+    testAsciiWeldsByDefault();
+    testBinaryWeldsByDefault();
+
+    return test::testResult();
+}
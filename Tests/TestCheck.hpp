@@ -0,0 +1,40 @@
+#pragma once
+
+#include <iostream>
+
+/**
+ * @brief Minimal assertion helpers for the CTest executables in this directory.
+ *
+ * CHECK() records a failure and keeps going so one run reports every broken
+ * expectation; main() returns testResult() as the process exit code.
+ */
+namespace test
+{
+    inline int& failureCount() noexcept
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline void fail(const char* expr, const char* file, int line)
+    {
+        std::cerr << file << ":" << line << ": CHECK failed: " << expr << "\n";
+        ++failureCount();
+    }
+
+    inline int testResult()
+    {
+        if (failureCount() == 0)
+            return 0;
+
+        std::cerr << failureCount() << " check(s) failed\n";
+        return 1;
+    }
+} // namespace test
+
+#define CHECK(expr)                                   \
+    do                                                \
+    {                                                 \
+        if (!(expr))                                  \
+            ::test::fail(#expr, __FILE__, __LINE__);  \
+    } while (false)
@@ -0,0 +1,200 @@
+#include <cstdint>
+#include <vector>
+
+#include "TestCheck.hpp"
+#include "TextureResidency.hpp"
+
+namespace
+{
+    /// RGBA8 mip chain of a square @p dim texture, finest first.
+    std::vector<uint64_t> squareLevels(uint32_t dim)
+    {
+        std::vector<uint64_t> levels;
+        for (;;)
+        {
+            levels.push_back(uint64_t(dim) * dim * 4);
+            if (dim == 1)
+                break;
+            dim /= 2;
+        }
+        return levels;
+    }
+
+    uint64_t bytesFrom(const std::vector<uint64_t>& levels, uint32_t topMip)
+    {
+        uint64_t bytes = 0;
+        for (size_t i = topMip; i < levels.size(); ++i)
+            bytes += levels[i];
+        return bytes;
+    }
+
+    void testPinnedTail()
+    {
+        TextureResidency r;
+        r.track(1, 4096, 4096, squareLevels(4096), 0);
+
+        // 4096 >> 4 == 256 == pinnedMaxDim.
+        CHECK(r.pinnedTopMip(1) == 4);
+        CHECK(r.residentTopMip(1) == 0);
+
+        // Tracking never starts coarser than the pinned tail.
+        r.track(2, 4096, 4096, squareLevels(4096), 12);
+        CHECK(r.residentTopMip(2) == 4);
+    }
+
+    void testWantedTopMip()
+    {
+        CHECK(TextureResidency::wantedTopMip(1024, 1024.0f) == 0);
+        CHECK(TextureResidency::wantedTopMip(1024, 2048.0f) == 0);
+        CHECK(TextureResidency::wantedTopMip(1024, 256.0f) == 2);
+        CHECK(TextureResidency::wantedTopMip(1024, 0.0f) == 31);
+        CHECK(TextureResidency::wantedTopMip(1, 16.0f) == 0);
+    }
+
+    void testUpgradeWithoutBudget()
+    {
+        TextureResidency r;
+        r.track(1, 4096, 4096, squareLevels(4096), 4);
+
+        r.request(1, 4096.0f);
+        const auto changes = r.update();
+
+        CHECK(changes.size() == 1);
+        CHECK(!changes.empty() && changes[0].id == 1 && changes[0].topMip == 0);
+        CHECK(r.residentTopMip(1) == 0);
+
+        // No request and no pressure: the levels stay (no churn).
+        CHECK(r.update().empty());
+        CHECK(r.residentTopMip(1) == 0);
+    }
+
+    void testBudgetEviction()
+    {
+        const auto levels = squareLevels(1024);
+
+        TextureResidency r;
+        r.track(1, 1024, 1024, levels, 2);
+        r.track(2, 1024, 1024, levels, 2);
+
+        // Room for one full chain next to the other's pinned tail.
+        r.setBudget(bytesFrom(levels, 0) + bytesFrom(levels, 2));
+
+        r.request(1, 1024.0f);
+        (void)r.update();
+        CHECK(r.residentTopMip(1) == 0);
+
+        // Texture 2 is needed now; 1 was not requested this frame and is the LRU victim.
+        r.request(2, 1024.0f);
+        (void)r.update();
+        CHECK(r.residentTopMip(2) == 0);
+        CHECK(r.residentTopMip(1) == 2);
+        CHECK(r.residentBytes() <= r.budget());
+
+        // A shrinking budget sheds unrequested levels down to the pinned tail.
+        r.setBudget(2 * bytesFrom(levels, 2));
+        (void)r.update();
+        CHECK(r.residentTopMip(2) == 2);
+        CHECK(r.residentBytes() <= r.budget());
+    }
+
+    void testRequestedTextureIsNotEvicted()
+    {
+        const auto levels = squareLevels(1024);
+
+        TextureResidency r;
+        r.track(1, 1024, 1024, levels, 2);
+        r.track(2, 1024, 1024, levels, 2);
+        r.setBudget(bytesFrom(levels, 0) + bytesFrom(levels, 2));
+
+        r.request(1, 1024.0f);
+        (void)r.update();
+
+        // Both wanted at full size: 1 keeps what it has, 2 gets what still fits.
+        r.request(1, 1024.0f);
+        r.request(2, 1024.0f);
+        (void)r.update();
+        CHECK(r.residentTopMip(1) == 0);
+        CHECK(r.residentTopMip(2) == 2);
+    }
+
+    void testPartialUpgrade()
+    {
+        const auto levels = squareLevels(4096);
+
+        TextureResidency r;
+        r.track(1, 4096, 4096, levels, 4);
+
+        // Enough for levels 1.. but not the 64 MiB base level.
+        r.setBudget(bytesFrom(levels, 1));
+
+        r.request(1, 4096.0f);
+        const auto changes = r.update();
+
+        CHECK(changes.size() == 1);
+        CHECK(r.residentTopMip(1) == 1);
+        CHECK(r.residentBytes() == bytesFrom(levels, 1));
+    }
+
+    void testChangeCapDefersWork()
+    {
+        TextureResidency::Config cfg;
+        cfg.maxChangesPerFrame = 2;
+
+        TextureResidency r(cfg);
+        for (TextureId id = 0; id < 5; ++id)
+            r.track(id, 1024, 1024, squareLevels(1024), 2);
+
+        uint32_t frames  = 0;
+        uint32_t changed = 0;
+        do
+        {
+            for (TextureId id = 0; id < 5; ++id)
+                r.request(id, 1024.0f);
+
+            const auto changes = r.update();
+            CHECK(changes.size() <= cfg.maxChangesPerFrame);
+            changed += static_cast<uint32_t>(changes.size());
+
+            if (frames == 0)
+                CHECK(r.hasDeferredWork());
+        } while (r.hasDeferredWork() && ++frames < 10);
+
+        CHECK(changed == 5);
+        CHECK(!r.hasDeferredWork());
+        for (TextureId id = 0; id < 5; ++id)
+            CHECK(r.residentTopMip(id) == 0);
+    }
+
+    void testSetResidentCorrectsFailedChange()
+    {
+        TextureResidency r;
+        r.track(1, 1024, 1024, squareLevels(1024), 2);
+
+        r.request(1, 1024.0f);
+        (void)r.update();
+        CHECK(r.residentTopMip(1) == 0);
+
+        // The upload failed: the handler reports what is really there.
+        r.setResident(1, 2);
+        CHECK(r.residentTopMip(1) == 2);
+        CHECK(r.residentBytes() == bytesFrom(squareLevels(1024), 2));
+
+        r.untrack(1);
+        CHECK(!r.tracked(1));
+        CHECK(r.residentBytes() == 0);
+    }
+} // namespace
+
+int main()
+{
+    testPinnedTail();
+    testWantedTopMip();
+    testUpgradeWithoutBudget();
+    testBudgetEviction();
+    testRequestedTextureIsNotEvicted();
+    testPartialUpgrade();
+    testChangeCapDefersWork();
+    testSetResidentCorrectsFailedChange();
+
+    return test::testResult();
+}